@@ -39,8 +39,12 @@ typedef struct {
 
 #define COMINIT_ROOTFS_GUID_TYPE "b921b045-1df0-41c3-af44-4c6f280d3fae"          ///< THE GUID of the rootfs.
 #define COMINIT_SECURE_STORAGE_GUID_TYPE "CA7D7CCB-63ED-4C53-861C-1742536059CC"  ///< THE GUID of the secure storage.
+#define COMINIT_GPT_ENTRY_TYPE_GUID_OFFSET 0     ///< Offset of the partition type GUID in a GPT partition entry.
+#define COMINIT_GPT_ENTRY_UNIQUE_GUID_OFFSET 16  ///< Offset of the unique partition GUID in a GPT partition entry.
 #define GPT_HEADER_DEFAULT_ENTRY_SIZE \
     128  ///< The default entry size within a GPT header as defined in UEFI specification.
+/** Bytes of the GPT partition entry array read at once, enough for the default 128 entries of default size. **/
+#define COMINIT_GPT_ENTRY_READ_SIZE (128 * GPT_HEADER_DEFAULT_ENTRY_SIZE)
 /**
  * Find a partition of a given type GUID.
  *
@@ -79,3 +83,19 @@ int cominitAutomountFindPartition(cominitGPTDisk_t *gptDisk, const char *guidTyp
  */
 int cominitAutomountFindPartitionOnDisk(cominitGPTDisk_t *gptDisk, const char *guidType, char *partitionName,
                                         size_t partitionNameSize);
+
+/**
+ * Find a partition by its unique partition GUID (PARTUUID).
+ *
+ * If @p gptDisk already describes a disk, e.g. the one of the rootfs, only that disk is searched. Otherwise all block
+ * devices under /dev are scanned and @p gptDisk is updated to describe the disk on which the partition resides.
+ *
+ * @param[in,out] gptDisk   Pointer to a cominitGPTDisk_t struct.
+ * @param[in] partUuid      The unique partition GUID that should be looked for in the GPT.
+ * @param[out] partitionName    Pointer to a buffer that receives device node of the partition.
+ * @param[in] partitionNameSize The size of the buffer.
+ *
+ * @return  EXIT_SUCCESS on success, EXIT_FAILURE otherwise
+ */
+int cominitAutomountFindPartitionByUuid(cominitGPTDisk_t *gptDisk, const char *partUuid, char *partitionName,
+                                        size_t partitionNameSize);
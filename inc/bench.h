@@ -0,0 +1,46 @@
+// SPDX-License-Identifier: MIT
+/**
+ * @file bench.h
+ * @brief Header related to the on-target benchmark of the boot phases.
+ */
+#ifndef __BENCH_H__
+#define __BENCH_H__
+
+#include "common.h"
+
+#define COMINIT_BENCH_OPTION "--bench"            ///< Option selecting the benchmark, optionally followed by `=<N>`.
+#define COMINIT_BENCH_DEFAULT_REPETITIONS 100uL  ///< Repetitions of every phase if not given with the option.
+#define COMINIT_BENCH_MAX_REPETITIONS 100000uL   ///< Maximum number of repetitions of every phase.
+#define COMINIT_BENCH_DM_NAME "cominit-bench"    ///< Name of the scratch device mapper device.
+
+/**
+ * Parses the benchmark option from an element of argv.
+ *
+ * Accepts `--bench` for #COMINIT_BENCH_DEFAULT_REPETITIONS and `--bench=<N>` for N repetitions, with N between 1 and
+ * #COMINIT_BENCH_MAX_REPETITIONS.
+ *
+ * @param repetitions  Return pointer for the number of repetitions.
+ * @param arg          An element of the argument vector.
+ *
+ * @return  EXIT_SUCCESS on success, EXIT_FAILURE otherwise
+ */
+int cominitBenchParseOption(unsigned long *repetitions, const char *arg);
+
+/**
+ * Repeats the boot phases and prints minimum, median, 99th percentile and maximum duration of each to stdout.
+ *
+ * Meant to characterize hardware from a rescue shell or the running system, so it must not run as PID 1. It enters a
+ * private mount namespace first, so nothing it mounts shows up in the running system. The phases are GPT discovery
+ * of the rootfs (unless it is given with `root=`), metadata read and verification, parsing the rootfs public key, TPM
+ * initialization with self-test and reading the SHA-256 PCRs given with `pcrSeal=` (all if none), both if built with
+ * TPM support, and loading the rootfs device mapper table into the scratch device #COMINIT_BENCH_DM_NAME and removing
+ * it again. A phase that fails is reported and the remaining phases still run.
+ *
+ * @param argCtx       Pointer to the structure that holds the parsed options.
+ * @param repetitions  The number of repetitions of every phase.
+ *
+ * @return  EXIT_SUCCESS if all phases succeeded, EXIT_FAILURE otherwise
+ */
+int cominitBenchRun(cominitCliArgs_t *argCtx, unsigned long repetitions);
+
+#endif /* __BENCH_H__ */
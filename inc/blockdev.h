@@ -0,0 +1,95 @@
+// SPDX-License-Identifier: MIT
+/**
+ * @file blockdev.h
+ * @brief Header related to the I/O backend used to probe disks and read partitions.
+ *
+ * Two implementations exist. blockdev.c accesses real block devices under /dev and is linked into cominit.
+ * blockdevimage.c treats regular files as disk images, so the disk probing and metadata code can run unprivileged, e.g.
+ * in the boot pipeline simulator.
+ */
+#ifndef __BLOCKDEV_H__
+#define __BLOCKDEV_H__
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <sys/stat.h>
+#include <sys/types.h>
+
+/** Directory scanned for disks by the block device backend. **/
+#define COMINIT_BLOCKDEV_SCAN_DIR "/dev"
+
+/**
+ * Opens a disk or partition read-only.
+ *
+ * @param path  The device node, or with the image backend the path of an image or a partition node derived from it.
+ *
+ * @return  A file descriptor on success, -1 otherwise with errno set
+ */
+int cominitBlockdevOpen(const char *path);
+
+/**
+ * Reads from a disk or partition opened with cominitBlockdevOpen() at the given offset.
+ *
+ * @param fd      The file descriptor returned by cominitBlockdevOpen().
+ * @param buf     The buffer receiving the data.
+ * @param len     The number of bytes to read.
+ * @param offset  The offset relative to the start of the disk or partition.
+ *
+ * @return  The number of bytes read like pread(), -1 on error with errno set
+ */
+ssize_t cominitBlockdevPread(int fd, void *buf, size_t len, off_t offset);
+
+/**
+ * Gets the size of a disk or partition opened with cominitBlockdevOpen().
+ *
+ * @param fd    The file descriptor returned by cominitBlockdevOpen().
+ * @param size  Pointer that receives the size in bytes.
+ *
+ * @return  EXIT_SUCCESS on success, EXIT_FAILURE otherwise
+ */
+int cominitBlockdevGetSize(int fd, uint64_t *size);
+
+/**
+ * Gets the logical block size of a disk opened with cominitBlockdevOpen().
+ *
+ * @param fd         The file descriptor returned by cominitBlockdevOpen().
+ * @param blockSize  Pointer that receives the block size in bytes.
+ *
+ * @return  EXIT_SUCCESS on success, EXIT_FAILURE otherwise
+ */
+int cominitBlockdevGetBlockSize(int fd, int *blockSize);
+
+/**
+ * Closes a disk or partition opened with cominitBlockdevOpen().
+ *
+ * @param fd  The file descriptor returned by cominitBlockdevOpen().
+ */
+void cominitBlockdevClose(int fd);
+
+/**
+ * Returns the directory scanned for disks, #COMINIT_BLOCKDEV_SCAN_DIR for block devices.
+ *
+ * @return  The path of the directory.
+ */
+const char *cominitBlockdevScanDir(void);
+
+/**
+ * Checks whether a directory entry found in cominitBlockdevScanDir() is a disk the backend can probe.
+ *
+ * @param st  The result of lstat() on the entry.
+ *
+ * @return  true if the entry is a block device, or a regular file with the image backend, false otherwise
+ */
+bool cominitBlockdevIsDisk(const struct stat *st);
+
+/**
+ * Sets the directory scanned for disk images. Only provided by the image backend.
+ *
+ * Partitions of an image `<dir>/disk.img` are addressed like block device partition nodes, e.g. `<dir>/disk.img2` for
+ * the second entry in its GPT. The image backend assumes a logical block size of 512 bytes.
+ *
+ * @param dir  The directory, must stay valid while it is used.
+ */
+void cominitBlockdevImageSetDir(const char *dir);
+
+#endif /* __BLOCKDEV_H__ */
@@ -7,24 +7,91 @@
 #define __COMMON_H__
 
 #include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
 #include <tss2/tss2_esys.h>
 
 #include "meta.h"
 #include "output.h"
 
+#ifndef COMINIT_TPM_PRIMARY_HANDLE
+#define COMINIT_TPM_PRIMARY_HANDLE TPM2_PERSISTENT_FIRST  ///< Default persistent handle of the storage primary key.
+#endif
+#ifndef COMINIT_TPM_TCTI
+#define COMINIT_TPM_TCTI "device:/dev/tpm0"  ///< Default TCTI configuration used to access the TPM.
+#endif
+#define COMINIT_TPM_TCTI_MAX 256  ///< Maximum length of a TCTI configuration including the terminating null byte.
+#ifndef COMINIT_TPM_BLOB_NV_INDEX
+#define COMINIT_TPM_BLOB_NV_INDEX 0x01000100  ///< Default TPM NV index holding the sealed blob.
+#endif
+
+#define COMINIT_CRYPT_VOLUMES_MAX 8       ///< Maximum number of additional encrypted volumes.
+#define COMINIT_CRYPT_VOLUME_NAME_MAX 32  ///< Maximum length of a volume name including the terminating null byte.
+#define COMINIT_GUID_STR_LEN 37           ///< Length of a GUID in canonical text form including the null byte.
+
+/**
+ * An additional encrypted volume unlocked together with the Secure Storage.
+ */
+typedef struct cominitCryptVolume {
+    char name[COMINIT_CRYPT_VOLUME_NAME_MAX];   ///< The device-mapper name, also names the key in the keyring.
+    char partUuid[COMINIT_GUID_STR_LEN];        ///< The unique partition GUID in lower case, binds the derived key.
+    char devNode[COMINIT_ROOTFS_DEV_PATH_MAX];  ///< Holds the device node found from the partition GUID.
+    bool create;                                ///< Set by `:create`, allows creating the volume after the first boot.
+} cominitCryptVolume_t;
+
+/**
+ * How the Secure Storage is brought up.
+ */
+typedef enum {
+    COMINIT_SECURE_STORAGE_MODE_SYNC = 0,  ///< Format (on first boot) and mount before switching into the rootfs.
+    COMINIT_SECURE_STORAGE_MODE_DEFERRED,  ///< Format and mount in a helper process after the rootfs init started.
+    COMINIT_SECURE_STORAGE_MODE_DETACHED,  ///< Unseal, open, format and mount in a helper process holding the TPM.
+} cominitSecureStorageMode_t;
+
+/**
+ * How the cominit runtime directory in `/run` of the rootfs is set up.
+ */
+typedef enum {
+    COMINIT_RUN_DIR_TMPFS = 0,  ///< Mount a tmpfs at `/run` of the rootfs, for the boot log and helper markers.
+    COMINIT_RUN_DIR_ROOTFS,     ///< Use `/run` of the rootfs as it is, it must be writable.
+    COMINIT_RUN_DIR_NONE,       ///< No boot log, a tmpfs is only mounted if a helper process needs it.
+} cominitRunDir_t;
+
+/**
+ * Where the sealed blob is stored.
+ */
+typedef enum {
+    COMINIT_BLOB_STORAGE_EXT4 = 0,  ///< A file on the ext4 formatted blob partition, mounted to access it.
+    COMINIT_BLOB_STORAGE_RAW,       ///< Two copies at fixed offsets of the unformatted blob partition.
+    COMINIT_BLOB_STORAGE_NV,        ///< A TPM NV index, no blob partition needed.
+} cominitBlobStorage_t;
+
 /**
  * Structure holding parsed options from argv.
  */
 typedef struct cominitCliArgs {
-    bool pcrSet;                               ///< Flag to check whether pcrIndex is set to a valid value.
-    unsigned long pcrIndex;                    ///< The index of the SHA-256 bank of the TPM.
-    int pcrSealCount;                          ///< The number of registers in the SHA-256 bank used for sealing.
-    unsigned long pcrSeal[TPM2_PT_PCR_COUNT];  ///< The list of registers in the SHA-256 bank used for sealing.
-    cominitLogLevelE_t visibleLogLevel;        ///< The visible log level.
+    bool pcrSet;                                   ///< Flag to check whether pcrIndex is set to a valid value.
+    unsigned long pcrIndex;                        ///< The index of the SHA-256 bank of the TPM.
+    bool pcrMeasureSet;                            ///< Flag to check whether pcrMeasureIndex is set to a valid value.
+    unsigned long pcrMeasureIndex;                 ///< The PCR measuring metadata, root hash and Kernel command line.
+    int pcrSealCount;                              ///< The number of registers in the SHA-256 bank used for sealing.
+    unsigned long pcrSeal[TPM2_PT_PCR_COUNT];      ///< The list of registers in the SHA-256 bank used for sealing.
+    cominitLogLevelE_t visibleLogLevel;            ///< The visible log level.
+    cominitLogLevelE_t consoleLogLevel;            ///< The log level also written to stderr once /dev/kmsg is used.
+    cominitRunDir_t runDir;                        ///< How the runtime directory in the rootfs is set up.
+    cominitSecureStorageMode_t secureStorageMode;  ///< How the Secure Storage is brought up.
+    TPM2_HANDLE tpmPrimaryHandle;                  ///< The persistent TPM handle of the storage primary key.
+    bool tpmFullSelftest;                          ///< Flag to run a full instead of an incremental TPM self-test.
+    char tpmTcti[COMINIT_TPM_TCTI_MAX];            ///< The TCTI configuration, #COMINIT_TPM_TCTI if empty.
+    cominitBlobStorage_t blobStorage;              ///< Where the sealed blob is stored.
+    TPM2_HANDLE blobNvIndex;                       ///< The TPM NV index used with #COMINIT_BLOB_STORAGE_NV.
 
     char devNodeRootFs[COMINIT_ROOTFS_DEV_PATH_MAX];  ///< Holds the Rootfs device node.
     char devNodeBlob[COMINIT_ROOTFS_DEV_PATH_MAX];    ///< Holds the blob device node.
     char devNodeCrypt[COMINIT_ROOTFS_DEV_PATH_MAX];   ///< Holds the crypt device node.
+
+    int cryptVolumeCount;                                          ///< The number of additional encrypted volumes.
+    cominitCryptVolume_t cryptVolumes[COMINIT_CRYPT_VOLUMES_MAX];  ///< The additional encrypted volumes.
 } cominitCliArgs_t;
 
 /**
@@ -61,4 +128,16 @@ typedef struct cominitCliArgs {
  */
 int cominitCommonGetPartSize(uint64_t *partSize, int fd);
 
+/**
+ * Computes the CRC32 (IEEE 802.3, as used by zlib) of a buffer.
+ *
+ * Meant for integrity checks of small on-disk structures, so a bitwise implementation without table is used.
+ *
+ * @param data  The data.
+ * @param len   The amount of Bytes in \a data.
+ *
+ * @return  The CRC32 value
+ */
+uint32_t cominitCommonCrc32(const uint8_t *data, size_t len);
+
 #endif /* __COMMON_H__ */
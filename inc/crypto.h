@@ -9,9 +9,23 @@
 #include "mbedtls/error.h"
 #include "mbedtls/pk.h"
 #include "mbedtls/sha256.h"
+#include "mbedtls/sha512.h"
 #include "mbedtls/version.h"
 
 #define SHA256_LEN 32  ///< size of SHA256 digest.
+#define SHA384_LEN 48  ///< size of SHA384 digest.
+
+#define COMINIT_CRYPTO_DIGEST_SHA256 (1 << 0)  ///< Select a SHA-256 digest in cominitCryptoDigests_t::algs.
+#define COMINIT_CRYPTO_DIGEST_SHA384 (1 << 1)  ///< Select a SHA-384 digest in cominitCryptoDigests_t::algs.
+
+/**
+ * Digests of one buffer in several hash algorithms.
+ */
+typedef struct cominitCryptoDigests {
+    unsigned int algs;                 ///< The digests to compute, see #COMINIT_CRYPTO_DIGEST_SHA256.
+    unsigned char sha256[SHA256_LEN];  ///< The SHA-256 digest, valid if selected in cominitCryptoDigests_t::algs.
+    unsigned char sha384[SHA384_LEN];  ///< The SHA-384 digest, valid if selected in cominitCryptoDigests_t::algs.
+} cominitCryptoDigests_t;
 
 /**
  * Verify data according to a signature and a public key.
@@ -40,6 +54,62 @@ int cominitCryptoVerifySignature(const uint8_t *data, size_t dataLen, const uint
  */
 int cominitCreateSHA256DigestfromKeyfile(const char *keyfile, unsigned char *digest, size_t digestLen);
 
+/**
+ * Create a SHA-256 digest of a buffer.
+ *
+ * @param data      The data to hash.
+ * @param dataLen   The amount of Bytes in \a data.
+ * @param digest    Pointer to an allocated buffer capable of holding the bytes given by \a digestLen.
+ * @param digestLen The length of the digest.
+ *
+ * @return  EXIT_SUCCESS on success, EXIT_FAILURE otherwise
+ */
+int cominitCryptoSha256(const uint8_t *data, size_t dataLen, unsigned char *digest, size_t digestLen);
+
+/**
+ * Create the digests selected in \a digests of a buffer.
+ *
+ * All digests are computed in a single pass over \a data, so each part of the buffer is read from memory only once.
+ *
+ * @param data      The data to hash.
+ * @param dataLen   The amount of Bytes in \a data.
+ * @param digests   Pointer to the structure that selects and receives the digests.
+ *
+ * @return  EXIT_SUCCESS on success, EXIT_FAILURE otherwise
+ */
+int cominitCryptoDigests(const uint8_t *data, size_t dataLen, cominitCryptoDigests_t *digests);
+
+/**
+ * Create the digests selected in \a digests of the public key from a PEM file.
+ *
+ * The key is hashed in its DER encoding, the SHA-256 digest is the same as from
+ * cominitCreateSHA256DigestfromKeyfile().
+ *
+ * @param keyfile   The path to the public key PEM-file.
+ * @param digests   Pointer to the structure that selects and receives the digests.
+ *
+ * @return  EXIT_SUCCESS on success, EXIT_FAILURE otherwise
+ */
+int cominitCryptoDigestsFromKeyfile(const char *keyfile, cominitCryptoDigests_t *digests);
+
+/**
+ * Derives key material from a secret using HKDF-SHA256 (RFC 5869) without salt.
+ *
+ * Used to derive independent keys for several purposes from a single high-entropy secret, each bound to its own
+ * \a info.
+ *
+ * @param ikm      The input keying material.
+ * @param ikmLen   The amount of Bytes in \a ikm.
+ * @param info     The context and application specific information, may be NULL if \a infoLen is 0.
+ * @param infoLen  The amount of Bytes in \a info.
+ * @param okm      Pointer to a buffer that receives the output keying material.
+ * @param okmLen   The amount of Bytes to derive, at most 255 * #SHA256_LEN.
+ *
+ * @return  EXIT_SUCCESS on success, EXIT_FAILURE otherwise
+ */
+int cominitCryptoHkdfSha256(const uint8_t *ikm, size_t ikmLen, const uint8_t *info, size_t infoLen, uint8_t *okm,
+                            size_t okmLen);
+
 int cominitCryptoCreatePassphrase(unsigned char *passphrase, size_t passphraseSize);
 
 #endif /* __CRYPTO_H__ */
@@ -12,34 +12,76 @@
 
 #define COMINIT_PASSPHRASE_SIZE 32  ///< The size of the passphrase.
 
+#ifndef COMINIT_CRYPTSETUP_MIN_STRENGTH
+#define COMINIT_CRYPTSETUP_MIN_STRENGTH 256  ///< Minimum security strength in bits a selected cipher has to provide.
+#endif
+
+/**
+ * Description of a cipher cominit may use for a LUKS2 volume.
+ */
+typedef struct cominitCryptsetupCipher {
+    const char *name;       ///< The cipher specification as understood by cryptsetup and dm-crypt.
+    const char *kcapiName;  ///< The Kernel Crypto API name of the cipher used to benchmark it.
+    size_t keySize;         ///< The key size in Bytes.
+    size_t ivSize;          ///< The IV size in Bytes.
+    unsigned int strength;  ///< The security strength in bits.
+} cominitCryptsetupCipher_t;
+
+/**
+ * Selects the fastest cipher for a new LUKS2 volume on the running platform.
+ *
+ * All known candidates providing at least \a minStrength bits of security are benchmarked using the Kernel Crypto
+ * API. If no candidate could be benchmarked (e.g. because the Kernel lacks AF_ALG support), the first candidate
+ * meeting the floor, `aes-xts-plain64` with a 512 bit key for floors up to 256 bits, is selected. A floor no candidate
+ * meets is an error, a weaker cipher is never selected.
+ *
+ * @param minStrength   The security floor in bits.
+ * @param cipher        Address of a pointer that receives the selected cipher.
+ *
+ * @return  EXIT_SUCCESS on success, EXIT_FAILURE otherwise
+ */
+int cominitCryptsetupSelectCipher(unsigned int minStrength, const cominitCryptsetupCipher_t **cipher);
+
 /**
  * Creates a new LUKS2 volume on the target device using the cryptsetup luksFormat subcommand
  *
+ * The cipher and key size are stored in the LUKS2 header, so later boots open the volume with the cipher selected
+ * here.
+ *
  * @param devCrypt      The target device.
+ * @param cipher        The cipher to use for the volume, see cominitCryptsetupSelectCipher().
  * @param passphrase    Pointer to the buffer containing a passphrase for unlocking a LUKS volume.
  * @param passphraseLen Size of the passphrase.
  *
  * @return  EXIT_SUCCESS on success, EXIT_FAILURE otherwise
  */
-int cominitCryptsetupCreateLuksVolume(char *devCrypt, uint8_t *passphrase, size_t passphraseLen);
+int cominitCryptsetupCreateLuksVolume(char *devCrypt, const cominitCryptsetupCipher_t *cipher, uint8_t *passphrase,
+                                      size_t passphraseLen);
 
 /**
- * Opens a LUKS2 volume on the target device using the cryptsetup luksOpen subcommand.
- * The passphrase is obtained by token from user key ring and must been added previously.
+ * Opens LUKS2 volumes on the target devices using the cryptsetup luksOpen subcommand.
+ * The passphrases are obtained by token from user key ring and must been added previously.
  *
- * @param devCrypt      The target device.
+ * One cryptsetup process per volume is started before any of them is waited for, so the key slot unlocking and dm
+ * table loads of all volumes run concurrently.
  *
- * @return  EXIT_SUCCESS on success, EXIT_FAILURE otherwise
+ * @param devCrypt      The target devices.
+ * @param names         The device-mapper names of the opened volumes, one per device.
+ * @param results       Receives EXIT_SUCCESS or EXIT_FAILURE for each volume, so a caller can tell which one failed.
+ * @param count         The number of volumes.
+ *
+ * @return  EXIT_SUCCESS if all volumes were opened, EXIT_FAILURE otherwise
  */
-int cominitCryptsetupOpenLuksVolume(char *devCrypt);
+int cominitCryptsetupOpenLuksVolumes(char *const devCrypt[], char *const names[], int results[], size_t count);
 
 /**
- * Adds a token to an existing LUKS volume.
+ * Adds a keyring token to an existing LUKS volume.
  *
  * @param devCrypt      The target device.
+ * @param keyDesc       The description of the user key holding the passphrase of the volume.
  *
  * @return  EXIT_SUCCESS on success, EXIT_FAILURE otherwise
  */
-int cominitCryptsetupAddToken(char *devCrypt);
+int cominitCryptsetupAddToken(char *devCrypt, const char *keyDesc);
 
 #endif /* __CRYPTSETUP_H__ */
@@ -17,6 +17,11 @@
  */
 #define COMINIT_ROOTFS_DM_NAME "rootfs"
 
+/**
+ * The dm-crypt cipher specification used by cominitSetupDmDeviceCrypt().
+ */
+#define COMINIT_DMCTL_CRYPT_CIPHER "aes-xts-plain64"
+
 /**
  * Set up a dm-verity or dm-integrity rootfs according to given metadata.
  *
@@ -34,6 +39,20 @@
  */
 int cominitSetupDmDevice(cominitRfsMetaData_t *rfsMeta);
 
+/**
+ * Load the dm-verity or dm-integrity table of the rootfs into a scratch device mapper device and remove it again.
+ *
+ * The table is loaded read-only and the device is never resumed, so the target is constructed (which opens and checks
+ * the partition) but nothing is written to it, even while the rootfs is in use. Meant to measure the device mapper
+ * setup on a running system.
+ *
+ * @param rfsMeta  The rootfs configuration metadata loaded by cominitLoadVerifyMetadata().
+ * @param name     The name of the scratch device, must not be in use.
+ *
+ * @return  0 on success, -1 otherwise
+ */
+int cominitProbeDmDevice(const cominitRfsMetaData_t *rfsMeta, const char *name);
+
 /**
  * Set up a dm-crypt mapping for a given block device using a raw key.
  *
@@ -0,0 +1,67 @@
+// SPDX-License-Identifier: MIT
+/**
+ * @file fstemplate.h
+ * @brief Header related to creating a filesystem from a pre-built sparse image template.
+ */
+#ifndef __FSTEMPLATE_H__
+#define __FSTEMPLATE_H__
+
+#include <stdint.h>
+
+#ifndef COMINIT_FSTEMPLATE_PATH
+/** Location of the sparse ext4 template image in the initramfs. Set via CMake. **/
+#define COMINIT_FSTEMPLATE_PATH "/etc/secure_storage.img"
+#endif
+
+/** Temporary mount point used to grow the filesystem after writing the template. **/
+#define COMINIT_FSTEMPLATE_MNT "/fstemplate"
+
+/** Size of the buffer used to copy data extents of the template. **/
+#define COMINIT_FSTEMPLATE_COPY_CHUNK (64 * 1024)
+
+/**
+ * Copy a sparse image to a device.
+ *
+ * Regions reported as data by `lseek(SEEK_DATA)` are copied and holes are zeroed on the target, so the target reads
+ * back exactly as the image even where it held ciphertext garbage before, e.g. on a fresh dm-crypt mapping. Holes are
+ * zeroed with BLKZEROOUT where possible, which avoids copying zeros through user space but still writes the whole
+ * image size. The target beyond the image size is not touched.
+ *
+ * @param templatePath  Path to the sparse image.
+ * @param device        Path to the target device (or file).
+ * @param written       Pointer to a variable that receives the amount of data Bytes copied, may be NULL.
+ *
+ * @return  EXIT_SUCCESS on success, EXIT_FAILURE otherwise
+ */
+int cominitFsTemplateCopy(const char *templatePath, const char *device, uint64_t *written);
+
+/**
+ * Give the ext4 filesystem on a device a new random UUID and directory hash seed.
+ *
+ * Every filesystem created from the same template would otherwise share both. Only the primary superblock is
+ * rewritten. With `metadata_csum`, the checksum seed derived from the old UUID is kept in the superblock
+ * (`metadata_csum_seed`), so the other metadata checksums stay valid, and the superblock checksum is updated. A
+ * filesystem with `uninit_bg` but without `metadata_csum` is refused, as its group descriptor checksums depend on the
+ * UUID. The filesystem must not contain indexed directories, as they are hashed with the old seed.
+ *
+ * @param device  Path to the target device (or file), must not be mounted.
+ *
+ * @return  EXIT_SUCCESS on success, EXIT_FAILURE otherwise
+ */
+int cominitFsTemplateRenewIds(const char *device);
+
+/**
+ * Create an ext4 filesystem on a block device from a template image.
+ *
+ * Copies \a templatePath to \a device using cominitFsTemplateCopy(), renews its UUID and hash seed with
+ * cominitFsTemplateRenewIds(), mounts it temporarily to #COMINIT_FSTEMPLATE_MNT and grows the filesystem online to
+ * the size of \a device.
+ *
+ * @param templatePath  Path to the sparse ext4 image, must not be larger than \a device.
+ * @param device        Path to the target block device.
+ *
+ * @return  EXIT_SUCCESS on success, EXIT_FAILURE otherwise
+ */
+int cominitFsTemplateApply(const char *templatePath, const char *device);
+
+#endif /* __FSTEMPLATE_H__ */
@@ -0,0 +1,84 @@
+// SPDX-License-Identifier: MIT
+/**
+ * @file helper.h
+ * @brief Header related to the background helper process that outlives the switch into the rootfs.
+ */
+#ifndef __HELPER_H__
+#define __HELPER_H__
+
+#include <sys/types.h>
+
+/** Directory in the rootfs (a tmpfs set up by cominitSetupRunDir()) holding the readiness markers. **/
+#define COMINIT_HELPER_RUN_DIR "/run/cominit"
+/** Path of the rootfs as seen by the helper once PID 1 has switched into it. **/
+#define COMINIT_HELPER_ROOTFS "/proc/1/root"
+/** Suffix of the marker file created if the helper task succeeded. **/
+#define COMINIT_HELPER_MARKER_READY ".ready"
+/** Suffix of the marker file created if the helper task failed. **/
+#define COMINIT_HELPER_MARKER_FAILED ".failed"
+
+/**
+ * Task executed by the helper.
+ *
+ * @param data  Pointer given to cominitHelperStart().
+ *
+ * @return  EXIT_SUCCESS on success, EXIT_FAILURE otherwise
+ */
+typedef int (*cominitHelperTask_t)(void *data);
+
+/**
+ * Structure holding the state of a started helper process.
+ */
+typedef struct cominitHelper {
+    pid_t pid;   ///< The process ID of the helper, -1 if no helper is running.
+    int syncFd;      ///< Write end of the pipe used to release the helper, -1 if not open.
+    int preparedFd;  ///< Socket the helper reports the end of its first task on, -1 if not open.
+} cominitHelper_t;
+
+/**
+ * Start a helper process that runs \a prepare right away and \a finish after cominit has switched into the rootfs.
+ *
+ * After \a prepare, the helper waits until it is released by cominitHelperRelease(). If cominit execs without
+ * releasing it (e.g. into the rescue shell), the helper exits without running \a finish. Otherwise it runs \a finish
+ * if \a prepare succeeded and creates the marker file `COMINIT_HELPER_RUN_DIR/<markerName>.ready` (or `.failed`) in
+ * the rootfs, so services can wait on it. As the helper may still need programs from the initramfs, it also takes over
+ * the cleanup of the initramfs, i.e. the lazy unmount of `/dev` and cominitFreeInitramfs(). The caller must skip both
+ * if the helper was started successfully.
+ *
+ * The helper is a fork of the caller, so \a data may point to the stack of the calling function.
+ *
+ * @param helper        Pointer to the structure receiving the helper state.
+ * @param prepare       The task to run right away, may be NULL.
+ * @param finish        The task to run once the rootfs init has been started.
+ * @param data          Pointer passed to \a prepare and \a finish.
+ * @param markerName    Name of the marker file without suffix.
+ *
+ * @return  EXIT_SUCCESS on success, EXIT_FAILURE otherwise
+ */
+int cominitHelperStart(cominitHelper_t *helper, cominitHelperTask_t prepare, cominitHelperTask_t finish, void *data,
+                       const char *markerName);
+
+/**
+ * Wait until a helper started by cominitHelperStart() has finished its \a prepare task.
+ *
+ * Must be called before the exec into the rootfs init if the rootfs must not run before \a prepare is done, e.g.
+ * because it could change PCRs the task depends on.
+ *
+ * @param helper  Pointer to the structure holding the helper state.
+ *
+ * @return  EXIT_SUCCESS if \a prepare has finished, EXIT_FAILURE if the helper exited before
+ */
+int cominitHelperWaitPrepared(cominitHelper_t *helper);
+
+/**
+ * Release a helper started by cominitHelperStart().
+ *
+ * Must be called after switching into the rootfs, directly before the exec into the rootfs init.
+ *
+ * @param helper  Pointer to the structure holding the helper state.
+ *
+ * @return  EXIT_SUCCESS on success, EXIT_FAILURE otherwise
+ */
+int cominitHelperRelease(cominitHelper_t *helper);
+
+#endif /* __HELPER_H__ */
@@ -0,0 +1,65 @@
+// SPDX-License-Identifier: MIT
+/**
+ * @file kcapi.h
+ * @brief Header related to the Kernel Crypto API (AF_ALG) implementations
+ */
+#ifndef __KCAPI_H__
+#define __KCAPI_H__
+
+#include <stddef.h>
+#include <stdint.h>
+
+#define COMINIT_KCAPI_BENCH_SIZE_MIB 4                ///< Amount of data measured per benchmark run in MiB.
+#define COMINIT_KCAPI_BENCH_WARMUP_SIZE (256 * 1024)  ///< Amount of data encrypted unmeasured before a run.
+#define COMINIT_KCAPI_BENCH_CHUNK 4096                ///< Size of a single encryption request, matches a 4k sector.
+/** Amount of data measured per benchmark run in Bytes. **/
+#define COMINIT_KCAPI_BENCH_SIZE (COMINIT_KCAPI_BENCH_SIZE_MIB * 1024 * 1024)
+
+#define COMINIT_KCAPI_TYPE_MAX 14          ///< Maximum length of an algorithm type including the null-Byte.
+#define COMINIT_KCAPI_NAME_MAX 64          ///< Maximum length of an algorithm name including the null-Byte.
+#define COMINIT_KCAPI_PROBE_CACHE_SIZE 16  ///< Number of probe results remembered during a boot.
+
+/**
+ * Check whether the running Kernel provides a crypto algorithm.
+ *
+ * The algorithm is probed by binding an AF_ALG socket to it, which also makes the Kernel load the module providing
+ * it if necessary. Results are cached for the lifetime of the process, so every algorithm is probed at most once per
+ * boot. If AF_ALG is not available or binding fails, `/proc/crypto` is consulted as a fallback.
+ *
+ * @param type      The algorithm type, e.g. "hash" or "skcipher".
+ * @param algName   The kernel crypto API name of the algorithm, e.g. "sha256" or "xts(aes)".
+ *
+ * @return  EXIT_SUCCESS if the algorithm is available, EXIT_FAILURE otherwise
+ */
+int cominitKcapiProbe(const char *type, const char *algName);
+
+/**
+ * Check whether the running Kernel provides the cipher of a dm-crypt table.
+ *
+ * Translates a dm-crypt cipher specification (`cipher[:keycount]-chainmode-ivmode[:ivopts]` or
+ * `capi:cipher_api_spec-ivmode[:ivopts]`) to its Kernel Crypto API name and probes it using cominitKcapiProbe().
+ *
+ * @param dmCipher  The dm-crypt cipher specification, e.g. "aes-xts-plain64".
+ *
+ * @return  EXIT_SUCCESS if the cipher is available, EXIT_FAILURE otherwise
+ */
+int cominitKcapiProbeDmCipher(const char *dmCipher);
+
+/**
+ * Measure the encryption throughput of a symmetric kernel cipher via an AF_ALG socket.
+ *
+ * Encrypts #COMINIT_KCAPI_BENCH_WARMUP_SIZE Bytes unmeasured to fault in the implementation and its buffers, then
+ * measures encrypting #COMINIT_KCAPI_BENCH_SIZE Bytes. Data is sent in requests of #COMINIT_KCAPI_BENCH_CHUNK Bytes
+ * with a fixed non-secret key. As dm-crypt uses the same kernel implementation, the result is a good estimate of the
+ * relative performance of a cipher on the running platform.
+ *
+ * @param algName       The kernel crypto API name of the cipher, e.g. "xts(aes)".
+ * @param keySize       The key size in Bytes.
+ * @param ivSize        The IV size in Bytes.
+ * @param nsPerRun      Pointer to a variable that receives the elapsed time in nanoseconds.
+ *
+ * @return  EXIT_SUCCESS on success, EXIT_FAILURE otherwise
+ */
+int cominitKcapiBenchmarkSkcipher(const char *algName, size_t keySize, size_t ivSize, uint64_t *nsPerRun);
+
+#endif /* __KCAPI_H__ */
@@ -10,6 +10,8 @@
 #include <stddef.h>
 #include <stdint.h>
 
+#include "kcapi.h"
+
 /** The location of the public key to verify the rootfs partition metadata. **/
 #define COMINIT_ROOTFS_KEY_LOCATION "/etc/rootfs_key_pub.pem"
 
@@ -22,11 +24,21 @@
 #define COMINIT_ROOTFS_DEV_PATH_MAX 256
 /** Maximum length of the filesystem type identifier. **/
 #define COMINIT_FSTYPE_STR_MAX_LEN 32
+/** Maximum number of Kernel crypto algorithms the device mapper tables of the rootfs may depend on. **/
+#define COMINIT_DM_ALGS_MAX 4
+/** Maximum length of a Kernel crypto algorithm type, the same as accepted by cominitKcapiProbe(). **/
+#define COMINIT_DM_ALG_TYPE_MAX COMINIT_KCAPI_TYPE_MAX
+/** Maximum length of a Kernel crypto algorithm name, the same as accepted by cominitKcapiProbe(). **/
+#define COMINIT_DM_ALG_NAME_MAX COMINIT_KCAPI_NAME_MAX
 
 /** Size (in Bytes) of the metadata region at the end of the rootfs patition. **/
 #define COMINIT_PART_META_DATA_SIZE 4096
 /** Size (in Bytes) of the signature within the metadata region **/
 #define COMINIT_PART_META_SIG_LENGTH 512
+/** Maximum size (in Bytes) of the signed metadata string including its terminating NUL. **/
+#define COMINIT_PART_META_STR_MAX (COMINIT_PART_META_DATA_SIZE - COMINIT_PART_META_SIG_LENGTH)
+/** Maximum length of the hex encoded dm-verity root hash, enough for SHA-512. **/
+#define COMINIT_DM_VERITY_ROOT_HASH_MAX 129
 
 /** Bitmask specifiying which dm-crypt/verity/integrity features to use, if any. **/
 typedef int8_t cominitCryptOpt_t;
@@ -39,6 +51,14 @@ typedef int8_t cominitCryptOpt_t;
 /** dm-crypt, can be combined with either #COMINIT_CRYPTOPT_VERITY or #COMINIT_CRYPTOPT_INTEGRITY **/
 #define COMINIT_CRYPTOPT_CRYPT (1 << 2)
 
+/**
+ * A Kernel crypto algorithm a device mapper target of the rootfs depends on.
+ */
+typedef struct cominitDmAlg {
+    char type[COMINIT_DM_ALG_TYPE_MAX];  ///< The algorithm type as used by AF_ALG, e.g. "hash" or "skcipher".
+    char name[COMINIT_DM_ALG_NAME_MAX];  ///< The Kernel Crypto API name of the algorithm, e.g. "sha256".
+} cominitDmAlg_t;
+
 /**
  * Structure holding rootfs partition metadata necessary to set it up correctly. cominitRfsMetaData_t::devicePath is
  * read from the boot command line. Everything else is read from the partition metadata region on disk by
@@ -59,6 +79,12 @@ typedef struct cominitRfsMetaData_t {
     char dmTableVerint[COMINIT_DM_TABLE_SIZE_MAX];  ///< Space to hold device mapper table for dm-verity or
                                                     ///< dm-integrity.
     char dmTableCrypt[COMINIT_DM_TABLE_SIZE_MAX];   ///< Space to hold device mapper table for dm-crypt
+    cominitDmAlg_t dmAlgs[COMINIT_DM_ALGS_MAX];     ///< Kernel crypto algorithms used by the device mapper tables.
+    size_t dmAlgCount;                              ///< Number of valid entries in cominitRfsMetaData_t::dmAlgs.
+    char dmVerityRootHash[COMINIT_DM_VERITY_ROOT_HASH_MAX];  ///< Hex encoded dm-verity root hash, empty if the
+                                                             ///< rootfs does not use dm-verity.
+    uint8_t metadata[COMINIT_PART_META_STR_MAX];  ///< The verified metadata string as signed, including its NUL.
+    size_t metadataLen;                           ///< Number of valid Bytes in cominitRfsMetaData_t::metadata.
 } cominitRfsMetaData_t;
 
 /**
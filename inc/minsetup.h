@@ -44,10 +44,30 @@ int cominitCleanupSysfiles(void);
  */
 int cominitSetupRootfs(cominitRfsMetaData_t *rfsMeta);
 
+/**
+ * Create the cominit runtime directory in `/newroot/run`, optionally on a freshly mounted tmpfs.
+ *
+ * Gives cominit (and its helper process, see helper.h) a writable location in the rootfs. With \a mountTmpfs this
+ * works even if the rootfs itself is read-only, the rootfs init is expected to keep an already mounted `/run`.
+ *
+ * @param mountTmpfs  Flag to mount a tmpfs at `/newroot/run` first instead of using the one of the rootfs.
+ *
+ * @return 0 on success, -1 on error
+ */
+int cominitSetupRunDir(bool mountTmpfs);
+
+/**
+ * Free up memory in the initramfs.
+ *
+ * Recursively removes all files of the initramfs without crossing into other mounts. Must not be called as long as
+ * programs from the initramfs are still needed.
+ */
+void cominitFreeInitramfs(void);
+
 /**
  * Switch into the rootfs mounted at `/newroot`.
  *
- * Will free up memory in the initramfs and move the root mount.
+ * Will move the root mount. The initramfs should be freed with cominitFreeInitramfs() before.
  *
  * @return 0 on success, -1 on error
  */
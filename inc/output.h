@@ -7,6 +7,7 @@
 #define __OUTPUT_H__
 
 #include <stdbool.h>
+#include <stddef.h>
 
 /**
  * Structure defining the different lof levels.
@@ -27,13 +28,36 @@ typedef enum {
  */
 #define COMINIT_PRINT_PREFIX "[COMINIT] "
 
+/**
+ * Path of the kernel log buffer device.
+ */
+#define COMINIT_OUTPUT_KMSG_PATH "/dev/kmsg"
+
+/**
+ * Path the in-memory log is written to before executing the rootfs init, relative to the switched root.
+ */
+#define COMINIT_OUTPUT_LOG_PATH "/run/cominit/log"
+
+/**
+ * Size of the in-memory log in bytes. Once full, the oldest records are overwritten.
+ */
+#ifndef COMINIT_OUTPUT_LOG_RING_SIZE
+#define COMINIT_OUTPUT_LOG_RING_SIZE (64 * 1024)
+#endif
+
 /**
  * Print a message. Message is only printed if current visible log level is higher than the message's log level.
  * Sensitive messages can only be printed by setting compiler option.
  *
  * Can be used like printf(). In contrast to printf(), this function adds #COMINIT_PRINT_PREFIX and the given
- * \a file, \a func, and \a line parameters at the start as well as a newline at the end. It uses stderr as its output
- * stream.
+ * \a file, \a func, and \a line parameters at the start as well as a newline at the end. Each record is formatted into
+ * a single buffer and emitted with one write(). It uses stderr as its output stream until cominitOutputOpenKmsg() has
+ * succeeded. From then on records go to the kernel log with the matching kernel log level and are only written to
+ * stderr as well if their log level is within the console log level or the kernel log refused the record. Sensitive
+ * messages are never written to the kernel log.
+ *
+ * Independent of the visible log level, all messages up to DEBUG are also kept in an in-memory log, see
+ * cominitOutputFlushLog().
  *
  * @return The number of characters printed.
  */
@@ -47,6 +71,34 @@ int cominitOutputLogFunc(cominitLogLevelE_t logLevel, const char *file, const ch
  */
 void cominitOutputSetVisibleLogLevel(cominitLogLevelE_t cominitLogLevel);
 
+/**
+ * Sets the log level up to which messages are written to stderr in addition to the kernel log. Has no effect as long
+ * as the kernel log is not used. Defaults to COMINIT_LOG_LEVEL_ERR, so errors stay visible even if the kernel drops
+ * records because of `printk.devkmsg=ratelimit`.
+ *
+ * @param cominitLogLevel   The console log level.
+ */
+void cominitOutputSetConsoleLogLevel(cominitLogLevelE_t cominitLogLevel);
+
+/**
+ * Writes the in-memory log to a file, oldest record first.
+ *
+ * The in-memory log holds all messages up to DEBUG since start, or the latest #COMINIT_OUTPUT_LOG_RING_SIZE bytes of
+ * them. Sensitive messages are never kept.
+ *
+ * @param path  The file to create or truncate, usually #COMINIT_OUTPUT_LOG_PATH.
+ * @return  EXIT_SUCCESS on success, EXIT_FAILURE otherwise
+ */
+int cominitOutputFlushLog(const char *path);
+
+/**
+ * Opens the kernel log device and uses it as output for all following log messages.
+ *
+ * @param path  Path to the kernel log device, usually #COMINIT_OUTPUT_KMSG_PATH.
+ * @return  EXIT_SUCCESS on success, EXIT_FAILURE otherwise
+ */
+int cominitOutputOpenKmsg(const char *path);
+
 /**
  * Parses the log level from argv that should be visible.
  *
@@ -57,19 +109,71 @@ void cominitOutputSetVisibleLogLevel(cominitLogLevelE_t cominitLogLevel);
  */
 int cominitOutputParseLogLevel(cominitLogLevelE_t *logLevel, const char *argValue);
 
-#define cominitDebugPrint(...) \
-    cominitOutputLogFunc(COMINIT_LOG_LEVEL_DEBUG, __FILE__, __func__, __LINE__, false, __VA_ARGS__)
+/**
+ * The least severe log level compiled into the binary, as number like in `logLevel=`. Calls to the print macros below
+ * this level compile to nothing, so neither their strings nor the call end up in the binary. Defaults to DEBUG, or to
+ * SENSITIVE if sensitive logging is enabled.
+ */
+#ifndef COMINIT_MIN_LOG_LEVEL
+#ifdef COMINIT_ENABLE_SENSITIVE_LOGGING
+#define COMINIT_MIN_LOG_LEVEL 5
+#else
+#define COMINIT_MIN_LOG_LEVEL 4
+#endif
+#endif
+
+#define COMINIT_LOG_STR_(x) #x
+#define COMINIT_LOG_STR(x) COMINIT_LOG_STR_(x)
+
+/**
+ * The call site passed to cominitOutputLogFunc(). If the build assigns a numeric ID to each source file, only that ID
+ * and the line are used instead of the file and function name strings.
+ */
+#ifdef COMINIT_LOG_FILE_ID
+#define COMINIT_LOG_SITE_FILE COMINIT_LOG_STR(COMINIT_LOG_FILE_ID)
+#define COMINIT_LOG_SITE_FUNC NULL
+#else
+#define COMINIT_LOG_SITE_FILE __FILE__
+#define COMINIT_LOG_SITE_FUNC __func__
+#endif
+
+#define COMINIT_LOG_CALL(logLevel, printErrno, ...) \
+    cominitOutputLogFunc(logLevel, COMINIT_LOG_SITE_FILE, COMINIT_LOG_SITE_FUNC, __LINE__, printErrno, __VA_ARGS__)
+
+/* Keeps the arguments referenced and format-checked, but the dead call and its strings are removed by the compiler. */
+#define COMINIT_LOG_STRIPPED(logLevel, printErrno, ...) \
+    ((void)(0 && COMINIT_LOG_CALL(logLevel, printErrno, __VA_ARGS__)))
+
+#if COMINIT_MIN_LOG_LEVEL >= 4
+#define cominitDebugPrint(...) COMINIT_LOG_CALL(COMINIT_LOG_LEVEL_DEBUG, false, __VA_ARGS__)
+#else
+#define cominitDebugPrint(...) COMINIT_LOG_STRIPPED(COMINIT_LOG_LEVEL_DEBUG, false, __VA_ARGS__)
+#endif
 
-#define cominitErrPrint(...) \
-    cominitOutputLogFunc(COMINIT_LOG_LEVEL_ERR, __FILE__, __func__, __LINE__, false, __VA_ARGS__)
+#if COMINIT_MIN_LOG_LEVEL >= 1
+#define cominitErrPrint(...) COMINIT_LOG_CALL(COMINIT_LOG_LEVEL_ERR, false, __VA_ARGS__)
+#define cominitErrnoPrint(...) COMINIT_LOG_CALL(COMINIT_LOG_LEVEL_ERR, true, __VA_ARGS__)
+#else
+#define cominitErrPrint(...) COMINIT_LOG_STRIPPED(COMINIT_LOG_LEVEL_ERR, false, __VA_ARGS__)
+#define cominitErrnoPrint(...) COMINIT_LOG_STRIPPED(COMINIT_LOG_LEVEL_ERR, true, __VA_ARGS__)
+#endif
 
-#define cominitErrnoPrint(...) \
-    cominitOutputLogFunc(COMINIT_LOG_LEVEL_ERR, __FILE__, __func__, __LINE__, true, __VA_ARGS__)
+#if COMINIT_MIN_LOG_LEVEL >= 3
+#define cominitInfoPrint(...) COMINIT_LOG_CALL(COMINIT_LOG_LEVEL_INFO, false, __VA_ARGS__)
+#else
+#define cominitInfoPrint(...) COMINIT_LOG_STRIPPED(COMINIT_LOG_LEVEL_INFO, false, __VA_ARGS__)
+#endif
 
-#define cominitInfoPrint(...) \
-    cominitOutputLogFunc(COMINIT_LOG_LEVEL_INFO, __FILE__, __func__, __LINE__, false, __VA_ARGS__)
+#if COMINIT_MIN_LOG_LEVEL >= 2
+#define cominitWarnPrint(...) COMINIT_LOG_CALL(COMINIT_LOG_LEVEL_WARN, false, __VA_ARGS__)
+#else
+#define cominitWarnPrint(...) COMINIT_LOG_STRIPPED(COMINIT_LOG_LEVEL_WARN, false, __VA_ARGS__)
+#endif
 
-#define cominitSensitivePrint(...) \
-    cominitOutputLogFunc(COMINIT_LOG_LEVEL_SENSITIVE, __FILE__, __func__, __LINE__, false, __VA_ARGS__)
+#if COMINIT_MIN_LOG_LEVEL >= 5
+#define cominitSensitivePrint(...) COMINIT_LOG_CALL(COMINIT_LOG_LEVEL_SENSITIVE, false, __VA_ARGS__)
+#else
+#define cominitSensitivePrint(...) COMINIT_LOG_STRIPPED(COMINIT_LOG_LEVEL_SENSITIVE, false, __VA_ARGS__)
+#endif
 
 #endif /* __OUTPUT_H__ */
@@ -0,0 +1,72 @@
+// SPDX-License-Identifier: MIT
+/**
+ * @file securearena.h
+ * @brief Header related to the locked memory arena holding all key material.
+ */
+#ifndef __SECUREARENA_H__
+#define __SECUREARENA_H__
+
+#include <stddef.h>
+
+/**
+ * Size of the secure arena in bytes, rounded up to whole pages.
+ */
+#ifndef COMINIT_SECURE_ARENA_SIZE
+#define COMINIT_SECURE_ARENA_SIZE (16 * 1024)
+#endif
+
+/**
+ * Allocates zeroed memory for a secret from the secure arena.
+ *
+ * The arena is set up on first use as one anonymous mapping framed by inaccessible guard pages. It is locked into RAM,
+ * excluded from core dumps and wiped in forked children, so callers do not need to mlock() their buffers. A forked
+ * child that allocates from the arena must call cominitSecureArenaAfterFork() first. Allocations are served in order
+ * and must be released with cominitSecureArenaFree(), ideally in reverse order.
+ *
+ * @param size  The number of bytes to allocate.
+ *
+ * @return  Pointer to the allocated memory on success, NULL if the arena could not be set up or is exhausted.
+ */
+void *cominitSecureArenaAlloc(size_t size);
+
+/**
+ * Wipes and releases memory allocated with cominitSecureArenaAlloc().
+ *
+ * @param ptr   Pointer returned by cominitSecureArenaAlloc(), may be NULL.
+ * @param size  The size given to cominitSecureArenaAlloc().
+ *
+ * @return  EXIT_SUCCESS on success, EXIT_FAILURE if \a ptr is not part of the arena or could not be wiped.
+ */
+int cominitSecureArenaFree(void *ptr, size_t size);
+
+/**
+ * Takes over the secure arena in a child process right after fork().
+ *
+ * Memory locks are not inherited across fork(), so the arena is locked again. It is also wiped and emptied, the
+ * allocations of the parent are not valid in the child. Does nothing if the arena has not been set up yet.
+ *
+ * @return  EXIT_SUCCESS on success, EXIT_FAILURE if the arena could not be locked.
+ */
+int cominitSecureArenaAfterFork(void);
+
+/**
+ * Overwrites a memory region with zeros in a way the compiler cannot optimize away.
+ *
+ * @param buffer    Pointer to the memory to clear.
+ * @param size      Number of bytes to clear.
+ */
+void cominitSecureArenaWipe(void *buffer, size_t size);
+
+/**
+ * Verifies that a memory region is completely zeroed.
+ *
+ * Every byte is checked regardless of where a non-zero byte is found, so the run time does not depend on the content.
+ *
+ * @param buffer    Pointer to the memory to check.
+ * @param size      Number of bytes to check.
+ *
+ * @return  EXIT_SUCCESS if every byte is 0x00, EXIT_FAILURE otherwise.
+ */
+int cominitSecureArenaVerifyZero(const void *buffer, size_t size);
+
+#endif /* __SECUREARENA_H__ */
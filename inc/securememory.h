@@ -9,6 +9,7 @@
 
 #include <stddef.h>
 
+#include "cryptsetup.h"
 #include "tpm.h"
 
 /**
@@ -16,21 +17,39 @@
  * retrieving the passphrase from user keyring and
  * calling cominitCryptsetupCreateLuksVolume().
  *
- * Use single buffer for passphrase and zeroes it out with
- * cominitSecurememoryZeroOut().
+ * Uses a single buffer from the secure arena for the passphrase
+ * and wipes it with cominitSecureArenaWipe().
  *
  * @param devCrypt The target device.
+ * @param keyDesc  The description of the user key holding the passphrase.
+ * @param cipher   The cipher to use for the volume.
  *
  * @return  EXIT_SUCCESS on success, EXIT_FAILURE otherwise
  */
-int cominitSecurememoryCreateLuksVolume(char *devCrypt);
+int cominitSecurememoryCreateLuksVolume(char *devCrypt, const char *keyDesc, const cominitCryptsetupCipher_t *cipher);
 
 /**
- * Unseals the passphrase from TPM sealed blob and adds it
+ * Derives a passphrase from a root secret in the user keyring and adds it
  * to user keyring.
  *
- * Use single buffer for passphrase and zeroes it out with
- * cominitSecurememoryZeroOut().
+ * The passphrase is derived with HKDF-SHA256 using \a context as info, so every
+ * context gets an independent passphrase from one unsealed secret. Uses a single
+ * buffer from the secure arena for the secret and the passphrase and wipes it
+ * with cominitSecureArenaWipe().
+ *
+ * @param rootKeyDesc The description of the user key holding the root secret.
+ * @param context     The context the passphrase is bound to, e.g. a partition GUID.
+ * @param keyDesc     The description of the user key that receives the passphrase.
+ *
+ * @return  EXIT_SUCCESS on success, EXIT_FAILURE otherwise
+ */
+int cominitSecurememoryDeriveKey(const char *rootKeyDesc, const char *context, const char *keyDesc);
+
+/**
+ * Creates a new passphrase and seals it into a TPM blob.
+ *
+ * Uses a single buffer from the secure arena for the passphrase
+ * and wipes it with cominitSecureArenaWipe().
  *
  * @param ectx  The Pointer to the initialized ESYS_CONTEXT handle.
  * @param primaryHandle  Pointer to a ESYS_TR structure that holds the primary key handle.
@@ -46,8 +65,8 @@ int cominitSecurememoryEsysCreate(ESYS_CONTEXT *ectx, ESYS_TR *primaryHandle, TP
  * Unseals the passphrase from TPM sealed blob and adds it
  * to user keyring.
  *
- * Use single buffer for passphrase and zeroes it out with
- * cominitSecurememoryZeroOut().
+ * The passphrase is returned by the ESAPI in its own buffer, which is
+ * locked while in use and wiped with cominitSecureArenaWipe().
  *
  * @param ectx  The Pointer to the initialized ESYS_CONTEXT handle.
  * @param blobHandle  Pointer to a ESYS_TR structure that holds the blob key handle.
@@ -0,0 +1,65 @@
+// SPDX-License-Identifier: MIT
+/**
+ * @file stats.h
+ * @brief Header related to the latency statistics shared by the benchmarks.
+ */
+#ifndef __STATS_H__
+#define __STATS_H__
+
+#include <stddef.h>
+#include <stdint.h>
+
+/**
+ * Returns the current value of the monotonic clock.
+ *
+ * @return  The time in nanoseconds.
+ */
+uint64_t cominitStatsNow(void);
+
+/**
+ * Sorts durations in ascending order.
+ *
+ * @param samples  The durations.
+ * @param count    The number of durations.
+ */
+void cominitStatsSort(uint64_t *samples, size_t count);
+
+/**
+ * Picks a percentile from sorted durations, without interpolation.
+ *
+ * 0 is the minimum, 50 the median and 100 the maximum.
+ *
+ * @param sorted   The durations sorted by cominitStatsSort().
+ * @param count    The number of durations, at least 1.
+ * @param percent  The percentile between 0 and 100.
+ *
+ * @return  The duration at the percentile.
+ */
+uint64_t cominitStatsPercentile(const uint64_t *sorted, size_t count, unsigned int percent);
+
+/**
+ * Prints the header line of a report to stdout.
+ *
+ * The percentile columns are labeled `min`, `median`, `max` or `p<percent>`.
+ *
+ * @param title        The title of the name column, e.g. `step [us]`.
+ * @param nameWidth    The width of the name column.
+ * @param percentiles  The percentiles to print, see cominitStatsPercentile().
+ * @param columns      The number of percentiles.
+ */
+void cominitStatsPrintHeader(const char *title, int nameWidth, const unsigned int *percentiles, size_t columns);
+
+/**
+ * Sorts durations and prints their percentiles in microseconds as a line of a report to stdout.
+ *
+ * @param name         The name of the measured step.
+ * @param nameWidth    The width of the name column.
+ * @param samples      The durations in nanoseconds, sorted in place.
+ * @param count        The number of durations, at least 1.
+ * @param percentiles  The percentiles to print, see cominitStatsPercentile().
+ * @param columns      The number of percentiles.
+ */
+void cominitStatsPrintRow(const char *name, int nameWidth, uint64_t *samples, size_t count,
+                          const unsigned int *percentiles, size_t columns);
+
+#endif /* __STATS_H__ */
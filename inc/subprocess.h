@@ -7,11 +7,39 @@
 #ifndef __SUBPROCESS_H__
 #define __SUBPROCESS_H__
 
+#include <limits.h>
 #include <stddef.h>
+#include <sys/types.h>
+
+#ifndef COMINIT_SUBPROCESS_MAX
+/** Maximum number of subprocesses started and not yet collected by cominitSubprocessWait(). **/
+#define COMINIT_SUBPROCESS_MAX 16
+#endif
+/** Timeout for a subprocess that may run as long as it needs. **/
+#define COMINIT_SUBPROCESS_NO_TIMEOUT UINT_MAX
+#ifndef COMINIT_SUBPROCESS_TIMEOUT_MS
+/** Default time in milliseconds a subprocess may run before it is terminated. **/
+#define COMINIT_SUBPROCESS_TIMEOUT_MS 120000
+#endif
+#ifndef COMINIT_SUBPROCESS_FORMAT_TIMEOUT_MS
+/**
+ * Time in milliseconds a subprocess creating or formatting a volume may run. None by default, as the Argon2 benchmark
+ * of cryptsetup and mkfs on a large or slow device may take far longer than COMINIT_SUBPROCESS_TIMEOUT_MS, and killing
+ * them leaves a half-written header or filesystem behind.
+ **/
+#define COMINIT_SUBPROCESS_FORMAT_TIMEOUT_MS COMINIT_SUBPROCESS_NO_TIMEOUT
+#endif
+#ifndef COMINIT_SUBPROCESS_KILL_GRACE_MS
+/** Time in milliseconds a subprocess gets to exit after SIGTERM before it is killed with SIGKILL. **/
+#define COMINIT_SUBPROCESS_KILL_GRACE_MS 1000
+#endif
 
 /**
  * Spawn a subprocess and feed it data on stdin.
  *
+ * The output of the subprocess is captured and logged line by line, stdout as debug and stderr as info message. The
+ * subprocess is terminated if it does not exit within COMINIT_SUBPROCESS_TIMEOUT_MS.
+ *
  * @param path      Absolute path to the program to execute.
  * @param argv      Null‑terminated array of argument strings; argv[0] should be
  *                  the program name and the last element must be NULL.
@@ -24,9 +52,32 @@
 int cominitSubprocessSpawnAndWrite(const char *path, char *const argv[], char *const env[], const void *data,
                                    size_t dataSize);
 
+/**
+ * Spawn a subprocess and feed it data on stdin, with a custom deadline.
+ *
+ * Same as cominitSubprocessSpawnAndWrite(), but the subprocess is terminated after @p timeoutMs as described for
+ * cominitSubprocessStartWithTimeout().
+ *
+ * @param path       Absolute path to the program to execute.
+ * @param argv       Null‑terminated array of argument strings; argv[0] should be
+ *                   the program name and the last element must be NULL.
+ * @param env        The environment for the new process. This must be a NULL‑terminated.
+ * @param data       Pointer to the buffer containing data to write to the child’s stdin.
+ * @param dataSize   Number of bytes from @p data to write into stdin.
+ * @param timeoutMs  Time in milliseconds the process may run, must not be 0, or COMINIT_SUBPROCESS_NO_TIMEOUT.
+ *
+ * @return  EXIT_SUCCESS on success, EXIT_FAILURE otherwise
+ */
+int cominitSubprocessSpawnAndWriteWithTimeout(const char *path, char *const argv[], char *const env[], const void *data,
+                                              size_t dataSize, unsigned int timeoutMs);
+
 /**
  * Spawn a subprocess.
  *
+ * stdin of the subprocess is connected to /dev/null, its output is captured and logged like for
+ * cominitSubprocessSpawnAndWrite(). The subprocess is terminated if it does not exit within
+ * COMINIT_SUBPROCESS_TIMEOUT_MS.
+ *
  * @param path  Absolute path to the program to execute.
  * @param argv  Null‑terminated array of argument strings; argv[0] should be
  *              the program name and the last element must be NULL.
@@ -36,4 +87,65 @@ int cominitSubprocessSpawnAndWrite(const char *path, char *const argv[], char *c
  */
 int cominitSubprocessSpawn(const char *path, char *const argv[], char *const env[]);
 
+/**
+ * Spawn a subprocess, with a custom deadline.
+ *
+ * Same as cominitSubprocessSpawn(), but the subprocess is terminated after @p timeoutMs as described for
+ * cominitSubprocessStartWithTimeout().
+ *
+ * @param path       Absolute path to the program to execute.
+ * @param argv       Null‑terminated array of argument strings; argv[0] should be
+ *                   the program name and the last element must be NULL.
+ * @param env        The environment for the new process. This must be a NULL‑terminated.
+ * @param timeoutMs  Time in milliseconds the process may run, must not be 0, or COMINIT_SUBPROCESS_NO_TIMEOUT.
+ *
+ * @return  EXIT_SUCCESS on success, EXIT_FAILURE otherwise
+ */
+int cominitSubprocessSpawnWithTimeout(const char *path, char *const argv[], char *const env[], unsigned int timeoutMs);
+
+/**
+ * Start a subprocess without waiting for it.
+ *
+ * Used to run several independent programs concurrently, each started process must be reaped with
+ * cominitSubprocessWait(). Up to COMINIT_SUBPROCESS_MAX processes can run at the same time. The process is
+ * terminated if it does not exit within COMINIT_SUBPROCESS_TIMEOUT_MS.
+ *
+ * @param path  Absolute path to the program to execute.
+ * @param argv  Null‑terminated array of argument strings; argv[0] should be
+ *              the program name and the last element must be NULL.
+ * @param env   The environment for the new process. This must be a NULL‑terminated.
+ *
+ * @return  The PID of the started process on success, -1 otherwise
+ */
+pid_t cominitSubprocessStart(const char *path, char *const argv[], char *const env[]);
+
+/**
+ * Start a subprocess without waiting for it, with a custom deadline.
+ *
+ * Same as cominitSubprocessStart(), but the process is sent SIGTERM after @p timeoutMs and SIGKILL
+ * COMINIT_SUBPROCESS_KILL_GRACE_MS later. A process terminated this way is reported as failed by
+ * cominitSubprocessWait(). With COMINIT_SUBPROCESS_NO_TIMEOUT the process is never terminated.
+ *
+ * @param path       Absolute path to the program to execute.
+ * @param argv       Null‑terminated array of argument strings; argv[0] should be
+ *                   the program name and the last element must be NULL.
+ * @param env        The environment for the new process. This must be a NULL‑terminated.
+ * @param timeoutMs  Time in milliseconds the process may run, must not be 0, or COMINIT_SUBPROCESS_NO_TIMEOUT.
+ *
+ * @return  The PID of the started process on success, -1 otherwise
+ */
+pid_t cominitSubprocessStartWithTimeout(const char *path, char *const argv[], char *const env[],
+                                        unsigned int timeoutMs);
+
+/**
+ * Wait for a subprocess started by cominitSubprocessStart() to terminate.
+ *
+ * While waiting, the output, stdin and deadlines of all other running subprocesses are served as well.
+ *
+ * @param pid  The PID of the process.
+ *
+ * @return  EXIT_SUCCESS if the process exited with 0, EXIT_FAILURE otherwise
+ */
+int cominitSubprocessWait(pid_t pid);
+
 #endif /* __SUBPROCESS_H__ */
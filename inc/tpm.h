@@ -12,23 +12,34 @@
 #include <tss2/tss2_tctildr.h>
 
 #include "common.h"
+#include "helper.h"
+#include "tpmblob.h"
 
 #define COMINIT_TPM_MNT_PT "/tpm"
 #define COMINIT_TPM_BLOB_LOCATION "sealed.blob"
+#define COMINIT_TPM_EXPECTED_PCRS_LOCATION "expected_pcrs"
+#define COMINIT_TPM_EXPECTED_PCRS_INITRAMFS "/etc/" COMINIT_TPM_EXPECTED_PCRS_LOCATION
 
 #define COMINIT_TPM_SECURE_STORAGE_NAME "secureStorage"
 #define COMINIT_TPM_SECURE_STORAGE_KEY_NAME COMINIT_TPM_SECURE_STORAGE_NAME
 #define COMINIT_TPM_SECURE_STORAGE_MNT "/newroot/mnt"
+#define COMINIT_TPM_SECURE_STORAGE_MNT_DEFERRED COMINIT_HELPER_ROOTFS "/mnt"
+#define COMINIT_TPM_SECURE_STORAGE_MARKER "secure-storage"
 #define COMINIT_TPM_SECURE_STORAGE_LOCATION "/dev/" DM_DIR "/" COMINIT_TPM_SECURE_STORAGE_NAME
 
 #define POLICY_FAILURE_RC 0x0000099d  ///< return code on policy failure.
 
+#define COMINIT_TPM_PCR_SELECT_SIZE 3                         ///< Size of the PCR bitmap, covers PCR 0 to 23.
+#define COMINIT_TPM_PCR_MAX (COMINIT_TPM_PCR_SELECT_SIZE * 8)  ///< Number of PCRs that can be selected.
+
 /**
  * Structure holding Tpm Context that is acquired during RT.
  */
 typedef struct cominitTpmContext {
     ESYS_CONTEXT *esysCtx;       ///< The Pointer to the ESYS context handle returned by Esys_Initialize().
     TSS2_TCTI_CONTEXT *tctiCtx;  ///< The Pointer to the TCTI context handle returned by Tss2_TctiLdr_Initialize().
+    unsigned int pcrBanks;       ///< The active PCR banks as #COMINIT_CRYPTO_DIGEST_SHA256 etc., 0 until queried.
+    bool formatPending;          ///< Set by cominitTpmProtectData() if formatting is left to the helper.
 } cominitTpmContext_t;
 
 /**
@@ -43,11 +54,95 @@ typedef enum {
 
 /**
  * Mounts the dm crypt device to the new root.
- * Mount point is defined in #COMINIT_TPM_SECURE_STORAGE_MNT.
+ *
+ * @param mountPoint    The mount point, #COMINIT_TPM_SECURE_STORAGE_MNT before switching into the rootfs or
+ *                      #COMINIT_TPM_SECURE_STORAGE_MNT_DEFERRED from the helper process afterwards.
+ *
+ * @return  EXIT_SUCCESS on success, EXIT_FAILURE otherwise
+ */
+int cominitTpmMountSecureStorage(const char *mountPoint);
+
+/**
+ * Data handed to the Secure Storage helper.
+ */
+typedef struct cominitTpmHelperData {
+    cominitTpmContext_t *tpmCtx;  ///< The TPM context the helper opens, released by cominit before the helper starts.
+    cominitCliArgs_t *argCtx;     ///< The parsed options.
+} cominitTpmHelperData_t;
+
+/**
+ * Formats the opened Secure Storage volume if cominitTpmProtectData() left that to the helper.
+ *
+ * Only formats if cominitTpmContext_t::formatPending is set, i.e. the sealed blob says the filesystem has not been
+ * created yet, and the volume still holds no ext4 superblock. The blob keeps saying so until a later boot finds the
+ * filesystem, so a formatting interrupted by a power loss resumes on the next boot. A volume that cannot be read is
+ * not formatted. Meant to run as cominitHelperTask_t right after the helper has been started in deferred mode.
+ *
+ * @param data  Pointer to a cominitTpmHelperData_t.
  *
  * @return  EXIT_SUCCESS on success, EXIT_FAILURE otherwise
  */
-int cominitTpmMountSecureStorage();
+int cominitTpmPrepareSecureStorage(void *data);
+
+/**
+ * Unseals the Secure Storage key and opens the volume in detached mode.
+ *
+ * Opens a TPM context of its own, as the context of cominit cannot be shared across fork(). Then runs
+ * cominitTpmProtectData(), handles a policy failure and releases the TPM. Meant to run as cominitHelperTask_t right
+ * after the helper has been started, so the TPM work overlaps with the rootfs setup of cominit. cominit waits for it
+ * via cominitHelperWaitPrepared() before the exec, as the rootfs init may extend the PCRs the key is sealed to.
+ * Formatting is left to cominitTpmFinishSecureStorage().
+ *
+ * @param data  Pointer to a cominitTpmHelperData_t.
+ *
+ * @return  EXIT_SUCCESS on success, EXIT_FAILURE otherwise
+ */
+int cominitTpmUnlockSecureStorage(void *data);
+
+/**
+ * Mounts the Secure Storage from the helper process.
+ *
+ * Formats the opened volume via cominitTpmPrepareSecureStorage() if still needed and mounts it to
+ * #COMINIT_TPM_SECURE_STORAGE_MNT_DEFERRED. Meant to run as cominitHelperTask_t after the rootfs init has started.
+ *
+ * @param data  Pointer to a cominitTpmHelperData_t.
+ *
+ * @return  EXIT_SUCCESS on success, EXIT_FAILURE otherwise
+ */
+int cominitTpmFinishSecureStorage(void *data);
+
+/**
+ * Parses the Secure Storage mode (`sync`, `deferred` or `detached`) from argv.
+ *
+ * Called by cominit if its uses TPM.
+ *
+ * @param argCtx   Pointer to the structure that receives the parsed options.
+ * @param argValue  The parsed value of the argument found in the provided argument vector.
+ * @return  EXIT_SUCCESS on success, EXIT_FAILURE otherwise
+ */
+int cominitTpmParseSecureStorageMode(cominitCliArgs_t *argCtx, const char *argValue);
+
+/**
+ * Parses where the sealed blob is stored (`ext4`, `raw`, `nv` or `nv:<index>`) from argv.
+ *
+ * Called by cominit if its uses TPM.
+ *
+ * @param argCtx   Pointer to the structure that receives the parsed options.
+ * @param argValue  The parsed value of the argument found in the provided argument vector.
+ * @return  EXIT_SUCCESS on success, EXIT_FAILURE otherwise
+ */
+int cominitTpmParseBlobStorage(cominitCliArgs_t *argCtx, const char *argValue);
+
+/**
+ * Parses the additional encrypted volumes (`<name>:<partition GUID>[:create][,...]`) from argv.
+ *
+ * Called by cominit if its uses TPM. The device nodes are resolved later from the partition GUIDs.
+ *
+ * @param argCtx   Pointer to the structure that receives the parsed options.
+ * @param argValue  The parsed value of the argument found in the provided argument vector.
+ * @return  EXIT_SUCCESS on success, EXIT_FAILURE otherwise
+ */
+int cominitTpmParseCryptVolumes(cominitCliArgs_t *argCtx, const char *argValue);
 
 /**
  * Handles failure on a TPM policy check.
@@ -73,6 +168,32 @@ int cominitTpmHandlePolicyFailure(cominitTpmContext_t *tpmCtx);
  */
 cominitTpmState_t cominitTpmProtectData(cominitTpmContext_t *tpmCtx, cominitCliArgs_t *argCtx);
 
+/**
+ * Seals a newly generated passphrase to the PCR policy and gets the used primary key.
+ *
+ * The policy covers the current (or expected) values of the PCRs in \a argCtx. The primary key is taken from or created
+ * at the persistent handle in \a argCtx.
+ *
+ * @param ectx  The Pointer to the initialized ESYS_CONTEXT handle.
+ * @param blob  Pointer to the structure that receives the sealed object, the PCR selection and the policy digest.
+ * @param argCtx Pointer to the structure that holds the parsed options.
+ * @return  EXIT_SUCCESS on success, EXIT_FAILURE otherwise
+ */
+int cominitTpmSeal(ESYS_CONTEXT *ectx, cominitTpmBlob_t *blob, cominitCliArgs_t *argCtx);
+
+/**
+ * Unseals a sealed passphrase and adds it to the user keyring.
+ *
+ * Loads the sealed object under the primary key at the persistent handle in \a argCtx and satisfies its policy with
+ * the current values of the PCRs recorded in \a blob, or of the PCRs in \a argCtx for blobs of earlier versions.
+ *
+ * @param ectx  The Pointer to the initialized ESYS_CONTEXT handle.
+ * @param blob  Pointer to the structure that holds the sealed object.
+ * @param argCtx Pointer to the structure that holds the parsed options.
+ * @return  Unsealed=2 on success, TpmPolicyFailure=1 or TpmFailure=0 otherwise
+ */
+cominitTpmState_t cominitTpmUnseal(ESYS_CONTEXT *ectx, const cominitTpmBlob_t *blob, cominitCliArgs_t *argCtx);
+
 /**
  * Parses the PCR index from argv that should be extended.
  *
@@ -84,6 +205,51 @@ cominitTpmState_t cominitTpmProtectData(cominitTpmContext_t *tpmCtx, cominitCliA
  */
 int cominitTpmParsePcrIndex(cominitCliArgs_t *argCtx, const char *argValue);
 
+/**
+ * Parses the index of the PCR that the boot configuration is measured into from argv.
+ *
+ * Called by cominit if its uses TPM. Without this option only the rootfs public key is measured.
+ *
+ * @param argCtx   Pointer to the structure that receives the parsed options.
+ * @param argValue  The parsed value of the argument found in the provided argument vector.
+ * @return  EXIT_SUCCESS on success, EXIT_FAILURE otherwise
+ */
+int cominitTpmParsePcrMeasureIndex(cominitCliArgs_t *argCtx, const char *argValue);
+
+/**
+ * Parses the persistent TPM handle of the storage primary key from argv.
+ *
+ * Called by cominit if its uses TPM. The handle must be in the persistent range (`0x81000000` to `0x81ffffff`).
+ *
+ * @param argCtx   Pointer to the structure that receives the parsed options.
+ * @param argValue  The parsed value of the argument found in the provided argument vector.
+ * @return  EXIT_SUCCESS on success, EXIT_FAILURE otherwise
+ */
+int cominitTpmParsePrimaryHandle(cominitCliArgs_t *argCtx, const char *argValue);
+
+/**
+ * Parses the TPM self-test mode (`incremental` or `full`) from argv.
+ *
+ * Called by cominit if its uses TPM. A full self-test of all TPM algorithms is meant for service boots.
+ *
+ * @param argCtx   Pointer to the structure that receives the parsed options.
+ * @param argValue  The parsed value of the argument found in the provided argument vector.
+ * @return  EXIT_SUCCESS on success, EXIT_FAILURE otherwise
+ */
+int cominitTpmParseSelftest(cominitCliArgs_t *argCtx, const char *argValue);
+
+/**
+ * Parses the TCTI configuration used to access the TPM from argv.
+ *
+ * Called by cominit if its uses TPM. The value is passed to Tss2_TctiLdr_Initialize(), e.g. `device:/dev/tpmrm0` or
+ * `swtpm:host=127.0.0.1,port=2321`.
+ *
+ * @param argCtx   Pointer to the structure that receives the parsed options.
+ * @param argValue  The parsed value of the argument found in the provided argument vector.
+ * @return  EXIT_SUCCESS on success, EXIT_FAILURE otherwise
+ */
+int cominitTpmParseTcti(cominitCliArgs_t *argCtx, const char *argValue);
+
 /**
  * Parses a list of PCR indexes from argv to build a policy for sealing data.
  *
@@ -107,6 +273,8 @@ int cominitDeleteTpm(cominitTpmContext_t *tpmCtx);
 /**
  * Extends the PCR by the given signature
  *
+ * The digest of the public key is extended into all active SHA-256 and SHA-384 PCR banks with one TPM command.
+ *
  * @param tpmCtx   The TPM context.
  * @param keyfile   The Pointer to the file that contains the public key for
  * @param pcrIndex  The index of the PCR to extend.
@@ -115,17 +283,68 @@ int cominitDeleteTpm(cominitTpmContext_t *tpmCtx);
  */
 int cominitTpmExtendPCR(cominitTpmContext_t *tpmCtx, const char *keyfile, unsigned long pcrIndex);
 
+/**
+ * Measures a buffer into a PCR.
+ *
+ * The digests for all active SHA-256 and SHA-384 PCR banks are computed in one pass over \a data and extended with a
+ * single TPM command. The active banks are queried from the TPM on first use and kept in \a tpmCtx.
+ *
+ * @param tpmCtx    The TPM context.
+ * @param pcrIndex  The index of the PCR to extend.
+ * @param data      The data to measure.
+ * @param dataLen   The amount of Bytes in \a data.
+ *
+ * @return  EXIT_SUCCESS on success, EXIT_FAILURE otherwise
+ */
+int cominitTpmMeasure(cominitTpmContext_t *tpmCtx, unsigned long pcrIndex, const uint8_t *data, size_t dataLen);
+
+/**
+ * Measures the boot configuration.
+ *
+ * If `pcrExtend` is set, only the rootfs public key is extended into that PCR, as before. If `pcrMeasure` is set, the
+ * verified partition metadata, the dm-verity root hash (if the rootfs uses dm-verity) and the Kernel command line are
+ * extended, in this order, into that PCR. Each measurement takes one TPM command for all PCR banks.
+ *
+ * @param tpmCtx   The TPM context.
+ * @param rfsMeta  The verified metadata of the rootfs.
+ * @param keyfile  The file that contains the public key the metadata was verified with.
+ * @param argCtx   Pointer to the structure that holds the parsed options.
+ *
+ * @return  EXIT_SUCCESS on success, EXIT_FAILURE otherwise
+ */
+int cominitTpmMeasureBoot(cominitTpmContext_t *tpmCtx, const cominitRfsMetaData_t *rfsMeta, const char *keyfile,
+                          const cominitCliArgs_t *argCtx);
+
+/**
+ * Reads the current values of SHA-256 PCRs.
+ *
+ * All PCRs are read in as few TPM2_PCR_Read commands as possible, the same way the PCR values recorded in the sealed
+ * blob are checked before unsealing.
+ *
+ * @param tpmCtx     The TPM context.
+ * @param pcrs       The indexes of the PCRs to read.
+ * @param pcrCount   The number of indexes in \a pcrs.
+ * @param pcrValues  Array of #COMINIT_TPM_PCR_MAX entries receiving the PCR values, indexed by PCR.
+ *
+ * @return  EXIT_SUCCESS if all PCRs were read, EXIT_FAILURE otherwise
+ */
+int cominitTpmReadPcrValues(cominitTpmContext_t *tpmCtx, const unsigned long *pcrs, int pcrCount,
+                            uint8_t pcrValues[][TPM2_SHA256_DIGEST_SIZE]);
+
 /**
  * Acquires shared run‑time resources that the TPM module
  * needs during execution.
  *
+ * Runs an incremental self-test of the algorithms used by cominit, or a full self-test if requested in \a argCtx.
+ *
  * @param tpmCtx   The TPM context.
+ * @param argCtx   Pointer to the structure that holds the parsed options.
  * @return  EXIT_SUCCESS on success, EXIT_FAILURE otherwise
  */
-int cominitInitTpm(cominitTpmContext_t *tpmCtx);
+int cominitInitTpm(cominitTpmContext_t *tpmCtx, cominitCliArgs_t *argCtx);
 
 /**
- * Checks if option Extension of PCR is enabled.
+ * Checks if option Extension of PCR is enabled, i.e. `pcrExtend` or `pcrMeasure` is set.
  *
  * @param argCtx   Pointer to the structure that holds the parsed options.
  *
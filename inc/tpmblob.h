@@ -0,0 +1,197 @@
+// SPDX-License-Identifier: MIT
+/**
+ * @file tpmblob.h
+ * @brief Header related to the storage format of the TPM sealed blob.
+ */
+#ifndef __TPMBLOB_H__
+#define __TPMBLOB_H__
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <tss2/tss2_esys.h>
+#include <tss2/tss2_tpm2_types.h>
+
+#define COMINIT_TPMBLOB_MAGIC "CTPB"    ///< Magic Bytes at the start of a serialized blob.
+#define COMINIT_TPMBLOB_VERSION 3       ///< Current version of the serialized blob format.
+#define COMINIT_TPMBLOB_HEADER_SIZE 12  ///< Size of magic, version, sequence number and payload length.
+#define COMINIT_TPMBLOB_PCR_MAX 24      ///< Number of PCRs whose sealed values a blob can record.
+#define COMINIT_TPMBLOB_CRC_SIZE 4      ///< Size of the trailing CRC32.
+
+#define COMINIT_TPMBLOB_FLAG_CREATE 0x1u  ///< The Secure Storage volume has not been created yet.
+#define COMINIT_TPMBLOB_FLAG_FORMAT 0x2u  ///< The Secure Storage filesystem has not been created yet.
+
+#define COMINIT_TPMBLOB_VOLUMES_MAX 8      ///< Number of additional volumes a blob can record as created.
+#define COMINIT_TPMBLOB_VOLUME_ID_SIZE 16  ///< Size of the binary unique partition GUID identifying a volume.
+
+#define COMINIT_TPMBLOB_RAW_SLOT_SIZE 4096  ///< Size of each of the two copies on a raw partition.
+#define COMINIT_TPMBLOB_NV_SIZE 2048        ///< Size of the TPM NV index holding a blob.
+#define COMINIT_TPMBLOB_NV_CHUNK_SIZE 512   ///< Bytes per TPM2_NV_Read/TPM2_NV_Write, below the limit of common TPMs.
+
+/**
+ * Maximum size of a serialized blob.
+ *
+ * The marshaled TPM structures are never larger than their in-memory representation.
+ */
+#define COMINIT_TPMBLOB_MAX_SIZE                                                                             \
+    (COMINIT_TPMBLOB_HEADER_SIZE + sizeof(TPML_PCR_SELECTION) + sizeof(TPM2B_DIGEST) + sizeof(TPM2B_PUBLIC) + \
+     sizeof(TPM2B_PRIVATE) + COMINIT_TPMBLOB_PCR_MAX * sizeof(TPM2B_DIGEST) + 2 * sizeof(uint32_t) +          \
+     COMINIT_TPMBLOB_VOLUMES_MAX * COMINIT_TPMBLOB_VOLUME_ID_SIZE + COMINIT_TPMBLOB_CRC_SIZE)
+
+/**
+ * A sealed object together with the policy it was sealed to.
+ */
+typedef struct cominitTpmBlob {
+    uint16_t sequence;                ///< Sequence number of the copy on a raw partition, 0 otherwise.
+    TPML_PCR_SELECTION pcrSelection;  ///< The PCRs covered by the policy, count is 0 if unknown.
+    TPM2B_DIGEST policyDigest;        ///< The policy digest of the sealed object.
+    TPM2B_PUBLIC outPublic;           ///< The public area of the sealed object.
+    TPM2B_PRIVATE outPrivate;         ///< The private area of the sealed object.
+    /** The sealed values of the selected PCRs indexed by PCR, size is 0 if not recorded. */
+    TPM2B_DIGEST pcrValues[COMINIT_TPMBLOB_PCR_MAX];
+    uint32_t flags;  ///< #COMINIT_TPMBLOB_FLAG_CREATE and #COMINIT_TPMBLOB_FLAG_FORMAT, 0 for earlier versions.
+    uint32_t volumeCount;  ///< The number of additional volumes recorded as created.
+    /** The unique partition GUIDs of the additional volumes that have been created, in text order of the digits. */
+    uint8_t volumes[COMINIT_TPMBLOB_VOLUMES_MAX][COMINIT_TPMBLOB_VOLUME_ID_SIZE];
+} cominitTpmBlob_t;
+
+/**
+ * Serializes a blob.
+ *
+ * The format is independent of compiler and tpm2-tss version. All numbers are big endian:
+ *
+ * | Offset | Size | Content                                                                  |
+ * |--------|------|--------------------------------------------------------------------------|
+ * | 0      | 4    | #COMINIT_TPMBLOB_MAGIC                                                   |
+ * | 4      | 2    | #COMINIT_TPMBLOB_VERSION                                                 |
+ * | 6      | 2    | sequence number, see cominitTpmBlobRawSave()                             |
+ * | 8      | 4    | payload length n                                                         |
+ * | 12     | n    | marshaled TPML_PCR_SELECTION, TPM2B_DIGEST, TPM2B_PUBLIC, TPM2B_PRIVATE |
+ * | 12 + n | 4    | CRC32 of all preceding Bytes                                             |
+ *
+ * Since version 2 the payload ends with one marshaled TPM2B_DIGEST per PCR selected in the first bank, in ascending
+ * order of the PCR index. Since version 3 it is followed by the 4 Byte cominitTpmBlob_t::flags, the 4 Byte
+ * cominitTpmBlob_t::volumeCount and as many 16 Byte IDs of created volumes. Blobs of earlier versions are still
+ * deserialized, without PCR values (version 1), with no flags set and no volumes recorded.
+ *
+ * @param blob      The blob to serialize.
+ * @param buffer    The buffer receiving the serialized blob, should hold #COMINIT_TPMBLOB_MAX_SIZE Bytes.
+ * @param bufferSize The size of \a buffer.
+ * @param length    Pointer to a variable that receives the size of the serialized blob.
+ *
+ * @return  EXIT_SUCCESS on success, EXIT_FAILURE otherwise
+ */
+int cominitTpmBlobSerialize(const cominitTpmBlob_t *blob, uint8_t *buffer, size_t bufferSize, size_t *length);
+
+/**
+ * Deserializes a blob written by cominitTpmBlobSerialize().
+ *
+ * Fails on a wrong magic, an unknown version, a length mismatch or a CRC mismatch.
+ *
+ * @param blob      The structure that receives the blob.
+ * @param buffer    The serialized blob.
+ * @param length    The size of the serialized blob.
+ *
+ * @return  EXIT_SUCCESS on success, EXIT_FAILURE otherwise
+ */
+int cominitTpmBlobDeserialize(cominitTpmBlob_t *blob, const uint8_t *buffer, size_t length);
+
+/**
+ * Saves a blob to a file atomically.
+ *
+ * Writes a temporary file next to \a path, syncs it and renames it to \a path, so a power loss leaves either the old
+ * or the new blob.
+ *
+ * @param blob  The blob to save.
+ * @param path  The path of the blob file.
+ *
+ * @return  EXIT_SUCCESS on success, EXIT_FAILURE otherwise
+ */
+int cominitTpmBlobSave(const cominitTpmBlob_t *blob, const char *path);
+
+/**
+ * Loads a blob from a file with a single read.
+ *
+ * Blobs written by earlier versions of cominit as raw TPM2B_PUBLIC and TPM2B_PRIVATE structures are still accepted.
+ * For those the PCR selection is unknown and the policy digest is taken from the public area.
+ *
+ * @param blob  The structure that receives the blob.
+ * @param path  The path of the blob file.
+ *
+ * @return  EXIT_SUCCESS on success, EXIT_FAILURE otherwise
+ */
+int cominitTpmBlobLoad(cominitTpmBlob_t *blob, const char *path);
+
+/**
+ * Loads a blob from an unformatted partition with a single read.
+ *
+ * The partition holds two copies of the serialized blob, one at offset 0 and one at #COMINIT_TPMBLOB_RAW_SLOT_SIZE.
+ * The valid copy with the higher sequence number is used.
+ *
+ * @param blob  The structure that receives the blob.
+ * @param device  The partition device node.
+ * @param empty  Pointer to a flag that is set if neither copy has been written completely yet.
+ *
+ * @return  EXIT_SUCCESS if a valid copy was loaded or the partition is empty, EXIT_FAILURE otherwise
+ */
+int cominitTpmBlobRawLoad(cominitTpmBlob_t *blob, const char *device, bool *empty);
+
+/**
+ * Saves a blob to an unformatted partition.
+ *
+ * The blob is written with the next sequence number over the older or invalid copy, so a power loss during the
+ * update leaves the previous copy intact. The magic Bytes of the copy are written and synced last, so a power loss
+ * during the very first save leaves the partition empty.
+ *
+ * @param blob  The blob to save.
+ * @param device  The partition device node.
+ *
+ * @return  EXIT_SUCCESS on success, EXIT_FAILURE otherwise
+ */
+int cominitTpmBlobRawSave(const cominitTpmBlob_t *blob, const char *device);
+
+/**
+ * Loads a blob from a TPM NV index.
+ *
+ * Blobs sealed by cominit fit into a single TPM2_NV_Read of #COMINIT_TPMBLOB_NV_CHUNK_SIZE Bytes.
+ *
+ * @param ectx  The Pointer to the initialized ESYS_CONTEXT handle.
+ * @param nvIndex  The NV index.
+ * @param blob  The structure that receives the blob.
+ * @param empty  Pointer to a flag that is set if the NV index is not defined or has never been written.
+ *
+ * @return  EXIT_SUCCESS if the blob was loaded or the NV index is empty, EXIT_FAILURE otherwise, also if the NV index
+ *          holds no valid blob
+ */
+int cominitTpmBlobNvLoad(ESYS_CONTEXT *ectx, TPM2_HANDLE nvIndex, cominitTpmBlob_t *blob, bool *empty);
+
+/**
+ * Saves a blob to a TPM NV index.
+ *
+ * Defines the NV index with #COMINIT_TPMBLOB_NV_SIZE Bytes in the owner hierarchy and with TPMA_NV_WRITE_STCLEAR if
+ * needed. The update is not atomic unless the blob fits into one #COMINIT_TPMBLOB_NV_CHUNK_SIZE write: a power loss
+ * during the save leaves an invalid blob, the NV index then has to be undefined and provisioned again.
+ *
+ * @param ectx  The Pointer to the initialized ESYS_CONTEXT handle.
+ * @param nvIndex  The NV index.
+ * @param blob  The blob to save.
+ *
+ * @return  EXIT_SUCCESS on success, EXIT_FAILURE otherwise
+ */
+int cominitTpmBlobNvSave(ESYS_CONTEXT *ectx, TPM2_HANDLE nvIndex, const cominitTpmBlob_t *blob);
+
+/**
+ * Write-locks the NV index holding the blob until the next TPM reset.
+ *
+ * Called once cominit is done with the blob, so the rootfs cannot replace it with the empty owner authorization. An
+ * NV index defined without TPMA_NV_WRITE_STCLEAR by an earlier version cannot be locked and is left writable with a
+ * warning.
+ *
+ * @param ectx  The Pointer to the initialized ESYS_CONTEXT handle.
+ * @param nvIndex  The NV index.
+ *
+ * @return  EXIT_SUCCESS if the NV index is locked, not defined or cannot be locked, EXIT_FAILURE otherwise
+ */
+int cominitTpmBlobNvLock(ESYS_CONTEXT *ectx, TPM2_HANDLE nvIndex);
+
+#endif /* __TPMBLOB_H__ */
@@ -0,0 +1,94 @@
+// SPDX-License-Identifier: MIT
+/**
+ * @file tpmprofile.h
+ * @brief Header related to the latency profiling of TPM commands.
+ */
+#ifndef __TPMPROFILE_H__
+#define __TPMPROFILE_H__
+
+#include <stdint.h>
+#include <tss2/tss2_common.h>
+
+/**
+ * The profiled TPM commands.
+ */
+typedef enum {
+    COMINIT_TPM_CMD_SELFTEST = 0,          ///< Esys_SelfTest()
+    COMINIT_TPM_CMD_INCREMENTAL_SELFTEST,  ///< Esys_IncrementalSelfTest()
+    COMINIT_TPM_CMD_GET_TEST_RESULT,       ///< Esys_GetTestResult()
+    COMINIT_TPM_CMD_CREATE_PRIMARY,        ///< Esys_CreatePrimary()
+    COMINIT_TPM_CMD_EVICT_CONTROL,         ///< Esys_EvictControl()
+    COMINIT_TPM_CMD_READ_PUBLIC,           ///< Esys_ReadPublic() and Esys_TR_FromTPMPublic()
+    COMINIT_TPM_CMD_CREATE,                ///< Esys_Create()
+    COMINIT_TPM_CMD_LOAD,                  ///< Esys_Load()
+    COMINIT_TPM_CMD_START_AUTH_SESSION,    ///< Esys_StartAuthSession()
+    COMINIT_TPM_CMD_POLICY_PCR,            ///< Esys_PolicyPCR()
+    COMINIT_TPM_CMD_UNSEAL,                ///< Esys_Unseal()
+    COMINIT_TPM_CMD_PCR_READ,              ///< Esys_PCR_Read()
+    COMINIT_TPM_CMD_PCR_EXTEND,            ///< Esys_PCR_Extend()
+    COMINIT_TPM_CMD_GET_CAPABILITY,        ///< Esys_GetCapability()
+    COMINIT_TPM_CMD_FLUSH_CONTEXT,         ///< Esys_FlushContext()
+    COMINIT_TPM_CMD_NV_DEFINE_SPACE,       ///< Esys_NV_DefineSpace()
+    COMINIT_TPM_CMD_NV_READ,               ///< Esys_NV_Read()
+    COMINIT_TPM_CMD_NV_WRITE,              ///< Esys_NV_Write()
+    COMINIT_TPM_CMD_NV_WRITE_LOCK,         ///< Esys_NV_WriteLock()
+    COMINIT_TPM_CMD_COUNT,                 ///< The number of profiled commands.
+} cominitTpmCommand_t;
+
+/**
+ * Statistics of a profiled TPM command.
+ */
+typedef struct cominitTpmProfileEntry {
+    uint32_t count;    ///< The number of calls.
+    uint32_t failed;   ///< The number of calls that did not return TSS2_RC_SUCCESS.
+    TSS2_RC lastRc;    ///< The response code of the last failed call.
+    uint64_t totalNs;  ///< The accumulated latency in nanoseconds.
+    uint64_t maxNs;    ///< The maximum latency in nanoseconds.
+} cominitTpmProfileEntry_t;
+
+/**
+ * Starts the latency measurement of a TPM command.
+ *
+ * @param cmd  The command.
+ */
+void cominitTpmProfileBegin(cominitTpmCommand_t cmd);
+
+/**
+ * Ends the latency measurement of a TPM command started by cominitTpmProfileBegin().
+ *
+ * @param cmd  The command.
+ * @param rc  The response code of the command.
+ *
+ * @return  \a rc
+ */
+TSS2_RC cominitTpmProfileEnd(cominitTpmCommand_t cmd, TSS2_RC rc);
+
+/**
+ * Gets the statistics of a TPM command.
+ *
+ * @param cmd  The command.
+ *
+ * @return  The statistics, NULL if \a cmd is invalid
+ */
+const cominitTpmProfileEntry_t *cominitTpmProfileGet(cominitTpmCommand_t cmd);
+
+/**
+ * Logs the statistics of all TPM commands called so far at info level.
+ */
+void cominitTpmProfileReport(void);
+
+/**
+ * Calls an ESAPI function and records its latency and response code if built with `-DTPM_PROFILE=On`.
+ *
+ * The comma operator guarantees that the measurement starts before \a call is evaluated.
+ *
+ * @param cmd  The #cominitTpmCommand_t of the call.
+ * @param call  The ESAPI function call returning a TSS2_RC.
+ */
+#ifdef COMINIT_TPM_PROFILE
+#define cominitTpmProfileCall(cmd, call) (cominitTpmProfileBegin(cmd), cominitTpmProfileEnd((cmd), (call)))
+#else
+#define cominitTpmProfileCall(cmd, call) (call)
+#endif
+
+#endif /* __TPMPROFILE_H__ */
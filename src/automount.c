@@ -10,40 +10,17 @@
 #include <ctype.h>
 #include <dirent.h>
 #include <endian.h>
-#include <fcntl.h>
 #include <inttypes.h>
-#include <linux/fs.h>
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
-#include <sys/ioctl.h>
 #include <sys/stat.h>
-#include <unistd.h>
 
+#include "blockdev.h"
 #include "common.h"
 #include "meta.h"
 #include "output.h"
 
-/**
- * Gets the block size of a block device with ioctl().
- *
- * @param fd            The open file descriptor of the block device.
- * @param blockSize     Pointer that receives the block size.
- *
- * @return  EXIT_SUCCESS on success, EXIT_FAILURE otherwise
- */
-static int cominitAutomountGetBlockSize(int fd, int *blockSize) {
-    int result = EXIT_FAILURE;
-
-    if (ioctl(fd, BLKSSZGET, blockSize) < 0) {
-        cominitErrnoPrint("ioctl failed to get block size.");
-    } else {
-        result = EXIT_SUCCESS;
-    }
-
-    return result;
-}
-
 /**
  * Checks wether the given name is black listed.
  *
@@ -76,17 +53,17 @@ static bool cominitAutomountIsBlacklistedName(const char *name) {
  */
 static int cominitAutomountFindGpt(const char *blockDevice, cominitGPTDisk_t *gptDisk) {
     int result = EXIT_FAILURE;
-    int fd = open(blockDevice, O_RDONLY | O_CLOEXEC);
+    int fd = cominitBlockdevOpen(blockDevice);
 
     if (fd < 0) {
         cominitErrnoPrint("could not open disk %s.", blockDevice);
     } else {
-        if (cominitAutomountGetBlockSize(fd, &gptDisk->blockSize) == EXIT_FAILURE) {
+        if (cominitBlockdevGetBlockSize(fd, &gptDisk->blockSize) == EXIT_FAILURE) {
             cominitErrPrint("Could not get block size of disk %s.", blockDevice);
         } else {
             cominitDebugPrint("blockSize: %ld", gptDisk->blockSize);
             cominitGPTHeader_t *hdr = &(gptDisk->hdr);
-            if (pread(fd, hdr, sizeof(*hdr), gptDisk->blockSize) != (ssize_t)sizeof(*hdr)) {
+            if (cominitBlockdevPread(fd, hdr, sizeof(*hdr), gptDisk->blockSize) != (ssize_t)sizeof(*hdr)) {
                 cominitErrnoPrint("Could not read from device %s.", blockDevice);
             } else {
                 if (memcmp(hdr->signature, "EFI PART", sizeof(hdr->signature)) != 0) {
@@ -98,7 +75,7 @@ static int cominitAutomountFindGpt(const char *blockDevice, cominitGPTDisk_t *gp
                 }
             }
         }
-        close(fd);
+        cominitBlockdevClose(fd);
     }
 
     return result;
@@ -153,59 +130,69 @@ static int cominitAutomountBuildPartitionNode(const char *diskName, unsigned idx
 }
 
 /**
- * Tries to find the GUID type inside the GPT header on a given not empty disk @p gptDisk.
+ * Tries to find a GUID inside the partition entries of the GPT on a given not empty disk @p gptDisk.
  * If found the partition device is copied to @p partitionName.
  *
  * @param[in] gptDisk       Pointer to a cominitGPTDisk_t struct containing a valid disk with GPT header.
- * @param[in] guidType      The GUID type that should be looked for in the GPT header.
+ * @param[in] guidOffset    The offset of the compared GUID in a partition entry, one of
+ *                          #COMINIT_GPT_ENTRY_TYPE_GUID_OFFSET or #COMINIT_GPT_ENTRY_UNIQUE_GUID_OFFSET.
+ * @param[in] guid          The GUID that should be looked for in the GPT.
  * @param[out] partitionName    Pointer to a buffer that receives device node of the partition.
  * @param[in] partitionNameSize The size of the buffer.
  *
  * @return  EXIT_SUCCESS on success, EXIT_FAILURE otherwise
  */
-int cominitAutomountFindPartitionOnDisk(cominitGPTDisk_t *gptDisk, const char *guidType, char *partitionName,
-                                        size_t partitionNameSize) {
+static int cominitAutomountFindEntryOnDisk(cominitGPTDisk_t *gptDisk, size_t guidOffset, const char *guid,
+                                           char *partitionName, size_t partitionNameSize) {
     int result = EXIT_FAILURE;
 
-    if (gptDisk == NULL || gptDisk->diskName[0] == '\0' || guidType == NULL || partitionName == NULL ||
+    if (gptDisk == NULL || gptDisk->diskName[0] == '\0' || guid == NULL || partitionName == NULL ||
         partitionNameSize == 0) {
         cominitErrPrint("Invalid parameters");
     } else {
-        int fd = open(gptDisk->diskName, O_RDONLY | O_CLOEXEC);
+        int fd = cominitBlockdevOpen(gptDisk->diskName);
         if (fd < 0) {
             cominitErrnoPrint("Could not open disk %s.", gptDisk->diskName);
         } else {
             cominitGPTHeader_t *hdr = &(gptDisk->hdr);
             uint64_t diskSize = 0;
-            if (cominitCommonGetPartSize(&diskSize, fd) == -1) {
+            if (cominitBlockdevGetSize(fd, &diskSize) == EXIT_FAILURE) {
                 cominitErrPrint("Could not get size of disk %s.", gptDisk->diskName);
             } else {
                 uint32_t partitionEntrySize = hdr->partitionEntrySize;
-                if (partitionEntrySize < GPT_HEADER_DEFAULT_ENTRY_SIZE || partitionEntrySize > diskSize) {
+                if (partitionEntrySize < GPT_HEADER_DEFAULT_ENTRY_SIZE || partitionEntrySize > diskSize ||
+                    partitionEntrySize > COMINIT_GPT_ENTRY_READ_SIZE) {
                     cominitErrPrint("Entry size of gpt header invalid.");
                 } else {
-                    uint8_t *entryBuffer = malloc(partitionEntrySize);
-                    if (!entryBuffer) {
-                        cominitErrnoPrint("Allocation of entry buffer failed");
-                    } else {
-                        char typeGuidString[37] = {0};
-                        for (uint32_t entryIndex = 0; entryIndex < hdr->partitionEntryCount; ++entryIndex) {
-                            uint64_t tableBaseBytes = hdr->partitionEntriesLba * (uint64_t)gptDisk->blockSize;
-                            uint64_t entryOffsetBytes = tableBaseBytes + (uint64_t)entryIndex * partitionEntrySize;
-                            if (entryOffsetBytes > diskSize || entryOffsetBytes > UINT64_MAX) {
-                                cominitErrPrint("Entry offset to large.");
-                                break;
-                            }
-                            off_t entryOffset = (off_t)entryOffsetBytes;
-                            ssize_t bytesRead = pread(fd, entryBuffer, partitionEntrySize, entryOffset);
-                            if (bytesRead != (ssize_t)partitionEntrySize) {
-                                cominitErrnoPrint("Could only read %zd bytes from partition entry of %zd byte size)",
-                                                  bytesRead, partitionEntrySize);
-                                break;
-                            }
+                    uint8_t entryBuffer[COMINIT_GPT_ENTRY_READ_SIZE];
+                    uint64_t entriesPerRead = COMINIT_GPT_ENTRY_READ_SIZE / partitionEntrySize;
+                    uint64_t tableBaseBytes = hdr->partitionEntriesLba * (uint64_t)gptDisk->blockSize;
+                    char guidString[37] = {0};
+                    bool found = false;
+                    for (uint64_t firstIndex = 0; firstIndex < hdr->partitionEntryCount && !found;
+                         firstIndex += entriesPerRead) {
+                        uint64_t entryCount = hdr->partitionEntryCount - firstIndex;
+                        if (entryCount > entriesPerRead) {
+                            entryCount = entriesPerRead;
+                        }
+                        uint64_t entryOffsetBytes = tableBaseBytes + firstIndex * partitionEntrySize;
+                        if (entryOffsetBytes > diskSize) {
+                            cominitErrPrint("Entry offset to large.");
+                            break;
+                        }
+                        size_t readSize = (size_t)(entryCount * partitionEntrySize);
+                        ssize_t bytesRead =
+                            cominitBlockdevPread(fd, entryBuffer, readSize, (off_t)entryOffsetBytes);
+                        if (bytesRead != (ssize_t)readSize) {
+                            cominitErrnoPrint("Could only read %zd bytes from partition entries of %zu byte size)",
+                                              bytesRead, readSize);
+                            break;
+                        }
+                        for (uint64_t i = 0; i < entryCount; i++) {
+                            const uint8_t *entry = entryBuffer + i * partitionEntrySize;
                             bool typeGuidAllZero = true;
                             for (int b = 0; b < 16; ++b) {
-                                if (entryBuffer[b] != 0) {
+                                if (entry[b] != 0) {
                                     typeGuidAllZero = false;
                                     break;
                                 }
@@ -213,34 +200,49 @@ int cominitAutomountFindPartitionOnDisk(cominitGPTDisk_t *gptDisk, const char *g
                             if (typeGuidAllZero) {
                                 continue;
                             }
-                            cominitAutomountFormatGuid(entryBuffer, typeGuidString);
-                            if (strcasecmp(typeGuidString, guidType) == 0) {
-                                result = cominitAutomountBuildPartitionNode(gptDisk->diskName, entryIndex + 1,
-                                                                            partitionName, partitionNameSize);
+                            cominitAutomountFormatGuid(entry + guidOffset, guidString);
+                            if (strcasecmp(guidString, guid) == 0) {
+                                result = cominitAutomountBuildPartitionNode(
+                                    gptDisk->diskName, (unsigned)(firstIndex + i + 1), partitionName,
+                                    partitionNameSize);
+                                found = true;
                                 break;
                             }
                         }
-                        free(entryBuffer);
                     }
                 }
             }
-            close(fd);
+            cominitBlockdevClose(fd);
         }
     }
 
     return result;
 }
 
-int cominitAutomountFindPartition(cominitGPTDisk_t *gptDisk, const char *guidType, char *partitionName,
-                                  size_t partitionNameSize) {
+/**
+ * Scans all disks in cominitBlockdevScanDir(), usually the block devices under /dev, for a GUID inside the partition
+ * entries of their GPT.
+ *
+ * @param[out] gptDisk      Pointer to a cominitGPTDisk_t struct that receives the GPT disk where the partition was
+ *                          found.
+ * @param[in] guidOffset    The offset of the compared GUID in a partition entry.
+ * @param[in] guid          The GUID that should be looked for in the GPT.
+ * @param[out] partitionName    Pointer to a buffer that receives device node of the partition.
+ * @param[in] partitionNameSize The size of the buffer.
+ *
+ * @return  EXIT_SUCCESS on success, EXIT_FAILURE otherwise
+ */
+static int cominitAutomountFindEntry(cominitGPTDisk_t *gptDisk, size_t guidOffset, const char *guid,
+                                     char *partitionName, size_t partitionNameSize) {
     int result = EXIT_FAILURE;
-    if (gptDisk == NULL || gptDisk->diskName == NULL || guidType == NULL || partitionName == NULL ||
+    if (gptDisk == NULL || gptDisk->diskName == NULL || guid == NULL || partitionName == NULL ||
         partitionNameSize == 0) {
         cominitErrPrint("Invalid parameters");
     } else {
-        DIR *d = opendir("/dev");
+        const char *scanDir = cominitBlockdevScanDir();
+        DIR *d = opendir(scanDir);
         if (!d) {
-            cominitErrnoPrint("Could not open /dev for gpt disk scan.");
+            cominitErrnoPrint("Could not open %s for gpt disk scan.", scanDir);
         } else {
             struct dirent *deviceEntry = NULL;
             char device[2 * COMINIT_ROOTFS_DEV_PATH_MAX] = {0};
@@ -251,16 +253,16 @@ int cominitAutomountFindPartition(cominitGPTDisk_t *gptDisk, const char *guidTyp
                 if (name[0] == '.') continue;
                 if (cominitAutomountIsBlacklistedName(name)) continue;
 
-                snprintf(device, sizeof(device), "/dev/%s", name);
+                snprintf(device, sizeof(device), "%s/%s", scanDir, name);
                 if (lstat(device, &st) != 0) continue;
                 if (S_ISLNK(st.st_mode)) continue;
-                if (!S_ISBLK(st.st_mode)) continue;
+                if (!cominitBlockdevIsDisk(&st)) continue;
 
                 cominitGPTDisk_t diskToProbe = {0};
                 result = cominitAutomountFindGpt(device, &diskToProbe);
                 if (result == EXIT_SUCCESS) {
-                    result =
-                        cominitAutomountFindPartitionOnDisk(&diskToProbe, guidType, partitionName, partitionNameSize);
+                    result = cominitAutomountFindEntryOnDisk(&diskToProbe, guidOffset, guid, partitionName,
+                                                             partitionNameSize);
                     if (result == EXIT_SUCCESS) {
                         memcpy(gptDisk, &diskToProbe, sizeof(*gptDisk));
                         break;
@@ -272,4 +274,33 @@ int cominitAutomountFindPartition(cominitGPTDisk_t *gptDisk, const char *guidTyp
     }
 
     return result;
-}
\ No newline at end of file
+}
+
+int cominitAutomountFindPartitionOnDisk(cominitGPTDisk_t *gptDisk, const char *guidType, char *partitionName,
+                                        size_t partitionNameSize) {
+    return cominitAutomountFindEntryOnDisk(gptDisk, COMINIT_GPT_ENTRY_TYPE_GUID_OFFSET, guidType, partitionName,
+                                           partitionNameSize);
+}
+
+int cominitAutomountFindPartition(cominitGPTDisk_t *gptDisk, const char *guidType, char *partitionName,
+                                  size_t partitionNameSize) {
+    return cominitAutomountFindEntry(gptDisk, COMINIT_GPT_ENTRY_TYPE_GUID_OFFSET, guidType, partitionName,
+                                     partitionNameSize);
+}
+
+int cominitAutomountFindPartitionByUuid(cominitGPTDisk_t *gptDisk, const char *partUuid, char *partitionName,
+                                        size_t partitionNameSize) {
+    int result = EXIT_FAILURE;
+
+    if (gptDisk == NULL) {
+        cominitErrPrint("Invalid parameters");
+    } else if (gptDisk->diskName[0] != '\0') {
+        result = cominitAutomountFindEntryOnDisk(gptDisk, COMINIT_GPT_ENTRY_UNIQUE_GUID_OFFSET, partUuid,
+                                                 partitionName, partitionNameSize);
+    } else {
+        result = cominitAutomountFindEntry(gptDisk, COMINIT_GPT_ENTRY_UNIQUE_GUID_OFFSET, partUuid, partitionName,
+                                           partitionNameSize);
+    }
+
+    return result;
+}
@@ -0,0 +1,273 @@
+// SPDX-License-Identifier: MIT
+/**
+ * @file bench.c
+ * @brief Implementation of the on-target benchmark of the boot phases.
+ */
+#include "bench.h"
+
+#include <ctype.h>
+#include <errno.h>
+#include <linux/dm-ioctl.h>
+#include <linux/sched.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/mount.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+#include "automount.h"
+#include "crypto.h"
+#include "dmctl.h"
+#include "meta.h"
+#include "output.h"
+#include "stats.h"
+#ifdef COMINIT_USE_TPM
+#include "tpm.h"
+#endif
+#include "version.h"
+
+/**
+ * State shared by the phases of the benchmark.
+ */
+typedef struct cominitBenchState {
+    cominitCliArgs_t *argCtx;                 ///< The parsed options.
+    char rootfs[COMINIT_ROOTFS_DEV_PATH_MAX];  ///< The rootfs partition.
+    cominitRfsMetaData_t rfsMeta;              ///< The metadata loaded by the last repetition.
+#ifdef COMINIT_USE_TPM
+    cominitTpmContext_t tpmCtx;  ///< The TPM context the PCRs are read with.
+#endif
+} cominitBenchState_t;
+
+/**
+ * A repeated phase, returns EXIT_SUCCESS if it succeeded.
+ */
+typedef int (*cominitBenchPhaseFunc_t)(cominitBenchState_t *state);
+
+/**
+ * The percentiles of the durations in the report, minimum, median, 99th percentile and maximum.
+ */
+static const unsigned int cominitBenchPercentiles[] = {0, 50, 99, 100};
+
+/**
+ * Finds the rootfs partition by its GUID type, as done on boot if no `root=` is given.
+ */
+static int cominitBenchGptDiscovery(cominitBenchState_t *state) {
+    cominitGPTDisk_t gptDisk = {0};
+    return cominitAutomountFindPartition(&gptDisk, (const char *)COMINIT_ROOTFS_GUID_TYPE, state->rootfs,
+                                         sizeof(state->rootfs));
+}
+
+/**
+ * Reads the rootfs metadata and verifies its signature, which includes parsing the public key.
+ */
+static int cominitBenchMetadata(cominitBenchState_t *state) {
+    memset(&state->rfsMeta, 0, sizeof(state->rfsMeta));
+    memcpy(state->rfsMeta.devicePath, state->rootfs, sizeof(state->rfsMeta.devicePath));
+    return (cominitLoadVerifyMetadata(&state->rfsMeta, COMINIT_ROOTFS_KEY_LOCATION) == 0) ? EXIT_SUCCESS
+                                                                                           : EXIT_FAILURE;
+}
+
+/**
+ * Parses the rootfs public key and computes its digest, as done to measure the key into the TPM.
+ */
+static int cominitBenchKeyParse(cominitBenchState_t *state) {
+    unsigned char digest[SHA256_LEN];
+    COMINIT_PARAM_UNUSED(state);
+    return cominitCreateSHA256DigestfromKeyfile(COMINIT_ROOTFS_KEY_LOCATION, digest, sizeof(digest));
+}
+
+#ifdef COMINIT_USE_TPM
+/**
+ * Opens the TPM, runs a full self-test and closes the TPM again.
+ */
+static int cominitBenchTpmInit(cominitBenchState_t *state) {
+    cominitTpmContext_t tpmCtx = {0};
+    /* An incremental self-test skips algorithms already tested, so only a full one costs the same every repetition. */
+    cominitCliArgs_t argCtx = *state->argCtx;
+    argCtx.tpmFullSelftest = true;
+
+    int result = cominitInitTpm(&tpmCtx, &argCtx);
+    if (tpmCtx.tctiCtx != NULL) {
+        cominitDeleteTpm(&tpmCtx);
+    }
+    return result;
+}
+
+/**
+ * Reads the PCRs given with `pcrSeal=` or all PCRs.
+ */
+static int cominitBenchPcrRead(cominitBenchState_t *state) {
+    static const unsigned long allPcrs[COMINIT_TPM_PCR_MAX] = {0,  1,  2,  3,  4,  5,  6,  7,  8,  9,  10, 11,
+                                                               12, 13, 14, 15, 16, 17, 18, 19, 20, 21, 22, 23};
+    uint8_t pcrValues[COMINIT_TPM_PCR_MAX][TPM2_SHA256_DIGEST_SIZE];
+
+    if (state->argCtx->pcrSealCount > 0) {
+        return cominitTpmReadPcrValues(&state->tpmCtx, state->argCtx->pcrSeal, state->argCtx->pcrSealCount,
+                                       pcrValues);
+    }
+    return cominitTpmReadPcrValues(&state->tpmCtx, allPcrs, COMINIT_TPM_PCR_MAX, pcrValues);
+}
+#endif
+
+/**
+ * Loads the rootfs device mapper table into the scratch device and removes it again.
+ */
+static int cominitBenchDmTable(cominitBenchState_t *state) {
+    return (cominitProbeDmDevice(&state->rfsMeta, COMINIT_BENCH_DM_NAME) == 0) ? EXIT_SUCCESS : EXIT_FAILURE;
+}
+
+/**
+ * Runs a phase \a repetitions times and prints minimum, median, 99th percentile and maximum duration.
+ *
+ * @param name         The name of the phase in the report.
+ * @param func         The phase.
+ * @param state        The state given to \a func.
+ * @param repetitions  The number of repetitions.
+ * @param samples      Buffer for \a repetitions durations.
+ *
+ * @return  EXIT_SUCCESS if all repetitions succeeded, EXIT_FAILURE otherwise
+ */
+static int cominitBenchPhase(const char *name, cominitBenchPhaseFunc_t func, cominitBenchState_t *state,
+                             unsigned long repetitions, uint64_t *samples) {
+    for (unsigned long i = 0; i < repetitions; i++) {
+        uint64_t start = cominitStatsNow();
+        if (func(state) != EXIT_SUCCESS) {
+            cominitErrPrint("Phase %s failed in repetition %lu.", name, i);
+            printf("%-16s failed\n", name);
+            return EXIT_FAILURE;
+        }
+        samples[i] = cominitStatsNow() - start;
+    }
+
+    cominitStatsPrintRow(name, 16, samples, repetitions, cominitBenchPercentiles, ARRAY_SIZE(cominitBenchPercentiles));
+    fflush(stdout);
+
+    return EXIT_SUCCESS;
+}
+
+/**
+ * Enters a private mount namespace and makes sure the device mapper control node is available in it.
+ *
+ * @return  EXIT_SUCCESS on success, EXIT_FAILURE otherwise
+ */
+static int cominitBenchUnshareMounts(void) {
+    if (syscall(SYS_unshare, CLONE_NEWNS) == -1) {
+        cominitErrnoPrint("Could not enter a private mount namespace.");
+        return EXIT_FAILURE;
+    }
+    if (mount(NULL, "/", NULL, MS_REC | MS_PRIVATE, NULL) == -1) {
+        cominitErrnoPrint("Could not make the mounts of the namespace private.");
+        return EXIT_FAILURE;
+    }
+    if (access("/dev/" DM_DIR "/" DM_CONTROL_NODE, F_OK) != 0 &&
+        mount("devtmpfs", "/dev", "devtmpfs", MS_NOSUID | MS_NOEXEC, NULL) == -1) {
+        cominitErrnoPrint("Could not mount devtmpfs to /dev.");
+        return EXIT_FAILURE;
+    }
+
+    return EXIT_SUCCESS;
+}
+
+int cominitBenchParseOption(unsigned long *repetitions, const char *arg) {
+    int result = EXIT_FAILURE;
+
+    if (repetitions == NULL || arg == NULL) {
+        cominitErrPrint("Invalid parameters");
+    } else if (strcmp(arg, COMINIT_BENCH_OPTION) == 0) {
+        *repetitions = COMINIT_BENCH_DEFAULT_REPETITIONS;
+        result = EXIT_SUCCESS;
+    } else if (strncmp(arg, COMINIT_BENCH_OPTION "=", sizeof(COMINIT_BENCH_OPTION)) == 0) {
+        const char *value = arg + sizeof(COMINIT_BENCH_OPTION);
+        char *end = NULL;
+        errno = 0;
+        unsigned long n = strtoul(value, &end, 10);
+        if (isdigit((unsigned char)value[0]) && *end == '\0' && errno == 0 && n > 0 &&
+            n <= COMINIT_BENCH_MAX_REPETITIONS) {
+            *repetitions = n;
+            result = EXIT_SUCCESS;
+        }
+    }
+
+    return result;
+}
+
+int cominitBenchRun(cominitCliArgs_t *argCtx, unsigned long repetitions) {
+    int result = EXIT_SUCCESS;
+
+    if (argCtx == NULL || repetitions == 0 || repetitions > COMINIT_BENCH_MAX_REPETITIONS) {
+        cominitErrPrint("Invalid parameters");
+        return EXIT_FAILURE;
+    }
+    /* Log records of every repetition would be measured as well. */
+    cominitOutputSetVisibleLogLevel((argCtx->visibleLogLevel == COMINIT_LOG_LEVEL_INVALID) ? COMINIT_LOG_LEVEL_ERR
+                                                                                            : argCtx->visibleLogLevel);
+    cominitOutputSetConsoleLogLevel(argCtx->consoleLogLevel);
+    if (cominitBenchUnshareMounts() == EXIT_FAILURE) {
+        return EXIT_FAILURE;
+    }
+
+    uint64_t *samples = calloc(repetitions, sizeof(uint64_t));
+    cominitBenchState_t *state = calloc(1, sizeof(cominitBenchState_t));
+    if (samples == NULL || state == NULL) {
+        cominitErrnoPrint("Could not allocate memory for %lu repetitions.", repetitions);
+        free(samples);
+        free(state);
+        return EXIT_FAILURE;
+    }
+    state->argCtx = argCtx;
+
+    bool rootfsGiven = (argCtx->devNodeRootFs[0] != '\0');
+    if (rootfsGiven) {
+        memcpy(state->rootfs, argCtx->devNodeRootFs, sizeof(state->rootfs));
+    } else if (cominitBenchGptDiscovery(state) != EXIT_SUCCESS) {
+        cominitErrPrint("No rootfs found, give it with root=<device>.");
+        result = EXIT_FAILURE;
+    }
+
+    if (result == EXIT_SUCCESS) {
+        printf("cominit %s, %lu repetitions, rootfs %s\n", cominitGetVersionString(), repetitions, state->rootfs);
+        cominitStatsPrintHeader("phase [us]", 16, cominitBenchPercentiles, ARRAY_SIZE(cominitBenchPercentiles));
+
+        if (rootfsGiven) {
+            printf("%-16s skipped, rootfs given with root=\n", "gpt-discovery");
+        } else if (cominitBenchPhase("gpt-discovery", cominitBenchGptDiscovery, state, repetitions, samples) !=
+                   EXIT_SUCCESS) {
+            result = EXIT_FAILURE;
+        }
+        bool metadataLoaded =
+            (cominitBenchPhase("metadata", cominitBenchMetadata, state, repetitions, samples) == EXIT_SUCCESS);
+        if (!metadataLoaded) {
+            result = EXIT_FAILURE;
+        }
+        if (cominitBenchPhase("key-parse", cominitBenchKeyParse, state, repetitions, samples) != EXIT_SUCCESS) {
+            result = EXIT_FAILURE;
+        }
+#ifdef COMINIT_USE_TPM
+        if (cominitBenchPhase("tpm-init", cominitBenchTpmInit, state, repetitions, samples) != EXIT_SUCCESS) {
+            result = EXIT_FAILURE;
+            printf("%-16s skipped, no TPM\n", "pcr-read");
+        } else if (cominitInitTpm(&state->tpmCtx, argCtx) != EXIT_SUCCESS) {
+            result = EXIT_FAILURE;
+            printf("%-16s skipped, no TPM\n", "pcr-read");
+        } else {
+            if (cominitBenchPhase("pcr-read", cominitBenchPcrRead, state, repetitions, samples) != EXIT_SUCCESS) {
+                result = EXIT_FAILURE;
+            }
+            cominitDeleteTpm(&state->tpmCtx);
+        }
+#endif
+        if (!metadataLoaded) {
+            printf("%-16s skipped, no metadata\n", "dm-table");
+        } else if (state->rfsMeta.crypt == COMINIT_CRYPTOPT_NONE) {
+            printf("%-16s skipped, rootfs uses no device mapper\n", "dm-table");
+        } else if (cominitBenchPhase("dm-table", cominitBenchDmTable, state, repetitions, samples) != EXIT_SUCCESS) {
+            result = EXIT_FAILURE;
+        }
+    }
+
+    free(state);
+    free(samples);
+
+    return result;
+}
@@ -0,0 +1,58 @@
+// SPDX-License-Identifier: MIT
+/**
+ * @file blockdev.c
+ * @brief Implementation of the I/O backend for real block devices.
+ */
+#include "blockdev.h"
+
+#include <fcntl.h>
+#include <linux/fs.h>
+#include <stdlib.h>
+#include <sys/ioctl.h>
+#include <unistd.h>
+
+#include "output.h"
+
+int cominitBlockdevOpen(const char *path) {
+    return open(path, O_RDONLY | O_CLOEXEC);
+}
+
+ssize_t cominitBlockdevPread(int fd, void *buf, size_t len, off_t offset) {
+    return pread(fd, buf, len, offset);
+}
+
+int cominitBlockdevGetSize(int fd, uint64_t *size) {
+    int result = EXIT_FAILURE;
+
+    if (ioctl(fd, BLKGETSIZE64, size) == -1) {
+        cominitErrnoPrint("Could not determine size of partition.");
+    } else {
+        result = EXIT_SUCCESS;
+    }
+
+    return result;
+}
+
+int cominitBlockdevGetBlockSize(int fd, int *blockSize) {
+    int result = EXIT_FAILURE;
+
+    if (ioctl(fd, BLKSSZGET, blockSize) < 0) {
+        cominitErrnoPrint("ioctl failed to get block size.");
+    } else {
+        result = EXIT_SUCCESS;
+    }
+
+    return result;
+}
+
+void cominitBlockdevClose(int fd) {
+    close(fd);
+}
+
+const char *cominitBlockdevScanDir(void) {
+    return COMINIT_BLOCKDEV_SCAN_DIR;
+}
+
+bool cominitBlockdevIsDisk(const struct stat *st) {
+    return S_ISBLK(st->st_mode);
+}
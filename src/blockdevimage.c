@@ -0,0 +1,246 @@
+// SPDX-License-Identifier: MIT
+/**
+ * @file blockdevimage.c
+ * @brief Implementation of the I/O backend for disk image files.
+ */
+#include "blockdev.h"
+
+#include <ctype.h>
+#include <endian.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+#include "automount.h"
+#include "output.h"
+
+/** Logical block size of all disk images. **/
+#define COMINIT_BLOCKDEV_IMAGE_BLOCK_SIZE 512
+/** Maximum number of images and partitions open at the same time. **/
+#define COMINIT_BLOCKDEV_IMAGE_OPEN_MAX 8
+/** Offset of the first LBA in a GPT partition entry. **/
+#define COMINIT_BLOCKDEV_IMAGE_ENTRY_FIRST_LBA_OFFSET 32
+/** Offset of the last LBA in a GPT partition entry. **/
+#define COMINIT_BLOCKDEV_IMAGE_ENTRY_LAST_LBA_OFFSET 40
+
+/**
+ * An open image or partition within an image.
+ */
+typedef struct cominitBlockdevImageFile {
+    bool used;      ///< Flag if the slot is in use.
+    int fd;         ///< File descriptor of the image.
+    off_t start;    ///< Offset of the partition in the image, 0 for the whole image.
+    uint64_t size;  ///< Size of the image or partition in bytes.
+} cominitBlockdevImageFile_t;
+
+static cominitBlockdevImageFile_t cominitBlockdevImageFiles[COMINIT_BLOCKDEV_IMAGE_OPEN_MAX];
+
+static const char *cominitBlockdevImageDir = COMINIT_BLOCKDEV_SCAN_DIR;
+
+/**
+ * Looks up an open image or partition.
+ *
+ * @param fd  The file descriptor returned by cominitBlockdevOpen().
+ *
+ * @return  The entry on success, NULL with errno set to EBADF otherwise
+ */
+static cominitBlockdevImageFile_t *cominitBlockdevImageLookup(int fd) {
+    for (size_t i = 0; i < COMINIT_BLOCKDEV_IMAGE_OPEN_MAX; i++) {
+        if (cominitBlockdevImageFiles[i].used && cominitBlockdevImageFiles[i].fd == fd) {
+            return &cominitBlockdevImageFiles[i];
+        }
+    }
+    errno = EBADF;
+    return NULL;
+}
+
+/**
+ * Splits a partition node into the path of its image and the index of the partition, the inverse of how automount.c
+ * builds partition nodes.
+ *
+ * @param path       The partition node, e.g. `disk.img2` or `disk0p2`.
+ * @param imagePath  Buffer receiving the path of the image.
+ * @param imageSize  The size of \a imagePath.
+ * @param idx        Pointer receiving the 1-based partition index.
+ *
+ * @return  EXIT_SUCCESS on success, EXIT_FAILURE if \a path does not end with a partition index
+ */
+static int cominitBlockdevImageSplitPartition(const char *path, char *imagePath, size_t imageSize, unsigned *idx) {
+    size_t len = strlen(path);
+    size_t digits = len;
+
+    while (digits > 0 && isdigit((unsigned char)path[digits - 1])) {
+        digits--;
+    }
+    if (digits == len || digits == 0) {
+        return EXIT_FAILURE;
+    }
+
+    *idx = (unsigned)strtoul(path + digits, NULL, 10);
+    if (digits > 1 && path[digits - 1] == 'p' && isdigit((unsigned char)path[digits - 2])) {
+        digits--;
+    }
+    if (*idx == 0 || digits >= imageSize) {
+        return EXIT_FAILURE;
+    }
+    memcpy(imagePath, path, digits);
+    imagePath[digits] = '\0';
+
+    return EXIT_SUCCESS;
+}
+
+/**
+ * Finds a partition in the GPT of an image.
+ *
+ * @param fd     The open image.
+ * @param idx    The 1-based index of the partition entry.
+ * @param start  Pointer receiving the offset of the partition in the image.
+ * @param size   Pointer receiving the size of the partition in bytes.
+ *
+ * @return  EXIT_SUCCESS on success, EXIT_FAILURE otherwise
+ */
+static int cominitBlockdevImageFindPartition(int fd, unsigned idx, off_t *start, uint64_t *size) {
+    int result = EXIT_FAILURE;
+    cominitGPTHeader_t hdr;
+    uint8_t entry[GPT_HEADER_DEFAULT_ENTRY_SIZE];
+
+    if (pread(fd, &hdr, sizeof(hdr), COMINIT_BLOCKDEV_IMAGE_BLOCK_SIZE) != (ssize_t)sizeof(hdr) ||
+        memcmp(hdr.signature, "EFI PART", sizeof(hdr.signature)) != 0) {
+        cominitErrPrint("Image does not contain a GPT.");
+    } else if (idx > le32toh(hdr.partitionEntryCount) ||
+               le32toh(hdr.partitionEntrySize) < GPT_HEADER_DEFAULT_ENTRY_SIZE) {
+        cominitErrPrint("Partition %u is not part of the GPT.", idx);
+    } else {
+        off_t offset = (off_t)(le64toh(hdr.partitionEntriesLba) * COMINIT_BLOCKDEV_IMAGE_BLOCK_SIZE +
+                               (uint64_t)(idx - 1) * le32toh(hdr.partitionEntrySize));
+        if (pread(fd, entry, sizeof(entry), offset) != (ssize_t)sizeof(entry)) {
+            cominitErrnoPrint("Could not read partition entry %u.", idx);
+        } else {
+            uint64_t firstLba = 0;
+            uint64_t lastLba = 0;
+            memcpy(&firstLba, entry + COMINIT_BLOCKDEV_IMAGE_ENTRY_FIRST_LBA_OFFSET, sizeof(firstLba));
+            memcpy(&lastLba, entry + COMINIT_BLOCKDEV_IMAGE_ENTRY_LAST_LBA_OFFSET, sizeof(lastLba));
+            firstLba = le64toh(firstLba);
+            lastLba = le64toh(lastLba);
+            if (firstLba == 0 || lastLba < firstLba) {
+                cominitErrPrint("Partition entry %u is empty.", idx);
+            } else {
+                *start = (off_t)(firstLba * COMINIT_BLOCKDEV_IMAGE_BLOCK_SIZE);
+                *size = (lastLba - firstLba + 1) * COMINIT_BLOCKDEV_IMAGE_BLOCK_SIZE;
+                result = EXIT_SUCCESS;
+            }
+        }
+    }
+
+    return result;
+}
+
+int cominitBlockdevOpen(const char *path) {
+    cominitBlockdevImageFile_t *file = NULL;
+    char imagePath[COMINIT_ROOTFS_DEV_PATH_MAX];
+    unsigned idx = 0;
+    off_t start = 0;
+    uint64_t size = 0;
+    struct stat st;
+
+    for (size_t i = 0; i < COMINIT_BLOCKDEV_IMAGE_OPEN_MAX && file == NULL; i++) {
+        if (cominitBlockdevImageFiles[i].used == false) {
+            file = &cominitBlockdevImageFiles[i];
+        }
+    }
+    if (file == NULL) {
+        errno = EMFILE;
+        return -1;
+    }
+
+    int fd = open(path, O_RDONLY | O_CLOEXEC);
+    if (fd >= 0) {
+        if (fstat(fd, &st) == -1) {
+            close(fd);
+            return -1;
+        }
+        size = (uint64_t)st.st_size;
+    } else if (errno == ENOENT &&
+               cominitBlockdevImageSplitPartition(path, imagePath, sizeof(imagePath), &idx) == EXIT_SUCCESS) {
+        fd = open(imagePath, O_RDONLY | O_CLOEXEC);
+        if (fd >= 0 && cominitBlockdevImageFindPartition(fd, idx, &start, &size) != EXIT_SUCCESS) {
+            close(fd);
+            errno = ENXIO;
+            return -1;
+        }
+    }
+
+    if (fd >= 0) {
+        *file = (cominitBlockdevImageFile_t){.used = true, .fd = fd, .start = start, .size = size};
+    }
+    return fd;
+}
+
+ssize_t cominitBlockdevPread(int fd, void *buf, size_t len, off_t offset) {
+    const cominitBlockdevImageFile_t *file = cominitBlockdevImageLookup(fd);
+
+    if (file == NULL) {
+        return -1;
+    }
+    if (offset < 0) {
+        errno = EINVAL;
+        return -1;
+    }
+    if ((uint64_t)offset >= file->size) {
+        return 0;
+    }
+    if (len > file->size - (uint64_t)offset) {
+        len = file->size - (uint64_t)offset;
+    }
+    return pread(fd, buf, len, file->start + offset);
+}
+
+int cominitBlockdevGetSize(int fd, uint64_t *size) {
+    int result = EXIT_FAILURE;
+    const cominitBlockdevImageFile_t *file = cominitBlockdevImageLookup(fd);
+
+    if (file == NULL) {
+        cominitErrnoPrint("Could not determine size of partition.");
+    } else {
+        *size = file->size;
+        result = EXIT_SUCCESS;
+    }
+
+    return result;
+}
+
+int cominitBlockdevGetBlockSize(int fd, int *blockSize) {
+    int result = EXIT_FAILURE;
+
+    if (cominitBlockdevImageLookup(fd) == NULL) {
+        cominitErrnoPrint("Could not get block size.");
+    } else {
+        *blockSize = COMINIT_BLOCKDEV_IMAGE_BLOCK_SIZE;
+        result = EXIT_SUCCESS;
+    }
+
+    return result;
+}
+
+void cominitBlockdevClose(int fd) {
+    cominitBlockdevImageFile_t *file = cominitBlockdevImageLookup(fd);
+
+    if (file != NULL) {
+        file->used = false;
+        close(fd);
+    }
+}
+
+const char *cominitBlockdevScanDir(void) {
+    return cominitBlockdevImageDir;
+}
+
+bool cominitBlockdevIsDisk(const struct stat *st) {
+    return S_ISREG(st->st_mode);
+}
+
+void cominitBlockdevImageSetDir(const char *dir) {
+    cominitBlockdevImageDir = dir;
+}
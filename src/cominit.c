@@ -22,7 +22,11 @@
 #include "tpm.h"
 #endif
 #include "automount.h"
+#ifdef COMINIT_BENCH
+#include "bench.h"
+#endif
 #include "common.h"
+#include "helper.h"
 #include "minsetup.h"
 #include "output.h"
 #include "version.h"
@@ -97,6 +101,14 @@ static inline bool cominitUseTpm(cominitCliArgs_t *ctx);
  * @return  EXIT_SUCCESS on success, EXIT_FAILURE otherwise
  */
 static int cominitParseDeviceNode(char *device, const char *argValue);
+/**
+ * Parses how the runtime directory in the rootfs is set up (`tmpfs`, `rootfs` or `none`).
+ *
+ * @param runDir  Pointer to the variable that receives the parsed setting.
+ * @param argValue  The parsed value of the argument found in the provided argument vector.
+ * @return  EXIT_SUCCESS on success, EXIT_FAILURE otherwise
+ */
+static int cominitParseRunDir(cominitRunDir_t *runDir, const char *argValue);
 /**
  * Parses a value from an argument of argv.
  *
@@ -130,12 +142,24 @@ bool cominitDiscoverRootfs(cominitCliArgs_t *argCtx, cominitRfsMetaData_t *rfsMe
  */
 int main(int argc, char *argv[], char *envp[]) {
     cominitCliArgs_t argCtx = {.visibleLogLevel = COMINIT_LOG_LEVEL_INVALID,
+                               .consoleLogLevel = COMINIT_LOG_LEVEL_INVALID,
+                               .runDir = COMINIT_RUN_DIR_TMPFS,
                                .pcrSet = false,
                                .pcrSealCount = 0,
+                               .secureStorageMode = COMINIT_SECURE_STORAGE_MODE_SYNC,
+                               .tpmPrimaryHandle = COMINIT_TPM_PRIMARY_HANDLE,
+                               .tpmFullSelftest = false,
+                               .tpmTcti[0] = '\0',
+                               .blobStorage = COMINIT_BLOB_STORAGE_EXT4,
+                               .blobNvIndex = COMINIT_TPM_BLOB_NV_INDEX,
                                .devNodeBlob[0] = '\0',
                                .devNodeCrypt[0] = '\0',
+                               .cryptVolumeCount = 0,
                                .devNodeRootFs[0] = '\0'};
     const char *argValue = NULL;
+#ifdef COMINIT_BENCH
+    unsigned long benchRepetitions = 0;
+#endif
 
     for (int i = 0; i < argc; i++) {
         if (cominitParamCheck(argv[i], "-V", "--version")) {
@@ -158,6 +182,18 @@ int main(int argc, char *argv[], char *envp[]) {
                 continue;
             }
         }
+        if ((argValue = cominitParseArgValue(argv[i], "consoleLogLevel", "cominit.consoleLogLevel")) != NULL) {
+            if (cominitOutputParseLogLevel(&argCtx.consoleLogLevel, argValue) == EXIT_FAILURE) {
+                cominitErrPrint("\'%s\' requires a valid log level ", argv[i]);
+                continue;
+            }
+        }
+        if ((argValue = cominitParseArgValue(argv[i], "runDir", "cominit.runDir")) != NULL) {
+            if (cominitParseRunDir(&argCtx.runDir, argValue) == EXIT_FAILURE) {
+                cominitErrPrint("\'%s\' requires \'tmpfs\', \'rootfs\' or \'none\' ", argv[i]);
+                continue;
+            }
+        }
 #ifdef COMINIT_USE_TPM
         if ((argValue = cominitParseArgValue(argv[i], "pcrExtend", "cominit.pcrExtend")) != NULL) {
             if (cominitTpmParsePcrIndex(&argCtx, argValue) == EXIT_FAILURE) {
@@ -165,29 +201,89 @@ int main(int argc, char *argv[], char *envp[]) {
                 continue;
             }
         }
+        if ((argValue = cominitParseArgValue(argv[i], "pcrMeasure", "cominit.pcrMeasure")) != NULL) {
+            if (cominitTpmParsePcrMeasureIndex(&argCtx, argValue) == EXIT_FAILURE) {
+                cominitErrPrint("\'%s\' requires an integer PCR index ", argv[i]);
+                continue;
+            }
+        }
         if ((argValue = cominitParseArgValue(argv[i], "blob", "cominit.blob")) != NULL) {
             if (cominitParseDeviceNode(argCtx.devNodeBlob, argValue) == EXIT_FAILURE) {
                 cominitErrPrint("\'%s\' requires a valid device node ", argv[i]);
                 continue;
             }
         }
+        if ((argValue = cominitParseArgValue(argv[i], "blobStorage", "cominit.blobStorage")) != NULL) {
+            if (cominitTpmParseBlobStorage(&argCtx, argValue) == EXIT_FAILURE) {
+                cominitErrPrint("\'%s\' requires \'ext4\', \'raw\' or \'nv[:<index>]\' ", argv[i]);
+                continue;
+            }
+        }
         if ((argValue = cominitParseArgValue(argv[i], "pcrSeal", "cominit.pcrSeal")) != NULL) {
             if (cominitTpmParsePcrIndexes(&argCtx, argValue) == EXIT_FAILURE) {
                 cominitErrPrint("\'%s\' requires integer PCR indexes ", argv[i]);
                 continue;
             }
         }
+        if ((argValue = cominitParseArgValue(argv[i], "tpmPrimaryHandle", "cominit.tpmPrimaryHandle")) != NULL) {
+            if (cominitTpmParsePrimaryHandle(&argCtx, argValue) == EXIT_FAILURE) {
+                cominitErrPrint("\'%s\' requires a persistent TPM handle ", argv[i]);
+                continue;
+            }
+        }
+        if ((argValue = cominitParseArgValue(argv[i], "tpmSelftest", "cominit.tpmSelftest")) != NULL) {
+            if (cominitTpmParseSelftest(&argCtx, argValue) == EXIT_FAILURE) {
+                cominitErrPrint("\'%s\' requires \'incremental\' or \'full\' ", argv[i]);
+                continue;
+            }
+        }
+        if ((argValue = cominitParseArgValue(argv[i], "tcti", "cominit.tcti")) != NULL) {
+            if (cominitTpmParseTcti(&argCtx, argValue) == EXIT_FAILURE) {
+                cominitErrPrint("\'%s\' requires a TCTI configuration ", argv[i]);
+                continue;
+            }
+        }
         if ((argValue = cominitParseArgValue(argv[i], "crypt", "cominit.crypt")) != NULL) {
             if (cominitParseDeviceNode(argCtx.devNodeCrypt, argValue) == EXIT_FAILURE) {
                 cominitErrPrint("\'%s\' requires a valid device node ", argv[i]);
                 continue;
             }
         }
+        if ((argValue = cominitParseArgValue(argv[i], "secureStorageMode", "cominit.secureStorageMode")) != NULL) {
+            if (cominitTpmParseSecureStorageMode(&argCtx, argValue) == EXIT_FAILURE) {
+                cominitErrPrint("\'%s\' requires \'sync\', \'deferred\' or \'detached\' ", argv[i]);
+                continue;
+            }
+        }
+        if ((argValue = cominitParseArgValue(argv[i], "cryptVolumes", "cominit.cryptVolumes")) != NULL) {
+            if (cominitTpmParseCryptVolumes(&argCtx, argValue) == EXIT_FAILURE) {
+                cominitErrPrint("\'%s\' requires \'<name>:<partition GUID>[,...]\' ", argv[i]);
+                continue;
+            }
+        }
+#endif
+#ifdef COMINIT_BENCH
+        if (strncmp(argv[i], COMINIT_BENCH_OPTION, sizeof(COMINIT_BENCH_OPTION) - 1) == 0) {
+            if (cominitBenchParseOption(&benchRepetitions, argv[i]) == EXIT_FAILURE) {
+                cominitErrPrint("\'%s\' requires between 1 and %lu repetitions ", argv[i],
+                                COMINIT_BENCH_MAX_REPETITIONS);
+                continue;
+            }
+        }
 #endif
     }
+#ifdef COMINIT_BENCH
+    if (benchRepetitions > 0) {
+        if (getpid() != 1) {
+            return cominitBenchRun(&argCtx, benchRepetitions);
+        }
+        cominitErrPrint("Ignoring \'%s\' when started as PID 1.", COMINIT_BENCH_OPTION);
+    }
+#endif
     setsid();
     umask(0);
     cominitOutputSetVisibleLogLevel(argCtx.visibleLogLevel);
+    cominitOutputSetConsoleLogLevel(argCtx.consoleLogLevel);
     cominitInfoPrint("BaseOS Compact Init version %s started.", cominitGetVersionString());
 
     /* Mount devtmpfs so we have a minimal system */
@@ -196,6 +292,10 @@ int main(int argc, char *argv[], char *envp[]) {
         cominitErrPrint("Could not setup minimal system/device files. Init failed.");
         goto rescue;
     }
+    /* From here on log records carry kernel timestamps and obey the kernel's console log level and rate limit. */
+    if (cominitOutputOpenKmsg(COMINIT_OUTPUT_KMSG_PATH) == EXIT_FAILURE) {
+        cominitWarnPrint("Could not use the kernel log, will log to the console.");
+    }
 
 /* In case we are built to emulate a HSM, enroll the standard development key for dm-integrity HMAC in the Kernel
  * user keyring. */
@@ -209,6 +309,7 @@ int main(int argc, char *argv[], char *envp[]) {
 
     cominitRfsMetaData_t rfsMeta = {0};
     cominitGPTDisk_t gptDiskRoot = {0};
+    cominitHelper_t helper = {.pid = -1, .syncFd = -1, .preparedFd = -1};
 
     unsigned long failCount = 0;
     while (cominitDiscoverRootfs(&argCtx, &rfsMeta, &gptDiskRoot) == false) {
@@ -235,6 +336,9 @@ int main(int argc, char *argv[], char *envp[]) {
     }
 
 #ifdef COMINIT_USE_TPM
+    cominitTpmContext_t tpmCtx = {0};
+    cominitTpmHelperData_t helperData = {.tpmCtx = &tpmCtx, .argCtx = &argCtx};
+    bool secureStorageUnlocked = false;
     if (argCtx.devNodeCrypt[0] == '\0') {
         cominitInfoPrint("No secureStorage partition given from kernel command line.");
         if (gptDiskRoot.diskName[0] != '\0') {
@@ -251,23 +355,49 @@ int main(int argc, char *argv[], char *envp[]) {
         }
     }
 
-    if (cominitUseTpm(&argCtx) == true) {
-        cominitTpmContext_t tpmCtx;
+    for (int i = 0; i < argCtx.cryptVolumeCount; i++) {
+        cominitCryptVolume_t *volume = &argCtx.cryptVolumes[i];
+        cominitGPTDisk_t gptDiskVolume = gptDiskRoot;
+        if (cominitAutomountFindPartitionByUuid(&gptDiskVolume, volume->partUuid, volume->devNode,
+                                                sizeof(volume->devNode)) == EXIT_FAILURE) {
+            cominitErrPrint("Could not find partition %s of volume %s.", volume->partUuid, volume->name);
+            volume->devNode[0] = '\0';
+        }
+    }
 
+    if (cominitUseTpm(&argCtx) == true) {
         cominitInfoPrint("TPM is used");
 
-        int result = cominitInitTpm(&tpmCtx);
+        int result = cominitInitTpm(&tpmCtx, &argCtx);
 
         if (result != EXIT_SUCCESS) {
             cominitErrPrint("TPM init failed.");
         } else {
             if (cominitTpmExtendEnabled(&argCtx) == true) {
-                result = cominitTpmExtendPCR(&tpmCtx, COMINIT_ROOTFS_KEY_LOCATION, argCtx.pcrIndex);
+                result = cominitTpmMeasureBoot(&tpmCtx, &rfsMeta, COMINIT_ROOTFS_KEY_LOCATION, &argCtx);
                 if (result != EXIT_SUCCESS) {
                     cominitErrPrint("PCR extention failed.");
                 }
             }
-            if (cominitTpmSecureStorageEnabled(&argCtx) == true) {
+            /*
+             * The helper opens a TPM context of its own while the rootfs is set up. Sharing one TCTI connection
+             * across fork() is not safe, finalizing it in one process would end the session of the other.
+             */
+            if (cominitTpmSecureStorageEnabled(&argCtx) == true &&
+                argCtx.secureStorageMode == COMINIT_SECURE_STORAGE_MODE_DETACHED) {
+                cominitDeleteTpm(&tpmCtx);
+                if (cominitHelperStart(&helper, cominitTpmUnlockSecureStorage, cominitTpmFinishSecureStorage,
+                                       &helperData, COMINIT_TPM_SECURE_STORAGE_MARKER) != EXIT_SUCCESS) {
+                    cominitErrPrint("Could not start secure storage helper, unlocking synchronously.");
+                    argCtx.secureStorageMode = COMINIT_SECURE_STORAGE_MODE_SYNC;
+                    result = cominitInitTpm(&tpmCtx, &argCtx);
+                    if (result != EXIT_SUCCESS) {
+                        cominitErrPrint("TPM init failed.");
+                    }
+                }
+            }
+            if (result == EXIT_SUCCESS && cominitTpmSecureStorageEnabled(&argCtx) == true &&
+                argCtx.secureStorageMode != COMINIT_SECURE_STORAGE_MODE_DETACHED) {
                 cominitTpmState_t state = cominitTpmProtectData(&tpmCtx, &argCtx);
                 switch (state) {
                     case TpmPolicyFailure:
@@ -277,8 +407,11 @@ int main(int argc, char *argv[], char *envp[]) {
                         }
                         break;
                     case Unsealed:
+                        secureStorageUnlocked = true;
                         break;
                     case Sealed:
+                        cominitWarnPrint("Secure storage not available before the sealed PCR state is reached.");
+                        break;
                     case TpmFailure:
                     default:
                         cominitErrPrint("TPM failed to set up protected data.");
@@ -286,7 +419,19 @@ int main(int argc, char *argv[], char *envp[]) {
                 }
             }
         }
-        cominitDeleteTpm(&tpmCtx);
+        if (tpmCtx.tctiCtx != NULL && tpmCtx.esysCtx != NULL) {
+            cominitDeleteTpm(&tpmCtx);
+        }
+    }
+
+    if (secureStorageUnlocked && argCtx.secureStorageMode == COMINIT_SECURE_STORAGE_MODE_DEFERRED) {
+        if (cominitHelperStart(&helper, cominitTpmPrepareSecureStorage, cominitTpmFinishSecureStorage, &helperData,
+                               COMINIT_TPM_SECURE_STORAGE_MARKER) != EXIT_SUCCESS) {
+            cominitErrPrint("Could not start secure storage helper, mounting synchronously.");
+            if (cominitTpmPrepareSecureStorage(&helperData) == EXIT_SUCCESS) {
+                argCtx.secureStorageMode = COMINIT_SECURE_STORAGE_MODE_SYNC;
+            }
+        }
     }
 #endif
 
@@ -297,18 +442,34 @@ int main(int argc, char *argv[], char *envp[]) {
         goto rescue;
     }
 
+    /* Holds the boot log and, if a helper runs, its readiness markers. */
+    bool runDirReady = false;
+    if (argCtx.runDir != COMINIT_RUN_DIR_NONE || helper.pid >= 0) {
+        if (cominitSetupRunDir(argCtx.runDir != COMINIT_RUN_DIR_ROOTFS) == -1) {
+            cominitWarnPrint("Could not set up %s, boot log and secure storage readiness will not be available.",
+                             COMINIT_HELPER_RUN_DIR);
+        } else {
+            runDirReady = (argCtx.runDir != COMINIT_RUN_DIR_NONE);
+        }
+    }
+
 #ifdef COMINIT_USE_TPM
-    if (cominitTpmSecureStorageEnabled(&argCtx) == true) {
-        if (cominitTpmMountSecureStorage() == -1) {
+    if (cominitTpmSecureStorageEnabled(&argCtx) == true &&
+        argCtx.secureStorageMode == COMINIT_SECURE_STORAGE_MODE_SYNC) {
+        if (cominitTpmMountSecureStorage(COMINIT_TPM_SECURE_STORAGE_MNT) == -1) {
             cominitErrPrint("Mounting of secure storage failed");
         }
     }
 #endif
 
-    /* Housekeeping/cleanup before switching to rootfs. For now, just initiate a lazy umount of /dev. */
-    cominitInfoPrint("Unmounting system directories...");
-    if (cominitCleanupSysfiles() == -1) {
-        cominitInfoPrint("Warning: Could not unmount all system/device files.");
+    /* The helper still needs the initramfs and cleans it up itself once done. */
+    if (helper.pid < 0) {
+        /* Housekeeping/cleanup before switching to rootfs. For now, just initiate a lazy umount of /dev. */
+        cominitInfoPrint("Unmounting system directories...");
+        if (cominitCleanupSysfiles() == -1) {
+            cominitInfoPrint("Warning: Could not unmount all system/device files.");
+        }
+        cominitFreeInitramfs();
     }
 
     /* Switch into the new rootfs */
@@ -317,8 +478,23 @@ int main(int argc, char *argv[], char *envp[]) {
         goto rescue;
     }
 
+#ifdef COMINIT_USE_TPM
+    /* The rootfs init may extend the PCRs the key is sealed to, so unsealing must be done before the exec. */
+    if (helper.pid >= 0 && argCtx.secureStorageMode == COMINIT_SECURE_STORAGE_MODE_DETACHED &&
+        cominitHelperWaitPrepared(&helper) != EXIT_SUCCESS) {
+        cominitErrPrint("Secure storage helper failed before unsealing.");
+    }
+#endif
+
+    if (helper.pid >= 0 && cominitHelperRelease(&helper) != EXIT_SUCCESS) {
+        cominitErrPrint("Could not release helper.");
+    }
+
     /* if we made it up to here we say goodbye and exec into the rootfs init daemon */
     cominitInfoPrint("Exec into rootfs init...");
+    if (runDirReady == true && cominitOutputFlushLog(COMINIT_OUTPUT_LOG_PATH) == EXIT_FAILURE) {
+        cominitWarnPrint("Could not save boot log to %s.", COMINIT_OUTPUT_LOG_PATH);
+    }
     char *const initArgs[] = {"/sbin/init", NULL};
     if (execve("/sbin/init", initArgs, envp) == -1) {
         cominitErrnoPrint("Execve into rootfs init failed.");
@@ -372,6 +548,13 @@ static void cominitPrintUsage(void) {
         "       metadata and then switch into it. The location of the rootfs partition (e.g. "
         "/dev/<blkdevice><partno>)\n"
         "       is determined through an argument passed to cominit by the bootloader on the kernel command line.\n");
+#ifdef COMINIT_BENCH
+    printf(
+        "       cominit %s[=<N>] [<option>=<value> ...] repeats the boot phases <N> (default %lu) times in a private\n"
+        "       mount namespace and prints their minimum, median, 99th percentile and maximum duration. It needs root\n"
+        "       privileges but must not run as PID 1.\n",
+        COMINIT_BENCH_OPTION, COMINIT_BENCH_DEFAULT_REPETITIONS);
+#endif
 }
 
 static int cominitParseDeviceNode(char *device, const char *argValue) {
@@ -392,6 +575,27 @@ static int cominitParseDeviceNode(char *device, const char *argValue) {
     return result;
 }
 
+static int cominitParseRunDir(cominitRunDir_t *runDir, const char *argValue) {
+    int result = EXIT_FAILURE;
+
+    if (runDir == NULL || argValue == NULL) {
+        cominitErrPrint("Invalid parameters");
+    } else {
+        if (strcmp(argValue, "tmpfs") == 0) {
+            *runDir = COMINIT_RUN_DIR_TMPFS;
+            result = EXIT_SUCCESS;
+        } else if (strcmp(argValue, "rootfs") == 0) {
+            *runDir = COMINIT_RUN_DIR_ROOTFS;
+            result = EXIT_SUCCESS;
+        } else if (strcmp(argValue, "none") == 0) {
+            *runDir = COMINIT_RUN_DIR_NONE;
+            result = EXIT_SUCCESS;
+        }
+    }
+
+    return result;
+}
+
 #ifdef COMINIT_USE_TPM
 static inline bool cominitUseTpm(cominitCliArgs_t *argCtx) {
     bool useTpm = false;
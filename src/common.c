@@ -6,17 +6,30 @@
 
 #include "common.h"
 
-#include <linux/fs.h>
-#include <sys/ioctl.h>
+#include <stdlib.h>
+
+#include "blockdev.h"
 
 int cominitCommonGetPartSize(uint64_t *partSize, int fd) {
     if (partSize == NULL) {
         cominitErrPrint("Return pointer must not be NULL.");
         return -1;
     }
-    if (ioctl(fd, BLKGETSIZE64, partSize) == -1) {
-        cominitErrnoPrint("Could not determine size of partition.");
+    if (cominitBlockdevGetSize(fd, partSize) != EXIT_SUCCESS) {
         return -1;
     }
     return 0;
-}
\ No newline at end of file
+}
+
+uint32_t cominitCommonCrc32(const uint8_t *data, size_t len) {
+    uint32_t crc = 0xFFFFFFFFu;
+
+    for (size_t i = 0; i < len; i++) {
+        crc ^= data[i];
+        for (int bit = 0; bit < 8; bit++) {
+            crc = (crc >> 1) ^ (0xEDB88320u & (0u - (crc & 1u)));
+        }
+    }
+
+    return ~crc;
+}
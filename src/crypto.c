@@ -2,6 +2,9 @@
 
 #include <mbedtls/ctr_drbg.h>
 #include <mbedtls/entropy.h>
+#include <mbedtls/hkdf.h>
+#include <mbedtls/md.h>
+#include <stdbool.h>
 #include <stdlib.h>
 #include <string.h>
 
@@ -12,12 +15,20 @@
 
 #define DER_BUFFER_SIZE 1600  ///< buffer size to hold RSA‑4k key.
 
+#define COMINIT_CRYPTO_DIGEST_CHUNK 4096  ///< Bytes fed to every hash before moving on in cominitCryptoDigests().
+
 // Macro definition to support both MbedTLS 2 and 3 interfaces.
 #if MBEDTLS_VERSION_MAJOR == 2
 
 #define cominitMbedtlsVerify(ctx, mdAlg, hashlen, hash, sig) \
     mbedtls_rsa_rsassa_pss_verify((ctx), NULL, NULL, MBEDTLS_RSA_PUBLIC, (mdAlg), (hashlen), (hash), (sig))
 #define cominitComputeSHA256(data, dataLen, dataHash) mbedtls_sha256_ret(data, dataLen, dataHash, 0);
+#define cominitSha256Starts(ctx) mbedtls_sha256_starts_ret((ctx), 0)
+#define cominitSha256Update(ctx, data, dataLen) mbedtls_sha256_update_ret((ctx), (data), (dataLen))
+#define cominitSha256Finish(ctx, digest) mbedtls_sha256_finish_ret((ctx), (digest))
+#define cominitSha384Starts(ctx) mbedtls_sha512_starts_ret((ctx), 1)
+#define cominitSha384Update(ctx, data, dataLen) mbedtls_sha512_update_ret((ctx), (data), (dataLen))
+#define cominitSha384Finish(ctx, digest) mbedtls_sha512_finish_ret((ctx), (digest))
 #define cominitRsaSetPadding(pkCtx, err)                                                         \
     do {                                                                                         \
         mbedtls_rsa_set_padding(mbedtls_pk_rsa(pkCtx), MBEDTLS_RSA_PKCS_V21, MBEDTLS_MD_SHA256); \
@@ -29,6 +40,12 @@
 #define cominitMbedtlsVerify(ctx, mdAlg, hashlen, hash, sig) \
     mbedtls_rsa_rsassa_pss_verify((ctx), (mdAlg), (hashlen), (hash), (sig))
 #define cominitComputeSHA256(data, dataLen, dataHash) mbedtls_sha256(data, dataLen, dataHash, 0);
+#define cominitSha256Starts(ctx) mbedtls_sha256_starts((ctx), 0)
+#define cominitSha256Update(ctx, data, dataLen) mbedtls_sha256_update((ctx), (data), (dataLen))
+#define cominitSha256Finish(ctx, digest) mbedtls_sha256_finish((ctx), (digest))
+#define cominitSha384Starts(ctx) mbedtls_sha512_starts((ctx), 1)
+#define cominitSha384Update(ctx, data, dataLen) mbedtls_sha512_update((ctx), (data), (dataLen))
+#define cominitSha384Finish(ctx, digest) mbedtls_sha512_finish((ctx), (digest))
 #define cominitRsaSetPadding(pkCtx, err)                                                                 \
     do {                                                                                                 \
         (err) = mbedtls_rsa_set_padding(mbedtls_pk_rsa(pkCtx), MBEDTLS_RSA_PKCS_V21, MBEDTLS_MD_SHA256); \
@@ -99,6 +116,22 @@ int cominitCreateSHA256DigestfromKeyfile(const char *keyfile, unsigned char *dig
 
     if (keyfile == NULL || digest == NULL || digestLen < SHA256_LEN) {
         cominitErrPrint("Invalid parameters");
+    } else {
+        cominitCryptoDigests_t digests = {.algs = COMINIT_CRYPTO_DIGEST_SHA256};
+        result = cominitCryptoDigestsFromKeyfile(keyfile, &digests);
+        if (result == EXIT_SUCCESS) {
+            memcpy(digest, digests.sha256, SHA256_LEN);
+        }
+    }
+
+    return result;
+}
+
+int cominitCryptoDigestsFromKeyfile(const char *keyfile, cominitCryptoDigests_t *digests) {
+    int result = EXIT_FAILURE;
+
+    if (keyfile == NULL || digests == NULL) {
+        cominitErrPrint("Invalid parameters");
     } else {
         mbedtls_pk_context pkCtx;
         mbedtls_pk_init(&pkCtx);
@@ -108,10 +141,7 @@ int cominitCreateSHA256DigestfromKeyfile(const char *keyfile, unsigned char *dig
             int derLen = mbedtls_pk_write_pubkey_der(&pkCtx, der, sizeof(der));
             if (derLen > 0) {
                 const unsigned char *pubKeyDer = der + sizeof(der) - derLen;
-                err = cominitComputeSHA256(pubKeyDer, (size_t)derLen, digest);
-                if (err == 0) {
-                    result = EXIT_SUCCESS;
-                }
+                result = cominitCryptoDigests(pubKeyDer, (size_t)derLen, digests);
             }
         }
         mbedtls_pk_free(&pkCtx);
@@ -120,6 +150,95 @@ int cominitCreateSHA256DigestfromKeyfile(const char *keyfile, unsigned char *dig
     return result;
 }
 
+int cominitCryptoDigests(const uint8_t *data, size_t dataLen, cominitCryptoDigests_t *digests) {
+    int result = EXIT_FAILURE;
+
+    if ((data == NULL && dataLen > 0) || digests == NULL ||
+        (digests->algs & ~(unsigned int)(COMINIT_CRYPTO_DIGEST_SHA256 | COMINIT_CRYPTO_DIGEST_SHA384)) != 0) {
+        cominitErrPrint("Invalid parameters");
+    } else {
+        bool sha256 = (digests->algs & COMINIT_CRYPTO_DIGEST_SHA256) != 0;
+        bool sha384 = (digests->algs & COMINIT_CRYPTO_DIGEST_SHA384) != 0;
+        mbedtls_sha256_context sha256Ctx;
+        mbedtls_sha512_context sha384Ctx;
+        int err = 0;
+
+        mbedtls_sha256_init(&sha256Ctx);
+        mbedtls_sha512_init(&sha384Ctx);
+        if (sha256) {
+            err = cominitSha256Starts(&sha256Ctx);
+        }
+        if (err == 0 && sha384) {
+            err = cominitSha384Starts(&sha384Ctx);
+        }
+        /* Feed each chunk to all hashes while it is still in the cache. */
+        for (size_t offset = 0; err == 0 && offset < dataLen; offset += COMINIT_CRYPTO_DIGEST_CHUNK) {
+            size_t chunkLen = dataLen - offset;
+            if (chunkLen > COMINIT_CRYPTO_DIGEST_CHUNK) {
+                chunkLen = COMINIT_CRYPTO_DIGEST_CHUNK;
+            }
+            if (sha256) {
+                err = cominitSha256Update(&sha256Ctx, data + offset, chunkLen);
+            }
+            if (err == 0 && sha384) {
+                err = cominitSha384Update(&sha384Ctx, data + offset, chunkLen);
+            }
+        }
+        if (err == 0 && sha256) {
+            err = cominitSha256Finish(&sha256Ctx, digests->sha256);
+        }
+        if (err == 0 && sha384) {
+            err = cominitSha384Finish(&sha384Ctx, digests->sha384);
+        }
+        mbedtls_sha256_free(&sha256Ctx);
+        mbedtls_sha512_free(&sha384Ctx);
+
+        if (err != 0) {
+            mbedtls_strerror(err, cominitMbedtlsErrbuf, sizeof(cominitMbedtlsErrbuf));
+            cominitErrPrint("Hashing failed: %s", cominitMbedtlsErrbuf);
+        } else {
+            result = EXIT_SUCCESS;
+        }
+    }
+
+    return result;
+}
+
+int cominitCryptoSha256(const uint8_t *data, size_t dataLen, unsigned char *digest, size_t digestLen) {
+    int result = EXIT_FAILURE;
+
+    if ((data == NULL && dataLen > 0) || digest == NULL || digestLen < SHA256_LEN) {
+        cominitErrPrint("Invalid parameters");
+    } else {
+        int err = cominitComputeSHA256(data, dataLen, digest);
+        if (err == 0) {
+            result = EXIT_SUCCESS;
+        }
+    }
+
+    return result;
+}
+
+int cominitCryptoHkdfSha256(const uint8_t *ikm, size_t ikmLen, const uint8_t *info, size_t infoLen, uint8_t *okm,
+                            size_t okmLen) {
+    int result = EXIT_FAILURE;
+
+    if (ikm == NULL || ikmLen == 0 || (info == NULL && infoLen > 0) || okm == NULL || okmLen == 0 ||
+        okmLen > 255 * SHA256_LEN) {
+        cominitErrPrint("Invalid parameters");
+    } else {
+        int err = mbedtls_hkdf(mbedtls_md_info_from_type(MBEDTLS_MD_SHA256), NULL, 0, ikm, ikmLen, info, infoLen, okm,
+                               okmLen);
+        if (err != 0) {
+            cominitErrPrint("HKDF failed (%d)", err);
+        } else {
+            result = EXIT_SUCCESS;
+        }
+    }
+
+    return result;
+}
+
 /**
  * Creates an unique string for DRBG (Deterministic Random Bit Generator) seeding.
  *
@@ -139,7 +258,8 @@ static int cominitCryptoCreateUniqueString(unsigned char *uniqueString) {
         if (fgets(buffer, sizeof(buffer), file)) {
             size_t n = strcspn(buffer, "\r\n");
             buffer[n] = '\0';
-            if (mbedtls_sha256_ret((const unsigned char *)buffer, strlen(buffer), uniqueString, 0) == 0) {
+            int err = cominitComputeSHA256((const unsigned char *)buffer, strlen(buffer), uniqueString);
+            if (err == 0) {
                 result = EXIT_SUCCESS;
             }
         }
@@ -1,7 +1,9 @@
 #include "cryptsetup.h"
 
 #include <stdio.h>
+#include <stdlib.h>
 
+#include "kcapi.h"
 #include "output.h"
 #include "subprocess.h"
 #include "tpm.h"
@@ -10,21 +12,89 @@
 #define COMINIT_CRYPTSETUP_DIR "/usr/sbin/cryptsetup"
 #endif
 
-int cominitCryptsetupCreateLuksVolume(char *devCrypt, uint8_t *passphrase, size_t passphraseSize) {
+/**
+ * Candidate ciphers for new LUKS2 volumes. The first entry meeting the security floor is the fallback if no candidate
+ * can be benchmarked.
+ */
+static const cominitCryptsetupCipher_t cominitCryptsetupCiphers[] = {
+    {.name = "aes-xts-plain64", .kcapiName = "xts(aes)", .keySize = 64, .ivSize = 16, .strength = 256},
+    {.name = "xchacha12,aes-adiantum-plain64",
+     .kcapiName = "adiantum(xchacha12,aes)",
+     .keySize = 32,
+     .ivSize = 32,
+     .strength = 256},
+    {.name = "aes-xts-plain64", .kcapiName = "xts(aes)", .keySize = 32, .ivSize = 16, .strength = 128},
+};
+
+int cominitCryptsetupSelectCipher(unsigned int minStrength, const cominitCryptsetupCipher_t **cipher) {
     int result = EXIT_FAILURE;
 
-    if (devCrypt == NULL || passphrase == NULL || passphraseSize <= 0) {
+    if (cipher == NULL) {
         cominitErrPrint("Invalid parameters");
     } else {
+        const cominitCryptsetupCipher_t *fastest = NULL;
+        const cominitCryptsetupCipher_t *fallback = NULL;
+        uint64_t fastestNs = UINT64_MAX;
+
+        for (size_t i = 0; i < ARRAY_SIZE(cominitCryptsetupCiphers); i++) {
+            const cominitCryptsetupCipher_t *candidate = &cominitCryptsetupCiphers[i];
+            uint64_t ns = 0;
+
+            if (candidate->strength < minStrength) {
+                continue;
+            }
+            if (fallback == NULL) {
+                fallback = candidate;
+            }
+            if (cominitKcapiBenchmarkSkcipher(candidate->kcapiName, candidate->keySize, candidate->ivSize, &ns) !=
+                EXIT_SUCCESS) {
+                cominitInfoPrint("Cipher %s (%zu bit key) not available", candidate->name, candidate->keySize * 8);
+                continue;
+            }
+            cominitInfoPrint("Cipher %s (%zu bit key): %llu us/MiB", candidate->name, candidate->keySize * 8,
+                             (unsigned long long)(ns / 1000 / COMINIT_KCAPI_BENCH_SIZE_MIB));
+            if (ns < fastestNs) {
+                fastest = candidate;
+                fastestNs = ns;
+            }
+        }
+
+        if (fallback == NULL) {
+            cominitErrPrint("No cipher provides a security strength of %u bits", minStrength);
+        } else {
+            if (fastest == NULL) {
+                cominitWarnPrint("Could not benchmark any cipher, falling back to %s (%zu bit key)", fallback->name,
+                                 fallback->keySize * 8);
+                fastest = fallback;
+            }
+            *cipher = fastest;
+            result = EXIT_SUCCESS;
+        }
+    }
+
+    return result;
+}
+
+int cominitCryptsetupCreateLuksVolume(char *devCrypt, const cominitCryptsetupCipher_t *cipher, uint8_t *passphrase,
+                                      size_t passphraseSize) {
+    int result = EXIT_FAILURE;
+
+    if (devCrypt == NULL || cipher == NULL || passphrase == NULL || passphraseSize <= 0) {
+        cominitErrPrint("Invalid parameters");
+    } else {
+        char keySize[16];
+        snprintf(keySize, sizeof(keySize), "%zu", cipher->keySize * 8);
+
+        cominitInfoPrint("Creating LUKS volume using %s with a %s bit key", cipher->name, keySize);
         char *const argv[] = {(char *)COMINIT_CRYPTSETUP_DIR,
                               "luksFormat",
                               "--batch-mode",
                               "--type",
                               "luks2",
                               "--key-size",
-                              "512",
+                              keySize,
                               "--cipher",
-                              "aes-xts-plain64",
+                              (char *)cipher->name,
                               "--iter-time",
                               "10",
                               "--key-file",
@@ -33,32 +103,64 @@ int cominitCryptsetupCreateLuksVolume(char *devCrypt, uint8_t *passphrase, size_
                               NULL};
         char *env[] = {NULL};
 
-        result = cominitSubprocessSpawnAndWrite(argv[0], argv, env, passphrase, passphraseSize);
+        result = cominitSubprocessSpawnAndWriteWithTimeout(argv[0], argv, env, passphrase, passphraseSize,
+                                                           COMINIT_SUBPROCESS_FORMAT_TIMEOUT_MS);
     }
 
     return result;
 }
 
-int cominitCryptsetupOpenLuksVolume(char *devCrypt) {
+int cominitCryptsetupOpenLuksVolumes(char *const devCrypt[], char *const names[], int results[], size_t count) {
     int result = EXIT_FAILURE;
 
-    if (devCrypt == NULL) {
+    if (devCrypt == NULL || names == NULL || results == NULL || count == 0) {
         cominitErrPrint("Invalid parameters");
     } else {
-        char *const argv[] = {(char *)COMINIT_CRYPTSETUP_DIR, "luksOpen", devCrypt,
-                              (char *)COMINIT_TPM_SECURE_STORAGE_NAME, NULL};
-        char *env[] = {NULL};
+        pid_t *pids = calloc(count, sizeof(*pids));
+        if (pids == NULL) {
+            cominitErrnoPrint("calloc failed");
+        } else {
+            char *env[] = {NULL};
 
-        result = cominitSubprocessSpawn(argv[0], argv, env);
+            result = EXIT_SUCCESS;
+            for (size_t i = 0; i < count; i++) {
+                pids[i] = -1;
+                results[i] = EXIT_FAILURE;
+                if (devCrypt[i] == NULL || names[i] == NULL) {
+                    cominitErrPrint("Invalid parameters");
+                    result = EXIT_FAILURE;
+                } else {
+                    char *const argv[] = {(char *)COMINIT_CRYPTSETUP_DIR, "luksOpen", devCrypt[i], names[i], NULL};
+                    pids[i] = cominitSubprocessStart(argv[0], argv, env);
+                    if (pids[i] <= 0) {
+                        cominitErrPrint("Could not start opening LUKS volume %s", names[i]);
+                        result = EXIT_FAILURE;
+                    }
+                }
+            }
+
+            /* Reap every started cryptsetup, even if another one failed, so no zombie is left behind. */
+            for (size_t i = 0; i < count; i++) {
+                if (pids[i] > 0) {
+                    results[i] = cominitSubprocessWait(pids[i]);
+                    if (results[i] != EXIT_SUCCESS) {
+                        cominitErrPrint("Could not open LUKS volume %s", names[i]);
+                        results[i] = EXIT_FAILURE;
+                        result = EXIT_FAILURE;
+                    }
+                }
+            }
+            free(pids);
+        }
     }
 
     return result;
 }
 
-int cominitCryptsetupAddToken(char *devCrypt) {
+int cominitCryptsetupAddToken(char *devCrypt, const char *keyDesc) {
     int result = EXIT_FAILURE;
 
-    if (devCrypt == NULL) {
+    if (devCrypt == NULL || keyDesc == NULL) {
         cominitErrPrint("Invalid parameters");
     } else {
         char *const argv[] = {(char *)COMINIT_CRYPTSETUP_DIR,
@@ -69,7 +171,7 @@ int cominitCryptsetupAddToken(char *devCrypt) {
                               "--key-slot",
                               "0",
                               "--key-description",
-                              (char *)COMINIT_TPM_SECURE_STORAGE_KEY_NAME,
+                              (char *)keyDesc,
                               (char *)devCrypt,
                               NULL};
         char *env[] = {NULL};
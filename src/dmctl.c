@@ -5,7 +5,6 @@
  */
 #include "dmctl.h"
 
-#include <ctype.h>
 #include <errno.h>
 #include <fcntl.h>
 #include <inttypes.h>
@@ -19,8 +18,10 @@
 #include <sys/stat.h>
 #include <unistd.h>
 
+#include "kcapi.h"
 #include "meta.h"
 #include "output.h"
+#include "securearena.h"
 #include "tpm.h"
 
 #define cominitIoctlSetVersion(ioctlStruct)               \
@@ -67,47 +68,25 @@ static int cominitDmctlGetSectors(const char *device, unsigned long *sectors) {
 }
 
 /**
- * Check whether the algorithm for encryption is found.
+ * Check whether the Kernel provides all crypto algorithms the rootfs device mapper table depends on.
  *
- * @param algorithm  The name of the algorithm to look for.
+ * Done before any device is created, so a missing algorithm is reported by name instead of an opaque failure of
+ * DM_TABLE_LOAD.
+ *
+ * @param rfsMeta  The rootfs metadata holding the algorithms found by cominitLoadVerifyMetadata().
  *
  * @return  0 on success, -1 otherwise
  */
-static int cominitDmctlCheckForCryptoAlg(const char *algorithm) {
-    if (access("/proc/crypto", F_OK) != 0) {
-        cominitErrnoPrint("/proc/crypto not mounted");
-        return -1;
-    }
-    FILE *f = fopen("/proc/crypto", "r");
-    if (!f) {
-        cominitErrnoPrint("could not open /proc/crypto");
-        return -1;
-    }
-    char line[256];
-    int found = 0;
-    while (fgets(line, sizeof(line), f)) {
-        if (strncmp(line, "name", 4) == 0) {
-            char *separator = strrchr(line, ':');
-            if (separator) {
-                char *algorithmName = separator + 1;
-                while (isspace((unsigned char)*algorithmName)) {
-                    algorithmName++;
-                }
-                algorithmName[strcspn(algorithmName, "\n")] = '\0';
-
-                if (strcmp(algorithmName, algorithm) == 0) {
-                    found = 1;
-                    break;
-                }
-            }
+static int cominitDmctlProbeAlgs(const cominitRfsMetaData_t *rfsMeta) {
+    for (size_t i = 0; i < rfsMeta->dmAlgCount; i++) {
+        const cominitDmAlg_t *alg = &rfsMeta->dmAlgs[i];
+        if (cominitKcapiProbe(alg->type, alg->name) != EXIT_SUCCESS) {
+            cominitErrPrint("Kernel does not support %s \'%s\' required by the rootfs.", alg->type, alg->name);
+            return -1;
         }
     }
-    fclose(f);
-    if (found) {
-        return 0;
-    }
 
-    return -1;
+    return 0;
 }
 
 /**
@@ -158,23 +137,89 @@ static inline int cominitDmctlLoadDmTable(int dmCtlFd, cominitDmIoctlData_t *dmi
     return ioctl(dmCtlFd, (int)DM_TABLE_LOAD, &dmi->ioctl);
 }
 
+/**
+ * Remove a device-mapper device.
+ *
+ * @param dmCtlFd  An open file descriptor to /dev/mapper/control.
+ * @param dmi  Pointer to a cominitDmIoctlData_t structure.
+ * @param name  The name of the device-mapper device.
+ *
+ * @return  0 on success, -1 otherwise
+ */
+static int cominitDmctlRemoveDmDevice(int dmCtlFd, cominitDmIoctlData_t *dmi, const char *name) {
+    memset(&dmi->ioctl, 0, sizeof(dmi->ioctl));
+    cominitIoctlSetVersion(dmi->ioctl);
+    dmi->ioctl.data_size = sizeof(dmi->ioctl);
+    strcpy(dmi->ioctl.name, name);
+
+    return ioctl(dmCtlFd, (int)DM_DEV_REMOVE, &dmi->ioctl);
+}
+
+/**
+ * Get the device-mapper target of the rootfs.
+ *
+ * @param rfsMeta  The rootfs metadata.
+ *
+ * @return  "verity" or "integrity" on success, NULL if the metadata requires no supported target
+ */
+static const char *cominitDmctlGetTarget(const cominitRfsMetaData_t *rfsMeta) {
+    if (rfsMeta->crypt == COMINIT_CRYPTOPT_VERITY) {
+        if (!rfsMeta->ro) {
+            cominitErrPrint("A dm-verity target can only be opened read-only.");
+            return NULL;
+        }
+        return "verity";
+    }
+    if (rfsMeta->crypt == COMINIT_CRYPTOPT_INTEGRITY) {
+        return "integrity";
+    }
+    cominitErrPrint("Unsupported device mapper target.");
+    return NULL;
+}
+
+/**
+ * Load the dm-verity or dm-integrity table of the rootfs into a device-mapper device.
+ *
+ * @param dmCtlFd  An open file descriptor to /dev/mapper/control.
+ * @param dmi  Pointer to a cominitDmIoctlData_t structure.
+ * @param rfsMeta  The rootfs metadata holding the table.
+ * @param dmTgtStr  The target returned by cominitDmctlGetTarget().
+ * @param devId  The Id of the device-mapper device.
+ * @param ro  Flag to load the table read-only.
+ *
+ * @return  0 on success, -1 otherwise
+ */
+static int cominitDmctlLoadRootfsTable(int dmCtlFd, cominitDmIoctlData_t *dmi, const cominitRfsMetaData_t *rfsMeta,
+                                       const char *dmTgtStr, uint64_t devId, bool ro) {
+    memset(dmi, 0, sizeof(*dmi));
+    cominitIoctlSetVersion(dmi->ioctl);
+    dmi->ioctl.dev = devId;
+    dmi->ioctl.flags = ro ? DM_READONLY_FLAG : 0;
+    dmi->ioctl.target_count = 1;
+    dmi->ioctl.data_start = offsetof(cominitDmIoctlData_t, tSpec) - offsetof(cominitDmIoctlData_t, ioctl);
+    dmi->tSpec.sector_start = 0;
+    dmi->tSpec.length = rfsMeta->dmVerintDataSizeBytes / 512;
+    strncpy(dmi->tSpec.target_type, dmTgtStr, sizeof(dmi->tSpec.target_type));
+    dmi->tSpec.target_type[sizeof(dmi->tSpec.target_type) - 1] = '\0';
+    char *dmTblEnd = stpncpy(dmi->dmTbl, rfsMeta->dmTableVerint, sizeof(dmi->dmTbl) - 1);
+    *dmTblEnd = '\0';
+    dmi->ioctl.data_size = dmTblEnd + 1 - (char *)&dmi->ioctl;
+
+    return cominitDmctlLoadDmTable(dmCtlFd, dmi);
+}
+
 int cominitSetupDmDevice(cominitRfsMetaData_t *rfsMeta) {
     if (rfsMeta == NULL) {
         cominitErrPrint("Input parameter must not be NULL.");
         return -1;
     }
 
-    const char *dmTgtStr;
-    if (rfsMeta->crypt == COMINIT_CRYPTOPT_VERITY) {
-        if (!rfsMeta->ro) {
-            cominitErrPrint("A dm-verity target can only be opened read-only.");
-            return -1;
-        }
-        dmTgtStr = "verity";
-    } else if (rfsMeta->crypt == COMINIT_CRYPTOPT_INTEGRITY) {
-        dmTgtStr = "integrity";
-    } else {
-        cominitErrPrint("Unsupported device mapper target.");
+    const char *dmTgtStr = cominitDmctlGetTarget(rfsMeta);
+    if (dmTgtStr == NULL) {
+        return -1;
+    }
+
+    if (cominitDmctlProbeAlgs(rfsMeta) == -1) {
         return -1;
     }
 
@@ -194,20 +239,7 @@ int cominitSetupDmDevice(cominitRfsMetaData_t *rfsMeta) {
     uint64_t devId = dmi.ioctl.dev;
 
     // Load dm-verity table to device mapper.
-    memset(&dmi, 0, sizeof(dmi));
-    cominitIoctlSetVersion(dmi.ioctl);
-    dmi.ioctl.dev = devId;
-    dmi.ioctl.flags = rfsMeta->ro ? DM_READONLY_FLAG : 0;
-    dmi.ioctl.target_count = 1;
-    dmi.ioctl.data_start = offsetof(cominitDmIoctlData_t, tSpec) - offsetof(cominitDmIoctlData_t, ioctl);
-    dmi.tSpec.sector_start = 0;
-    dmi.tSpec.length = rfsMeta->dmVerintDataSizeBytes / 512;
-    strncpy(dmi.tSpec.target_type, dmTgtStr, sizeof(dmi.tSpec.target_type));
-    dmi.tSpec.target_type[sizeof(dmi.tSpec.target_type) - 1] = '\0';
-    char *dmTblEnd = stpncpy(dmi.dmTbl, rfsMeta->dmTableVerint, sizeof(dmi.dmTbl) - 1);
-    *dmTblEnd = '\0';
-    dmi.ioctl.data_size = dmTblEnd + 1 - (char *)&dmi.ioctl;
-    if (cominitDmctlLoadDmTable(dmCtlFd, &dmi) == -1) {
+    if (cominitDmctlLoadRootfsTable(dmCtlFd, &dmi, rfsMeta, dmTgtStr, devId, rfsMeta->ro) == -1) {
         cominitErrnoPrint("Could not load device mapper table using ioctl().");
         close(dmCtlFd);
         return -1;
@@ -236,14 +268,55 @@ int cominitSetupDmDevice(cominitRfsMetaData_t *rfsMeta) {
     return 0;
 }
 
+int cominitProbeDmDevice(const cominitRfsMetaData_t *rfsMeta, const char *name) {
+    if (rfsMeta == NULL || name == NULL || strlen(name) >= DM_NAME_LEN) {
+        cominitErrPrint("Invalid parameters.");
+        return -1;
+    }
+
+    const char *dmTgtStr = cominitDmctlGetTarget(rfsMeta);
+    if (dmTgtStr == NULL) {
+        return -1;
+    }
+
+    int dmCtlFd = open("/dev/" DM_DIR "/" DM_CONTROL_NODE, O_RDWR);
+    if (dmCtlFd == -1) {
+        cominitErrnoPrint("Could not open \'/dev/" DM_DIR "/" DM_CONTROL_NODE "\'.");
+        return -1;
+    }
+
+    int result = 0;
+    cominitDmIoctlData_t dmi;
+    if (cominitDmctlCreateNewDmDevice(dmCtlFd, &dmi, name) == -1) {
+        cominitErrnoPrint("Could not create device mapper device \'%s\' using ioctl().", name);
+        close(dmCtlFd);
+        return -1;
+    }
+
+    // Read-only and never resumed, so the partition is not written.
+    if (cominitDmctlLoadRootfsTable(dmCtlFd, &dmi, rfsMeta, dmTgtStr, dmi.ioctl.dev, true) == -1) {
+        cominitErrnoPrint("Could not load device mapper table using ioctl().");
+        result = -1;
+    }
+
+    if (cominitDmctlRemoveDmDevice(dmCtlFd, &dmi, name) == -1) {
+        cominitErrnoPrint("Could not remove device mapper device \'%s\' using ioctl().", name);
+        result = -1;
+    }
+
+    close(dmCtlFd);
+
+    return result;
+}
+
 int cominitSetupDmDeviceCrypt(char *device, const char *name, const TPM2B_DIGEST *key, uint64_t offsetSectors) {
     if (access(device, F_OK) != 0) {
         cominitErrnoPrint("/'%s/' not ready", device);
         return -1;
     }
 
-    if (cominitDmctlCheckForCryptoAlg("xts(aes)") != 0) {
-        cominitErrnoPrint("Kernel does not support /'%s'/ crypt algorithm", "xts(aes)");
+    if (cominitKcapiProbeDmCipher(COMINIT_DMCTL_CRYPT_CIPHER) != EXIT_SUCCESS) {
+        cominitErrPrint("Kernel does not support \'%s\' crypt cipher.", COMINIT_DMCTL_CRYPT_CIPHER);
         return -1;
     }
 
@@ -275,12 +348,15 @@ int cominitSetupDmDeviceCrypt(char *device, const char *name, const TPM2B_DIGEST
     unsigned long mapLength = totalSectors - offsetSectors;
 
     size_t hexLen = key->size * 2 + 1;
-    char *keyHex = malloc(hexLen);
+    char *keyHex = cominitSecureArenaAlloc(hexLen);
+    if (keyHex == NULL) {
+        cominitErrPrint("Could not allocate key buffer.");
+        close(dmCtlFd);
+        return -1;
+    }
     if (cominitBytesToHex(keyHex, key->buffer, key->size) == -1) {
         cominitErrnoPrint("Could not convert bytes to hex.", device);
-        /* Overwrite key in memory */
-        memset(keyHex, 0, hexLen);
-        free(keyHex);
+        cominitSecureArenaFree(keyHex, hexLen);
         close(dmCtlFd);
         return -1;
     }
@@ -288,12 +364,10 @@ int cominitSetupDmDeviceCrypt(char *device, const char *name, const TPM2B_DIGEST
     uint64_t start = 0;
     uint64_t ivOffset = 0;
 
-    snprintf(dmi.dmTbl, sizeof(dmi.dmTbl), "aes-xts-plain64 %s %" PRIu64 " %s %" PRIu64 "", keyHex, ivOffset, device,
-             offsetSectors);
+    snprintf(dmi.dmTbl, sizeof(dmi.dmTbl), "%s %s %" PRIu64 " %s %" PRIu64 "", COMINIT_DMCTL_CRYPT_CIPHER, keyHex,
+             ivOffset, device, offsetSectors);
 
-    /* Overwrite key in memory */
-    memset(keyHex, 0, hexLen);
-    free(keyHex);
+    cominitSecureArenaFree(keyHex, hexLen);
 
     strncpy(dmi.tSpec.target_type, "crypt", sizeof(dmi.tSpec.target_type));
     dmi.tSpec.target_type[sizeof(dmi.tSpec.target_type) - 1] = '\0';
@@ -315,7 +389,7 @@ int cominitSetupDmDeviceCrypt(char *device, const char *name, const TPM2B_DIGEST
     }
 
     /* Overwrite key in memory */
-    memset(&dmi.dmTbl, 0, sizeof(dmi.dmTbl));
+    cominitSecureArenaWipe(&dmi.dmTbl, sizeof(dmi.dmTbl));
 
     if (cominitDmctlStartDmDevice(dmCtlFd, &dmi, devId) == -1) {
         cominitErrnoPrint("Could not make the device mapper resume using ioctl().");
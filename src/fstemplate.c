@@ -0,0 +1,408 @@
+// SPDX-License-Identifier: MIT
+/**
+ * @file fstemplate.c
+ * @brief Implementation of creating a filesystem from a pre-built sparse image template.
+ */
+#include "fstemplate.h"
+
+#include <errno.h>
+#include <fcntl.h>
+#include <inttypes.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/ioctl.h>
+#include <sys/mount.h>
+#include <sys/stat.h>
+#include <sys/statfs.h>
+#include <unistd.h>
+
+#include "common.h"
+#include "output.h"
+
+#ifndef SEEK_DATA
+#define SEEK_DATA 3
+#endif
+#ifndef SEEK_HOLE
+#define SEEK_HOLE 4
+#endif
+
+#ifndef EXT4_IOC_RESIZE_FS
+#define EXT4_IOC_RESIZE_FS _IOW('f', 16, uint64_t)
+#endif
+
+#ifndef BLKZEROOUT
+#define BLKZEROOUT _IO(0x12, 127)
+#endif
+
+#define COMINIT_FSTEMPLATE_RANDOM "/dev/urandom"  ///< Source of the new UUID and hash seed.
+
+#define COMINIT_EXT4_SB_OFFSET 1024              ///< Offset of the primary ext4 superblock.
+#define COMINIT_EXT4_SB_SIZE 1024                ///< Size of the ext4 superblock.
+#define COMINIT_EXT4_SB_MAGIC_OFF 0x38           ///< Offset of s_magic.
+#define COMINIT_EXT4_SB_INCOMPAT_OFF 0x60        ///< Offset of s_feature_incompat.
+#define COMINIT_EXT4_SB_RO_COMPAT_OFF 0x64       ///< Offset of s_feature_ro_compat.
+#define COMINIT_EXT4_SB_UUID_OFF 0x68            ///< Offset of s_uuid.
+#define COMINIT_EXT4_SB_HASH_SEED_OFF 0xEC       ///< Offset of s_hash_seed.
+#define COMINIT_EXT4_SB_CSUM_SEED_OFF 0x270      ///< Offset of s_checksum_seed.
+#define COMINIT_EXT4_SB_CSUM_OFF 0x3FC           ///< Offset of s_checksum.
+#define COMINIT_EXT4_ID_SIZE 16                  ///< Size of s_uuid and s_hash_seed.
+#define COMINIT_EXT4_MAGIC 0xEF53u               ///< The ext2/3/4 superblock magic.
+#define COMINIT_EXT4_RO_COMPAT_GDT_CSUM 0x10u    ///< Feature uninit_bg.
+#define COMINIT_EXT4_RO_COMPAT_CSUM 0x400u       ///< Feature metadata_csum.
+#define COMINIT_EXT4_INCOMPAT_CSUM_SEED 0x2000u  ///< Feature metadata_csum_seed.
+
+/**
+ * Copy a single data extent.
+ *
+ * @param inFd      File descriptor of the template.
+ * @param outFd     File descriptor of the target.
+ * @param start     Offset of the extent.
+ * @param end       Offset of the first Byte after the extent.
+ * @param buffer    Copy buffer of #COMINIT_FSTEMPLATE_COPY_CHUNK Bytes.
+ *
+ * @return  EXIT_SUCCESS on success, EXIT_FAILURE otherwise
+ */
+static int cominitFsTemplateCopyExtent(int inFd, int outFd, off_t start, off_t end, uint8_t *buffer) {
+    int result = EXIT_SUCCESS;
+
+    for (off_t pos = start; pos < end && result == EXIT_SUCCESS;) {
+        size_t len =
+            ((end - pos) < COMINIT_FSTEMPLATE_COPY_CHUNK) ? (size_t)(end - pos) : COMINIT_FSTEMPLATE_COPY_CHUNK;
+        ssize_t n = pread(inFd, buffer, len, pos);
+        if (n <= 0) {
+            cominitErrnoPrint("Could not read template at offset %jd", (intmax_t)pos);
+            result = EXIT_FAILURE;
+        } else if (pwrite(outFd, buffer, (size_t)n, pos) != n) {
+            cominitErrnoPrint("Could not write template at offset %jd", (intmax_t)pos);
+            result = EXIT_FAILURE;
+        } else {
+            pos += n;
+        }
+    }
+
+    return result;
+}
+
+/**
+ * Zero a hole of the template on the target.
+ *
+ * Block devices are zeroed by the Kernel using BLKZEROOUT. If that is not supported (e.g. for regular files), zeros
+ * are written.
+ *
+ * @param outFd     File descriptor of the target.
+ * @param start     Offset of the hole.
+ * @param end       Offset of the first Byte after the hole.
+ * @param buffer    Copy buffer of #COMINIT_FSTEMPLATE_COPY_CHUNK Bytes.
+ *
+ * @return  EXIT_SUCCESS on success, EXIT_FAILURE otherwise
+ */
+static int cominitFsTemplateZeroHole(int outFd, off_t start, off_t end, uint8_t *buffer) {
+    int result = EXIT_SUCCESS;
+    uint64_t range[2] = {(uint64_t)start, (uint64_t)(end - start)};
+
+    if (start < end && ioctl(outFd, BLKZEROOUT, range) != 0) {
+        memset(buffer, 0, COMINIT_FSTEMPLATE_COPY_CHUNK);
+        for (off_t pos = start; pos < end && result == EXIT_SUCCESS;) {
+            size_t len =
+                ((end - pos) < COMINIT_FSTEMPLATE_COPY_CHUNK) ? (size_t)(end - pos) : COMINIT_FSTEMPLATE_COPY_CHUNK;
+            ssize_t n = pwrite(outFd, buffer, len, pos);
+            if (n <= 0) {
+                cominitErrnoPrint("Could not zero template hole at offset %jd", (intmax_t)pos);
+                result = EXIT_FAILURE;
+            } else {
+                pos += n;
+            }
+        }
+    }
+
+    return result;
+}
+
+int cominitFsTemplateCopy(const char *templatePath, const char *device, uint64_t *written) {
+    int result = EXIT_FAILURE;
+    uint64_t total = 0;
+
+    if (templatePath == NULL || device == NULL) {
+        cominitErrPrint("Invalid parameters");
+    } else {
+        int inFd = open(templatePath, O_RDONLY | O_CLOEXEC);
+        int outFd = open(device, O_WRONLY | O_CLOEXEC);
+        uint8_t *buffer = malloc(COMINIT_FSTEMPLATE_COPY_CHUNK);
+
+        if (inFd < 0 || outFd < 0) {
+            cominitErrnoPrint("Could not open template \'%s\' or target \'%s\'", templatePath, device);
+        } else if (buffer == NULL) {
+            cominitErrnoPrint("malloc failed");
+        } else {
+            off_t pos = 0;
+            off_t data;
+            off_t size = lseek(inFd, 0, SEEK_END);
+            result = (size < 0) ? EXIT_FAILURE : EXIT_SUCCESS;
+            while (result == EXIT_SUCCESS && (data = lseek(inFd, pos, SEEK_DATA)) >= 0) {
+                off_t hole = lseek(inFd, data, SEEK_HOLE);
+                if (hole < 0) {
+                    cominitErrnoPrint("Could not find end of data extent at offset %jd", (intmax_t)data);
+                    result = EXIT_FAILURE;
+                } else {
+                    result = cominitFsTemplateZeroHole(outFd, pos, data, buffer);
+                    if (result == EXIT_SUCCESS) {
+                        result = cominitFsTemplateCopyExtent(inFd, outFd, data, hole, buffer);
+                    }
+                    total += (uint64_t)(hole - data);
+                    pos = hole;
+                }
+            }
+            /* lseek(SEEK_DATA) fails with ENXIO once there is no more data after pos */
+            if (result == EXIT_SUCCESS && errno != ENXIO) {
+                cominitErrnoPrint("Could not find next data extent in template");
+                result = EXIT_FAILURE;
+            }
+            if (result == EXIT_SUCCESS) {
+                result = cominitFsTemplateZeroHole(outFd, pos, size, buffer);
+            }
+            if (result == EXIT_SUCCESS && fsync(outFd) != 0) {
+                cominitErrnoPrint("Could not sync \'%s\'", device);
+                result = EXIT_FAILURE;
+            }
+        }
+
+        free(buffer);
+        if (inFd >= 0) {
+            close(inFd);
+        }
+        if (outFd >= 0) {
+            close(outFd);
+        }
+    }
+
+    if (result == EXIT_SUCCESS && written != NULL) {
+        *written = total;
+    }
+
+    return result;
+}
+
+/**
+ * Read a little endian 32 bit value.
+ *
+ * @param p  The buffer to read from.
+ *
+ * @return  The value.
+ */
+static uint32_t cominitFsTemplateGetLe32(const uint8_t *p) {
+    return (uint32_t)p[0] | ((uint32_t)p[1] << 8) | ((uint32_t)p[2] << 16) | ((uint32_t)p[3] << 24);
+}
+
+/**
+ * Write a little endian 32 bit value.
+ *
+ * @param p      The buffer to write to.
+ * @param value  The value.
+ */
+static void cominitFsTemplatePutLe32(uint8_t *p, uint32_t value) {
+    for (size_t i = 0; i < sizeof(value); i++) {
+        p[i] = (uint8_t)(value >> (8 * i));
+    }
+}
+
+/**
+ * Compute a CRC32C the way ext4 does, i.e. without the final inversion.
+ *
+ * @param crc   The initial value.
+ * @param data  The data.
+ * @param len   The amount of Bytes in \a data.
+ *
+ * @return  The CRC32C.
+ */
+static uint32_t cominitFsTemplateCrc32c(uint32_t crc, const uint8_t *data, size_t len) {
+    for (size_t i = 0; i < len; i++) {
+        crc ^= data[i];
+        for (int bit = 0; bit < 8; bit++) {
+            crc = (crc >> 1) ^ (0x82F63B78u & (0u - (crc & 1u)));
+        }
+    }
+
+    return crc;
+}
+
+/**
+ * Read random Bytes.
+ *
+ * /dev/urandom is used as it does not block while the Kernel is still collecting entropy early in boot.
+ *
+ * @param buffer  The buffer to fill.
+ * @param len     The amount of Bytes to read.
+ *
+ * @return  EXIT_SUCCESS on success, EXIT_FAILURE otherwise
+ */
+static int cominitFsTemplateRandom(uint8_t *buffer, size_t len) {
+    int result = EXIT_FAILURE;
+
+    int fd = open(COMINIT_FSTEMPLATE_RANDOM, O_RDONLY | O_CLOEXEC);
+    if (fd < 0) {
+        cominitErrnoPrint("Could not open \'%s\'", COMINIT_FSTEMPLATE_RANDOM);
+    } else {
+        if (read(fd, buffer, len) != (ssize_t)len) {
+            cominitErrnoPrint("Could not read \'%s\'", COMINIT_FSTEMPLATE_RANDOM);
+        } else {
+            result = EXIT_SUCCESS;
+        }
+        close(fd);
+    }
+
+    return result;
+}
+
+/**
+ * Give an ext4 superblock a new random UUID and hash seed and update its checksum.
+ *
+ * @param sb      The superblock of #COMINIT_EXT4_SB_SIZE Bytes, is modified.
+ * @param device  Path to the device the superblock was read from, for logging.
+ *
+ * @return  EXIT_SUCCESS on success, EXIT_FAILURE otherwise
+ */
+static int cominitFsTemplateRenewSuperblock(uint8_t *sb, const char *device) {
+    int result = EXIT_FAILURE;
+    uint32_t incompat = cominitFsTemplateGetLe32(sb + COMINIT_EXT4_SB_INCOMPAT_OFF);
+    uint32_t roCompat = cominitFsTemplateGetLe32(sb + COMINIT_EXT4_SB_RO_COMPAT_OFF);
+    bool csum = (roCompat & COMINIT_EXT4_RO_COMPAT_CSUM) != 0;
+
+    if ((sb[COMINIT_EXT4_SB_MAGIC_OFF] | (sb[COMINIT_EXT4_SB_MAGIC_OFF + 1] << 8)) != COMINIT_EXT4_MAGIC) {
+        cominitErrPrint("\'%s\' does not hold an ext4 filesystem", device);
+    } else if (csum == false && (roCompat & COMINIT_EXT4_RO_COMPAT_GDT_CSUM) != 0) {
+        cominitErrPrint("Cannot renew the UUID of \'%s\', it uses uninit_bg without metadata_csum", device);
+    } else {
+        /* The other metadata checksums are seeded from the UUID, keep that seed before replacing the UUID */
+        if (csum == true && (incompat & COMINIT_EXT4_INCOMPAT_CSUM_SEED) == 0) {
+            uint32_t seed = cominitFsTemplateCrc32c(~0u, sb + COMINIT_EXT4_SB_UUID_OFF, COMINIT_EXT4_ID_SIZE);
+            cominitFsTemplatePutLe32(sb + COMINIT_EXT4_SB_CSUM_SEED_OFF, seed);
+            cominitFsTemplatePutLe32(sb + COMINIT_EXT4_SB_INCOMPAT_OFF, incompat | COMINIT_EXT4_INCOMPAT_CSUM_SEED);
+        }
+        result = cominitFsTemplateRandom(sb + COMINIT_EXT4_SB_UUID_OFF, COMINIT_EXT4_ID_SIZE);
+        if (result == EXIT_SUCCESS) {
+            result = cominitFsTemplateRandom(sb + COMINIT_EXT4_SB_HASH_SEED_OFF, COMINIT_EXT4_ID_SIZE);
+        }
+        if (result == EXIT_SUCCESS) {
+            /* Random UUID as of RFC 4122 version 4 */
+            sb[COMINIT_EXT4_SB_UUID_OFF + 6] = (uint8_t)((sb[COMINIT_EXT4_SB_UUID_OFF + 6] & 0x0Fu) | 0x40u);
+            sb[COMINIT_EXT4_SB_UUID_OFF + 8] = (uint8_t)((sb[COMINIT_EXT4_SB_UUID_OFF + 8] & 0x3Fu) | 0x80u);
+            if (csum == true) {
+                cominitFsTemplatePutLe32(sb + COMINIT_EXT4_SB_CSUM_OFF,
+                                         cominitFsTemplateCrc32c(~0u, sb, COMINIT_EXT4_SB_CSUM_OFF));
+            }
+        }
+    }
+
+    return result;
+}
+
+int cominitFsTemplateRenewIds(const char *device) {
+    int result = EXIT_FAILURE;
+    uint8_t sb[COMINIT_EXT4_SB_SIZE];
+
+    if (device == NULL) {
+        cominitErrPrint("Invalid parameters");
+    } else {
+        int fd = open(device, O_RDWR | O_CLOEXEC);
+        if (fd < 0) {
+            cominitErrnoPrint("Could not open \'%s\'", device);
+        } else {
+            if (pread(fd, sb, sizeof(sb), COMINIT_EXT4_SB_OFFSET) != (ssize_t)sizeof(sb)) {
+                cominitErrnoPrint("Could not read superblock of \'%s\'", device);
+            } else if (cominitFsTemplateRenewSuperblock(sb, device) == EXIT_SUCCESS) {
+                if (pwrite(fd, sb, sizeof(sb), COMINIT_EXT4_SB_OFFSET) != (ssize_t)sizeof(sb) || fsync(fd) != 0) {
+                    cominitErrnoPrint("Could not write superblock of \'%s\'", device);
+                } else {
+                    result = EXIT_SUCCESS;
+                }
+            }
+            close(fd);
+        }
+    }
+
+    return result;
+}
+
+/**
+ * Grow the ext4 filesystem mounted at #COMINIT_FSTEMPLATE_MNT to the given size.
+ *
+ * @param size  The target size in Bytes.
+ *
+ * @return  EXIT_SUCCESS on success, EXIT_FAILURE otherwise
+ */
+static int cominitFsTemplateResize(uint64_t size) {
+    int result = EXIT_FAILURE;
+    struct statfs fsInfo;
+
+    int fd = open(COMINIT_FSTEMPLATE_MNT, O_RDONLY | O_DIRECTORY | O_CLOEXEC);
+    if (fd < 0) {
+        cominitErrnoPrint("Could not open \'%s\'", COMINIT_FSTEMPLATE_MNT);
+    } else {
+        if (fstatfs(fd, &fsInfo) != 0 || fsInfo.f_bsize <= 0) {
+            cominitErrnoPrint("Could not get block size of \'%s\'", COMINIT_FSTEMPLATE_MNT);
+        } else {
+            uint64_t blocks = size / (uint64_t)fsInfo.f_bsize;
+            if (ioctl(fd, EXT4_IOC_RESIZE_FS, &blocks) != 0) {
+                cominitErrnoPrint("Could not resize filesystem to %" PRIu64 " blocks", blocks);
+            } else {
+                cominitDebugPrint("Resized filesystem to %" PRIu64 " blocks", blocks);
+                result = EXIT_SUCCESS;
+            }
+        }
+        close(fd);
+    }
+
+    return result;
+}
+
+int cominitFsTemplateApply(const char *templatePath, const char *device) {
+    int result = EXIT_FAILURE;
+    struct stat templateStat;
+    uint64_t deviceSize = 0;
+
+    if (templatePath == NULL || device == NULL) {
+        cominitErrPrint("Invalid parameters");
+    } else if (stat(templatePath, &templateStat) != 0) {
+        cominitErrnoPrint("Could not access template \'%s\'", templatePath);
+    } else {
+        int fd = open(device, O_RDONLY | O_CLOEXEC);
+        if (fd < 0) {
+            cominitErrnoPrint("Could not open \'%s\'", device);
+        } else {
+            if (cominitCommonGetPartSize(&deviceSize, fd) == 0) {
+                result = EXIT_SUCCESS;
+            }
+            close(fd);
+        }
+
+        if (result == EXIT_SUCCESS && (uint64_t)templateStat.st_size > deviceSize) {
+            cominitErrPrint("Template \'%s\' is larger than \'%s\'", templatePath, device);
+            result = EXIT_FAILURE;
+        }
+    }
+
+    if (result == EXIT_SUCCESS) {
+        uint64_t written = 0;
+        result = cominitFsTemplateCopy(templatePath, device, &written);
+        if (result == EXIT_SUCCESS) {
+            cominitInfoPrint("Wrote filesystem template of %jd Bytes with %" PRIu64 " data Bytes to \'%s\'",
+                             (intmax_t)templateStat.st_size, written, device);
+            result = EXIT_FAILURE;
+            if (cominitFsTemplateRenewIds(device) != EXIT_SUCCESS) {
+                cominitErrPrint("Could not renew the UUID and hash seed of the filesystem created from template");
+            } else if (mkdir(COMINIT_FSTEMPLATE_MNT, S_IRWXU) != 0 && errno != EEXIST) {
+                cominitErrnoPrint("Could not create \'%s\'", COMINIT_FSTEMPLATE_MNT);
+            } else if (mount(device, COMINIT_FSTEMPLATE_MNT, "ext4", MS_NOEXEC | MS_NOSUID | MS_NODEV, "") != 0) {
+                cominitErrnoPrint("Could not mount filesystem created from template");
+            } else {
+                result = cominitFsTemplateResize(deviceSize);
+                if (umount(COMINIT_FSTEMPLATE_MNT) != 0) {
+                    cominitErrnoPrint("Could not unmount \'%s\'", COMINIT_FSTEMPLATE_MNT);
+                    result = EXIT_FAILURE;
+                }
+            }
+        }
+    }
+
+    return result;
+}
@@ -0,0 +1,189 @@
+// SPDX-License-Identifier: MIT
+/**
+ * @file helper.c
+ * @brief Implementation of the background helper process that outlives the switch into the rootfs.
+ */
+#include "helper.h"
+
+#include <errno.h>
+#include <fcntl.h>
+#include <limits.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+#include "minsetup.h"
+#include "output.h"
+#include "securearena.h"
+
+#define COMINIT_HELPER_GO 'S'        ///< Byte sent to the helper once PID 1 has switched into the rootfs.
+#define COMINIT_HELPER_PREPARED 'P'  ///< Byte sent by the helper once its first task has finished.
+
+/**
+ * Create the readiness marker of a finished helper task in the rootfs.
+ *
+ * @param markerName    Name of the marker file without suffix.
+ * @param taskResult    The return value of the task.
+ */
+static void cominitHelperCreateMarker(const char *markerName, int taskResult) {
+    char path[PATH_MAX];
+    int n = snprintf(path, sizeof(path), COMINIT_HELPER_ROOTFS COMINIT_HELPER_RUN_DIR "/%s%s", markerName,
+                     (taskResult == EXIT_SUCCESS) ? COMINIT_HELPER_MARKER_READY : COMINIT_HELPER_MARKER_FAILED);
+
+    if (n < 0 || (size_t)n >= sizeof(path)) {
+        cominitErrPrint("Marker path for \'%s\' too long", markerName);
+    } else {
+        int fd = open(path, O_WRONLY | O_CREAT | O_CLOEXEC, 0644);
+        if (fd < 0) {
+            cominitErrnoPrint("Could not create marker \'%s\'", path);
+        } else {
+            close(fd);
+        }
+    }
+}
+
+/**
+ * Main function of the helper process.
+ *
+ * @param syncFd        Read end of the pipe used to release the helper.
+ * @param preparedFd    Helper end of the socket pair used to report that \a prepare has finished.
+ * @param prepare       The task to run right away, may be NULL.
+ * @param finish        The task to run once released.
+ * @param data          Pointer passed to \a prepare and \a finish.
+ * @param markerName    Name of the marker file without suffix.
+ *
+ * @return  The exit code of the helper
+ */
+static int cominitHelperRun(int syncFd, int preparedFd, cominitHelperTask_t prepare, cominitHelperTask_t finish,
+                            void *data, const char *markerName) {
+    char go = '\0';
+    const char prepared = COMINIT_HELPER_PREPARED;
+    ssize_t n;
+
+    /* The tasks may handle key material, which must stay locked in the helper as well. */
+    int result = cominitSecureArenaAfterFork();
+    if (result != EXIT_SUCCESS) {
+        cominitErrPrint("Could not lock secure arena in helper.");
+    } else if (prepare != NULL) {
+        result = prepare(data);
+    }
+
+    /* PID 1 only reads this in some modes and may have exec'd already, which must not raise SIGPIPE here. */
+    if (send(preparedFd, &prepared, sizeof(prepared), MSG_NOSIGNAL) != sizeof(prepared) && errno != EPIPE) {
+        cominitErrnoPrint("Could not report end of first task for \'%s\'", markerName);
+    }
+    close(preparedFd);
+
+    do {
+        n = read(syncFd, &go, sizeof(go));
+    } while (n < 0 && errno == EINTR);
+    close(syncFd);
+
+    if (n != sizeof(go) || go != COMINIT_HELPER_GO) {
+        cominitInfoPrint("Helper for \'%s\' not released, exiting.", markerName);
+        result = EXIT_FAILURE;
+    } else {
+        if (result == EXIT_SUCCESS) {
+            result = finish(data);
+        }
+        cominitHelperCreateMarker(markerName, result);
+
+        if (cominitCleanupSysfiles() == -1) {
+            cominitWarnPrint("Could not unmount all system/device files.");
+        }
+        cominitFreeInitramfs();
+    }
+
+    return result;
+}
+
+int cominitHelperStart(cominitHelper_t *helper, cominitHelperTask_t prepare, cominitHelperTask_t finish, void *data,
+                       const char *markerName) {
+    int result = EXIT_FAILURE;
+    int pipeFd[2] = {-1, -1};
+    int preparedSockFd[2] = {-1, -1};
+
+    if (helper == NULL || finish == NULL || markerName == NULL) {
+        cominitErrPrint("Invalid parameters");
+    } else if (pipe(pipeFd) != 0) {
+        cominitErrnoPrint("pipe failed");
+    } else if (socketpair(AF_UNIX, SOCK_STREAM, 0, preparedSockFd) != 0) {
+        cominitErrnoPrint("socketpair failed");
+        close(pipeFd[0]);
+        close(pipeFd[1]);
+    } else if (fcntl(pipeFd[1], F_SETFD, FD_CLOEXEC) != 0 || fcntl(preparedSockFd[0], F_SETFD, FD_CLOEXEC) != 0) {
+        /* The ends PID 1 keeps must be closed by the exec into the rootfs or rescue shell, otherwise the helper never
+         * exits. */
+        cominitErrnoPrint("Could not set close-on-exec flag");
+        close(pipeFd[0]);
+        close(pipeFd[1]);
+        close(preparedSockFd[0]);
+        close(preparedSockFd[1]);
+    } else {
+        pid_t pid = fork();
+        if (pid < 0) {
+            cominitErrnoPrint("fork failed");
+            close(pipeFd[0]);
+            close(pipeFd[1]);
+            close(preparedSockFd[0]);
+            close(preparedSockFd[1]);
+        } else if (pid == 0) {
+            close(pipeFd[1]);
+            close(preparedSockFd[0]);
+            _exit(cominitHelperRun(pipeFd[0], preparedSockFd[1], prepare, finish, data, markerName));
+        } else {
+            close(pipeFd[0]);
+            close(preparedSockFd[1]);
+            helper->pid = pid;
+            helper->syncFd = pipeFd[1];
+            helper->preparedFd = preparedSockFd[0];
+            cominitDebugPrint("Started helper for \'%s\' with PID %d.", markerName, (int)pid);
+            result = EXIT_SUCCESS;
+        }
+    }
+
+    return result;
+}
+
+int cominitHelperWaitPrepared(cominitHelper_t *helper) {
+    int result = EXIT_FAILURE;
+    char prepared = '\0';
+    ssize_t n;
+
+    if (helper == NULL || helper->preparedFd < 0) {
+        cominitErrPrint("Invalid parameters");
+    } else {
+        do {
+            n = read(helper->preparedFd, &prepared, sizeof(prepared));
+        } while (n < 0 && errno == EINTR);
+        if (n == sizeof(prepared) && prepared == COMINIT_HELPER_PREPARED) {
+            result = EXIT_SUCCESS;
+        } else {
+            cominitErrPrint("Helper exited before finishing its first task");
+        }
+        close(helper->preparedFd);
+        helper->preparedFd = -1;
+    }
+
+    return result;
+}
+
+int cominitHelperRelease(cominitHelper_t *helper) {
+    int result = EXIT_FAILURE;
+
+    if (helper == NULL || helper->syncFd < 0) {
+        cominitErrPrint("Invalid parameters");
+    } else {
+        const char go = COMINIT_HELPER_GO;
+        if (write(helper->syncFd, &go, sizeof(go)) != sizeof(go)) {
+            cominitErrnoPrint("Could not release helper");
+        } else {
+            result = EXIT_SUCCESS;
+        }
+        close(helper->syncFd);
+        helper->syncFd = -1;
+    }
+
+    return result;
+}
@@ -0,0 +1,329 @@
+// SPDX-License-Identifier: MIT
+/**
+ * @file kcapi.c
+ * @brief Implementation of Kernel Crypto API (AF_ALG) helpers.
+ */
+#include "kcapi.h"
+
+#include <ctype.h>
+#include <errno.h>
+#include <linux/if_alg.h>
+#include <stdbool.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/socket.h>
+#include <time.h>
+#include <unistd.h>
+
+#include "output.h"
+
+#ifndef SOL_ALG
+#define SOL_ALG 279
+#endif
+
+#define COMINIT_KCAPI_IV_MAX 64  ///< Upper limit for IV sizes accepted by cominitKcapiBenchmarkSkcipher().
+
+/**
+ * Result of a single algorithm probe.
+ */
+typedef struct cominitKcapiProbeEntry {
+    char type[COMINIT_KCAPI_TYPE_MAX];  ///< The algorithm type, e.g. "hash".
+    char name[COMINIT_KCAPI_NAME_MAX];  ///< The kernel crypto API name of the algorithm.
+    bool available;                     ///< true if the Kernel provides the algorithm.
+} cominitKcapiProbeEntry_t;
+
+/**
+ * Probe results of the current boot.
+ */
+static cominitKcapiProbeEntry_t cominitKcapiProbeCache[COMINIT_KCAPI_PROBE_CACHE_SIZE];
+static size_t cominitKcapiProbeCacheCount = 0;  ///< Number of valid entries in #cominitKcapiProbeCache.
+
+/**
+ * Open an AF_ALG transformation socket bound to the given algorithm.
+ *
+ * Binding to an algorithm the kernel does not know yet triggers loading of the corresponding crypto module.
+ *
+ * @param type      The algorithm type, e.g. "skcipher" or "hash".
+ * @param algName   The kernel crypto API name of the algorithm.
+ *
+ * @return  The socket file descriptor on success, -1 otherwise
+ */
+static int cominitKcapiBind(const char *type, const char *algName) {
+    int tfmFd = -1;
+    struct sockaddr_alg sa = {.salg_family = AF_ALG};
+
+    if (strlen(type) >= sizeof(sa.salg_type) || strlen(algName) >= sizeof(sa.salg_name)) {
+        cominitErrPrint("Algorithm name \'%s\' is too long", algName);
+    } else {
+        strncpy((char *)sa.salg_type, type, sizeof(sa.salg_type) - 1);
+        strncpy((char *)sa.salg_name, algName, sizeof(sa.salg_name) - 1);
+
+        tfmFd = socket(AF_ALG, SOCK_SEQPACKET | SOCK_CLOEXEC, 0);
+        if (tfmFd < 0) {
+            cominitErrnoPrint("Could not create AF_ALG socket");
+        } else if (bind(tfmFd, (struct sockaddr *)&sa, sizeof(sa)) != 0) {
+            cominitDebugPrint("Could not bind AF_ALG socket to %s \'%s\'", type, algName);
+            close(tfmFd);
+            tfmFd = -1;
+        }
+    }
+
+    return tfmFd;
+}
+
+/**
+ * Look up an algorithm in `/proc/crypto`.
+ *
+ * Used as a fallback if the algorithm could not be bound via AF_ALG, e.g. because the Kernel lacks the AF_ALG
+ * interface for its type. Only algorithms which are built-in or already loaded are listed.
+ *
+ * @param algName   The kernel crypto API name of the algorithm.
+ *
+ * @return  true if the algorithm is listed, false otherwise
+ */
+static bool cominitKcapiFindInProcCrypto(const char *algName) {
+    bool found = false;
+    FILE *f = fopen("/proc/crypto", "r");
+
+    if (f == NULL) {
+        cominitErrnoPrint("Could not open /proc/crypto");
+    } else {
+        char line[256];
+        while (!found && fgets(line, sizeof(line), f) != NULL) {
+            char *separator = strrchr(line, ':');
+            if (strncmp(line, "name", 4) == 0 && separator != NULL) {
+                char *listedName = separator + 1;
+                while (isspace((unsigned char)*listedName)) {
+                    listedName++;
+                }
+                listedName[strcspn(listedName, "\n")] = '\0';
+                found = (strcmp(listedName, algName) == 0);
+            }
+        }
+        fclose(f);
+    }
+
+    return found;
+}
+
+/**
+ * Encrypt a single request on an AF_ALG operation socket.
+ *
+ * @param opFd      The operation socket returned by accept() on a keyed transformation socket.
+ * @param iv        The IV for this request.
+ * @param ivSize    The size of \a iv in Bytes.
+ * @param in        The plaintext.
+ * @param out       The buffer receiving the ciphertext, must be at least \a len Bytes.
+ * @param len       The size of \a in in Bytes.
+ *
+ * @return  EXIT_SUCCESS on success, EXIT_FAILURE otherwise
+ */
+static int cominitKcapiEncrypt(int opFd, const uint8_t *iv, size_t ivSize, const uint8_t *in, uint8_t *out,
+                               size_t len) {
+    /* struct af_alg_iv is a 32 bit length followed by the IV itself */
+    uint8_t cbuf[CMSG_SPACE(sizeof(uint32_t)) + CMSG_SPACE(sizeof(uint32_t) + COMINIT_KCAPI_IV_MAX)] = {0};
+    struct iovec iov = {.iov_base = (void *)in, .iov_len = len};
+    struct msghdr msg = {
+        .msg_iov = &iov,
+        .msg_iovlen = 1,
+        .msg_control = cbuf,
+        .msg_controllen = CMSG_SPACE(sizeof(uint32_t)) + CMSG_SPACE(sizeof(uint32_t) + ivSize),
+    };
+
+    struct cmsghdr *cmsg = CMSG_FIRSTHDR(&msg);
+    uint32_t value = ALG_OP_ENCRYPT;
+    cmsg->cmsg_level = SOL_ALG;
+    cmsg->cmsg_type = ALG_SET_OP;
+    cmsg->cmsg_len = CMSG_LEN(sizeof(value));
+    memcpy(CMSG_DATA(cmsg), &value, sizeof(value));
+
+    cmsg = CMSG_NXTHDR(&msg, cmsg);
+    value = (uint32_t)ivSize;
+    cmsg->cmsg_level = SOL_ALG;
+    cmsg->cmsg_type = ALG_SET_IV;
+    cmsg->cmsg_len = CMSG_LEN(sizeof(value) + ivSize);
+    memcpy(CMSG_DATA(cmsg), &value, sizeof(value));
+    memcpy(CMSG_DATA(cmsg) + sizeof(value), iv, ivSize);
+
+    int result = EXIT_FAILURE;
+    if (sendmsg(opFd, &msg, 0) != (ssize_t)len) {
+        cominitErrnoPrint("Could not send data to AF_ALG socket");
+    } else if (read(opFd, out, len) != (ssize_t)len) {
+        cominitErrnoPrint("Could not read data from AF_ALG socket");
+    } else {
+        result = EXIT_SUCCESS;
+    }
+
+    return result;
+}
+
+/**
+ * Encrypt a number of Bytes in #COMINIT_KCAPI_BENCH_CHUNK sized requests with plain64 style IVs.
+ *
+ * @param opFd      The AF_ALG operation socket.
+ * @param iv        Buffer for the IV.
+ * @param ivSize    The IV size in Bytes.
+ * @param buffer    Buffer of two chunks, the plaintext followed by the ciphertext.
+ * @param size      The number of Bytes to encrypt.
+ * @param sector    Pointer to the sector number of the next request, incremented per request.
+ *
+ * @return  EXIT_SUCCESS on success, EXIT_FAILURE otherwise
+ */
+static int cominitKcapiEncryptSectors(int opFd, uint8_t *iv, size_t ivSize, uint8_t *buffer, size_t size,
+                                      uint64_t *sector) {
+    int result = EXIT_SUCCESS;
+
+    for (size_t done = 0; done < size && result == EXIT_SUCCESS; done += COMINIT_KCAPI_BENCH_CHUNK) {
+        /* plain64 style IV: little endian sector number */
+        memcpy(iv, sector, (ivSize < sizeof(*sector)) ? ivSize : sizeof(*sector));
+        result = cominitKcapiEncrypt(opFd, iv, ivSize, buffer, buffer + COMINIT_KCAPI_BENCH_CHUNK,
+                                     COMINIT_KCAPI_BENCH_CHUNK);
+        (*sector)++;
+    }
+
+    return result;
+}
+
+int cominitKcapiBenchmarkSkcipher(const char *algName, size_t keySize, size_t ivSize, uint64_t *nsPerRun) {
+    int result = EXIT_FAILURE;
+    uint8_t key[64] = {0};
+    uint8_t iv[COMINIT_KCAPI_IV_MAX] = {0};
+
+    if (algName == NULL || nsPerRun == NULL || keySize == 0 || keySize > sizeof(key) || ivSize > sizeof(iv)) {
+        cominitErrPrint("Invalid parameters");
+    } else {
+        /* A non-secret but non-degenerate key: XTS rejects identical key halves in FIPS mode. */
+        for (size_t i = 0; i < keySize; i++) {
+            key[i] = (uint8_t)i;
+        }
+
+        int tfmFd = cominitKcapiBind("skcipher", algName);
+        if (tfmFd >= 0) {
+            int opFd = -1;
+            uint8_t *buffer = NULL;
+
+            if (setsockopt(tfmFd, SOL_ALG, ALG_SET_KEY, key, keySize) != 0) {
+                cominitErrnoPrint("Could not set key for \'%s\'", algName);
+            } else if ((opFd = accept(tfmFd, NULL, 0)) < 0) {
+                cominitErrnoPrint("Could not create AF_ALG operation socket for \'%s\'", algName);
+            } else if ((buffer = calloc(2, COMINIT_KCAPI_BENCH_CHUNK)) == NULL) {
+                cominitErrnoPrint("calloc failed");
+            } else {
+                struct timespec start;
+                struct timespec end;
+                uint64_t sector = 0;
+
+                result = cominitKcapiEncryptSectors(opFd, iv, ivSize, buffer, COMINIT_KCAPI_BENCH_WARMUP_SIZE, &sector);
+                clock_gettime(CLOCK_MONOTONIC, &start);
+                if (result == EXIT_SUCCESS) {
+                    result = cominitKcapiEncryptSectors(opFd, iv, ivSize, buffer, COMINIT_KCAPI_BENCH_SIZE, &sector);
+                }
+                clock_gettime(CLOCK_MONOTONIC, &end);
+
+                *nsPerRun = (uint64_t)(end.tv_sec - start.tv_sec) * 1000000000ULL + (uint64_t)end.tv_nsec -
+                            (uint64_t)start.tv_nsec;
+            }
+
+            free(buffer);
+            if (opFd >= 0) {
+                close(opFd);
+            }
+            close(tfmFd);
+        }
+    }
+
+    return result;
+}
+
+int cominitKcapiProbe(const char *type, const char *algName) {
+    int result = EXIT_FAILURE;
+
+    if (type == NULL || algName == NULL || strlen(type) >= COMINIT_KCAPI_TYPE_MAX ||
+        strlen(algName) >= COMINIT_KCAPI_NAME_MAX) {
+        cominitErrPrint("Invalid parameters");
+    } else {
+        const cominitKcapiProbeEntry_t *entry = NULL;
+        for (size_t i = 0; i < cominitKcapiProbeCacheCount && entry == NULL; i++) {
+            if (strcmp(cominitKcapiProbeCache[i].type, type) == 0 &&
+                strcmp(cominitKcapiProbeCache[i].name, algName) == 0) {
+                entry = &cominitKcapiProbeCache[i];
+            }
+        }
+
+        bool available;
+        if (entry != NULL) {
+            available = entry->available;
+        } else {
+            int tfmFd = cominitKcapiBind(type, algName);
+            if (tfmFd >= 0) {
+                close(tfmFd);
+                available = true;
+            } else {
+                available = cominitKcapiFindInProcCrypto(algName);
+            }
+
+            if (cominitKcapiProbeCacheCount < COMINIT_KCAPI_PROBE_CACHE_SIZE) {
+                cominitKcapiProbeEntry_t *newEntry = &cominitKcapiProbeCache[cominitKcapiProbeCacheCount++];
+                strcpy(newEntry->type, type);
+                strcpy(newEntry->name, algName);
+                newEntry->available = available;
+            }
+            cominitDebugPrint("Kernel %s %s \'%s\'", available ? "provides" : "does not provide", type, algName);
+        }
+
+        if (available) {
+            result = EXIT_SUCCESS;
+        }
+    }
+
+    return result;
+}
+
+int cominitKcapiProbeDmCipher(const char *dmCipher) {
+    int result = EXIT_FAILURE;
+    char spec[COMINIT_KCAPI_NAME_MAX];
+
+    if (dmCipher == NULL || strlen(dmCipher) >= sizeof(spec)) {
+        cominitErrPrint("Invalid parameters");
+    } else {
+        char algName[COMINIT_KCAPI_NAME_MAX] = {0};
+        int written = -1;
+
+        strcpy(spec, dmCipher);
+        if (strncmp(spec, "capi:", strlen("capi:")) == 0) {
+            /* capi:cipher_api_spec-ivmode[:ivopts], the API name is everything up to the last dash */
+            char *ivMode = strrchr(spec, '-');
+            if (ivMode != NULL) {
+                *ivMode = '\0';
+            }
+            written = snprintf(algName, sizeof(algName), "%s", spec + strlen("capi:"));
+        } else {
+            /* cipher[:keycount]-chainmode-ivmode[:ivopts] */
+            char *cipher = spec;
+            char *chainMode = strchr(cipher, '-');
+            char *ivMode = NULL;
+            if (chainMode != NULL) {
+                *chainMode++ = '\0';
+                ivMode = strchr(chainMode, '-');
+                if (ivMode != NULL) {
+                    *ivMode++ = '\0';
+                }
+            }
+            cipher[strcspn(cipher, ":")] = '\0';
+            /* Same defaults as dm-crypt for legacy specifications like "aes" or "aes-plain" */
+            if (chainMode == NULL || (strcmp(chainMode, "plain") == 0 && ivMode == NULL)) {
+                chainMode = "cbc";
+            }
+            written = snprintf(algName, sizeof(algName), "%s(%s)", chainMode, cipher);
+        }
+
+        if (written <= 0 || (size_t)written >= sizeof(algName)) {
+            cominitErrPrint("Could not parse dm-crypt cipher \'%s\'", dmCipher);
+        } else {
+            result = cominitKcapiProbe("skcipher", algName);
+        }
+    }
+
+    return result;
+}
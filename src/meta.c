@@ -6,16 +6,17 @@
 #include "meta.h"
 
 #include <errno.h>
-#include <fcntl.h>
+#include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
 #include <sys/mount.h>
-#include <unistd.h>
 
+#include "blockdev.h"
 #include "common.h"
 #include "crypto.h"
 #include "keyring.h"
 #include "output.h"
+#include "securearena.h"
 
 #define COMINIT_ROOTFS_FEATURE_NONE "none"  ///< Human-readable string indicating no use of device mapper features.
 #define COMINIT_ROOTFS_FEATURE_VERITY "dm-verity"        ///< Human-readable string indicating use of dm-verity.
@@ -60,12 +61,24 @@ static inline int cominitGenVerityDmTbl(cominitRfsMetaData_t *meta, char *dmMeta
  */
 static inline int cominitGenIntegrityDmTbl(cominitRfsMetaData_t *meta, char *dmMetaStr);
 /**
- * Read an exact amount of Bytes from a file descriptor at an offset.
+ * Record a Kernel crypto algorithm the device mapper tables of the rootfs depend on.
+ *
+ * The recorded algorithms are probed by cominitSetupDmDevice() before any table is loaded.
+ *
+ * @param meta      The metadata structure to add the algorithm to.
+ * @param type      The algorithm type as used by AF_ALG, e.g. "hash".
+ * @param name      The algorithm name, does not need to be null-terminated.
+ * @param nameLen   The length of \a name.
+ *
+ * @return  0 on success, -1 otherwise
+ */
+static int cominitMetaAddDmAlg(cominitRfsMetaData_t *meta, const char *type, const char *name, size_t nameLen);
+/**
+ * Read an exact amount of Bytes from a partition at an offset.
  *
  * @param buf     The buffer to write the data to, must be at least \a len large.
- * @param fd      The open file descriptor to read from.
- * @param offset  The offset in Bytes in \a fd where to start reading. Only positive values (or 0) are allowed and
- *                \a fd must support seeking if it is >0.
+ * @param fd      The file descriptor returned by cominitBlockdevOpen().
+ * @param offset  The offset in Bytes in \a fd where to start reading. Only positive values (or 0) are allowed.
  * @param len     The amount of Bytes to read.
  *
  * @return  0 on success, -1 otherwise
@@ -76,15 +89,15 @@ int cominitLoadVerifyMetadata(cominitRfsMetaData_t *meta, const char *keyfile) {
     uint8_t metabuf[COMINIT_PART_META_DATA_SIZE] = {0};
     uint64_t partSize = 0;
 
-    int partFd = open(meta->devicePath, O_RDONLY);
+    int partFd = cominitBlockdevOpen(meta->devicePath);
     if (partFd == -1) {
         cominitErrnoPrint("Could not open \'%s\' for reading.", meta->devicePath);
         return -1;
     }
 
-    if (cominitCommonGetPartSize(&partSize, partFd) == -1) {
+    if (cominitBlockdevGetSize(partFd, &partSize) != EXIT_SUCCESS) {
         cominitErrPrint("Could not determine size of partition \'%s\'.", meta->devicePath);
-        close(partFd);
+        cominitBlockdevClose(partFd);
         return -1;
     }
 
@@ -92,10 +105,10 @@ int cominitLoadVerifyMetadata(cominitRfsMetaData_t *meta, const char *keyfile) {
     if (cominitBinReadall(metabuf, partFd, metadataOffset, sizeof(metabuf)) == -1) {
         cominitErrPrint("Could not read %zu Bytes from offset %ld in \'%s\'.", sizeof(metabuf), metadataOffset,
                         meta->devicePath);
-        close(partFd);
+        cominitBlockdevClose(partFd);
         return -1;
     }
-    close(partFd);
+    cominitBlockdevClose(partFd);
 
     size_t metaLen = strnlen((const char *)metabuf, sizeof(metabuf));
     if (metaLen >= sizeof(metabuf) - COMINIT_PART_META_SIG_LENGTH - 1) {
@@ -110,6 +123,10 @@ int cominitLoadVerifyMetadata(cominitRfsMetaData_t *meta, const char *keyfile) {
         return -1;
     }
 
+    /* Keep the verified metadata for measurement, parsing modifies the buffer. */
+    memcpy(meta->metadata, metabuf, metaLen + 1);
+    meta->metadataLen = metaLen + 1;
+
     if (cominitParseMetadata(meta, (char *)metabuf) == -1) {
         cominitErrPrint("Parsing of partition metadata failed.");
         return -1;
@@ -126,16 +143,21 @@ static int cominitBinReadall(uint8_t *buf, int fd, off_t offset, size_t len) {
         cominitErrPrint("Offset must not be negative.");
         return -1;
     }
-    if (lseek(fd, offset, SEEK_SET) == -1) {
-        cominitErrnoPrint("Could not seek to position %ld in given file descriptor.", offset);
-        return -1;
-    }
     while (len > 0) {
-        ssize_t bytesRead = read(fd, buf, len);
+        ssize_t bytesRead = cominitBlockdevPread(fd, buf, len, offset);
+        if (bytesRead < 0 && errno == EINTR) {
+            continue;
+        }
         if (bytesRead < 0) {
             cominitErrnoPrint("Could not read from given file descriptor.");
             return -1;
         }
+        if (bytesRead == 0) {
+            cominitErrPrint("Unexpected end of partition at position %ld.", offset);
+            return -1;
+        }
+        buf += bytesRead;
+        offset += bytesRead;
         len -= bytesRead;
     }
     return 0;
@@ -241,6 +263,8 @@ static inline int cominitParseMetadata(cominitRfsMetaData_t *meta, char *metaStr
     // Default case (plain) means two empty strings as device mapper tables.
     meta->dmTableVerint[0] = '\0';
     meta->dmTableCrypt[0] = '\0';
+    meta->dmAlgCount = 0;
+    meta->dmVerityRootHash[0] = '\0';
 
     if (meta->crypt == COMINIT_CRYPTOPT_VERITY && cominitGenVerityDmTbl(meta, dmTblVerintStr) == -1) {
         cominitErrPrint("Could not generate device mapper table for dm-verity rootfs.");
@@ -329,6 +353,22 @@ static inline int cominitGenVerityDmTbl(cominitRfsMetaData_t *meta, char *dmMeta
         return -1;
     }
     cominitInfoPrint("dm-verity hash algorithm: %s", runner);
+    if (cominitMetaAddDmAlg(meta, "hash", runner, strlen(runner)) == -1) {
+        return -1;
+    }
+
+    // root hash
+    runner = strtok_r(NULL, " ", &strtokState);
+    if (runner == NULL) {
+        cominitErrPrint("Unexpected end of metadata string.");
+        return -1;
+    }
+    size_t rootHashLen = strlen(runner);
+    if (rootHashLen >= sizeof(meta->dmVerityRootHash)) {
+        cominitErrPrint("dm-verity root hash too long.");
+        return -1;
+    }
+    memcpy(meta->dmVerityRootHash, runner, rootHashLen + 1);
 
     return 0;
 }
@@ -383,6 +423,7 @@ static inline int cominitGenIntegrityDmTbl(cominitRfsMetaData_t *meta, char *dmM
     *procOpt = '\0';
 
     const char *keyOpts[] = {"internal_hash:", "journal_crypt:", "journal_mac:"};
+    const char *keyOptAlgTypes[] = {"hash", "skcipher", "hash"};
     while (opt != NULL) {
         int n = sizeof(procAddOpts) - (procOpt - procAddOpts);
         int ret;
@@ -390,19 +431,28 @@ static inline int cominitGenIntegrityDmTbl(cominitRfsMetaData_t *meta, char *dmM
         for (size_t i = 0; i < sizeof(keyOpts) / sizeof(*keyOpts); i++) {
             if (strncmp(opt, keyOpts[i], strlen(keyOpts[i])) == 0) {
                 optionalKey = true;
-                char hashTmp[32] = {'\0'};
-                char *hashPtr = opt + strlen(keyOpts[0]);
+                char hashTmp[COMINIT_DM_ALG_NAME_MAX] = {'\0'};
+                char *hashPtr = opt + strlen(keyOpts[i]);
                 size_t copyLen = strcspn(hashPtr, ":");
                 strncpy(hashTmp, hashPtr, (copyLen < sizeof(hashTmp)) ? copyLen : sizeof(hashTmp) - 1);
                 hashTmp[sizeof(hashTmp) - 1] = '\0';
                 cominitInfoPrint("Dm-integrity algorithm for %s %s", keyOpts[i], hashTmp);
+                if (cominitMetaAddDmAlg(meta, keyOptAlgTypes[i], hashPtr, copyLen) == -1) {
+                    return -1;
+                }
                 break;
             }
         }
         char *keyDesc = (optionalKey) ? strstr(opt, "::") : NULL;
         if (keyDesc != NULL && strlen(keyDesc) > 2) {
-            uint8_t keyBytes[COMINIT_KEYRING_PAYLOAD_MAX_SIZE];
-            char keyHex[2 * COMINIT_KEYRING_PAYLOAD_MAX_SIZE + 1];
+            /* The raw key and its hexadecimal form share one buffer from the secure arena. */
+            size_t keyBufSize = 3 * COMINIT_KEYRING_PAYLOAD_MAX_SIZE + 1;
+            uint8_t *keyBytes = cominitSecureArenaAlloc(keyBufSize);
+            if (keyBytes == NULL) {
+                cominitErrPrint("Could not allocate key buffer.");
+                return -1;
+            }
+            char *keyHex = (char *)keyBytes + COMINIT_KEYRING_PAYLOAD_MAX_SIZE;
             keyDesc[1] = '\0';
             keyDesc += 2;
 
@@ -410,13 +460,16 @@ static inline int cominitGenIntegrityDmTbl(cominitRfsMetaData_t *meta, char *dmM
             ssize_t keyLen = cominitKeyringGetKey(keyBytes, COMINIT_KEYRING_PAYLOAD_MAX_SIZE, keyDesc);
             if (keyLen < 1) {
                 cominitErrPrint("Could not get key payload for key \'%s\'.", keyDesc);
+                cominitSecureArenaFree(keyBytes, keyBufSize);
                 return -1;
             }
             if (cominitBytesToHex(keyHex, keyBytes, keyLen) == -1) {
                 cominitErrPrint("Could not convert key payload to hexadecimal format.");
+                cominitSecureArenaFree(keyBytes, keyBufSize);
                 return -1;
             }
             ret = snprintf(procOpt, n, "%s%s ", opt, keyHex);
+            cominitSecureArenaFree(keyBytes, keyBufSize);
         } else {
             ret = snprintf(procOpt, n, "%s ", opt);
         }
@@ -447,6 +500,26 @@ static inline int cominitGenIntegrityDmTbl(cominitRfsMetaData_t *meta, char *dmM
     return 0;
 }
 
+static int cominitMetaAddDmAlg(cominitRfsMetaData_t *meta, const char *type, const char *name, size_t nameLen) {
+    if (meta->dmAlgCount >= COMINIT_DM_ALGS_MAX) {
+        cominitErrPrint("Too many crypto algorithms in device mapper table.");
+        return -1;
+    }
+    if (nameLen == 0 || nameLen >= COMINIT_DM_ALG_NAME_MAX) {
+        cominitErrPrint("Invalid length of crypto algorithm name in device mapper table.");
+        return -1;
+    }
+
+    cominitDmAlg_t *alg = &meta->dmAlgs[meta->dmAlgCount];
+    strncpy(alg->type, type, sizeof(alg->type) - 1);
+    alg->type[sizeof(alg->type) - 1] = '\0';
+    memcpy(alg->name, name, nameLen);
+    alg->name[nameLen] = '\0';
+    meta->dmAlgCount++;
+
+    return 0;
+}
+
 int cominitBytesToHex(char *dest, const uint8_t *src, size_t n) {
     if (dest == NULL || src == NULL) {
         cominitErrPrint("Input parameters must not be NULL.");
@@ -16,6 +16,7 @@
 
 #include "common.h"
 #include "dmctl.h"
+#include "helper.h"
 #include "output.h"
 
 #define __USE_XOPEN_EXTENDED 1  // needed so glibc has nftw(), actually not needed for musl
@@ -150,11 +151,20 @@ static int cominitNftwRemove(const char *fpath, const struct stat *sb, int tflag
     return 0;
 }
 
-int cominitSwitchIntoRootfs(void) {
+int cominitSetupRunDir(bool mountTmpfs) {
+    cominitFailIf(mountTmpfs && mount("tmpfs", "/newroot/run", "tmpfs", MS_NOSUID | MS_NODEV, "mode=0755") == -1);
+    cominitFailIf(mkdir("/newroot" COMINIT_HELPER_RUN_DIR, 0755) == -1 && errno != EEXIST);
+    return 0;
+}
+
+void cominitFreeInitramfs(void) {
     cominitInfoPrint("Freeing up initramfs...");
     if (nftw("/", cominitNftwRemove, 32, FTW_DEPTH | FTW_PHYS | FTW_MOUNT) == -1) {
         cominitInfoPrint("Warning: Some parts of initramfs could not be deleted.");
     }
+}
+
+int cominitSwitchIntoRootfs(void) {
     cominitInfoPrint("Switching root to /newroot...");
     if (chdir("/newroot") == -1) {
         cominitErrnoPrint("Could not cd to /newroot.");
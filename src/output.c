@@ -6,13 +6,23 @@
 #include "output.h"
 
 #include <errno.h>
+#include <fcntl.h>
 #include <stdarg.h>
 #include <stdbool.h>
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
+#include <unistd.h>
 
 #define DEFAULT_LOG_LEVEL COMINIT_LOG_LEVEL_INFO
+#define DEFAULT_CONSOLE_LOG_LEVEL COMINIT_LOG_LEVEL_ERR
+
+/** Maximum size of a log record, including the kernel priority and the newline. Longer records are truncated. **/
+#define COMINIT_LOG_RECORD_MAX 512
+/** Space reserved in front of a record for the /dev/kmsg priority, e.g. "<3>". **/
+#define COMINIT_LOG_KMSG_PRIO_LEN 3
+/** Highest log level kept in the in-memory log, independent of the visible log level. **/
+#define COMINIT_LOG_RING_LEVEL COMINIT_LOG_LEVEL_DEBUG
 
 /**
  * Structure that holds a log level entry.
@@ -20,6 +30,7 @@
 typedef struct cominitLogLevelEntry {
     const char *name;    ///< The name of the log level.
     const char *prefix;  ///< The prefix printed in a message of this log level.
+    char kmsgPrio;       ///< The kernel log level of a message of this log level, as character.
 } cominitLogLevelEntry_t;
 
 /**
@@ -28,19 +39,151 @@ typedef struct cominitLogLevelEntry {
 typedef struct cominitLogContext {
     cominitLogLevelEntry_t logLevelEntry[COMINIT_LOG_LEVEL_COUNT];  ///< The available log levels.
     cominitLogLevelE_t visibleLevel;                                ///< The current visible log level
+    cominitLogLevelE_t consoleLevel;  ///< Messages up to this level are also written to stderr if /dev/kmsg is used.
+    int kmsgFd;                       ///< The file descriptor of /dev/kmsg, -1 while messages go to stderr only.
 } cominitLogContext_t;
 
 static cominitLogContext_t cominitLogContext = {
     .logLevelEntry =
         {
-            [COMINIT_LOG_LEVEL_NONE] = {.name = "NONE", .prefix = NULL},
-            [COMINIT_LOG_LEVEL_ERR] = {.name = "ERROR", .prefix = "ERROR: "},
-            [COMINIT_LOG_LEVEL_WARN] = {.name = "WARNING", .prefix = "WARNING: "},
-            [COMINIT_LOG_LEVEL_INFO] = {.name = "INFO", .prefix = NULL},
-            [COMINIT_LOG_LEVEL_DEBUG] = {.name = "DEBUG", .prefix = "DEBUG: "},
-            [COMINIT_LOG_LEVEL_SENSITIVE] = {.name = "SENSITIVE", .prefix = "SENSITIVE: "},
+            [COMINIT_LOG_LEVEL_NONE] = {.name = "NONE", .prefix = NULL, .kmsgPrio = '7'},
+            [COMINIT_LOG_LEVEL_ERR] = {.name = "ERROR", .prefix = "ERROR: ", .kmsgPrio = '3'},
+            [COMINIT_LOG_LEVEL_WARN] = {.name = "WARNING", .prefix = "WARNING: ", .kmsgPrio = '4'},
+            [COMINIT_LOG_LEVEL_INFO] = {.name = "INFO", .prefix = NULL, .kmsgPrio = '6'},
+            [COMINIT_LOG_LEVEL_DEBUG] = {.name = "DEBUG", .prefix = "DEBUG: ", .kmsgPrio = '7'},
+            [COMINIT_LOG_LEVEL_SENSITIVE] = {.name = "SENSITIVE", .prefix = "SENSITIVE: ", .kmsgPrio = '7'},
         },
-    .visibleLevel = DEFAULT_LOG_LEVEL};
+    .visibleLevel = DEFAULT_LOG_LEVEL,
+    .consoleLevel = DEFAULT_CONSOLE_LOG_LEVEL,
+    .kmsgFd = -1};
+
+/**
+ * In-memory log of the current boot. Kept outside of cominitLogContext so it ends up in .bss and does not grow the
+ * binary. Only cominit's main thread logs to it, the helper process works on its own copy after fork().
+ */
+static struct {
+    char buf[COMINIT_OUTPUT_LOG_RING_SIZE];  ///< The records, oldest first starting at head once wrapped.
+    size_t head;                             ///< Offset the next record is written to.
+    bool wrapped;                            ///< Flag if older records have been overwritten.
+} cominitLogRing;
+
+/**
+ * Appends a record to the in-memory log, overwriting the oldest records if it is full.
+ *
+ * @param rec   The record including its newline.
+ * @param len   The length of the record, at most #COMINIT_LOG_RECORD_MAX.
+ */
+static void cominitOutputRingAppend(const char *rec, size_t len) {
+    size_t first = sizeof(cominitLogRing.buf) - cominitLogRing.head;
+    if (first > len) {
+        first = len;
+    }
+
+    memcpy(cominitLogRing.buf + cominitLogRing.head, rec, first);
+    memcpy(cominitLogRing.buf, rec + first, len - first);
+    if (cominitLogRing.head + len >= sizeof(cominitLogRing.buf)) {
+        cominitLogRing.wrapped = true;
+    }
+    cominitLogRing.head = (cominitLogRing.head + len) % sizeof(cominitLogRing.buf);
+}
+
+/**
+ * Writes a complete record to a file descriptor.
+ *
+ * @param fd    The file descriptor.
+ * @param buf   The record.
+ * @param len   The length of the record.
+ * @return  0 on success, -1 otherwise
+ */
+static int cominitOutputWriteRecord(int fd, const char *buf, size_t len) {
+    while (len > 0) {
+        ssize_t n = write(fd, buf, len);
+        if (n < 0 && errno == EINTR) {
+            continue;
+        }
+        if (n <= 0) {
+            return -1;
+        }
+        buf += n;
+        len -= (size_t)n;
+    }
+    return 0;
+}
+
+int cominitOutputOpenKmsg(const char *path) {
+    int result = EXIT_FAILURE;
+
+    if (path == NULL) {
+        cominitErrPrint("Invalid parameters");
+    } else {
+        int fd = open(path, O_WRONLY | O_NOCTTY | O_CLOEXEC);
+        if (fd < 0) {
+            cominitErrnoPrint("Could not open \'%s\', logging to console only.", path);
+        } else {
+            if (cominitLogContext.kmsgFd >= 0) {
+                close(cominitLogContext.kmsgFd);
+            }
+            cominitLogContext.kmsgFd = fd;
+            result = EXIT_SUCCESS;
+        }
+    }
+
+    return result;
+}
+
+int cominitOutputFlushLog(const char *path) {
+    int result = EXIT_FAILURE;
+
+    if (path == NULL) {
+        cominitErrPrint("Invalid parameters");
+    } else {
+        int fd = open(path, O_WRONLY | O_CREAT | O_TRUNC | O_NOFOLLOW | O_CLOEXEC, 0640);
+        if (fd < 0) {
+            cominitErrnoPrint("Could not open \'%s\'.", path);
+        } else {
+            /* Once wrapped, the log continues behind head with the oldest record, which may be cut off. */
+            const char *older = cominitLogRing.buf + cominitLogRing.head;
+            size_t olderLen = (cominitLogRing.wrapped) ? sizeof(cominitLogRing.buf) - cominitLogRing.head : 0;
+            const char *newer = cominitLogRing.buf;
+            size_t newerLen = cominitLogRing.head;
+            if (olderLen > 0) {
+                const char *end = memchr(older, '\n', olderLen);
+                if (end != NULL) {
+                    olderLen -= (size_t)(end + 1 - older);
+                    older = end + 1;
+                } else {
+                    end = memchr(newer, '\n', newerLen);
+                    olderLen = 0;
+                    if (end != NULL) {
+                        newerLen -= (size_t)(end + 1 - newer);
+                        newer = end + 1;
+                    }
+                }
+            }
+
+            if (cominitOutputWriteRecord(fd, older, olderLen) == -1 ||
+                cominitOutputWriteRecord(fd, newer, newerLen) == -1) {
+                cominitErrnoPrint("Could not write log to \'%s\'.", path);
+            } else {
+                result = EXIT_SUCCESS;
+            }
+            if (close(fd) == -1 && result == EXIT_SUCCESS) {
+                cominitErrnoPrint("Could not close \'%s\'.", path);
+                result = EXIT_FAILURE;
+            }
+        }
+    }
+
+    return result;
+}
+
+void cominitOutputSetConsoleLogLevel(cominitLogLevelE_t cominitLogLevel) {
+    if (cominitLogLevel == COMINIT_LOG_LEVEL_INVALID) {
+        cominitLogContext.consoleLevel = DEFAULT_CONSOLE_LOG_LEVEL;
+    } else {
+        cominitLogContext.consoleLevel = cominitLogLevel;
+    }
+}
 
 void cominitOutputSetVisibleLogLevel(cominitLogLevelE_t cominitLogLevel) {
     if (cominitLogLevel == COMINIT_LOG_LEVEL_INVALID) {
@@ -71,58 +214,96 @@ int cominitOutputParseLogLevel(cominitLogLevelE_t *logLevel, const char *argValu
 
 int cominitOutputLogFunc(cominitLogLevelE_t logLevel, const char *file, const char *func, int line, bool printErrno,
                          const char *format, ...) {
+    int savedErrno = errno;
     int ret = 0;
 
     if (logLevel <= COMINIT_LOG_LEVEL_NONE || logLevel >= COMINIT_LOG_LEVEL_COUNT) {
         return ret;
     }
 
-    if (logLevel > cominitLogContext.visibleLevel) {
-        return ret;
-    }
-
+    bool visible = (logLevel <= cominitLogContext.visibleLevel);
 #if !defined(COMINIT_ENABLE_SENSITIVE_LOGGING)
     if (logLevel >= COMINIT_LOG_LEVEL_SENSITIVE) {
-        return ret;
+        visible = false;
     }
 #endif
+    if (visible == false && logLevel > COMINIT_LOG_RING_LEVEL) {
+        return ret;
+    }
 
-    int cCount = 0;
+    /* The record is formatted once behind room for the kernel priority, so each sink takes a single write. */
+    char record[COMINIT_LOG_RECORD_MAX];
+    char *text = record + COMINIT_LOG_KMSG_PRIO_LEN;
+    size_t textSize = sizeof(record) - COMINIT_LOG_KMSG_PRIO_LEN;
+    size_t len = 0;
     va_list args;
 
     if (logLevel == COMINIT_LOG_LEVEL_INFO) {
-        ret = fprintf(stderr, COMINIT_PRINT_PREFIX);
-
+        ret = snprintf(text, textSize, COMINIT_PRINT_PREFIX);
+    } else if (func == NULL) {
+        /* Call site given as numeric file ID, see COMINIT_LOG_FILE_ID. */
+        ret = snprintf(text, textSize, COMINIT_PRINT_PREFIX "(#%s:%d) %s", file, line,
+                       cominitLogContext.logLevelEntry[logLevel].prefix);
     } else {
-        ret = fprintf(stderr, COMINIT_PRINT_PREFIX "(%s:%s:%d) %s", file, func, line,
-                      cominitLogContext.logLevelEntry[logLevel].prefix);
+        ret = snprintf(text, textSize, COMINIT_PRINT_PREFIX "(%s:%s:%d) %s", file, func, line,
+                       cominitLogContext.logLevelEntry[logLevel].prefix);
     }
     if (ret < 0) {
         return ret;
     }
-    cCount += ret;
+    len = ((size_t)ret < textSize) ? (size_t)ret : textSize - 1;
 
     va_start(args, format);
-    ret = vfprintf(stderr, format, args);
+    ret = vsnprintf(text + len, textSize - len, format, args);
     va_end(args);
     if (ret < 0) {
         return ret;
     }
-    cCount += ret;
-
-    ret = fprintf(stderr, "\n");
-    if (ret < 0) {
-        return ret;
-    }
-    cCount += ret;
+    len = (len + (size_t)ret < textSize) ? len + (size_t)ret : textSize - 1;
 
     if (printErrno == true) {
-        ret = fprintf(stderr, " Errno: %s\n", strerror(errno));
+        ret = snprintf(text + len, textSize - len, " Errno: %s", strerror(savedErrno));
         if (ret < 0) {
             return ret;
         }
-        cCount += ret;
+        len = (len + (size_t)ret < textSize) ? len + (size_t)ret : textSize - 1;
+    }
+
+    /* A truncated record loses its last character to the newline. */
+    if (len == textSize - 1) {
+        len--;
+    }
+    text[len++] = '\n';
+
+    if (logLevel <= COMINIT_LOG_RING_LEVEL) {
+        cominitOutputRingAppend(text, len);
+    }
+    if (visible == false) {
+        errno = savedErrno;
+        return 0;
+    }
+
+    bool toConsole = true;
+    /* Sensitive messages never go to the kernel log buffer, it outlives cominit and may be readable by users. */
+    if (cominitLogContext.kmsgFd >= 0 && logLevel < COMINIT_LOG_LEVEL_SENSITIVE) {
+        record[0] = '<';
+        record[1] = cominitLogContext.logLevelEntry[logLevel].kmsgPrio;
+        record[2] = '>';
+        /*
+         * With printk.devkmsg=ratelimit the kernel drops records silently, which is why errors also go to stderr by
+         * default. A record the kernel refuses goes to stderr instead.
+         */
+        if (cominitOutputWriteRecord(cominitLogContext.kmsgFd, record, len + COMINIT_LOG_KMSG_PRIO_LEN) == 0) {
+            toConsole = (logLevel <= cominitLogContext.consoleLevel);
+        }
+    }
+
+    if (toConsole == true && cominitOutputWriteRecord(STDERR_FILENO, text, len) == -1) {
+        ret = -1;
+    } else {
+        ret = (int)len;
     }
 
-    return cCount;
+    errno = savedErrno;
+    return ret;
 }
@@ -0,0 +1,178 @@
+// SPDX-License-Identifier: MIT
+/**
+ * @file securearena.c
+ * @brief Implementation of the locked memory arena holding all key material.
+ */
+#include "securearena.h"
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <unistd.h>
+
+#include "output.h"
+
+/**
+ * Alignment of every allocation, enough for any TPM2B structure.
+ */
+#define COMINIT_SECURE_ARENA_ALIGN 16
+
+/**
+ * State of the secure arena.
+ */
+static struct {
+    uint8_t *base;  ///< Start of the usable region, NULL before the arena is set up.
+    size_t size;    ///< Size of the usable region.
+    size_t used;    ///< Offset of the next allocation.
+    size_t live;    ///< Number of allocations not yet freed.
+} cominitSecureArena;
+
+/**
+ * Rounds \a size up to the allocation alignment.
+ *
+ * @param size  The size to round.
+ *
+ * @return  The rounded size.
+ */
+static size_t cominitSecureArenaAlign(size_t size) {
+    return (size + COMINIT_SECURE_ARENA_ALIGN - 1) & ~((size_t)COMINIT_SECURE_ARENA_ALIGN - 1);
+}
+
+/**
+ * Maps and locks the arena with a guard page in front and behind.
+ *
+ * @return  EXIT_SUCCESS on success, EXIT_FAILURE otherwise
+ */
+static int cominitSecureArenaSetup(void) {
+    int result = EXIT_FAILURE;
+    long pageSize = sysconf(_SC_PAGESIZE);
+
+    if (pageSize <= 0) {
+        cominitErrnoPrint("Could not get page size.");
+        return result;
+    }
+
+    size_t page = (size_t)pageSize;
+    size_t size = (COMINIT_SECURE_ARENA_SIZE + page - 1) / page * page;
+    uint8_t *map = mmap(NULL, size + 2 * page, PROT_NONE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    if (map == MAP_FAILED) {
+        cominitErrnoPrint("mmap failed");
+    } else if (mprotect(map + page, size, PROT_READ | PROT_WRITE) != 0) {
+        cominitErrnoPrint("mprotect failed");
+    } else if (mlock(map + page, size) != 0) {
+        cominitErrnoPrint("mlock failed");
+    } else {
+        if (madvise(map + page, size, MADV_DONTDUMP) != 0) {
+            cominitWarnPrint("Secure arena may show up in core dumps.");
+        }
+#ifdef MADV_WIPEONFORK
+        if (madvise(map + page, size, MADV_WIPEONFORK) != 0) {
+            cominitWarnPrint("Secure arena is not wiped in forked processes.");
+        }
+#endif
+        cominitSecureArena.base = map + page;
+        cominitSecureArena.size = size;
+        result = EXIT_SUCCESS;
+    }
+
+    if (result != EXIT_SUCCESS && map != MAP_FAILED) {
+        munmap(map, size + 2 * page);
+    }
+
+    return result;
+}
+
+void *cominitSecureArenaAlloc(size_t size) {
+    void *ptr = NULL;
+
+    if (size == 0) {
+        cominitErrPrint("Invalid parameters");
+    } else if (cominitSecureArena.base == NULL && cominitSecureArenaSetup() != EXIT_SUCCESS) {
+        cominitErrPrint("Could not set up secure arena.");
+    } else if (cominitSecureArenaAlign(size) < size ||
+               cominitSecureArenaAlign(size) > cominitSecureArena.size - cominitSecureArena.used) {
+        cominitErrPrint("Secure arena exhausted.");
+    } else {
+        ptr = cominitSecureArena.base + cominitSecureArena.used;
+        cominitSecureArena.used += cominitSecureArenaAlign(size);
+        cominitSecureArena.live++;
+    }
+
+    return ptr;
+}
+
+int cominitSecureArenaFree(void *ptr, size_t size) {
+    int result = EXIT_FAILURE;
+    uint8_t *p = ptr;
+
+    if (ptr == NULL) {
+        result = EXIT_SUCCESS;
+    } else if (cominitSecureArena.base == NULL || p < cominitSecureArena.base ||
+               p + size > cominitSecureArena.base + cominitSecureArena.used || cominitSecureArena.live == 0) {
+        cominitErrPrint("Invalid parameters");
+    } else {
+        cominitSecureArenaWipe(ptr, size);
+        result = cominitSecureArenaVerifyZero(ptr, size);
+        if (result != EXIT_SUCCESS) {
+            cominitSensitivePrint("Could not verify that key is zero'ed out");
+        }
+
+        /* Space is reused once the newest allocation or all of them are released. */
+        cominitSecureArena.live--;
+        if (cominitSecureArena.live == 0) {
+            cominitSecureArena.used = 0;
+        } else if (p + cominitSecureArenaAlign(size) == cominitSecureArena.base + cominitSecureArena.used) {
+            cominitSecureArena.used = (size_t)(p - cominitSecureArena.base);
+        }
+    }
+
+    return result;
+}
+
+int cominitSecureArenaAfterFork(void) {
+    int result = EXIT_SUCCESS;
+
+    if (cominitSecureArena.base != NULL) {
+        /* Without MADV_WIPEONFORK the child got a copy of the parent's secrets, which it does not own. */
+        cominitSecureArenaWipe(cominitSecureArena.base, cominitSecureArena.size);
+        cominitSecureArena.used = 0;
+        cominitSecureArena.live = 0;
+        if (mlock(cominitSecureArena.base, cominitSecureArena.size) != 0) {
+            cominitErrnoPrint("mlock failed");
+            result = EXIT_FAILURE;
+        }
+    }
+
+    return result;
+}
+
+void cominitSecureArenaWipe(void *buffer, size_t size) {
+    if (buffer != NULL && size > 0) {
+        explicit_bzero(buffer, size);
+    }
+}
+
+int cominitSecureArenaVerifyZero(const void *buffer, size_t size) {
+    int result = EXIT_FAILURE;
+
+    if (buffer == NULL || size == 0) {
+        cominitErrPrint("Invalid parameters");
+    } else {
+        const uint8_t *bytes = buffer;
+        size_t acc = 0;
+        size_t i = 0;
+        for (; i + sizeof(acc) <= size; i += sizeof(acc)) {
+            size_t word;
+            memcpy(&word, bytes + i, sizeof(word));
+            acc |= word;
+        }
+        for (; i < size; i++) {
+            acc |= bytes[i];
+        }
+        result = (acc == 0) ? EXIT_SUCCESS : EXIT_FAILURE;
+    }
+
+    return result;
+}
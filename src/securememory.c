@@ -8,57 +8,8 @@
 #include "crypto.h"
 #include "cryptsetup.h"
 #include "keyring.h"
-
-/**
- * Overwrite a memory region with zeros
- *
- * @param bufferToClear Pointer to the memory to clear
- * @param bufferSize     Number of bytes to check.
- *
- * @return 1 if every byte is 0x00, 0 otherwise.
- */
-static int cominitSecurememoryZeroOut(void *bufferToClear, size_t bufferSize) {
-    int result = EXIT_FAILURE;
-
-    if (bufferToClear == NULL || bufferSize <= 0) {
-        cominitErrPrint("Invalid parameters");
-    } else {
-        volatile uint8_t *buffer = bufferToClear;
-        for (size_t i = 0; i < bufferSize; i++) {
-            buffer[i] = 0;
-        }
-        result = EXIT_SUCCESS;
-    }
-
-    return result;
-}
-
-/**
- * Verify that a buffer is completely zeroed.
- *
- * @param bufferToVerify Pointer to the memory to check
- * @param bufferSize     Number of bytes to check.
- *
- * @return 1 if every byte is 0x00, 0 otherwise.
- */
-static int cominitSecurememoryVerifyZero(const void *bufferToVerify, size_t bufferSize) {
-    int result = EXIT_SUCCESS;
-
-    if (bufferToVerify == NULL || bufferSize == 0) {
-        result = EXIT_FAILURE;
-        cominitErrPrint("Invalid parameters");
-    } else {
-        const uint8_t *buffer = bufferToVerify;
-        for (size_t i = 0; i < bufferSize; i++) {
-            if (buffer[i] != 0) {
-                result = EXIT_FAILURE;
-                break;
-            }
-        }
-    }
-
-    return result;
-}
+#include "securearena.h"
+#include "tpmprofile.h"
 
 cominitTpmState_t cominitSecurememoryEsysUnseal(ESYS_CONTEXT *ectx, ESYS_TR *blobHandle, ESYS_TR *session) {
     TPM2B_SENSITIVE_DATA *keyBuffer = NULL;
@@ -67,7 +18,8 @@ cominitTpmState_t cominitSecurememoryEsysUnseal(ESYS_CONTEXT *ectx, ESYS_TR *blo
     if (ectx == NULL || blobHandle == NULL || session == NULL) {
         cominitErrPrint("Invalid parameters");
     } else {
-        TSS2_RC rc = Esys_Unseal(ectx, *blobHandle, *session, ESYS_TR_NONE, ESYS_TR_NONE, &keyBuffer);
+        TSS2_RC rc = cominitTpmProfileCall(
+            COMINIT_TPM_CMD_UNSEAL, Esys_Unseal(ectx, *blobHandle, *session, ESYS_TR_NONE, ESYS_TR_NONE, &keyBuffer));
         if (rc != TSS2_RC_SUCCESS) {
             if (rc == POLICY_FAILURE_RC) {
                 state = TpmPolicyFailure;
@@ -82,15 +34,13 @@ cominitTpmState_t cominitSecurememoryEsysUnseal(ESYS_CONTEXT *ectx, ESYS_TR *blo
                     0) {
                     state = Unsealed;
                 }
-                if (cominitSecurememoryZeroOut(keyBuffer->buffer, keyBuffer->size) == EXIT_FAILURE) {
-                    cominitSensitivePrint("Could not zero out key");
-                }
+                cominitSecureArenaWipe(keyBuffer->buffer, keyBuffer->size);
             }
         }
     }
 
     if (keyBuffer != NULL) {
-        if (cominitSecurememoryVerifyZero(keyBuffer->buffer, keyBuffer->size) == EXIT_FAILURE) {
+        if (cominitSecureArenaVerifyZero(keyBuffer->buffer, keyBuffer->size) == EXIT_FAILURE) {
             cominitSensitivePrint("Could not verify that key is zero'ed out");
         }
         munlock(keyBuffer, sizeof(TPM2B_SENSITIVE_DATA));
@@ -101,42 +51,67 @@ cominitTpmState_t cominitSecurememoryEsysUnseal(ESYS_CONTEXT *ectx, ESYS_TR *blo
     return state;
 }
 
-int cominitSecurememoryCreateLuksVolume(char *devCrypt) {
+int cominitSecurememoryCreateLuksVolume(char *devCrypt, const char *keyDesc, const cominitCryptsetupCipher_t *cipher) {
     int result = EXIT_FAILURE;
     uint8_t *keyBuffer = NULL;
     size_t keyBufferSize = COMINIT_PASSPHRASE_SIZE;
 
-    if (devCrypt == NULL) {
+    if (devCrypt == NULL || keyDesc == NULL || cipher == NULL) {
         cominitErrPrint("Invalid parameters");
     } else {
-        keyBuffer = calloc(1, keyBufferSize);
+        keyBuffer = cominitSecureArenaAlloc(keyBufferSize);
         if (keyBuffer == NULL) {
-            cominitErrnoPrint("calloc failed");
+            cominitErrPrint("Could not allocate key buffer.");
         } else {
-            if (mlock(keyBuffer, keyBufferSize) != 0) {
-                cominitErrnoPrint("mlock failed");
+            ssize_t keySize = cominitKeyringGetKey(keyBuffer, keyBufferSize, (char *)keyDesc);
+            if (keySize <= 0) {
+                cominitErrPrint("Could not get passphrase from keyring.");
             } else {
-                size_t keySize = cominitKeyringGetKey(keyBuffer, keyBufferSize, COMINIT_TPM_SECURE_STORAGE_KEY_NAME);
-                if (keySize <= 0) {
-                    cominitErrPrint("Could not get passphrase from keyring.");
-                } else {
-                    cominitSensitivePrint("key length is %d", keySize);
-                    result = cominitCryptsetupCreateLuksVolume(devCrypt, keyBuffer, keySize);
-                    if (cominitSecurememoryZeroOut(keyBuffer, keyBufferSize) == EXIT_FAILURE) {
-                        cominitSensitivePrint("Could not zero out key");
-                    }
-                }
+                cominitSensitivePrint("key length is %zd", keySize);
+                result = cominitCryptsetupCreateLuksVolume(devCrypt, cipher, keyBuffer, (size_t)keySize);
             }
+            cominitSecureArenaWipe(keyBuffer, keyBufferSize);
         }
     }
 
-    if (keyBuffer != NULL) {
-        if (cominitSecurememoryVerifyZero(keyBuffer, keyBufferSize) == EXIT_FAILURE) {
-            cominitSensitivePrint("Could not verify that key is zero'ed out");
+    if (keyBuffer != NULL && cominitSecureArenaFree(keyBuffer, keyBufferSize) != EXIT_SUCCESS) {
+        cominitSensitivePrint("Could not release key buffer");
+    }
+
+    return result;
+}
+
+int cominitSecurememoryDeriveKey(const char *rootKeyDesc, const char *context, const char *keyDesc) {
+    int result = EXIT_FAILURE;
+    uint8_t *keyBuffer = NULL;
+    size_t keyBufferSize = 2 * COMINIT_PASSPHRASE_SIZE;
+
+    if (rootKeyDesc == NULL || context == NULL || keyDesc == NULL) {
+        cominitErrPrint("Invalid parameters");
+    } else {
+        keyBuffer = cominitSecureArenaAlloc(keyBufferSize);
+        if (keyBuffer == NULL) {
+            cominitErrPrint("Could not allocate key buffer.");
+        } else {
+            /* The root secret and the derived key share one buffer. */
+            uint8_t *derivedKey = keyBuffer + COMINIT_PASSPHRASE_SIZE;
+            ssize_t rootSize = cominitKeyringGetKey(keyBuffer, COMINIT_PASSPHRASE_SIZE, (char *)rootKeyDesc);
+            if (rootSize <= 0) {
+                cominitErrPrint("Could not get root secret from keyring.");
+            } else if (cominitCryptoHkdfSha256(keyBuffer, (size_t)rootSize, (const uint8_t *)context, strlen(context),
+                                               derivedKey, COMINIT_PASSPHRASE_SIZE) != EXIT_SUCCESS) {
+                cominitErrPrint("Could not derive key %s", keyDesc);
+            } else if (cominitKeyringAddUserKey(keyDesc, derivedKey, COMINIT_PASSPHRASE_SIZE) != 0) {
+                cominitErrPrint("Could not add key %s to keyring", keyDesc);
+            } else {
+                result = EXIT_SUCCESS;
+            }
+            cominitSecureArenaWipe(keyBuffer, keyBufferSize);
         }
-        munlock(keyBuffer, keyBufferSize);
-        free(keyBuffer);
-        keyBuffer = NULL;
+    }
+
+    if (keyBuffer != NULL && cominitSecureArenaFree(keyBuffer, keyBufferSize) != EXIT_SUCCESS) {
+        cominitSensitivePrint("Could not release key buffer");
     }
 
     return result;
@@ -153,77 +128,65 @@ int cominitSecurememoryEsysCreate(ESYS_CONTEXT *ectx, ESYS_TR *primaryHandle, TP
     if (ectx == NULL || primaryHandle == NULL || outPublic == NULL || outPrivate == NULL || policyDigest == NULL) {
         cominitErrPrint("Invalid parameters");
     } else {
-        keyBuffer = calloc(1, sizeof(TPM2B_SENSITIVE_CREATE));
+        keyBuffer = cominitSecureArenaAlloc(sizeof(TPM2B_SENSITIVE_CREATE));
         if (keyBuffer == NULL) {
-            cominitErrnoPrint("calloc failed");
+            cominitErrPrint("Could not allocate key buffer.");
         } else {
-            if (mlock(keyBuffer, sizeof(TPM2B_SENSITIVE_CREATE)) != 0) {
-                cominitErrnoPrint("mlock failed");
+            TPM2B_PUBLIC inPublic = {
+                .size = 0,
+                .publicArea = {
+                    .type = TPM2_ALG_KEYEDHASH,
+                    .nameAlg = TPM2_ALG_SHA256,
+                    .objectAttributes = (TPMA_OBJECT_USERWITHAUTH | TPMA_OBJECT_FIXEDTPM | TPMA_OBJECT_FIXEDPARENT),
+
+                    .authPolicy =
+                        {
+                            .size = 0,
+                        },
+                    .parameters.keyedHashDetail = {.scheme = {.scheme = TPM2_ALG_NULL,
+                                                              .details = {.hmac = {.hashAlg = TPM2_ALG_SHA256}}}},
+                    .unique.keyedHash =
+                        {
+                            .size = 0,
+                            .buffer = {0},
+                        },
+                }};
+            TPM2B_DATA outsideInfo = {
+                .size = 0,
+                .buffer = {0},
+            };
+
+            TPML_PCR_SELECTION creationPCR = {
+                .count = 0,
+            };
+            inPublic.publicArea.authPolicy.size = policyDigest->size;
+            memcpy(inPublic.publicArea.authPolicy.buffer, policyDigest->buffer, policyDigest->size);
+
+            keyBuffer->size = sizeof(keyBuffer->sensitive);
+            keyBuffer->sensitive.userAuth.size = 0;
+            keyBuffer->sensitive.data.size = COMINIT_PASSPHRASE_SIZE;
+
+            result = cominitCryptoCreatePassphrase(keyBuffer->sensitive.data.buffer, keyBuffer->sensitive.data.size);
+            if (result != EXIT_SUCCESS) {
+                cominitErrPrint("Could not generate passphrase.");
             } else {
-                TPM2B_PUBLIC inPublic = {
-                    .size = 0,
-                    .publicArea = {
-                        .type = TPM2_ALG_KEYEDHASH,
-                        .nameAlg = TPM2_ALG_SHA256,
-                        .objectAttributes = (TPMA_OBJECT_USERWITHAUTH | TPMA_OBJECT_FIXEDTPM | TPMA_OBJECT_FIXEDPARENT),
-
-                        .authPolicy =
-                            {
-                                .size = 0,
-                            },
-                        .parameters.keyedHashDetail = {.scheme = {.scheme = TPM2_ALG_NULL,
-                                                                  .details = {.hmac = {.hashAlg = TPM2_ALG_SHA256}}}},
-                        .unique.keyedHash =
-                            {
-                                .size = 0,
-                                .buffer = {0},
-                            },
-                    }};
-                TPM2B_DATA outsideInfo = {
-                    .size = 0,
-                    .buffer = {0},
-                };
-
-                TPML_PCR_SELECTION creationPCR = {
-                    .count = 0,
-                };
-                inPublic.publicArea.authPolicy.size = policyDigest->size;
-                memcpy(inPublic.publicArea.authPolicy.buffer, policyDigest->buffer, policyDigest->size);
-
-                keyBuffer->size = sizeof(keyBuffer->sensitive);
-                keyBuffer->sensitive.userAuth.size = 0;
-                keyBuffer->sensitive.data.size = COMINIT_PASSPHRASE_SIZE;
-
-                result =
-                    cominitCryptoCreatePassphrase(keyBuffer->sensitive.data.buffer, keyBuffer->sensitive.data.size);
-                if (result != EXIT_SUCCESS) {
-                    cominitErrPrint("Could not generate passphrase.");
+                TSS2_RC rc = cominitTpmProfileCall(
+                    COMINIT_TPM_CMD_CREATE,
+                    Esys_Create(ectx, *primaryHandle, ESYS_TR_PASSWORD, ESYS_TR_NONE, ESYS_TR_NONE, keyBuffer,
+                                &inPublic, &outsideInfo, &creationPCR, outPrivate, outPublic, &creationData,
+                                &creationHash, &creationTicket));
+                if (rc != TSS2_RC_SUCCESS) {
+                    cominitErrPrint("Creation of blob failed");
                 } else {
-                    TSS2_RC rc = Esys_Create(ectx, *primaryHandle, ESYS_TR_PASSWORD, ESYS_TR_NONE, ESYS_TR_NONE,
-                                             keyBuffer, &inPublic, &outsideInfo, &creationPCR, outPrivate, outPublic,
-                                             &creationData, &creationHash, &creationTicket);
-                    if (rc != TSS2_RC_SUCCESS) {
-                        cominitErrPrint("Creation of blob failed");
-                    } else {
-                        result = EXIT_SUCCESS;
-                    }
-                    if (cominitSecurememoryZeroOut(keyBuffer->sensitive.data.buffer, keyBuffer->sensitive.data.size) ==
-                        EXIT_FAILURE) {
-                        cominitSensitivePrint("Could not zero out key");
-                    }
+                    result = EXIT_SUCCESS;
                 }
+                cominitSecureArenaWipe(keyBuffer->sensitive.data.buffer, keyBuffer->sensitive.data.size);
             }
         }
     }
 
-    if (keyBuffer != NULL) {
-        if (cominitSecurememoryVerifyZero(keyBuffer->sensitive.data.buffer, keyBuffer->sensitive.data.size) ==
-            EXIT_FAILURE) {
-            cominitSensitivePrint("Could not verify that key is zero'ed out");
-        }
-        munlock(keyBuffer, sizeof(TPM2B_SENSITIVE_CREATE));
-        free(keyBuffer);
-        keyBuffer = NULL;
+    if (keyBuffer != NULL && cominitSecureArenaFree(keyBuffer, sizeof(TPM2B_SENSITIVE_CREATE)) != EXIT_SUCCESS) {
+        cominitSensitivePrint("Could not release key buffer");
     }
 
     Esys_Free(creationData);
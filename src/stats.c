@@ -0,0 +1,62 @@
+// SPDX-License-Identifier: MIT
+/**
+ * @file stats.c
+ * @brief Implementation of the latency statistics shared by the benchmarks.
+ */
+#include "stats.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+
+/**
+ * Compares two durations for qsort().
+ */
+static int cominitStatsCompare(const void *a, const void *b) {
+    uint64_t x = *(const uint64_t *)a;
+    uint64_t y = *(const uint64_t *)b;
+    return (x > y) - (x < y);
+}
+
+uint64_t cominitStatsNow(void) {
+    struct timespec t;
+    clock_gettime(CLOCK_MONOTONIC, &t);
+    return (uint64_t)t.tv_sec * 1000000000ULL + (uint64_t)t.tv_nsec;
+}
+
+void cominitStatsSort(uint64_t *samples, size_t count) {
+    qsort(samples, count, sizeof(uint64_t), cominitStatsCompare);
+}
+
+uint64_t cominitStatsPercentile(const uint64_t *sorted, size_t count, unsigned int percent) {
+    size_t index = (count * percent) / 100;
+    return sorted[(index < count) ? index : count - 1];
+}
+
+void cominitStatsPrintHeader(const char *title, int nameWidth, const unsigned int *percentiles, size_t columns) {
+    printf("%-*s", nameWidth, title);
+    for (size_t i = 0; i < columns; i++) {
+        char label[8];
+        if (percentiles[i] == 0) {
+            snprintf(label, sizeof(label), "min");
+        } else if (percentiles[i] == 50) {
+            snprintf(label, sizeof(label), "median");
+        } else if (percentiles[i] >= 100) {
+            snprintf(label, sizeof(label), "max");
+        } else {
+            snprintf(label, sizeof(label), "p%u", percentiles[i]);
+        }
+        printf(" %10s", label);
+    }
+    printf("\n");
+}
+
+void cominitStatsPrintRow(const char *name, int nameWidth, uint64_t *samples, size_t count,
+                          const unsigned int *percentiles, size_t columns) {
+    cominitStatsSort(samples, count);
+    printf("%-*s", nameWidth, name);
+    for (size_t i = 0; i < columns; i++) {
+        printf(" %10llu", (unsigned long long)(cominitStatsPercentile(samples, count, percentiles[i]) / 1000));
+    }
+    printf("\n");
+}
@@ -8,91 +8,460 @@
 
 #include <errno.h>
 #include <fcntl.h>
+#include <poll.h>
+#include <signal.h>
+#include <spawn.h>
+#include <stdbool.h>
+#include <stdint.h>
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
+#include <sys/syscall.h>
 #include <sys/wait.h>
-#include <sysexits.h>
+#include <time.h>
 #include <unistd.h>
 
 #include "output.h"
 
-int cominitSubprocessSpawnAndWrite(const char *path, char *const argv[], char *const env[], const void *data,
-                                   size_t dataSize) {
-    int result = EXIT_FAILURE;
-    int pipefd[2] = {0};
+/** Maximum length of a captured output line, longer lines are split. **/
+#define COMINIT_SUBPROCESS_LINE_MAX 256
+/** Upper bound for a poll() round if a child has no pidfd and has to be checked for termination periodically. **/
+#define COMINIT_SUBPROCESS_POLL_INTERVAL_MS 20
 
-    if (path == NULL || argv == NULL || env == NULL || data == NULL || dataSize == 0) {
-        cominitErrPrint("Invalid parameters");
-    } else {
-        if (pipe(pipefd) == 0) {
-            pid_t pid = fork();
-            if (pid < 0) {
-                close(pipefd[0]);
-                close(pipefd[1]);
-                cominitErrnoPrint("fork failed");
+/**
+ * Captured output stream of a child.
+ */
+typedef struct cominitSubprocessStream {
+    int fd;                                  ///< Read end of the pipe, -1 once closed.
+    size_t len;                              ///< Number of bytes in line.
+    char line[COMINIT_SUBPROCESS_LINE_MAX];  ///< Incomplete output line.
+} cominitSubprocessStream_t;
+
+/**
+ * A child started by cominitSubprocessLaunch() and not yet collected by cominitSubprocessWait().
+ */
+typedef struct cominitSubprocessEntry {
+    pid_t pid;                            ///< PID of the child, 0 if the entry is unused.
+    const char *name;                     ///< Program name used as prefix of captured output.
+    int pidFd;                            ///< pidfd of the child, -1 if the Kernel does not support pidfds.
+    cominitSubprocessStream_t stream[2];  ///< Captured stdout and stderr.
+    int inFd;                             ///< Write end of the stdin pipe, -1 if no (more) data is to be written.
+    const uint8_t *inData;                ///< Data not yet written to stdin.
+    size_t inSize;                        ///< Number of bytes left in inData.
+    uint64_t deadline;                    ///< Monotonic time in ms at which the child is terminated.
+    bool terminated;                      ///< Flag if SIGTERM has been sent, deadline is then the SIGKILL time.
+    bool failed;                          ///< Flag if feeding stdin failed or the deadline was missed.
+    bool reaped;                          ///< Flag if the child has terminated and status is valid.
+    int status;                           ///< Wait status of the child.
+} cominitSubprocessEntry_t;
+
+static cominitSubprocessEntry_t cominitSubprocessTable[COMINIT_SUBPROCESS_MAX];
+
+/**
+ * Returns the current monotonic time in milliseconds.
+ */
+static uint64_t cominitSubprocessNowMs(void) {
+    struct timespec ts = {0};
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000 + (uint64_t)ts.tv_nsec / 1000000;
+}
+
+/**
+ * Closes a file descriptor if it is open and marks it as closed.
+ */
+static void cominitSubprocessClose(int *fd) {
+    if (*fd >= 0) {
+        close(*fd);
+        *fd = -1;
+    }
+}
+
+/**
+ * Creates a pipe with both ends close-on-exec, so only the descriptors duplicated onto stdio reach a child.
+ *
+ * @return  0 on success, -1 otherwise
+ */
+static int cominitSubprocessPipe(int fds[2]) {
+    if (pipe(fds) != 0) {
+        return -1;
+    }
+    fcntl(fds[0], F_SETFD, FD_CLOEXEC);
+    fcntl(fds[1], F_SETFD, FD_CLOEXEC);
+    return 0;
+}
+
+/**
+ * Logs the buffered output line of a child stream. stdout is logged as debug, stderr as info message.
+ */
+static void cominitSubprocessFlushLine(const cominitSubprocessEntry_t *entry, cominitSubprocessStream_t *stream) {
+    if (stream->len > 0) {
+        if (stream == &entry->stream[0]) {
+            cominitDebugPrint("%s: %.*s", entry->name, (int)stream->len, stream->line);
+        } else {
+            cominitInfoPrint("%s: %.*s", entry->name, (int)stream->len, stream->line);
+        }
+        stream->len = 0;
+    }
+}
+
+/**
+ * Reads everything currently available from a child stream and logs it line by line.
+ */
+static void cominitSubprocessReadStream(const cominitSubprocessEntry_t *entry, cominitSubprocessStream_t *stream) {
+    char buf[COMINIT_SUBPROCESS_LINE_MAX];
+    ssize_t n = 0;
+
+    while (stream->fd >= 0 && (n = read(stream->fd, buf, sizeof(buf))) != 0) {
+        if (n < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            if (errno != EAGAIN) {
+                cominitSubprocessClose(&stream->fd);
             }
-            if (pid == 0) {
-                close(pipefd[1]);
-                if (dup2(pipefd[0], STDIN_FILENO) < 0) {
-                    _exit(EX_OSERR);
+            return;
+        }
+        for (ssize_t i = 0; i < n; i++) {
+            if (buf[i] == '\n') {
+                cominitSubprocessFlushLine(entry, stream);
+            } else {
+                if (stream->len == sizeof(stream->line)) {
+                    cominitSubprocessFlushLine(entry, stream);
                 }
-                close(pipefd[0]);
+                stream->line[stream->len++] = buf[i];
+            }
+        }
+    }
+
+    /* End of file, the child and all its descendants closed the stream. */
+    cominitSubprocessFlushLine(entry, stream);
+    cominitSubprocessClose(&stream->fd);
+}
 
-                execve(path, argv, env);
-                cominitErrnoPrint("execve failed");
-                _exit(EXIT_FAILURE);
+/**
+ * Writes as much of the pending stdin data to a child as the pipe takes without blocking.
+ */
+static void cominitSubprocessWriteStdin(cominitSubprocessEntry_t *entry) {
+    struct sigaction ignore = {.sa_handler = SIG_IGN};
+    struct sigaction old;
+
+    /* A child exiting early must not kill cominit with SIGPIPE, write() reports EPIPE instead. */
+    sigemptyset(&ignore.sa_mask);
+    sigaction(SIGPIPE, &ignore, &old);
+    while (entry->inSize > 0) {
+        ssize_t n = write(entry->inFd, entry->inData, entry->inSize);
+        if (n < 0) {
+            if (errno == EINTR) {
+                continue;
             }
-            if (pid > 0) {
-                close(pipefd[0]);
-                ssize_t written = write(pipefd[1], data, dataSize);
-                close(pipefd[1]);
-                if (written < 0) {
-                    cominitErrnoPrint("write failed");
-                } else {
-                    cominitSensitivePrint("wrote %d bytes to stdin", written);
-                    int status = -1;
-                    waitpid(pid, &status, 0);
-                    if (WIFEXITED(status) && WEXITSTATUS(status) == 0) {
-                        result = EXIT_SUCCESS;
-                    } else {
-                        cominitErrPrint("child failed or was terminated.");
-                    }
+            if (errno != EAGAIN) {
+                cominitErrnoPrint("write to %s failed", entry->name);
+                entry->failed = true;
+                entry->inSize = 0;
+            }
+            break;
+        }
+        cominitSensitivePrint("wrote %zd bytes to stdin", n);
+        entry->inData += n;
+        entry->inSize -= (size_t)n;
+    }
+    sigaction(SIGPIPE, &old, NULL);
+
+    if (entry->inSize == 0) {
+        entry->inData = NULL;
+        cominitSubprocessClose(&entry->inFd);
+    }
+}
+
+/**
+ * Collects the exit status of a child if it has terminated and drains its remaining output.
+ */
+static void cominitSubprocessReap(cominitSubprocessEntry_t *entry) {
+    pid_t ret = waitpid(entry->pid, &entry->status, WNOHANG);
+
+    if (ret == 0 || (ret < 0 && errno == EINTR)) {
+        return;
+    }
+    if (ret < 0) {
+        cominitErrnoPrint("waitpid for %s failed", entry->name);
+        entry->failed = true;
+    }
+
+    entry->reaped = true;
+    for (size_t i = 0; i < sizeof(entry->stream) / sizeof(entry->stream[0]); i++) {
+        cominitSubprocessReadStream(entry, &entry->stream[i]);
+        cominitSubprocessFlushLine(entry, &entry->stream[i]);
+        cominitSubprocessClose(&entry->stream[i].fd);
+    }
+    cominitSubprocessClose(&entry->inFd);
+    cominitSubprocessClose(&entry->pidFd);
+}
+
+/**
+ * Terminates a child that missed its deadline, first with SIGTERM and after a grace period with SIGKILL.
+ */
+static void cominitSubprocessEnforceDeadline(cominitSubprocessEntry_t *entry, uint64_t now) {
+    if (now < entry->deadline) {
+        return;
+    }
+    if (entry->terminated == false) {
+        cominitErrPrint("%s did not finish in time, terminating it.", entry->name);
+        kill(entry->pid, SIGTERM);
+        entry->terminated = true;
+        entry->failed = true;
+        entry->deadline = now + COMINIT_SUBPROCESS_KILL_GRACE_MS;
+    } else {
+        cominitErrPrint("%s did not terminate, killing it.", entry->name);
+        kill(entry->pid, SIGKILL);
+        entry->deadline = UINT64_MAX;
+    }
+}
+
+/**
+ * Runs one round of the event loop for all running children: waits until output, stdin space, a termination or the
+ * next deadline is due and handles it.
+ */
+static void cominitSubprocessPoll(void) {
+    struct pollfd fds[COMINIT_SUBPROCESS_MAX * 4];
+    cominitSubprocessEntry_t *owner[COMINIT_SUBPROCESS_MAX * 4];
+    nfds_t nfds = 0;
+    uint64_t now = cominitSubprocessNowMs();
+    uint64_t next = UINT64_MAX;
+    bool periodic = false;
+
+    for (size_t i = 0; i < COMINIT_SUBPROCESS_MAX; i++) {
+        cominitSubprocessEntry_t *entry = &cominitSubprocessTable[i];
+        if (entry->pid <= 0 || entry->reaped) {
+            continue;
+        }
+        for (size_t s = 0; s < sizeof(entry->stream) / sizeof(entry->stream[0]); s++) {
+            if (entry->stream[s].fd >= 0) {
+                fds[nfds] = (struct pollfd){.fd = entry->stream[s].fd, .events = POLLIN};
+                owner[nfds++] = entry;
+            }
+        }
+        if (entry->inFd >= 0) {
+            fds[nfds] = (struct pollfd){.fd = entry->inFd, .events = POLLOUT};
+            owner[nfds++] = entry;
+        }
+        if (entry->pidFd >= 0) {
+            fds[nfds] = (struct pollfd){.fd = entry->pidFd, .events = POLLIN};
+            owner[nfds++] = entry;
+        } else {
+            periodic = true;
+        }
+        if (entry->deadline < next) {
+            next = entry->deadline;
+        }
+    }
+
+    int timeout = -1;
+    if (next != UINT64_MAX) {
+        timeout = (next > now) ? (int)((next - now < INT32_MAX) ? next - now : INT32_MAX) : 0;
+    }
+    if (periodic && (timeout < 0 || timeout > COMINIT_SUBPROCESS_POLL_INTERVAL_MS)) {
+        timeout = COMINIT_SUBPROCESS_POLL_INTERVAL_MS;
+    }
+
+    if (poll(fds, nfds, timeout) < 0 && errno != EINTR) {
+        cominitErrnoPrint("poll failed");
+    }
+
+    for (nfds_t i = 0; i < nfds; i++) {
+        cominitSubprocessEntry_t *entry = owner[i];
+        if (fds[i].revents == 0 || entry->reaped) {
+            continue;
+        }
+        if (fds[i].fd == entry->inFd) {
+            cominitSubprocessWriteStdin(entry);
+        } else if (fds[i].fd == entry->pidFd) {
+            cominitSubprocessReap(entry);
+        } else {
+            for (size_t s = 0; s < sizeof(entry->stream) / sizeof(entry->stream[0]); s++) {
+                if (fds[i].fd == entry->stream[s].fd) {
+                    cominitSubprocessReadStream(entry, &entry->stream[s]);
                 }
             }
+        }
+    }
+
+    now = cominitSubprocessNowMs();
+    for (size_t i = 0; i < COMINIT_SUBPROCESS_MAX; i++) {
+        cominitSubprocessEntry_t *entry = &cominitSubprocessTable[i];
+        if (entry->pid <= 0 || entry->reaped) {
+            continue;
+        }
+        if (entry->pidFd < 0) {
+            cominitSubprocessReap(entry);
+        }
+        if (entry->reaped == false) {
+            cominitSubprocessEnforceDeadline(entry, now);
+        }
+    }
+}
+
+/**
+ * Starts a child with posix_spawn(), which uses a vfork-like clone, so no page tables are copied. stdout and stderr
+ * of the child are captured, stdin is fed with \a data or connected to /dev/null.
+ *
+ * @return  The PID of the started process on success, -1 otherwise
+ */
+static pid_t cominitSubprocessLaunch(const char *path, char *const argv[], char *const env[], const void *data,
+                                     size_t dataSize, unsigned int timeoutMs) {
+    cominitSubprocessEntry_t *entry = NULL;
+    int outPipe[2] = {-1, -1};
+    int errPipe[2] = {-1, -1};
+    int inPipe[2] = {-1, -1};
+    posix_spawn_file_actions_t actions;
+    pid_t pid = -1;
+
+    for (size_t i = 0; i < COMINIT_SUBPROCESS_MAX && entry == NULL; i++) {
+        if (cominitSubprocessTable[i].pid == 0) {
+            entry = &cominitSubprocessTable[i];
+        }
+    }
+    if (entry == NULL) {
+        cominitErrPrint("Too many running subprocesses.");
+        return pid;
+    }
+
+    if (cominitSubprocessPipe(outPipe) != 0 || cominitSubprocessPipe(errPipe) != 0 ||
+        (data != NULL && cominitSubprocessPipe(inPipe) != 0)) {
+        cominitErrnoPrint("pipe failed");
+    } else if (posix_spawn_file_actions_init(&actions) != 0) {
+        cominitErrPrint("Could not initialize spawn file actions.");
+    } else {
+        int ret = 0;
+        if (data != NULL) {
+            ret |= posix_spawn_file_actions_adddup2(&actions, inPipe[0], STDIN_FILENO);
         } else {
-            cominitErrnoPrint("pipe failed");
+            ret |= posix_spawn_file_actions_addopen(&actions, STDIN_FILENO, "/dev/null", O_RDONLY, 0);
         }
+        ret |= posix_spawn_file_actions_adddup2(&actions, outPipe[1], STDOUT_FILENO);
+        ret |= posix_spawn_file_actions_adddup2(&actions, errPipe[1], STDERR_FILENO);
+        if (ret != 0) {
+            cominitErrPrint("Could not set up spawn file actions.");
+        } else {
+            ret = posix_spawn(&pid, path, &actions, NULL, argv, env);
+            if (ret != 0) {
+                errno = ret;
+                cominitErrnoPrint("Could not spawn %s", path);
+                pid = -1;
+            }
+        }
+        posix_spawn_file_actions_destroy(&actions);
     }
 
-    return result;
+    cominitSubprocessClose(&outPipe[1]);
+    cominitSubprocessClose(&errPipe[1]);
+    cominitSubprocessClose(&inPipe[0]);
+    if (pid <= 0) {
+        cominitSubprocessClose(&outPipe[0]);
+        cominitSubprocessClose(&errPipe[0]);
+        cominitSubprocessClose(&inPipe[1]);
+        return -1;
+    }
+
+    const char *name = strrchr(path, '/');
+    *entry = (cominitSubprocessEntry_t){
+        .pid = pid,
+        .name = (name != NULL) ? name + 1 : path,
+        .pidFd = -1,
+        .stream = {{.fd = outPipe[0]}, {.fd = errPipe[0]}},
+        .inFd = inPipe[1],
+        .inData = data,
+        .inSize = (data != NULL) ? dataSize : 0,
+        .deadline = (timeoutMs == COMINIT_SUBPROCESS_NO_TIMEOUT) ? UINT64_MAX : cominitSubprocessNowMs() + timeoutMs,
+    };
+#ifdef SYS_pidfd_open
+    entry->pidFd = (int)syscall(SYS_pidfd_open, pid, 0);
+#endif
+    fcntl(entry->stream[0].fd, F_SETFL, O_NONBLOCK);
+    fcntl(entry->stream[1].fd, F_SETFL, O_NONBLOCK);
+    if (entry->inFd >= 0) {
+        fcntl(entry->inFd, F_SETFL, O_NONBLOCK);
+    }
+
+    return pid;
 }
 
-int cominitSubprocessSpawn(const char *path, char *const argv[], char *const env[]) {
+int cominitSubprocessSpawnAndWriteWithTimeout(const char *path, char *const argv[], char *const env[], const void *data,
+                                              size_t dataSize, unsigned int timeoutMs) {
     int result = EXIT_FAILURE;
 
-    if (path == NULL || argv == NULL || env == NULL) {
+    if (path == NULL || argv == NULL || env == NULL || data == NULL || dataSize == 0 || timeoutMs == 0) {
+        cominitErrPrint("Invalid parameters");
+    } else {
+        pid_t pid = cominitSubprocessLaunch(path, argv, env, data, dataSize, timeoutMs);
+        if (pid > 0) {
+            result = cominitSubprocessWait(pid);
+        }
+    }
+
+    return result;
+}
+
+int cominitSubprocessSpawnAndWrite(const char *path, char *const argv[], char *const env[], const void *data,
+                                   size_t dataSize) {
+    return cominitSubprocessSpawnAndWriteWithTimeout(path, argv, env, data, dataSize, COMINIT_SUBPROCESS_TIMEOUT_MS);
+}
+
+pid_t cominitSubprocessStartWithTimeout(const char *path, char *const argv[], char *const env[],
+                                        unsigned int timeoutMs) {
+    pid_t pid = -1;
+
+    if (path == NULL || argv == NULL || env == NULL || timeoutMs == 0) {
         cominitErrPrint("Invalid parameters");
     } else {
-        pid_t pid = fork();
-        if (pid < 0) {
-            cominitErrnoPrint("fork failed");
+        pid = cominitSubprocessLaunch(path, argv, env, NULL, 0, timeoutMs);
+    }
+
+    return pid;
+}
+
+pid_t cominitSubprocessStart(const char *path, char *const argv[], char *const env[]) {
+    return cominitSubprocessStartWithTimeout(path, argv, env, COMINIT_SUBPROCESS_TIMEOUT_MS);
+}
+
+int cominitSubprocessWait(pid_t pid) {
+    int result = EXIT_FAILURE;
+    cominitSubprocessEntry_t *entry = NULL;
+
+    for (size_t i = 0; i < COMINIT_SUBPROCESS_MAX && pid > 0 && entry == NULL; i++) {
+        if (cominitSubprocessTable[i].pid == pid) {
+            entry = &cominitSubprocessTable[i];
         }
-        if (pid == 0) {
-            execve(path, argv, env);
-            cominitErrnoPrint("execve failed");
-            _exit(EXIT_FAILURE);
+    }
+
+    if (entry == NULL) {
+        cominitErrPrint("Invalid parameters");
+    } else {
+        /* Other running children are served as well, so none of them blocks on a full output pipe. */
+        while (entry->reaped == false) {
+            cominitSubprocessPoll();
         }
-        if (pid > 0) {
-            int status = -1;
-            waitpid(pid, &status, 0);
-            if (WIFEXITED(status) && WEXITSTATUS(status) == 0) {
-                result = EXIT_SUCCESS;
-            } else {
-                cominitErrPrint("child failed or was terminated.");
-            }
+        if (entry->failed == false && WIFEXITED(entry->status) && WEXITSTATUS(entry->status) == 0) {
+            result = EXIT_SUCCESS;
+        } else {
+            cominitErrPrint("child failed or was terminated.");
         }
+        *entry = (cominitSubprocessEntry_t){.pid = 0};
     }
 
     return result;
-}
\ No newline at end of file
+}
+
+int cominitSubprocessSpawnWithTimeout(const char *path, char *const argv[], char *const env[], unsigned int timeoutMs) {
+    int result = EXIT_FAILURE;
+
+    pid_t pid = cominitSubprocessStartWithTimeout(path, argv, env, timeoutMs);
+    if (pid > 0) {
+        result = cominitSubprocessWait(pid);
+    }
+
+    return result;
+}
+
+int cominitSubprocessSpawn(const char *path, char *const argv[], char *const env[]) {
+    return cominitSubprocessSpawnWithTimeout(path, argv, env, COMINIT_SUBPROCESS_TIMEOUT_MS);
+}
@@ -16,24 +16,38 @@
 #include <sys/mount.h>
 #include <sys/stat.h>
 #include <sys/wait.h>
+#include <time.h>
 #include <unistd.h>
 
 #include "crypto.h"
 #include "cryptsetup.h"
 #include "dmctl.h"
+#include "fstemplate.h"
 #include "keyring.h"
 #include "meta.h"
 #include "output.h"
 #include "securememory.h"
 #include "subprocess.h"
+#include "tpmprofile.h"
+
+#define COMINIT_TPM_EXT4_MAGIC_OFFSET (1024 + 56)  ///< Offset of s_magic in the ext4 superblock.
+#define COMINIT_TPM_EXT4_MAGIC 0xEF53               ///< Value of s_magic for ext2/3/4, stored little endian.
+
+#define COMINIT_TPM_LUKS_MAGIC "LUKS\xba\xbe"  ///< Magic at the start of a LUKS1 and LUKS2 header.
+#define COMINIT_TPM_LUKS_MAGIC_SIZE 6          ///< Size of the LUKS magic.
+#define COMINIT_TPM_VOLUME_KEY_CONTEXT "cominit-volume:"  ///< Prefix of the partition GUID in the HKDF info.
+#define COMINIT_TPM_VOLUME_CREATE ":create"               ///< Suffix of a volume that may be created later on.
+
+#define COMINIT_TPM_CMDLINE_PATH "/proc/cmdline"  ///< The Kernel command line measured by cominitTpmMeasureBoot().
+#define COMINIT_TPM_CMDLINE_MAX 4096              ///< Maximum size of the Kernel command line.
 
 /**
- * Result codes on checking the current state of the blob partition.
+ * Result codes on checking the current state of the blob storage.
  */
 typedef enum {
-    BlobIsEmpty,   ///< There is no file at #COMINIT_TPM_BLOB_LOCATION.
-    BlobExists,    ///< A file at location #COMINIT_TPM_BLOB_LOCATION can be accessed.
-    BlobNotFound,  ///< An error occurred while accessing the file at location #COMINIT_TPM_BLOB_LOCATION.
+    BlobIsEmpty,   ///< No blob has been saved yet.
+    BlobExists,    ///< A valid blob has been loaded.
+    BlobNotFound,  ///< An error occurred while accessing the blob storage.
 } cominitBlobState_t;
 
 /**
@@ -48,20 +62,114 @@ static int cominitTpmLoadDriver() {
 }
 
 /**
- * Checks whether the TPM driver module is functional.
+ * Algorithms used by cominit that are tested by the incremental self-test.
  *
- * @param tpmCtx   The TPM context.
+ * SHA-256 for PCRs and policies, ECC and RSA for the storage primary key (RSA only for keys of earlier versions),
+ * AES-CFB for the protection of the sealed object and KEYEDHASH for the sealed object itself.
+ */
+static const TPML_ALG cominitTpmSelftestAlgs = {
+    .count = 6,
+    .algorithms = {TPM2_ALG_SHA256, TPM2_ALG_ECC, TPM2_ALG_RSA, TPM2_ALG_AES, TPM2_ALG_CFB, TPM2_ALG_KEYEDHASH},
+};
+
+/**
+ * Runs an incremental self-test of the algorithms in #cominitTpmSelftestAlgs.
+ *
+ * The TPM only tests algorithms that have not been tested yet and may finish the tests in the background.
+ *
+ * @param ectx  The Pointer to the initialized ESYS_CONTEXT handle.
  *
  * @return  EXIT_SUCCESS on success, EXIT_FAILURE otherwise
  */
-static int cominitTpmSelftest(cominitTpmContext_t *tpmCtx) {
+static int cominitTpmIncrementalSelftest(ESYS_CONTEXT *ectx) {
+    int result = EXIT_FAILURE;
+    TPML_ALG *toDoList = NULL;
+
+    TSS2_RC rc = cominitTpmProfileCall(
+        COMINIT_TPM_CMD_INCREMENTAL_SELFTEST,
+        Esys_IncrementalSelfTest(ectx, ESYS_TR_NONE, ESYS_TR_NONE, ESYS_TR_NONE, &cominitTpmSelftestAlgs, &toDoList));
+    if (rc != TSS2_RC_SUCCESS) {
+        cominitWarnPrint("Incremental selftest failed (0x%08x)", rc);
+    } else {
+        cominitDebugPrint("%u algorithms left to test", (toDoList != NULL) ? toDoList->count : 0);
+        result = EXIT_SUCCESS;
+    }
+    Esys_Free(toDoList);
+
+    return result;
+}
+
+/**
+ * Checks the result of the self-tests run so far.
+ *
+ * A TPM in failure mode still answers TPM2_GetTestResult(), so this detects a TPM that cannot be used.
+ *
+ * @param ectx  The Pointer to the initialized ESYS_CONTEXT handle.
+ *
+ * @return  EXIT_SUCCESS if no self-test failed, EXIT_FAILURE otherwise
+ */
+static int cominitTpmCheckTestResult(ESYS_CONTEXT *ectx) {
     int result = EXIT_FAILURE;
-    TSS2_RC rc = Esys_SelfTest(tpmCtx->esysCtx, ESYS_TR_NONE, ESYS_TR_NONE, ESYS_TR_NONE, TPM2_YES);
+    TPM2B_MAX_BUFFER *outData = NULL;
+    TPM2_RC testResult = TPM2_RC_FAILURE;
+
+    TSS2_RC rc = cominitTpmProfileCall(
+        COMINIT_TPM_CMD_GET_TEST_RESULT,
+        Esys_GetTestResult(ectx, ESYS_TR_NONE, ESYS_TR_NONE, ESYS_TR_NONE, &outData, &testResult));
     if (rc != TSS2_RC_SUCCESS) {
-        cominitErrPrint("Selftest failed");
+        cominitErrPrint("Could not get selftest result");
+    } else if (testResult != TPM2_RC_SUCCESS && testResult != TPM2_RC_TESTING && testResult != TPM2_RC_NEEDS_TEST) {
+        cominitErrPrint("TPM selftest failed (0x%08x)", testResult);
     } else {
         result = EXIT_SUCCESS;
     }
+    Esys_Free(outData);
+
+    return result;
+}
+
+/**
+ * Checks whether the TPM driver module is functional.
+ *
+ * Runs an incremental self-test limited to the algorithms used by cominit, which only costs time if they have not been
+ * tested since the last TPM reset. A full self-test of all algorithms is run if requested, or if the TPM rejects the
+ * incremental one. The time spent is logged.
+ *
+ * @param tpmCtx   The TPM context.
+ * @param fullSelftest  Flag to run a full self-test.
+ *
+ * @return  EXIT_SUCCESS on success, EXIT_FAILURE otherwise
+ */
+static int cominitTpmSelftest(cominitTpmContext_t *tpmCtx, bool fullSelftest) {
+    int result = EXIT_FAILURE;
+    struct timespec start;
+    struct timespec end;
+
+    clock_gettime(CLOCK_MONOTONIC, &start);
+
+    if (fullSelftest == false) {
+        result = cominitTpmIncrementalSelftest(tpmCtx->esysCtx);
+    }
+    if (result != EXIT_SUCCESS) {
+        fullSelftest = true;
+        TSS2_RC rc = cominitTpmProfileCall(
+            COMINIT_TPM_CMD_SELFTEST,
+            Esys_SelfTest(tpmCtx->esysCtx, ESYS_TR_NONE, ESYS_TR_NONE, ESYS_TR_NONE, TPM2_YES));
+        if (rc != TSS2_RC_SUCCESS) {
+            cominitErrPrint("Selftest failed");
+        } else {
+            result = EXIT_SUCCESS;
+        }
+    }
+    if (result == EXIT_SUCCESS) {
+        result = cominitTpmCheckTestResult(tpmCtx->esysCtx);
+    }
+
+    clock_gettime(CLOCK_MONOTONIC, &end);
+    uint64_t usecs = (uint64_t)(end.tv_sec - start.tv_sec) * 1000000ULL + (uint64_t)(end.tv_nsec / 1000) -
+                     (uint64_t)(start.tv_nsec / 1000);
+    cominitInfoPrint("TPM %s selftest took %llu.%03llums", fullSelftest ? "full" : "incremental",
+                     (unsigned long long)(usecs / 1000), (unsigned long long)(usecs % 1000));
 
     return result;
 }
@@ -110,12 +218,12 @@ static int cominitMkdir(const char *dirPath, mode_t mode) {
 }
 
 /**
- * Mounts the partition on which the sealed blob is saved to and checks whether the partition is empty.
+ * Mounts the ext4 partition on which the sealed blob is saved to and checks whether the blob file exists.
  *
  * @param argCtx Pointer to the structure that holds the parsed options.
  * @return  BlobIsEmpty=0 or BlobExists=1 on success, BlobNotFound=3 otherwise
  */
-static cominitBlobState_t cominitTpmSetupBlob(cominitCliArgs_t *argCtx) {
+static cominitBlobState_t cominitTpmMountBlob(cominitCliArgs_t *argCtx) {
     cominitBlobState_t state = BlobNotFound;
 
     if (argCtx->devNodeBlob[0] != '\0') {
@@ -150,224 +258,218 @@ static cominitBlobState_t cominitTpmSetupBlob(cominitCliArgs_t *argCtx) {
 }
 
 /**
- * Saves the sealed blob to the given path on the blob partition.
+ * Loads the sealed blob from the configured storage.
  *
- * @param outPublic     The Pointer to the structure that holds the public meta data.
- * @param outPrivate    The Pointer to the structure that holds the private data.
- * @return  EXIT_SUCCESS on success, EXIT_FAILURE otherwise
+ * With #COMINIT_BLOB_STORAGE_EXT4 the blob partition is mounted and stays mounted until cominitTpmUnmountBlob(). The
+ * other storages need a single read and no filesystem.
+ *
+ * @param ectx  The Pointer to the initialized ESYS_CONTEXT handle.
+ * @param argCtx Pointer to the structure that holds the parsed options.
+ * @param blob  Pointer to the structure that receives the blob if it exists.
+ * @return  BlobIsEmpty=0 or BlobExists=1 on success, BlobNotFound=3 otherwise
  */
-static int cominitTpmSaveBlob(TPM2B_PUBLIC *outPublic, TPM2B_PRIVATE *outPrivate) {
-    int result = EXIT_FAILURE;
-    FILE *fp = NULL;
-
-    fp = fopen(COMINIT_TPM_MNT_PT "/" COMINIT_TPM_BLOB_LOCATION, "wb");
-    if (fp) {
-        fwrite(outPublic, 1, sizeof *outPublic, fp);
-        fwrite(outPrivate, 1, sizeof *outPrivate, fp);
-        result = EXIT_SUCCESS;
-    }
+static cominitBlobState_t cominitTpmSetupBlob(ESYS_CONTEXT *ectx, cominitCliArgs_t *argCtx, cominitTpmBlob_t *blob) {
+    cominitBlobState_t state = BlobNotFound;
+    bool empty = false;
 
-    if (fp) {
-        fclose(fp);
+    switch (argCtx->blobStorage) {
+        case COMINIT_BLOB_STORAGE_RAW:
+            if (argCtx->devNodeBlob[0] != '\0' &&
+                cominitTpmBlobRawLoad(blob, argCtx->devNodeBlob, &empty) == EXIT_SUCCESS) {
+                state = empty ? BlobIsEmpty : BlobExists;
+            }
+            break;
+        case COMINIT_BLOB_STORAGE_NV:
+            if (cominitTpmBlobNvLoad(ectx, argCtx->blobNvIndex, blob, &empty) == EXIT_SUCCESS) {
+                state = empty ? BlobIsEmpty : BlobExists;
+            }
+            break;
+        case COMINIT_BLOB_STORAGE_EXT4:
+        default:
+            state = cominitTpmMountBlob(argCtx);
+            if (state == BlobExists &&
+                cominitTpmBlobLoad(blob, COMINIT_TPM_MNT_PT "/" COMINIT_TPM_BLOB_LOCATION) != EXIT_SUCCESS) {
+                cominitErrPrint("Could not retrieve blob.");
+                state = BlobNotFound;
+            }
+            break;
     }
 
-    return result;
+    return state;
 }
 
 /**
- * Makes the primary key persistent on TPM.
+ * Template of the ECC P-256 storage primary key created by cominit.
  *
- * @param ectx The Pointer to the initialized ESYS_CONTEXT handle.
- * @param primaryHandle Pointer to an ESYS_TR holding a transient primary key handle.
- * @return  EXIT_SUCCESS on success, EXIT_FAILURE otherwise
+ * Follows the TCG SRK template. Unlike RSA, the key generation takes milliseconds even on discrete TPMs.
  */
-static int cominitTpmSavePrimaryHandle(ESYS_CONTEXT *ectx, ESYS_TR *primaryHandle) {
-    int result = EXIT_FAILURE;
-    ESYS_TR savedHandle = ESYS_TR_NONE;
-
-    TSS2_RC rc = Esys_EvictControl(ectx, ESYS_TR_RH_OWNER, *primaryHandle, ESYS_TR_PASSWORD, ESYS_TR_NONE, ESYS_TR_NONE,
-                                   TPM2_PERSISTENT_FIRST, &savedHandle);
-
-    if (rc != TSS2_RC_SUCCESS) {
-        cominitErrPrint("could not save handle");
-    } else {
-        result = EXIT_SUCCESS;
-    }
-
-    return result;
-}
+static const TPM2B_PUBLIC cominitTpmSrkTemplateEcc = {
+    .size = 0,
+    .publicArea =
+        {
+            .type = TPM2_ALG_ECC,
+            .nameAlg = TPM2_ALG_SHA256,
+            .objectAttributes = (TPMA_OBJECT_USERWITHAUTH | TPMA_OBJECT_RESTRICTED | TPMA_OBJECT_DECRYPT |
+                                 TPMA_OBJECT_FIXEDTPM | TPMA_OBJECT_FIXEDPARENT | TPMA_OBJECT_SENSITIVEDATAORIGIN),
+            .authPolicy = {.size = 0},
+            .parameters.eccDetail =
+                {
+                    .symmetric = {.algorithm = TPM2_ALG_AES, .keyBits.aes = 128, .mode.aes = TPM2_ALG_CFB},
+                    .scheme = {.scheme = TPM2_ALG_NULL},
+                    .curveID = TPM2_ECC_NIST_P256,
+                    .kdf = {.scheme = TPM2_ALG_NULL},
+                },
+            .unique.ecc = {.x = {.size = 0}, .y = {.size = 0}},
+        },
+};
 
 /**
- * Select the PCR that are used for building a policy.
+ * Template of the RSA-2048 storage primary key created by earlier versions of cominit.
  *
- * @param argCtx Pointer to the structure that holds the parsed options.
- * @param pcrSelection Pointer to a TPML_PCR_SELECTION structure that receives the selected PCR register from the parsed
- * options.
+ * Only used to recognize such a key at the persistent handle, new keys are created from #cominitTpmSrkTemplateEcc.
  */
-static void cominitTpmSelectPcr(cominitCliArgs_t *argCtx, TPML_PCR_SELECTION *pcrSelection) {
-    unsigned long pcrIndex = 0;
+static const TPM2B_PUBLIC cominitTpmSrkTemplateRsa = {
+    .size = 0,
+    .publicArea =
+        {
+            .type = TPM2_ALG_RSA,
+            .nameAlg = TPM2_ALG_SHA256,
+            .objectAttributes = (TPMA_OBJECT_USERWITHAUTH | TPMA_OBJECT_RESTRICTED | TPMA_OBJECT_DECRYPT |
+                                 TPMA_OBJECT_FIXEDTPM | TPMA_OBJECT_FIXEDPARENT | TPMA_OBJECT_SENSITIVEDATAORIGIN),
+            .authPolicy = {.size = 0},
+            .parameters.rsaDetail =
+                {
+                    .symmetric = {.algorithm = TPM2_ALG_AES, .keyBits.aes = 128, .mode.aes = TPM2_ALG_CFB},
+                    .scheme = {.scheme = TPM2_ALG_NULL},
+                    .keyBits = 2048,
+                    .exponent = 0,
+                },
+            .unique.rsa = {.size = 0},
+        },
+};
 
-    for (int i = 0; i < argCtx->pcrSealCount; i++) {
-        pcrIndex = argCtx->pcrSeal[i];
-        pcrSelection->pcrSelections[0].pcrSelect[pcrIndex / 8] |= (1u << (pcrIndex % 8));
+/**
+ * Checks whether the public area of a key was created from the given template.
+ *
+ * The unique field is ignored as it holds the public key itself.
+ *
+ * @param pub   The public area read from the TPM.
+ * @param tmpl  The template.
+ * @return  true if \a pub matches \a tmpl, false otherwise
+ */
+static bool cominitTpmPublicMatches(const TPMT_PUBLIC *pub, const TPMT_PUBLIC *tmpl) {
+    bool matches = (pub->type == tmpl->type && pub->nameAlg == tmpl->nameAlg &&
+                    pub->objectAttributes == tmpl->objectAttributes && pub->authPolicy.size == tmpl->authPolicy.size);
+
+    if (matches && pub->type == TPM2_ALG_ECC) {
+        const TPMS_ECC_PARMS *p = &pub->parameters.eccDetail;
+        const TPMS_ECC_PARMS *t = &tmpl->parameters.eccDetail;
+        matches = (p->symmetric.algorithm == t->symmetric.algorithm &&
+                   p->symmetric.keyBits.aes == t->symmetric.keyBits.aes &&
+                   p->symmetric.mode.aes == t->symmetric.mode.aes && p->scheme.scheme == t->scheme.scheme &&
+                   p->curveID == t->curveID && p->kdf.scheme == t->kdf.scheme);
+    } else if (matches && pub->type == TPM2_ALG_RSA) {
+        const TPMS_RSA_PARMS *p = &pub->parameters.rsaDetail;
+        const TPMS_RSA_PARMS *t = &tmpl->parameters.rsaDetail;
+        matches = (p->symmetric.algorithm == t->symmetric.algorithm &&
+                   p->symmetric.keyBits.aes == t->symmetric.keyBits.aes &&
+                   p->symmetric.mode.aes == t->symmetric.mode.aes && p->scheme.scheme == t->scheme.scheme &&
+                   p->keyBits == t->keyBits && p->exponent == t->exponent);
+    } else {
+        matches = false;
     }
+
+    return matches;
 }
 
 /**
- * Seals a key to a blob and save the used primary key.
+ * Creates the storage primary key and makes it persistent on TPM.
  *
- * @param ectx  The Pointer to the initialized ESYS_CONTEXT handle.
- * @param outPublic Address of a TPM2B_PUBLIC pointer that receives the public meta data.
- * @param outPrivate    Address of a TPM2B_PRIVATE pointer that receives the private data.
- * @param argCtx Pointer to the structure that holds the parsed options.
+ * @param ectx The Pointer to the initialized ESYS_CONTEXT handle.
+ * @param persistentHandle The persistent TPM handle to store the key at.
+ * @param primaryHandle Pointer to an ESYS_TR that receives the persistent primary key handle.
  * @return  EXIT_SUCCESS on success, EXIT_FAILURE otherwise
  */
-static int cominitTpmSeal(ESYS_CONTEXT *ectx, TPM2B_PUBLIC **outPublic, TPM2B_PRIVATE **outPrivate,
-                          cominitCliArgs_t *argCtx) {
+static int cominitTpmCreatePrimary(ESYS_CONTEXT *ectx, TPM2_HANDLE persistentHandle, ESYS_TR *primaryHandle) {
     int result = EXIT_FAILURE;
-    TPM2B_DIGEST *policyDigest = NULL;
-    ESYS_TR sess;
-    ESYS_TR primaryHandle = ESYS_TR_NONE;
+    ESYS_TR transientHandle = ESYS_TR_NONE;
     TPM2B_PUBLIC *outPublicPrimary = NULL;
-
     TPM2B_CREATION_DATA *creationData = NULL;
     TPM2B_DIGEST *creationHash = NULL;
     TPMT_TK_CREATION *creationTicket = NULL;
 
     TPM2B_SENSITIVE_CREATE inSensitivePrimary = {.size = 0};
+    TPM2B_DATA outsideInfo = {.size = 0};
+    TPML_PCR_SELECTION creationPCR = {.count = 0};
 
-    TPM2B_PUBLIC inPublic = {
-        .size = 0,
-        .publicArea =
-            {
-                .type = TPM2_ALG_RSA,
-                .nameAlg = TPM2_ALG_SHA256,
-                .objectAttributes = (TPMA_OBJECT_USERWITHAUTH | TPMA_OBJECT_RESTRICTED | TPMA_OBJECT_DECRYPT |
-                                     TPMA_OBJECT_FIXEDTPM | TPMA_OBJECT_FIXEDPARENT | TPMA_OBJECT_SENSITIVEDATAORIGIN),
-                .authPolicy =
-                    {
-                        .size = 0,
-                    },
-                .parameters.rsaDetail =
-                    {
-                        .symmetric = {.algorithm = TPM2_ALG_AES, .keyBits.aes = 128, .mode.aes = TPM2_ALG_CFB},
-                        .scheme = {.scheme = TPM2_ALG_NULL},
-                        .keyBits = 2048,
-                        .exponent = 0,
-                    },
-                .unique.rsa =
-                    {
-                        .size = 0,
-                        .buffer = {0},
-                    },
-            },
-    };
-
-    TPM2B_DATA outsideInfo = {
-        .size = 0,
-        .buffer = {0},
-    };
-
-    TPML_PCR_SELECTION creationPCR = {
-        .count = 0,
-    };
-
-    TSS2_RC rc = Esys_CreatePrimary(ectx, ESYS_TR_RH_OWNER, ESYS_TR_PASSWORD, ESYS_TR_NONE, ESYS_TR_NONE,
-                                    &inSensitivePrimary, &inPublic, &outsideInfo, &creationPCR, &primaryHandle,
-                                    &outPublicPrimary, &creationData, &creationHash, &creationTicket);
+    cominitInfoPrint("Creating primary key at persistent handle 0x%08x", persistentHandle);
 
+    TSS2_RC rc = cominitTpmProfileCall(
+        COMINIT_TPM_CMD_CREATE_PRIMARY,
+        Esys_CreatePrimary(ectx, ESYS_TR_RH_OWNER, ESYS_TR_PASSWORD, ESYS_TR_NONE, ESYS_TR_NONE, &inSensitivePrimary,
+                           &cominitTpmSrkTemplateEcc, &outsideInfo, &creationPCR, &transientHandle, &outPublicPrimary,
+                           &creationData, &creationHash, &creationTicket));
     if (rc != TSS2_RC_SUCCESS) {
         cominitErrPrint("Create primary failed");
     } else {
-        TPMT_SYM_DEF symmetric = {.algorithm = TPM2_ALG_NULL};
-
-        rc = Esys_StartAuthSession(ectx, ESYS_TR_NONE, ESYS_TR_NONE, ESYS_TR_NONE, ESYS_TR_NONE, ESYS_TR_NONE, NULL,
-                                   TPM2_SE_TRIAL, &symmetric, TPM2_ALG_SHA256, &sess);
-
+        rc = cominitTpmProfileCall(COMINIT_TPM_CMD_EVICT_CONTROL,
+                                   Esys_EvictControl(ectx, ESYS_TR_RH_OWNER, transientHandle, ESYS_TR_PASSWORD,
+                                                     ESYS_TR_NONE, ESYS_TR_NONE, persistentHandle, primaryHandle));
         if (rc != TSS2_RC_SUCCESS) {
-            cominitErrPrint("Start Session failed");
+            cominitErrPrint("could not save handle");
         } else {
-            TPML_PCR_SELECTION psel = {
-                .count = 1, .pcrSelections = {{.hash = TPM2_ALG_SHA256, .sizeofSelect = 3, .pcrSelect = {0, 0, 0}}}};
-            cominitTpmSelectPcr(argCtx, &psel);
-
-            rc = Esys_PolicyPCR(ectx, sess, ESYS_TR_NONE, ESYS_TR_NONE, ESYS_TR_NONE, NULL, &psel);
-
-            if (rc != TSS2_RC_SUCCESS) {
-                cominitErrPrint("Create policy failed");
-            } else {
-                rc = Esys_PolicyGetDigest(ectx, sess, ESYS_TR_NONE, ESYS_TR_NONE, ESYS_TR_NONE, &policyDigest);
-                if (rc != TSS2_RC_SUCCESS) {
-                    cominitErrPrint("Get policy digest failed");
-                } else {
-                    result = cominitSecurememoryEsysCreate(ectx, &primaryHandle, outPublic, outPrivate, policyDigest);
-                    if (rc != EXIT_SUCCESS) {
-                        cominitErrPrint("Creation of blob failed");
-                    } else {
-                        result = cominitTpmSavePrimaryHandle(ectx, &primaryHandle);
-                    }
-                }
-            }
+            result = EXIT_SUCCESS;
         }
+        cominitTpmProfileCall(COMINIT_TPM_CMD_FLUSH_CONTEXT, Esys_FlushContext(ectx, transientHandle));
     }
 
-    Esys_FlushContext(ectx, sess);
-    Esys_FlushContext(ectx, primaryHandle);
     Esys_Free(creationData);
     Esys_Free(creationHash);
     Esys_Free(creationTicket);
-    Esys_Free(policyDigest);
     Esys_Free(outPublicPrimary);
 
     return result;
 }
 
 /**
- * Formats the secure storage partition to ext4 on first boot.
+ * Gets the persistent storage primary key, creating it if the persistent handle is still free.
  *
- * */
-static int cominitTpmFormatSecureStorage() {
-    char *argv[] = {"/sbin/mkfs.ext4", "-F", (char *)COMINIT_TPM_SECURE_STORAGE_LOCATION, NULL};
-    char *env[] = {NULL};
-    return cominitSubprocessSpawn(argv[0], argv, env);
-}
-
-/**
- * Sets up the secure storage with the unsealed key.
+ * A key already present at the handle is only used if it was created from one of the cominit templates, so a key of
+ * another TPM user is never used or overwritten.
  *
- * @param argCtx Pointer to the structure that holds the parsed options.
- * @param isFirstBoot Flag to indicate whether it is the very first boot.
+ * @param ectx The Pointer to the initialized ESYS_CONTEXT handle.
+ * @param persistentHandle The persistent TPM handle of the key.
+ * @param primaryHandle Pointer to an ESYS_TR that receives the persistent primary key handle.
  * @return  EXIT_SUCCESS on success, EXIT_FAILURE otherwise
  */
-static int cominitTpmSetupSecureStorage(cominitCliArgs_t *argCtx, bool isFirstBoot) {
+static int cominitTpmGetPrimary(ESYS_CONTEXT *ectx, TPM2_HANDLE persistentHandle, ESYS_TR *primaryHandle) {
     int result = EXIT_FAILURE;
+    ESYS_TR handle = ESYS_TR_NONE;
 
-    if (isFirstBoot == true) {
-        result = cominitSecurememoryCreateLuksVolume(argCtx->devNodeCrypt);
-        if (result != EXIT_SUCCESS) {
-            cominitErrPrint("Could not create LUKS volume");
+    TSS2_RC rc = cominitTpmProfileCall(
+        COMINIT_TPM_CMD_READ_PUBLIC,
+        Esys_TR_FromTPMPublic(ectx, persistentHandle, ESYS_TR_NONE, ESYS_TR_NONE, ESYS_TR_NONE, &handle));
+    if (rc != TSS2_RC_SUCCESS) {
+        result = cominitTpmCreatePrimary(ectx, persistentHandle, primaryHandle);
+    } else {
+        TPM2B_PUBLIC *outPublic = NULL;
+        rc = cominitTpmProfileCall(
+            COMINIT_TPM_CMD_READ_PUBLIC,
+            Esys_ReadPublic(ectx, handle, ESYS_TR_NONE, ESYS_TR_NONE, ESYS_TR_NONE, &outPublic, NULL, NULL));
+        if (rc != TSS2_RC_SUCCESS) {
+            cominitErrPrint("Could not read public area of persistent handle 0x%08x", persistentHandle);
+        } else if (cominitTpmPublicMatches(&outPublic->publicArea, &cominitTpmSrkTemplateEcc.publicArea) ||
+                   cominitTpmPublicMatches(&outPublic->publicArea, &cominitTpmSrkTemplateRsa.publicArea)) {
+            cominitInfoPrint("Reusing primary key at persistent handle 0x%08x", persistentHandle);
+            *primaryHandle = handle;
+            handle = ESYS_TR_NONE;
+            result = EXIT_SUCCESS;
         } else {
-            result = cominitCryptsetupAddToken(argCtx->devNodeCrypt);
-            if (result != EXIT_SUCCESS) {
-                cominitErrPrint("Could not add LUKS token");
-            } else {
-                result = cominitCryptsetupOpenLuksVolume(argCtx->devNodeCrypt);
-                if (result != EXIT_SUCCESS) {
-                    cominitErrPrint("Could not open LUKS volume");
-                } else {
-                    result = cominitTpmFormatSecureStorage();
-                    if (result != EXIT_SUCCESS) {
-                        cominitErrPrint("formating secure storage failed");
-                    }
-                }
-            }
+            cominitErrPrint("Persistent handle 0x%08x is occupied by a key not created by cominit", persistentHandle);
         }
-    }
-
-    else {
-        result = cominitCryptsetupOpenLuksVolume(argCtx->devNodeCrypt);
-        if (result != EXIT_SUCCESS) {
-            cominitErrPrint("Could not open LUKS volume");
+        Esys_Free(outPublic);
+        if (handle != ESYS_TR_NONE) {
+            Esys_TR_Close(ectx, &handle);
         }
     }
 
@@ -375,198 +477,885 @@ static int cominitTpmSetupSecureStorage(cominitCliArgs_t *argCtx, bool isFirstBo
 }
 
 /**
- * Seals the key into blob and saves it.
+ * Select the PCR that are used for building a policy.
  *
- * @param ectx  The Pointer to the initialized ESYS_CONTEXT handle.
  * @param argCtx Pointer to the structure that holds the parsed options.
- * @return  Sealed=3 on success, TpmFailure=0 otherwise
+ * @param pcrSelection Pointer to a TPML_PCR_SELECTION structure that receives the selected PCR register from the parsed
+ * options.
  */
-static cominitTpmState_t cominitTpmSealBlob(ESYS_CONTEXT *ectx, cominitCliArgs_t *argCtx) {
-    TPM2B_PUBLIC *outPublic = NULL;
-    TPM2B_PRIVATE *outPrivate = NULL;
-    cominitTpmState_t state = TpmFailure;
-    int result = EXIT_FAILURE;
+static void cominitTpmSelectPcr(cominitCliArgs_t *argCtx, TPML_PCR_SELECTION *pcrSelection) {
+    unsigned long pcrIndex = 0;
 
-    result = cominitTpmSeal(ectx, &outPublic, &outPrivate, argCtx);
-    if (result != EXIT_SUCCESS) {
-        cominitErrPrint("Could not seal the data.");
-    } else {
-        result = cominitTpmSaveBlob(outPublic, outPrivate);
-        if (result != EXIT_SUCCESS) {
-            cominitErrPrint("Could not save the sealed blob.");
+    for (int i = 0; i < argCtx->pcrSealCount; i++) {
+        pcrIndex = argCtx->pcrSeal[i];
+        if (pcrIndex < COMINIT_TPM_PCR_MAX) {
+            pcrSelection->pcrSelections[0].pcrSelect[pcrIndex / 8] |= (1u << (pcrIndex % 8));
         }
     }
-
-    if (result == EXIT_SUCCESS) {
-        cominitInfoPrint("Key sealed to blob");
-        state = Sealed;
-    }
-
-    Esys_Free(outPublic);
-    Esys_Free(outPrivate);
-
-    return state;
 }
 
 /**
- * Unmount the blob partition.
+ * Checks whether a PCR is set in the SHA-256 selection built by cominitTpmSelectPcr().
  *
+ * @param pcrSelection The PCR selection.
+ * @param pcrIndex The index of the PCR.
+ * @return  true if selected, false otherwise
  */
-static void cominitTpmUnmountBlob() {
-    umount(COMINIT_TPM_MNT_PT);
+static inline bool cominitTpmPcrSelected(const TPML_PCR_SELECTION *pcrSelection, unsigned long pcrIndex) {
+    return (pcrSelection->pcrSelections[0].pcrSelect[pcrIndex / 8] & (1u << (pcrIndex % 8))) != 0;
 }
 
 /**
- * Loads the primary key for unsealing.
+ * Loads the expected PCR values supplied at provisioning time.
  *
- * @param ectx  The Pointer to the initialized ESYS_CONTEXT handle.
- * @param primaryHandle Pointer to a ESYS_TR structure that receives the primary key handle.
- * @return  EXIT_SUCCESS on success, EXIT_FAILURE otherwise
+ * The optional file #COMINIT_TPM_EXPECTED_PCRS_LOCATION holds one line per PCR with the index and the hex encoded
+ * SHA-256 value, e.g. `10 3d458cfe...`. It allows to seal for a future PCR state. With ext4 blob storage it is read
+ * from the blob partition, otherwise, or if it is not there, from #COMINIT_TPM_EXPECTED_PCRS_INITRAMFS.
+ *
+ * @param argCtx Pointer to the structure that holds the parsed options.
+ * @param pcrValues Array receiving the PCR values, indexed by PCR.
+ * @param known Array of flags that are set for every PCR loaded.
  */
-static int cominitTpmLoadPrimaryHandle(ESYS_CONTEXT *ectx, ESYS_TR *primaryHandle) {
-    int result = EXIT_FAILURE;
-
-    TSS2_RC rc =
-        Esys_TR_FromTPMPublic(ectx, TPM2_PERSISTENT_FIRST, ESYS_TR_NONE, ESYS_TR_NONE, ESYS_TR_NONE, primaryHandle);
+static void cominitTpmLoadExpectedPcrs(const cominitCliArgs_t *argCtx, uint8_t pcrValues[][SHA256_LEN], bool *known) {
+    FILE *fp = NULL;
 
-    if (rc != TSS2_RC_SUCCESS) {
-        cominitErrPrint("Could not open primary handle");
-    } else {
-        result = EXIT_SUCCESS;
+    if (argCtx->blobStorage == COMINIT_BLOB_STORAGE_EXT4) {
+        fp = fopen(COMINIT_TPM_MNT_PT "/" COMINIT_TPM_EXPECTED_PCRS_LOCATION, "r");
+    }
+    if (fp == NULL) {
+        fp = fopen(COMINIT_TPM_EXPECTED_PCRS_INITRAMFS, "r");
     }
 
-    return result;
+    if (fp) {
+        cominitInfoPrint("Sealing for expected PCR values");
+        char line[128];
+        while (fgets(line, sizeof(line), fp) != NULL) {
+            char hex[2 * SHA256_LEN + 1];
+            unsigned long pcrIndex = 0;
+            if (sscanf(line, "%lu %64s", &pcrIndex, hex) != 2 || pcrIndex >= COMINIT_TPM_PCR_MAX ||
+                strlen(hex) != 2 * SHA256_LEN) {
+                cominitWarnPrint("Ignoring invalid line in expected PCR values");
+                continue;
+            }
+            size_t i = 0;
+            for (; i < SHA256_LEN && sscanf(&hex[2 * i], "%2hhx", &pcrValues[pcrIndex][i]) == 1; i++) {
+            }
+            known[pcrIndex] = (i == SHA256_LEN);
+        }
+        fclose(fp);
+    }
 }
 
 /**
- * Loads the sealed blob from a given path on the blob partition.
+ * Reads the values of all selected PCRs that are not known yet from the TPM.
  *
- * @param outPublic The Pointer to the structure that receives the public meta data.
- * @param outPrivate    The Pointer to the structure that receives the private data.
- * @return  EXIT_SUCCESS on success, EXIT_FAILURE otherwise
+ * @param ectx The Pointer to the initialized ESYS_CONTEXT handle.
+ * @param pcrSelection The PCR selection.
+ * @param pcrValues Array receiving the PCR values, indexed by PCR.
+ * @param known Array of flags that are set for every PCR read.
+ * @return  EXIT_SUCCESS if all selected PCRs are known afterwards, EXIT_FAILURE otherwise
  */
-static int cominitTpmLoadBlob(TPM2B_PUBLIC *outPublic, TPM2B_PRIVATE *outPrivate) {
+static int cominitTpmReadPcrs(ESYS_CONTEXT *ectx, const TPML_PCR_SELECTION *pcrSelection,
+                              uint8_t pcrValues[][SHA256_LEN], bool *known) {
     int result = EXIT_FAILURE;
-    FILE *fp = NULL;
-
-    fp = fopen(COMINIT_TPM_MNT_PT "/" COMINIT_TPM_BLOB_LOCATION, "rb");
-    if (fp) {
-        size_t want = sizeof *outPublic;
-        if (fread(outPublic, 1, want, fp) == want) {
-            want = sizeof *outPrivate;
-            if (fread(outPrivate, 1, want, fp) == want) {
-                result = EXIT_SUCCESS;
+    bool progress = true;
+
+    while (result != EXIT_SUCCESS && progress) {
+        TPML_PCR_SELECTION missing = {
+            .count = 1,
+            .pcrSelections = {{.hash = TPM2_ALG_SHA256, .sizeofSelect = COMINIT_TPM_PCR_SELECT_SIZE}}};
+        bool anyMissing = false;
+        for (unsigned long i = 0; i < COMINIT_TPM_PCR_MAX; i++) {
+            if (cominitTpmPcrSelected(pcrSelection, i) && !known[i]) {
+                missing.pcrSelections[0].pcrSelect[i / 8] |= (1u << (i % 8));
+                anyMissing = true;
             }
         }
-    }
 
-    if (fp) {
-        fclose(fp);
+        progress = false;
+        if (!anyMissing) {
+            result = EXIT_SUCCESS;
+        } else {
+            /* The TPM returns at most 8 digests per call, so reading may take several rounds */
+            UINT32 updateCounter = 0;
+            TPML_PCR_SELECTION *readSelection = NULL;
+            TPML_DIGEST *values = NULL;
+            TSS2_RC rc = cominitTpmProfileCall(COMINIT_TPM_CMD_PCR_READ,
+                                               Esys_PCR_Read(ectx, ESYS_TR_NONE, ESYS_TR_NONE, ESYS_TR_NONE, &missing,
+                                                             &updateCounter, &readSelection, &values));
+            if (rc != TSS2_RC_SUCCESS) {
+                cominitErrPrint("Reading PCR values failed");
+            } else if (readSelection->count > 0) {
+                UINT32 n = 0;
+                for (unsigned long i = 0; i < COMINIT_TPM_PCR_MAX && n < values->count; i++) {
+                    if ((readSelection->pcrSelections[0].pcrSelect[i / 8] & (1u << (i % 8))) != 0 &&
+                        values->digests[n].size == SHA256_LEN) {
+                        memcpy(pcrValues[i], values->digests[n++].buffer, SHA256_LEN);
+                        known[i] = true;
+                        progress = true;
+                    }
+                }
+            }
+            Esys_Free(readSelection);
+            Esys_Free(values);
+        }
     }
 
     return result;
 }
 
 /**
- * Unseals the key.
+ * Compares the current PCR values with the values recorded in the blob at sealing time.
+ *
+ * Reads all recorded PCRs in as few TPM2_PCR_Read commands as possible, so a changed platform state is detected
+ * without loading the sealed object and running a policy session. The diverged PCRs are logged.
  *
  * @param ectx  The Pointer to the initialized ESYS_CONTEXT handle.
- * @param primaryHandle Pointer to an ESYS_TR holding a transient primary key handle.
- * @param outPublic The Pointer to the structure that holds the public meta data.
- * @param outPrivate    The Pointer to the structure that holds the private data.
- * @param argCtx Pointer to the structure that holds the parsed options.
- * @return  Unsealed=2 on success, TpmPolicyFailure=1 or TpmFailure=0 otherwise
+ * @param blob  Pointer to the structure that holds the sealed object.
+ * @return  true if at least one PCR diverged, false if all match or the blob does not record PCR values
  */
-static cominitTpmState_t cominitTpmUnseal(ESYS_CONTEXT *ectx, ESYS_TR *primaryHandle, TPM2B_PUBLIC *outPublic,
-                                          TPM2B_PRIVATE *outPrivate, cominitCliArgs_t *argCtx) {
-    ESYS_TR blobHandle = ESYS_TR_NONE;
-    ESYS_TR sess = ESYS_TR_NONE;
-    cominitTpmState_t state = TpmFailure;
+static bool cominitTpmPcrsDiverged(ESYS_CONTEXT *ectx, const cominitTpmBlob_t *blob) {
+    bool diverged = false;
+    uint8_t pcrValues[COMINIT_TPM_PCR_MAX][SHA256_LEN] = {{0}};
+    bool known[COMINIT_TPM_PCR_MAX] = {false};
+    TPML_PCR_SELECTION psel = {
+        .count = 1,
+        .pcrSelections = {{.hash = TPM2_ALG_SHA256, .sizeofSelect = COMINIT_TPM_PCR_SELECT_SIZE, .pcrSelect = {0}}}};
+    bool recorded = false;
+
+    for (unsigned long i = 0; i < COMINIT_TPM_PCR_MAX; i++) {
+        if (blob->pcrSelection.count > 0 && cominitTpmPcrSelected(&blob->pcrSelection, i) &&
+            blob->pcrValues[i].size == SHA256_LEN) {
+            psel.pcrSelections[0].pcrSelect[i / 8] |= (1u << (i % 8));
+            recorded = true;
+        }
+    }
 
-    TSS2_RC rc = Esys_Load(ectx, *primaryHandle, ESYS_TR_PASSWORD, ESYS_TR_NONE, ESYS_TR_NONE, outPrivate, outPublic,
-                           &blobHandle);
+    if (recorded && cominitTpmReadPcrs(ectx, &psel, pcrValues, known) == EXIT_SUCCESS) {
+        char list[COMINIT_TPM_PCR_MAX * 3 + 1] = "";
+        size_t len = 0;
+        for (unsigned long i = 0; i < COMINIT_TPM_PCR_MAX; i++) {
+            if (cominitTpmPcrSelected(&psel, i) && memcmp(pcrValues[i], blob->pcrValues[i].buffer, SHA256_LEN) != 0) {
+                len += snprintf(list + len, sizeof(list) - len, " %lu", i);
+                diverged = true;
+            }
+        }
+        if (diverged) {
+            cominitErrPrint("PCRs diverged from the sealed state:%s", list);
+        }
+    }
 
-    if (rc != TSS2_RC_SUCCESS) {
-        cominitErrPrint("Load of handle failed");
-    } else {
-        TPMT_SYM_DEF symmetric = {.algorithm = TPM2_ALG_NULL};
-        rc = Esys_StartAuthSession(ectx, ESYS_TR_NONE, ESYS_TR_NONE, ESYS_TR_NONE, ESYS_TR_NONE, ESYS_TR_NONE, NULL,
-                                   TPM2_SE_POLICY, &symmetric, TPM2_ALG_SHA256, &sess);
-        if (rc != TSS2_RC_SUCCESS) {
-            cominitErrPrint("Starting session failed");
-        } else {
-            TPML_PCR_SELECTION psel = {
-                .count = 1, .pcrSelections = {{.hash = TPM2_ALG_SHA256, .sizeofSelect = 3, .pcrSelect = {0, 0, 0}}}};
-            cominitTpmSelectPcr(argCtx, &psel);
+    return diverged;
+}
 
-            rc = Esys_PolicyPCR(ectx, sess, ESYS_TR_NONE, ESYS_TR_NONE, ESYS_TR_NONE, NULL, &psel);
+int cominitTpmReadPcrValues(cominitTpmContext_t *tpmCtx, const unsigned long *pcrs, int pcrCount,
+                            uint8_t pcrValues[][TPM2_SHA256_DIGEST_SIZE]) {
+    int result = EXIT_FAILURE;
+    bool known[COMINIT_TPM_PCR_MAX] = {false};
+    TPML_PCR_SELECTION psel = {
+        .count = 1,
+        .pcrSelections = {{.hash = TPM2_ALG_SHA256, .sizeofSelect = COMINIT_TPM_PCR_SELECT_SIZE, .pcrSelect = {0}}}};
 
-            if (rc != TSS2_RC_SUCCESS) {
-                cominitErrPrint("Creating policy failed");
+    if (tpmCtx == NULL || tpmCtx->esysCtx == NULL || pcrs == NULL || pcrCount <= 0 || pcrValues == NULL) {
+        cominitErrPrint("Invalid parameters");
+    } else {
+        result = EXIT_SUCCESS;
+        for (int i = 0; i < pcrCount && result == EXIT_SUCCESS; i++) {
+            if (pcrs[i] >= COMINIT_TPM_PCR_MAX) {
+                cominitErrPrint("PCR index %lu out of range", pcrs[i]);
+                result = EXIT_FAILURE;
             } else {
-                state = cominitSecurememoryEsysUnseal(ectx, &blobHandle, &sess);
+                psel.pcrSelections[0].pcrSelect[pcrs[i] / 8] |= (1u << (pcrs[i] % 8));
             }
         }
+        if (result == EXIT_SUCCESS) {
+            result = cominitTpmReadPcrs(tpmCtx->esysCtx, &psel, pcrValues, known);
+        }
     }
 
-    Esys_FlushContext(ectx, sess);
-    Esys_FlushContext(ectx, blobHandle);
-
-    return state;
+    return result;
 }
 
 /**
- * Loads the primary key and the private data to unseal the key.
+ * Computes the digest of a TPM2_PolicyPCR policy in software.
  *
- * @param ectx  The Pointer to the initialized ESYS_CONTEXT handle.
- * @param argCtx Pointer to the structure that holds the parsed options.
- * @return  Unsealed=2 on success, TpmPolicyFailure=1 or TpmFailure=0 otherwise
+ * Yields the same value as running TPM2_PolicyPCR in a trial session with the given PCR values, i.e.
+ * `SHA256(0...0 || TPM_CC_PolicyPCR || TPML_PCR_SELECTION || SHA256(selected PCR values))`.
+ *
+ * @param pcrSelection The PCR selection.
+ * @param pcrValues The PCR values, indexed by PCR.
+ * @param policyDigest Pointer to the structure that receives the policy digest.
+ * @return  EXIT_SUCCESS on success, EXIT_FAILURE otherwise
  */
-static cominitTpmState_t cominitTpmUnsealBlob(ESYS_CONTEXT *ectx, cominitCliArgs_t *argCtx) {
-    TPM2B_PUBLIC outPublic = {0};
-    TPM2B_PRIVATE outPrivate = {0};
-    ESYS_TR primaryHandle = ESYS_TR_NONE;
+static int cominitTpmComputePolicyDigest(const TPML_PCR_SELECTION *pcrSelection, uint8_t pcrValues[][SHA256_LEN],
+                                         TPM2B_DIGEST *policyDigest) {
     int result = EXIT_FAILURE;
-    cominitTpmState_t tpmState = TpmFailure;
-
-    result = cominitTpmLoadPrimaryHandle(ectx, &primaryHandle);
+    uint8_t composite[COMINIT_TPM_PCR_MAX * SHA256_LEN];
+    size_t compositeLen = 0;
+    /* policyDigestOld || commandCode || count || hash || sizeofSelect || pcrSelect || pcrDigest */
+    uint8_t policy[SHA256_LEN + 4 + 4 + 2 + 1 + COMINIT_TPM_PCR_SELECT_SIZE + SHA256_LEN] = {0};
+    uint8_t *p = policy + SHA256_LEN;
+
+    for (unsigned long i = 0; i < COMINIT_TPM_PCR_MAX; i++) {
+        if (cominitTpmPcrSelected(pcrSelection, i)) {
+            memcpy(composite + compositeLen, pcrValues[i], SHA256_LEN);
+            compositeLen += SHA256_LEN;
+        }
+    }
 
-    if (result != EXIT_SUCCESS) {
-        cominitErrPrint("Could not retrieve handle.");
+    *p++ = (uint8_t)(TPM2_CC_PolicyPCR >> 24);
+    *p++ = (uint8_t)(TPM2_CC_PolicyPCR >> 16);
+    *p++ = (uint8_t)(TPM2_CC_PolicyPCR >> 8);
+    *p++ = (uint8_t)TPM2_CC_PolicyPCR;
+    p += 3;
+    *p++ = 1;
+    *p++ = (uint8_t)(TPM2_ALG_SHA256 >> 8);
+    *p++ = (uint8_t)TPM2_ALG_SHA256;
+    *p++ = COMINIT_TPM_PCR_SELECT_SIZE;
+    memcpy(p, pcrSelection->pcrSelections[0].pcrSelect, COMINIT_TPM_PCR_SELECT_SIZE);
+    p += COMINIT_TPM_PCR_SELECT_SIZE;
+
+    if (cominitCryptoSha256(composite, compositeLen, p, SHA256_LEN) != EXIT_SUCCESS) {
+        cominitErrPrint("Hashing PCR values failed");
+    } else if (cominitCryptoSha256(policy, sizeof(policy), policyDigest->buffer, sizeof(policyDigest->buffer)) !=
+               EXIT_SUCCESS) {
+        cominitErrPrint("Hashing policy failed");
     } else {
-        result = cominitTpmLoadBlob(&outPublic, &outPrivate);
-        if (result != EXIT_SUCCESS) {
-            cominitErrPrint("Could not retrieve blob.");
-        } else {
-            tpmState = cominitTpmUnseal(ectx, &primaryHandle, &outPublic, &outPrivate, argCtx);
-        }
+        policyDigest->size = SHA256_LEN;
+        result = EXIT_SUCCESS;
     }
 
-    return tpmState;
+    return result;
 }
 
-int cominitInitTpm(cominitTpmContext_t *tpmCtx) {
-    const char *tctiConf = "device:/dev/tpm0";
+/**
+ * Formats the secure storage partition to ext4 on first boot.
+ *
+ * If the initramfs contains a filesystem template at #COMINIT_FSTEMPLATE_PATH, it is written with its holes zeroed and
+ * the filesystem is grown to the partition size. Otherwise, or if that fails, mkfs.ext4 is used. Inode tables and the
+ * journal are initialized lazily by the Kernel after the first mount and the freshly created volume is not discarded,
+ * so formatting time does not grow with the partition size.
+ * */
+static int cominitTpmFormatSecureStorage() {
     int result = EXIT_FAILURE;
 
-    if (tpmCtx == NULL) {
+    if (access(COMINIT_FSTEMPLATE_PATH, F_OK) == 0) {
+        result = cominitFsTemplateApply(COMINIT_FSTEMPLATE_PATH, COMINIT_TPM_SECURE_STORAGE_LOCATION);
+        if (result != EXIT_SUCCESS) {
+            cominitWarnPrint("Could not create secure storage from template, falling back to mkfs.ext4");
+        }
+    }
+
+    if (result != EXIT_SUCCESS) {
+        char *argv[] = {"/sbin/mkfs.ext4", "-F", "-E", "lazy_itable_init=1,lazy_journal_init=1,nodiscard",
+                        (char *)COMINIT_TPM_SECURE_STORAGE_LOCATION, NULL};
+        char *env[] = {NULL};
+        result = cominitSubprocessSpawnWithTimeout(argv[0], argv, env, COMINIT_SUBPROCESS_FORMAT_TIMEOUT_MS);
+    }
+
+    return result;
+}
+
+/**
+ * Reads whether the opened secure storage volume already contains an ext4 filesystem.
+ *
+ * @param hasFs  Pointer to a flag that is set if an ext4 superblock was found.
+ *
+ * @return  EXIT_SUCCESS if the superblock could be read, EXIT_FAILURE otherwise
+ */
+static int cominitTpmSecureStorageHasFs(bool *hasFs) {
+    int result = EXIT_FAILURE;
+    uint8_t magic[2] = {0};
+
+    int fd = open(COMINIT_TPM_SECURE_STORAGE_LOCATION, O_RDONLY | O_CLOEXEC);
+    if (fd < 0) {
+        cominitErrnoPrint("Could not open '%s'", COMINIT_TPM_SECURE_STORAGE_LOCATION);
+    } else {
+        if (pread(fd, magic, sizeof(magic), COMINIT_TPM_EXT4_MAGIC_OFFSET) == (ssize_t)sizeof(magic)) {
+            *hasFs = (magic[0] == (COMINIT_TPM_EXT4_MAGIC & 0xff) && magic[1] == (COMINIT_TPM_EXT4_MAGIC >> 8));
+            result = EXIT_SUCCESS;
+        } else {
+            cominitErrnoPrint("Could not read '%s'", COMINIT_TPM_SECURE_STORAGE_LOCATION);
+        }
+        close(fd);
+    }
+
+    return result;
+}
+
+/**
+ * Reads whether a device contains a LUKS header.
+ *
+ * @param devNode  The device node.
+ * @param isLuks   Pointer to a flag that is set if the LUKS magic was found.
+ *
+ * @return  EXIT_SUCCESS if the start of the device could be read, EXIT_FAILURE otherwise
+ */
+static int cominitTpmReadLuksMagic(const char *devNode, bool *isLuks) {
+    int result = EXIT_FAILURE;
+    char magic[COMINIT_TPM_LUKS_MAGIC_SIZE] = {0};
+
+    int fd = open(devNode, O_RDONLY | O_CLOEXEC);
+    if (fd < 0) {
+        cominitErrnoPrint("Could not open '%s'", devNode);
+    } else {
+        if (pread(fd, magic, sizeof(magic), 0) == (ssize_t)sizeof(magic)) {
+            *isLuks = (memcmp(magic, COMINIT_TPM_LUKS_MAGIC, sizeof(magic)) == 0);
+            result = EXIT_SUCCESS;
+        } else {
+            cominitErrnoPrint("Could not read '%s'", devNode);
+        }
+        close(fd);
+    }
+
+    return result;
+}
+
+/**
+ * Creates a LUKS volume whose passphrase is taken from the keyring by a token.
+ *
+ * The cipher is selected on the first call only, so several volumes created during one boot share one benchmark.
+ *
+ * @param devNode  The device node.
+ * @param keyDesc  The description of the user key holding the passphrase.
+ * @param cipher   Address of the selected cipher, selected if it points to NULL.
+ * @return  EXIT_SUCCESS on success, EXIT_FAILURE otherwise
+ */
+static int cominitTpmCreateLuksVolume(char *devNode, const char *keyDesc, const cominitCryptsetupCipher_t **cipher) {
+    int result = EXIT_SUCCESS;
+
+    if (*cipher == NULL) {
+        result = cominitCryptsetupSelectCipher(COMINIT_CRYPTSETUP_MIN_STRENGTH, cipher);
+    }
+    if (result == EXIT_SUCCESS) {
+        result = cominitSecurememoryCreateLuksVolume(devNode, keyDesc, *cipher);
+    }
+    if (result != EXIT_SUCCESS) {
+        cominitErrPrint("Could not create LUKS volume");
+    } else {
+        result = cominitCryptsetupAddToken(devNode, keyDesc);
+        if (result != EXIT_SUCCESS) {
+            cominitErrPrint("Could not add LUKS token");
+        }
+    }
+
+    return result;
+}
+
+/**
+ * Converts the unique partition GUID of a volume to the ID recorded in the blob.
+ *
+ * @param guid  The GUID in canonical text form, in lower case.
+ * @param id    The buffer receiving the hex digits of \a guid in text order.
+ */
+static void cominitTpmVolumeId(const char *guid, uint8_t id[COMINIT_TPMBLOB_VOLUME_ID_SIZE]) {
+    size_t n = 0;
+
+    for (size_t i = 0; guid[i] != '\0' && n < 2 * COMINIT_TPMBLOB_VOLUME_ID_SIZE; i++) {
+        if (isxdigit((unsigned char)guid[i])) {
+            uint8_t nibble = (uint8_t)(isdigit((unsigned char)guid[i]) ? guid[i] - '0' : guid[i] - 'a' + 10);
+            id[n / 2] = (n % 2 == 0) ? (uint8_t)(nibble << 4) : (uint8_t)(id[n / 2] | nibble);
+            n++;
+        }
+    }
+}
+
+/**
+ * Checks whether the blob records an additional volume as created.
+ *
+ * @param blob  The unsealed blob.
+ * @param id    The ID of the volume.
+ *
+ * @return  true if recorded, false otherwise
+ */
+static bool cominitTpmVolumeCreated(const cominitTpmBlob_t *blob, const uint8_t id[COMINIT_TPMBLOB_VOLUME_ID_SIZE]) {
+    bool created = false;
+
+    for (uint32_t i = 0; created == false && i < blob->volumeCount; i++) {
+        created = (memcmp(blob->volumes[i], id, COMINIT_TPMBLOB_VOLUME_ID_SIZE) == 0);
+    }
+
+    return created;
+}
+
+/**
+ * Derives the key of an additional encrypted volume and creates the volume if allowed.
+ *
+ * The key is derived from the unsealed Secure Storage key with the partition GUID as context, so no additional TPM
+ * command is needed per volume. A volume without a LUKS header is only created on the boot that creates the Secure
+ * Storage or if it is marked with `:create`, and never again once the blob records it as created. A volume found with
+ * a LUKS header is recorded as well, so a header lost later is reported instead of formatted over.
+ *
+ * @param volume  The volume.
+ * @param blob    The unsealed blob, the volume is recorded in it once it has a LUKS header.
+ * @param firstBoot  Flag to indicate that the Secure Storage is created on this boot.
+ * @param cipher  Address of the selected cipher, selected if it points to NULL.
+ * @return  EXIT_SUCCESS on success, EXIT_FAILURE otherwise
+ */
+static int cominitTpmSetupCryptVolume(cominitCryptVolume_t *volume, cominitTpmBlob_t *blob, bool firstBoot,
+                                      const cominitCryptsetupCipher_t **cipher) {
+    int result = EXIT_FAILURE;
+    char keyDesc[sizeof(COMINIT_TPM_SECURE_STORAGE_KEY_NAME) + COMINIT_CRYPT_VOLUME_NAME_MAX];
+    char context[sizeof(COMINIT_TPM_VOLUME_KEY_CONTEXT) + COMINIT_GUID_STR_LEN];
+    uint8_t id[COMINIT_TPMBLOB_VOLUME_ID_SIZE] = {0};
+    bool isLuks = false;
+
+    snprintf(keyDesc, sizeof(keyDesc), "%s-%s", COMINIT_TPM_SECURE_STORAGE_KEY_NAME, volume->name);
+    snprintf(context, sizeof(context), "%s%s", COMINIT_TPM_VOLUME_KEY_CONTEXT, volume->partUuid);
+    cominitTpmVolumeId(volume->partUuid, id);
+    bool created = cominitTpmVolumeCreated(blob, id);
+
+    if (volume->devNode[0] == '\0') {
+        cominitErrPrint("No partition found for volume %s", volume->name);
+    } else if (cominitSecurememoryDeriveKey(COMINIT_TPM_SECURE_STORAGE_KEY_NAME, context, keyDesc) != EXIT_SUCCESS) {
+        cominitErrPrint("Could not derive key of volume %s", volume->name);
+    } else if (cominitTpmReadLuksMagic(volume->devNode, &isLuks) != EXIT_SUCCESS) {
+        cominitErrPrint("Could not check volume %s for a LUKS header", volume->name);
+    } else if (isLuks == true) {
+        result = EXIT_SUCCESS;
+    } else if (created == true) {
+        cominitErrPrint("Volume %s has lost its LUKS header, not creating it again", volume->name);
+    } else if (firstBoot == false && volume->create == false) {
+        cominitErrPrint("Volume %s has no LUKS header, add '%s' to create it", volume->name, COMINIT_TPM_VOLUME_CREATE);
+    } else {
+        cominitInfoPrint("Creating volume %s on %s", volume->name, volume->devNode);
+        result = cominitTpmCreateLuksVolume(volume->devNode, keyDesc, cipher);
+    }
+
+    if (result == EXIT_SUCCESS && created == false) {
+        if (blob->volumeCount < COMINIT_TPMBLOB_VOLUMES_MAX) {
+            memcpy(blob->volumes[blob->volumeCount], id, COMINIT_TPMBLOB_VOLUME_ID_SIZE);
+            blob->volumeCount++;
+        } else {
+            cominitWarnPrint("Cannot record volume %s as created, the sealed blob is full", volume->name);
+        }
+    }
+
+    return result;
+}
+
+/**
+ * Saves the blob to the configured storage.
+ *
+ * @param ectx  The Pointer to the initialized ESYS_CONTEXT handle.
+ * @param argCtx Pointer to the structure that holds the parsed options.
+ * @param blob  The blob to save.
+ * @return  EXIT_SUCCESS on success, EXIT_FAILURE otherwise
+ */
+static int cominitTpmSaveBlob(ESYS_CONTEXT *ectx, cominitCliArgs_t *argCtx, const cominitTpmBlob_t *blob) {
+    int result = EXIT_FAILURE;
+
+    switch (argCtx->blobStorage) {
+        case COMINIT_BLOB_STORAGE_RAW:
+            result = cominitTpmBlobRawSave(blob, argCtx->devNodeBlob);
+            break;
+        case COMINIT_BLOB_STORAGE_NV:
+            result = cominitTpmBlobNvSave(ectx, argCtx->blobNvIndex, blob);
+            break;
+        case COMINIT_BLOB_STORAGE_EXT4:
+        default:
+            result = cominitTpmBlobSave(blob, COMINIT_TPM_MNT_PT "/" COMINIT_TPM_BLOB_LOCATION);
+            break;
+    }
+
+    return result;
+}
+
+/**
+ * Creates the Secure Storage volume if the blob says it has not been created yet.
+ *
+ * A device that already has a LUKS header is never formatted again, even if #COMINIT_TPMBLOB_FLAG_CREATE is still set
+ * because a power loss hit before the flag was cleared. Without the flag a missing header is left to the open to fail.
+ *
+ * @param argCtx Pointer to the structure that holds the parsed options.
+ * @param blob  The unsealed blob.
+ * @param cipher  Address of the selected cipher, selected if it points to NULL.
+ * @return  EXIT_SUCCESS on success, EXIT_FAILURE otherwise
+ */
+static int cominitTpmCreateSecureStorage(cominitCliArgs_t *argCtx, const cominitTpmBlob_t *blob,
+                                         const cominitCryptsetupCipher_t **cipher) {
+    int result = EXIT_SUCCESS;
+
+    if (blob->flags & COMINIT_TPMBLOB_FLAG_CREATE) {
+        bool isLuks = false;
+        result = cominitTpmReadLuksMagic(argCtx->devNodeCrypt, &isLuks);
+        if (result != EXIT_SUCCESS) {
+            cominitErrPrint("Could not check secure storage for a LUKS header");
+        } else if (isLuks == true) {
+            cominitWarnPrint("Secure storage already has a LUKS header, opening it instead of creating it");
+        } else {
+            cominitInfoPrint("Creating secure storage");
+            result = cominitTpmCreateLuksVolume(argCtx->devNodeCrypt, COMINIT_TPM_SECURE_STORAGE_KEY_NAME, cipher);
+        }
+    }
+
+    return result;
+}
+
+/**
+ * Sets up the secure storage and the additional encrypted volumes with the unsealed key.
+ *
+ * All volumes are opened concurrently. An additional volume that cannot be set up or opened is left closed without
+ * affecting the Secure Storage. The Secure Storage is only created and formatted while the flags of the blob say so,
+ * and each flag is cleared and the blob saved again once its step is done. In sync mode the Secure Storage is
+ * formatted as long as #COMINIT_TPMBLOB_FLAG_FORMAT is set and it holds no filesystem yet, e.g. because the boot that
+ * created it was interrupted before formatting.
+ *
+ * @param tpmCtx  Pointer to the structure that holds the acquired TPM context, cominitTpmContext_t::formatPending is
+ *                set if formatting is left to the helper.
+ * @param argCtx Pointer to the structure that holds the parsed options.
+ * @param blob  The unsealed blob, its flags are updated.
+ * @return  EXIT_SUCCESS on success, EXIT_FAILURE otherwise
+ */
+static int cominitTpmSetupSecureStorage(cominitTpmContext_t *tpmCtx, cominitCliArgs_t *argCtx,
+                                        cominitTpmBlob_t *blob) {
+    int result = EXIT_FAILURE;
+    const cominitCryptsetupCipher_t *cipher = NULL;
+    char *devCrypt[1 + COMINIT_CRYPT_VOLUMES_MAX] = {argCtx->devNodeCrypt};
+    char *names[1 + COMINIT_CRYPT_VOLUMES_MAX] = {(char *)COMINIT_TPM_SECURE_STORAGE_NAME};
+    size_t count = 1;
+    uint32_t flags = blob->flags;
+    uint32_t volumeCount = blob->volumeCount;
+    bool firstBoot = (blob->flags & COMINIT_TPMBLOB_FLAG_CREATE) != 0;
+
+    result = cominitTpmCreateSecureStorage(argCtx, blob, &cipher);
+
+    for (int i = 0; result == EXIT_SUCCESS && i < argCtx->cryptVolumeCount; i++) {
+        cominitCryptVolume_t *volume = &argCtx->cryptVolumes[i];
+        if (cominitTpmSetupCryptVolume(volume, blob, firstBoot, &cipher) == EXIT_SUCCESS) {
+            devCrypt[count] = volume->devNode;
+            names[count] = volume->name;
+            count++;
+        }
+    }
+
+    if (result == EXIT_SUCCESS) {
+        int opened[1 + COMINIT_CRYPT_VOLUMES_MAX] = {EXIT_FAILURE};
+        /* An additional volume that cannot be opened stays closed, only the Secure Storage is required. */
+        cominitCryptsetupOpenLuksVolumes(devCrypt, names, opened, count);
+        result = opened[0];
+        if (result != EXIT_SUCCESS) {
+            cominitErrPrint("Could not open LUKS volume");
+        } else {
+            blob->flags &= ~COMINIT_TPMBLOB_FLAG_CREATE;
+        }
+    }
+
+    bool hasFs = false;
+    if (result == EXIT_SUCCESS && (blob->flags & COMINIT_TPMBLOB_FLAG_FORMAT)) {
+        result = cominitTpmSecureStorageHasFs(&hasFs);
+        if (result != EXIT_SUCCESS) {
+            cominitErrPrint("Could not check secure storage for a filesystem");
+        } else if (hasFs == true) {
+            blob->flags &= ~COMINIT_TPMBLOB_FLAG_FORMAT;
+        } else if (argCtx->secureStorageMode != COMINIT_SECURE_STORAGE_MODE_SYNC) {
+            /* The flag stays set until a later boot finds the filesystem the helper creates. */
+            cominitInfoPrint("Formatting of secure storage deferred");
+            tpmCtx->formatPending = true;
+        } else {
+            result = cominitTpmFormatSecureStorage();
+            if (result != EXIT_SUCCESS) {
+                cominitErrPrint("formating secure storage failed");
+            } else {
+                blob->flags &= ~COMINIT_TPMBLOB_FLAG_FORMAT;
+            }
+        }
+    }
+
+    /* Failing to save only repeats the checks above on the next boot, which then find the volume set up. */
+    if ((blob->flags != flags || blob->volumeCount != volumeCount) &&
+        cominitTpmSaveBlob(tpmCtx->esysCtx, argCtx, blob) != EXIT_SUCCESS) {
+        cominitWarnPrint("Could not save the updated flags of the sealed blob");
+    }
+
+    return result;
+}
+
+/**
+ * Seals the key into blob and saves it to the configured storage.
+ *
+ * The blob is saved with #COMINIT_TPMBLOB_FLAG_CREATE and #COMINIT_TPMBLOB_FLAG_FORMAT set, so the volume is created
+ * on the first boot that unseals the key, which is a later one if the key was sealed for expected PCR values.
+ *
+ * @param ectx  The Pointer to the initialized ESYS_CONTEXT handle.
+ * @param argCtx Pointer to the structure that holds the parsed options.
+ * @param blob  Pointer to the structure that receives the sealed blob.
+ * @return  Sealed=3 on success, TpmFailure=0 otherwise
+ */
+static cominitTpmState_t cominitTpmSealBlob(ESYS_CONTEXT *ectx, cominitCliArgs_t *argCtx, cominitTpmBlob_t *blob) {
+    cominitTpmState_t state = TpmFailure;
+    int result = EXIT_FAILURE;
+
+    result = cominitTpmSeal(ectx, blob, argCtx);
+    if (result != EXIT_SUCCESS) {
+        cominitErrPrint("Could not seal the data.");
+    } else {
+        blob->flags = COMINIT_TPMBLOB_FLAG_CREATE | COMINIT_TPMBLOB_FLAG_FORMAT;
+        result = cominitTpmSaveBlob(ectx, argCtx, blob);
+        if (result != EXIT_SUCCESS) {
+            cominitErrPrint("Could not save the sealed blob.");
+        }
+    }
+
+    if (result == EXIT_SUCCESS) {
+        cominitInfoPrint("Key sealed to blob");
+        state = Sealed;
+    }
+
+    return state;
+}
+
+/**
+ * Unmount the blob partition.
+ *
+ */
+static void cominitTpmUnmountBlob() {
+    umount(COMINIT_TPM_MNT_PT);
+}
+
+/**
+ * Loads the primary key for unsealing.
+ *
+ * @param ectx  The Pointer to the initialized ESYS_CONTEXT handle.
+ * @param persistentHandle The persistent TPM handle of the primary key.
+ * @param primaryHandle Pointer to a ESYS_TR structure that receives the primary key handle.
+ * @return  EXIT_SUCCESS on success, EXIT_FAILURE otherwise
+ */
+static int cominitTpmLoadPrimaryHandle(ESYS_CONTEXT *ectx, TPM2_HANDLE persistentHandle, ESYS_TR *primaryHandle) {
+    int result = EXIT_FAILURE;
+
+    TSS2_RC rc = cominitTpmProfileCall(
+        COMINIT_TPM_CMD_READ_PUBLIC,
+        Esys_TR_FromTPMPublic(ectx, persistentHandle, ESYS_TR_NONE, ESYS_TR_NONE, ESYS_TR_NONE, primaryHandle));
+
+    if (rc != TSS2_RC_SUCCESS) {
+        cominitErrPrint("Could not open primary handle");
+    } else {
+        result = EXIT_SUCCESS;
+    }
+
+    return result;
+}
+
+int cominitInitTpm(cominitTpmContext_t *tpmCtx, cominitCliArgs_t *argCtx) {
+    int result = EXIT_FAILURE;
+
+    if (tpmCtx == NULL || argCtx == NULL) {
         cominitErrPrint("Invalid parameters");
     } else {
+        tpmCtx->pcrBanks = 0;
+        const char *tctiConf = (argCtx->tpmTcti[0] != '\0') ? argCtx->tpmTcti : COMINIT_TPM_TCTI;
+        cominitDebugPrint("Using TCTI '%s'", tctiConf);
         result = cominitTpmLoadDriver();
         if (result == EXIT_SUCCESS) {
             result = EXIT_FAILURE;
             TSS2_RC rc = Tss2_TctiLdr_Initialize(tctiConf, &tpmCtx->tctiCtx);
             if (rc != TSS2_RC_SUCCESS) {
                 cominitErrPrint("Initializing TCTI context failed");
+                tpmCtx->tctiCtx = NULL;
+            } else {
+                rc = Esys_Initialize(&tpmCtx->esysCtx, tpmCtx->tctiCtx, NULL);
+                if (rc != TSS2_RC_SUCCESS) {
+                    cominitErrPrint("Initializing ESYS context failed");
+                    /* Either both contexts are set or none, so cominitDeleteTpm() can always clean up. */
+                    Tss2_TctiLdr_Finalize(&tpmCtx->tctiCtx);
+                    tpmCtx->tctiCtx = NULL;
+                    tpmCtx->esysCtx = NULL;
+                } else {
+                    result = cominitTpmSelftest(tpmCtx, argCtx->tpmFullSelftest);
+                }
+            }
+        }
+    }
+
+    return result;
+}
+
+int cominitTpmSeal(ESYS_CONTEXT *ectx, cominitTpmBlob_t *blob, cominitCliArgs_t *argCtx) {
+    int result = EXIT_FAILURE;
+    TPM2B_PUBLIC *outPublic = NULL;
+    TPM2B_PRIVATE *outPrivate = NULL;
+    TPM2B_DIGEST policyDigest = {.size = 0};
+    ESYS_TR primaryHandle = ESYS_TR_NONE;
+    uint8_t pcrValues[COMINIT_TPM_PCR_MAX][SHA256_LEN] = {{0}};
+    bool known[COMINIT_TPM_PCR_MAX] = {false};
+    TPML_PCR_SELECTION psel = {
+        .count = 1,
+        .pcrSelections = {{.hash = TPM2_ALG_SHA256, .sizeofSelect = COMINIT_TPM_PCR_SELECT_SIZE, .pcrSelect = {0}}}};
+
+    if (ectx == NULL || blob == NULL || argCtx == NULL) {
+        cominitErrPrint("Invalid parameters");
+    } else {
+        cominitTpmSelectPcr(argCtx, &psel);
+        cominitTpmLoadExpectedPcrs(argCtx, pcrValues, known);
+
+        if (cominitTpmReadPcrs(ectx, &psel, pcrValues, known) != EXIT_SUCCESS) {
+            cominitErrPrint("Could not get PCR values");
+        } else if (cominitTpmComputePolicyDigest(&psel, pcrValues, &policyDigest) != EXIT_SUCCESS) {
+            cominitErrPrint("Create policy failed");
+        } else if (cominitTpmGetPrimary(ectx, argCtx->tpmPrimaryHandle, &primaryHandle) != EXIT_SUCCESS) {
+            cominitErrPrint("Could not get primary key");
+        } else {
+            result = cominitSecurememoryEsysCreate(ectx, &primaryHandle, &outPublic, &outPrivate, &policyDigest);
+            if (result != EXIT_SUCCESS) {
+                cominitErrPrint("Creation of blob failed");
+            } else {
+                blob->pcrSelection = psel;
+                blob->policyDigest = policyDigest;
+                for (unsigned long i = 0; i < COMINIT_TPM_PCR_MAX; i++) {
+                    blob->pcrValues[i].size = 0;
+                    if (cominitTpmPcrSelected(&psel, i)) {
+                        blob->pcrValues[i].size = SHA256_LEN;
+                        memcpy(blob->pcrValues[i].buffer, pcrValues[i], SHA256_LEN);
+                    }
+                }
+                blob->outPublic = *outPublic;
+                blob->outPrivate = *outPrivate;
+            }
+        }
+    }
+
+    if (primaryHandle != ESYS_TR_NONE) {
+        Esys_TR_Close(ectx, &primaryHandle);
+    }
+    Esys_Free(outPublic);
+    Esys_Free(outPrivate);
+
+    return result;
+}
+
+cominitTpmState_t cominitTpmUnseal(ESYS_CONTEXT *ectx, const cominitTpmBlob_t *blob, cominitCliArgs_t *argCtx) {
+    ESYS_TR primaryHandle = ESYS_TR_NONE;
+    ESYS_TR blobHandle = ESYS_TR_NONE;
+    ESYS_TR sess = ESYS_TR_NONE;
+    cominitTpmState_t state = TpmFailure;
+
+    if (ectx == NULL || blob == NULL || argCtx == NULL) {
+        cominitErrPrint("Invalid parameters");
+    } else if (cominitTpmPcrsDiverged(ectx, blob)) {
+        state = TpmPolicyFailure;
+    } else if (cominitTpmLoadPrimaryHandle(ectx, argCtx->tpmPrimaryHandle, &primaryHandle) != EXIT_SUCCESS) {
+        cominitErrPrint("Could not retrieve handle.");
+    } else {
+        TSS2_RC rc = cominitTpmProfileCall(COMINIT_TPM_CMD_LOAD,
+                                           Esys_Load(ectx, primaryHandle, ESYS_TR_PASSWORD, ESYS_TR_NONE, ESYS_TR_NONE,
+                                                     &blob->outPrivate, &blob->outPublic, &blobHandle));
+
+        if (rc != TSS2_RC_SUCCESS) {
+            cominitErrPrint("Load of handle failed");
+        } else {
+            TPMT_SYM_DEF symmetric = {.algorithm = TPM2_ALG_NULL};
+            rc = cominitTpmProfileCall(COMINIT_TPM_CMD_START_AUTH_SESSION,
+                                       Esys_StartAuthSession(ectx, ESYS_TR_NONE, ESYS_TR_NONE, ESYS_TR_NONE,
+                                                             ESYS_TR_NONE, ESYS_TR_NONE, NULL, TPM2_SE_POLICY,
+                                                             &symmetric, TPM2_ALG_SHA256, &sess));
+            if (rc != TSS2_RC_SUCCESS) {
+                cominitErrPrint("Starting session failed");
             } else {
-                rc = Esys_Initialize(&tpmCtx->esysCtx, tpmCtx->tctiCtx, NULL);
+                TPML_PCR_SELECTION psel = blob->pcrSelection;
+                if (psel.count == 0) {
+                    /* Blobs of earlier versions do not record the PCR selection */
+                    psel = (TPML_PCR_SELECTION){.count = 1,
+                                                .pcrSelections = {{.hash = TPM2_ALG_SHA256,
+                                                                   .sizeofSelect = COMINIT_TPM_PCR_SELECT_SIZE,
+                                                                   .pcrSelect = {0}}}};
+                    cominitTpmSelectPcr(argCtx, &psel);
+                }
+
+                rc = cominitTpmProfileCall(
+                    COMINIT_TPM_CMD_POLICY_PCR,
+                    Esys_PolicyPCR(ectx, sess, ESYS_TR_NONE, ESYS_TR_NONE, ESYS_TR_NONE, NULL, &psel));
+
                 if (rc != TSS2_RC_SUCCESS) {
-                    cominitErrPrint("Initializing ESYS context failed");
+                    cominitErrPrint("Creating policy failed");
                 } else {
-                    result = cominitTpmSelftest(tpmCtx);
+                    state = cominitSecurememoryEsysUnseal(ectx, &blobHandle, &sess);
                 }
             }
         }
+
+        cominitTpmProfileCall(COMINIT_TPM_CMD_FLUSH_CONTEXT, Esys_FlushContext(ectx, sess));
+        cominitTpmProfileCall(COMINIT_TPM_CMD_FLUSH_CONTEXT, Esys_FlushContext(ectx, blobHandle));
+        Esys_TR_Close(ectx, &primaryHandle);
+    }
+
+    return state;
+}
+
+/**
+ * Queries the active PCR banks from the TPM and keeps them in the context.
+ *
+ * Only the SHA-256 and SHA-384 banks are considered. If the query fails or none of them is active, only the SHA-256
+ * bank is extended, as before. An active SHA-1 bank is left unextended, which is logged, so it must not be used in a
+ * sealing policy.
+ *
+ * @param tpmCtx  The TPM context.
+ */
+static void cominitTpmGetPcrBanks(cominitTpmContext_t *tpmCtx) {
+    TPMI_YES_NO moreData = TPM2_NO;
+    TPMS_CAPABILITY_DATA *capabilityData = NULL;
+    unsigned int banks = 0;
+
+    TSS2_RC rc = cominitTpmProfileCall(COMINIT_TPM_CMD_GET_CAPABILITY,
+                                       Esys_GetCapability(tpmCtx->esysCtx, ESYS_TR_NONE, ESYS_TR_NONE, ESYS_TR_NONE,
+                                                          TPM2_CAP_PCRS, 0, 1, &moreData, &capabilityData));
+    if (rc != TSS2_RC_SUCCESS || capabilityData == NULL) {
+        cominitWarnPrint("Could not get the active PCR banks, using SHA-256");
+    } else {
+        const TPML_PCR_SELECTION *assigned = &capabilityData->data.assignedPCR;
+        for (UINT32 i = 0; i < assigned->count && i < TPM2_NUM_PCR_BANKS; i++) {
+            const TPMS_PCR_SELECTION *bank = &assigned->pcrSelections[i];
+            bool active = false;
+            for (UINT8 j = 0; j < bank->sizeofSelect && j < sizeof(bank->pcrSelect); j++) {
+                active = active || bank->pcrSelect[j] != 0;
+            }
+            if (active && bank->hash == TPM2_ALG_SHA256) {
+                banks |= COMINIT_CRYPTO_DIGEST_SHA256;
+            } else if (active && bank->hash == TPM2_ALG_SHA384) {
+                banks |= COMINIT_CRYPTO_DIGEST_SHA384;
+            } else if (active && bank->hash == TPM2_ALG_SHA1) {
+                cominitWarnPrint("The active SHA-1 PCR bank is not extended");
+            }
+        }
+    }
+    Esys_Free(capabilityData);
+
+    tpmCtx->pcrBanks = (banks != 0) ? banks : COMINIT_CRYPTO_DIGEST_SHA256;
+    cominitDebugPrint("Extending PCR banks:%s%s", (tpmCtx->pcrBanks & COMINIT_CRYPTO_DIGEST_SHA256) ? " SHA-256" : "",
+                      (tpmCtx->pcrBanks & COMINIT_CRYPTO_DIGEST_SHA384) ? " SHA-384" : "");
+}
+
+/**
+ * Extends a PCR in all banks selected in \a digests with a single TPM command.
+ *
+ * @param tpmCtx    The TPM context.
+ * @param pcrIndex  The index of the PCR to extend.
+ * @param digests   The digests of the measurement.
+ *
+ * @return  EXIT_SUCCESS on success, EXIT_FAILURE otherwise
+ */
+static int cominitTpmExtendDigests(cominitTpmContext_t *tpmCtx, unsigned long pcrIndex,
+                                   const cominitCryptoDigests_t *digests) {
+    int result = EXIT_FAILURE;
+    ESYS_TR pcrTR = ESYS_TR_PCR0 + pcrIndex;
+    TPML_DIGEST_VALUES vals = {.count = 0};
+
+    if (digests->algs & COMINIT_CRYPTO_DIGEST_SHA256) {
+        vals.digests[vals.count].hashAlg = TPM2_ALG_SHA256;
+        memcpy(vals.digests[vals.count].digest.sha256, digests->sha256, SHA256_LEN);
+        vals.count++;
+    }
+    if (digests->algs & COMINIT_CRYPTO_DIGEST_SHA384) {
+        vals.digests[vals.count].hashAlg = TPM2_ALG_SHA384;
+        memcpy(vals.digests[vals.count].digest.sha384, digests->sha384, SHA384_LEN);
+        vals.count++;
+    }
+
+    TSS2_RC rc = cominitTpmProfileCall(
+        COMINIT_TPM_CMD_PCR_EXTEND,
+        Esys_PCR_Extend(tpmCtx->esysCtx, pcrTR, ESYS_TR_PASSWORD, ESYS_TR_NONE, ESYS_TR_NONE, &vals));
+    if (rc == TSS2_RC_SUCCESS) {
+        result = EXIT_SUCCESS;
     }
 
     return result;
@@ -574,25 +1363,100 @@ int cominitInitTpm(cominitTpmContext_t *tpmCtx) {
 
 int cominitTpmExtendPCR(cominitTpmContext_t *tpmCtx, const char *keyfile, unsigned long pcrIndex) {
     int result = EXIT_FAILURE;
-    unsigned char digest[SHA256_LEN];
 
     if (tpmCtx == NULL || keyfile == NULL) {
         cominitErrPrint("Invalid parameters");
     } else {
-        result = cominitCreateSHA256DigestfromKeyfile(keyfile, digest, ARRAY_SIZE(digest));
+        if (tpmCtx->pcrBanks == 0) {
+            cominitTpmGetPcrBanks(tpmCtx);
+        }
+        cominitCryptoDigests_t digests = {.algs = tpmCtx->pcrBanks};
+        result = cominitCryptoDigestsFromKeyfile(keyfile, &digests);
         if (result != EXIT_SUCCESS) {
             cominitErrPrint("Could not hash the rootfs public key");
         } else {
-            ESYS_TR pcrTR = ESYS_TR_PCR0 + pcrIndex;
-            TPML_DIGEST_VALUES vals = {.count = 1};
-            vals.digests[0].hashAlg = TPM2_ALG_SHA256;
-            memcpy(vals.digests[0].digest.sha256, digest, sizeof(digest));
+            result = cominitTpmExtendDigests(tpmCtx, pcrIndex, &digests);
+        }
+    }
 
-            TSS2_RC rc = Esys_PCR_Extend(tpmCtx->esysCtx, pcrTR, ESYS_TR_PASSWORD, ESYS_TR_NONE, ESYS_TR_NONE, &vals);
-            if (rc != TSS2_RC_SUCCESS) {
-                result = EXIT_FAILURE;
+    return result;
+}
+
+int cominitTpmMeasure(cominitTpmContext_t *tpmCtx, unsigned long pcrIndex, const uint8_t *data, size_t dataLen) {
+    int result = EXIT_FAILURE;
+
+    if (tpmCtx == NULL || (data == NULL && dataLen > 0)) {
+        cominitErrPrint("Invalid parameters");
+    } else {
+        if (tpmCtx->pcrBanks == 0) {
+            cominitTpmGetPcrBanks(tpmCtx);
+        }
+        cominitCryptoDigests_t digests = {.algs = tpmCtx->pcrBanks};
+        result = cominitCryptoDigests(data, dataLen, &digests);
+        if (result != EXIT_SUCCESS) {
+            cominitErrPrint("Could not hash the measurement");
+        } else {
+            result = cominitTpmExtendDigests(tpmCtx, pcrIndex, &digests);
+        }
+    }
+
+    return result;
+}
+
+/**
+ * Measures the verified partition metadata, the dm-verity root hash and the Kernel command line into a PCR.
+ *
+ * @param tpmCtx    The TPM context.
+ * @param rfsMeta   The verified metadata of the rootfs.
+ * @param pcrIndex  The index of the PCR to extend.
+ *
+ * @return  EXIT_SUCCESS on success, EXIT_FAILURE otherwise
+ */
+static int cominitTpmMeasureConfig(cominitTpmContext_t *tpmCtx, const cominitRfsMetaData_t *rfsMeta,
+                                   unsigned long pcrIndex) {
+    int result = EXIT_FAILURE;
+
+    if (cominitTpmMeasure(tpmCtx, pcrIndex, rfsMeta->metadata, rfsMeta->metadataLen) != EXIT_SUCCESS) {
+        cominitErrPrint("Could not measure the rootfs metadata");
+    } else if (rfsMeta->dmVerityRootHash[0] != '\0' &&
+               cominitTpmMeasure(tpmCtx, pcrIndex, (const uint8_t *)rfsMeta->dmVerityRootHash,
+                                 strlen(rfsMeta->dmVerityRootHash)) != EXIT_SUCCESS) {
+        cominitErrPrint("Could not measure the dm-verity root hash");
+    } else {
+        uint8_t cmdline[COMINIT_TPM_CMDLINE_MAX];
+        ssize_t cmdlineLen = -1;
+        int fd = open(COMINIT_TPM_CMDLINE_PATH, O_RDONLY | O_CLOEXEC);
+        if (fd < 0) {
+            cominitErrnoPrint("Could not open '%s'", COMINIT_TPM_CMDLINE_PATH);
+        } else {
+            cmdlineLen = read(fd, cmdline, sizeof(cmdline));
+            if (cmdlineLen < 0) {
+                cominitErrnoPrint("Could not read '%s'", COMINIT_TPM_CMDLINE_PATH);
             }
+            close(fd);
         }
+        if (cmdlineLen >= 0 && cominitTpmMeasure(tpmCtx, pcrIndex, cmdline, (size_t)cmdlineLen) == EXIT_SUCCESS) {
+            result = EXIT_SUCCESS;
+        } else {
+            cominitErrPrint("Could not measure the Kernel command line");
+        }
+    }
+
+    return result;
+}
+
+int cominitTpmMeasureBoot(cominitTpmContext_t *tpmCtx, const cominitRfsMetaData_t *rfsMeta, const char *keyfile,
+                          const cominitCliArgs_t *argCtx) {
+    int result = EXIT_FAILURE;
+
+    if (tpmCtx == NULL || rfsMeta == NULL || keyfile == NULL || argCtx == NULL) {
+        cominitErrPrint("Invalid parameters");
+    } else if (argCtx->pcrSet == true && cominitTpmExtendPCR(tpmCtx, keyfile, argCtx->pcrIndex) != EXIT_SUCCESS) {
+        cominitErrPrint("Could not measure the rootfs public key");
+    } else if (argCtx->pcrMeasureSet == true) {
+        result = cominitTpmMeasureConfig(tpmCtx, rfsMeta, argCtx->pcrMeasureIndex);
+    } else {
+        result = EXIT_SUCCESS;
     }
 
     return result;
@@ -604,6 +1468,9 @@ int cominitDeleteTpm(cominitTpmContext_t *tpmCtx) {
     if (tpmCtx == NULL || tpmCtx->tctiCtx == NULL || tpmCtx->esysCtx == NULL) {
         cominitErrPrint("Invalid parameters");
     } else {
+#ifdef COMINIT_TPM_PROFILE
+        cominitTpmProfileReport();
+#endif
         Tss2_TctiLdr_Finalize(&tpmCtx->tctiCtx);
         Esys_Finalize(&tpmCtx->esysCtx);
         result = EXIT_SUCCESS;
@@ -632,6 +1499,79 @@ int cominitTpmParsePcrIndex(cominitCliArgs_t *argCtx, const char *argValue) {
     return result;
 }
 
+int cominitTpmParsePcrMeasureIndex(cominitCliArgs_t *argCtx, const char *argValue) {
+    int result = EXIT_FAILURE;
+
+    if (argCtx == NULL || argValue == NULL) {
+        cominitErrPrint("Invalid parameters");
+    } else {
+        argCtx->pcrMeasureSet = false;
+        errno = 0;
+        char *end;
+        unsigned long pcrIndex = strtoul(argValue, &end, 0);
+        if (!errno && *end == '\0' && pcrIndex < TPM2_PT_PCR_COUNT) {
+            result = EXIT_SUCCESS;
+            argCtx->pcrMeasureSet = true;
+            argCtx->pcrMeasureIndex = pcrIndex;
+        }
+    }
+
+    return result;
+}
+
+int cominitTpmParsePrimaryHandle(cominitCliArgs_t *argCtx, const char *argValue) {
+    int result = EXIT_FAILURE;
+
+    if (argCtx == NULL || argValue == NULL) {
+        cominitErrPrint("Invalid parameters");
+    } else {
+        errno = 0;
+        char *end;
+        unsigned long handle = strtoul(argValue, &end, 0);
+        if (!errno && end != argValue && *end == '\0' && handle >= TPM2_PERSISTENT_FIRST &&
+            handle <= TPM2_PERSISTENT_LAST) {
+            argCtx->tpmPrimaryHandle = (TPM2_HANDLE)handle;
+            result = EXIT_SUCCESS;
+        }
+    }
+
+    return result;
+}
+
+int cominitTpmParseSelftest(cominitCliArgs_t *argCtx, const char *argValue) {
+    int result = EXIT_FAILURE;
+
+    if (argCtx == NULL || argValue == NULL) {
+        cominitErrPrint("Invalid parameters");
+    } else {
+        if (strcmp(argValue, "incremental") == 0) {
+            argCtx->tpmFullSelftest = false;
+            result = EXIT_SUCCESS;
+        } else if (strcmp(argValue, "full") == 0) {
+            argCtx->tpmFullSelftest = true;
+            result = EXIT_SUCCESS;
+        }
+    }
+
+    return result;
+}
+
+int cominitTpmParseTcti(cominitCliArgs_t *argCtx, const char *argValue) {
+    int result = EXIT_FAILURE;
+
+    if (argCtx == NULL || argValue == NULL) {
+        cominitErrPrint("Invalid parameters");
+    } else {
+        size_t len = strnlen(argValue, sizeof(argCtx->tpmTcti));
+        if (len > 0 && len < sizeof(argCtx->tpmTcti)) {
+            memcpy(argCtx->tpmTcti, argValue, len + 1);
+            result = EXIT_SUCCESS;
+        }
+    }
+
+    return result;
+}
+
 int cominitTpmParsePcrIndexes(cominitCliArgs_t *argCtx, const char *argValue) {
     int result = EXIT_FAILURE;
     unsigned long i = 0;
@@ -666,16 +1606,247 @@ int cominitTpmParsePcrIndexes(cominitCliArgs_t *argCtx, const char *argValue) {
     return result;
 }
 
-int cominitTpmMountSecureStorage() {
-    int result = cominitMkdir(COMINIT_TPM_SECURE_STORAGE_MNT, S_IRWXU);
-    if (result != EXIT_SUCCESS) {
-        cominitErrPrint("creating mount point for secure storage failed");
+int cominitTpmMountSecureStorage(const char *mountPoint) {
+    int result = EXIT_FAILURE;
+
+    if (mountPoint == NULL) {
+        cominitErrPrint("Invalid parameters");
+    } else {
+        result = cominitMkdir(mountPoint, S_IRWXU);
+        if (result != EXIT_SUCCESS) {
+            cominitErrPrint("creating mount point for secure storage failed");
+        } else {
+            if (mount(COMINIT_TPM_SECURE_STORAGE_LOCATION, mountPoint, "ext4", 0, "") != 0) {
+                result = -EXIT_FAILURE;
+            } else {
+                result = EXIT_SUCCESS;
+            }
+        }
+    }
+
+    return result;
+}
+
+int cominitTpmPrepareSecureStorage(void *data) {
+    int result = EXIT_FAILURE;
+    cominitTpmHelperData_t *helperData = data;
+    bool hasFs = false;
+
+    if (helperData == NULL || helperData->tpmCtx == NULL) {
+        cominitErrPrint("Invalid parameters");
+    } else if (helperData->tpmCtx->formatPending == false) {
+        result = EXIT_SUCCESS;
+    } else if (cominitTpmSecureStorageHasFs(&hasFs) != EXIT_SUCCESS) {
+        cominitErrPrint("Could not check secure storage for a filesystem");
+    } else if (hasFs == true) {
+        result = EXIT_SUCCESS;
+    } else {
+        cominitInfoPrint("Formatting secure storage");
+        result = cominitTpmFormatSecureStorage();
+        if (result != EXIT_SUCCESS) {
+            cominitErrPrint("formating secure storage failed");
+        } else {
+            helperData->tpmCtx->formatPending = false;
+        }
+    }
+
+    return result;
+}
+
+int cominitTpmUnlockSecureStorage(void *data) {
+    int result = EXIT_FAILURE;
+    cominitTpmHelperData_t *helperData = data;
+
+    if (helperData == NULL || helperData->tpmCtx == NULL || helperData->argCtx == NULL) {
+        cominitErrPrint("Invalid parameters");
     } else {
-        if (mount(COMINIT_TPM_SECURE_STORAGE_LOCATION, COMINIT_TPM_SECURE_STORAGE_MNT, "ext4", 0, "") != 0) {
-            result = -EXIT_FAILURE;
+        cominitTpmState_t state = TpmFailure;
+        if (cominitInitTpm(helperData->tpmCtx, helperData->argCtx) != EXIT_SUCCESS) {
+            cominitErrPrint("TPM init failed.");
         } else {
+            state = cominitTpmProtectData(helperData->tpmCtx, helperData->argCtx);
+        }
+        switch (state) {
+            case TpmPolicyFailure:
+                if (cominitTpmHandlePolicyFailure(helperData->tpmCtx) != EXIT_SUCCESS) {
+                    cominitErrPrint("Failed to handle policy failure");
+                }
+                break;
+            case Unsealed:
+                result = EXIT_SUCCESS;
+                break;
+            case Sealed:
+                cominitWarnPrint("Secure storage not available before the sealed PCR state is reached.");
+                break;
+            case TpmFailure:
+            default:
+                cominitErrPrint("TPM failed to set up protected data.");
+                break;
+        }
+        if (helperData->tpmCtx->tctiCtx != NULL && helperData->tpmCtx->esysCtx != NULL) {
+            cominitDeleteTpm(helperData->tpmCtx);
+        }
+    }
+
+    return result;
+}
+
+int cominitTpmFinishSecureStorage(void *data) {
+    /* Already done by the first task in deferred mode, left to this one in detached mode. */
+    int result = cominitTpmPrepareSecureStorage(data);
+    if (result == EXIT_SUCCESS) {
+        result = cominitTpmMountSecureStorage(COMINIT_TPM_SECURE_STORAGE_MNT_DEFERRED);
+    }
+    if (result != EXIT_SUCCESS) {
+        cominitErrPrint("Mounting of secure storage failed");
+    } else {
+        cominitInfoPrint("Secure storage mounted");
+    }
+
+    return result;
+}
+
+int cominitTpmParseSecureStorageMode(cominitCliArgs_t *argCtx, const char *argValue) {
+    int result = EXIT_FAILURE;
+
+    if (argCtx == NULL || argValue == NULL) {
+        cominitErrPrint("Invalid parameters");
+    } else {
+        if (strcmp(argValue, "sync") == 0) {
+            argCtx->secureStorageMode = COMINIT_SECURE_STORAGE_MODE_SYNC;
+            result = EXIT_SUCCESS;
+        } else if (strcmp(argValue, "deferred") == 0) {
+            argCtx->secureStorageMode = COMINIT_SECURE_STORAGE_MODE_DEFERRED;
+            result = EXIT_SUCCESS;
+        } else if (strcmp(argValue, "detached") == 0) {
+            argCtx->secureStorageMode = COMINIT_SECURE_STORAGE_MODE_DETACHED;
+            result = EXIT_SUCCESS;
+        }
+    }
+
+    return result;
+}
+
+int cominitTpmParseBlobStorage(cominitCliArgs_t *argCtx, const char *argValue) {
+    int result = EXIT_FAILURE;
+
+    if (argCtx == NULL || argValue == NULL) {
+        cominitErrPrint("Invalid parameters");
+    } else {
+        if (strcmp(argValue, "ext4") == 0) {
+            argCtx->blobStorage = COMINIT_BLOB_STORAGE_EXT4;
+            result = EXIT_SUCCESS;
+        } else if (strcmp(argValue, "raw") == 0) {
+            argCtx->blobStorage = COMINIT_BLOB_STORAGE_RAW;
             result = EXIT_SUCCESS;
+        } else if (strcmp(argValue, "nv") == 0) {
+            argCtx->blobStorage = COMINIT_BLOB_STORAGE_NV;
+            result = EXIT_SUCCESS;
+        } else if (strncmp(argValue, "nv:", 3) == 0) {
+            errno = 0;
+            char *end;
+            unsigned long index = strtoul(argValue + 3, &end, 0);
+            if (!errno && end != argValue + 3 && *end == '\0' && index >= TPM2_NV_INDEX_FIRST &&
+                index <= TPM2_NV_INDEX_LAST) {
+                argCtx->blobStorage = COMINIT_BLOB_STORAGE_NV;
+                argCtx->blobNvIndex = (TPM2_HANDLE)index;
+                result = EXIT_SUCCESS;
+            }
+        }
+    }
+
+    return result;
+}
+
+/**
+ * Checks that a volume name is usable as device-mapper name and key description suffix.
+ *
+ * @param name  The volume name.
+ * @return  true if valid, false otherwise
+ */
+static bool cominitTpmIsValidVolumeName(const char *name) {
+    bool valid = (name[0] != '\0' && strcmp(name, COMINIT_TPM_SECURE_STORAGE_NAME) != 0);
+
+    for (const char *c = name; valid && *c != '\0'; c++) {
+        valid = (isalnum((unsigned char)*c) || *c == '_' || *c == '-');
+    }
+
+    return valid;
+}
+
+/**
+ * Checks a GUID in its canonical string form and converts it to lower case.
+ *
+ * @param guid  The GUID string of #COMINIT_GUID_STR_LEN - 1 characters.
+ * @return  true if valid, false otherwise
+ */
+static bool cominitTpmNormalizeGuid(char *guid) {
+    bool valid = (strlen(guid) == COMINIT_GUID_STR_LEN - 1);
+
+    for (size_t i = 0; valid && i < COMINIT_GUID_STR_LEN - 1; i++) {
+        if (i == 8 || i == 13 || i == 18 || i == 23) {
+            valid = (guid[i] == '-');
+        } else {
+            valid = isxdigit((unsigned char)guid[i]);
+            guid[i] = (char)tolower((unsigned char)guid[i]);
+        }
+    }
+
+    return valid;
+}
+
+int cominitTpmParseCryptVolumes(cominitCliArgs_t *argCtx, const char *argValue) {
+    int result = EXIT_FAILURE;
+
+    if (argCtx == NULL || argValue == NULL) {
+        cominitErrPrint("Invalid parameters");
+    } else {
+        const char *p = argValue;
+        int count = 0;
+
+        result = EXIT_SUCCESS;
+        while (*p != '\0' && result == EXIT_SUCCESS) {
+            const char *end = strchr(p, ',');
+            if (end == NULL) {
+                end = p + strlen(p);
+            }
+            const char *sep = memchr(p, ':', (size_t)(end - p));
+            size_t nameLen = (sep != NULL) ? (size_t)(sep - p) : 0;
+            /* The GUID, optionally followed by the create suffix */
+            size_t valueLen = (sep != NULL) ? (size_t)(end - sep - 1) : 0;
+            bool create = (valueLen == COMINIT_GUID_STR_LEN - 1 + strlen(COMINIT_TPM_VOLUME_CREATE) &&
+                           strncmp(sep + COMINIT_GUID_STR_LEN, COMINIT_TPM_VOLUME_CREATE,
+                                   strlen(COMINIT_TPM_VOLUME_CREATE)) == 0);
+            if (count >= COMINIT_CRYPT_VOLUMES_MAX || sep == NULL || nameLen >= COMINIT_CRYPT_VOLUME_NAME_MAX ||
+                (valueLen != COMINIT_GUID_STR_LEN - 1 && create == false)) {
+                result = EXIT_FAILURE;
+            } else {
+                cominitCryptVolume_t *volume = &argCtx->cryptVolumes[count];
+                memcpy(volume->name, p, nameLen);
+                volume->name[nameLen] = '\0';
+                memcpy(volume->partUuid, sep + 1, COMINIT_GUID_STR_LEN - 1);
+                volume->partUuid[COMINIT_GUID_STR_LEN - 1] = '\0';
+                volume->devNode[0] = '\0';
+                volume->create = create;
+                if (cominitTpmIsValidVolumeName(volume->name) == false ||
+                    cominitTpmNormalizeGuid(volume->partUuid) == false) {
+                    result = EXIT_FAILURE;
+                }
+                for (int i = 0; result == EXIT_SUCCESS && i < count; i++) {
+                    if (strcmp(argCtx->cryptVolumes[i].name, volume->name) == 0 ||
+                        strcmp(argCtx->cryptVolumes[i].partUuid, volume->partUuid) == 0) {
+                        result = EXIT_FAILURE;
+                    }
+                }
+                count++;
+            }
+            p = (*end == ',') ? end + 1 : end;
+        }
+
+        if (count == 0) {
+            result = EXIT_FAILURE;
         }
+        argCtx->cryptVolumeCount = (result == EXIT_SUCCESS) ? count : 0;
     }
 
     return result;
@@ -701,7 +1872,8 @@ bool cominitTpmSecureStorageEnabled(cominitCliArgs_t *argCtx) {
     if (argCtx == NULL) {
         cominitErrPrint("Invalid parameters");
     } else {
-        if (argCtx->devNodeBlob[0] != '\0' && argCtx->pcrSealCount > 0 && argCtx->devNodeCrypt[0] != '\0') {
+        bool blobConfigured = argCtx->devNodeBlob[0] != '\0' || argCtx->blobStorage == COMINIT_BLOB_STORAGE_NV;
+        if (blobConfigured && argCtx->pcrSealCount > 0 && argCtx->devNodeCrypt[0] != '\0') {
             secureStorageEnabled = true;
         }
     }
@@ -715,7 +1887,7 @@ bool cominitTpmExtendEnabled(cominitCliArgs_t *argCtx) {
     if (argCtx == NULL) {
         cominitErrPrint("Invalid parameters");
     } else {
-        if (argCtx->pcrSet == true) {
+        if (argCtx->pcrSet == true || argCtx->pcrMeasureSet == true) {
             extendEnabled = true;
         }
     }
@@ -726,18 +1898,25 @@ bool cominitTpmExtendEnabled(cominitCliArgs_t *argCtx) {
 cominitTpmState_t cominitTpmProtectData(cominitTpmContext_t *tpmCtx, cominitCliArgs_t *argCtx) {
     cominitBlobState_t blobState = BlobNotFound;
     cominitTpmState_t tpmState = TpmFailure;
+    cominitTpmBlob_t blob = {0};
 
-    blobState = cominitTpmSetupBlob(argCtx);
+    tpmCtx->formatPending = false;
+    blobState = cominitTpmSetupBlob(tpmCtx->esysCtx, argCtx, &blob);
 
     switch (blobState) {
         case BlobIsEmpty:
             cominitInfoPrint("Blob is empty: sealing");
-            tpmState = cominitTpmSealBlob(tpmCtx->esysCtx, argCtx);
+            tpmState = cominitTpmSealBlob(tpmCtx->esysCtx, argCtx, &blob);
             if (tpmState == Sealed) {
-                tpmState = cominitTpmUnsealBlob(tpmCtx->esysCtx, argCtx);
+                tpmState = cominitTpmUnseal(tpmCtx->esysCtx, &blob, argCtx);
+                if (tpmState == TpmPolicyFailure) {
+                    /* Sealed for expected PCR values, the first boot in that state creates the volume. */
+                    cominitInfoPrint("Key sealed for a future PCR state, secure storage is set up once it is reached");
+                    tpmState = Sealed;
+                }
             }
             if (tpmState == Unsealed) {
-                if (cominitTpmSetupSecureStorage(argCtx, true) != EXIT_SUCCESS) {
+                if (cominitTpmSetupSecureStorage(tpmCtx, argCtx, &blob) != EXIT_SUCCESS) {
                     cominitErrPrint("Secure storage could not be set up.");
                     tpmState = TpmFailure;
                 }
@@ -745,9 +1924,9 @@ cominitTpmState_t cominitTpmProtectData(cominitTpmContext_t *tpmCtx, cominitCliA
             break;
         case BlobExists:
             cominitInfoPrint("Blob exists: unsealing");
-            tpmState = cominitTpmUnsealBlob(tpmCtx->esysCtx, argCtx);
+            tpmState = cominitTpmUnseal(tpmCtx->esysCtx, &blob, argCtx);
             if (tpmState == Unsealed) {
-                if (cominitTpmSetupSecureStorage(argCtx, false) != EXIT_SUCCESS) {
+                if (cominitTpmSetupSecureStorage(tpmCtx, argCtx, &blob) != EXIT_SUCCESS) {
                     cominitErrPrint("Secure storage could not be set up.");
                     tpmState = TpmFailure;
                 }
@@ -760,7 +1939,12 @@ cominitTpmState_t cominitTpmProtectData(cominitTpmContext_t *tpmCtx, cominitCliA
             break;
     }
 
-    cominitTpmUnmountBlob(argCtx->devNodeBlob);
+    if (argCtx->blobStorage == COMINIT_BLOB_STORAGE_EXT4) {
+        cominitTpmUnmountBlob();
+    } else if (argCtx->blobStorage == COMINIT_BLOB_STORAGE_NV &&
+               cominitTpmBlobNvLock(tpmCtx->esysCtx, argCtx->blobNvIndex) != EXIT_SUCCESS) {
+        cominitErrPrint("The sealed blob stays writable until the next boot");
+    }
 
     return tpmState;
 }
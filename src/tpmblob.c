@@ -0,0 +1,693 @@
+// SPDX-License-Identifier: MIT
+/**
+ * @file tpmblob.c
+ * @brief Implementation of the storage format of the TPM sealed blob.
+ */
+#include "tpmblob.h"
+
+#include <errno.h>
+#include <fcntl.h>
+#include <libgen.h>
+#include <limits.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/stat.h>
+#include <tss2/tss2_mu.h>
+#include <unistd.h>
+
+#include "common.h"
+#include "output.h"
+#include "tpmprofile.h"
+
+/**
+ * Stores a 16 bit value big endian.
+ *
+ * @param p      The destination.
+ * @param value  The value.
+ */
+static inline void cominitTpmBlobPut16(uint8_t *p, uint16_t value) {
+    p[0] = (uint8_t)(value >> 8);
+    p[1] = (uint8_t)value;
+}
+
+/**
+ * Stores a 32 bit value big endian.
+ *
+ * @param p      The destination.
+ * @param value  The value.
+ */
+static inline void cominitTpmBlobPut32(uint8_t *p, uint32_t value) {
+    p[0] = (uint8_t)(value >> 24);
+    p[1] = (uint8_t)(value >> 16);
+    p[2] = (uint8_t)(value >> 8);
+    p[3] = (uint8_t)value;
+}
+
+/**
+ * Loads a 16 bit big endian value.
+ *
+ * @param p  The source.
+ *
+ * @return  The value
+ */
+static inline uint16_t cominitTpmBlobGet16(const uint8_t *p) {
+    return (uint16_t)(((uint16_t)p[0] << 8) | p[1]);
+}
+
+/**
+ * Loads a 32 bit big endian value.
+ *
+ * @param p  The source.
+ *
+ * @return  The value
+ */
+static inline uint32_t cominitTpmBlobGet32(const uint8_t *p) {
+    return ((uint32_t)p[0] << 24) | ((uint32_t)p[1] << 16) | ((uint32_t)p[2] << 8) | p[3];
+}
+
+/**
+ * Accepts a blob in the raw format of earlier versions of cominit.
+ *
+ * @param blob      The structure that receives the blob.
+ * @param buffer    The raw TPM2B_PUBLIC followed by the raw TPM2B_PRIVATE.
+ * @param length    The size of \a buffer.
+ *
+ * @return  EXIT_SUCCESS on success, EXIT_FAILURE otherwise
+ */
+static int cominitTpmBlobLoadLegacy(cominitTpmBlob_t *blob, const uint8_t *buffer, size_t length) {
+    int result = EXIT_FAILURE;
+
+    if (length == sizeof(blob->outPublic) + sizeof(blob->outPrivate)) {
+        memset(blob, 0, sizeof(*blob));
+        memcpy(&blob->outPublic, buffer, sizeof(blob->outPublic));
+        memcpy(&blob->outPrivate, buffer + sizeof(blob->outPublic), sizeof(blob->outPrivate));
+        if (blob->outPublic.publicArea.authPolicy.size <= sizeof(blob->policyDigest.buffer)) {
+            blob->policyDigest.size = blob->outPublic.publicArea.authPolicy.size;
+            memcpy(blob->policyDigest.buffer, blob->outPublic.publicArea.authPolicy.buffer, blob->policyDigest.size);
+            cominitInfoPrint("Loaded sealed blob in legacy format");
+            result = EXIT_SUCCESS;
+        }
+    }
+
+    return result;
+}
+
+/**
+ * Checks whether a PCR is selected in the first bank of the PCR selection of a blob.
+ *
+ * @param blob  The blob.
+ * @param pcrIndex  The index of the PCR.
+ *
+ * @return  true if selected, false otherwise
+ */
+static inline bool cominitTpmBlobPcrSelected(const cominitTpmBlob_t *blob, unsigned int pcrIndex) {
+    return blob->pcrSelection.count > 0 && pcrIndex / 8 < blob->pcrSelection.pcrSelections[0].sizeofSelect &&
+           (blob->pcrSelection.pcrSelections[0].pcrSelect[pcrIndex / 8] & (1u << (pcrIndex % 8))) != 0;
+}
+
+/**
+ * Marshals the sealed values of the selected PCRs.
+ *
+ * @param blob      The blob.
+ * @param buffer    The buffer receiving the marshaled values.
+ * @param bufferSize The size of \a buffer.
+ * @param offset    Pointer to the current offset in \a buffer, updated on success.
+ *
+ * @return  EXIT_SUCCESS on success, EXIT_FAILURE otherwise
+ */
+static int cominitTpmBlobMarshalPcrValues(const cominitTpmBlob_t *blob, uint8_t *buffer, size_t bufferSize,
+                                          size_t *offset) {
+    int result = EXIT_SUCCESS;
+
+    for (unsigned int i = 0; i < COMINIT_TPMBLOB_PCR_MAX && result == EXIT_SUCCESS; i++) {
+        if (cominitTpmBlobPcrSelected(blob, i) &&
+            Tss2_MU_TPM2B_DIGEST_Marshal(&blob->pcrValues[i], buffer, bufferSize, offset) != TSS2_RC_SUCCESS) {
+            result = EXIT_FAILURE;
+        }
+    }
+
+    return result;
+}
+
+/**
+ * Unmarshals the sealed values of the selected PCRs.
+ *
+ * @param blob      The blob with the PCR selection already unmarshaled.
+ * @param buffer    The buffer holding the marshaled values.
+ * @param bufferSize The size of \a buffer.
+ * @param offset    Pointer to the current offset in \a buffer, updated on success.
+ *
+ * @return  EXIT_SUCCESS on success, EXIT_FAILURE otherwise
+ */
+static int cominitTpmBlobUnmarshalPcrValues(cominitTpmBlob_t *blob, const uint8_t *buffer, size_t bufferSize,
+                                            size_t *offset) {
+    int result = EXIT_SUCCESS;
+
+    for (unsigned int i = 0; i < COMINIT_TPMBLOB_PCR_MAX && result == EXIT_SUCCESS; i++) {
+        if (cominitTpmBlobPcrSelected(blob, i) &&
+            Tss2_MU_TPM2B_DIGEST_Unmarshal(buffer, bufferSize, offset, &blob->pcrValues[i]) != TSS2_RC_SUCCESS) {
+            result = EXIT_FAILURE;
+        }
+    }
+
+    return result;
+}
+
+/**
+ * Marshals the IDs of the created volumes, preceded by their number.
+ *
+ * @param blob      The blob.
+ * @param buffer    The buffer receiving the marshaled IDs.
+ * @param bufferSize The size of \a buffer.
+ * @param offset    Pointer to the current offset in \a buffer, updated on success.
+ *
+ * @return  EXIT_SUCCESS on success, EXIT_FAILURE otherwise
+ */
+static int cominitTpmBlobMarshalVolumes(const cominitTpmBlob_t *blob, uint8_t *buffer, size_t bufferSize,
+                                        size_t *offset) {
+    int result = EXIT_FAILURE;
+    size_t length = blob->volumeCount * COMINIT_TPMBLOB_VOLUME_ID_SIZE;
+
+    if (blob->volumeCount <= COMINIT_TPMBLOB_VOLUMES_MAX &&
+        Tss2_MU_UINT32_Marshal(blob->volumeCount, buffer, bufferSize, offset) == TSS2_RC_SUCCESS &&
+        length <= bufferSize - *offset) {
+        memcpy(buffer + *offset, blob->volumes, length);
+        *offset += length;
+        result = EXIT_SUCCESS;
+    }
+
+    return result;
+}
+
+/**
+ * Unmarshals the IDs of the created volumes, preceded by their number.
+ *
+ * @param blob      The blob.
+ * @param buffer    The buffer holding the marshaled IDs.
+ * @param bufferSize The size of \a buffer.
+ * @param offset    Pointer to the current offset in \a buffer, updated on success.
+ *
+ * @return  EXIT_SUCCESS on success, EXIT_FAILURE otherwise
+ */
+static int cominitTpmBlobUnmarshalVolumes(cominitTpmBlob_t *blob, const uint8_t *buffer, size_t bufferSize,
+                                          size_t *offset) {
+    int result = EXIT_FAILURE;
+    uint32_t count = 0;
+
+    if (Tss2_MU_UINT32_Unmarshal(buffer, bufferSize, offset, &count) == TSS2_RC_SUCCESS &&
+        count <= COMINIT_TPMBLOB_VOLUMES_MAX && count * COMINIT_TPMBLOB_VOLUME_ID_SIZE <= bufferSize - *offset) {
+        blob->volumeCount = count;
+        memcpy(blob->volumes, buffer + *offset, count * COMINIT_TPMBLOB_VOLUME_ID_SIZE);
+        *offset += count * COMINIT_TPMBLOB_VOLUME_ID_SIZE;
+        result = EXIT_SUCCESS;
+    }
+
+    return result;
+}
+
+int cominitTpmBlobSerialize(const cominitTpmBlob_t *blob, uint8_t *buffer, size_t bufferSize, size_t *length) {
+    int result = EXIT_FAILURE;
+    size_t offset = COMINIT_TPMBLOB_HEADER_SIZE;
+
+    if (blob == NULL || buffer == NULL || length == NULL ||
+        bufferSize < COMINIT_TPMBLOB_HEADER_SIZE + COMINIT_TPMBLOB_CRC_SIZE) {
+        cominitErrPrint("Invalid parameters");
+    } else {
+        size_t payloadEnd = bufferSize - COMINIT_TPMBLOB_CRC_SIZE;
+        if (Tss2_MU_TPML_PCR_SELECTION_Marshal(&blob->pcrSelection, buffer, payloadEnd, &offset) != TSS2_RC_SUCCESS ||
+            Tss2_MU_TPM2B_DIGEST_Marshal(&blob->policyDigest, buffer, payloadEnd, &offset) != TSS2_RC_SUCCESS ||
+            Tss2_MU_TPM2B_PUBLIC_Marshal(&blob->outPublic, buffer, payloadEnd, &offset) != TSS2_RC_SUCCESS ||
+            Tss2_MU_TPM2B_PRIVATE_Marshal(&blob->outPrivate, buffer, payloadEnd, &offset) != TSS2_RC_SUCCESS ||
+            cominitTpmBlobMarshalPcrValues(blob, buffer, payloadEnd, &offset) != EXIT_SUCCESS ||
+            Tss2_MU_UINT32_Marshal(blob->flags, buffer, payloadEnd, &offset) != TSS2_RC_SUCCESS ||
+            cominitTpmBlobMarshalVolumes(blob, buffer, payloadEnd, &offset) != EXIT_SUCCESS) {
+            cominitErrPrint("Could not marshal sealed blob");
+        } else {
+            memcpy(buffer, COMINIT_TPMBLOB_MAGIC, 4);
+            cominitTpmBlobPut16(buffer + 4, COMINIT_TPMBLOB_VERSION);
+            cominitTpmBlobPut16(buffer + 6, blob->sequence);
+            cominitTpmBlobPut32(buffer + 8, (uint32_t)(offset - COMINIT_TPMBLOB_HEADER_SIZE));
+            cominitTpmBlobPut32(buffer + offset, cominitCommonCrc32(buffer, offset));
+            *length = offset + COMINIT_TPMBLOB_CRC_SIZE;
+            result = EXIT_SUCCESS;
+        }
+    }
+
+    return result;
+}
+
+int cominitTpmBlobDeserialize(cominitTpmBlob_t *blob, const uint8_t *buffer, size_t length) {
+    int result = EXIT_FAILURE;
+
+    if (blob == NULL || buffer == NULL) {
+        cominitErrPrint("Invalid parameters");
+    } else if (length < COMINIT_TPMBLOB_HEADER_SIZE + COMINIT_TPMBLOB_CRC_SIZE ||
+               memcmp(buffer, COMINIT_TPMBLOB_MAGIC, 4) != 0) {
+        cominitErrPrint("Sealed blob has no valid header");
+    } else if (cominitTpmBlobGet16(buffer + 4) == 0 || cominitTpmBlobGet16(buffer + 4) > COMINIT_TPMBLOB_VERSION) {
+        cominitErrPrint("Unsupported sealed blob version %u", cominitTpmBlobGet16(buffer + 4));
+    } else {
+        uint16_t version = cominitTpmBlobGet16(buffer + 4);
+        size_t payloadEnd = COMINIT_TPMBLOB_HEADER_SIZE + cominitTpmBlobGet32(buffer + 8);
+        size_t offset = COMINIT_TPMBLOB_HEADER_SIZE;
+        memset(blob->pcrValues, 0, sizeof(blob->pcrValues));
+        blob->flags = 0;
+        blob->volumeCount = 0;
+        if (payloadEnd + COMINIT_TPMBLOB_CRC_SIZE != length) {
+            cominitErrPrint("Sealed blob length mismatch");
+        } else if (cominitTpmBlobGet32(buffer + payloadEnd) != cominitCommonCrc32(buffer, payloadEnd)) {
+            cominitErrPrint("Sealed blob CRC mismatch");
+        } else if (Tss2_MU_TPML_PCR_SELECTION_Unmarshal(buffer, payloadEnd, &offset, &blob->pcrSelection) !=
+                       TSS2_RC_SUCCESS ||
+                   Tss2_MU_TPM2B_DIGEST_Unmarshal(buffer, payloadEnd, &offset, &blob->policyDigest) !=
+                       TSS2_RC_SUCCESS ||
+                   Tss2_MU_TPM2B_PUBLIC_Unmarshal(buffer, payloadEnd, &offset, &blob->outPublic) != TSS2_RC_SUCCESS ||
+                   Tss2_MU_TPM2B_PRIVATE_Unmarshal(buffer, payloadEnd, &offset, &blob->outPrivate) !=
+                       TSS2_RC_SUCCESS ||
+                   (version >= 2 &&
+                    cominitTpmBlobUnmarshalPcrValues(blob, buffer, payloadEnd, &offset) != EXIT_SUCCESS) ||
+                   (version >= 3 &&
+                    (Tss2_MU_UINT32_Unmarshal(buffer, payloadEnd, &offset, &blob->flags) != TSS2_RC_SUCCESS ||
+                     cominitTpmBlobUnmarshalVolumes(blob, buffer, payloadEnd, &offset) != EXIT_SUCCESS)) ||
+                   offset != payloadEnd) {
+            cominitErrPrint("Could not unmarshal sealed blob");
+        } else {
+            blob->sequence = cominitTpmBlobGet16(buffer + 6);
+            result = EXIT_SUCCESS;
+        }
+    }
+
+    return result;
+}
+
+int cominitTpmBlobSave(const cominitTpmBlob_t *blob, const char *path) {
+    int result = EXIT_FAILURE;
+    uint8_t buffer[COMINIT_TPMBLOB_MAX_SIZE];
+    char tmpPath[PATH_MAX];
+    size_t length = 0;
+
+    if (blob == NULL || path == NULL) {
+        cominitErrPrint("Invalid parameters");
+    } else if (snprintf(tmpPath, sizeof(tmpPath), "%s.tmp", path) >= (int)sizeof(tmpPath)) {
+        cominitErrPrint("Path of sealed blob too long");
+    } else if (cominitTpmBlobSerialize(blob, buffer, sizeof(buffer), &length) == EXIT_SUCCESS) {
+        int fd = open(tmpPath, O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC, S_IRUSR | S_IWUSR);
+        if (fd < 0) {
+            cominitErrnoPrint("Could not create \'%s\'", tmpPath);
+        } else {
+            if (write(fd, buffer, length) != (ssize_t)length) {
+                cominitErrnoPrint("Could not write \'%s\'", tmpPath);
+            } else if (fsync(fd) != 0) {
+                cominitErrnoPrint("Could not sync \'%s\'", tmpPath);
+            } else {
+                result = EXIT_SUCCESS;
+            }
+            close(fd);
+
+            if (result == EXIT_SUCCESS && rename(tmpPath, path) != 0) {
+                cominitErrnoPrint("Could not rename \'%s\' to \'%s\'", tmpPath, path);
+                result = EXIT_FAILURE;
+            }
+            if (result != EXIT_SUCCESS) {
+                unlink(tmpPath);
+            } else {
+                /* Persist the rename itself */
+                int dirFd = open(dirname(tmpPath), O_RDONLY | O_DIRECTORY | O_CLOEXEC);
+                if (dirFd >= 0) {
+                    fsync(dirFd);
+                    close(dirFd);
+                }
+            }
+        }
+    }
+
+    return result;
+}
+
+int cominitTpmBlobLoad(cominitTpmBlob_t *blob, const char *path) {
+    int result = EXIT_FAILURE;
+    /* Large enough for legacy blobs as well, one more Byte to detect oversized files */
+    uint8_t buffer[sizeof(TPM2B_PUBLIC) + sizeof(TPM2B_PRIVATE) + COMINIT_TPMBLOB_MAX_SIZE + 1];
+
+    if (blob == NULL || path == NULL) {
+        cominitErrPrint("Invalid parameters");
+    } else {
+        int fd = open(path, O_RDONLY | O_CLOEXEC);
+        if (fd < 0) {
+            cominitErrnoPrint("Could not open \'%s\'", path);
+        } else {
+            ssize_t n = pread(fd, buffer, sizeof(buffer), 0);
+            if (n < 0) {
+                cominitErrnoPrint("Could not read \'%s\'", path);
+            } else if (n >= 4 && memcmp(buffer, COMINIT_TPMBLOB_MAGIC, 4) == 0) {
+                result = cominitTpmBlobDeserialize(blob, buffer, (size_t)n);
+            } else {
+                result = cominitTpmBlobLoadLegacy(blob, buffer, (size_t)n);
+                if (result != EXIT_SUCCESS) {
+                    cominitErrPrint("\'%s\' is not a valid sealed blob", path);
+                }
+            }
+            close(fd);
+        }
+    }
+
+    return result;
+}
+
+/**
+ * Checks whether a copy on a raw partition starts with the magic Bytes.
+ *
+ * The magic Bytes are written after the rest of the copy has been synced. A copy without them has never been saved
+ * completely.
+ *
+ * @param slot  The copy.
+ *
+ * @return  true if the copy has been written before, false otherwise
+ */
+static inline bool cominitTpmBlobRawWritten(const uint8_t *slot) {
+    return memcmp(slot, COMINIT_TPMBLOB_MAGIC, 4) == 0;
+}
+
+/**
+ * Picks the newest valid copy on a raw partition.
+ *
+ * The length of a copy is taken from its header, the rest of the slot is padding.
+ *
+ * @param blob  The structure that receives the newest valid copy.
+ * @param slots  Both copies, #COMINIT_TPMBLOB_RAW_SLOT_SIZE Bytes each.
+ *
+ * @return  The index of the newest valid copy, -1 if there is none
+ */
+static int cominitTpmBlobRawPick(cominitTpmBlob_t *blob, const uint8_t *slots) {
+    int newest = -1;
+    cominitTpmBlob_t copy;
+
+    for (int i = 0; i < 2; i++) {
+        const uint8_t *slot = slots + i * COMINIT_TPMBLOB_RAW_SLOT_SIZE;
+        if (cominitTpmBlobRawWritten(slot)) {
+            size_t length = COMINIT_TPMBLOB_HEADER_SIZE + (size_t)cominitTpmBlobGet32(slot + 8) +
+                            COMINIT_TPMBLOB_CRC_SIZE;
+            if (length > COMINIT_TPMBLOB_RAW_SLOT_SIZE ||
+                cominitTpmBlobDeserialize(&copy, slot, length) != EXIT_SUCCESS) {
+                cominitWarnPrint("Copy %d of the sealed blob is invalid", i);
+            } else if (newest < 0 || (int16_t)(copy.sequence - blob->sequence) > 0) {
+                /* Serial number arithmetic, the sequence number may wrap around */
+                *blob = copy;
+                newest = i;
+            }
+        }
+    }
+
+    return newest;
+}
+
+int cominitTpmBlobRawLoad(cominitTpmBlob_t *blob, const char *device, bool *empty) {
+    int result = EXIT_FAILURE;
+    uint8_t slots[2 * COMINIT_TPMBLOB_RAW_SLOT_SIZE];
+
+    if (blob == NULL || device == NULL || empty == NULL) {
+        cominitErrPrint("Invalid parameters");
+    } else {
+        int fd = open(device, O_RDONLY | O_CLOEXEC);
+        if (fd < 0) {
+            cominitErrnoPrint("Could not open \'%s\'", device);
+        } else {
+            if (pread(fd, slots, sizeof(slots), 0) != (ssize_t)sizeof(slots)) {
+                cominitErrnoPrint("Could not read \'%s\'", device);
+            } else if (!cominitTpmBlobRawWritten(slots) &&
+                       !cominitTpmBlobRawWritten(slots + COMINIT_TPMBLOB_RAW_SLOT_SIZE)) {
+                *empty = true;
+                result = EXIT_SUCCESS;
+            } else if (cominitTpmBlobRawPick(blob, slots) < 0) {
+                cominitErrPrint("\'%s\' holds no valid sealed blob", device);
+            } else {
+                *empty = false;
+                result = EXIT_SUCCESS;
+            }
+            close(fd);
+        }
+    }
+
+    return result;
+}
+
+int cominitTpmBlobRawSave(const cominitTpmBlob_t *blob, const char *device) {
+    int result = EXIT_FAILURE;
+    uint8_t slots[2 * COMINIT_TPMBLOB_RAW_SLOT_SIZE];
+
+    if (blob == NULL || device == NULL) {
+        cominitErrPrint("Invalid parameters");
+    } else {
+        int fd = open(device, O_RDWR | O_CLOEXEC);
+        if (fd < 0) {
+            cominitErrnoPrint("Could not open \'%s\'", device);
+        } else {
+            if (pread(fd, slots, sizeof(slots), 0) != (ssize_t)sizeof(slots)) {
+                cominitErrnoPrint("Could not read \'%s\'", device);
+            } else {
+                cominitTpmBlob_t current = {0};
+                cominitTpmBlob_t next = *blob;
+                int newest = cominitTpmBlobRawPick(&current, slots);
+                int target = (newest == 0) ? 1 : 0;
+                size_t length = 0;
+
+                next.sequence = (newest < 0) ? 1 : (uint16_t)(current.sequence + 1);
+                memset(slots, 0, COMINIT_TPMBLOB_RAW_SLOT_SIZE);
+                if (cominitTpmBlobSerialize(&next, slots, COMINIT_TPMBLOB_RAW_SLOT_SIZE, &length) != EXIT_SUCCESS) {
+                    cominitErrPrint("Sealed blob does not fit into a copy on \'%s\'", device);
+                } else {
+                    /* The magic Bytes are written last, so an interrupted first save leaves the partition empty */
+                    off_t slotOffset = (off_t)target * COMINIT_TPMBLOB_RAW_SLOT_SIZE;
+                    memset(slots, 0, 4);
+                    if (pwrite(fd, slots, COMINIT_TPMBLOB_RAW_SLOT_SIZE, slotOffset) != COMINIT_TPMBLOB_RAW_SLOT_SIZE ||
+                        fsync(fd) != 0 || pwrite(fd, COMINIT_TPMBLOB_MAGIC, 4, slotOffset) != 4) {
+                        cominitErrnoPrint("Could not write copy %d to \'%s\'", target, device);
+                    } else if (fsync(fd) != 0) {
+                        cominitErrnoPrint("Could not sync \'%s\'", device);
+                    } else {
+                        result = EXIT_SUCCESS;
+                    }
+                }
+            }
+            close(fd);
+        }
+    }
+
+    return result;
+}
+
+/**
+ * Checks whether a response code tells that an NV index is not defined or not written yet.
+ *
+ * @param rc  The response code of Esys_TR_FromTPMPublic() or Esys_NV_Read().
+ *
+ * @return  true if the NV index is empty, false otherwise
+ */
+static inline bool cominitTpmBlobNvEmpty(TSS2_RC rc) {
+    return (rc & ~(TPM2_RC_P | TPM2_RC_N_MASK)) == TPM2_RC_HANDLE || rc == TPM2_RC_NV_UNINITIALIZED;
+}
+
+/**
+ * Reads from an NV index in chunks of #COMINIT_TPMBLOB_NV_CHUNK_SIZE Bytes.
+ *
+ * @param ectx  The Pointer to the initialized ESYS_CONTEXT handle.
+ * @param nvHandle  The ESYS handle of the NV index.
+ * @param buffer  The buffer receiving the data.
+ * @param offset  The offset in the NV index.
+ * @param length  The number of Bytes to read.
+ * @param rc  Pointer to a variable that receives the response code of the failed read, if any.
+ *
+ * @return  EXIT_SUCCESS on success, EXIT_FAILURE otherwise
+ */
+static int cominitTpmBlobNvRead(ESYS_CONTEXT *ectx, ESYS_TR nvHandle, uint8_t *buffer, uint16_t offset, size_t length,
+                                TSS2_RC *rc) {
+    int result = EXIT_SUCCESS;
+
+    while (result == EXIT_SUCCESS && length > 0) {
+        TPM2B_MAX_NV_BUFFER *data = NULL;
+        uint16_t chunk = (length < COMINIT_TPMBLOB_NV_CHUNK_SIZE) ? (uint16_t)length : COMINIT_TPMBLOB_NV_CHUNK_SIZE;
+        *rc = cominitTpmProfileCall(COMINIT_TPM_CMD_NV_READ,
+                                    Esys_NV_Read(ectx, ESYS_TR_RH_OWNER, nvHandle, ESYS_TR_PASSWORD, ESYS_TR_NONE,
+                                                 ESYS_TR_NONE, chunk, offset, &data));
+        if (*rc != TSS2_RC_SUCCESS) {
+            result = EXIT_FAILURE;
+        } else if (data->size != chunk) {
+            cominitErrPrint("Short read from NV index");
+            result = EXIT_FAILURE;
+        } else {
+            memcpy(buffer + offset, data->buffer, chunk);
+            offset += chunk;
+            length -= chunk;
+        }
+        Esys_Free(data);
+    }
+
+    return result;
+}
+
+int cominitTpmBlobNvLoad(ESYS_CONTEXT *ectx, TPM2_HANDLE nvIndex, cominitTpmBlob_t *blob, bool *empty) {
+    int result = EXIT_FAILURE;
+    uint8_t buffer[COMINIT_TPMBLOB_NV_SIZE];
+    ESYS_TR nvHandle = ESYS_TR_NONE;
+
+    if (ectx == NULL || blob == NULL || empty == NULL) {
+        cominitErrPrint("Invalid parameters");
+    } else {
+        TSS2_RC rc = cominitTpmProfileCall(
+            COMINIT_TPM_CMD_READ_PUBLIC,
+            Esys_TR_FromTPMPublic(ectx, nvIndex, ESYS_TR_NONE, ESYS_TR_NONE, ESYS_TR_NONE, &nvHandle));
+        if (rc == TSS2_RC_SUCCESS) {
+            size_t length = COMINIT_TPMBLOB_NV_CHUNK_SIZE;
+            if (cominitTpmBlobNvRead(ectx, nvHandle, buffer, 0, length, &rc) == EXIT_SUCCESS) {
+                /* Only read the remainder if the blob does not fit into the first chunk */
+                size_t total = COMINIT_TPMBLOB_HEADER_SIZE + (size_t)cominitTpmBlobGet32(buffer + 8) +
+                               COMINIT_TPMBLOB_CRC_SIZE;
+                if (memcmp(buffer, COMINIT_TPMBLOB_MAGIC, 4) != 0 || total > sizeof(buffer)) {
+                    /* Sealing again would replace the key of an existing Secure Storage */
+                    cominitErrPrint("NV index 0x%08x holds no valid sealed blob", nvIndex);
+                } else if (total <= length ||
+                           cominitTpmBlobNvRead(ectx, nvHandle, buffer, (uint16_t)length, total - length, &rc) ==
+                               EXIT_SUCCESS) {
+                    *empty = false;
+                    result = cominitTpmBlobDeserialize(blob, buffer, total);
+                }
+            }
+        }
+
+        if (rc != TSS2_RC_SUCCESS) {
+            if (cominitTpmBlobNvEmpty(rc)) {
+                *empty = true;
+                result = EXIT_SUCCESS;
+            } else {
+                cominitErrPrint("Could not read NV index 0x%08x: 0x%x", nvIndex, rc);
+            }
+        }
+
+        if (nvHandle != ESYS_TR_NONE) {
+            Esys_TR_Close(ectx, &nvHandle);
+        }
+    }
+
+    return result;
+}
+
+int cominitTpmBlobNvSave(ESYS_CONTEXT *ectx, TPM2_HANDLE nvIndex, const cominitTpmBlob_t *blob) {
+    int result = EXIT_FAILURE;
+    uint8_t buffer[COMINIT_TPMBLOB_NV_SIZE];
+    size_t length = 0;
+    ESYS_TR nvHandle = ESYS_TR_NONE;
+
+    if (ectx == NULL || blob == NULL) {
+        cominitErrPrint("Invalid parameters");
+    } else if (cominitTpmBlobSerialize(blob, buffer, sizeof(buffer), &length) != EXIT_SUCCESS) {
+        cominitErrPrint("Sealed blob does not fit into NV index 0x%08x", nvIndex);
+    } else {
+        uint8_t magic[4] = {0};
+        bool firstSave = true;
+        TSS2_RC rc = cominitTpmProfileCall(
+            COMINIT_TPM_CMD_READ_PUBLIC,
+            Esys_TR_FromTPMPublic(ectx, nvIndex, ESYS_TR_NONE, ESYS_TR_NONE, ESYS_TR_NONE, &nvHandle));
+        if (rc == TSS2_RC_SUCCESS) {
+            TSS2_RC readRc = TSS2_RC_SUCCESS;
+            if (cominitTpmBlobNvRead(ectx, nvHandle, magic, 0, sizeof(magic), &readRc) == EXIT_SUCCESS) {
+                firstSave = (memcmp(magic, COMINIT_TPMBLOB_MAGIC, sizeof(magic)) != 0);
+            }
+        } else {
+            TPM2B_AUTH auth = {.size = 0};
+            TPM2B_NV_PUBLIC publicInfo = {
+                .size = 0,
+                .nvPublic = {
+                    .nvIndex = nvIndex,
+                    .nameAlg = TPM2_ALG_SHA256,
+                    .attributes = (TPMA_NV_OWNERWRITE | TPMA_NV_OWNERREAD | TPMA_NV_WRITE_STCLEAR | TPMA_NV_NO_DA),
+                    .authPolicy = {.size = 0},
+                    .dataSize = COMINIT_TPMBLOB_NV_SIZE,
+                }};
+            nvHandle = ESYS_TR_NONE;
+            rc = cominitTpmProfileCall(COMINIT_TPM_CMD_NV_DEFINE_SPACE,
+                                       Esys_NV_DefineSpace(ectx, ESYS_TR_RH_OWNER, ESYS_TR_PASSWORD, ESYS_TR_NONE,
+                                                           ESYS_TR_NONE, &auth, &publicInfo, &nvHandle));
+            if (rc != TSS2_RC_SUCCESS) {
+                cominitErrPrint("Could not define NV index 0x%08x: 0x%x", nvIndex, rc);
+            }
+        }
+
+        /*
+         * Updating a single NV index is not atomic. On the first save the magic Bytes are written last, so an
+         * interrupted first save never reads back as a partially written blob. Either leaves an invalid blob.
+         */
+        if (firstSave) {
+            memset(buffer, 0, 4);
+        }
+        size_t offset = 0;
+        while (rc == TSS2_RC_SUCCESS && offset < length) {
+            TPM2B_MAX_NV_BUFFER data = {.size = 0};
+            data.size = (length - offset < COMINIT_TPMBLOB_NV_CHUNK_SIZE) ? (uint16_t)(length - offset)
+                                                                          : COMINIT_TPMBLOB_NV_CHUNK_SIZE;
+            memcpy(data.buffer, buffer + offset, data.size);
+            rc = cominitTpmProfileCall(COMINIT_TPM_CMD_NV_WRITE,
+                                       Esys_NV_Write(ectx, ESYS_TR_RH_OWNER, nvHandle, ESYS_TR_PASSWORD, ESYS_TR_NONE,
+                                                     ESYS_TR_NONE, &data, (uint16_t)offset));
+            if (rc != TSS2_RC_SUCCESS) {
+                cominitErrPrint("Could not write NV index 0x%08x: 0x%x", nvIndex, rc);
+            }
+            offset += data.size;
+        }
+        if (rc == TSS2_RC_SUCCESS && firstSave) {
+            TPM2B_MAX_NV_BUFFER data = {.size = 4};
+            memcpy(data.buffer, COMINIT_TPMBLOB_MAGIC, data.size);
+            rc = cominitTpmProfileCall(COMINIT_TPM_CMD_NV_WRITE,
+                                       Esys_NV_Write(ectx, ESYS_TR_RH_OWNER, nvHandle, ESYS_TR_PASSWORD, ESYS_TR_NONE,
+                                                     ESYS_TR_NONE, &data, 0));
+            if (rc != TSS2_RC_SUCCESS) {
+                cominitErrPrint("Could not write NV index 0x%08x: 0x%x", nvIndex, rc);
+            }
+        }
+
+        if (rc == TSS2_RC_SUCCESS) {
+            result = EXIT_SUCCESS;
+        }
+        if (nvHandle != ESYS_TR_NONE) {
+            Esys_TR_Close(ectx, &nvHandle);
+        }
+    }
+
+    return result;
+}
+
+int cominitTpmBlobNvLock(ESYS_CONTEXT *ectx, TPM2_HANDLE nvIndex) {
+    int result = EXIT_FAILURE;
+    ESYS_TR nvHandle = ESYS_TR_NONE;
+
+    if (ectx == NULL) {
+        cominitErrPrint("Invalid parameters");
+    } else {
+        TSS2_RC rc = cominitTpmProfileCall(
+            COMINIT_TPM_CMD_READ_PUBLIC,
+            Esys_TR_FromTPMPublic(ectx, nvIndex, ESYS_TR_NONE, ESYS_TR_NONE, ESYS_TR_NONE, &nvHandle));
+        if (rc == TSS2_RC_SUCCESS) {
+            rc = cominitTpmProfileCall(COMINIT_TPM_CMD_NV_WRITE_LOCK,
+                                       Esys_NV_WriteLock(ectx, ESYS_TR_RH_OWNER, nvHandle, ESYS_TR_PASSWORD,
+                                                         ESYS_TR_NONE, ESYS_TR_NONE));
+        }
+
+        if (rc == TSS2_RC_SUCCESS) {
+            result = EXIT_SUCCESS;
+        } else if (cominitTpmBlobNvEmpty(rc)) {
+            /* Nothing was saved, e.g. because sealing failed */
+            result = EXIT_SUCCESS;
+        } else if ((rc & ~(TPM2_RC_P | TPM2_RC_N_MASK)) == TPM2_RC_ATTRIBUTES) {
+            cominitWarnPrint("NV index 0x%08x was defined without TPMA_NV_WRITE_STCLEAR and stays writable", nvIndex);
+            result = EXIT_SUCCESS;
+        } else {
+            cominitErrPrint("Could not write-lock NV index 0x%08x: 0x%x", nvIndex, rc);
+        }
+
+        if (nvHandle != ESYS_TR_NONE) {
+            Esys_TR_Close(ectx, &nvHandle);
+        }
+    }
+
+    return result;
+}
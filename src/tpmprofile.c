@@ -0,0 +1,100 @@
+// SPDX-License-Identifier: MIT
+/**
+ * @file tpmprofile.c
+ * @brief Implementation of the latency profiling of TPM commands.
+ */
+#include "tpmprofile.h"
+
+#include <time.h>
+
+#include "output.h"
+
+/**
+ * Names of the profiled commands as used in the TPM specification.
+ */
+static const char *const cominitTpmProfileNames[COMINIT_TPM_CMD_COUNT] = {
+    [COMINIT_TPM_CMD_SELFTEST] = "SelfTest",
+    [COMINIT_TPM_CMD_INCREMENTAL_SELFTEST] = "IncrementalSelfTest",
+    [COMINIT_TPM_CMD_GET_TEST_RESULT] = "GetTestResult",
+    [COMINIT_TPM_CMD_CREATE_PRIMARY] = "CreatePrimary",
+    [COMINIT_TPM_CMD_EVICT_CONTROL] = "EvictControl",
+    [COMINIT_TPM_CMD_READ_PUBLIC] = "ReadPublic",
+    [COMINIT_TPM_CMD_CREATE] = "Create",
+    [COMINIT_TPM_CMD_LOAD] = "Load",
+    [COMINIT_TPM_CMD_START_AUTH_SESSION] = "StartAuthSession",
+    [COMINIT_TPM_CMD_POLICY_PCR] = "PolicyPCR",
+    [COMINIT_TPM_CMD_UNSEAL] = "Unseal",
+    [COMINIT_TPM_CMD_PCR_READ] = "PCR_Read",
+    [COMINIT_TPM_CMD_PCR_EXTEND] = "PCR_Extend",
+    [COMINIT_TPM_CMD_GET_CAPABILITY] = "GetCapability",
+    [COMINIT_TPM_CMD_FLUSH_CONTEXT] = "FlushContext",
+    [COMINIT_TPM_CMD_NV_DEFINE_SPACE] = "NV_DefineSpace",
+    [COMINIT_TPM_CMD_NV_READ] = "NV_Read",
+    [COMINIT_TPM_CMD_NV_WRITE] = "NV_Write",
+    [COMINIT_TPM_CMD_NV_WRITE_LOCK] = "NV_WriteLock",
+};
+
+static cominitTpmProfileEntry_t cominitTpmProfileEntries[COMINIT_TPM_CMD_COUNT];
+static uint64_t cominitTpmProfileStart[COMINIT_TPM_CMD_COUNT];
+
+/**
+ * Reads the monotonic clock.
+ *
+ * @return  The current time in nanoseconds
+ */
+static inline uint64_t cominitTpmProfileNow(void) {
+    struct timespec t;
+
+    clock_gettime(CLOCK_MONOTONIC, &t);
+    return (uint64_t)t.tv_sec * 1000000000ULL + (uint64_t)t.tv_nsec;
+}
+
+void cominitTpmProfileBegin(cominitTpmCommand_t cmd) {
+    if (cmd < COMINIT_TPM_CMD_COUNT) {
+        cominitTpmProfileStart[cmd] = cominitTpmProfileNow();
+    }
+}
+
+TSS2_RC cominitTpmProfileEnd(cominitTpmCommand_t cmd, TSS2_RC rc) {
+    if (cmd < COMINIT_TPM_CMD_COUNT) {
+        uint64_t elapsed = cominitTpmProfileNow() - cominitTpmProfileStart[cmd];
+        cominitTpmProfileEntry_t *entry = &cominitTpmProfileEntries[cmd];
+
+        entry->count++;
+        entry->totalNs += elapsed;
+        if (elapsed > entry->maxNs) {
+            entry->maxNs = elapsed;
+        }
+        if (rc != TSS2_RC_SUCCESS) {
+            entry->failed++;
+            entry->lastRc = rc;
+        }
+    }
+
+    return rc;
+}
+
+const cominitTpmProfileEntry_t *cominitTpmProfileGet(cominitTpmCommand_t cmd) {
+    const cominitTpmProfileEntry_t *entry = NULL;
+
+    if (cmd < COMINIT_TPM_CMD_COUNT) {
+        entry = &cominitTpmProfileEntries[cmd];
+    }
+
+    return entry;
+}
+
+void cominitTpmProfileReport(void) {
+    uint64_t totalNs = 0;
+
+    for (int cmd = 0; cmd < COMINIT_TPM_CMD_COUNT; cmd++) {
+        const cominitTpmProfileEntry_t *entry = &cominitTpmProfileEntries[cmd];
+        if (entry->count > 0) {
+            cominitInfoPrint("TPM profile: %-19s calls %3u total %8llu us max %8llu us failed %u (last rc 0x%x)",
+                             cominitTpmProfileNames[cmd], entry->count, (unsigned long long)(entry->totalNs / 1000),
+                             (unsigned long long)(entry->maxNs / 1000), entry->failed, entry->lastRc);
+            totalNs += entry->totalNs;
+        }
+    }
+    cominitInfoPrint("TPM profile: %llu us spent in TPM commands", (unsigned long long)(totalNs / 1000));
+}
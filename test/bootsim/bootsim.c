@@ -0,0 +1,445 @@
+// SPDX-License-Identifier: MIT
+/**
+ * @file bootsim.c
+ * @brief Unprivileged simulation of the cominit rootfs discovery, metadata verification and device mapper table
+ * generation over synthetic GPT disk images.
+ */
+#include <endian.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include "automount.h"
+#include "blockdev.h"
+#include "common.h"
+#include "meta.h"
+#include "output.h"
+#include "stats.h"
+
+#define COMINIT_BOOTSIM_DEFAULT_IMAGES 1000  ///< Number of images if not given on the command line.
+#define COMINIT_BOOTSIM_DEFAULT_DECOYS 3     ///< Number of decoy images next to each rootfs image.
+#define COMINIT_BOOTSIM_BLOCK_SIZE 512       ///< Logical block size of the images.
+#define COMINIT_BOOTSIM_ENTRIES_LBA 2        ///< First LBA of the partition entry array.
+#define COMINIT_BOOTSIM_ENTRY_COUNT 128      ///< Number of partition entries.
+#define COMINIT_BOOTSIM_FIRST_USABLE_LBA 34  ///< First LBA after the partition entry array.
+#define COMINIT_BOOTSIM_PART_BLOCKS 2048     ///< Size of each partition in blocks (1 MiB).
+#define COMINIT_BOOTSIM_DATA_LBA 2048        ///< First LBA of the data partition in front of the rootfs.
+#define COMINIT_BOOTSIM_ROOTFS_LBA (COMINIT_BOOTSIM_DATA_LBA + COMINIT_BOOTSIM_PART_BLOCKS)  ///< First rootfs LBA.
+/** Number of blocks of an image, including the space a backup GPT would take. **/
+#define COMINIT_BOOTSIM_DISK_BLOCKS (COMINIT_BOOTSIM_ROOTFS_LBA + COMINIT_BOOTSIM_PART_BLOCKS + 33)
+#define COMINIT_BOOTSIM_DECOY_SIZE (64 * 1024)  ///< Size of a decoy image without GPT.
+#define COMINIT_BOOTSIM_DATA_GUID_TYPE "0fc63daf-8483-4772-8e79-3d69d8477de4"  ///< Linux filesystem data partition.
+
+/**
+ * The measured steps of one simulated boot.
+ */
+typedef enum {
+    BootsimDiscover = 0,  ///< cominitAutomountFindPartition(): scan of the disks for the rootfs partition.
+    BootsimVerify,        ///< cominitLoadVerifyMetadata(): metadata read, signature check and dm table generation.
+    BootsimTotal,         ///< Both steps.
+    BootsimStepCount,     ///< The number of steps.
+} cominitBootsimStep_t;
+
+/**
+ * Names of the steps in the report, indexed by cominitBootsimStep_t.
+ */
+static const char *cominitBootsimStepNames[BootsimStepCount] = {
+    "discover",
+    "verify+dm-table",
+    "total",
+};
+
+/**
+ * A GPT partition entry as defined by the UEFI specification.
+ */
+typedef struct {
+    uint8_t typeGuid[16];    ///< Partition type GUID.
+    uint8_t uniqueGuid[16];  ///< Unique partition GUID.
+    uint64_t firstLba;       ///< First LBA of the partition.
+    uint64_t lastLba;        ///< Last LBA of the partition, inclusive.
+    uint64_t attributes;     ///< Attribute flags.
+    uint16_t name[36];       ///< UTF-16LE partition name.
+} __attribute__((packed)) cominitBootsimGptEntry_t;
+
+/**
+ * The percentiles of the durations in the report, minimum, median, 95th and 99th percentile and maximum.
+ */
+static const unsigned int cominitBootsimPercentiles[] = {0, 50, 95, 99, 100};
+
+/**
+ * Converts a GUID in canonical text form into its mixed-endian on-disk form.
+ *
+ * @param guid  The GUID string.
+ * @param raw   Buffer receiving the 16 bytes.
+ */
+static void cominitBootsimParseGuid(const char *guid, uint8_t raw[16]) {
+    static const int order[16] = {3, 2, 1, 0, 5, 4, 7, 6, 8, 9, 10, 11, 12, 13, 14, 15};
+    size_t pos = 0;
+
+    for (size_t i = 0; i < 16; i++) {
+        if (guid[pos] == '-') {
+            pos++;
+        }
+        unsigned int byte = 0;
+        sscanf(guid + pos, "%2x", &byte);
+        raw[order[i]] = (uint8_t)byte;
+        pos += 2;
+    }
+}
+
+/**
+ * Writes a GPT with the given partitions to an image.
+ *
+ * @param fd       The image opened for writing.
+ * @param entries  The partition entries, the remaining entries are left empty.
+ * @param count    The number of entries in \a entries.
+ * @param index    Number of the image, used to make the disk GUID unique.
+ *
+ * @return  EXIT_SUCCESS on success, EXIT_FAILURE otherwise
+ */
+static int cominitBootsimWriteGpt(int fd, const cominitBootsimGptEntry_t *entries, size_t count, unsigned long index) {
+    cominitBootsimGptEntry_t table[COMINIT_BOOTSIM_ENTRY_COUNT] = {0};
+    cominitGPTHeader_t hdr = {0};
+
+    memcpy(table, entries, count * sizeof(*entries));
+
+    memcpy(hdr.signature, "EFI PART", sizeof(hdr.signature));
+    hdr.revision = htole32(0x00010000);
+    hdr.headerSize = htole32(sizeof(hdr));
+    hdr.currentLba = htole64(1);
+    hdr.backupLba = htole64(COMINIT_BOOTSIM_DISK_BLOCKS - 1);
+    hdr.firstUsableLba = htole64(COMINIT_BOOTSIM_FIRST_USABLE_LBA);
+    hdr.lastUsableLba = htole64(COMINIT_BOOTSIM_DISK_BLOCKS - COMINIT_BOOTSIM_FIRST_USABLE_LBA);
+    memcpy(hdr.diskGuid, &index, sizeof(index));
+    hdr.partitionEntriesLba = htole64(COMINIT_BOOTSIM_ENTRIES_LBA);
+    hdr.partitionEntryCount = htole32(COMINIT_BOOTSIM_ENTRY_COUNT);
+    hdr.partitionEntrySize = htole32(sizeof(cominitBootsimGptEntry_t));
+    hdr.partitionEntriesCrc32 = htole32(cominitCommonCrc32((const uint8_t *)table, sizeof(table)));
+    hdr.headerCrc32 = htole32(cominitCommonCrc32((const uint8_t *)&hdr, sizeof(hdr)));
+
+    if (pwrite(fd, &hdr, sizeof(hdr), COMINIT_BOOTSIM_BLOCK_SIZE) != (ssize_t)sizeof(hdr) ||
+        pwrite(fd, table, sizeof(table), COMINIT_BOOTSIM_ENTRIES_LBA * COMINIT_BOOTSIM_BLOCK_SIZE) !=
+            (ssize_t)sizeof(table)) {
+        perror("Writing GPT failed");
+        return EXIT_FAILURE;
+    }
+
+    return EXIT_SUCCESS;
+}
+
+/**
+ * Creates a sparse image file.
+ *
+ * @param path  The path of the image.
+ * @param size  The size of the image in bytes.
+ *
+ * @return  The file descriptor opened for writing on success, -1 otherwise
+ */
+static int cominitBootsimCreateImage(const char *path, off_t size) {
+    int fd = open(path, O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC, 0600);
+
+    if (fd < 0) {
+        fprintf(stderr, "Could not create '%s': %s\n", path, strerror(errno));
+    } else if (ftruncate(fd, size) != 0) {
+        fprintf(stderr, "Could not resize '%s': %s\n", path, strerror(errno));
+        close(fd);
+        fd = -1;
+    }
+
+    return fd;
+}
+
+/**
+ * Creates the directory of one simulated boot with a rootfs image and decoy images.
+ *
+ * The rootfs image holds a data partition followed by the rootfs partition, which ends with \a metadata. Even decoys
+ * have no GPT, odd decoys have a GPT with only a data partition, so discovery has to read their partition entries.
+ *
+ * @param dir           The directory to create.
+ * @param index         Number of the simulated boot, used to make the GUIDs unique.
+ * @param decoys        The number of decoy images.
+ * @param metadata      The signed metadata region.
+ * @param metadataSize  The size of \a metadata, at most #COMINIT_PART_META_DATA_SIZE.
+ *
+ * @return  EXIT_SUCCESS on success, EXIT_FAILURE otherwise
+ */
+static int cominitBootsimCreateBoot(const char *dir, unsigned long index, unsigned long decoys, const uint8_t *metadata,
+                                    size_t metadataSize) {
+    char path[COMINIT_ROOTFS_DEV_PATH_MAX];
+    cominitBootsimGptEntry_t entries[2] = {0};
+
+    if (mkdir(dir, 0700) != 0) {
+        fprintf(stderr, "Could not create '%s': %s\n", dir, strerror(errno));
+        return EXIT_FAILURE;
+    }
+
+    cominitBootsimParseGuid(COMINIT_BOOTSIM_DATA_GUID_TYPE, entries[0].typeGuid);
+    memcpy(entries[0].uniqueGuid, &index, sizeof(index));
+    entries[0].uniqueGuid[15] = 1;
+    entries[0].firstLba = htole64(COMINIT_BOOTSIM_DATA_LBA);
+    entries[0].lastLba = htole64(COMINIT_BOOTSIM_DATA_LBA + COMINIT_BOOTSIM_PART_BLOCKS - 1);
+    cominitBootsimParseGuid(COMINIT_ROOTFS_GUID_TYPE, entries[1].typeGuid);
+    memcpy(entries[1].uniqueGuid, &index, sizeof(index));
+    entries[1].uniqueGuid[15] = 2;
+    entries[1].firstLba = htole64(COMINIT_BOOTSIM_ROOTFS_LBA);
+    entries[1].lastLba = htole64(COMINIT_BOOTSIM_ROOTFS_LBA + COMINIT_BOOTSIM_PART_BLOCKS - 1);
+
+    for (unsigned long d = 0; d < decoys; d++) {
+        snprintf(path, sizeof(path), "%s/decoy%lu.img", dir, d);
+        bool hasGpt = (d % 2) == 1;
+        int fd = cominitBootsimCreateImage(
+            path, hasGpt ? COMINIT_BOOTSIM_DISK_BLOCKS * COMINIT_BOOTSIM_BLOCK_SIZE : COMINIT_BOOTSIM_DECOY_SIZE);
+        if (fd < 0) {
+            return EXIT_FAILURE;
+        }
+        int result = hasGpt ? cominitBootsimWriteGpt(fd, entries, 1, index) : EXIT_SUCCESS;
+        close(fd);
+        if (result != EXIT_SUCCESS) {
+            return EXIT_FAILURE;
+        }
+    }
+
+    snprintf(path, sizeof(path), "%s/disk.img", dir);
+    int fd = cominitBootsimCreateImage(path, COMINIT_BOOTSIM_DISK_BLOCKS * COMINIT_BOOTSIM_BLOCK_SIZE);
+    if (fd < 0) {
+        return EXIT_FAILURE;
+    }
+    int result = cominitBootsimWriteGpt(fd, entries, 2, index);
+    off_t metaOffset = (COMINIT_BOOTSIM_ROOTFS_LBA + COMINIT_BOOTSIM_PART_BLOCKS) * COMINIT_BOOTSIM_BLOCK_SIZE -
+                       COMINIT_PART_META_DATA_SIZE;
+    if (result == EXIT_SUCCESS && pwrite(fd, metadata, metadataSize, metaOffset) != (ssize_t)metadataSize) {
+        perror("Writing metadata failed");
+        result = EXIT_FAILURE;
+    }
+    close(fd);
+
+    return result;
+}
+
+/**
+ * Removes the directory of one simulated boot created by cominitBootsimCreateBoot().
+ *
+ * @param dir     The directory.
+ * @param decoys  The number of decoy images.
+ */
+static void cominitBootsimRemoveBoot(const char *dir, unsigned long decoys) {
+    char path[COMINIT_ROOTFS_DEV_PATH_MAX];
+
+    for (unsigned long d = 0; d < decoys; d++) {
+        snprintf(path, sizeof(path), "%s/decoy%lu.img", dir, d);
+        unlink(path);
+    }
+    snprintf(path, sizeof(path), "%s/disk.img", dir);
+    unlink(path);
+    rmdir(dir);
+}
+
+/**
+ * Runs one simulated boot: finds the rootfs partition in \a dir, then loads, verifies and parses its metadata.
+ *
+ * @param dir      The directory holding the images.
+ * @param keyfile  The public key PEM file to verify the metadata with.
+ * @param samples  Array receiving the duration of each step in nanoseconds.
+ *
+ * @return  EXIT_SUCCESS if the rootfs was found and a device mapper table generated, EXIT_FAILURE otherwise
+ */
+static int cominitBootsimBoot(const char *dir, const char *keyfile, uint64_t samples[BootsimStepCount]) {
+    int result = EXIT_FAILURE;
+    cominitGPTDisk_t disk = {0};
+    static cominitRfsMetaData_t meta;
+
+    cominitBlockdevImageSetDir(dir);
+    memset(&meta, 0, sizeof(meta));
+
+    uint64_t start = cominitStatsNow();
+    if (cominitAutomountFindPartition(&disk, COMINIT_ROOTFS_GUID_TYPE, meta.devicePath, sizeof(meta.devicePath)) !=
+        EXIT_SUCCESS) {
+        fprintf(stderr, "No rootfs partition found in '%s'\n", dir);
+    } else {
+        uint64_t found = cominitStatsNow();
+        samples[BootsimDiscover] = found - start;
+        if (cominitLoadVerifyMetadata(&meta, keyfile) != 0) {
+            fprintf(stderr, "Metadata of '%s' could not be verified\n", meta.devicePath);
+        } else if (meta.dmTableVerint[0] != '\0' && strstr(meta.dmTableVerint, meta.devicePath) == NULL) {
+            fprintf(stderr, "Device mapper table of '%s' does not refer to the partition\n", meta.devicePath);
+        } else {
+            uint64_t end = cominitStatsNow();
+            samples[BootsimVerify] = end - found;
+            samples[BootsimTotal] = end - start;
+            result = EXIT_SUCCESS;
+        }
+    }
+
+    return result;
+}
+
+/**
+ * Prints throughput and minimum, median, 95th and 99th percentile and maximum of the durations of each step.
+ *
+ * @param samples  The durations in nanoseconds, \a count per step.
+ * @param count    The number of simulated boots.
+ * @param elapsed  The wall clock time of all boots in nanoseconds.
+ */
+static void cominitBootsimReport(uint64_t *samples[BootsimStepCount], size_t count, uint64_t elapsed) {
+    printf("%zu boots in %.3f s, %.1f boots/s\n", count, (double)elapsed / 1e9,
+           (double)count * 1e9 / (double)(elapsed > 0 ? elapsed : 1));
+    cominitStatsPrintHeader("step [us]", 16, cominitBootsimPercentiles, ARRAY_SIZE(cominitBootsimPercentiles));
+    for (size_t s = 0; s < BootsimStepCount; s++) {
+        cominitStatsPrintRow(cominitBootsimStepNames[s], 16, samples[s], count, cominitBootsimPercentiles,
+                             ARRAY_SIZE(cominitBootsimPercentiles));
+    }
+}
+
+/**
+ * Reads the signed metadata region from a file.
+ *
+ * @param path  The path of the file.
+ * @param buf   Buffer of #COMINIT_PART_META_DATA_SIZE bytes receiving the metadata.
+ *
+ * @return  The number of bytes read on success, 0 otherwise
+ */
+static size_t cominitBootsimReadMetadata(const char *path, uint8_t *buf) {
+    size_t len = 0;
+    FILE *f = fopen(path, "rb");
+
+    if (f == NULL) {
+        fprintf(stderr, "Could not open '%s': %s\n", path, strerror(errno));
+    } else {
+        len = fread(buf, 1, COMINIT_PART_META_DATA_SIZE, f);
+        if (len == 0 || fgetc(f) != EOF) {
+            fprintf(stderr, "'%s' must hold between 1 and %d bytes\n", path, COMINIT_PART_META_DATA_SIZE);
+            len = 0;
+        }
+        fclose(f);
+    }
+
+    return len;
+}
+
+/**
+ * Prints the usage of the simulator to stderr.
+ *
+ * @param name  The name of the executable.
+ */
+static void cominitBootsimUsage(const char *name) {
+    fprintf(stderr,
+            "USAGE: %s -k <public key PEM> -m <signed metadata> [-n <boots>] [-d <decoys>] [-w <directory>]\n"
+            "       Creates <boots> (default %d) directories in a temporary directory below <directory> (default\n"
+            "       $TMPDIR or /tmp), each with a GPT disk image holding a rootfs partition that ends with the\n"
+            "       given metadata region and <decoys> (default %d) images without a rootfs partition. For each\n"
+            "       directory it runs the rootfs discovery, metadata verification and device mapper table generation\n"
+            "       of cominit and reports throughput and latency. The images are removed afterwards.\n",
+            name, COMINIT_BOOTSIM_DEFAULT_IMAGES, COMINIT_BOOTSIM_DEFAULT_DECOYS);
+}
+
+/**
+ * Main function of the boot pipeline simulator.
+ *
+ * @return  EXIT_SUCCESS if all simulated boots succeeded, EXIT_FAILURE otherwise
+ */
+int main(int argc, char *argv[]) {
+    int result = EXIT_SUCCESS;
+    const char *keyfile = NULL;
+    const char *metafile = NULL;
+    const char *workdir = getenv("TMPDIR");
+    unsigned long boots = COMINIT_BOOTSIM_DEFAULT_IMAGES;
+    unsigned long decoys = COMINIT_BOOTSIM_DEFAULT_DECOYS;
+    uint64_t *samples[BootsimStepCount] = {NULL};
+    static uint8_t metadata[COMINIT_PART_META_DATA_SIZE];
+    int opt;
+
+    while ((opt = getopt(argc, argv, "k:m:n:d:w:h")) != -1) {
+        switch (opt) {
+            case 'k':
+                keyfile = optarg;
+                break;
+            case 'm':
+                metafile = optarg;
+                break;
+            case 'n':
+                boots = strtoul(optarg, NULL, 10);
+                break;
+            case 'd':
+                decoys = strtoul(optarg, NULL, 10);
+                break;
+            case 'w':
+                workdir = optarg;
+                break;
+            case 'h':
+            default:
+                result = EXIT_FAILURE;
+                break;
+        }
+    }
+
+    if (result != EXIT_SUCCESS || keyfile == NULL || metafile == NULL || boots == 0) {
+        cominitBootsimUsage(argv[0]);
+        return EXIT_FAILURE;
+    }
+
+    size_t metadataSize = cominitBootsimReadMetadata(metafile, metadata);
+    if (metadataSize == 0) {
+        return EXIT_FAILURE;
+    }
+
+    char root[COMINIT_ROOTFS_DEV_PATH_MAX / 2];
+    char dir[COMINIT_ROOTFS_DEV_PATH_MAX];
+    snprintf(root, sizeof(root), "%s/cominit-sim-XXXXXX", (workdir != NULL) ? workdir : "/tmp");
+    if (mkdtemp(root) == NULL) {
+        fprintf(stderr, "Could not create a directory in '%s': %s\n", (workdir != NULL) ? workdir : "/tmp",
+                strerror(errno));
+        return EXIT_FAILURE;
+    }
+
+    cominitOutputSetVisibleLogLevel(COMINIT_LOG_LEVEL_ERR);
+
+    for (size_t s = 0; s < BootsimStepCount && result == EXIT_SUCCESS; s++) {
+        samples[s] = calloc(boots, sizeof(uint64_t));
+        if (samples[s] == NULL) {
+            perror("calloc failed");
+            result = EXIT_FAILURE;
+        }
+    }
+
+    unsigned long created = 0;
+    for (; created < boots && result == EXIT_SUCCESS; created++) {
+        snprintf(dir, sizeof(dir), "%s/%05lu", root, created);
+        result = cominitBootsimCreateBoot(dir, created, decoys, metadata, metadataSize);
+    }
+
+    size_t done = 0;
+    uint64_t start = cominitStatsNow();
+    for (; done < boots && result == EXIT_SUCCESS; done++) {
+        uint64_t bootSamples[BootsimStepCount] = {0};
+        snprintf(dir, sizeof(dir), "%s/%05zu", root, done);
+        result = cominitBootsimBoot(dir, keyfile, bootSamples);
+        for (size_t s = 0; s < BootsimStepCount && result == EXIT_SUCCESS; s++) {
+            samples[s][done] = bootSamples[s];
+        }
+    }
+    uint64_t elapsed = cominitStatsNow() - start;
+
+    if (result == EXIT_SUCCESS) {
+        printf("%zu images with %lu decoys each in '%s'\n", done, decoys, root);
+        cominitBootsimReport(samples, done, elapsed);
+    } else if (created == boots) {
+        fprintf(stderr, "Boot %zu failed\n", done);
+    }
+
+    for (unsigned long i = 0; i < created; i++) {
+        snprintf(dir, sizeof(dir), "%s/%05lu", root, i);
+        cominitBootsimRemoveBoot(dir, decoys);
+    }
+    rmdir(root);
+
+    for (size_t s = 0; s < BootsimStepCount; s++) {
+        free(samples[s]);
+    }
+
+    return result;
+}
@@ -0,0 +1,35 @@
+#!/bin/bash
+# SPDX-License-Identifier: MIT
+#
+# Run cominit-sim with a freshly generated key and signed dm-verity metadata.
+#
+# Usage: run-bootsim.sh <path to cominit-sim> [images] [decoys]
+#
+# The metadata is signed as described in the README. Exits with 77 (skipped) if openssl is not installed.
+#
+set -eu
+
+SIM="${1:?path to cominit-sim required}"
+IMAGES="${2:-1000}"
+DECOYS="${3:-3}"
+
+WORKDIR=$(mktemp -d)
+trap 'rm -rf "${WORKDIR}"' EXIT
+
+if ! command -v openssl >/dev/null; then
+    echo "openssl not found, skipping boot pipeline simulation"
+    exit 77
+fi
+
+openssl genpkey -algorithm RSA -pkeyopt rsa_keygen_bits:4096 -out "${WORKDIR}/rootfs.key" 2>/dev/null
+openssl rsa -pubout < "${WORKDIR}/rootfs.key" > "${WORKDIR}/rootfs_key_pub.pem" 2>/dev/null
+
+ROOT_HASH=$(printf '%064x' 1)
+SALT=$(printf '%064x' 2)
+printf '1 squashfs ro verity\xff1 4096 4096 200 201 sha256 %s %s\xff\0' "${ROOT_HASH}" "${SALT}" \
+    > "${WORKDIR}/data.meta"
+openssl dgst -sha256 -sigopt rsa_padding_mode:pss -sigopt rsa_pss_saltlen:-1 -sigopt rsa_mgf1_md:sha256 \
+    -sign "${WORKDIR}/rootfs.key" -out "${WORKDIR}/sig.meta" "${WORKDIR}/data.meta"
+cat "${WORKDIR}/data.meta" "${WORKDIR}/sig.meta" > "${WORKDIR}/region.meta"
+
+"${SIM}" -k "${WORKDIR}/rootfs_key_pub.pem" -m "${WORKDIR}/region.meta" -n "${IMAGES}" -d "${DECOYS}" -w "${WORKDIR}"
@@ -0,0 +1,249 @@
+// SPDX-License-Identifier: MIT
+/**
+ * @file cryptobench.c
+ * @brief Microbenchmark of the cominit signature verification, key digest and passphrase generation.
+ */
+#include <errno.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+#include "common.h"
+#include "crypto.h"
+#include "cryptsetup.h"
+#include "output.h"
+#include "stats.h"
+
+#define COMINIT_CRYPTOBENCH_DEFAULT_REPETITIONS 100  ///< Number of measured calls if not given on the command line.
+#define COMINIT_CRYPTOBENCH_DEFAULT_WARMUP 10        ///< Number of unmeasured calls before the measured ones.
+#define COMINIT_CRYPTOBENCH_DATA_MAX 4096            ///< Maximum size of the signed data, a full metadata region.
+#define COMINIT_CRYPTOBENCH_SIG_MAX 512              ///< Maximum size of a signature, enough for RSA-4096.
+#define COMINIT_CRYPTOBENCH_NAME_MAX 48              ///< Maximum length of a benchmark name in the report.
+
+/**
+ * The input of one benchmarked call.
+ */
+typedef struct cominitCryptobenchInput {
+    const char *keyfile;                         ///< The public key PEM file.
+    const uint8_t *data;                         ///< The signed data.
+    size_t dataLen;                              ///< The length of cominitCryptobenchInput_t::data.
+    uint8_t signature[COMINIT_CRYPTOBENCH_SIG_MAX];  ///< The RSASSA-PSS signature over the data.
+} cominitCryptobenchInput_t;
+
+/**
+ * A benchmarked function, returns EXIT_SUCCESS if the call had the expected result.
+ */
+typedef int (*cominitCryptobenchFunc_t)(const cominitCryptobenchInput_t *input);
+
+/**
+ * The percentiles of the latencies in the report, minimum, median, 99th percentile and maximum.
+ */
+static const unsigned int cominitCryptobenchPercentiles[] = {0, 50, 99, 100};
+
+/**
+ * Benchmarked call of cominitCryptoVerifySignature(), which parses the key, hashes the data and verifies.
+ */
+static int cominitCryptobenchVerify(const cominitCryptobenchInput_t *input) {
+    return (cominitCryptoVerifySignature(input->data, input->dataLen, input->signature, input->keyfile) == 0)
+               ? EXIT_SUCCESS
+               : EXIT_FAILURE;
+}
+
+/**
+ * Benchmarked call of cominitCreateSHA256DigestfromKeyfile(), as used to measure the key into the TPM.
+ */
+static int cominitCryptobenchKeyDigest(const cominitCryptobenchInput_t *input) {
+    unsigned char digest[SHA256_LEN];
+    return cominitCreateSHA256DigestfromKeyfile(input->keyfile, digest, sizeof(digest));
+}
+
+/**
+ * Benchmarked call of cominitCryptoCreatePassphrase(), which seeds a CTR-DRBG and draws a passphrase.
+ */
+static int cominitCryptobenchPassphrase(const cominitCryptobenchInput_t *input) {
+    unsigned char passphrase[COMINIT_PASSPHRASE_SIZE];
+    COMINIT_PARAM_UNUSED(input);
+    return cominitCryptoCreatePassphrase(passphrase, sizeof(passphrase));
+}
+
+/**
+ * Runs a function \a warmup times unmeasured and \a repetitions times measured and prints minimum, median,
+ * 99th percentile and maximum latency.
+ *
+ * @param name         The name of the benchmark in the report.
+ * @param func         The benchmarked function.
+ * @param input        The input passed to \a func.
+ * @param warmup       The number of unmeasured calls.
+ * @param repetitions  The number of measured calls.
+ * @param samples      Buffer for \a repetitions durations.
+ *
+ * @return  EXIT_SUCCESS if all calls succeeded, EXIT_FAILURE otherwise
+ */
+static int cominitCryptobenchRun(const char *name, cominitCryptobenchFunc_t func,
+                                 const cominitCryptobenchInput_t *input, unsigned long warmup,
+                                 unsigned long repetitions, uint64_t *samples) {
+    for (unsigned long i = 0; i < warmup; i++) {
+        if (func(input) != EXIT_SUCCESS) {
+            fprintf(stderr, "%s failed during warm-up\n", name);
+            return EXIT_FAILURE;
+        }
+    }
+
+    for (unsigned long i = 0; i < repetitions; i++) {
+        uint64_t start = cominitStatsNow();
+        if (func(input) != EXIT_SUCCESS) {
+            fprintf(stderr, "%s failed in repetition %lu\n", name, i);
+            return EXIT_FAILURE;
+        }
+        samples[i] = cominitStatsNow() - start;
+    }
+
+    cominitStatsPrintRow(name, 24, samples, repetitions, cominitCryptobenchPercentiles,
+                         ARRAY_SIZE(cominitCryptobenchPercentiles));
+
+    return EXIT_SUCCESS;
+}
+
+/**
+ * Reads a whole file into a buffer.
+ *
+ * @param path  The path of the file.
+ * @param buf   The buffer.
+ * @param size  The size of \a buf.
+ *
+ * @return  The number of bytes read on success, 0 if the file could not be read, is empty or larger than \a buf
+ */
+static size_t cominitCryptobenchReadFile(const char *path, uint8_t *buf, size_t size) {
+    size_t len = 0;
+    FILE *f = fopen(path, "rb");
+
+    if (f == NULL) {
+        fprintf(stderr, "Could not open '%s': %s\n", path, strerror(errno));
+    } else {
+        len = fread(buf, 1, size, f);
+        if (len == 0 || fgetc(f) != EOF) {
+            fprintf(stderr, "'%s' must hold between 1 and %zu bytes\n", path, size);
+            len = 0;
+        }
+        fclose(f);
+    }
+
+    return len;
+}
+
+/**
+ * Gets the size of the RSA key in a public key PEM file.
+ *
+ * @param keyfile  The public key PEM file.
+ *
+ * @return  The key size in bits, 0 if the file could not be parsed
+ */
+static size_t cominitCryptobenchKeyBits(const char *keyfile) {
+    size_t bits = 0;
+    mbedtls_pk_context pkCtx;
+
+    mbedtls_pk_init(&pkCtx);
+    if (mbedtls_pk_parse_public_keyfile(&pkCtx, keyfile) == 0) {
+        bits = mbedtls_pk_get_bitlen(&pkCtx);
+    }
+    mbedtls_pk_free(&pkCtx);
+
+    return bits;
+}
+
+/**
+ * Prints the usage of the benchmark to stderr.
+ *
+ * @param name  The name of the executable.
+ */
+static void cominitCryptobenchUsage(const char *name) {
+    fprintf(stderr,
+            "USAGE: %s -d <data> [-n <repetitions>] [-w <warm-up>] <public key PEM> <signature> [...]\n"
+            "       Benchmarks cominitCryptoVerifySignature() and cominitCreateSHA256DigestfromKeyfile() for every\n"
+            "       given key and its RSASSA-PSS signature over <data>, and cominitCryptoCreatePassphrase(). Each\n"
+            "       function is called <warm-up> (default %d) times before <repetitions> (default %d) measured\n"
+            "       calls.\n",
+            name, COMINIT_CRYPTOBENCH_DEFAULT_WARMUP, COMINIT_CRYPTOBENCH_DEFAULT_REPETITIONS);
+}
+
+/**
+ * Main function of the crypto benchmark.
+ *
+ * @return  EXIT_SUCCESS if all calls succeeded, EXIT_FAILURE otherwise
+ */
+int main(int argc, char *argv[]) {
+    int result = EXIT_SUCCESS;
+    const char *datafile = NULL;
+    unsigned long repetitions = COMINIT_CRYPTOBENCH_DEFAULT_REPETITIONS;
+    unsigned long warmup = COMINIT_CRYPTOBENCH_DEFAULT_WARMUP;
+    static uint8_t data[COMINIT_CRYPTOBENCH_DATA_MAX];
+    cominitCryptobenchInput_t input = {.data = data};
+    int opt;
+
+    while ((opt = getopt(argc, argv, "d:n:w:h")) != -1) {
+        switch (opt) {
+            case 'd':
+                datafile = optarg;
+                break;
+            case 'n':
+                repetitions = strtoul(optarg, NULL, 10);
+                break;
+            case 'w':
+                warmup = strtoul(optarg, NULL, 10);
+                break;
+            case 'h':
+            default:
+                result = EXIT_FAILURE;
+                break;
+        }
+    }
+
+    if (result != EXIT_SUCCESS || datafile == NULL || repetitions == 0 || optind == argc ||
+        (argc - optind) % 2 != 0) {
+        cominitCryptobenchUsage(argv[0]);
+        return EXIT_FAILURE;
+    }
+
+    input.dataLen = cominitCryptobenchReadFile(datafile, data, sizeof(data));
+    uint64_t *samples = calloc(repetitions, sizeof(uint64_t));
+    if (input.dataLen == 0 || samples == NULL) {
+        free(samples);
+        return EXIT_FAILURE;
+    }
+
+    cominitOutputSetVisibleLogLevel(COMINIT_LOG_LEVEL_ERR);
+
+    printf("mbedTLS %s, %lu repetitions after %lu warm-up calls\n", MBEDTLS_VERSION_STRING, repetitions, warmup);
+    cominitStatsPrintHeader("function [us]", 24, cominitCryptobenchPercentiles,
+                            ARRAY_SIZE(cominitCryptobenchPercentiles));
+
+    for (int i = optind; i < argc && result == EXIT_SUCCESS; i += 2) {
+        char name[COMINIT_CRYPTOBENCH_NAME_MAX];
+        size_t bits = cominitCryptobenchKeyBits(argv[i]);
+        size_t sigLen = cominitCryptobenchReadFile(argv[i + 1], input.signature, sizeof(input.signature));
+        if (bits == 0 || sigLen != (bits + 7) / 8) {
+            fprintf(stderr, "'%s' is no RSA public key or '%s' no signature made with it\n", argv[i], argv[i + 1]);
+            result = EXIT_FAILURE;
+            break;
+        }
+        input.keyfile = argv[i];
+
+        snprintf(name, sizeof(name), "verify-rsa%zu", bits);
+        result = cominitCryptobenchRun(name, cominitCryptobenchVerify, &input, warmup, repetitions, samples);
+        if (result == EXIT_SUCCESS) {
+            snprintf(name, sizeof(name), "key-digest-rsa%zu", bits);
+            result = cominitCryptobenchRun(name, cominitCryptobenchKeyDigest, &input, warmup, repetitions, samples);
+        }
+    }
+
+    if (result == EXIT_SUCCESS) {
+        result =
+            cominitCryptobenchRun("passphrase", cominitCryptobenchPassphrase, &input, warmup, repetitions, samples);
+    }
+
+    free(samples);
+
+    return result;
+}
@@ -0,0 +1,36 @@
+#!/bin/bash
+# SPDX-License-Identifier: MIT
+#
+# Run cominit-bench-crypto with freshly generated 2048, 3072 and 4096 bit keys.
+#
+# Usage: run-cryptobench.sh <path to cominit-bench-crypto> [repetitions] [warm-up]
+#
+# Every key signs the same random data like the rootfs metadata in the README. Exits with 77 (skipped) if openssl is
+# not installed.
+#
+set -eu
+
+BENCH="${1:?path to cominit-bench-crypto required}"
+REPETITIONS="${2:-100}"
+WARMUP="${3:-10}"
+
+WORKDIR=$(mktemp -d)
+trap 'rm -rf "${WORKDIR}"' EXIT
+
+if ! command -v openssl >/dev/null; then
+    echo "openssl not found, skipping crypto benchmark"
+    exit 77
+fi
+
+head -c 1024 /dev/urandom > "${WORKDIR}/data"
+
+ARGS=()
+for BITS in 2048 3072 4096; do
+    openssl genpkey -algorithm RSA -pkeyopt rsa_keygen_bits:${BITS} -out "${WORKDIR}/rsa${BITS}.key" 2>/dev/null
+    openssl rsa -pubout < "${WORKDIR}/rsa${BITS}.key" > "${WORKDIR}/rsa${BITS}_pub.pem" 2>/dev/null
+    openssl dgst -sha256 -sigopt rsa_padding_mode:pss -sigopt rsa_pss_saltlen:-1 -sigopt rsa_mgf1_md:sha256 \
+        -sign "${WORKDIR}/rsa${BITS}.key" -out "${WORKDIR}/rsa${BITS}.sig" "${WORKDIR}/data"
+    ARGS+=("${WORKDIR}/rsa${BITS}_pub.pem" "${WORKDIR}/rsa${BITS}.sig")
+done
+
+"${BENCH}" -d "${WORKDIR}/data" -n "${REPETITIONS}" -w "${WARMUP}" "${ARGS[@]}"
@@ -0,0 +1,19 @@
+// SPDX-License-Identifier: MIT
+/**
+ * @file mock_cominitCryptoDigests.c
+ * @brief Implementation of a mock function for cominitCryptoDigests() using cmocka.
+ */
+#include "mock_cominitCryptoDigests.h"
+
+#include "unit_test.h"
+
+// NOLINTNEXTLINE(readability-identifier-naming)    Rationale: Naming scheme fixed due to linker wrapping.
+int __wrap_cominitCryptoDigests(const uint8_t *data, size_t dataLen, cominitCryptoDigests_t *digests) {
+    check_expected_ptr(data);
+    check_expected(dataLen);
+    assert_non_null(digests);
+    unsigned int algs = digests->algs;
+    check_expected(algs);
+
+    return mock_type(int);
+}
@@ -0,0 +1,23 @@
+// SPDX-License-Identifier: MIT
+/**
+ * @file mock_cominitCryptoDigests.h
+ * @brief Header declaring a mock function for cominitCryptoDigests().
+ */
+#ifndef __MOCK_COMINIT_CRYPTODIGESTS_H__
+#define __MOCK_COMINIT_CRYPTODIGESTS_H__
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include "crypto.h"
+
+/**
+ * Mock function for cominitCryptoDigests().
+ *
+ * Implemented using cmocka. Inputs may be checked and return code set using cmocka API. Otherwise the function is a
+ * no-op.
+ */
+// NOLINTNEXTLINE(readability-identifier-naming)    Rationale: Naming scheme fixed due to linker wrapping.
+int __wrap_cominitCryptoDigests(const uint8_t *data, size_t dataLen, cominitCryptoDigests_t *digests);
+
+#endif /* __MOCK_COMINIT_CRYPTODIGESTS_H__ */
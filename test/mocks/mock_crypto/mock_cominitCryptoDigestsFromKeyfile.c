@@ -0,0 +1,18 @@
+// SPDX-License-Identifier: MIT
+/**
+ * @file mock_cominitCryptoDigestsFromKeyfile.c
+ * @brief Implementation of a mock function for cominitCryptoDigestsFromKeyfile() using cmocka.
+ */
+#include "mock_cominitCryptoDigestsFromKeyfile.h"
+
+#include "unit_test.h"
+
+// NOLINTNEXTLINE(readability-identifier-naming)    Rationale: Naming scheme fixed due to linker wrapping.
+int __wrap_cominitCryptoDigestsFromKeyfile(const char *keyfile, cominitCryptoDigests_t *digests) {
+    assert_non_null(keyfile);
+    assert_non_null(digests);
+    unsigned int algs = digests->algs;
+    check_expected(algs);
+
+    return mock_type(int);
+}
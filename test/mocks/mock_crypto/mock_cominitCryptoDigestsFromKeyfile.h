@@ -0,0 +1,20 @@
+// SPDX-License-Identifier: MIT
+/**
+ * @file mock_cominitCryptoDigestsFromKeyfile.h
+ * @brief Header declaring a mock function for cominitCryptoDigestsFromKeyfile().
+ */
+#ifndef __MOCK_COMINIT_CRYPTODIGESTSFROMKEYFILE_H__
+#define __MOCK_COMINIT_CRYPTODIGESTSFROMKEYFILE_H__
+
+#include "crypto.h"
+
+/**
+ * Mock function for cominitCryptoDigestsFromKeyfile().
+ *
+ * Implemented using cmocka. Inputs may be checked and return code set using cmocka API. Otherwise the function is a
+ * no-op.
+ */
+// NOLINTNEXTLINE(readability-identifier-naming)    Rationale: Naming scheme fixed due to linker wrapping.
+int __wrap_cominitCryptoDigestsFromKeyfile(const char *keyfile, cominitCryptoDigests_t *digests);
+
+#endif /* __MOCK_COMINIT_CRYPTODIGESTSFROMKEYFILE_H__ */
@@ -0,0 +1,21 @@
+// SPDX-License-Identifier: MIT
+/**
+ * @file mock_cominitCryptoHkdfSha256.c
+ * @brief Implementation of a mock function for cominitCryptoHkdfSha256() using cmocka.
+ */
+#include "mock_cominitCryptoHkdfSha256.h"
+
+#include "unit_test.h"
+
+// NOLINTNEXTLINE(readability-identifier-naming)    Rationale: Naming scheme fixed due to linker wrapping.
+int __wrap_cominitCryptoHkdfSha256(const uint8_t *ikm, size_t ikmLen, const uint8_t *info, size_t infoLen, uint8_t *okm,
+                                   size_t okmLen) {
+    check_expected_ptr(ikm);
+    check_expected(ikmLen);
+    check_expected_ptr(info);
+    check_expected(infoLen);
+    assert_non_null(okm);
+    assert_true(okmLen > 0);
+
+    return mock_type(int);
+}
@@ -0,0 +1,22 @@
+// SPDX-License-Identifier: MIT
+/**
+ * @file mock_cominitCryptoHkdfSha256.h
+ * @brief Header declaring a mock function for cominitCryptoHkdfSha256().
+ */
+#ifndef __MOCK_COMINIT_CRYPTOHKDFSHA256_H__
+#define __MOCK_COMINIT_CRYPTOHKDFSHA256_H__
+
+#include <stddef.h>
+#include <stdint.h>
+
+/**
+ * Mock function for cominitCryptoHkdfSha256().
+ *
+ * Implemented using cmocka. Inputs may be checked and return code set using cmocka API. Otherwise the function is a
+ * no-op.
+ */
+// NOLINTNEXTLINE(readability-identifier-naming)    Rationale: Naming scheme fixed due to linker wrapping.
+int __wrap_cominitCryptoHkdfSha256(const uint8_t *ikm, size_t ikmLen, const uint8_t *info, size_t infoLen, uint8_t *okm,
+                                   size_t okmLen);
+
+#endif /* __MOCK_COMINIT_CRYPTOHKDFSHA256_H__ */
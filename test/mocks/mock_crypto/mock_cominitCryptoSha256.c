@@ -0,0 +1,18 @@
+// SPDX-License-Identifier: MIT
+/**
+ * @file mock_cominitCryptoSha256.c
+ * @brief Implementation of a mock function for cominitCryptoSha256() using cmocka.
+ */
+#include "mock_cominitCryptoSha256.h"
+
+#include "unit_test.h"
+
+// NOLINTNEXTLINE(readability-identifier-naming)    Rationale: Naming scheme fixed due to linker wrapping.
+int __wrap_cominitCryptoSha256(const uint8_t *data, size_t dataLen, unsigned char *digest, size_t digestLen) {
+    check_expected_ptr(data);
+    check_expected(dataLen);
+    assert_non_null(digest);
+    assert_true(digestLen > 0);
+
+    return mock_type(int);
+}
@@ -0,0 +1,21 @@
+// SPDX-License-Identifier: MIT
+/**
+ * @file mock_cominitCryptoSha256.h
+ * @brief Header declaring a mock function for cominitCryptoSha256().
+ */
+#ifndef __MOCK_COMINIT_CRYPTOSHA256_H__
+#define __MOCK_COMINIT_CRYPTOSHA256_H__
+
+#include <stddef.h>
+#include <stdint.h>
+
+/**
+ * Mock function for cominitCryptoSha256().
+ *
+ * Implemented using cmocka. Inputs may be checked and return code set using cmocka API. Otherwise the function is a
+ * no-op.
+ */
+// NOLINTNEXTLINE(readability-identifier-naming)    Rationale: Naming scheme fixed due to linker wrapping.
+int __wrap_cominitCryptoSha256(const uint8_t *data, size_t dataLen, unsigned char *digest, size_t digestLen);
+
+#endif /* __MOCK_COMINIT_CRYPTOSHA256_H__ */
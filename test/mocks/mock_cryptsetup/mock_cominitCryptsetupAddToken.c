@@ -8,8 +8,9 @@
 #include "unit_test.h"
 
 // NOLINTNEXTLINE(readability-identifier-naming)    Rationale: Naming scheme fixed due to linker wrapping.
-int __wrap_cominitCryptsetupAddToken(char *devCrypt) {
+int __wrap_cominitCryptsetupAddToken(char *devCrypt, const char *keyDesc) {
     check_expected_ptr(devCrypt);
+    check_expected_ptr(keyDesc);
 
     return mock_type(int);
 }
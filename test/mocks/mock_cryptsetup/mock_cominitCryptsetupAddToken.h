@@ -13,6 +13,6 @@
  * no-op.
  */
 // NOLINTNEXTLINE(readability-identifier-naming)    Rationale: Naming scheme fixed due to linker wrapping.
-int __wrap_cominitCryptsetupAddToken(char *devCrypt);
+int __wrap_cominitCryptsetupAddToken(char *devCrypt, const char *keyDesc);
 
 #endif /* __MOCK_COMINIT_CRYPTSETUPADDTOKEN_H__ */
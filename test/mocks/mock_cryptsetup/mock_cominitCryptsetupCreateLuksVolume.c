@@ -8,9 +8,11 @@
 #include "unit_test.h"
 
 // NOLINTNEXTLINE(readability-identifier-naming)    Rationale: Naming scheme fixed due to linker wrapping.
-int __wrap_cominitCryptsetupCreateLuksVolume(char *devCrypt, uint8_t *passphrase, size_t passphraseSize) {
+int __wrap_cominitCryptsetupCreateLuksVolume(char *devCrypt, const cominitCryptsetupCipher_t *cipher,
+                                             uint8_t *passphrase, size_t passphraseSize) {
     check_expected_ptr(passphrase);
     check_expected_ptr(devCrypt);
+    check_expected_ptr(cipher);
     check_expected(passphraseSize);
 
     return mock_type(int);
@@ -9,6 +9,8 @@
 #include <tss2/tss2_common.h>
 #include <tss2/tss2_esys.h>
 
+#include "cryptsetup.h"
+
 /**
  * Mock function for cominitCryptsetupCreateLuksVolume().
  *
@@ -16,6 +18,7 @@
  * no-op.
  */
 // NOLINTNEXTLINE(readability-identifier-naming)    Rationale: Naming scheme fixed due to linker wrapping.
-int __wrap_cominitCryptsetupCreateLuksVolume(char *devCrypt, uint8_t *passphrase, size_t passphraseSize);
+int __wrap_cominitCryptsetupCreateLuksVolume(char *devCrypt, const cominitCryptsetupCipher_t *cipher,
+                                             uint8_t *passphrase, size_t passphraseSize);
 
 #endif /* __MOCK_COMINIT_CRYPTSETUPCREATELUKSVOLUME_H__ */
@@ -0,0 +1,22 @@
+// SPDX-License-Identifier: MIT
+/**
+ * @file mock_cominitCryptsetupOpenLuksVolumes.c
+ * @brief Implementation of a mock function for cominitCryptsetupOpenLuksVolumes() using cmocka.
+ */
+#include "mock_cominitCryptsetupOpenLuksVolumes.h"
+
+#include "unit_test.h"
+
+// NOLINTNEXTLINE(readability-identifier-naming)    Rationale: Naming scheme fixed due to linker wrapping.
+int __wrap_cominitCryptsetupOpenLuksVolumes(char *const devCrypt[], char *const names[], int results[], size_t count) {
+    check_expected_ptr(devCrypt);
+    check_expected_ptr(names);
+    check_expected(count);
+
+    int result = mock_type(int);
+    for (size_t i = 0; results != NULL && i < count; i++) {
+        results[i] = result;
+    }
+
+    return result;
+}
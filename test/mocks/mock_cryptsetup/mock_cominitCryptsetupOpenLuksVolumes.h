@@ -0,0 +1,20 @@
+// SPDX-License-Identifier: MIT
+/**
+ * @file mock_cominitCryptsetupOpenLuksVolumes.h
+ * @brief Header declaring a mock function for cominitCryptsetupOpenLuksVolumes().
+ */
+#ifndef __MOCK_COMINIT_CRYPTSETUPOPENLUKSVOLUMES_H__
+#define __MOCK_COMINIT_CRYPTSETUPOPENLUKSVOLUMES_H__
+
+#include <stddef.h>
+
+/**
+ * Mock function for cominitCryptsetupOpenLuksVolumes().
+ *
+ * Implemented using cmocka. Inputs may be checked and return code set using cmocka API. Every entry of \a results
+ * is set to the return code. Otherwise the function is a no-op.
+ */
+// NOLINTNEXTLINE(readability-identifier-naming)    Rationale: Naming scheme fixed due to linker wrapping.
+int __wrap_cominitCryptsetupOpenLuksVolumes(char *const devCrypt[], char *const names[], int results[], size_t count);
+
+#endif /* __MOCK_COMINIT_CRYPTSETUPOPENLUKSVOLUMES_H__ */
@@ -0,0 +1,21 @@
+// SPDX-License-Identifier: MIT
+/**
+ * @file mock_cominitCryptsetupSelectCipher.c
+ * @brief Implementation of a mock function for cominitCryptsetupSelectCipher() using cmocka.
+ */
+#include "mock_cominitCryptsetupSelectCipher.h"
+
+#include "unit_test.h"
+
+// NOLINTNEXTLINE(readability-identifier-naming)    Rationale: Naming scheme fixed due to linker wrapping.
+int __wrap_cominitCryptsetupSelectCipher(unsigned int minStrength, const cominitCryptsetupCipher_t **cipher) {
+    static const cominitCryptsetupCipher_t cominitMockCipher = {
+        .name = "aes-xts-plain64", .kcapiName = "xts(aes)", .keySize = 64, .ivSize = 16, .strength = 256};
+
+    check_expected(minStrength);
+    assert_non_null(cipher);
+
+    *cipher = &cominitMockCipher;
+
+    return mock_type(int);
+}
@@ -0,0 +1,20 @@
+// SPDX-License-Identifier: MIT
+/**
+ * @file mock_cominitCryptsetupSelectCipher.h
+ * @brief Header declaring a mock function for cominitCryptsetupSelectCipher().
+ */
+#ifndef __MOCK_COMINIT_CRYPTSETUPSELECTCIPHER_H__
+#define __MOCK_COMINIT_CRYPTSETUPSELECTCIPHER_H__
+
+#include "cryptsetup.h"
+
+/**
+ * Mock function for cominitCryptsetupSelectCipher().
+ *
+ * Implemented using cmocka. Inputs may be checked and return code set using cmocka API. Otherwise the function is a
+ * no-op.
+ */
+// NOLINTNEXTLINE(readability-identifier-naming)    Rationale: Naming scheme fixed due to linker wrapping.
+int __wrap_cominitCryptsetupSelectCipher(unsigned int minStrength, const cominitCryptsetupCipher_t **cipher);
+
+#endif /* __MOCK_COMINIT_CRYPTSETUPSELECTCIPHER_H__ */
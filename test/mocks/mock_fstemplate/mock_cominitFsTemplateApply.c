@@ -0,0 +1,16 @@
+// SPDX-License-Identifier: MIT
+/**
+ * @file mock_cominitFsTemplateApply.c
+ * @brief Implementation of a mock function for cominitFsTemplateApply() using cmocka.
+ */
+#include "mock_cominitFsTemplateApply.h"
+
+#include "unit_test.h"
+
+// NOLINTNEXTLINE(readability-identifier-naming)    Rationale: Naming scheme fixed due to linker wrapping.
+int __wrap_cominitFsTemplateApply(const char *templatePath, const char *device) {
+    check_expected_ptr(templatePath);
+    check_expected_ptr(device);
+
+    return mock_type(int);
+}
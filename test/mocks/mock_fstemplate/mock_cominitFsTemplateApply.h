@@ -0,0 +1,19 @@
+// SPDX-License-Identifier: MIT
+/**
+ * @file mock_cominitFsTemplateApply.h
+ * @brief Header declaring a mock function for cominitFsTemplateApply().
+ */
+#ifndef __MOCK_COMINIT_FSTEMPLATEAPPLY_H__
+#define __MOCK_COMINIT_FSTEMPLATEAPPLY_H__
+
+
+/**
+ * Mock function for cominitFsTemplateApply().
+ *
+ * Implemented using cmocka. Inputs may be checked and return code set using cmocka API. Otherwise the function is a
+ * no-op.
+ */
+// NOLINTNEXTLINE(readability-identifier-naming)    Rationale: Naming scheme fixed due to linker wrapping.
+int __wrap_cominitFsTemplateApply(const char *templatePath, const char *device);
+
+#endif /* __MOCK_COMINIT_FSTEMPLATEAPPLY_H__ */
@@ -0,0 +1,20 @@
+// SPDX-License-Identifier: MIT
+/**
+ * @file mock_cominitKcapiBenchmarkSkcipher.c
+ * @brief Implementation of a mock function for cominitKcapiBenchmarkSkcipher() using cmocka.
+ */
+#include "mock_cominitKcapiBenchmarkSkcipher.h"
+
+#include "unit_test.h"
+
+// NOLINTNEXTLINE(readability-identifier-naming)    Rationale: Naming scheme fixed due to linker wrapping.
+int __wrap_cominitKcapiBenchmarkSkcipher(const char *algName, size_t keySize, size_t ivSize, uint64_t *nsPerRun) {
+    check_expected_ptr(algName);
+    check_expected(keySize);
+    check_expected(ivSize);
+    assert_non_null(nsPerRun);
+
+    *nsPerRun = mock_type(uint64_t);
+
+    return mock_type(int);
+}
@@ -0,0 +1,21 @@
+// SPDX-License-Identifier: MIT
+/**
+ * @file mock_cominitKcapiBenchmarkSkcipher.h
+ * @brief Header declaring a mock function for cominitKcapiBenchmarkSkcipher().
+ */
+#ifndef __MOCK_COMINIT_KCAPIBENCHMARKSKCIPHER_H__
+#define __MOCK_COMINIT_KCAPIBENCHMARKSKCIPHER_H__
+
+#include <stddef.h>
+#include <stdint.h>
+
+/**
+ * Mock function for cominitKcapiBenchmarkSkcipher().
+ *
+ * Implemented using cmocka. Inputs may be checked and return code set using cmocka API. Otherwise the function is a
+ * no-op.
+ */
+// NOLINTNEXTLINE(readability-identifier-naming)    Rationale: Naming scheme fixed due to linker wrapping.
+int __wrap_cominitKcapiBenchmarkSkcipher(const char *algName, size_t keySize, size_t ivSize, uint64_t *nsPerRun);
+
+#endif /* __MOCK_COMINIT_KCAPIBENCHMARKSKCIPHER_H__ */
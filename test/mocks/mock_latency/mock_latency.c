@@ -0,0 +1,52 @@
+// SPDX-License-Identifier: MIT
+/**
+ * @file mock_latency.c
+ * @brief Implementation of a virtual monotonic clock and per-call latencies for mock functions.
+ */
+#include "mock_latency.h"
+
+#include <stddef.h>
+
+#define COMINIT_MOCK_LATENCY_SEED 0x9E3779B97F4A7C15ULL  ///< Start value of the pseudo random sequence.
+
+static uint64_t cominitMockClockNs = 0;                              ///< Current time of the virtual clock.
+static uint64_t cominitMockLatencyState = COMINIT_MOCK_LATENCY_SEED;  ///< State of the pseudo random sequence.
+
+/**
+ * Draws the next value of a deterministic xorshift64 sequence, good enough to spread latencies.
+ *
+ * @return  The pseudo random value
+ */
+static uint64_t cominitMockLatencyRandom(void) {
+    cominitMockLatencyState ^= cominitMockLatencyState << 13;
+    cominitMockLatencyState ^= cominitMockLatencyState >> 7;
+    cominitMockLatencyState ^= cominitMockLatencyState << 17;
+    return cominitMockLatencyState;
+}
+
+void cominitMockClockReset(void) {
+    cominitMockClockNs = 0;
+    cominitMockLatencyState = COMINIT_MOCK_LATENCY_SEED;
+}
+
+uint64_t cominitMockClockNow(void) {
+    return cominitMockClockNs;
+}
+
+void cominitMockClockAdvance(uint64_t ns) {
+    cominitMockClockNs += ns;
+}
+
+uint64_t cominitMockLatencyApply(const cominitMockLatency_t *latency) {
+    uint64_t ns = 0;
+
+    if (latency != NULL) {
+        ns = latency->minNs;
+        if (latency->maxNs > latency->minNs) {
+            ns += cominitMockLatencyRandom() % (latency->maxNs - latency->minNs + 1);
+        }
+    }
+    cominitMockClockAdvance(ns);
+
+    return ns;
+}
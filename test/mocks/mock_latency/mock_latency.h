@@ -0,0 +1,66 @@
+// SPDX-License-Identifier: MIT
+/**
+ * @file mock_latency.h
+ * @brief Header declaring a virtual monotonic clock and per-call latencies for mock functions.
+ */
+#ifndef __MOCK_LATENCY_H__
+#define __MOCK_LATENCY_H__
+
+#include <stdint.h>
+
+/**
+ * Converts milliseconds to the nanoseconds of the virtual monotonic clock.
+ *
+ * @param ms  The number of milliseconds.
+ */
+#define COMINIT_MOCK_MSEC(ms) ((uint64_t)(ms) * 1000000ULL)
+
+/**
+ * Latency distribution of a mocked call.
+ *
+ * Every call takes a duration uniformly distributed between both bounds, or exactly cominitMockLatency_t::minNs if
+ * they are equal. The zero-initialized distribution lets a mock return immediately.
+ */
+typedef struct cominitMockLatency {
+    uint64_t minNs;  ///< Shortest duration of a call in nanoseconds.
+    uint64_t maxNs;  ///< Longest duration of a call in nanoseconds.
+} cominitMockLatency_t;
+
+/**
+ * A latency distribution between two durations in milliseconds.
+ *
+ * @param minMs  The shortest duration.
+ * @param maxMs  The longest duration.
+ */
+#define COMINIT_MOCK_LATENCY_MSEC(minMs, maxMs) \
+    ((cominitMockLatency_t){.minNs = COMINIT_MOCK_MSEC(minMs), .maxNs = COMINIT_MOCK_MSEC(maxMs)})
+
+/**
+ * Resets the virtual monotonic clock to 0 and reseeds the latency distributions, so scenarios are reproducible.
+ */
+void cominitMockClockReset(void);
+
+/**
+ * Gets the current time of the virtual monotonic clock.
+ *
+ * @return  The time in nanoseconds since the last call of cominitMockClockReset()
+ */
+uint64_t cominitMockClockNow(void);
+
+/**
+ * Lets time pass on the virtual monotonic clock.
+ *
+ * @param ns  The number of nanoseconds to add.
+ */
+void cominitMockClockAdvance(uint64_t ns);
+
+/**
+ * Lets one call of a mock take its time on the virtual monotonic clock.
+ *
+ * @param latency  The latency distribution of the call, may be NULL for no latency.
+ *
+ * @return  The number of nanoseconds the call took
+ */
+uint64_t cominitMockLatencyApply(const cominitMockLatency_t *latency);
+
+#endif /* __MOCK_LATENCY_H__ */
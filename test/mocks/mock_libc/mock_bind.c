@@ -0,0 +1,21 @@
+// SPDX-License-Identifier: MIT
+/**
+ * @file mock_bind.c
+ * @brief Implementation of a mock function for bind().
+ */
+#include "mock_bind.h"
+
+#include "unit_test.h"
+
+bool cominitMockBindEnabled = false;
+// Rationale: Naming scheme fixed due to linker wrapping.
+// NOLINTNEXTLINE(readability-identifier-naming)
+int __wrap_bind(int sockfd, const struct sockaddr *addr, socklen_t addrlen) {
+    if (cominitMockBindEnabled) {
+        check_expected(sockfd);
+        check_expected_ptr(addr);
+        return mock_type(int);
+    } else {
+        return __real_bind(sockfd, addr, addrlen);
+    }
+}
@@ -0,0 +1,34 @@
+// SPDX-License-Identifier: MIT
+/**
+ * @file mock_bind.h
+ * @brief Header declaring a mock function for bind().
+ */
+#ifndef __MOCK_BIND_H__
+#define __MOCK_BIND_H__
+
+#include <stdbool.h>
+#include <sys/socket.h>
+
+/**
+ * Mock function for bind().
+ *
+ * If cominitMockBindEnabled is true then it checks that the right parameters are
+ * given.
+ * If cominitMockBindEnabled is false then the call is forwarded to the genuine bind
+ * method.
+ */
+// NOLINTNEXTLINE(readability-identifier-naming)    Rationale: Naming scheme fixed due to linker wrapping.
+int __wrap_bind(int sockfd, const struct sockaddr *addr, socklen_t addrlen);
+/*
+ * Prototype for the genuine bind function provided by the linker
+ */
+// NOLINTNEXTLINE(readability-identifier-naming)    Rationale: Naming scheme fixed due to linker wrapping.
+int __real_bind(int sockfd, const struct sockaddr *addr, socklen_t addrlen);
+/*
+ * Define if bind is used as mock or if bind forwards to __real_bind.
+ * true - mocking enabled , no real bind is called
+ * false - all calls are forwarded to __real_bind aka `bind`
+ */
+extern bool cominitMockBindEnabled;
+
+#endif /* __MOCK_BIND_H__ */
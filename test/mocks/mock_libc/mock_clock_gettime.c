@@ -0,0 +1,25 @@
+// SPDX-License-Identifier: MIT
+/**
+ * @file mock_clock_gettime.c
+ * @brief Implementation of a mock function for clock_gettime().
+ */
+#include "mock_clock_gettime.h"
+
+#include "mock_latency.h"
+#include "unit_test.h"
+
+bool cominitMockClockEnabled = false;
+
+// Rationale: Naming scheme fixed due to linker wrapping.
+// NOLINTNEXTLINE(readability-identifier-naming)
+int __wrap_clock_gettime(clockid_t clockid, struct timespec *tp) {
+    if (cominitMockClockEnabled) {
+        uint64_t now = cominitMockClockNow();
+        assert_non_null(tp);
+        tp->tv_sec = (time_t)(now / 1000000000ULL);
+        tp->tv_nsec = (long)(now % 1000000000ULL);
+        return 0;
+    } else {
+        return __real_clock_gettime(clockid, tp);
+    }
+}
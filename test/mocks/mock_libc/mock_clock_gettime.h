@@ -0,0 +1,36 @@
+// SPDX-License-Identifier: MIT
+/**
+ * @file mock_clock_gettime.h
+ * @brief Header declaring a mock function for clock_gettime().
+ */
+#ifndef __MOCK_CLOCK_GETTIME_H__
+#define __MOCK_CLOCK_GETTIME_H__
+
+#include <stdbool.h>
+#include <time.h>
+
+/**
+ * Mock function for clock_gettime().
+ *
+ * If cominitMockClockEnabled is true then every clock returns the time of the virtual monotonic clock from
+ * mock_latency.h.
+ * If cominitMockClockEnabled is false then the call is forwarded to the genuine clock_gettime method.
+ */
+int __wrap_clock_gettime(clockid_t clockid, struct timespec *tp);  // NOLINT(readability-identifier-naming)
+                                                                   // Rationale: Naming scheme fixed due to linker
+                                                                   // wrapping.
+
+/*
+ * Prototype for the genuine clock_gettime function provided by the linker
+ */
+int __real_clock_gettime(clockid_t clockid, struct timespec *tp);  // NOLINT(readability-identifier-naming)
+                                                                   // Rationale: Naming scheme fixed due to linker
+                                                                   // wrapping.
+
+/*
+ * Define if clock_gettime() and clock_nanosleep() use the virtual monotonic clock or forward to the genuine functions.
+ * true - the virtual clock is read and advanced, no time passes in reality
+ * false - all calls are forwarded to __real_clock_gettime and __real_clock_nanosleep
+ */
+extern bool cominitMockClockEnabled;
+#endif /* __MOCK_CLOCK_GETTIME_H__ */
@@ -0,0 +1,27 @@
+// SPDX-License-Identifier: MIT
+/**
+ * @file mock_clock_nanosleep.c
+ * @brief Implementation of a mock function for clock_nanosleep().
+ */
+#include "mock_clock_nanosleep.h"
+
+#include "mock_latency.h"
+#include "unit_test.h"
+
+// Rationale: Naming scheme fixed due to linker wrapping.
+// NOLINTNEXTLINE(readability-identifier-naming)
+int __wrap_clock_nanosleep(clockid_t clockid, int flags, const struct timespec *request, struct timespec *remain) {
+    if (cominitMockClockEnabled) {
+        assert_non_null(request);
+        uint64_t ns = (uint64_t)request->tv_sec * 1000000000ULL + (uint64_t)request->tv_nsec;
+        uint64_t now = cominitMockClockNow();
+        if ((flags & TIMER_ABSTIME) == 0) {
+            cominitMockClockAdvance(ns);
+        } else if (ns > now) {
+            cominitMockClockAdvance(ns - now);
+        }
+        return 0;
+    } else {
+        return __real_clock_nanosleep(clockid, flags, request, remain);
+    }
+}
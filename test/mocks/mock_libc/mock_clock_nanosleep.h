@@ -0,0 +1,31 @@
+// SPDX-License-Identifier: MIT
+/**
+ * @file mock_clock_nanosleep.h
+ * @brief Header declaring a mock function for clock_nanosleep().
+ */
+#ifndef __MOCK_CLOCK_NANOSLEEP_H__
+#define __MOCK_CLOCK_NANOSLEEP_H__
+
+#include <time.h>
+
+#include "mock_clock_gettime.h"
+
+/**
+ * Mock function for clock_nanosleep().
+ *
+ * If cominitMockClockEnabled is true then the virtual monotonic clock from mock_latency.h is advanced to the absolute
+ * or by the relative time in \a request and the call returns immediately.
+ * If cominitMockClockEnabled is false then the call is forwarded to the genuine clock_nanosleep method.
+ */
+int __wrap_clock_nanosleep(clockid_t clockid, int flags, const struct timespec *request,
+                           struct timespec *remain);  // NOLINT(readability-identifier-naming)
+                                                      // Rationale: Naming scheme fixed due to linker wrapping.
+
+/*
+ * Prototype for the genuine clock_nanosleep function provided by the linker
+ */
+int __real_clock_nanosleep(clockid_t clockid, int flags, const struct timespec *request,
+                           struct timespec *remain);  // NOLINT(readability-identifier-naming)
+                                                      // Rationale: Naming scheme fixed due to linker wrapping.
+
+#endif /* __MOCK_CLOCK_NANOSLEEP_H__ */
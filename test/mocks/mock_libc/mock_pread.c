@@ -7,6 +7,8 @@
 
 #include "unit_test.h"
 
+cominitMockLatency_t cominitMockPreadLatency = {0};
+
 // Rationale: Naming scheme fixed due to linker wrapping.
 // NOLINTNEXTLINE(readability-identifier-naming)
 ssize_t __wrap_pread(int fd, void *buf, size_t count, off_t offset) {
@@ -15,5 +17,7 @@ ssize_t __wrap_pread(int fd, void *buf, size_t count, off_t offset) {
     check_expected(count);
     check_expected(offset);
 
+    cominitMockLatencyApply(&cominitMockPreadLatency);
+
     return mock_type(ssize_t);
 }
@@ -8,13 +8,21 @@
 
 #include <unistd.h>
 
+#include "mock_latency.h"
+
 /**
  * Mock function for pread().
  *
- * Checks that the right parameters are given and return a preset pointer.
+ * Checks that the right parameters are given and return a preset pointer. Every call takes cominitMockPreadLatency on
+ * the virtual monotonic clock.
  */
 ssize_t __wrap_pread(int fd, void *buf, size_t count,
                      off_t offset);  // NOLINT(readability-identifier-naming)
                                      // Rationale: Naming scheme fixed due to linker wrapping.
 
+/*
+ * Latency of every pread() call, no latency by default.
+ */
+extern cominitMockLatency_t cominitMockPreadLatency;
+
 #endif /* __MOCK_PREAD_H__ */
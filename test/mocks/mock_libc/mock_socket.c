@@ -0,0 +1,20 @@
+// SPDX-License-Identifier: MIT
+/**
+ * @file mock_socket.c
+ * @brief Implementation of a mock function for socket().
+ */
+#include "mock_socket.h"
+
+#include "unit_test.h"
+
+bool cominitMockSocketEnabled = false;
+// Rationale: Naming scheme fixed due to linker wrapping.
+// NOLINTNEXTLINE(readability-identifier-naming)
+int __wrap_socket(int domain, int type, int protocol) {
+    if (cominitMockSocketEnabled) {
+        check_expected(domain);
+        return mock_type(int);
+    } else {
+        return __real_socket(domain, type, protocol);
+    }
+}
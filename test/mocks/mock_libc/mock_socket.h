@@ -0,0 +1,34 @@
+// SPDX-License-Identifier: MIT
+/**
+ * @file mock_socket.h
+ * @brief Header declaring a mock function for socket().
+ */
+#ifndef __MOCK_SOCKET_H__
+#define __MOCK_SOCKET_H__
+
+#include <stdbool.h>
+#include <sys/socket.h>
+
+/**
+ * Mock function for socket().
+ *
+ * If cominitMockSocketEnabled is true then it checks that the right parameters are
+ * given.
+ * If cominitMockSocketEnabled is false then the call is forwarded to the genuine socket
+ * method.
+ */
+int __wrap_socket(int domain, int type, int protocol);  // NOLINT(readability-identifier-naming)
+                                                        // Rationale: Naming scheme fixed due to linker wrapping.
+/*
+ * Prototype for the genuine socket function provided by the linker
+ */
+int __real_socket(int domain, int type, int protocol);  // NOLINT(readability-identifier-naming)
+                                                        // Rationale: Naming scheme fixed due to linker wrapping.
+/*
+ * Define if socket is used as mock or if socket forwards to __real_socket.
+ * true - mocking enabled , no real socket is called
+ * false - all calls are forwarded to __real_socket aka `socket`
+ */
+extern bool cominitMockSocketEnabled;
+
+#endif /* __MOCK_SOCKET_H__ */
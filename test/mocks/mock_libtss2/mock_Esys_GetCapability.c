@@ -0,0 +1,29 @@
+// SPDX-License-Identifier: MIT
+/**
+ * @file mock_Esys_GetCapability.c
+ * @brief Implementation of a mock function for Esys_GetCapability() using cmocka.
+ */
+#include "mock_Esys_GetCapability.h"
+
+#include "unit_test.h"
+
+// NOLINTNEXTLINE(readability-identifier-naming)    Rationale: Naming scheme fixed due to linker wrapping.
+TSS2_RC __wrap_Esys_GetCapability(ESYS_CONTEXT *esysContext, ESYS_TR shandle1, ESYS_TR shandle2, ESYS_TR shandle3,
+                                  TPM2_CAP capability, UINT32 property, UINT32 propertyCount, TPMI_YES_NO *moreData,
+                                  TPMS_CAPABILITY_DATA **capabilityData) {
+    check_expected_ptr(esysContext);
+    check_expected(shandle1);
+    check_expected(shandle2);
+    check_expected(shandle3);
+    check_expected(capability);
+    check_expected(property);
+    check_expected(propertyCount);
+
+    assert_non_null(capabilityData);
+    if (moreData != NULL) {
+        *moreData = TPM2_NO;
+    }
+    *capabilityData = mock_ptr_type(TPMS_CAPABILITY_DATA *);
+
+    return mock_type(TSS2_RC);
+}
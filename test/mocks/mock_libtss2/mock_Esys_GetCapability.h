@@ -0,0 +1,23 @@
+// SPDX-License-Identifier: MIT
+/**
+ * @file mock_Esys_GetCapability.h
+ * @brief Header declaring a mock function for Esys_GetCapability().
+ */
+#ifndef __MOCK_ESYS_GET_CAPABILITY_H__
+#define __MOCK_ESYS_GET_CAPABILITY_H__
+
+#include <tss2/tss2_common.h>
+#include <tss2/tss2_esys.h>
+
+/**
+ * Mock function for Esys_GetCapability().
+ *
+ * Implemented using cmocka. Inputs may be checked and return code set using cmocka API. Otherwise the function is a
+ * no-op.
+ */
+// NOLINTNEXTLINE(readability-identifier-naming)    Rationale: Naming scheme fixed due to linker wrapping.
+TSS2_RC __wrap_Esys_GetCapability(ESYS_CONTEXT *esysContext, ESYS_TR shandle1, ESYS_TR shandle2, ESYS_TR shandle3,
+                                  TPM2_CAP capability, UINT32 property, UINT32 propertyCount, TPMI_YES_NO *moreData,
+                                  TPMS_CAPABILITY_DATA **capabilityData);
+
+#endif /* __MOCK_ESYS_GET_CAPABILITY_H__ */
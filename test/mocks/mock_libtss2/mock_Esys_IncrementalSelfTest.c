@@ -0,0 +1,27 @@
+// SPDX-License-Identifier: MIT
+/**
+ * @file mock_Esys_IncrementalSelfTest.c
+ * @brief Implementation of a mock function for Esys_IncrementalSelfTest() using cmocka.
+ */
+#include "mock_Esys_IncrementalSelfTest.h"
+
+#include "unit_test.h"
+
+cominitMockLatency_t cominitMockEsysIncrementalSelfTestLatency = {0};
+
+// NOLINTNEXTLINE(readability-identifier-naming)    Rationale: Naming scheme fixed due to linker wrapping.
+TSS2_RC __wrap_Esys_IncrementalSelfTest(ESYS_CONTEXT *esysContext, ESYS_TR shandle1, ESYS_TR shandle2,
+                                        ESYS_TR shandle3, const TPML_ALG *toTest, TPML_ALG **toDoList) {
+    (void)(esysContext);
+    (void)(shandle1);
+    (void)(shandle2);
+    (void)(shandle3);
+    assert_non_null(toTest);
+
+    cominitMockLatencyApply(&cominitMockEsysIncrementalSelfTestLatency);
+
+    assert_non_null(toDoList);
+    *toDoList = mock_ptr_type(TPML_ALG *);
+
+    return mock_type(TSS2_RC);
+}
@@ -0,0 +1,29 @@
+// SPDX-License-Identifier: MIT
+/**
+ * @file mock_Esys_IncrementalSelfTest.h
+ * @brief Header declaring a mock function for Esys_IncrementalSelfTest().
+ */
+#ifndef __MOCK_ESYS_INCREMENTALSELFTEST_H__
+#define __MOCK_ESYS_INCREMENTALSELFTEST_H__
+
+#include <tss2/tss2_common.h>
+#include <tss2/tss2_esys.h>
+
+#include "mock_latency.h"
+
+/**
+ * Mock function for Esys_IncrementalSelfTest().
+ *
+ * Implemented using cmocka. Inputs may be checked and return code set using cmocka API. Otherwise the function is a
+ * no-op.
+ */
+// NOLINTNEXTLINE(readability-identifier-naming)    Rationale: Naming scheme fixed due to linker wrapping.
+TSS2_RC __wrap_Esys_IncrementalSelfTest(ESYS_CONTEXT *esysContext, ESYS_TR shandle1, ESYS_TR shandle2,
+                                        ESYS_TR shandle3, const TPML_ALG *toTest, TPML_ALG **toDoList);
+
+/**
+ * Latency of every Esys_IncrementalSelfTest() call, no latency by default.
+ */
+extern cominitMockLatency_t cominitMockEsysIncrementalSelfTestLatency;
+
+#endif /* __MOCK_ESYS_INCREMENTALSELFTEST_H__ */
@@ -19,6 +19,8 @@ TSS2_RC __wrap_Esys_PCR_Extend(ESYS_CONTEXT *esysContext, ESYS_TR pcrHandle, ESY
     check_expected(shandle3);
 
     assert_non_null(digests);
+    UINT32 digestCount = digests->count;
+    check_expected(digestCount);
 
     return mock_type(TSS2_RC);
 }
@@ -0,0 +1,27 @@
+// SPDX-License-Identifier: MIT
+/**
+ * @file mock_Esys_PCR_Read.c
+ * @brief Implementation of a mock function for Esys_PCR_Read() using cmocka.
+ */
+#include "mock_Esys_PCR_Read.h"
+
+#include "unit_test.h"
+
+// NOLINTNEXTLINE(readability-identifier-naming)    Rationale: Naming scheme fixed due to linker wrapping.
+TSS2_RC __wrap_Esys_PCR_Read(ESYS_CONTEXT *esysContext, ESYS_TR shandle1, ESYS_TR shandle2, ESYS_TR shandle3,
+                             const TPML_PCR_SELECTION *pcrSelectionIn, UINT32 *pcrUpdateCounter,
+                             TPML_PCR_SELECTION **pcrSelectionOut, TPML_DIGEST **pcrValues) {
+    check_expected_ptr(esysContext);
+    check_expected(shandle1);
+    check_expected(shandle2);
+    check_expected(shandle3);
+    check_expected_ptr(pcrSelectionIn);
+    check_expected_ptr(pcrUpdateCounter);
+
+    assert_non_null(pcrSelectionOut);
+    assert_non_null(pcrValues);
+    *pcrSelectionOut = mock_ptr_type(TPML_PCR_SELECTION *);
+    *pcrValues = mock_ptr_type(TPML_DIGEST *);
+
+    return mock_type(TSS2_RC);
+}
@@ -0,0 +1,23 @@
+// SPDX-License-Identifier: MIT
+/**
+ * @file mock_Esys_PCR_Read.h
+ * @brief Header declaring a mock function for Esys_PCR_Read().
+ */
+#ifndef __MOCK_ESYS_PCR_READ_H__
+#define __MOCK_ESYS_PCR_READ_H__
+
+#include <tss2/tss2_common.h>
+#include <tss2/tss2_esys.h>
+
+/**
+ * Mock function for Esys_PCR_Read().
+ *
+ * Implemented using cmocka. Inputs may be checked and return code set using cmocka API. Otherwise the function is a
+ * no-op.
+ */
+// NOLINTNEXTLINE(readability-identifier-naming)    Rationale: Naming scheme fixed due to linker wrapping.
+TSS2_RC __wrap_Esys_PCR_Read(ESYS_CONTEXT *esysContext, ESYS_TR shandle1, ESYS_TR shandle2, ESYS_TR shandle3,
+                             const TPML_PCR_SELECTION *pcrSelectionIn, UINT32 *pcrUpdateCounter,
+                             TPML_PCR_SELECTION **pcrSelectionOut, TPML_DIGEST **pcrValues);
+
+#endif /* __MOCK_ESYS_PCR_READ_H__ */
@@ -0,0 +1,23 @@
+// SPDX-License-Identifier: MIT
+/**
+ * @file mock_Esys_ReadPublic.h
+ * @brief Header declaring a mock function for Esys_ReadPublic().
+ */
+#ifndef __MOCK_ESYS_READPUBLIC_H__
+#define __MOCK_ESYS_READPUBLIC_H__
+
+#include <tss2/tss2_common.h>
+#include <tss2/tss2_esys.h>
+
+/**
+ * Mock function for Esys_ReadPublic().
+ *
+ * Implemented using cmocka. Inputs may be checked and return code set using cmocka API. Otherwise the function is a
+ * no-op.
+ */
+// NOLINTNEXTLINE(readability-identifier-naming)    Rationale: Naming scheme fixed due to linker wrapping.
+TSS2_RC __wrap_Esys_ReadPublic(ESYS_CONTEXT *esysContext, ESYS_TR objectHandle, ESYS_TR shandle1, ESYS_TR shandle2,
+                               ESYS_TR shandle3, TPM2B_PUBLIC **outPublic, TPM2B_NAME **name,
+                               TPM2B_NAME **qualifiedName);
+
+#endif /* __MOCK_ESYS_READPUBLIC_H__ */
@@ -9,6 +9,8 @@
 
 #include "unit_test.h"
 
+cominitMockLatency_t cominitMockEsysSelfTestLatency = {0};
+
 // NOLINTNEXTLINE(readability-identifier-naming)    Rationale: Naming scheme fixed due to linker wrapping.
 TSS2_RC __wrap_Esys_SelfTest(ESYS_CONTEXT *esysContext, ESYS_TR shandle1, ESYS_TR shandle2, ESYS_TR shandle3,
                              TPMI_YES_NO fullTest) {
@@ -18,5 +20,7 @@ TSS2_RC __wrap_Esys_SelfTest(ESYS_CONTEXT *esysContext, ESYS_TR shandle1, ESYS_T
     (void)(shandle3);
     (void)(fullTest);
 
+    cominitMockLatencyApply(&cominitMockEsysSelfTestLatency);
+
     return TSS2_RC_SUCCESS;
 }
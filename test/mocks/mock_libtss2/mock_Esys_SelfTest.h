@@ -9,6 +9,8 @@
 #include <tss2/tss2_common.h>
 #include <tss2/tss2_esys.h>
 
+#include "mock_latency.h"
+
 /**
  * Mock function for Esys_SelfTest().
  *
@@ -19,4 +21,9 @@
 TSS2_RC __wrap_Esys_SelfTest(ESYS_CONTEXT *esysContext, ESYS_TR shandle1, ESYS_TR shandle2, ESYS_TR shandle3,
                              TPMI_YES_NO fullTest);
 
+/**
+ * Latency of every Esys_SelfTest() call, no latency by default.
+ */
+extern cominitMockLatency_t cominitMockEsysSelfTestLatency;
+
 #endif /* __MOCK_ESYS_SELFTEST_H__ */
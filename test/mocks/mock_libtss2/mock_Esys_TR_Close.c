@@ -0,0 +1,18 @@
+// SPDX-License-Identifier: MIT
+/**
+ * @file mock_Esys_TR_Close.c
+ * @brief Implementation of a mock function for Esys_TR_Close() using cmocka.
+ */
+#include "mock_Esys_TR_Close.h"
+
+#include "unit_test.h"
+
+// NOLINTNEXTLINE(readability-identifier-naming)    Rationale: Naming scheme fixed due to linker wrapping.
+TSS2_RC __wrap_Esys_TR_Close(ESYS_CONTEXT *esysContext, ESYS_TR *rsrcHandle) {
+    check_expected_ptr(esysContext);
+
+    assert_non_null(rsrcHandle);
+    *rsrcHandle = ESYS_TR_NONE;
+
+    return mock_type(TSS2_RC);
+}
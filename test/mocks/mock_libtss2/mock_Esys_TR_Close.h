@@ -0,0 +1,21 @@
+// SPDX-License-Identifier: MIT
+/**
+ * @file mock_Esys_TR_Close.h
+ * @brief Header declaring a mock function for Esys_TR_Close().
+ */
+#ifndef __MOCK_ESYS_TR_CLOSE_H__
+#define __MOCK_ESYS_TR_CLOSE_H__
+
+#include <tss2/tss2_common.h>
+#include <tss2/tss2_esys.h>
+
+/**
+ * Mock function for Esys_TR_Close().
+ *
+ * Implemented using cmocka. Inputs may be checked and return code set using cmocka API. Otherwise the function is a
+ * no-op.
+ */
+// NOLINTNEXTLINE(readability-identifier-naming)    Rationale: Naming scheme fixed due to linker wrapping.
+TSS2_RC __wrap_Esys_TR_Close(ESYS_CONTEXT *esysContext, ESYS_TR *rsrcHandle);
+
+#endif /* __MOCK_ESYS_TR_CLOSE_H__ */
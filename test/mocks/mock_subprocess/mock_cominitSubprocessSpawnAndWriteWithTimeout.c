@@ -0,0 +1,21 @@
+// SPDX-License-Identifier: MIT
+/**
+ * @file mock_cominitSubprocessSpawnAndWriteWithTimeout.c
+ * @brief Implementation of a mock function for cominitSubprocessSpawnAndWriteWithTimeout() using cmocka.
+ */
+#include "mock_cominitSubprocessSpawnAndWriteWithTimeout.h"
+
+#include "unit_test.h"
+
+// NOLINTNEXTLINE(readability-identifier-naming)    Rationale: Naming scheme fixed due to linker wrapping.
+int __wrap_cominitSubprocessSpawnAndWriteWithTimeout(const char *path, char *const argv[], char *const env[],
+                                                     const void *data, size_t dataSize, unsigned int timeoutMs) {
+    check_expected_ptr(path);
+    check_expected_ptr(argv);
+    check_expected_ptr(env);
+    check_expected_ptr(data);
+    check_expected(dataSize);
+    check_expected(timeoutMs);
+
+    return mock_type(int);
+}
@@ -0,0 +1,21 @@
+// SPDX-License-Identifier: MIT
+/**
+ * @file mock_cominitSubprocessSpawnAndWriteWithTimeout.h
+ * @brief Header declaring a mock function for cominitSubprocessSpawnAndWriteWithTimeout().
+ */
+#ifndef __MOCK_COMINIT_SUBPROCESSSPAWNANDWRITEWITHTIMEOUT_H__
+#define __MOCK_COMINIT_SUBPROCESSSPAWNANDWRITEWITHTIMEOUT_H__
+
+#include <stddef.h>
+
+/**
+ * Mock function for cominitSubprocessSpawnAndWriteWithTimeout().
+ *
+ * Implemented using cmocka. Inputs may be checked and return code set using cmocka API. Otherwise the function is a
+ * no-op.
+ */
+// NOLINTNEXTLINE(readability-identifier-naming)    Rationale: Naming scheme fixed due to linker wrapping.
+int __wrap_cominitSubprocessSpawnAndWriteWithTimeout(const char *path, char *const argv[], char *const env[],
+                                                     const void *data, size_t dataSize, unsigned int timeoutMs);
+
+#endif /* __MOCK_COMINIT_SUBPROCESSSPAWNANDWRITEWITHTIMEOUT_H__ */
@@ -0,0 +1,19 @@
+// SPDX-License-Identifier: MIT
+/**
+ * @file mock_cominitSubprocessSpawnWithTimeout.c
+ * @brief Implementation of a mock function for cominitSubprocessSpawnWithTimeout() using cmocka.
+ */
+#include "mock_cominitSubprocessSpawnWithTimeout.h"
+
+#include "unit_test.h"
+
+// NOLINTNEXTLINE(readability-identifier-naming)    Rationale: Naming scheme fixed due to linker wrapping.
+int __wrap_cominitSubprocessSpawnWithTimeout(const char *path, char *const argv[], char *const env[],
+                                             unsigned int timeoutMs) {
+    check_expected_ptr(path);
+    check_expected_ptr(argv);
+    check_expected_ptr(env);
+    check_expected(timeoutMs);
+
+    return mock_type(int);
+}
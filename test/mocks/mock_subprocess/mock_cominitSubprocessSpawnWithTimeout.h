@@ -0,0 +1,19 @@
+// SPDX-License-Identifier: MIT
+/**
+ * @file mock_cominitSubprocessSpawnWithTimeout.h
+ * @brief Header declaring a mock function for cominitSubprocessSpawnWithTimeout().
+ */
+#ifndef __MOCK_COMINIT_SUBPROCESSSPAWNWITHTIMEOUT_H__
+#define __MOCK_COMINIT_SUBPROCESSSPAWNWITHTIMEOUT_H__
+
+/**
+ * Mock function for cominitSubprocessSpawnWithTimeout().
+ *
+ * Implemented using cmocka. Inputs may be checked and return code set using cmocka API. Otherwise the function is a
+ * no-op.
+ */
+// NOLINTNEXTLINE(readability-identifier-naming)    Rationale: Naming scheme fixed due to linker wrapping.
+int __wrap_cominitSubprocessSpawnWithTimeout(const char *path, char *const argv[], char *const env[],
+                                             unsigned int timeoutMs);
+
+#endif /* __MOCK_COMINIT_SUBPROCESSSPAWNWITHTIMEOUT_H__ */
@@ -0,0 +1,17 @@
+// SPDX-License-Identifier: MIT
+/**
+ * @file mock_cominitSubprocessStart.c
+ * @brief Implementation of a mock function for cominitSubprocessStart() using cmocka.
+ */
+#include "mock_cominitSubprocessStart.h"
+
+#include "unit_test.h"
+
+// NOLINTNEXTLINE(readability-identifier-naming)    Rationale: Naming scheme fixed due to linker wrapping.
+pid_t __wrap_cominitSubprocessStart(const char *path, char *const argv[], char *const env[]) {
+    check_expected_ptr(path);
+    check_expected_ptr(argv);
+    check_expected_ptr(env);
+
+    return mock_type(pid_t);
+}
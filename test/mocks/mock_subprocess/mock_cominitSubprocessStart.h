@@ -0,0 +1,20 @@
+// SPDX-License-Identifier: MIT
+/**
+ * @file mock_cominitSubprocessStart.h
+ * @brief Header declaring a mock function for cominitSubprocessStart().
+ */
+#ifndef __MOCK_COMINIT_SUBPROCESSSTART_H__
+#define __MOCK_COMINIT_SUBPROCESSSTART_H__
+
+#include <sys/types.h>
+
+/**
+ * Mock function for cominitSubprocessStart().
+ *
+ * Implemented using cmocka. Inputs may be checked and return code set using cmocka API. Otherwise the function is a
+ * no-op.
+ */
+// NOLINTNEXTLINE(readability-identifier-naming)    Rationale: Naming scheme fixed due to linker wrapping.
+pid_t __wrap_cominitSubprocessStart(const char *path, char *const argv[], char *const env[]);
+
+#endif /* __MOCK_COMINIT_SUBPROCESSSTART_H__ */
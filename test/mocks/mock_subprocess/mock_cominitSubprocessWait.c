@@ -0,0 +1,15 @@
+// SPDX-License-Identifier: MIT
+/**
+ * @file mock_cominitSubprocessWait.c
+ * @brief Implementation of a mock function for cominitSubprocessWait() using cmocka.
+ */
+#include "mock_cominitSubprocessWait.h"
+
+#include "unit_test.h"
+
+// NOLINTNEXTLINE(readability-identifier-naming)    Rationale: Naming scheme fixed due to linker wrapping.
+int __wrap_cominitSubprocessWait(pid_t pid) {
+    check_expected(pid);
+
+    return mock_type(int);
+}
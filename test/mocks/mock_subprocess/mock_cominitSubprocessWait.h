@@ -0,0 +1,20 @@
+// SPDX-License-Identifier: MIT
+/**
+ * @file mock_cominitSubprocessWait.h
+ * @brief Header declaring a mock function for cominitSubprocessWait().
+ */
+#ifndef __MOCK_COMINIT_SUBPROCESSWAIT_H__
+#define __MOCK_COMINIT_SUBPROCESSWAIT_H__
+
+#include <sys/types.h>
+
+/**
+ * Mock function for cominitSubprocessWait().
+ *
+ * Implemented using cmocka. Inputs may be checked and return code set using cmocka API. Otherwise the function is a
+ * no-op.
+ */
+// NOLINTNEXTLINE(readability-identifier-naming)    Rationale: Naming scheme fixed due to linker wrapping.
+int __wrap_cominitSubprocessWait(pid_t pid);
+
+#endif /* __MOCK_COMINIT_SUBPROCESSWAIT_H__ */
@@ -0,0 +1,23 @@
+// SPDX-License-Identifier: MIT
+/**
+ * @file mock_cominitTpmBlobLoad.c
+ * @brief Implementation of a mock function for cominitTpmBlobLoad() using cmocka.
+ */
+#include "mock_cominitTpmBlobLoad.h"
+
+#include <string.h>
+
+#include "unit_test.h"
+
+// NOLINTNEXTLINE(readability-identifier-naming)    Rationale: Naming scheme fixed due to linker wrapping.
+int __wrap_cominitTpmBlobLoad(cominitTpmBlob_t *blob, const char *path) {
+    check_expected_ptr(blob);
+    check_expected_ptr(path);
+
+    const cominitTpmBlob_t *loaded = mock_ptr_type(const cominitTpmBlob_t *);
+    if (loaded != NULL && blob != NULL) {
+        memcpy(blob, loaded, sizeof(*blob));
+    }
+
+    return mock_type(int);
+}
@@ -0,0 +1,20 @@
+// SPDX-License-Identifier: MIT
+/**
+ * @file mock_cominitTpmBlobLoad.h
+ * @brief Header declaring a mock function for cominitTpmBlobLoad().
+ */
+#ifndef __MOCK_COMINIT_TPMBLOBLOAD_H__
+#define __MOCK_COMINIT_TPMBLOBLOAD_H__
+
+#include "tpmblob.h"
+
+/**
+ * Mock function for cominitTpmBlobLoad().
+ *
+ * Implemented using cmocka. Inputs may be checked and return code set using cmocka API. If the pointer passed via
+ * will_return() is not NULL, the blob it points to is copied to \a blob. Otherwise the function is a no-op.
+ */
+// NOLINTNEXTLINE(readability-identifier-naming)    Rationale: Naming scheme fixed due to linker wrapping.
+int __wrap_cominitTpmBlobLoad(cominitTpmBlob_t *blob, const char *path);
+
+#endif /* __MOCK_COMINIT_TPMBLOBLOAD_H__ */
@@ -0,0 +1,27 @@
+// SPDX-License-Identifier: MIT
+/**
+ * @file mock_cominitTpmBlobNvLoad.c
+ * @brief Implementation of a mock function for cominitTpmBlobNvLoad() using cmocka.
+ */
+#include "mock_cominitTpmBlobNvLoad.h"
+
+#include <string.h>
+
+#include "unit_test.h"
+
+// NOLINTNEXTLINE(readability-identifier-naming)    Rationale: Naming scheme fixed due to linker wrapping.
+int __wrap_cominitTpmBlobNvLoad(ESYS_CONTEXT *ectx, TPM2_HANDLE nvIndex, cominitTpmBlob_t *blob, bool *empty) {
+    check_expected_ptr(ectx);
+    check_expected(nvIndex);
+    check_expected_ptr(blob);
+
+    const cominitTpmBlob_t *loaded = mock_ptr_type(const cominitTpmBlob_t *);
+    if (loaded != NULL && blob != NULL) {
+        memcpy(blob, loaded, sizeof(*blob));
+    }
+    if (empty != NULL) {
+        *empty = (loaded == NULL);
+    }
+
+    return mock_type(int);
+}
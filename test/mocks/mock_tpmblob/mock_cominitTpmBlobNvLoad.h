@@ -0,0 +1,20 @@
+// SPDX-License-Identifier: MIT
+/**
+ * @file mock_cominitTpmBlobNvLoad.h
+ * @brief Header declaring a mock function for cominitTpmBlobNvLoad().
+ */
+#ifndef __MOCK_COMINIT_TPMBLOBNVLOAD_H__
+#define __MOCK_COMINIT_TPMBLOBNVLOAD_H__
+
+#include "tpmblob.h"
+
+/**
+ * Mock function for cominitTpmBlobNvLoad().
+ *
+ * Implemented using cmocka. Inputs may be checked and return code set using cmocka API. The blob passed via
+ * will_return() is copied to \a blob, a NULL pointer reports an empty NV index.
+ */
+// NOLINTNEXTLINE(readability-identifier-naming)    Rationale: Naming scheme fixed due to linker wrapping.
+int __wrap_cominitTpmBlobNvLoad(ESYS_CONTEXT *ectx, TPM2_HANDLE nvIndex, cominitTpmBlob_t *blob, bool *empty);
+
+#endif /* __MOCK_COMINIT_TPMBLOBNVLOAD_H__ */
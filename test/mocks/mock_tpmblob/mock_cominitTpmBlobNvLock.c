@@ -0,0 +1,16 @@
+// SPDX-License-Identifier: MIT
+/**
+ * @file mock_cominitTpmBlobNvLock.c
+ * @brief Implementation of a mock function for cominitTpmBlobNvLock() using cmocka.
+ */
+#include "mock_cominitTpmBlobNvLock.h"
+
+#include "unit_test.h"
+
+// NOLINTNEXTLINE(readability-identifier-naming)    Rationale: Naming scheme fixed due to linker wrapping.
+int __wrap_cominitTpmBlobNvLock(ESYS_CONTEXT *ectx, TPM2_HANDLE nvIndex) {
+    check_expected_ptr(ectx);
+    check_expected(nvIndex);
+
+    return mock_type(int);
+}
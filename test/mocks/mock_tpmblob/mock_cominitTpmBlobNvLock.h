@@ -0,0 +1,20 @@
+// SPDX-License-Identifier: MIT
+/**
+ * @file mock_cominitTpmBlobNvLock.h
+ * @brief Header declaring a mock function for cominitTpmBlobNvLock().
+ */
+#ifndef __MOCK_COMINIT_TPMBLOBNVLOCK_H__
+#define __MOCK_COMINIT_TPMBLOBNVLOCK_H__
+
+#include "tpmblob.h"
+
+/**
+ * Mock function for cominitTpmBlobNvLock().
+ *
+ * Implemented using cmocka. Inputs may be checked and return code set using cmocka API. Otherwise the function is a
+ * no-op.
+ */
+// NOLINTNEXTLINE(readability-identifier-naming)    Rationale: Naming scheme fixed due to linker wrapping.
+int __wrap_cominitTpmBlobNvLock(ESYS_CONTEXT *ectx, TPM2_HANDLE nvIndex);
+
+#endif /* __MOCK_COMINIT_TPMBLOBNVLOCK_H__ */
@@ -0,0 +1,17 @@
+// SPDX-License-Identifier: MIT
+/**
+ * @file mock_cominitTpmBlobNvSave.c
+ * @brief Implementation of a mock function for cominitTpmBlobNvSave() using cmocka.
+ */
+#include "mock_cominitTpmBlobNvSave.h"
+
+#include "unit_test.h"
+
+// NOLINTNEXTLINE(readability-identifier-naming)    Rationale: Naming scheme fixed due to linker wrapping.
+int __wrap_cominitTpmBlobNvSave(ESYS_CONTEXT *ectx, TPM2_HANDLE nvIndex, const cominitTpmBlob_t *blob) {
+    check_expected_ptr(ectx);
+    check_expected(nvIndex);
+    check_expected_ptr(blob);
+
+    return mock_type(int);
+}
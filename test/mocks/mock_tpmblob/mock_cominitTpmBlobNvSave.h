@@ -0,0 +1,20 @@
+// SPDX-License-Identifier: MIT
+/**
+ * @file mock_cominitTpmBlobNvSave.h
+ * @brief Header declaring a mock function for cominitTpmBlobNvSave().
+ */
+#ifndef __MOCK_COMINIT_TPMBLOBNVSAVE_H__
+#define __MOCK_COMINIT_TPMBLOBNVSAVE_H__
+
+#include "tpmblob.h"
+
+/**
+ * Mock function for cominitTpmBlobNvSave().
+ *
+ * Implemented using cmocka. Inputs may be checked and return code set using cmocka API. Otherwise the function is a
+ * no-op.
+ */
+// NOLINTNEXTLINE(readability-identifier-naming)    Rationale: Naming scheme fixed due to linker wrapping.
+int __wrap_cominitTpmBlobNvSave(ESYS_CONTEXT *ectx, TPM2_HANDLE nvIndex, const cominitTpmBlob_t *blob);
+
+#endif /* __MOCK_COMINIT_TPMBLOBNVSAVE_H__ */
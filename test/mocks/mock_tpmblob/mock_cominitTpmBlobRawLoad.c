@@ -0,0 +1,26 @@
+// SPDX-License-Identifier: MIT
+/**
+ * @file mock_cominitTpmBlobRawLoad.c
+ * @brief Implementation of a mock function for cominitTpmBlobRawLoad() using cmocka.
+ */
+#include "mock_cominitTpmBlobRawLoad.h"
+
+#include <string.h>
+
+#include "unit_test.h"
+
+// NOLINTNEXTLINE(readability-identifier-naming)    Rationale: Naming scheme fixed due to linker wrapping.
+int __wrap_cominitTpmBlobRawLoad(cominitTpmBlob_t *blob, const char *device, bool *empty) {
+    check_expected_ptr(blob);
+    check_expected_ptr(device);
+
+    const cominitTpmBlob_t *loaded = mock_ptr_type(const cominitTpmBlob_t *);
+    if (loaded != NULL && blob != NULL) {
+        memcpy(blob, loaded, sizeof(*blob));
+    }
+    if (empty != NULL) {
+        *empty = (loaded == NULL);
+    }
+
+    return mock_type(int);
+}
@@ -0,0 +1,20 @@
+// SPDX-License-Identifier: MIT
+/**
+ * @file mock_cominitTpmBlobRawLoad.h
+ * @brief Header declaring a mock function for cominitTpmBlobRawLoad().
+ */
+#ifndef __MOCK_COMINIT_TPMBLOBRAWLOAD_H__
+#define __MOCK_COMINIT_TPMBLOBRAWLOAD_H__
+
+#include "tpmblob.h"
+
+/**
+ * Mock function for cominitTpmBlobRawLoad().
+ *
+ * Implemented using cmocka. Inputs may be checked and return code set using cmocka API. The blob passed via
+ * will_return() is copied to \a blob, a NULL pointer reports an empty partition.
+ */
+// NOLINTNEXTLINE(readability-identifier-naming)    Rationale: Naming scheme fixed due to linker wrapping.
+int __wrap_cominitTpmBlobRawLoad(cominitTpmBlob_t *blob, const char *device, bool *empty);
+
+#endif /* __MOCK_COMINIT_TPMBLOBRAWLOAD_H__ */
@@ -0,0 +1,16 @@
+// SPDX-License-Identifier: MIT
+/**
+ * @file mock_cominitTpmBlobRawSave.c
+ * @brief Implementation of a mock function for cominitTpmBlobRawSave() using cmocka.
+ */
+#include "mock_cominitTpmBlobRawSave.h"
+
+#include "unit_test.h"
+
+// NOLINTNEXTLINE(readability-identifier-naming)    Rationale: Naming scheme fixed due to linker wrapping.
+int __wrap_cominitTpmBlobRawSave(const cominitTpmBlob_t *blob, const char *device) {
+    check_expected_ptr(blob);
+    check_expected_ptr(device);
+
+    return mock_type(int);
+}
@@ -0,0 +1,20 @@
+// SPDX-License-Identifier: MIT
+/**
+ * @file mock_cominitTpmBlobRawSave.h
+ * @brief Header declaring a mock function for cominitTpmBlobRawSave().
+ */
+#ifndef __MOCK_COMINIT_TPMBLOBRAWSAVE_H__
+#define __MOCK_COMINIT_TPMBLOBRAWSAVE_H__
+
+#include "tpmblob.h"
+
+/**
+ * Mock function for cominitTpmBlobRawSave().
+ *
+ * Implemented using cmocka. Inputs may be checked and return code set using cmocka API. Otherwise the function is a
+ * no-op.
+ */
+// NOLINTNEXTLINE(readability-identifier-naming)    Rationale: Naming scheme fixed due to linker wrapping.
+int __wrap_cominitTpmBlobRawSave(const cominitTpmBlob_t *blob, const char *device);
+
+#endif /* __MOCK_COMINIT_TPMBLOBRAWSAVE_H__ */
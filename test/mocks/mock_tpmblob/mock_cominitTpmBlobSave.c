@@ -0,0 +1,16 @@
+// SPDX-License-Identifier: MIT
+/**
+ * @file mock_cominitTpmBlobSave.c
+ * @brief Implementation of a mock function for cominitTpmBlobSave() using cmocka.
+ */
+#include "mock_cominitTpmBlobSave.h"
+
+#include "unit_test.h"
+
+// NOLINTNEXTLINE(readability-identifier-naming)    Rationale: Naming scheme fixed due to linker wrapping.
+int __wrap_cominitTpmBlobSave(const cominitTpmBlob_t *blob, const char *path) {
+    check_expected_ptr(blob);
+    check_expected_ptr(path);
+
+    return mock_type(int);
+}
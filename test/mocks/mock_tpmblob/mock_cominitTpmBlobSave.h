@@ -0,0 +1,20 @@
+// SPDX-License-Identifier: MIT
+/**
+ * @file mock_cominitTpmBlobSave.h
+ * @brief Header declaring a mock function for cominitTpmBlobSave().
+ */
+#ifndef __MOCK_COMINIT_TPMBLOBSAVE_H__
+#define __MOCK_COMINIT_TPMBLOBSAVE_H__
+
+#include "tpmblob.h"
+
+/**
+ * Mock function for cominitTpmBlobSave().
+ *
+ * Implemented using cmocka. Inputs may be checked and return code set using cmocka API. Otherwise the function is a
+ * no-op.
+ */
+// NOLINTNEXTLINE(readability-identifier-naming)    Rationale: Naming scheme fixed due to linker wrapping.
+int __wrap_cominitTpmBlobSave(const cominitTpmBlob_t *blob, const char *path);
+
+#endif /* __MOCK_COMINIT_TPMBLOBSAVE_H__ */
@@ -0,0 +1,50 @@
+#!/bin/bash
+# SPDX-License-Identifier: MIT
+#
+# Run cominit-tpmbench against a locally spawned software TPM.
+#
+# Usage: run-tpmbench.sh <path to cominit-tpmbench> [iterations]
+#
+# swtpm is started with TPM2_Startup already done, as cominit expects the firmware to have started up the TPM. The TPM
+# state lives in a temporary directory that is removed afterwards. Exits with 77 (skipped) if swtpm is not installed.
+#
+set -eu
+
+BENCH="${1:?path to cominit-tpmbench required}"
+ITERATIONS="${2:-10}"
+PORT="${TPMBENCH_PORT:-2321}"
+
+WORKDIR=$(mktemp -d)
+TPM_PID=""
+
+cleanup() {
+    if [ -n "${TPM_PID}" ]; then
+        kill "${TPM_PID}" 2>/dev/null || true
+        wait "${TPM_PID}" 2>/dev/null || true
+    fi
+    rm -rf "${WORKDIR}"
+}
+trap cleanup EXIT
+
+if ! command -v swtpm >/dev/null; then
+    echo "swtpm not found, skipping TPM benchmark"
+    exit 77
+fi
+
+swtpm socket --tpm2 --tpmstate dir="${WORKDIR}" \
+    --server type=tcp,port="${PORT}" --ctrl type=tcp,port="$((PORT + 1))" \
+    --flags not-need-init,startup-clear &
+TPM_PID=$!
+
+openssl genpkey -algorithm RSA -pkeyopt rsa_keygen_bits:2048 -out "${WORKDIR}/key.pem" 2>/dev/null
+openssl pkey -in "${WORKDIR}/key.pem" -pubout -out "${WORKDIR}/key_pub.pem"
+
+# Give the simulator some time to open its sockets.
+for _ in $(seq 50); do
+    if (exec 3<>"/dev/tcp/127.0.0.1/${PORT}") 2>/dev/null; then
+        break
+    fi
+    sleep 0.1
+done
+
+"${BENCH}" -t "swtpm:host=127.0.0.1,port=${PORT}" -k "${WORKDIR}/key_pub.pem" -n "${ITERATIONS}"
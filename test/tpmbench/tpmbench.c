@@ -0,0 +1,207 @@
+// SPDX-License-Identifier: MIT
+/**
+ * @file tpmbench.c
+ * @brief End-to-end benchmark of the cominit TPM flows against a TPM reachable through a TCTI, e.g. swtpm.
+ */
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+#include "common.h"
+#include "output.h"
+#include "stats.h"
+#include "tpm.h"
+
+#define COMINIT_TPMBENCH_PCR 16               ///< The debug PCR, which can be reset from locality 0.
+#define COMINIT_TPMBENCH_DEFAULT_ITERATIONS 10  ///< Number of iterations if not given on the command line.
+
+/**
+ * The measured steps of one iteration.
+ */
+typedef enum {
+    BenchInit = 0,       ///< cominitInitTpm(): TCTI and ESYS setup and self-test.
+    BenchSeal,           ///< cominitTpmSeal(): PCR read, policy digest, primary key and sealed object creation.
+    BenchUnseal,         ///< cominitTpmUnseal(): load, policy session and unseal.
+    BenchExtend,         ///< cominitTpmExtendPCR(): hashing the key file and extending the PCR.
+    BenchPolicyFailure,  ///< cominitTpmUnseal() after the PCR changed, must fail the policy check.
+    BenchStepCount,      ///< The number of steps.
+} cominitTpmbenchStep_t;
+
+/**
+ * Names of the steps in the report, indexed by cominitTpmbenchStep_t.
+ */
+static const char *cominitTpmbenchStepNames[BenchStepCount] = {
+    "init", "seal", "unseal", "pcr-extend", "policy-failure",
+};
+
+/**
+ * The percentiles of the durations in the report, minimum, median, 95th percentile and maximum.
+ */
+static const unsigned int cominitTpmbenchPercentiles[] = {0, 50, 95, 100};
+
+/**
+ * Prints minimum, median, 95th percentile and maximum of the durations of each step in microseconds.
+ *
+ * @param samples     The durations in nanoseconds, \a iterations per step.
+ * @param iterations  The number of completed iterations.
+ */
+static void cominitTpmbenchReport(uint64_t *samples[BenchStepCount], size_t iterations) {
+    cominitStatsPrintHeader("step [us]", 16, cominitTpmbenchPercentiles, ARRAY_SIZE(cominitTpmbenchPercentiles));
+    for (size_t s = 0; s < BenchStepCount; s++) {
+        cominitStatsPrintRow(cominitTpmbenchStepNames[s], 16, samples[s], iterations, cominitTpmbenchPercentiles,
+                             ARRAY_SIZE(cominitTpmbenchPercentiles));
+    }
+}
+
+/**
+ * Runs one iteration of all steps and records the duration of each.
+ *
+ * The benchmark PCR is reset first, so every iteration seals to the same state.
+ *
+ * @param argCtx   The options passed to the cominit TPM functions.
+ * @param keyfile  The public key PEM file measured into the PCR.
+ * @param samples  Array receiving the duration of each step in nanoseconds.
+ *
+ * @return  EXIT_SUCCESS if every step had the expected result, EXIT_FAILURE otherwise
+ */
+static int cominitTpmbenchIteration(cominitCliArgs_t *argCtx, const char *keyfile, uint64_t samples[BenchStepCount]) {
+    int result = EXIT_FAILURE;
+    cominitTpmContext_t tpmCtx = {0};
+    cominitTpmBlob_t blob = {0};
+    uint64_t start = cominitStatsNow();
+
+    if (cominitInitTpm(&tpmCtx, argCtx) != EXIT_SUCCESS) {
+        fprintf(stderr, "TPM init failed\n");
+    } else {
+        samples[BenchInit] = cominitStatsNow() - start;
+
+        if (Esys_PCR_Reset(tpmCtx.esysCtx, ESYS_TR_PCR0 + COMINIT_TPMBENCH_PCR, ESYS_TR_PASSWORD, ESYS_TR_NONE,
+                           ESYS_TR_NONE) != TSS2_RC_SUCCESS) {
+            fprintf(stderr, "Resetting PCR %d failed\n", COMINIT_TPMBENCH_PCR);
+        } else {
+            start = cominitStatsNow();
+            if (cominitTpmSeal(tpmCtx.esysCtx, &blob, argCtx) != EXIT_SUCCESS) {
+                fprintf(stderr, "Sealing failed\n");
+            } else {
+                samples[BenchSeal] = cominitStatsNow() - start;
+
+                start = cominitStatsNow();
+                if (cominitTpmUnseal(tpmCtx.esysCtx, &blob, argCtx) != Unsealed) {
+                    fprintf(stderr, "Unsealing failed\n");
+                } else {
+                    samples[BenchUnseal] = cominitStatsNow() - start;
+
+                    start = cominitStatsNow();
+                    if (cominitTpmExtendPCR(&tpmCtx, keyfile, COMINIT_TPMBENCH_PCR) != EXIT_SUCCESS) {
+                        fprintf(stderr, "Extending PCR %d failed\n", COMINIT_TPMBENCH_PCR);
+                    } else {
+                        samples[BenchExtend] = cominitStatsNow() - start;
+
+                        start = cominitStatsNow();
+                        if (cominitTpmUnseal(tpmCtx.esysCtx, &blob, argCtx) != TpmPolicyFailure) {
+                            fprintf(stderr, "Unsealing after PCR extension did not fail the policy check\n");
+                        } else {
+                            samples[BenchPolicyFailure] = cominitStatsNow() - start;
+                            result = EXIT_SUCCESS;
+                        }
+                    }
+                }
+            }
+        }
+        cominitDeleteTpm(&tpmCtx);
+    }
+
+    return result;
+}
+
+/**
+ * Prints the usage of the benchmark to stderr.
+ *
+ * @param name  The name of the executable.
+ */
+static void cominitTpmbenchUsage(const char *name) {
+    fprintf(stderr,
+            "USAGE: %s -k <public key PEM> [-t <TCTI>] [-n <iterations>]\n"
+            "       Runs the cominit seal, unseal, PCR extension and policy failure flows against the TPM given by\n"
+            "       the TCTI (default '%s') and reports the latency of each step. Uses PCR %d, the primary key\n"
+            "       handle 0x%08x and the user keyring, so only run it against a software TPM.\n",
+            name, COMINIT_TPM_TCTI, COMINIT_TPMBENCH_PCR, COMINIT_TPM_PRIMARY_HANDLE);
+}
+
+/**
+ * Main function of the TPM benchmark.
+ *
+ * @return  EXIT_SUCCESS if all iterations succeeded, EXIT_FAILURE otherwise
+ */
+int main(int argc, char *argv[]) {
+    int result = EXIT_SUCCESS;
+    const char *keyfile = NULL;
+    unsigned long iterations = COMINIT_TPMBENCH_DEFAULT_ITERATIONS;
+    uint64_t *samples[BenchStepCount] = {NULL};
+    cominitCliArgs_t argCtx = {.pcrSeal = {COMINIT_TPMBENCH_PCR},
+                               .pcrSealCount = 1,
+                               .tpmPrimaryHandle = COMINIT_TPM_PRIMARY_HANDLE,
+                               .tpmFullSelftest = false,
+                               .tpmTcti[0] = '\0'};
+    int opt;
+
+    while ((opt = getopt(argc, argv, "k:t:n:h")) != -1) {
+        switch (opt) {
+            case 'k':
+                keyfile = optarg;
+                break;
+            case 't':
+                if (cominitTpmParseTcti(&argCtx, optarg) != EXIT_SUCCESS) {
+                    result = EXIT_FAILURE;
+                }
+                break;
+            case 'n':
+                iterations = strtoul(optarg, NULL, 10);
+                break;
+            case 'h':
+            default:
+                result = EXIT_FAILURE;
+                break;
+        }
+    }
+
+    if (result != EXIT_SUCCESS || keyfile == NULL || iterations == 0) {
+        cominitTpmbenchUsage(argv[0]);
+        return EXIT_FAILURE;
+    }
+
+    cominitOutputSetVisibleLogLevel(COMINIT_LOG_LEVEL_ERR);
+
+    for (size_t s = 0; s < BenchStepCount && result == EXIT_SUCCESS; s++) {
+        samples[s] = calloc(iterations, sizeof(uint64_t));
+        if (samples[s] == NULL) {
+            perror("calloc failed");
+            result = EXIT_FAILURE;
+        }
+    }
+
+    size_t done = 0;
+    for (; done < iterations && result == EXIT_SUCCESS; done++) {
+        uint64_t iterationSamples[BenchStepCount] = {0};
+        result = cominitTpmbenchIteration(&argCtx, keyfile, iterationSamples);
+        for (size_t s = 0; s < BenchStepCount && result == EXIT_SUCCESS; s++) {
+            samples[s][done] = iterationSamples[s];
+        }
+    }
+
+    if (result == EXIT_SUCCESS) {
+        const char *tcti = (argCtx.tpmTcti[0] != '\0') ? argCtx.tpmTcti : COMINIT_TPM_TCTI;
+        printf("%zu iterations against TCTI '%s'\n", done, tcti);
+        cominitTpmbenchReport(samples, done);
+    } else {
+        fprintf(stderr, "Iteration %zu failed\n", done);
+    }
+
+    for (size_t s = 0; s < BenchStepCount; s++) {
+        free(samples[s]);
+    }
+
+    return result;
+}
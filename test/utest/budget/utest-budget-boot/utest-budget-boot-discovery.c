@@ -0,0 +1,46 @@
+// SPDX-License-Identifier: MIT
+/**
+ * @file utest-budget-boot-discovery.c
+ * @brief Implementation of the syscall and allocation budget unit test for rootfs discovery.
+ */
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "unit_test.h"
+#include "utest-budget-boot.h"
+
+void cominitBudgetBootTestDiscovery(void **state) {
+    COMINIT_PARAM_UNUSED(state);
+
+    static const unsigned diskCounts[] = {1, 4, 16};
+    static const uint32_t entryCounts[] = {128, 256};
+
+    for (size_t d = 0; d < ARRAY_SIZE(diskCounts); d++) {
+        for (size_t e = 0; e < ARRAY_SIZE(entryCounts); e++) {
+            unsigned disks = diskCounts[d];
+            uint32_t entries = entryCounts[e];
+            cominitGPTDisk_t disk = {0};
+            char partition[COMINIT_ROOTFS_DEV_PATH_MAX] = {0};
+            char expected[COMINIT_ROOTFS_DEV_PATH_MAX] = {0};
+            snprintf(expected, sizeof(expected), "/dev/sd%c%u", 'a' + disks - 1, (unsigned)entries);
+
+            cominitBudgetStart(disks, entries, "");
+            int result = cominitAutomountFindPartition(&disk, COMINIT_ROOTFS_GUID_TYPE, partition, sizeof(partition));
+            cominitBudgetStop();
+
+            assert_int_equal(result, EXIT_SUCCESS);
+            assert_string_equal(partition, expected);
+
+            assert_int_equal(cominitBudgetCount.opendir, 1);
+            assert_int_equal(cominitBudgetCount.closedir, 1);
+            assert_true(cominitBudgetCount.lstat <= disks + COMINIT_BUDGET_OTHER_NODES);
+            assert_true(cominitBudgetCount.open <= disks * COMINIT_BUDGET_OPENS_PER_DISK);
+            assert_int_equal(cominitBudgetCount.close, cominitBudgetCount.open);
+            assert_true(cominitBudgetCount.ioctl <= cominitBudgetCount.open);
+            assert_true(cominitBudgetCount.pread <= disks * COMINIT_BUDGET_PREADS_PER_DISK(entries));
+            assert_int_equal(cominitBudgetCount.malloc, 0);
+            assert_int_equal(cominitBudgetCount.free, 0);
+        }
+    }
+}
@@ -0,0 +1,64 @@
+// SPDX-License-Identifier: MIT
+/**
+ * @file utest-budget-boot-metadata.c
+ * @brief Implementation of the syscall and allocation budget unit tests for loading the rootfs metadata.
+ */
+#include <stdlib.h>
+#include <string.h>
+
+#include "unit_test.h"
+#include "utest-budget-boot.h"
+
+#define TEST_ROOTFS_PARTITION "/dev/sda128"
+#define TEST_ROOTFS_ENTRIES 128
+
+#define TEST_VERITY_METADATA                                                                            \
+    "1 squashfs ro verity\xff"                                                                          \
+    "1 4096 4096 200 201 sha256 0000000000000000000000000000000000000000000000000000000000000001 "     \
+    "0000000000000000000000000000000000000000000000000000000000000002\xff"
+
+#define TEST_INTEGRITY_METADATA \
+    "1 ext4 rw integrity\xff"   \
+    "978936 512 2 internal_hash:hmac(sha256)::dm-integrity-hmac-secret fix_padding\xff"
+
+/**
+ * Loads the metadata of the simulated rootfs partition and checks the budget every metadata format shares: one open,
+ * one size query, one read of the metadata region, one signature verification and no heap allocation.
+ *
+ * @param metadata  The metadata string of the rootfs partition.
+ * @param meta      The metadata structure to fill.
+ */
+static void cominitBudgetBootLoadMetadata(const char *metadata, cominitRfsMetaData_t *meta) {
+    strcpy(meta->devicePath, TEST_ROOTFS_PARTITION);
+
+    cominitBudgetStart(1, TEST_ROOTFS_ENTRIES, metadata);
+    int result = cominitLoadVerifyMetadata(meta, COMINIT_ROOTFS_KEY_LOCATION);
+    cominitBudgetStop();
+
+    assert_int_equal(result, 0);
+    assert_int_equal(cominitBudgetCount.open, 1);
+    assert_int_equal(cominitBudgetCount.close, 1);
+    assert_int_equal(cominitBudgetCount.ioctl, 1);
+    assert_int_equal(cominitBudgetCount.pread, 1);
+    assert_int_equal(cominitBudgetCount.verify, 1);
+    assert_int_equal(cominitBudgetCount.malloc, 0);
+    assert_int_equal(cominitBudgetCount.free, 0);
+}
+
+void cominitBudgetBootTestMetadataVerity(void **state) {
+    COMINIT_PARAM_UNUSED(state);
+    static cominitRfsMetaData_t meta;
+
+    cominitBudgetBootLoadMetadata(TEST_VERITY_METADATA, &meta);
+    assert_int_equal(meta.crypt, COMINIT_CRYPTOPT_VERITY);
+    assert_int_equal(cominitBudgetCount.keyring, 0);
+}
+
+void cominitBudgetBootTestMetadataIntegrity(void **state) {
+    COMINIT_PARAM_UNUSED(state);
+    static cominitRfsMetaData_t meta;
+
+    cominitBudgetBootLoadMetadata(TEST_INTEGRITY_METADATA, &meta);
+    assert_int_equal(meta.crypt, COMINIT_CRYPTOPT_INTEGRITY);
+    assert_int_equal(cominitBudgetCount.keyring, 1);
+}
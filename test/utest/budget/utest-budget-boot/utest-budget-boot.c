@@ -0,0 +1,286 @@
+// SPDX-License-Identifier: MIT
+/**
+ * @file utest-budget-boot.c
+ * @brief Implementation of the simulated devices and the counting wrappers of the boot budget unit test group.
+ */
+#include "utest-budget-boot.h"
+
+#include <dirent.h>
+#include <endian.h>
+#include <errno.h>
+#include <linux/fs.h>
+#include <stdarg.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/stat.h>
+
+#include "unit_test.h"
+
+#define COMINIT_BUDGET_DEV "/dev"         ///< Directory scanned for disks.
+#define COMINIT_BUDGET_DISK_PREFIX "sd"  ///< Name prefix of all simulated disks.
+#define COMINIT_BUDGET_DISK_FD 100       ///< File descriptor of the first simulated disk.
+#define COMINIT_BUDGET_PART_FD 300       ///< File descriptor of the simulated rootfs partition.
+
+/** Raw type GUID of the rootfs, #COMINIT_ROOTFS_GUID_TYPE. **/
+static const uint8_t cominitBudgetRootfsGuid[16] = {0x45, 0xb0, 0x21, 0xb9, 0xf0, 0x1d, 0xc3, 0x41,
+                                                    0xaf, 0x44, 0x4c, 0x6f, 0x28, 0x0d, 0x3f, 0xae};
+/** Raw type GUID of a Linux data partition, 0fc63daf-8483-4772-8e79-3d69d8477de4. **/
+static const uint8_t cominitBudgetDataGuid[16] = {0xaf, 0x3d, 0xc6, 0x0f, 0x83, 0x84, 0x72, 0x47,
+                                                  0x8e, 0x79, 0x3d, 0x69, 0xd8, 0x47, 0x7d, 0xe4};
+
+/** Nodes of the simulated /dev besides the disks, `loop0` is skipped by name, `console` by its type. **/
+static const char *const cominitBudgetOtherNodes[] = {".", "..", "console", "loop0"};
+
+cominitBudgetCounters_t cominitBudgetCount;
+
+static bool cominitBudgetCounting = false;
+static unsigned cominitBudgetDiskCount;
+static uint32_t cominitBudgetEntryCount;
+static uint8_t cominitBudgetMetaRegion[COMINIT_PART_META_DATA_SIZE];
+static struct dirent cominitBudgetDirents[ARRAY_SIZE(cominitBudgetOtherNodes) + COMINIT_BUDGET_DISKS_MAX];
+static size_t cominitBudgetDirentCount;
+static size_t cominitBudgetDirentPos;
+static int cominitBudgetDirHandle;
+
+void *__real_malloc(size_t size);               // NOLINT(readability-identifier-naming)
+void *__real_calloc(size_t nmemb, size_t size);  // NOLINT(readability-identifier-naming)
+void __real_free(void *ptr);                     // NOLINT(readability-identifier-naming)
+
+void cominitBudgetStart(unsigned diskCount, uint32_t entryCount, const char *metadata) {
+    assert_true(diskCount > 0 && diskCount <= COMINIT_BUDGET_DISKS_MAX);
+    assert_true(strlen(metadata) < COMINIT_PART_META_STR_MAX);
+
+    cominitBudgetDiskCount = diskCount;
+    cominitBudgetEntryCount = entryCount;
+
+    memset(cominitBudgetMetaRegion, 0, sizeof(cominitBudgetMetaRegion));
+    strcpy((char *)cominitBudgetMetaRegion, metadata);
+    memset(cominitBudgetMetaRegion + strlen(metadata) + 1, 0xa5, COMINIT_PART_META_SIG_LENGTH);
+
+    memset(cominitBudgetDirents, 0, sizeof(cominitBudgetDirents));
+    cominitBudgetDirentCount = 0;
+    for (size_t i = 0; i < ARRAY_SIZE(cominitBudgetOtherNodes); i++) {
+        strcpy(cominitBudgetDirents[cominitBudgetDirentCount++].d_name, cominitBudgetOtherNodes[i]);
+    }
+    for (unsigned i = 0; i < diskCount; i++) {
+        snprintf(cominitBudgetDirents[cominitBudgetDirentCount++].d_name, sizeof(cominitBudgetDirents[0].d_name),
+                 COMINIT_BUDGET_DISK_PREFIX "%c", 'a' + i);
+    }
+
+    memset(&cominitBudgetCount, 0, sizeof(cominitBudgetCount));
+    cominitBudgetCounting = true;
+}
+
+void cominitBudgetStop(void) {
+    cominitBudgetCounting = false;
+}
+
+/**
+ * Copies the part of a simulated on-disk object that overlaps a read.
+ *
+ * @param buf        The read buffer.
+ * @param count      The size of the read.
+ * @param offset     The offset of the read.
+ * @param src        The simulated object.
+ * @param srcLen     The size of \a src.
+ * @param srcOffset  The offset of \a src on the device.
+ */
+static void cominitBudgetCopy(uint8_t *buf, size_t count, off_t offset, const void *src, size_t srcLen,
+                              off_t srcOffset) {
+    off_t readEnd = offset + (off_t)count;
+    off_t srcEnd = srcOffset + (off_t)srcLen;
+    off_t start = (offset > srcOffset) ? offset : srcOffset;
+    off_t end = (readEnd < srcEnd) ? readEnd : srcEnd;
+    if (start < end) {
+        memcpy(buf + (start - offset), (const uint8_t *)src + (start - srcOffset), (size_t)(end - start));
+    }
+}
+
+/**
+ * Simulates a read from the GPT header or the partition entry array of a disk.
+ */
+static void cominitBudgetReadDisk(unsigned disk, uint8_t *buf, size_t count, off_t offset) {
+    cominitGPTHeader_t hdr = {0};
+    memcpy(hdr.signature, "EFI PART", sizeof(hdr.signature));
+    hdr.partitionEntriesLba = htole64(COMINIT_BUDGET_ENTRIES_LBA);
+    hdr.partitionEntryCount = htole32(cominitBudgetEntryCount);
+    hdr.partitionEntrySize = htole32(GPT_HEADER_DEFAULT_ENTRY_SIZE);
+    cominitBudgetCopy(buf, count, offset, &hdr, sizeof(hdr), COMINIT_BUDGET_BLOCK_SIZE);
+
+    off_t tableOffset = COMINIT_BUDGET_ENTRIES_LBA * COMINIT_BUDGET_BLOCK_SIZE;
+    for (uint32_t i = 0; i < cominitBudgetEntryCount; i++) {
+        off_t entryOffset = tableOffset + (off_t)i * GPT_HEADER_DEFAULT_ENTRY_SIZE;
+        if (entryOffset >= (off_t)(offset + count)) {
+            break;
+        }
+        if (entryOffset + GPT_HEADER_DEFAULT_ENTRY_SIZE <= offset) {
+            continue;
+        }
+        uint8_t entry[GPT_HEADER_DEFAULT_ENTRY_SIZE] = {0};
+        bool rootfs = (disk == cominitBudgetDiskCount - 1 && i == cominitBudgetEntryCount - 1);
+        memcpy(entry + COMINIT_GPT_ENTRY_TYPE_GUID_OFFSET, rootfs ? cominitBudgetRootfsGuid : cominitBudgetDataGuid,
+               16);
+        memcpy(entry + COMINIT_GPT_ENTRY_UNIQUE_GUID_OFFSET, &i, sizeof(i));
+        cominitBudgetCopy(buf, count, offset, entry, sizeof(entry), entryOffset);
+    }
+}
+
+// NOLINTNEXTLINE(readability-identifier-naming)    Rationale: Naming scheme fixed due to linker wrapping.
+DIR *__wrap_opendir(const char *name) {
+    cominitBudgetCount.opendir++;
+    assert_string_equal(name, COMINIT_BUDGET_DEV);
+    cominitBudgetDirentPos = 0;
+    return (DIR *)&cominitBudgetDirHandle;
+}
+
+// NOLINTNEXTLINE(readability-identifier-naming)    Rationale: Naming scheme fixed due to linker wrapping.
+struct dirent *__wrap_readdir(DIR *dirp) {
+    cominitBudgetCount.readdir++;
+    assert_ptr_equal(dirp, &cominitBudgetDirHandle);
+    return (cominitBudgetDirentPos < cominitBudgetDirentCount) ? &cominitBudgetDirents[cominitBudgetDirentPos++]
+                                                                 : NULL;
+}
+
+// NOLINTNEXTLINE(readability-identifier-naming)    Rationale: Naming scheme fixed due to linker wrapping.
+int __wrap_closedir(DIR *dirp) {
+    cominitBudgetCount.closedir++;
+    assert_ptr_equal(dirp, &cominitBudgetDirHandle);
+    return 0;
+}
+
+// NOLINTNEXTLINE(readability-identifier-naming)    Rationale: Naming scheme fixed due to linker wrapping.
+int __wrap_lstat(const char *restrict path, struct stat *restrict buf) {
+    const char *prefix = COMINIT_BUDGET_DEV "/" COMINIT_BUDGET_DISK_PREFIX;
+
+    cominitBudgetCount.lstat++;
+    *buf = (struct stat){0};
+    if (strncmp(path, prefix, strlen(prefix)) == 0) {
+        buf->st_mode = S_IFBLK | 0600;
+    } else {
+        buf->st_mode = S_IFCHR | 0600;
+    }
+    return 0;
+}
+
+// NOLINTNEXTLINE(readability-identifier-naming)    Rationale: Naming scheme fixed due to linker wrapping.
+int __wrap_open(const char *path, int flags, ...) {
+    const char *prefix = COMINIT_BUDGET_DEV "/" COMINIT_BUDGET_DISK_PREFIX;
+    COMINIT_PARAM_UNUSED(flags);
+
+    cominitBudgetCount.open++;
+    if (strncmp(path, prefix, strlen(prefix)) == 0) {
+        const char *name = path + strlen(prefix);
+        unsigned disk = (unsigned)(name[0] - 'a');
+        if (disk < cominitBudgetDiskCount && name[1] == '\0') {
+            return COMINIT_BUDGET_DISK_FD + (int)disk;
+        }
+        if (disk == cominitBudgetDiskCount - 1 && strtoul(name + 1, NULL, 10) == cominitBudgetEntryCount) {
+            return COMINIT_BUDGET_PART_FD;
+        }
+    }
+    errno = ENOENT;
+    return -1;
+}
+
+// NOLINTNEXTLINE(readability-identifier-naming)    Rationale: Naming scheme fixed due to linker wrapping.
+int __wrap_close(int fd) {
+    cominitBudgetCount.close++;
+    assert_true(fd == COMINIT_BUDGET_PART_FD ||
+                (fd >= COMINIT_BUDGET_DISK_FD && fd < COMINIT_BUDGET_DISK_FD + (int)cominitBudgetDiskCount));
+    return 0;
+}
+
+// NOLINTNEXTLINE(readability-identifier-naming)    Rationale: Naming scheme fixed due to linker wrapping.
+int __wrap_ioctl(int fd, unsigned long request, ...) {
+    va_list ap;
+    int result = 0;
+
+    cominitBudgetCount.ioctl++;
+    va_start(ap, request);
+    switch (request) {
+        case BLKSSZGET:
+            *va_arg(ap, int *) = COMINIT_BUDGET_BLOCK_SIZE;
+            break;
+        case BLKGETSIZE64:
+            *va_arg(ap, uint64_t *) =
+                (fd == COMINIT_BUDGET_PART_FD) ? COMINIT_BUDGET_PART_SIZE : COMINIT_BUDGET_DISK_SIZE;
+            break;
+        default:
+            errno = ENOTTY;
+            result = -1;
+            break;
+    }
+    va_end(ap);
+
+    return result;
+}
+
+// NOLINTNEXTLINE(readability-identifier-naming)    Rationale: Naming scheme fixed due to linker wrapping.
+ssize_t __wrap_pread(int fd, void *buf, size_t count, off_t offset) {
+    cominitBudgetCount.pread++;
+    memset(buf, 0, count);
+    if (fd == COMINIT_BUDGET_PART_FD) {
+        cominitBudgetCopy(buf, count, offset, cominitBudgetMetaRegion, sizeof(cominitBudgetMetaRegion),
+                          (off_t)(COMINIT_BUDGET_PART_SIZE - COMINIT_PART_META_DATA_SIZE));
+    } else {
+        cominitBudgetReadDisk((unsigned)(fd - COMINIT_BUDGET_DISK_FD), buf, count, offset);
+    }
+    return (ssize_t)count;
+}
+
+// NOLINTNEXTLINE(readability-identifier-naming)    Rationale: Naming scheme fixed due to linker wrapping.
+void *__wrap_malloc(size_t size) {
+    if (cominitBudgetCounting) {
+        cominitBudgetCount.malloc++;
+    }
+    return __real_malloc(size);
+}
+
+// NOLINTNEXTLINE(readability-identifier-naming)    Rationale: Naming scheme fixed due to linker wrapping.
+void *__wrap_calloc(size_t nmemb, size_t size) {
+    if (cominitBudgetCounting) {
+        cominitBudgetCount.malloc++;
+    }
+    return __real_calloc(nmemb, size);
+}
+
+// NOLINTNEXTLINE(readability-identifier-naming)    Rationale: Naming scheme fixed due to linker wrapping.
+void __wrap_free(void *ptr) {
+    if (cominitBudgetCounting && ptr != NULL) {
+        cominitBudgetCount.free++;
+    }
+    __real_free(ptr);
+}
+
+// NOLINTNEXTLINE(readability-identifier-naming)    Rationale: Naming scheme fixed due to linker wrapping.
+int __wrap_cominitCryptoVerifySignature(const uint8_t *data, size_t dataLen, const uint8_t *signature,
+                                        const char *keyfile) {
+    COMINIT_PARAM_UNUSED(keyfile);
+    cominitBudgetCount.verify++;
+    assert_int_equal(dataLen, strlen((const char *)data) + 1);
+    assert_int_equal(signature[0], 0xa5);
+    return 0;
+}
+
+// NOLINTNEXTLINE(readability-identifier-naming)    Rationale: Naming scheme fixed due to linker wrapping.
+ssize_t __wrap_cominitKeyringGetKey(uint8_t *key, size_t keyMaxLen, char *keyDesc) {
+    COMINIT_PARAM_UNUSED(keyDesc);
+    cominitBudgetCount.keyring++;
+    memset(key, 0x5a, (keyMaxLen < 32) ? keyMaxLen : 32);
+    return 32;
+}
+
+/**
+ * Run the boot budget unit tests.
+ *
+ * @return  The same as cmocka_run_group_tests() returns for the tests.
+ */
+int main(void) {
+    const struct CMUnitTest tests[] = {
+        cmocka_unit_test(cominitBudgetBootTestDiscovery),
+        cmocka_unit_test(cominitBudgetBootTestMetadataVerity),
+        cmocka_unit_test(cominitBudgetBootTestMetadataIntegrity),
+    };
+    return cmocka_run_group_tests(tests, NULL, NULL);
+}
@@ -0,0 +1,88 @@
+// SPDX-License-Identifier: MIT
+/**
+ * @file utest-budget-boot.h
+ * @brief Header declaring cmocka unit tests for the syscall and allocation budget of the boot phases.
+ */
+#ifndef __UTEST_BUDGET_BOOT_H__
+#define __UTEST_BUDGET_BOOT_H__
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#include "automount.h"
+#include "common.h"
+#include "meta.h"
+
+#define COMINIT_BUDGET_DISKS_MAX 16                      ///< Maximum number of simulated disks.
+#define COMINIT_BUDGET_DISK_SIZE (64ULL * 1024 * 1024)  ///< Size of every simulated disk.
+#define COMINIT_BUDGET_PART_SIZE (32ULL * 1024 * 1024)  ///< Size of the simulated rootfs partition.
+#define COMINIT_BUDGET_BLOCK_SIZE 512                    ///< Logical block size of every simulated disk.
+#define COMINIT_BUDGET_ENTRIES_LBA 2                     ///< LBA of the partition entry array on every disk.
+#define COMINIT_BUDGET_OTHER_NODES 1  ///< Number of nodes in the simulated /dev that are neither disks nor skipped.
+
+/** Maximum number of opened files per probed disk, one to find the GPT and one to search its entries. **/
+#define COMINIT_BUDGET_OPENS_PER_DISK 2
+/** Maximum number of preads per probed disk, one for the GPT header and as few as possible for the entry array. **/
+#define COMINIT_BUDGET_PREADS_PER_DISK(entryCount)                                             \
+    (1 + ((entryCount) * GPT_HEADER_DEFAULT_ENTRY_SIZE + COMINIT_GPT_ENTRY_READ_SIZE - 1) / \
+             COMINIT_GPT_ENTRY_READ_SIZE)
+
+/**
+ * Number of calls to the counted functions since cominitBudgetStart().
+ */
+typedef struct cominitBudgetCounters {
+    size_t opendir;   ///< Calls to opendir().
+    size_t readdir;   ///< Calls to readdir().
+    size_t closedir;  ///< Calls to closedir().
+    size_t lstat;     ///< Calls to lstat().
+    size_t open;      ///< Calls to open().
+    size_t close;     ///< Calls to close().
+    size_t pread;     ///< Calls to pread().
+    size_t ioctl;     ///< Calls to ioctl().
+    size_t malloc;    ///< Calls to malloc() and calloc().
+    size_t free;      ///< Calls to free() with a non-NULL pointer.
+    size_t verify;    ///< Calls to cominitCryptoVerifySignature(), each parses the public key once.
+    size_t keyring;   ///< Calls to cominitKeyringGetKey().
+} cominitBudgetCounters_t;
+
+extern cominitBudgetCounters_t cominitBudgetCount;
+
+/**
+ * Sets up the simulated devices and starts counting.
+ *
+ * The simulated /dev holds \a diskCount disks `sda`, `sdb`, ... with a GPT of \a entryCount used entries each. Only the
+ * last entry of the last disk is the rootfs, all other entries are Linux data partitions, so the rootfs is found last.
+ * The rootfs partition node `/dev/sd<last disk><entryCount>` ends with a metadata region holding \a metadata and a
+ * dummy signature.
+ *
+ * @param diskCount   The number of disks, at most #COMINIT_BUDGET_DISKS_MAX.
+ * @param entryCount  The number of partition entries on every disk.
+ * @param metadata    The metadata string of the rootfs partition.
+ */
+void cominitBudgetStart(unsigned diskCount, uint32_t entryCount, const char *metadata);
+
+/**
+ * Stops counting.
+ */
+void cominitBudgetStop(void);
+
+/**
+ * Unit test for the budget of rootfs discovery with 1, 4 and 16 disks of 128 and 256 GPT entries.
+ * @param state
+ */
+void cominitBudgetBootTestDiscovery(void **state);
+
+/**
+ * Unit test for the budget of loading dm-verity metadata.
+ * @param state
+ */
+void cominitBudgetBootTestMetadataVerity(void **state);
+
+/**
+ * Unit test for the budget of loading dm-integrity metadata with a key from the Kernel keyring.
+ * @param state
+ */
+void cominitBudgetBootTestMetadataIntegrity(void **state);
+
+#endif /* __UTEST_BUDGET_BOOT_H__ */
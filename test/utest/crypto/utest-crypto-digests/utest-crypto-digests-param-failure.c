@@ -0,0 +1,24 @@
+// SPDX-License-Identifier: MIT
+/**
+ * @file utest-crypto-digests-param-failure.c
+ * @brief Implementation of a parameter failure case unit test for cominitCryptoDigests().
+ */
+#include <stdlib.h>
+
+#include "common.h"
+#include "crypto.h"
+#include "unit_test.h"
+#include "utest-crypto-digests.h"
+
+void cominitCryptoDigestsTestParamFailure(void **state) {
+    COMINIT_PARAM_UNUSED(state);
+
+    const uint8_t data[] = {'a', 'b', 'c'};
+    cominitCryptoDigests_t digests = {.algs = COMINIT_CRYPTO_DIGEST_SHA256};
+
+    assert_int_not_equal(cominitCryptoDigests(NULL, sizeof(data), &digests), EXIT_SUCCESS);
+    assert_int_not_equal(cominitCryptoDigests(data, sizeof(data), NULL), EXIT_SUCCESS);
+
+    digests.algs = COMINIT_CRYPTO_DIGEST_SHA384 << 1;
+    assert_int_not_equal(cominitCryptoDigests(data, sizeof(data), &digests), EXIT_SUCCESS);
+}
@@ -0,0 +1,53 @@
+// SPDX-License-Identifier: MIT
+/**
+ * @file utest-crypto-digests-success.c
+ * @brief Implementation of a success case unit test for cominitCryptoDigests().
+ */
+#include <stdlib.h>
+#include <string.h>
+
+#include "common.h"
+#include "crypto.h"
+#include "unit_test.h"
+#include "utest-crypto-digests.h"
+
+/** Size of a buffer that spans several chunks hashed by cominitCryptoDigests(). **/
+#define COMINIT_TEST_LARGE_SIZE 10000
+
+void cominitCryptoDigestsTestSuccess(void **state) {
+    COMINIT_PARAM_UNUSED(state);
+
+    /* FIPS 180-2 test vectors */
+    const uint8_t abc[] = {'a', 'b', 'c'};
+    const uint8_t abcSha256[SHA256_LEN] = {0xba, 0x78, 0x16, 0xbf, 0x8f, 0x01, 0xcf, 0xea, 0x41, 0x41, 0x40, 0xde,
+                                           0x5d, 0xae, 0x22, 0x23, 0xb0, 0x03, 0x61, 0xa3, 0x96, 0x17, 0x7a, 0x9c,
+                                           0xb4, 0x10, 0xff, 0x61, 0xf2, 0x00, 0x15, 0xad};
+    const uint8_t abcSha384[SHA384_LEN] = {0xcb, 0x00, 0x75, 0x3f, 0x45, 0xa3, 0x5e, 0x8b, 0xb5, 0xa0, 0x3d, 0x69,
+                                           0x9a, 0xc6, 0x50, 0x07, 0x27, 0x2c, 0x32, 0xab, 0x0e, 0xde, 0xd1, 0x63,
+                                           0x1a, 0x8b, 0x60, 0x5a, 0x43, 0xff, 0x5b, 0xed, 0x80, 0x86, 0x07, 0x2b,
+                                           0xa1, 0xe7, 0xcc, 0x23, 0x58, 0xba, 0xec, 0xa1, 0x34, 0xc8, 0x25, 0xa7};
+    /* SHA-384 of 10000 times 'a' */
+    const uint8_t largeSha384[SHA384_LEN] = {0x2b, 0xca, 0x3b, 0x13, 0x1b, 0xb7, 0xe9, 0x22, 0xbc, 0xd1, 0xde, 0x98,
+                                             0xc4, 0x47, 0x86, 0xd3, 0x2e, 0x6b, 0x6b, 0x29, 0x93, 0xe6, 0x9c, 0x49,
+                                             0x87, 0xed, 0xf9, 0xdd, 0x49, 0x71, 0x1e, 0xb5, 0x01, 0xf0, 0xe9, 0x8a,
+                                             0xd2, 0x48, 0xd8, 0x39, 0xf6, 0xbf, 0x9e, 0x11, 0x6e, 0x25, 0xa9, 0x7c};
+    static uint8_t large[COMINIT_TEST_LARGE_SIZE];
+    unsigned char largeSha256[SHA256_LEN] = {0};
+
+    cominitCryptoDigests_t digests = {.algs = COMINIT_CRYPTO_DIGEST_SHA256 | COMINIT_CRYPTO_DIGEST_SHA384};
+    assert_int_equal(cominitCryptoDigests(abc, sizeof(abc), &digests), EXIT_SUCCESS);
+    assert_memory_equal(digests.sha256, abcSha256, SHA256_LEN);
+    assert_memory_equal(digests.sha384, abcSha384, SHA384_LEN);
+
+    memset(&digests, 0, sizeof(digests));
+    digests.algs = COMINIT_CRYPTO_DIGEST_SHA384;
+    assert_int_equal(cominitCryptoDigests(abc, sizeof(abc), &digests), EXIT_SUCCESS);
+    assert_memory_equal(digests.sha384, abcSha384, SHA384_LEN);
+
+    memset(large, 'a', sizeof(large));
+    assert_int_equal(cominitCryptoSha256(large, sizeof(large), largeSha256, sizeof(largeSha256)), EXIT_SUCCESS);
+    digests.algs = COMINIT_CRYPTO_DIGEST_SHA256 | COMINIT_CRYPTO_DIGEST_SHA384;
+    assert_int_equal(cominitCryptoDigests(large, sizeof(large), &digests), EXIT_SUCCESS);
+    assert_memory_equal(digests.sha256, largeSha256, SHA256_LEN);
+    assert_memory_equal(digests.sha384, largeSha384, SHA384_LEN);
+}
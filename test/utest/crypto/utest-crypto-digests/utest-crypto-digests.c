@@ -0,0 +1,21 @@
+// SPDX-License-Identifier: MIT
+/**
+ * @file utest-crypto-digests.c
+ * @brief Implementation of an cominitCryptoDigests() unit test group using cmocka.
+ */
+#include "utest-crypto-digests.h"
+
+#include "unit_test.h"
+
+/**
+ * Run the unit tests for cominitCryptoDigests().
+ *
+ * @return  The same as cmocka_run_group_tests() returns for the tests.
+ */
+int main(void) {
+    const struct CMUnitTest tests[] = {
+        cmocka_unit_test(cominitCryptoDigestsTestSuccess),
+        cmocka_unit_test(cominitCryptoDigestsTestParamFailure),
+    };
+    return cmocka_run_group_tests(tests, NULL, NULL);
+}
@@ -0,0 +1,21 @@
+// SPDX-License-Identifier: MIT
+/**
+ * @file utest-crypto-digests.h
+ * @brief Header declaring cmocka unit test functions for cominitCryptoDigests().
+ */
+#ifndef __UTEST_CRYPTO_DIGESTS_H__
+#define __UTEST_CRYPTO_DIGESTS_H__
+
+/**
+ * Unit test for cominitCryptoDigests() successful code path.
+ * @param state
+ */
+void cominitCryptoDigestsTestSuccess(void **state);
+
+/**
+ * Unit test for cominitCryptoDigests() with invalid parameters.
+ * @param state
+ */
+void cominitCryptoDigestsTestParamFailure(void **state);
+
+#endif /* __UTEST_CRYPTO_DIGESTS_H__ */
@@ -0,0 +1,30 @@
+// SPDX-License-Identifier: MIT
+/**
+ * @file utest-crypto-hkdf-sha256-param-failure.c
+ * @brief Implementation of a parameter failure case unit test for cominitCryptoHkdfSha256().
+ */
+#include <stdlib.h>
+
+#include "common.h"
+#include "crypto.h"
+#include "unit_test.h"
+#include "utest-crypto-hkdf-sha256.h"
+
+void cominitCryptoHkdfSha256TestParamFailure(void **state) {
+    COMINIT_PARAM_UNUSED(state);
+
+    const uint8_t ikm[32] = {0};
+    const uint8_t info[] = {'i', 'n', 'f', 'o'};
+    uint8_t okm[32] = {0};
+    static uint8_t tooLong[255 * SHA256_LEN + 1];
+
+    assert_int_not_equal(cominitCryptoHkdfSha256(NULL, sizeof(ikm), info, sizeof(info), okm, sizeof(okm)),
+                         EXIT_SUCCESS);
+    assert_int_not_equal(cominitCryptoHkdfSha256(ikm, 0, info, sizeof(info), okm, sizeof(okm)), EXIT_SUCCESS);
+    assert_int_not_equal(cominitCryptoHkdfSha256(ikm, sizeof(ikm), NULL, sizeof(info), okm, sizeof(okm)), EXIT_SUCCESS);
+    assert_int_not_equal(cominitCryptoHkdfSha256(ikm, sizeof(ikm), info, sizeof(info), NULL, sizeof(okm)),
+                         EXIT_SUCCESS);
+    assert_int_not_equal(cominitCryptoHkdfSha256(ikm, sizeof(ikm), info, sizeof(info), okm, 0), EXIT_SUCCESS);
+    assert_int_not_equal(cominitCryptoHkdfSha256(ikm, sizeof(ikm), info, sizeof(info), tooLong, sizeof(tooLong)),
+                         EXIT_SUCCESS);
+}
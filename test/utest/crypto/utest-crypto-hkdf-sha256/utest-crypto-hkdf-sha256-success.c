@@ -0,0 +1,42 @@
+// SPDX-License-Identifier: MIT
+/**
+ * @file utest-crypto-hkdf-sha256-success.c
+ * @brief Implementation of a success case unit test for cominitCryptoHkdfSha256().
+ */
+#include <stdlib.h>
+#include <string.h>
+
+#include "common.h"
+#include "crypto.h"
+#include "unit_test.h"
+#include "utest-crypto-hkdf-sha256.h"
+
+void cominitCryptoHkdfSha256TestSuccess(void **state) {
+    COMINIT_PARAM_UNUSED(state);
+
+    /* RFC 5869 test case 3 (no salt, no info) */
+    uint8_t ikm[22];
+    const uint8_t expected[42] = {0x8d, 0xa4, 0xe7, 0x75, 0xa5, 0x63, 0xc1, 0x8f, 0x71, 0x5f, 0x80, 0x2a, 0x06, 0x3c,
+                                  0x5a, 0x31, 0xb8, 0xa1, 0x1f, 0x5c, 0x5e, 0xe1, 0x87, 0x9e, 0xc3, 0x45, 0x4e, 0x5f,
+                                  0x3c, 0x73, 0x8d, 0x2d, 0x9d, 0x20, 0x13, 0x95, 0xfa, 0xa4, 0xb6, 0x1a, 0x96, 0xc8};
+    uint8_t okm[sizeof(expected)] = {0};
+    memset(ikm, 0x0b, sizeof(ikm));
+
+    assert_int_equal(cominitCryptoHkdfSha256(ikm, sizeof(ikm), NULL, 0, okm, sizeof(okm)), EXIT_SUCCESS);
+    assert_memory_equal(okm, expected, sizeof(expected));
+
+    /* Different contexts yield independent keys. */
+    const char logs[] = "0fc63daf-8483-4772-8e79-3d69d8477de4";
+    const char data[] = "0fc63daf-8483-4772-8e79-3d69d8477de5";
+    uint8_t logsKey[32] = {0};
+    uint8_t dataKey[32] = {0};
+
+    assert_int_equal(cominitCryptoHkdfSha256(ikm, sizeof(ikm), (const uint8_t *)logs, strlen(logs), logsKey,
+                                             sizeof(logsKey)),
+                     EXIT_SUCCESS);
+    assert_int_equal(cominitCryptoHkdfSha256(ikm, sizeof(ikm), (const uint8_t *)data, strlen(data), dataKey,
+                                             sizeof(dataKey)),
+                     EXIT_SUCCESS);
+    assert_memory_not_equal(logsKey, dataKey, sizeof(logsKey));
+    assert_memory_not_equal(logsKey, okm, sizeof(logsKey));
+}
@@ -0,0 +1,21 @@
+// SPDX-License-Identifier: MIT
+/**
+ * @file utest-crypto-hkdf-sha256.c
+ * @brief Implementation of an cominitCryptoHkdfSha256() unit test group using cmocka.
+ */
+#include "utest-crypto-hkdf-sha256.h"
+
+#include "unit_test.h"
+
+/**
+ * Run the unit tests for cominitCryptoHkdfSha256().
+ *
+ * @return  The same as cmocka_run_group_tests() returns for the tests.
+ */
+int main(void) {
+    const struct CMUnitTest tests[] = {
+        cmocka_unit_test(cominitCryptoHkdfSha256TestSuccess),
+        cmocka_unit_test(cominitCryptoHkdfSha256TestParamFailure),
+    };
+    return cmocka_run_group_tests(tests, NULL, NULL);
+}
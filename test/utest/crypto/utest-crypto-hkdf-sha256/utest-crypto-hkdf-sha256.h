@@ -0,0 +1,21 @@
+// SPDX-License-Identifier: MIT
+/**
+ * @file utest-crypto-hkdf-sha256.h
+ * @brief Header declaring cmocka unit test functions for cominitCryptoHkdfSha256().
+ */
+#ifndef __UTEST_CRYPTO_HKDF_SHA256_H__
+#define __UTEST_CRYPTO_HKDF_SHA256_H__
+
+/**
+ * Unit test for cominitCryptoHkdfSha256() successful code path.
+ * @param state
+ */
+void cominitCryptoHkdfSha256TestSuccess(void **state);
+
+/**
+ * Unit test for cominitCryptoHkdfSha256() with invalid parameters.
+ * @param state
+ */
+void cominitCryptoHkdfSha256TestParamFailure(void **state);
+
+#endif /* __UTEST_CRYPTO_HKDF_SHA256_H__ */
@@ -0,0 +1,22 @@
+// SPDX-License-Identifier: MIT
+/**
+ * @file utest-crypto-sha256-param-failure.c
+ * @brief Implementation of a parameter failure case unit test for cominitCryptoSha256().
+ */
+#include <stdlib.h>
+
+#include "common.h"
+#include "crypto.h"
+#include "unit_test.h"
+#include "utest-crypto-sha256.h"
+
+void cominitCryptoSha256TestParamFailure(void **state) {
+    COMINIT_PARAM_UNUSED(state);
+
+    const uint8_t data[] = {'a', 'b', 'c'};
+    unsigned char digest[SHA256_LEN] = {0};
+
+    assert_int_not_equal(cominitCryptoSha256(NULL, sizeof(data), digest, sizeof(digest)), EXIT_SUCCESS);
+    assert_int_not_equal(cominitCryptoSha256(data, sizeof(data), NULL, sizeof(digest)), EXIT_SUCCESS);
+    assert_int_not_equal(cominitCryptoSha256(data, sizeof(data), digest, sizeof(digest) - 1), EXIT_SUCCESS);
+}
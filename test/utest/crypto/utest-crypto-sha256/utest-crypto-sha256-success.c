@@ -0,0 +1,31 @@
+// SPDX-License-Identifier: MIT
+/**
+ * @file utest-crypto-sha256-success.c
+ * @brief Implementation of a success case unit test for cominitCryptoSha256().
+ */
+#include <stdlib.h>
+
+#include "common.h"
+#include "crypto.h"
+#include "unit_test.h"
+#include "utest-crypto-sha256.h"
+
+void cominitCryptoSha256TestSuccess(void **state) {
+    COMINIT_PARAM_UNUSED(state);
+
+    /* FIPS 180-2 test vectors */
+    const uint8_t abc[] = {'a', 'b', 'c'};
+    const uint8_t abcDigest[SHA256_LEN] = {0xba, 0x78, 0x16, 0xbf, 0x8f, 0x01, 0xcf, 0xea, 0x41, 0x41, 0x40,
+                                           0xde, 0x5d, 0xae, 0x22, 0x23, 0xb0, 0x03, 0x61, 0xa3, 0x96, 0x17,
+                                           0x7a, 0x9c, 0xb4, 0x10, 0xff, 0x61, 0xf2, 0x00, 0x15, 0xad};
+    const uint8_t emptyDigest[SHA256_LEN] = {0xe3, 0xb0, 0xc4, 0x42, 0x98, 0xfc, 0x1c, 0x14, 0x9a, 0xfb, 0xf4,
+                                             0xc8, 0x99, 0x6f, 0xb9, 0x24, 0x27, 0xae, 0x41, 0xe4, 0x64, 0x9b,
+                                             0x93, 0x4c, 0xa4, 0x95, 0x99, 0x1b, 0x78, 0x52, 0xb8, 0x55};
+    unsigned char digest[SHA256_LEN] = {0};
+
+    assert_int_equal(cominitCryptoSha256(abc, sizeof(abc), digest, sizeof(digest)), EXIT_SUCCESS);
+    assert_memory_equal(digest, abcDigest, SHA256_LEN);
+
+    assert_int_equal(cominitCryptoSha256(NULL, 0, digest, sizeof(digest)), EXIT_SUCCESS);
+    assert_memory_equal(digest, emptyDigest, SHA256_LEN);
+}
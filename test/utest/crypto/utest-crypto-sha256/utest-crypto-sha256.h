@@ -0,0 +1,21 @@
+// SPDX-License-Identifier: MIT
+/**
+ * @file utest-crypto-sha256.h
+ * @brief Header declaring cmocka unit test functions for cominitCryptoSha256().
+ */
+#ifndef __UTEST_CRYPTO_SHA256_H__
+#define __UTEST_CRYPTO_SHA256_H__
+
+/**
+ * Unit test for cominitCryptoSha256() successful code path.
+ * @param state
+ */
+void cominitCryptoSha256TestSuccess(void **state);
+
+/**
+ * Unit test for cominitCryptoSha256() with invalid parameters.
+ * @param state
+ */
+void cominitCryptoSha256TestParamFailure(void **state);
+
+#endif /* __UTEST_CRYPTO_SHA256_H__ */
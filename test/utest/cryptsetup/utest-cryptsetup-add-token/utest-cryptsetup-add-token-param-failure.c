@@ -18,5 +18,6 @@
 void cominitCryptsetupAddTokenTestParamFailure(void **state) {
     COMINIT_PARAM_UNUSED(state);
 
-    assert_int_not_equal(cominitCryptsetupAddToken(NULL), 0);
+    assert_int_not_equal(cominitCryptsetupAddToken(NULL, "secureStorage"), 0);
+    assert_int_not_equal(cominitCryptsetupAddToken("/dev/crypt", NULL), 0);
 }
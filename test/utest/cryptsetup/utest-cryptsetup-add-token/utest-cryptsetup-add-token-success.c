@@ -23,5 +23,5 @@ void cominitCryptsetupAddTokenTestSuccess(void **state) {
 
     will_return(__wrap_cominitSubprocessSpawn, 0);
 
-    assert_int_equal(cominitCryptsetupAddToken(devCryptTest), 0);
+    assert_int_equal(cominitCryptsetupAddToken(devCryptTest, "secureStorage"), 0);
 }
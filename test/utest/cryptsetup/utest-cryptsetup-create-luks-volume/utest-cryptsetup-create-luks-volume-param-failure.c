@@ -15,5 +15,8 @@ void cominitCryptsetupCreateLuksVolumeTestParamFailure(void **state) {
     unsigned char passphrase[] = "secret key";
     size_t passphraseSize = ARRAY_SIZE(passphrase);
 
-    assert_int_not_equal(cominitCryptsetupCreateLuksVolume(NULL, passphrase, passphraseSize), 0);
+    const cominitCryptsetupCipher_t cipher = {.name = "aes-xts-plain64", .keySize = 64};
+
+    assert_int_not_equal(cominitCryptsetupCreateLuksVolume(NULL, &cipher, passphrase, passphraseSize), 0);
+    assert_int_not_equal(cominitCryptsetupCreateLuksVolume("/dev/crypt", NULL, passphrase, passphraseSize), 0);
 }
@@ -7,22 +7,25 @@
 #include <cmocka_extensions/cmocka_extensions.h>
 #include <stddef.h>
 
+#include "subprocess.h"
 #include "utest-cryptsetup-create-luks-volume.h"
 
 void cominitCryptsetupCreateLuksVolumeTestSuccess(void **state) {
     COMINIT_PARAM_UNUSED(state);
     char devCryptTest[] = "/dev/crypt";
+    const cominitCryptsetupCipher_t cipher = {.name = "xchacha12,aes-adiantum-plain64", .keySize = 32};
 
     unsigned char passphraseTest[] = "secret key";
     size_t passphraseSizeTest = ARRAY_SIZE(passphraseTest);
 
-    expect_string(__wrap_cominitSubprocessSpawnAndWrite, data, passphraseTest);
-    expect_value(__wrap_cominitSubprocessSpawnAndWrite, dataSize, passphraseSizeTest);
-    expect_string(__wrap_cominitSubprocessSpawnAndWrite, path, COMINIT_CRYPTSETUP_DIR);
-    expect_any(__wrap_cominitSubprocessSpawnAndWrite, argv);
-    expect_any(__wrap_cominitSubprocessSpawnAndWrite, env);
+    expect_string(__wrap_cominitSubprocessSpawnAndWriteWithTimeout, data, passphraseTest);
+    expect_value(__wrap_cominitSubprocessSpawnAndWriteWithTimeout, dataSize, passphraseSizeTest);
+    expect_string(__wrap_cominitSubprocessSpawnAndWriteWithTimeout, path, COMINIT_CRYPTSETUP_DIR);
+    expect_any(__wrap_cominitSubprocessSpawnAndWriteWithTimeout, argv);
+    expect_any(__wrap_cominitSubprocessSpawnAndWriteWithTimeout, env);
+    expect_value(__wrap_cominitSubprocessSpawnAndWriteWithTimeout, timeoutMs, COMINIT_SUBPROCESS_FORMAT_TIMEOUT_MS);
 
-    will_return(__wrap_cominitSubprocessSpawnAndWrite, 0);
+    will_return(__wrap_cominitSubprocessSpawnAndWriteWithTimeout, 0);
 
-    assert_int_equal(cominitCryptsetupCreateLuksVolume(devCryptTest, passphraseTest, passphraseSizeTest), 0);
+    assert_int_equal(cominitCryptsetupCreateLuksVolume(devCryptTest, &cipher, passphraseTest, passphraseSizeTest), 0);
 }
@@ -0,0 +1,36 @@
+// SPDX-License-Identifier: MIT
+/**
+ * @file utest-cryptsetup-open-luks-volumes-failure.c
+ * @brief Implementation of a failure case unit test for cominitCryptsetupOpenLuksVolumes().
+ */
+
+#include <cmocka_extensions/cmocka_extensions.h>
+
+#include "utest-cryptsetup-open-luks-volumes.h"
+
+void cominitCryptsetupOpenLuksVolumesTestFailure(void **state) {
+    COMINIT_PARAM_UNUSED(state);
+    char *const devCrypt[] = {"/dev/crypt1", "/dev/crypt2", "/dev/crypt3"};
+    char *const names[] = {"secureStorage", "logs", "data"};
+    int results[ARRAY_SIZE(devCrypt)] = {0};
+
+    expect_any_count(__wrap_cominitSubprocessStart, path, 3);
+    expect_any_count(__wrap_cominitSubprocessStart, argv, 3);
+    expect_any_count(__wrap_cominitSubprocessStart, env, 3);
+    will_return(__wrap_cominitSubprocessStart, 100);
+    will_return(__wrap_cominitSubprocessStart, -1);
+    will_return(__wrap_cominitSubprocessStart, 102);
+
+    /* The failed start is skipped but the other volumes are still reaped. */
+    expect_value(__wrap_cominitSubprocessWait, pid, 100);
+    will_return(__wrap_cominitSubprocessWait, EXIT_SUCCESS);
+    expect_value(__wrap_cominitSubprocessWait, pid, 102);
+    will_return(__wrap_cominitSubprocessWait, EXIT_FAILURE);
+
+    assert_int_not_equal(cominitCryptsetupOpenLuksVolumes(devCrypt, names, results, ARRAY_SIZE(devCrypt)), 0);
+
+    /* Each volume reports its own result. */
+    assert_int_equal(results[0], EXIT_SUCCESS);
+    assert_int_not_equal(results[1], EXIT_SUCCESS);
+    assert_int_not_equal(results[2], EXIT_SUCCESS);
+}
@@ -0,0 +1,21 @@
+// SPDX-License-Identifier: MIT
+/**
+ * @file utest-cryptsetup-open-luks-volumes-param-failure.c
+ * @brief Implementation of a failure case unit test for cominitCryptsetupOpenLuksVolumes().
+ */
+
+#include <cmocka_extensions/cmocka_extensions.h>
+
+#include "utest-cryptsetup-open-luks-volumes.h"
+
+void cominitCryptsetupOpenLuksVolumesTestParamFailure(void **state) {
+    COMINIT_PARAM_UNUSED(state);
+    char *const devCrypt[] = {"/dev/crypt"};
+    char *const names[] = {"secureStorage"};
+    int results[1] = {0};
+
+    assert_int_not_equal(cominitCryptsetupOpenLuksVolumes(NULL, names, results, 1), 0);
+    assert_int_not_equal(cominitCryptsetupOpenLuksVolumes(devCrypt, NULL, results, 1), 0);
+    assert_int_not_equal(cominitCryptsetupOpenLuksVolumes(devCrypt, names, NULL, 1), 0);
+    assert_int_not_equal(cominitCryptsetupOpenLuksVolumes(devCrypt, names, results, 0), 0);
+}
@@ -0,0 +1,33 @@
+// SPDX-License-Identifier: MIT
+/**
+ * @file utest-cryptsetup-open-luks-volumes-success.c
+ * @brief Implementation of a success case unit test for cominitCryptsetupOpenLuksVolumes().
+ */
+
+#include <cmocka_extensions/cmocka_extensions.h>
+
+#include "utest-cryptsetup-open-luks-volumes.h"
+
+void cominitCryptsetupOpenLuksVolumesTestSuccess(void **state) {
+    COMINIT_PARAM_UNUSED(state);
+    char *const devCrypt[] = {"/dev/crypt1", "/dev/crypt2", "/dev/crypt3"};
+    char *const names[] = {"secureStorage", "logs", "data"};
+    int results[ARRAY_SIZE(devCrypt)] = {0};
+
+    /* All processes are started before the first one is waited for. */
+    for (pid_t pid = 100; pid < 103; pid++) {
+        expect_string(__wrap_cominitSubprocessStart, path, COMINIT_CRYPTSETUP_DIR);
+        expect_any(__wrap_cominitSubprocessStart, argv);
+        expect_any(__wrap_cominitSubprocessStart, env);
+        will_return(__wrap_cominitSubprocessStart, pid);
+    }
+    for (pid_t pid = 100; pid < 103; pid++) {
+        expect_value(__wrap_cominitSubprocessWait, pid, pid);
+        will_return(__wrap_cominitSubprocessWait, EXIT_SUCCESS);
+    }
+
+    assert_int_equal(cominitCryptsetupOpenLuksVolumes(devCrypt, names, results, ARRAY_SIZE(devCrypt)), 0);
+    for (size_t i = 0; i < ARRAY_SIZE(results); i++) {
+        assert_int_equal(results[i], EXIT_SUCCESS);
+    }
+}
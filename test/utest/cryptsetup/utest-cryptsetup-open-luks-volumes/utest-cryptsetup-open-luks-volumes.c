@@ -0,0 +1,22 @@
+// SPDX-License-Identifier: MIT
+/**
+ * @file utest-cryptsetup-open-luks-volumes.c
+ * @brief Implementation of an cominitCryptsetupOpenLuksVolumes() unit test group using cmocka.
+ */
+#include "utest-cryptsetup-open-luks-volumes.h"
+
+#include "unit_test.h"
+
+/**
+ * Run the unit tests for cominitCryptsetupOpenLuksVolumes().
+ *
+ * @return  The same as cmocka_run_group_tests() returns for the tests.
+ */
+int main(void) {
+    const struct CMUnitTest tests[] = {
+        cmocka_unit_test(cominitCryptsetupOpenLuksVolumesTestSuccess),
+        cmocka_unit_test(cominitCryptsetupOpenLuksVolumesTestFailure),
+        cmocka_unit_test(cominitCryptsetupOpenLuksVolumesTestParamFailure),
+    };
+    return cmocka_run_group_tests(tests, NULL, NULL);
+}
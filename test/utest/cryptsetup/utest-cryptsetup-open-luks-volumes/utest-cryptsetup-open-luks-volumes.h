@@ -0,0 +1,30 @@
+// SPDX-License-Identifier: MIT
+/**
+ * @file utest-cryptsetup-open-luks-volumes.h
+ * @brief Header declaring cmocka unit test functions for cominitCryptsetupOpenLuksVolumes().
+ */
+#ifndef __UTEST_CRYPTSETUP_OPEN_LUKS_VOLUMES_H__
+#define __UTEST_CRYPTSETUP_OPEN_LUKS_VOLUMES_H__
+
+#include "common.h"
+#include "cryptsetup.h"
+
+/**
+ * Unit test for cominitCryptsetupOpenLuksVolumes() successful code path.
+ * @param state
+ */
+void cominitCryptsetupOpenLuksVolumesTestSuccess(void **state);
+
+/**
+ * Unit test for cominitCryptsetupOpenLuksVolumes() if one of the volumes cannot be opened.
+ * @param state
+ */
+void cominitCryptsetupOpenLuksVolumesTestFailure(void **state);
+
+/**
+ * Unit test for cominitCryptsetupOpenLuksVolumes() if parameters are not initialized.
+ * @param state
+ */
+void cominitCryptsetupOpenLuksVolumesTestParamFailure(void **state);
+
+#endif /* __UTEST_CRYPTSETUP_OPEN_LUKS_VOLUMES_H__ */
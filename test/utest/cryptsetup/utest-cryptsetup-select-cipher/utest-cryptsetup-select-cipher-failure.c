@@ -0,0 +1,19 @@
+// SPDX-License-Identifier: MIT
+/**
+ * @file utest-cryptsetup-select-cipher-failure.c
+ * @brief Implementation of failure case unit tests for cominitCryptsetupSelectCipher().
+ */
+
+#include <cmocka_extensions/cmocka_extensions.h>
+#include <stddef.h>
+
+#include "utest-cryptsetup-select-cipher.h"
+
+void cominitCryptsetupSelectCipherTestFloorFailure(void **state) {
+    COMINIT_PARAM_UNUSED(state);
+    const cominitCryptsetupCipher_t *cipher = NULL;
+
+    /* No candidate is benchmarked and no weaker one is used as fallback */
+    assert_int_not_equal(cominitCryptsetupSelectCipher(512, &cipher), EXIT_SUCCESS);
+    assert_null(cipher);
+}
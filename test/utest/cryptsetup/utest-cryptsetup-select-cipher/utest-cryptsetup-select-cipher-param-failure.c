@@ -0,0 +1,16 @@
+// SPDX-License-Identifier: MIT
+/**
+ * @file utest-cryptsetup-select-cipher-param-failure.c
+ * @brief Implementation of a failure case unit test for cominitCryptsetupSelectCipher().
+ */
+
+#include <cmocka_extensions/cmocka_extensions.h>
+#include <stddef.h>
+
+#include "utest-cryptsetup-select-cipher.h"
+
+void cominitCryptsetupSelectCipherTestParamFailure(void **state) {
+    COMINIT_PARAM_UNUSED(state);
+
+    assert_int_not_equal(cominitCryptsetupSelectCipher(256, NULL), 0);
+}
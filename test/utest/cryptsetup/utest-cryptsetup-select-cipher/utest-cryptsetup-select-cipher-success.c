@@ -0,0 +1,88 @@
+// SPDX-License-Identifier: MIT
+/**
+ * @file utest-cryptsetup-select-cipher-success.c
+ * @brief Implementation of success case unit tests for cominitCryptsetupSelectCipher().
+ */
+
+#include <cmocka_extensions/cmocka_extensions.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#include "utest-cryptsetup-select-cipher.h"
+
+/**
+ * Queue the expectations for a single cominitKcapiBenchmarkSkcipher() call.
+ *
+ * @param algName   The expected Kernel Crypto API name.
+ * @param keySize   The expected key size in Bytes.
+ * @param ns        The benchmark result to return.
+ * @param result    The return value of the mocked benchmark.
+ */
+static void cominitExpectBenchmark(const char *algName, size_t keySize, uint64_t ns, int result) {
+    expect_string(__wrap_cominitKcapiBenchmarkSkcipher, algName, algName);
+    expect_value(__wrap_cominitKcapiBenchmarkSkcipher, keySize, keySize);
+    expect_any(__wrap_cominitKcapiBenchmarkSkcipher, ivSize);
+    will_return(__wrap_cominitKcapiBenchmarkSkcipher, ns);
+    will_return(__wrap_cominitKcapiBenchmarkSkcipher, result);
+}
+
+void cominitCryptsetupSelectCipherTestSuccessAdiantum(void **state) {
+    COMINIT_PARAM_UNUSED(state);
+    const cominitCryptsetupCipher_t *cipher = NULL;
+
+    cominitExpectBenchmark("xts(aes)", 64, 40000000, EXIT_SUCCESS);
+    cominitExpectBenchmark("adiantum(xchacha12,aes)", 32, 12000000, EXIT_SUCCESS);
+
+    assert_int_equal(cominitCryptsetupSelectCipher(256, &cipher), EXIT_SUCCESS);
+    assert_non_null(cipher);
+    assert_string_equal(cipher->name, "xchacha12,aes-adiantum-plain64");
+    assert_int_equal(cipher->keySize, 32);
+}
+
+void cominitCryptsetupSelectCipherTestSuccessAesXts(void **state) {
+    COMINIT_PARAM_UNUSED(state);
+    const cominitCryptsetupCipher_t *cipher = NULL;
+
+    cominitExpectBenchmark("xts(aes)", 64, 900000, EXIT_SUCCESS);
+    cominitExpectBenchmark("adiantum(xchacha12,aes)", 32, 3000000, EXIT_SUCCESS);
+
+    assert_int_equal(cominitCryptsetupSelectCipher(256, &cipher), EXIT_SUCCESS);
+    assert_non_null(cipher);
+    assert_string_equal(cipher->name, "aes-xts-plain64");
+    assert_int_equal(cipher->keySize, 64);
+}
+
+void cominitCryptsetupSelectCipherTestSuccessSecurityFloor(void **state) {
+    COMINIT_PARAM_UNUSED(state);
+    const cominitCryptsetupCipher_t *cipher = NULL;
+
+    /* AES-128-XTS is the fastest candidate but only selected if the floor allows it */
+    cominitExpectBenchmark("xts(aes)", 64, 900000, EXIT_SUCCESS);
+    cominitExpectBenchmark("adiantum(xchacha12,aes)", 32, 3000000, EXIT_SUCCESS);
+    cominitExpectBenchmark("xts(aes)", 32, 700000, EXIT_SUCCESS);
+
+    assert_int_equal(cominitCryptsetupSelectCipher(128, &cipher), EXIT_SUCCESS);
+    assert_non_null(cipher);
+    assert_string_equal(cipher->name, "aes-xts-plain64");
+    assert_int_equal(cipher->keySize, 32);
+
+    cominitExpectBenchmark("xts(aes)", 64, 900000, EXIT_SUCCESS);
+    cominitExpectBenchmark("adiantum(xchacha12,aes)", 32, 3000000, EXIT_SUCCESS);
+
+    assert_int_equal(cominitCryptsetupSelectCipher(256, &cipher), EXIT_SUCCESS);
+    assert_non_null(cipher);
+    assert_int_equal(cipher->keySize, 64);
+}
+
+void cominitCryptsetupSelectCipherTestSuccessFallback(void **state) {
+    COMINIT_PARAM_UNUSED(state);
+    const cominitCryptsetupCipher_t *cipher = NULL;
+
+    cominitExpectBenchmark("xts(aes)", 64, 0, EXIT_FAILURE);
+    cominitExpectBenchmark("adiantum(xchacha12,aes)", 32, 0, EXIT_FAILURE);
+
+    assert_int_equal(cominitCryptsetupSelectCipher(256, &cipher), EXIT_SUCCESS);
+    assert_non_null(cipher);
+    assert_string_equal(cipher->name, "aes-xts-plain64");
+    assert_int_equal(cipher->keySize, 64);
+}
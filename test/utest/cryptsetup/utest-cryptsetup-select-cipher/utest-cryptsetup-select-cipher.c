@@ -0,0 +1,25 @@
+// SPDX-License-Identifier: MIT
+/**
+ * @file utest-cryptsetup-select-cipher.c
+ * @brief Implementation of an cominitCryptsetupSelectCipher() unit test group using cmocka.
+ */
+#include "utest-cryptsetup-select-cipher.h"
+
+#include "unit_test.h"
+
+/**
+ * Run the unit tests for cominitCryptsetupSelectCipher().
+ *
+ * @return  The same as cmocka_run_group_tests() returns for the tests.
+ */
+int main(void) {
+    const struct CMUnitTest tests[] = {
+        cmocka_unit_test(cominitCryptsetupSelectCipherTestSuccessAdiantum),
+        cmocka_unit_test(cominitCryptsetupSelectCipherTestSuccessAesXts),
+        cmocka_unit_test(cominitCryptsetupSelectCipherTestSuccessSecurityFloor),
+        cmocka_unit_test(cominitCryptsetupSelectCipherTestSuccessFallback),
+        cmocka_unit_test(cominitCryptsetupSelectCipherTestFloorFailure),
+        cmocka_unit_test(cominitCryptsetupSelectCipherTestParamFailure),
+    };
+    return cmocka_run_group_tests(tests, NULL, NULL);
+}
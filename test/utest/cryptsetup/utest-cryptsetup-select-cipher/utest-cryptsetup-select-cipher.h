@@ -0,0 +1,48 @@
+// SPDX-License-Identifier: MIT
+/**
+ * @file utest-cryptsetup-select-cipher.h
+ * @brief Header declaring cmocka unit test functions for cominitCryptsetupSelectCipher().
+ */
+#ifndef __UTEST_CRYPTSETUP_SELECT_CIPHER_H__
+#define __UTEST_CRYPTSETUP_SELECT_CIPHER_H__
+
+#include "common.h"
+#include "cryptsetup.h"
+
+/**
+ * Unit test for cominitCryptsetupSelectCipher() if the fastest candidate is Adiantum.
+ * @param state
+ */
+void cominitCryptsetupSelectCipherTestSuccessAdiantum(void **state);
+
+/**
+ * Unit test for cominitCryptsetupSelectCipher() if the fastest candidate is AES-XTS.
+ * @param state
+ */
+void cominitCryptsetupSelectCipherTestSuccessAesXts(void **state);
+
+/**
+ * Unit test for cominitCryptsetupSelectCipher() if candidates below the security floor are faster.
+ * @param state
+ */
+void cominitCryptsetupSelectCipherTestSuccessSecurityFloor(void **state);
+
+/**
+ * Unit test for cominitCryptsetupSelectCipher() if no candidate can be benchmarked.
+ * @param state
+ */
+void cominitCryptsetupSelectCipherTestSuccessFallback(void **state);
+
+/**
+ * Unit test for cominitCryptsetupSelectCipher() if no candidate meets the security floor.
+ * @param state
+ */
+void cominitCryptsetupSelectCipherTestFloorFailure(void **state);
+
+/**
+ * Unit test for cominitCryptsetupSelectCipher() if parameters are not initialized.
+ * @param state
+ */
+void cominitCryptsetupSelectCipherTestParamFailure(void **state);
+
+#endif /* __UTEST_CRYPTSETUP_SELECT_CIPHER_H__ */
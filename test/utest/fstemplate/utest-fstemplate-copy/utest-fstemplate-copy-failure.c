@@ -0,0 +1,29 @@
+// SPDX-License-Identifier: MIT
+/**
+ * @file utest-fstemplate-copy-failure.c
+ * @brief Implementation of a failure case unit test for cominitFsTemplateCopy().
+ */
+#include <cmocka_extensions/cmocka_extensions.h>
+#include <stdlib.h>
+#include <unistd.h>
+
+#include "utest-fstemplate-copy.h"
+
+void cominitFsTemplateCopyTestFailure(void **state) {
+    COMINIT_PARAM_UNUSED(state);
+
+    char templatePath[] = "/tmp/utest-fstemplate-XXXXXX";
+    uint64_t written = 0;
+
+    int templateFd = mkstemp(templatePath);
+    assert_true(templateFd >= 0);
+
+    assert_int_equal(cominitFsTemplateCopy("/tmp/utest-fstemplate-nonexistent", templatePath, &written),
+                     EXIT_FAILURE);
+    assert_int_equal(cominitFsTemplateCopy(templatePath, "/tmp/utest-fstemplate-nonexistent/target", &written),
+                     EXIT_FAILURE);
+    assert_int_equal(cominitFsTemplateApply("/tmp/utest-fstemplate-nonexistent", templatePath), EXIT_FAILURE);
+
+    close(templateFd);
+    unlink(templatePath);
+}
@@ -0,0 +1,18 @@
+// SPDX-License-Identifier: MIT
+/**
+ * @file utest-fstemplate-copy-param-failure.c
+ * @brief Implementation of a failure case unit test for cominitFsTemplateCopy() with invalid parameters.
+ */
+#include <cmocka_extensions/cmocka_extensions.h>
+#include <stdlib.h>
+
+#include "utest-fstemplate-copy.h"
+
+void cominitFsTemplateCopyTestParamFailure(void **state) {
+    COMINIT_PARAM_UNUSED(state);
+
+    assert_int_equal(cominitFsTemplateCopy(NULL, "/dev/null", NULL), EXIT_FAILURE);
+    assert_int_equal(cominitFsTemplateCopy("/dev/null", NULL, NULL), EXIT_FAILURE);
+    assert_int_equal(cominitFsTemplateApply(NULL, "/dev/null"), EXIT_FAILURE);
+    assert_int_equal(cominitFsTemplateApply("/dev/null", NULL), EXIT_FAILURE);
+}
@@ -0,0 +1,54 @@
+// SPDX-License-Identifier: MIT
+/**
+ * @file utest-fstemplate-copy-success.c
+ * @brief Implementation of a success case unit test for cominitFsTemplateCopy().
+ */
+#include <cmocka_extensions/cmocka_extensions.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+#include "utest-fstemplate-copy.h"
+
+void cominitFsTemplateCopyTestSuccess(void **state) {
+    COMINIT_PARAM_UNUSED(state);
+
+    char templatePath[] = "/tmp/utest-fstemplate-XXXXXX";
+    char targetPath[] = "/tmp/utest-fstemplate-target-XXXXXX";
+    const char superblock[] = "superblock";
+    const char groupDesc[] = "group descriptors";
+    const off_t groupDescOffset = COMINIT_UTEST_FSTEMPLATE_SIZE / 2;
+    uint8_t *content = malloc(COMINIT_UTEST_FSTEMPLATE_SIZE);
+    uint64_t written = 0;
+    assert_non_null(content);
+
+    int templateFd = mkstemp(templatePath);
+    int targetFd = mkstemp(targetPath);
+    assert_true(templateFd >= 0);
+    assert_true(targetFd >= 0);
+
+    assert_int_equal(ftruncate(templateFd, COMINIT_UTEST_FSTEMPLATE_SIZE), 0);
+    assert_int_equal(pwrite(templateFd, superblock, sizeof(superblock), 0), sizeof(superblock));
+    assert_int_equal(pwrite(templateFd, groupDesc, sizeof(groupDesc), groupDescOffset), sizeof(groupDesc));
+
+    memset(content, COMINIT_UTEST_FSTEMPLATE_FILL, COMINIT_UTEST_FSTEMPLATE_SIZE);
+    assert_int_equal(pwrite(targetFd, content, COMINIT_UTEST_FSTEMPLATE_SIZE, 0), COMINIT_UTEST_FSTEMPLATE_SIZE);
+
+    assert_int_equal(cominitFsTemplateCopy(templatePath, targetPath, &written), EXIT_SUCCESS);
+    assert_true(written >= sizeof(superblock) + sizeof(groupDesc));
+    assert_true(written <= COMINIT_UTEST_FSTEMPLATE_SIZE);
+
+    assert_int_equal(pread(targetFd, content, COMINIT_UTEST_FSTEMPLATE_SIZE, 0), COMINIT_UTEST_FSTEMPLATE_SIZE);
+    assert_memory_equal(content, superblock, sizeof(superblock));
+    assert_memory_equal(content + groupDescOffset, groupDesc, sizeof(groupDesc));
+    /* Holes must read back as zeros, whatever the target held before. */
+    assert_int_equal(content[sizeof(superblock)], 0);
+    assert_int_equal(content[groupDescOffset - 1], 0);
+    assert_int_equal(content[COMINIT_UTEST_FSTEMPLATE_SIZE - 1], 0);
+
+    close(templateFd);
+    close(targetFd);
+    unlink(templatePath);
+    unlink(targetPath);
+    free(content);
+}
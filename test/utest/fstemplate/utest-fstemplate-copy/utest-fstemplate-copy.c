@@ -0,0 +1,22 @@
+// SPDX-License-Identifier: MIT
+/**
+ * @file utest-fstemplate-copy.c
+ * @brief Implementation of an cominitFsTemplateCopy() unit test group using cmocka.
+ */
+#include "utest-fstemplate-copy.h"
+
+#include "unit_test.h"
+
+/**
+ * Run the unit tests for cominitFsTemplateCopy().
+ *
+ * @return  The same as cmocka_run_group_tests() returns for the tests.
+ */
+int main(void) {
+    const struct CMUnitTest tests[] = {
+        cmocka_unit_test(cominitFsTemplateCopyTestSuccess),
+        cmocka_unit_test(cominitFsTemplateCopyTestFailure),
+        cmocka_unit_test(cominitFsTemplateCopyTestParamFailure),
+    };
+    return cmocka_run_group_tests(tests, NULL, NULL);
+}
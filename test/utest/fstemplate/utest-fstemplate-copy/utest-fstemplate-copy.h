@@ -0,0 +1,35 @@
+// SPDX-License-Identifier: MIT
+/**
+ * @file utest-fstemplate-copy.h
+ * @brief Header declaring cmocka unit test functions for cominitFsTemplateCopy().
+ */
+#ifndef __UTEST_FSTEMPLATE_COPY_H__
+#define __UTEST_FSTEMPLATE_COPY_H__
+
+#include "common.h"
+#include "fstemplate.h"
+
+/** Size of the sparse template and the target file used in the tests. **/
+#define COMINIT_UTEST_FSTEMPLATE_SIZE (1024 * 1024)
+/** Byte pattern the target file is filled with before copying. **/
+#define COMINIT_UTEST_FSTEMPLATE_FILL 0xAA
+
+/**
+ * Unit test for cominitFsTemplateCopy() with a sparse template containing two data extents and holes to zero.
+ * @param state
+ */
+void cominitFsTemplateCopyTestSuccess(void **state);
+
+/**
+ * Unit test for cominitFsTemplateCopy() if the template or the target does not exist.
+ * @param state
+ */
+void cominitFsTemplateCopyTestFailure(void **state);
+
+/**
+ * Unit test for cominitFsTemplateCopy() and cominitFsTemplateApply() if parameters are not initialized.
+ * @param state
+ */
+void cominitFsTemplateCopyTestParamFailure(void **state);
+
+#endif /* __UTEST_FSTEMPLATE_COPY_H__ */
@@ -0,0 +1,43 @@
+// SPDX-License-Identifier: MIT
+/**
+ * @file utest-fstemplate-renew-ids-failure.c
+ * @brief Implementation of a failure case unit test for cominitFsTemplateRenewIds().
+ */
+#include <cmocka_extensions/cmocka_extensions.h>
+#include <stdlib.h>
+#include <unistd.h>
+
+#include "utest-fstemplate-renew-ids.h"
+
+void cominitFsTemplateRenewIdsTestFailure(void **state) {
+    COMINIT_PARAM_UNUSED(state);
+
+    char path[] = "/tmp/utest-fstemplate-renew-ids-XXXXXX";
+    uint8_t sb[COMINIT_UTEST_EXT4_SB_SIZE] = {0};
+    uint8_t readBack[COMINIT_UTEST_EXT4_SB_SIZE];
+
+    assert_int_equal(cominitFsTemplateRenewIds("/tmp/utest-fstemplate-nonexistent"), EXIT_FAILURE);
+
+    int fd = mkstemp(path);
+    assert_true(fd >= 0);
+
+    /* Too short to hold a superblock */
+    assert_int_equal(cominitFsTemplateRenewIds(path), EXIT_FAILURE);
+
+    /* No ext4 magic */
+    assert_int_equal(pwrite(fd, sb, sizeof(sb), COMINIT_UTEST_EXT4_SB_OFFSET), sizeof(sb));
+    assert_int_equal(cominitFsTemplateRenewIds(path), EXIT_FAILURE);
+
+    /* uninit_bg without metadata_csum, the group descriptor checksums depend on the UUID */
+    sb[COMINIT_UTEST_EXT4_MAGIC_OFF] = COMINIT_UTEST_EXT4_MAGIC & 0xFF;
+    sb[COMINIT_UTEST_EXT4_MAGIC_OFF + 1] = COMINIT_UTEST_EXT4_MAGIC >> 8;
+    sb[COMINIT_UTEST_EXT4_RO_COMPAT_OFF] = COMINIT_UTEST_EXT4_GDT_CSUM;
+    assert_int_equal(pwrite(fd, sb, sizeof(sb), COMINIT_UTEST_EXT4_SB_OFFSET), sizeof(sb));
+    assert_int_equal(cominitFsTemplateRenewIds(path), EXIT_FAILURE);
+
+    assert_int_equal(pread(fd, readBack, sizeof(readBack), COMINIT_UTEST_EXT4_SB_OFFSET), sizeof(readBack));
+    assert_memory_equal(readBack, sb, sizeof(sb));
+
+    close(fd);
+    unlink(path);
+}
@@ -0,0 +1,15 @@
+// SPDX-License-Identifier: MIT
+/**
+ * @file utest-fstemplate-renew-ids-param-failure.c
+ * @brief Implementation of a failure case unit test for cominitFsTemplateRenewIds() with invalid parameters.
+ */
+#include <cmocka_extensions/cmocka_extensions.h>
+#include <stdlib.h>
+
+#include "utest-fstemplate-renew-ids.h"
+
+void cominitFsTemplateRenewIdsTestParamFailure(void **state) {
+    COMINIT_PARAM_UNUSED(state);
+
+    assert_int_equal(cominitFsTemplateRenewIds(NULL), EXIT_FAILURE);
+}
@@ -0,0 +1,82 @@
+// SPDX-License-Identifier: MIT
+/**
+ * @file utest-fstemplate-renew-ids-success.c
+ * @brief Implementation of a success case unit test for cominitFsTemplateRenewIds().
+ */
+#include <cmocka_extensions/cmocka_extensions.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+#include "utest-fstemplate-renew-ids.h"
+
+/**
+ * Read a little endian 32 bit value from the superblock.
+ */
+static uint32_t cominitUtestGetLe32(const uint8_t *p) {
+    return (uint32_t)p[0] | ((uint32_t)p[1] << 8) | ((uint32_t)p[2] << 16) | ((uint32_t)p[3] << 24);
+}
+
+/**
+ * Reference CRC32C as used by ext4, without the final inversion.
+ */
+static uint32_t cominitUtestCrc32c(uint32_t crc, const uint8_t *data, size_t len) {
+    for (size_t i = 0; i < len; i++) {
+        crc ^= data[i];
+        for (int bit = 0; bit < 8; bit++) {
+            crc = (crc >> 1) ^ (0x82F63B78u & (0u - (crc & 1u)));
+        }
+    }
+    return crc;
+}
+
+/**
+ * Renews the IDs of an image holding only a superblock with the given features and checks the result.
+ */
+static void cominitUtestRenewIds(uint32_t roCompat) {
+    char path[] = "/tmp/utest-fstemplate-renew-ids-XXXXXX";
+    uint8_t before[COMINIT_UTEST_EXT4_SB_SIZE] = {0};
+    uint8_t after[COMINIT_UTEST_EXT4_SB_SIZE];
+
+    before[COMINIT_UTEST_EXT4_MAGIC_OFF] = COMINIT_UTEST_EXT4_MAGIC & 0xFF;
+    before[COMINIT_UTEST_EXT4_MAGIC_OFF + 1] = COMINIT_UTEST_EXT4_MAGIC >> 8;
+    before[COMINIT_UTEST_EXT4_RO_COMPAT_OFF] = roCompat & 0xFF;
+    before[COMINIT_UTEST_EXT4_RO_COMPAT_OFF + 1] = (roCompat >> 8) & 0xFF;
+    memset(before + COMINIT_UTEST_EXT4_UUID_OFF, 0x11, 16);
+    memset(before + COMINIT_UTEST_EXT4_HASH_SEED_OFF, 0x22, 16);
+
+    int fd = mkstemp(path);
+    assert_true(fd >= 0);
+    assert_int_equal(pwrite(fd, before, sizeof(before), COMINIT_UTEST_EXT4_SB_OFFSET), sizeof(before));
+
+    assert_int_equal(cominitFsTemplateRenewIds(path), EXIT_SUCCESS);
+
+    assert_int_equal(pread(fd, after, sizeof(after), COMINIT_UTEST_EXT4_SB_OFFSET), sizeof(after));
+    assert_memory_not_equal(after + COMINIT_UTEST_EXT4_UUID_OFF, before + COMINIT_UTEST_EXT4_UUID_OFF, 16);
+    assert_memory_not_equal(after + COMINIT_UTEST_EXT4_HASH_SEED_OFF, before + COMINIT_UTEST_EXT4_HASH_SEED_OFF, 16);
+    assert_int_equal(after[COMINIT_UTEST_EXT4_UUID_OFF + 6] & 0xF0, 0x40);
+    assert_int_equal(after[COMINIT_UTEST_EXT4_UUID_OFF + 8] & 0xC0, 0x80);
+
+    uint32_t incompat = cominitUtestGetLe32(after + COMINIT_UTEST_EXT4_INCOMPAT_OFF);
+    if (roCompat & COMINIT_UTEST_EXT4_METADATA_CSUM) {
+        /* The checksum seed must still be the one derived from the old UUID. */
+        assert_true(incompat & COMINIT_UTEST_EXT4_CSUM_SEED);
+        assert_int_equal(cominitUtestGetLe32(after + COMINIT_UTEST_EXT4_CSUM_SEED_OFF),
+                         cominitUtestCrc32c(~0u, before + COMINIT_UTEST_EXT4_UUID_OFF, 16));
+        assert_int_equal(cominitUtestGetLe32(after + COMINIT_UTEST_EXT4_CSUM_OFF),
+                         cominitUtestCrc32c(~0u, after, COMINIT_UTEST_EXT4_CSUM_OFF));
+    } else {
+        assert_false(incompat & COMINIT_UTEST_EXT4_CSUM_SEED);
+        assert_int_equal(cominitUtestGetLe32(after + COMINIT_UTEST_EXT4_CSUM_OFF), 0);
+    }
+
+    close(fd);
+    unlink(path);
+}
+
+void cominitFsTemplateRenewIdsTestSuccess(void **state) {
+    COMINIT_PARAM_UNUSED(state);
+
+    cominitUtestRenewIds(COMINIT_UTEST_EXT4_METADATA_CSUM);
+    cominitUtestRenewIds(0);
+}
@@ -0,0 +1,22 @@
+// SPDX-License-Identifier: MIT
+/**
+ * @file utest-fstemplate-renew-ids.c
+ * @brief Implementation of an cominitFsTemplateRenewIds() unit test group using cmocka.
+ */
+#include "utest-fstemplate-renew-ids.h"
+
+#include "unit_test.h"
+
+/**
+ * Run the unit tests for cominitFsTemplateRenewIds().
+ *
+ * @return  The same as cmocka_run_group_tests() returns for the tests.
+ */
+int main(void) {
+    const struct CMUnitTest tests[] = {
+        cmocka_unit_test(cominitFsTemplateRenewIdsTestSuccess),
+        cmocka_unit_test(cominitFsTemplateRenewIdsTestFailure),
+        cmocka_unit_test(cominitFsTemplateRenewIdsTestParamFailure),
+    };
+    return cmocka_run_group_tests(tests, NULL, NULL);
+}
@@ -0,0 +1,60 @@
+// SPDX-License-Identifier: MIT
+/**
+ * @file utest-fstemplate-renew-ids.h
+ * @brief Header declaring cmocka unit test functions for cominitFsTemplateRenewIds().
+ */
+#ifndef __UTEST_FSTEMPLATE_RENEW_IDS_H__
+#define __UTEST_FSTEMPLATE_RENEW_IDS_H__
+
+#include <stdint.h>
+
+#include "common.h"
+#include "fstemplate.h"
+
+/** Offset of the ext4 superblock in the test images. **/
+#define COMINIT_UTEST_EXT4_SB_OFFSET 1024
+/** Size of the ext4 superblock. **/
+#define COMINIT_UTEST_EXT4_SB_SIZE 1024
+/** Offset of s_feature_incompat in the superblock. **/
+#define COMINIT_UTEST_EXT4_INCOMPAT_OFF 0x60
+/** Offset of s_feature_ro_compat in the superblock. **/
+#define COMINIT_UTEST_EXT4_RO_COMPAT_OFF 0x64
+/** Offset of s_uuid in the superblock. **/
+#define COMINIT_UTEST_EXT4_UUID_OFF 0x68
+/** Offset of s_hash_seed in the superblock. **/
+#define COMINIT_UTEST_EXT4_HASH_SEED_OFF 0xEC
+/** Offset of s_checksum_seed in the superblock. **/
+#define COMINIT_UTEST_EXT4_CSUM_SEED_OFF 0x270
+/** Offset of s_checksum in the superblock. **/
+#define COMINIT_UTEST_EXT4_CSUM_OFF 0x3FC
+/** Offset of s_magic in the superblock. **/
+#define COMINIT_UTEST_EXT4_MAGIC_OFF 0x38
+
+/** The ext4 superblock magic. **/
+#define COMINIT_UTEST_EXT4_MAGIC 0xEF53
+/** Feature uninit_bg. **/
+#define COMINIT_UTEST_EXT4_GDT_CSUM 0x10u
+/** Feature metadata_csum. **/
+#define COMINIT_UTEST_EXT4_METADATA_CSUM 0x400u
+/** Feature metadata_csum_seed. **/
+#define COMINIT_UTEST_EXT4_CSUM_SEED 0x2000u
+
+/**
+ * Unit test for cominitFsTemplateRenewIds() with and without metadata_csum.
+ * @param state
+ */
+void cominitFsTemplateRenewIdsTestSuccess(void **state);
+
+/**
+ * Unit test for cominitFsTemplateRenewIds() on a missing device, a non-ext4 image and an image using uninit_bg.
+ * @param state
+ */
+void cominitFsTemplateRenewIdsTestFailure(void **state);
+
+/**
+ * Unit test for cominitFsTemplateRenewIds() if parameters are not initialized.
+ * @param state
+ */
+void cominitFsTemplateRenewIdsTestParamFailure(void **state);
+
+#endif /* __UTEST_FSTEMPLATE_RENEW_IDS_H__ */
@@ -0,0 +1,26 @@
+// SPDX-License-Identifier: MIT
+/**
+ * @file utest-kcapi-probe-failure.c
+ * @brief Implementation of a failure case unit test for cominitKcapiProbe().
+ */
+#include <cmocka_extensions/cmocka_extensions.h>
+#include <stdlib.h>
+
+#include "mock_bind.h"
+#include "mock_close.h"
+#include "mock_socket.h"
+#include "utest-kcapi-probe.h"
+
+void cominitKcapiProbeTestFailure(void **state) {
+    COMINIT_PARAM_UNUSED(state);
+
+    cominitKcapiProbeTestExpectBind("cominit-nonexistent", -1);
+    assert_int_equal(cominitKcapiProbe("hash", "cominit-nonexistent"), EXIT_FAILURE);
+
+    /* The negative result is cached as well. */
+    assert_int_equal(cominitKcapiProbe("hash", "cominit-nonexistent"), EXIT_FAILURE);
+
+    cominitMockSocketEnabled = false;
+    cominitMockBindEnabled = false;
+    cominitMockCloseEnabled = false;
+}
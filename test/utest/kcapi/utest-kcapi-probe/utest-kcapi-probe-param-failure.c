@@ -0,0 +1,19 @@
+// SPDX-License-Identifier: MIT
+/**
+ * @file utest-kcapi-probe-param-failure.c
+ * @brief Implementation of a failure case unit test for cominitKcapiProbe() with invalid parameters.
+ */
+#include <cmocka_extensions/cmocka_extensions.h>
+#include <stdlib.h>
+
+#include "utest-kcapi-probe.h"
+
+void cominitKcapiProbeTestParamFailure(void **state) {
+    COMINIT_PARAM_UNUSED(state);
+
+    assert_int_equal(cominitKcapiProbe(NULL, "sha256"), EXIT_FAILURE);
+    assert_int_equal(cominitKcapiProbe("hash", NULL), EXIT_FAILURE);
+    assert_int_equal(cominitKcapiProbe("hash", "a-very-long-algorithm-name-which-exceeds-the-limit-of-af-alg-sockets"),
+                     EXIT_FAILURE);
+    assert_int_equal(cominitKcapiProbeDmCipher(NULL), EXIT_FAILURE);
+}
@@ -0,0 +1,80 @@
+// SPDX-License-Identifier: MIT
+/**
+ * @file utest-kcapi-probe-success.c
+ * @brief Implementation of a success case unit test for cominitKcapiProbe().
+ */
+#include <cmocka_extensions/cmocka_extensions.h>
+#include <linux/if_alg.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "mock_bind.h"
+#include "mock_close.h"
+#include "mock_socket.h"
+#include "utest-kcapi-probe.h"
+
+/**
+ * Custom cmocka parameter check for the algorithm name passed to bind().
+ *
+ * @param value         The struct sockaddr_alg given to bind().
+ * @param checkValue    The expected algorithm name.
+ *
+ * @return  1 if the names match, 0 otherwise
+ */
+static int cominitKcapiProbeTestCheckAlgName(const LargestIntegralType value, const LargestIntegralType checkValue) {
+    const struct sockaddr_alg *sa = (const struct sockaddr_alg *)(uintptr_t)value;
+    const char *algName = (const char *)(uintptr_t)checkValue;
+
+    return (sa->salg_family == AF_ALG && strcmp((const char *)sa->salg_name, algName) == 0) ? 1 : 0;
+}
+
+void cominitKcapiProbeTestExpectBind(const char *algName, int bindRet) {
+    cominitMockSocketEnabled = true;
+    cominitMockBindEnabled = true;
+    cominitMockCloseEnabled = true;
+
+    expect_value(__wrap_socket, domain, AF_ALG);
+    will_return(__wrap_socket, COMINIT_UTEST_KCAPI_FD);
+    expect_value(__wrap_bind, sockfd, COMINIT_UTEST_KCAPI_FD);
+    expect_check(__wrap_bind, addr, cominitKcapiProbeTestCheckAlgName, (uintptr_t)algName);
+    will_return(__wrap_bind, bindRet);
+    expect_value(__wrap_close, fd, COMINIT_UTEST_KCAPI_FD);
+    will_return(__wrap_close, 0);
+}
+
+void cominitKcapiProbeTestSuccess(void **state) {
+    COMINIT_PARAM_UNUSED(state);
+
+    cominitKcapiProbeTestExpectBind("sha256", 0);
+    assert_int_equal(cominitKcapiProbe("hash", "sha256"), EXIT_SUCCESS);
+
+    /* Second probe must be answered from the cache without touching AF_ALG. */
+    assert_int_equal(cominitKcapiProbe("hash", "sha256"), EXIT_SUCCESS);
+
+    cominitMockSocketEnabled = false;
+    cominitMockBindEnabled = false;
+    cominitMockCloseEnabled = false;
+}
+
+void cominitKcapiProbeTestSuccessDmCipher(void **state) {
+    COMINIT_PARAM_UNUSED(state);
+
+    cominitKcapiProbeTestExpectBind("xts(aes)", 0);
+    assert_int_equal(cominitKcapiProbeDmCipher("aes-xts-plain64"), EXIT_SUCCESS);
+
+    cominitKcapiProbeTestExpectBind("adiantum(xchacha12,aes)", 0);
+    assert_int_equal(cominitKcapiProbeDmCipher("capi:adiantum(xchacha12,aes)-plain64"), EXIT_SUCCESS);
+
+    cominitKcapiProbeTestExpectBind("cbc(serpent)", 0);
+    assert_int_equal(cominitKcapiProbeDmCipher("serpent:2-cbc-essiv:sha256"), EXIT_SUCCESS);
+
+    cominitKcapiProbeTestExpectBind("cbc(twofish)", 0);
+    assert_int_equal(cominitKcapiProbeDmCipher("twofish"), EXIT_SUCCESS);
+
+    /* Same Kernel algorithm as the first specification, answered from the cache. */
+    assert_int_equal(cominitKcapiProbeDmCipher("aes-xts-essiv:sha256"), EXIT_SUCCESS);
+
+    cominitMockSocketEnabled = false;
+    cominitMockBindEnabled = false;
+    cominitMockCloseEnabled = false;
+}
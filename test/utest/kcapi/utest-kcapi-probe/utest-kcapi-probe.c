@@ -0,0 +1,23 @@
+// SPDX-License-Identifier: MIT
+/**
+ * @file utest-kcapi-probe.c
+ * @brief Implementation of an cominitKcapiProbe() unit test group using cmocka.
+ */
+#include "utest-kcapi-probe.h"
+
+#include "unit_test.h"
+
+/**
+ * Run the unit tests for cominitKcapiProbe().
+ *
+ * @return  The same as cmocka_run_group_tests() returns for the tests.
+ */
+int main(void) {
+    const struct CMUnitTest tests[] = {
+        cmocka_unit_test(cominitKcapiProbeTestSuccess),
+        cmocka_unit_test(cominitKcapiProbeTestSuccessDmCipher),
+        cmocka_unit_test(cominitKcapiProbeTestFailure),
+        cmocka_unit_test(cominitKcapiProbeTestParamFailure),
+    };
+    return cmocka_run_group_tests(tests, NULL, NULL);
+}
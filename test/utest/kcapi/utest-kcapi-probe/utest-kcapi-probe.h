@@ -0,0 +1,49 @@
+// SPDX-License-Identifier: MIT
+/**
+ * @file utest-kcapi-probe.h
+ * @brief Header declaring cmocka unit test functions for cominitKcapiProbe().
+ */
+#ifndef __UTEST_KCAPI_PROBE_H__
+#define __UTEST_KCAPI_PROBE_H__
+
+#include <stdint.h>
+
+#include "common.h"
+#include "kcapi.h"
+
+/** Fake file descriptor returned by the socket() mock. **/
+#define COMINIT_UTEST_KCAPI_FD 42
+
+/**
+ * Expect a single AF_ALG probe binding to \a algName.
+ *
+ * @param algName   The algorithm name the probe is expected to bind to.
+ * @param bindRet   The return value of the bind() mock.
+ */
+void cominitKcapiProbeTestExpectBind(const char *algName, int bindRet);
+
+/**
+ * Unit test for cominitKcapiProbe() if the algorithm is available and the result is cached.
+ * @param state
+ */
+void cominitKcapiProbeTestSuccess(void **state);
+
+/**
+ * Unit test for cominitKcapiProbeDmCipher() translating dm-crypt cipher specifications.
+ * @param state
+ */
+void cominitKcapiProbeTestSuccessDmCipher(void **state);
+
+/**
+ * Unit test for cominitKcapiProbe() if the algorithm is unavailable and the result is cached.
+ * @param state
+ */
+void cominitKcapiProbeTestFailure(void **state);
+
+/**
+ * Unit test for cominitKcapiProbe() and cominitKcapiProbeDmCipher() if parameters are invalid.
+ * @param state
+ */
+void cominitKcapiProbeTestParamFailure(void **state);
+
+#endif /* __UTEST_KCAPI_PROBE_H__ */
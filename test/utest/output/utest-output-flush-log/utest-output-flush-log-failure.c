@@ -0,0 +1,23 @@
+// SPDX-License-Identifier: MIT
+/**
+ * @file utest-output-flush-log-failure.c
+ * @brief Implementation of failure case unit tests for cominitOutputFlushLog().
+ */
+#include <cmocka_extensions/cmocka_extensions.h>
+#include <stdlib.h>
+
+#include "common.h"
+#include "output.h"
+#include "utest-output-flush-log.h"
+
+void cominitOutputFlushLogTestFailure(void **state) {
+    COMINIT_PARAM_UNUSED(state);
+
+    assert_int_equal(cominitOutputFlushLog("/nonexistent/log"), EXIT_FAILURE);
+}
+
+void cominitOutputFlushLogTestParamFailure(void **state) {
+    COMINIT_PARAM_UNUSED(state);
+
+    assert_int_equal(cominitOutputFlushLog(NULL), EXIT_FAILURE);
+}
@@ -0,0 +1,74 @@
+// SPDX-License-Identifier: MIT
+/**
+ * @file utest-output-flush-log-success.c
+ * @brief Implementation of success case unit tests for cominitOutputFlushLog().
+ */
+#include <cmocka_extensions/cmocka_extensions.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+#include "common.h"
+#include "output.h"
+#include "utest-output-flush-log.h"
+
+/**
+ * Flushes the in-memory log to a temporary file and reads it back.
+ *
+ * @param buf   Buffer receiving the log, NUL-terminated.
+ * @param size  Size of \a buf.
+ * @return  The length of the log.
+ */
+static size_t cominitFlushAndRead(char *buf, size_t size) {
+    char path[] = "/tmp/utest-output-flush-log-XXXXXX";
+    int fd = mkstemp(path);
+    assert_true(fd >= 0);
+
+    assert_int_equal(cominitOutputFlushLog(path), EXIT_SUCCESS);
+
+    memset(buf, 0, size);
+    ssize_t n = pread(fd, buf, size - 1, 0);
+    assert_true(n >= 0);
+    close(fd);
+    unlink(path);
+
+    return (size_t)n;
+}
+
+void cominitOutputFlushLogTestSuccess(void **state) {
+    COMINIT_PARAM_UNUSED(state);
+
+    char log[1024];
+
+    cominitOutputSetVisibleLogLevel(COMINIT_LOG_LEVEL_NONE);
+    cominitInfoPrint("info %d", 1);
+    cominitDebugPrint("debug %d", 2);
+    cominitSensitivePrint("secret");
+
+    size_t len = cominitFlushAndRead(log, sizeof(log));
+
+    assert_int_equal(strncmp(log, "[COMINIT] info 1\n", strlen("[COMINIT] info 1\n")), 0);
+    assert_non_null(strstr(log, "DEBUG: debug 2\n"));
+    assert_null(strstr(log, "secret"));
+    assert_int_equal(log[len - 1], '\n');
+}
+
+void cominitOutputFlushLogTestSuccessWrapped(void **state) {
+    COMINIT_PARAM_UNUSED(state);
+
+    static char log[COMINIT_OUTPUT_LOG_RING_SIZE + 1];
+    const char *last = "[COMINIT] record 9999\n";
+
+    cominitOutputSetVisibleLogLevel(COMINIT_LOG_LEVEL_NONE);
+    for (int i = 0; i < 10000; i++) {
+        cominitInfoPrint("record %d", i);
+    }
+
+    size_t len = cominitFlushAndRead(log, sizeof(log));
+
+    assert_true(len > COMINIT_OUTPUT_LOG_RING_SIZE - COMINIT_OUTPUT_LOG_RING_SIZE / 64);
+    assert_true(len <= COMINIT_OUTPUT_LOG_RING_SIZE);
+    assert_int_equal(strncmp(log, "[COMINIT] ", strlen("[COMINIT] ")), 0);
+    assert_string_equal(log + len - strlen(last), last);
+}
@@ -0,0 +1,25 @@
+// SPDX-License-Identifier: MIT
+/**
+ * @file utest-output-flush-log.c
+ * @brief Implementation of a cominitOutputFlushLog() unit test group using cmocka.
+ */
+#include "utest-output-flush-log.h"
+
+#include "unit_test.h"
+
+/**
+ * Run the unit tests for cominitOutputFlushLog().
+ *
+ * The success test relies on an empty in-memory log and therefore has to run first.
+ *
+ * @return  The same as cmocka_run_group_tests() returns for the tests.
+ */
+int main(void) {
+    const struct CMUnitTest tests[] = {
+        cmocka_unit_test(cominitOutputFlushLogTestSuccess),
+        cmocka_unit_test(cominitOutputFlushLogTestSuccessWrapped),
+        cmocka_unit_test(cominitOutputFlushLogTestFailure),
+        cmocka_unit_test(cominitOutputFlushLogTestParamFailure),
+    };
+    return cmocka_run_group_tests(tests, NULL, NULL);
+}
@@ -0,0 +1,33 @@
+// SPDX-License-Identifier: MIT
+/**
+ * @file utest-output-flush-log.h
+ * @brief Header declaring cmocka unit test functions for cominitOutputFlushLog().
+ */
+#ifndef __UTEST_OUTPUT_FLUSH_LOG_H__
+#define __UTEST_OUTPUT_FLUSH_LOG_H__
+
+/**
+ * Unit test for cominitOutputFlushLog() successful code path keeping messages that are not visible.
+ * @param state
+ */
+void cominitOutputFlushLogTestSuccess(void **state);
+
+/**
+ * Unit test for cominitOutputFlushLog() successful code path after the oldest records have been overwritten.
+ * @param state
+ */
+void cominitOutputFlushLogTestSuccessWrapped(void **state);
+
+/**
+ * Unit test for cominitOutputFlushLog() with a file that cannot be created.
+ * @param state
+ */
+void cominitOutputFlushLogTestFailure(void **state);
+
+/**
+ * Unit test for cominitOutputFlushLog() with a NULL path.
+ * @param state
+ */
+void cominitOutputFlushLogTestParamFailure(void **state);
+
+#endif /* __UTEST_OUTPUT_FLUSH_LOG_H__ */
@@ -0,0 +1,23 @@
+// SPDX-License-Identifier: MIT
+/**
+ * @file utest-output-open-kmsg-failure.c
+ * @brief Implementation of failure case unit tests for cominitOutputOpenKmsg().
+ */
+#include <cmocka_extensions/cmocka_extensions.h>
+#include <stdlib.h>
+
+#include "common.h"
+#include "output.h"
+#include "utest-output-open-kmsg.h"
+
+void cominitOutputOpenKmsgTestFailure(void **state) {
+    COMINIT_PARAM_UNUSED(state);
+
+    assert_int_equal(cominitOutputOpenKmsg("/nonexistent/kmsg"), EXIT_FAILURE);
+}
+
+void cominitOutputOpenKmsgTestParamFailure(void **state) {
+    COMINIT_PARAM_UNUSED(state);
+
+    assert_int_equal(cominitOutputOpenKmsg(NULL), EXIT_FAILURE);
+}
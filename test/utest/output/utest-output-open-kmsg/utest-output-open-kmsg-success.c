@@ -0,0 +1,113 @@
+// SPDX-License-Identifier: MIT
+/**
+ * @file utest-output-open-kmsg-success.c
+ * @brief Implementation of success case unit tests for cominitOutputOpenKmsg().
+ */
+#include <cmocka_extensions/cmocka_extensions.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+#include "common.h"
+#include "output.h"
+#include "utest-output-open-kmsg.h"
+
+/**
+ * Logs an info and a sensitive message in a child process with \a kmsgPath as kernel log device and a pipe as stderr.
+ *
+ * @param consoleLogLevel   The console log level to set in the child.
+ * @param kmsgPath          The kernel log device to use.
+ * @param console           Buffer receiving what was written to stderr.
+ * @param consoleSize       Size of \a console.
+ */
+static void cominitTriggerKmsgOutputTestPath(cominitLogLevelE_t consoleLogLevel, const char *kmsgPath, char *console,
+                                             size_t consoleSize) {
+    int pipefd[2] = {-1, -1};
+    int status = -1;
+
+    assert_int_equal(pipe(pipefd), 0);
+
+    pid_t pid = fork();
+    assert_true(pid >= 0);
+    if (pid == 0) {
+        close(pipefd[0]);
+        dup2(pipefd[1], STDERR_FILENO);
+        close(pipefd[1]);
+        cominitOutputSetVisibleLogLevel(COMINIT_LOG_LEVEL_SENSITIVE);
+        cominitOutputSetConsoleLogLevel(consoleLogLevel);
+        if (cominitOutputOpenKmsg(kmsgPath) != EXIT_SUCCESS) {
+            _exit(EXIT_FAILURE);
+        }
+        cominitInfoPrint("test %d", 123);
+        cominitSensitivePrint("secret");
+        _exit(EXIT_SUCCESS);
+    }
+    close(pipefd[1]);
+    waitpid(pid, &status, 0);
+    assert_true(WIFEXITED(status) && WEXITSTATUS(status) == EXIT_SUCCESS);
+
+    memset(console, 0, consoleSize);
+    assert_true(read(pipefd[0], console, consoleSize - 1) >= 0);
+    close(pipefd[0]);
+}
+
+/**
+ * Logs an info and a sensitive message in a child process with a temporary file as kernel log device and a pipe as
+ * stderr.
+ *
+ * @param consoleLogLevel   The console log level to set in the child.
+ * @param kmsg              Buffer receiving the content of the kernel log file.
+ * @param kmsgSize          Size of \a kmsg.
+ * @param console           Buffer receiving what was written to stderr.
+ * @param consoleSize       Size of \a console.
+ */
+static void cominitTriggerKmsgOutputTest(cominitLogLevelE_t consoleLogLevel, char *kmsg, size_t kmsgSize,
+                                         char *console, size_t consoleSize) {
+    char kmsgPath[] = "/tmp/utest-output-open-kmsg-XXXXXX";
+    int kmsgFd = mkstemp(kmsgPath);
+
+    assert_true(kmsgFd >= 0);
+    cominitTriggerKmsgOutputTestPath(consoleLogLevel, kmsgPath, console, consoleSize);
+
+    memset(kmsg, 0, kmsgSize);
+    assert_true(pread(kmsgFd, kmsg, kmsgSize - 1, 0) >= 0);
+    close(kmsgFd);
+    unlink(kmsgPath);
+}
+
+void cominitOutputOpenKmsgTestSuccess(void **state) {
+    COMINIT_PARAM_UNUSED(state);
+
+    char kmsg[256];
+    char console[256];
+
+    cominitTriggerKmsgOutputTest(COMINIT_LOG_LEVEL_NONE, kmsg, sizeof(kmsg), console, sizeof(console));
+
+    assert_string_equal(kmsg, "<6>[COMINIT] test 123\n");
+    assert_string_equal(console, "");
+}
+
+void cominitOutputOpenKmsgTestSuccessConsole(void **state) {
+    COMINIT_PARAM_UNUSED(state);
+
+    char kmsg[256];
+    char console[256];
+
+    cominitTriggerKmsgOutputTest(COMINIT_LOG_LEVEL_INFO, kmsg, sizeof(kmsg), console, sizeof(console));
+
+    assert_string_equal(kmsg, "<6>[COMINIT] test 123\n");
+    assert_memory_equal(console, "[COMINIT] test 123\n", strlen("[COMINIT] test 123\n"));
+}
+
+void cominitOutputOpenKmsgTestSuccessFallback(void **state) {
+    COMINIT_PARAM_UNUSED(state);
+
+    char console[256];
+
+    /* Every write to /dev/full fails, so the records the kernel log refuses must go to stderr instead. */
+    cominitTriggerKmsgOutputTestPath(COMINIT_LOG_LEVEL_NONE, "/dev/full", console, sizeof(console));
+
+    assert_memory_equal(console, "[COMINIT] test 123\n", strlen("[COMINIT] test 123\n"));
+}
@@ -0,0 +1,24 @@
+// SPDX-License-Identifier: MIT
+/**
+ * @file utest-output-open-kmsg.c
+ * @brief Implementation of a cominitOutputOpenKmsg() unit test group using cmocka.
+ */
+#include "utest-output-open-kmsg.h"
+
+#include "unit_test.h"
+
+/**
+ * Run the unit tests for cominitOutputOpenKmsg().
+ *
+ * @return  The same as cmocka_run_group_tests() returns for the tests.
+ */
+int main(void) {
+    const struct CMUnitTest tests[] = {
+        cmocka_unit_test(cominitOutputOpenKmsgTestSuccess),
+        cmocka_unit_test(cominitOutputOpenKmsgTestSuccessConsole),
+        cmocka_unit_test(cominitOutputOpenKmsgTestSuccessFallback),
+        cmocka_unit_test(cominitOutputOpenKmsgTestFailure),
+        cmocka_unit_test(cominitOutputOpenKmsgTestParamFailure),
+    };
+    return cmocka_run_group_tests(tests, NULL, NULL);
+}
@@ -0,0 +1,39 @@
+// SPDX-License-Identifier: MIT
+/**
+ * @file utest-output-open-kmsg.h
+ * @brief Header declaring cmocka unit test functions for cominitOutputOpenKmsg().
+ */
+#ifndef __UTEST_OUTPUT_OPEN_KMSG_H__
+#define __UTEST_OUTPUT_OPEN_KMSG_H__
+
+/**
+ * Unit test for cominitOutputOpenKmsg() successful code path writing to the kernel log only.
+ * @param state
+ */
+void cominitOutputOpenKmsgTestSuccess(void **state);
+
+/**
+ * Unit test for cominitOutputOpenKmsg() successful code path with a console log level copying records to stderr.
+ * @param state
+ */
+void cominitOutputOpenKmsgTestSuccessConsole(void **state);
+
+/**
+ * Unit test for cominitOutputOpenKmsg() with a kernel log device refusing every record, which goes to stderr instead.
+ * @param state
+ */
+void cominitOutputOpenKmsgTestSuccessFallback(void **state);
+
+/**
+ * Unit test for cominitOutputOpenKmsg() with a device that cannot be opened.
+ * @param state
+ */
+void cominitOutputOpenKmsgTestFailure(void **state);
+
+/**
+ * Unit test for cominitOutputOpenKmsg() with a NULL path.
+ * @param state
+ */
+void cominitOutputOpenKmsgTestParamFailure(void **state);
+
+#endif /* __UTEST_OUTPUT_OPEN_KMSG_H__ */
@@ -0,0 +1,66 @@
+// SPDX-License-Identifier: MIT
+/**
+ * @file utest-secure-arena-after-fork-success.c
+ * @brief Implementation of a success case unit test for cominitSecureArenaAfterFork().
+ */
+#include <cmocka_extensions/cmocka_extensions.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+#include "common.h"
+#include "utest-secure-arena-after-fork.h"
+
+/**
+ * Reads the amount of locked memory of the calling process.
+ *
+ * @return  The value of `VmLck` in /proc/self/status in kB, 0 if it cannot be read.
+ */
+static unsigned long cominitSecureArenaAfterForkTestLocked(void) {
+    unsigned long locked = 0;
+    char line[128];
+    FILE *fp = fopen("/proc/self/status", "r");
+
+    if (fp != NULL) {
+        while (fgets(line, sizeof(line), fp) != NULL) {
+            if (sscanf(line, "VmLck: %lu kB", &locked) == 1) {
+                break;
+            }
+        }
+        fclose(fp);
+    }
+
+    return locked;
+}
+
+void cominitSecureArenaAfterForkTestSuccess(void **state) {
+    COMINIT_PARAM_UNUSED(state);
+    int status = -1;
+
+    /* Nothing to do before the arena is set up. */
+    assert_int_equal(cominitSecureArenaAfterFork(), EXIT_SUCCESS);
+
+    uint8_t *secret = cominitSecureArenaAlloc(32);
+    assert_non_null(secret);
+    memset(secret, 0xa5, 32);
+
+    pid_t pid = fork();
+    assert_true(pid >= 0);
+    if (pid == 0) {
+        /* The child starts without locked memory, an empty arena and none of the parent's secrets. */
+        bool ok = cominitSecureArenaAfterForkTestLocked() == 0 && cominitSecureArenaAfterFork() == EXIT_SUCCESS &&
+                  cominitSecureArenaAfterForkTestLocked() > 0 &&
+                  cominitSecureArenaVerifyZero(secret, 32) == EXIT_SUCCESS &&
+                  cominitSecureArenaAlloc(32) == secret;
+        _exit(ok ? EXIT_SUCCESS : EXIT_FAILURE);
+    }
+    waitpid(pid, &status, 0);
+    assert_true(WIFEXITED(status) && WEXITSTATUS(status) == EXIT_SUCCESS);
+
+    /* The parent keeps its secret. */
+    assert_int_equal(secret[0], 0xa5);
+    assert_int_equal(cominitSecureArenaFree(secret, 32), EXIT_SUCCESS);
+}
@@ -0,0 +1,20 @@
+// SPDX-License-Identifier: MIT
+/**
+ * @file utest-secure-arena-after-fork.c
+ * @brief Implementation of a cominitSecureArenaAfterFork() unit test group using cmocka.
+ */
+#include "utest-secure-arena-after-fork.h"
+
+#include "unit_test.h"
+
+/**
+ * Run the unit tests for cominitSecureArenaAfterFork().
+ *
+ * @return  The same as cmocka_run_group_tests() returns for the tests.
+ */
+int main(void) {
+    const struct CMUnitTest tests[] = {
+        cmocka_unit_test(cominitSecureArenaAfterForkTestSuccess),
+    };
+    return cmocka_run_group_tests(tests, NULL, NULL);
+}
@@ -0,0 +1,17 @@
+// SPDX-License-Identifier: MIT
+/**
+ * @file utest-secure-arena-after-fork.h
+ * @brief Header declaring cmocka unit test functions for cominitSecureArenaAfterFork().
+ */
+#ifndef __UTEST_SECURE_ARENA_AFTER_FORK_H__
+#define __UTEST_SECURE_ARENA_AFTER_FORK_H__
+
+#include "securearena.h"
+
+/**
+ * Unit test for cominitSecureArenaAfterFork() successful code path.
+ * @param state
+ */
+void cominitSecureArenaAfterForkTestSuccess(void **state);
+
+#endif /* __UTEST_SECURE_ARENA_AFTER_FORK_H__ */
@@ -0,0 +1,24 @@
+// SPDX-License-Identifier: MIT
+/**
+ * @file utest-secure-arena-alloc-failure.c
+ * @brief Implementation of a failure case unit test for cominitSecureArenaAlloc().
+ */
+#include <cmocka_extensions/cmocka_extensions.h>
+#include <stdint.h>
+#include <stdlib.h>
+
+#include "common.h"
+#include "utest-secure-arena-alloc.h"
+
+void cominitSecureArenaAllocTestFailure(void **state) {
+    COMINIT_PARAM_UNUSED(state);
+
+    uint8_t *key = cominitSecureArenaAlloc(COMINIT_SECURE_ARENA_SIZE);
+    assert_non_null(key);
+
+    /* More than the arena can hold, even after rounding it up to whole pages */
+    assert_null(cominitSecureArenaAlloc(64 * COMINIT_SECURE_ARENA_SIZE));
+    assert_null(cominitSecureArenaAlloc(SIZE_MAX));
+
+    assert_int_equal(cominitSecureArenaFree(key, COMINIT_SECURE_ARENA_SIZE), EXIT_SUCCESS);
+}
@@ -0,0 +1,21 @@
+// SPDX-License-Identifier: MIT
+/**
+ * @file utest-secure-arena-alloc-param-failure.c
+ * @brief Implementation of a parameter failure case unit test for cominitSecureArenaAlloc() and
+ *        cominitSecureArenaFree().
+ */
+#include <cmocka_extensions/cmocka_extensions.h>
+#include <stdint.h>
+#include <stdlib.h>
+
+#include "common.h"
+#include "utest-secure-arena-alloc.h"
+
+void cominitSecureArenaAllocTestParamFailure(void **state) {
+    COMINIT_PARAM_UNUSED(state);
+
+    uint8_t notInArena[16] = {0};
+
+    assert_null(cominitSecureArenaAlloc(0));
+    assert_int_equal(cominitSecureArenaFree(notInArena, sizeof(notInArena)), EXIT_FAILURE);
+}
@@ -0,0 +1,42 @@
+// SPDX-License-Identifier: MIT
+/**
+ * @file utest-secure-arena-alloc-success.c
+ * @brief Implementation of a success case unit test for cominitSecureArenaAlloc() and cominitSecureArenaFree().
+ */
+#include <cmocka_extensions/cmocka_extensions.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "common.h"
+#include "utest-secure-arena-alloc.h"
+
+void cominitSecureArenaAllocTestSuccess(void **state) {
+    COMINIT_PARAM_UNUSED(state);
+
+    uint8_t *first = cominitSecureArenaAlloc(32);
+    uint8_t *second = cominitSecureArenaAlloc(5);
+    assert_non_null(first);
+    assert_non_null(second);
+    assert_true(second >= first + 32);
+    assert_int_equal((uintptr_t)second % 16, 0);
+    assert_memory_is_zeroed(first, 32);
+
+    memset(first, 0xa5, 32);
+    memset(second, 0x5a, 5);
+
+    /* Released memory is wiped and the newest allocation is reused right away. */
+    assert_int_equal(cominitSecureArenaFree(second, 5), EXIT_SUCCESS);
+    assert_memory_is_zeroed(second, 5);
+    assert_ptr_equal(cominitSecureArenaAlloc(5), second);
+    assert_int_equal(cominitSecureArenaFree(second, 5), EXIT_SUCCESS);
+
+    assert_int_equal(cominitSecureArenaFree(first, 32), EXIT_SUCCESS);
+    assert_memory_is_zeroed(first, 32);
+
+    /* Once everything is released, the arena starts from the beginning. */
+    assert_ptr_equal(cominitSecureArenaAlloc(COMINIT_SECURE_ARENA_SIZE), first);
+    assert_int_equal(cominitSecureArenaFree(first, COMINIT_SECURE_ARENA_SIZE), EXIT_SUCCESS);
+
+    assert_int_equal(cominitSecureArenaFree(NULL, 32), EXIT_SUCCESS);
+}
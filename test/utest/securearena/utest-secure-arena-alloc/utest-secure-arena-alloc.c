@@ -0,0 +1,22 @@
+// SPDX-License-Identifier: MIT
+/**
+ * @file utest-secure-arena-alloc.c
+ * @brief Implementation of a cominitSecureArenaAlloc() unit test group using cmocka.
+ */
+#include "utest-secure-arena-alloc.h"
+
+#include "unit_test.h"
+
+/**
+ * Run the unit tests for cominitSecureArenaAlloc().
+ *
+ * @return  The same as cmocka_run_group_tests() returns for the tests.
+ */
+int main(void) {
+    const struct CMUnitTest tests[] = {
+        cmocka_unit_test(cominitSecureArenaAllocTestSuccess),
+        cmocka_unit_test(cominitSecureArenaAllocTestFailure),
+        cmocka_unit_test(cominitSecureArenaAllocTestParamFailure),
+    };
+    return cmocka_run_group_tests(tests, NULL, NULL);
+}
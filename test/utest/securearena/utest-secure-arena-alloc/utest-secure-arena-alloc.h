@@ -0,0 +1,29 @@
+// SPDX-License-Identifier: MIT
+/**
+ * @file utest-secure-arena-alloc.h
+ * @brief Header declaring cmocka unit test functions for cominitSecureArenaAlloc() and cominitSecureArenaFree().
+ */
+#ifndef __UTEST_SECURE_ARENA_ALLOC_H__
+#define __UTEST_SECURE_ARENA_ALLOC_H__
+
+#include "securearena.h"
+
+/**
+ * Unit test for cominitSecureArenaAlloc() and cominitSecureArenaFree() successful code path.
+ * @param state
+ */
+void cominitSecureArenaAllocTestSuccess(void **state);
+
+/**
+ * Unit test for cominitSecureArenaAlloc() with an exhausted arena.
+ * @param state
+ */
+void cominitSecureArenaAllocTestFailure(void **state);
+
+/**
+ * Unit test for cominitSecureArenaAlloc() and cominitSecureArenaFree() with invalid parameters.
+ * @param state
+ */
+void cominitSecureArenaAllocTestParamFailure(void **state);
+
+#endif /* __UTEST_SECURE_ARENA_ALLOC_H__ */
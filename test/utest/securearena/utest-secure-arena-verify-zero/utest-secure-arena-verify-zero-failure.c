@@ -0,0 +1,27 @@
+// SPDX-License-Identifier: MIT
+/**
+ * @file utest-secure-arena-verify-zero-failure.c
+ * @brief Implementation of a failure case unit test for cominitSecureArenaVerifyZero().
+ */
+#include <cmocka_extensions/cmocka_extensions.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "common.h"
+#include "utest-secure-arena-verify-zero.h"
+
+void cominitSecureArenaVerifyZeroTestFailure(void **state) {
+    COMINIT_PARAM_UNUSED(state);
+
+    uint8_t buffer[67];
+
+    for (size_t i = 0; i < sizeof(buffer); i++) {
+        memset(buffer, 0, sizeof(buffer));
+        buffer[i] = 0x01;
+        assert_int_equal(cominitSecureArenaVerifyZero(buffer, sizeof(buffer)), EXIT_FAILURE);
+    }
+
+    assert_int_equal(cominitSecureArenaVerifyZero(NULL, sizeof(buffer)), EXIT_FAILURE);
+    assert_int_equal(cominitSecureArenaVerifyZero(buffer, 0), EXIT_FAILURE);
+}
@@ -0,0 +1,28 @@
+// SPDX-License-Identifier: MIT
+/**
+ * @file utest-secure-arena-verify-zero-success.c
+ * @brief Implementation of a success case unit test for cominitSecureArenaWipe() and cominitSecureArenaVerifyZero().
+ */
+#include <cmocka_extensions/cmocka_extensions.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "common.h"
+#include "utest-secure-arena-verify-zero.h"
+
+void cominitSecureArenaVerifyZeroTestSuccess(void **state) {
+    COMINIT_PARAM_UNUSED(state);
+
+    uint8_t buffer[67];
+
+    /* Unaligned starts and lengths that are no multiple of a word */
+    for (size_t offset = 0; offset < 3; offset++) {
+        for (size_t len = 1; len <= sizeof(buffer) - offset; len++) {
+            memset(buffer, 0xff, sizeof(buffer));
+            cominitSecureArenaWipe(buffer + offset, len);
+            assert_memory_is_zeroed(buffer + offset, len);
+            assert_int_equal(cominitSecureArenaVerifyZero(buffer + offset, len), EXIT_SUCCESS);
+        }
+    }
+}
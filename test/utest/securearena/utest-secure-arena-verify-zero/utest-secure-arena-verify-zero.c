@@ -0,0 +1,21 @@
+// SPDX-License-Identifier: MIT
+/**
+ * @file utest-secure-arena-verify-zero.c
+ * @brief Implementation of a cominitSecureArenaVerifyZero() unit test group using cmocka.
+ */
+#include "utest-secure-arena-verify-zero.h"
+
+#include "unit_test.h"
+
+/**
+ * Run the unit tests for cominitSecureArenaVerifyZero().
+ *
+ * @return  The same as cmocka_run_group_tests() returns for the tests.
+ */
+int main(void) {
+    const struct CMUnitTest tests[] = {
+        cmocka_unit_test(cominitSecureArenaVerifyZeroTestSuccess),
+        cmocka_unit_test(cominitSecureArenaVerifyZeroTestFailure),
+    };
+    return cmocka_run_group_tests(tests, NULL, NULL);
+}
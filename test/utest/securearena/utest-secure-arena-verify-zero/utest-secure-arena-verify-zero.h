@@ -0,0 +1,23 @@
+// SPDX-License-Identifier: MIT
+/**
+ * @file utest-secure-arena-verify-zero.h
+ * @brief Header declaring cmocka unit test functions for cominitSecureArenaWipe() and cominitSecureArenaVerifyZero().
+ */
+#ifndef __UTEST_SECURE_ARENA_VERIFY_ZERO_H__
+#define __UTEST_SECURE_ARENA_VERIFY_ZERO_H__
+
+#include "securearena.h"
+
+/**
+ * Unit test for cominitSecureArenaVerifyZero() on wiped buffers of different sizes and alignments.
+ * @param state
+ */
+void cominitSecureArenaVerifyZeroTestSuccess(void **state);
+
+/**
+ * Unit test for cominitSecureArenaVerifyZero() with a single non-zero byte at every position and invalid parameters.
+ * @param state
+ */
+void cominitSecureArenaVerifyZeroTestFailure(void **state);
+
+#endif /* __UTEST_SECURE_ARENA_VERIFY_ZERO_H__ */
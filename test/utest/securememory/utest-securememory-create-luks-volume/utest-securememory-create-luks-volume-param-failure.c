@@ -11,5 +11,9 @@
 void cominitSecurememoryCreateLuksVolumeTestParamFailure(void **state) {
     COMINIT_PARAM_UNUSED(state);
 
-    assert_int_not_equal(cominitSecurememoryCreateLuksVolume(NULL), 0);
+    const cominitCryptsetupCipher_t cipher = {.name = "aes-xts-plain64", .keySize = 64};
+
+    assert_int_not_equal(cominitSecurememoryCreateLuksVolume(NULL, "secureStorage", &cipher), 0);
+    assert_int_not_equal(cominitSecurememoryCreateLuksVolume("/dev/crypt", NULL, &cipher), 0);
+    assert_int_not_equal(cominitSecurememoryCreateLuksVolume("/dev/crypt", "secureStorage", NULL), 0);
 }
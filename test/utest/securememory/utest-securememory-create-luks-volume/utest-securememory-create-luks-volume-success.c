@@ -13,26 +13,27 @@
 
 static char cominitTestString[] = "secret key";
 
+static uint8_t cominitTestKeyBuffer[COMINIT_PASSPHRASE_SIZE];
+
 // NOLINTNEXTLINE(readability-identifier-naming)    Rationale: Naming scheme fixed due to linker wrapping.
-int __wrap_mlock(const void *addr, size_t len) {
-    COMINIT_PARAM_UNUSED(len);
-    assert_non_null(addr);
+void *__wrap_cominitSecureArenaAlloc(size_t size) {
+    assert_int_equal(size, sizeof(cominitTestKeyBuffer));
 
-    uint8_t *outData = (uint8_t *)addr;
-    memcpy(outData, cominitTestString, ARRAY_SIZE(cominitTestString));
+    memset(cominitTestKeyBuffer, 0, sizeof(cominitTestKeyBuffer));
+    memcpy(cominitTestKeyBuffer, cominitTestString, ARRAY_SIZE(cominitTestString));
 
-    return mock_type(int);
+    return (mock_type(int) == 0) ? cominitTestKeyBuffer : NULL;
 }
 
 // NOLINTNEXTLINE(readability-identifier-naming)    Rationale: Naming scheme fixed due to linker wrapping.
-int __wrap_munlock(const void *addr, size_t len) {
-    assert_true(len > 0);
-    assert_non_null(addr);
+int __wrap_cominitSecureArenaFree(void *ptr, size_t size) {
+    assert_true(size > 0);
+    assert_ptr_equal(ptr, cominitTestKeyBuffer);
 
     /* Additional test that buffer has been cleared*/
-    uint8_t *outData = (uint8_t *)addr;
+    uint8_t *outData = (uint8_t *)ptr;
     assert_string_not_equal((char *)outData, cominitTestString);
-    assert_memory_is_zeroed(outData, ARRAY_SIZE(cominitTestString));
+    assert_memory_is_zeroed(outData, size);
 
     return mock_type(int);
 }
@@ -40,20 +41,22 @@ int __wrap_munlock(const void *addr, size_t len) {
 void cominitSecurememoryCreateLuksVolumeTestSuccess(void **state) {
     COMINIT_PARAM_UNUSED(state);
     char devCryptTest[] = "/dev/crypt";
+    const cominitCryptsetupCipher_t cipher = {.name = "aes-xts-plain64", .keySize = 64};
 
-    will_return(__wrap_mlock, 0);
+    will_return(__wrap_cominitSecureArenaAlloc, 0);
 
     expect_string(__wrap_cominitKeyringGetKey, key, cominitTestString);
-    expect_any(__wrap_cominitKeyringGetKey, keyDesc);
+    expect_string(__wrap_cominitKeyringGetKey, keyDesc, "secureStorage");
     expect_any(__wrap_cominitKeyringGetKey, keyMaxLen);
     will_return(__wrap_cominitKeyringGetKey, ARRAY_SIZE(cominitTestString));
 
     expect_string(__wrap_cominitCryptsetupCreateLuksVolume, passphrase, cominitTestString);
     expect_string(__wrap_cominitCryptsetupCreateLuksVolume, devCrypt, devCryptTest);
+    expect_value(__wrap_cominitCryptsetupCreateLuksVolume, cipher, &cipher);
     expect_any(__wrap_cominitCryptsetupCreateLuksVolume, passphraseSize);
     will_return(__wrap_cominitCryptsetupCreateLuksVolume, 0);
 
-    will_return(__wrap_munlock, 0);
+    will_return(__wrap_cominitSecureArenaFree, EXIT_SUCCESS);
 
-    assert_int_equal(cominitSecurememoryCreateLuksVolume(devCryptTest), 0);
+    assert_int_equal(cominitSecurememoryCreateLuksVolume(devCryptTest, "secureStorage", &cipher), 0);
 }
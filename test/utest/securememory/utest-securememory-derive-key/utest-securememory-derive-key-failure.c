@@ -0,0 +1,48 @@
+// SPDX-License-Identifier: MIT
+/**
+ * @file utest-securememory-derive-key-failure.c
+ * @brief Implementation of a failure case unit test for cominitSecurememoryDeriveKey().
+ */
+
+#include <cmocka_extensions/cmocka_extensions.h>
+#include <stdlib.h>
+
+#include "unit_test.h"
+#include "utest-securememory-derive-key.h"
+
+void cominitSecurememoryDeriveKeyTestFailure(void **state) {
+    COMINIT_PARAM_UNUSED(state);
+
+    /* No locked memory for the key buffer */
+    will_return(__wrap_cominitSecureArenaAlloc, -1);
+
+    assert_int_not_equal(cominitSecurememoryDeriveKey(COMINIT_TEST_ROOT_KEY, COMINIT_TEST_CONTEXT, COMINIT_TEST_KEY),
+                         EXIT_SUCCESS);
+
+    /* No root secret in the keyring */
+    will_return(__wrap_cominitSecureArenaAlloc, 0);
+    expect_any(__wrap_cominitKeyringGetKey, key);
+    expect_string(__wrap_cominitKeyringGetKey, keyDesc, COMINIT_TEST_ROOT_KEY);
+    expect_any(__wrap_cominitKeyringGetKey, keyMaxLen);
+    will_return(__wrap_cominitKeyringGetKey, -1);
+    will_return(__wrap_cominitSecureArenaFree, EXIT_SUCCESS);
+
+    assert_int_not_equal(cominitSecurememoryDeriveKey(COMINIT_TEST_ROOT_KEY, COMINIT_TEST_CONTEXT, COMINIT_TEST_KEY),
+                         EXIT_SUCCESS);
+
+    /* Derivation fails, nothing is added to the keyring */
+    will_return(__wrap_cominitSecureArenaAlloc, 0);
+    expect_any(__wrap_cominitKeyringGetKey, key);
+    expect_any(__wrap_cominitKeyringGetKey, keyDesc);
+    expect_any(__wrap_cominitKeyringGetKey, keyMaxLen);
+    will_return(__wrap_cominitKeyringGetKey, COMINIT_PASSPHRASE_SIZE);
+    expect_any(__wrap_cominitCryptoHkdfSha256, ikm);
+    expect_any(__wrap_cominitCryptoHkdfSha256, ikmLen);
+    expect_any(__wrap_cominitCryptoHkdfSha256, info);
+    expect_any(__wrap_cominitCryptoHkdfSha256, infoLen);
+    will_return(__wrap_cominitCryptoHkdfSha256, EXIT_FAILURE);
+    will_return(__wrap_cominitSecureArenaFree, EXIT_SUCCESS);
+
+    assert_int_not_equal(cominitSecurememoryDeriveKey(COMINIT_TEST_ROOT_KEY, COMINIT_TEST_CONTEXT, COMINIT_TEST_KEY),
+                         EXIT_SUCCESS);
+}
@@ -0,0 +1,18 @@
+// SPDX-License-Identifier: MIT
+/**
+ * @file utest-securememory-derive-key-param-failure.c
+ * @brief Implementation of a parameter failure case unit test for cominitSecurememoryDeriveKey().
+ */
+
+#include <cmocka_extensions/cmocka_extensions.h>
+#include <stdlib.h>
+
+#include "utest-securememory-derive-key.h"
+
+void cominitSecurememoryDeriveKeyTestParamFailure(void **state) {
+    COMINIT_PARAM_UNUSED(state);
+
+    assert_int_not_equal(cominitSecurememoryDeriveKey(NULL, COMINIT_TEST_CONTEXT, COMINIT_TEST_KEY), EXIT_SUCCESS);
+    assert_int_not_equal(cominitSecurememoryDeriveKey(COMINIT_TEST_ROOT_KEY, NULL, COMINIT_TEST_KEY), EXIT_SUCCESS);
+    assert_int_not_equal(cominitSecurememoryDeriveKey(COMINIT_TEST_ROOT_KEY, COMINIT_TEST_CONTEXT, NULL), EXIT_SUCCESS);
+}
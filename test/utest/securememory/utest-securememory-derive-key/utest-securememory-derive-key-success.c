@@ -0,0 +1,39 @@
+// SPDX-License-Identifier: MIT
+/**
+ * @file utest-securememory-derive-key-success.c
+ * @brief Implementation of a success case unit test for cominitSecurememoryDeriveKey().
+ */
+
+#include <cmocka_extensions/cmocka_extensions.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "unit_test.h"
+#include "utest-securememory-derive-key.h"
+
+void cominitSecurememoryDeriveKeyTestSuccess(void **state) {
+    COMINIT_PARAM_UNUSED(state);
+
+    will_return(__wrap_cominitSecureArenaAlloc, 0);
+
+    expect_any(__wrap_cominitKeyringGetKey, key);
+    expect_string(__wrap_cominitKeyringGetKey, keyDesc, COMINIT_TEST_ROOT_KEY);
+    expect_value(__wrap_cominitKeyringGetKey, keyMaxLen, COMINIT_PASSPHRASE_SIZE);
+    will_return(__wrap_cominitKeyringGetKey, COMINIT_PASSPHRASE_SIZE);
+
+    expect_string(__wrap_cominitCryptoHkdfSha256, ikm, "secret key");
+    expect_value(__wrap_cominitCryptoHkdfSha256, ikmLen, COMINIT_PASSPHRASE_SIZE);
+    expect_string(__wrap_cominitCryptoHkdfSha256, info, COMINIT_TEST_CONTEXT);
+    expect_value(__wrap_cominitCryptoHkdfSha256, infoLen, strlen(COMINIT_TEST_CONTEXT));
+    will_return(__wrap_cominitCryptoHkdfSha256, EXIT_SUCCESS);
+
+    expect_string(__wrap_cominitKeyringAddUserKey, keyDesc, COMINIT_TEST_KEY);
+    expect_any(__wrap_cominitKeyringAddUserKey, key);
+    expect_value(__wrap_cominitKeyringAddUserKey, keyLen, COMINIT_PASSPHRASE_SIZE);
+    will_return(__wrap_cominitKeyringAddUserKey, 0);
+
+    will_return(__wrap_cominitSecureArenaFree, EXIT_SUCCESS);
+
+    assert_int_equal(cominitSecurememoryDeriveKey(COMINIT_TEST_ROOT_KEY, COMINIT_TEST_CONTEXT, COMINIT_TEST_KEY),
+                     EXIT_SUCCESS);
+}
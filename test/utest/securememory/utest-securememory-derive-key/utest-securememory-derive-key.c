@@ -0,0 +1,50 @@
+// SPDX-License-Identifier: MIT
+/**
+ * @file utest-securememory-derive-key.c
+ * @brief Implementation of an cominitSecurememoryDeriveKey() unit test group using cmocka.
+ */
+#include "utest-securememory-derive-key.h"
+
+#include <string.h>
+
+#include "unit_test.h"
+
+static const char cominitTestSecret[] = "secret key";
+
+static uint8_t cominitTestKeyBuffer[2 * COMINIT_PASSPHRASE_SIZE];
+
+// NOLINTNEXTLINE(readability-identifier-naming)    Rationale: Naming scheme fixed due to linker wrapping.
+void *__wrap_cominitSecureArenaAlloc(size_t size) {
+    assert_int_equal(size, sizeof(cominitTestKeyBuffer));
+
+    /* Simulates the root secret read from the keyring. */
+    memset(cominitTestKeyBuffer, 0, sizeof(cominitTestKeyBuffer));
+    memcpy(cominitTestKeyBuffer, cominitTestSecret, sizeof(cominitTestSecret));
+
+    return (mock_type(int) == 0) ? cominitTestKeyBuffer : NULL;
+}
+
+// NOLINTNEXTLINE(readability-identifier-naming)    Rationale: Naming scheme fixed due to linker wrapping.
+int __wrap_cominitSecureArenaFree(void *ptr, size_t size) {
+    assert_int_equal(size, sizeof(cominitTestKeyBuffer));
+    assert_ptr_equal(ptr, cominitTestKeyBuffer);
+
+    /* Additional test that the secret and the derived key have been cleared */
+    assert_memory_is_zeroed(ptr, size);
+
+    return mock_type(int);
+}
+
+/**
+ * Run the unit tests for cominitSecurememoryDeriveKey().
+ *
+ * @return  The same as cmocka_run_group_tests() returns for the tests.
+ */
+int main(void) {
+    const struct CMUnitTest tests[] = {
+        cmocka_unit_test(cominitSecurememoryDeriveKeyTestSuccess),
+        cmocka_unit_test(cominitSecurememoryDeriveKeyTestFailure),
+        cmocka_unit_test(cominitSecurememoryDeriveKeyTestParamFailure),
+    };
+    return cmocka_run_group_tests(tests, NULL, NULL);
+}
@@ -0,0 +1,33 @@
+// SPDX-License-Identifier: MIT
+/**
+ * @file utest-securememory-derive-key.h
+ * @brief Header declaring cmocka unit test functions for cominitSecurememoryDeriveKey().
+ */
+#ifndef __UTEST_SECUREMEMORY_DERIVE_KEY_H__
+#define __UTEST_SECUREMEMORY_DERIVE_KEY_H__
+
+#include "securememory.h"
+
+#define COMINIT_TEST_ROOT_KEY "secureStorage"                        ///< Description of the root secret.
+#define COMINIT_TEST_CONTEXT "0fc63daf-8483-4772-8e79-3d69d8477de4"  ///< The context used for derivation.
+#define COMINIT_TEST_KEY "secureStorage-logs"                        ///< Description of the derived key.
+
+/**
+ * Unit test for cominitSecurememoryDeriveKey() successful code path.
+ * @param state
+ */
+void cominitSecurememoryDeriveKeyTestSuccess(void **state);
+
+/**
+ * Unit test for cominitSecurememoryDeriveKey() if the root secret is missing or the derivation fails.
+ * @param state
+ */
+void cominitSecurememoryDeriveKeyTestFailure(void **state);
+
+/**
+ * Unit test for cominitSecurememoryDeriveKey() if parameters are not initialized.
+ * @param state
+ */
+void cominitSecurememoryDeriveKeyTestParamFailure(void **state);
+
+#endif /* __UTEST_SECUREMEMORY_DERIVE_KEY_H__ */
@@ -5,6 +5,7 @@
  */
 
 #include <cmocka_extensions/cmocka_extensions.h>
+#include <stdlib.h>
 #include <string.h>
 #include <tss2/tss2_esys.h>
 
@@ -13,24 +14,25 @@
 
 static char cominitTestString[] = "secret key";
 
+static TPM2B_SENSITIVE_CREATE cominitTestKeyBuffer;
+
 // NOLINTNEXTLINE(readability-identifier-naming)    Rationale: Naming scheme fixed due to linker wrapping.
-int __wrap_mlock(const void *addr, size_t len) {
-    COMINIT_PARAM_UNUSED(len);
-    assert_non_null(addr);
+void *__wrap_cominitSecureArenaAlloc(size_t size) {
+    assert_int_equal(size, sizeof(cominitTestKeyBuffer));
 
-    TPM2B_SENSITIVE_CREATE *outData = (TPM2B_SENSITIVE_CREATE *)addr;
-    strcpy((char *)outData->sensitive.data.buffer, cominitTestString);
+    memset(&cominitTestKeyBuffer, 0, sizeof(cominitTestKeyBuffer));
+    strcpy((char *)cominitTestKeyBuffer.sensitive.data.buffer, cominitTestString);
 
-    return mock_type(int);
+    return (mock_type(int) == 0) ? &cominitTestKeyBuffer : NULL;
 }
 
 // NOLINTNEXTLINE(readability-identifier-naming)    Rationale: Naming scheme fixed due to linker wrapping.
-int __wrap_munlock(const void *addr, size_t len) {
-    assert_true(len > 0);
-    assert_non_null(addr);
+int __wrap_cominitSecureArenaFree(void *ptr, size_t size) {
+    assert_int_equal(size, sizeof(cominitTestKeyBuffer));
+    assert_ptr_equal(ptr, &cominitTestKeyBuffer);
 
     /* Additional test that buffer has been cleared*/
-    TPM2B_SENSITIVE_CREATE *outData = (TPM2B_SENSITIVE_CREATE *)addr;
+    TPM2B_SENSITIVE_CREATE *outData = (TPM2B_SENSITIVE_CREATE *)ptr;
     assert_string_not_equal((char *)outData->sensitive.data.buffer, cominitTestString);
     assert_memory_is_zeroed(outData->sensitive.data.buffer, ARRAY_SIZE(cominitTestString));
 
@@ -46,7 +48,7 @@ void cominitSecurememoryEsysCreateTestSuccess(void **state) {
     TPM2B_PRIVATE *outPrivate = NULL;
     TPM2B_DIGEST policyDigest = {0};
 
-    will_return(__wrap_mlock, 0);
+    will_return(__wrap_cominitSecureArenaAlloc, 0);
 
     expect_string(__wrap_cominitCryptoCreatePassphrase, passphrase, cominitTestString);
     expect_any(__wrap_cominitCryptoCreatePassphrase, passphraseSize);
@@ -68,7 +70,7 @@ void cominitSecurememoryEsysCreateTestSuccess(void **state) {
     expect_any(__wrap_Esys_Create, creationTicket);
     will_return(__wrap_Esys_Create, TSS2_RC_SUCCESS);
 
-    will_return(__wrap_munlock, 0);
+    will_return(__wrap_cominitSecureArenaFree, EXIT_SUCCESS);
 
     expect_any(__wrap_Esys_Free, __ptr);
     expect_any(__wrap_Esys_Free, __ptr);
@@ -0,0 +1,40 @@
+// SPDX-License-Identifier: MIT
+/**
+ * @file utest-stats-percentile-success.c
+ * @brief Implementation of success case unit tests for cominitStatsPercentile().
+ */
+#include <cmocka_extensions/cmocka_extensions.h>
+#include <stdint.h>
+
+#include "common.h"
+#include "utest-stats-percentile.h"
+
+void cominitStatsPercentileTestSuccess(void **state) {
+    COMINIT_PARAM_UNUSED(state);
+    uint64_t samples[100];
+
+    /* Durations 1 to 100 in descending order, so sorting is needed. */
+    for (size_t i = 0; i < ARRAY_SIZE(samples); i++) {
+        samples[i] = ARRAY_SIZE(samples) - i;
+    }
+    cominitStatsSort(samples, ARRAY_SIZE(samples));
+    for (size_t i = 0; i < ARRAY_SIZE(samples); i++) {
+        assert_int_equal(samples[i], i + 1);
+    }
+
+    assert_int_equal(cominitStatsPercentile(samples, ARRAY_SIZE(samples), 0), 1);
+    assert_int_equal(cominitStatsPercentile(samples, ARRAY_SIZE(samples), 50), 51);
+    assert_int_equal(cominitStatsPercentile(samples, ARRAY_SIZE(samples), 95), 96);
+    assert_int_equal(cominitStatsPercentile(samples, ARRAY_SIZE(samples), 99), 100);
+    assert_int_equal(cominitStatsPercentile(samples, ARRAY_SIZE(samples), 100), 100);
+}
+
+void cominitStatsPercentileTestSuccessSingle(void **state) {
+    COMINIT_PARAM_UNUSED(state);
+    uint64_t samples[] = {42};
+
+    cominitStatsSort(samples, ARRAY_SIZE(samples));
+    assert_int_equal(cominitStatsPercentile(samples, ARRAY_SIZE(samples), 0), 42);
+    assert_int_equal(cominitStatsPercentile(samples, ARRAY_SIZE(samples), 50), 42);
+    assert_int_equal(cominitStatsPercentile(samples, ARRAY_SIZE(samples), 100), 42);
+}
@@ -0,0 +1,21 @@
+// SPDX-License-Identifier: MIT
+/**
+ * @file utest-stats-percentile.c
+ * @brief Implementation of a cominitStatsPercentile() unit test group using cmocka.
+ */
+#include "utest-stats-percentile.h"
+
+#include "unit_test.h"
+
+/**
+ * Run the unit tests for cominitStatsPercentile().
+ *
+ * @return  The same as cmocka_run_group_tests() returns for the tests.
+ */
+int main(void) {
+    const struct CMUnitTest tests[] = {
+        cmocka_unit_test(cominitStatsPercentileTestSuccess),
+        cmocka_unit_test(cominitStatsPercentileTestSuccessSingle),
+    };
+    return cmocka_run_group_tests(tests, NULL, NULL);
+}
@@ -0,0 +1,23 @@
+// SPDX-License-Identifier: MIT
+/**
+ * @file utest-stats-percentile.h
+ * @brief Header declaring cmocka unit test functions for cominitStatsPercentile().
+ */
+#ifndef __UTEST_STATS_PERCENTILE_H__
+#define __UTEST_STATS_PERCENTILE_H__
+
+#include "stats.h"
+
+/**
+ * Unit test for cominitStatsPercentile() successful code path.
+ * @param state
+ */
+void cominitStatsPercentileTestSuccess(void **state);
+
+/**
+ * Unit test for cominitStatsPercentile() successful code path with a single duration.
+ * @param state
+ */
+void cominitStatsPercentileTestSuccessSingle(void **state);
+
+#endif /* __UTEST_STATS_PERCENTILE_H__ */
@@ -0,0 +1,23 @@
+// SPDX-License-Identifier: MIT
+/**
+ * @file utest-subprocess-start-with-timeout-failure.c
+ * @brief Implementation of a failure case unit test for cominitSubprocessStartWithTimeout().
+ */
+
+#include <cmocka_extensions/cmocka_extensions.h>
+#include <time.h>
+
+#include "utest-subprocess-start-with-timeout.h"
+
+void cominitSubprocessStartWithTimeoutTestFailure(void **state) {
+    COMINIT_PARAM_UNUSED(state);
+
+    char *const argv[] = {"/bin/sleep", "10", NULL};
+    char *const env[] = {NULL};
+    time_t start = time(NULL);
+
+    pid_t pid = cominitSubprocessStartWithTimeout(argv[0], argv, env, 100);
+    assert_true(pid > 0);
+    assert_int_not_equal(cominitSubprocessWait(pid), 0);
+    assert_true(time(NULL) - start < 5);
+}
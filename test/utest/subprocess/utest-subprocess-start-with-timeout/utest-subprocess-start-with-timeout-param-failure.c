@@ -0,0 +1,21 @@
+// SPDX-License-Identifier: MIT
+/**
+ * @file utest-subprocess-start-with-timeout-param-failure.c
+ * @brief Implementation of a parameter failure case unit test for cominitSubprocessStartWithTimeout().
+ */
+
+#include <cmocka_extensions/cmocka_extensions.h>
+
+#include "utest-subprocess-start-with-timeout.h"
+
+void cominitSubprocessStartWithTimeoutTestParamFailure(void **state) {
+    COMINIT_PARAM_UNUSED(state);
+
+    char *const argv[] = {"/bin/true", NULL};
+    char *const env[] = {NULL};
+
+    assert_int_equal(cominitSubprocessStartWithTimeout(NULL, argv, env, 1000), -1);
+    assert_int_equal(cominitSubprocessStartWithTimeout(argv[0], NULL, env, 1000), -1);
+    assert_int_equal(cominitSubprocessStartWithTimeout(argv[0], argv, NULL, 1000), -1);
+    assert_int_equal(cominitSubprocessStartWithTimeout(argv[0], argv, env, 0), -1);
+}
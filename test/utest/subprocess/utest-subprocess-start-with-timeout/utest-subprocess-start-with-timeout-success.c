@@ -0,0 +1,30 @@
+// SPDX-License-Identifier: MIT
+/**
+ * @file utest-subprocess-start-with-timeout-success.c
+ * @brief Implementation of a success case unit test for cominitSubprocessStartWithTimeout().
+ */
+
+#include <cmocka_extensions/cmocka_extensions.h>
+
+#include "utest-subprocess-start-with-timeout.h"
+
+void cominitSubprocessStartWithTimeoutTestSuccess(void **state) {
+    COMINIT_PARAM_UNUSED(state);
+
+    char *const argvEcho[] = {"/bin/echo", "captured output", NULL};
+    char *const argvTrue[] = {"/bin/true", NULL};
+    char *const env[] = {NULL};
+
+    pid_t echo = cominitSubprocessStartWithTimeout(argvEcho[0], argvEcho, env, 10000);
+    pid_t quick = cominitSubprocessStartWithTimeout(argvTrue[0], argvTrue, env, 10000);
+    assert_true(echo > 0);
+    assert_true(quick > 0);
+
+    assert_int_equal(cominitSubprocessWait(quick), 0);
+    assert_int_equal(cominitSubprocessWait(echo), 0);
+    assert_int_not_equal(cominitSubprocessWait(echo), 0);
+
+    pid_t unbounded = cominitSubprocessStartWithTimeout(argvTrue[0], argvTrue, env, COMINIT_SUBPROCESS_NO_TIMEOUT);
+    assert_true(unbounded > 0);
+    assert_int_equal(cominitSubprocessWait(unbounded), 0);
+}
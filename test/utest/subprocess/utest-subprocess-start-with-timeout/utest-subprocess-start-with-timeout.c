@@ -0,0 +1,22 @@
+// SPDX-License-Identifier: MIT
+/**
+ * @file utest-subprocess-start-with-timeout.c
+ * @brief Implementation of an cominitSubprocessStartWithTimeout() unit test group using cmocka.
+ */
+#include "utest-subprocess-start-with-timeout.h"
+
+#include "unit_test.h"
+
+/**
+ * Run the unit tests for cominitSubprocessStartWithTimeout().
+ *
+ * @return  The same as cmocka_run_group_tests() returns for the tests.
+ */
+int main(void) {
+    const struct CMUnitTest tests[] = {
+        cmocka_unit_test(cominitSubprocessStartWithTimeoutTestSuccess),
+        cmocka_unit_test(cominitSubprocessStartWithTimeoutTestFailure),
+        cmocka_unit_test(cominitSubprocessStartWithTimeoutTestParamFailure),
+    };
+    return cmocka_run_group_tests(tests, NULL, NULL);
+}
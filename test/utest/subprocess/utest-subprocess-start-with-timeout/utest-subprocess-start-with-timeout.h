@@ -0,0 +1,30 @@
+// SPDX-License-Identifier: MIT
+/**
+ * @file utest-subprocess-start-with-timeout.h
+ * @brief Header declaring cmocka unit test functions for cominitSubprocessStartWithTimeout().
+ */
+#ifndef __UTEST_SUBPROCESS_START_WITH_TIMEOUT_H__
+#define __UTEST_SUBPROCESS_START_WITH_TIMEOUT_H__
+
+#include "common.h"
+#include "subprocess.h"
+
+/**
+ * Unit test for cominitSubprocessStartWithTimeout() if the subprocess finishes in time.
+ * @param state
+ */
+void cominitSubprocessStartWithTimeoutTestSuccess(void **state);
+
+/**
+ * Unit test for cominitSubprocessStartWithTimeout() if the subprocess misses its deadline.
+ * @param state
+ */
+void cominitSubprocessStartWithTimeoutTestFailure(void **state);
+
+/**
+ * Unit test for cominitSubprocessStartWithTimeout() if parameters are not initialized.
+ * @param state
+ */
+void cominitSubprocessStartWithTimeoutTestParamFailure(void **state);
+
+#endif /* __UTEST_SUBPROCESS_START_WITH_TIMEOUT_H__ */
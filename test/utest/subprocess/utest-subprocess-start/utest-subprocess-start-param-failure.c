@@ -0,0 +1,23 @@
+// SPDX-License-Identifier: MIT
+/**
+ * @file utest-subprocess-start-param-failure.c
+ * @brief Implementation of a failure case unit test for cominitSubprocessStart() and cominitSubprocessWait().
+ */
+
+#include <cmocka_extensions/cmocka_extensions.h>
+
+#include "utest-subprocess-start.h"
+
+void cominitSubprocessStartTestParamFailure(void **state) {
+    COMINIT_PARAM_UNUSED(state);
+
+    char *const argv[] = {"/bin/true", NULL};
+    char *const env[] = {NULL};
+
+    assert_int_equal(cominitSubprocessStart(NULL, argv, env), -1);
+    assert_int_equal(cominitSubprocessStart(argv[0], NULL, env), -1);
+    assert_int_equal(cominitSubprocessStart(argv[0], argv, NULL), -1);
+
+    assert_int_not_equal(cominitSubprocessWait(-1), 0);
+    assert_int_not_equal(cominitSubprocessWait(0), 0);
+}
@@ -0,0 +1,26 @@
+// SPDX-License-Identifier: MIT
+/**
+ * @file utest-subprocess-start-success.c
+ * @brief Implementation of a success case unit test for cominitSubprocessStart() and cominitSubprocessWait().
+ */
+
+#include <cmocka_extensions/cmocka_extensions.h>
+
+#include "utest-subprocess-start.h"
+
+void cominitSubprocessStartTestSuccess(void **state) {
+    COMINIT_PARAM_UNUSED(state);
+
+    char *const argvTrue[] = {"/bin/true", NULL};
+    char *const argvFalse[] = {"/bin/false", NULL};
+    char *const env[] = {NULL};
+
+    pid_t first = cominitSubprocessStart(argvTrue[0], argvTrue, env);
+    pid_t second = cominitSubprocessStart(argvFalse[0], argvFalse, env);
+    assert_true(first > 0);
+    assert_true(second > 0);
+    assert_int_not_equal(first, second);
+
+    assert_int_not_equal(cominitSubprocessWait(second), 0);
+    assert_int_equal(cominitSubprocessWait(first), 0);
+}
@@ -0,0 +1,21 @@
+// SPDX-License-Identifier: MIT
+/**
+ * @file utest-subprocess-start.c
+ * @brief Implementation of an cominitSubprocessStart() and cominitSubprocessWait() unit test group using cmocka.
+ */
+#include "utest-subprocess-start.h"
+
+#include "unit_test.h"
+
+/**
+ * Run the unit tests for cominitSubprocessStart() and cominitSubprocessWait().
+ *
+ * @return  The same as cmocka_run_group_tests() returns for the tests.
+ */
+int main(void) {
+    const struct CMUnitTest tests[] = {
+        cmocka_unit_test(cominitSubprocessStartTestSuccess),
+        cmocka_unit_test(cominitSubprocessStartTestParamFailure),
+    };
+    return cmocka_run_group_tests(tests, NULL, NULL);
+}
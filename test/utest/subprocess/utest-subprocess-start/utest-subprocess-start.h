@@ -0,0 +1,24 @@
+// SPDX-License-Identifier: MIT
+/**
+ * @file utest-subprocess-start.h
+ * @brief Header declaring cmocka unit test functions for cominitSubprocessStart() and cominitSubprocessWait().
+ */
+#ifndef __UTEST_SUBPROCESS_START_H__
+#define __UTEST_SUBPROCESS_START_H__
+
+#include "common.h"
+#include "subprocess.h"
+
+/**
+ * Unit test for concurrently started subprocesses.
+ * @param state
+ */
+void cominitSubprocessStartTestSuccess(void **state);
+
+/**
+ * Unit test for cominitSubprocessStart() and cominitSubprocessWait() if parameters are not initialized.
+ * @param state
+ */
+void cominitSubprocessStartTestParamFailure(void **state);
+
+#endif /* __UTEST_SUBPROCESS_START_H__ */
@@ -15,22 +15,50 @@
 void cominitInitTpmTestNullCtxFailure(void **state) {
     COMINIT_PARAM_UNUSED(state);
 
-    assert_int_not_equal(cominitInitTpm(NULL), 0);
+    cominitCliArgs_t argCtx = {0};
+    cominitTpmContext_t ctx;
+
+    assert_int_not_equal(cominitInitTpm(NULL, &argCtx), 0);
+    assert_int_not_equal(cominitInitTpm(&ctx, NULL), 0);
 }
 
 void cominitInitTpmTestTss2InitFailFailure(void **state) {
     COMINIT_PARAM_UNUSED(state);
     cominitTpmContext_t ctx;
+    cominitCliArgs_t argCtx = {0};
 
     will_return(__wrap_Tss2_TctiLdr_Initialize, TSS2_TCTI_RC_GENERAL_FAILURE);
-    assert_int_not_equal(cominitInitTpm(&ctx), 0);
+    assert_int_not_equal(cominitInitTpm(&ctx, &argCtx), 0);
+    assert_null(ctx.tctiCtx);
 }
 
 void cominitInitTpmTestEsysInitFailFailure(void **state) {
     COMINIT_PARAM_UNUSED(state);
     cominitTpmContext_t ctx;
+    cominitCliArgs_t argCtx = {0};
 
     will_return(__wrap_Tss2_TctiLdr_Initialize, TSS2_RC_SUCCESS);
     will_return(__wrap_Esys_Initialize, TSS2_ESYS_RC_GENERAL_FAILURE);
-    assert_int_not_equal(cominitInitTpm(&ctx), 0);
+    assert_int_not_equal(cominitInitTpm(&ctx, &argCtx), 0);
+
+    /* The TCTI context is finalized, nothing is left for cominitDeleteTpm(). */
+    assert_null(ctx.tctiCtx);
+    assert_null(ctx.esysCtx);
+}
+
+void cominitInitTpmTestSelftestFailure(void **state) {
+    COMINIT_PARAM_UNUSED(state);
+    cominitTpmContext_t ctx;
+    cominitCliArgs_t argCtx = {0};
+
+    will_return(__wrap_Tss2_TctiLdr_Initialize, TSS2_RC_SUCCESS);
+    will_return(__wrap_Esys_Initialize, TSS2_RC_SUCCESS);
+    will_return(__wrap_Esys_IncrementalSelfTest, NULL);
+    will_return(__wrap_Esys_IncrementalSelfTest, TSS2_RC_SUCCESS);
+    expect_any(__wrap_Esys_Free, __ptr);
+    will_return(__wrap_Esys_GetTestResult, NULL);
+    will_return(__wrap_Esys_GetTestResult, TPM2_RC_FAILURE);
+    will_return(__wrap_Esys_GetTestResult, TSS2_RC_SUCCESS);
+    expect_any(__wrap_Esys_Free, __ptr);
+    assert_int_not_equal(cominitInitTpm(&ctx, &argCtx), 0);
 }
@@ -15,8 +15,30 @@
 void cominitInitTpmTestSuccess(void **state) {
     COMINIT_PARAM_UNUSED(state);
     cominitTpmContext_t ctx;
+    cominitCliArgs_t argCtx = {.tpmFullSelftest = false};
 
     will_return(__wrap_Tss2_TctiLdr_Initialize, TSS2_RC_SUCCESS);
     will_return(__wrap_Esys_Initialize, TSS2_RC_SUCCESS);
-    assert_int_equal(cominitInitTpm(&ctx), 0);
+    will_return(__wrap_Esys_IncrementalSelfTest, NULL);
+    will_return(__wrap_Esys_IncrementalSelfTest, TSS2_RC_SUCCESS);
+    expect_any(__wrap_Esys_Free, __ptr);
+    will_return(__wrap_Esys_GetTestResult, NULL);
+    will_return(__wrap_Esys_GetTestResult, TPM2_RC_TESTING);
+    will_return(__wrap_Esys_GetTestResult, TSS2_RC_SUCCESS);
+    expect_any(__wrap_Esys_Free, __ptr);
+    assert_int_equal(cominitInitTpm(&ctx, &argCtx), 0);
+}
+
+void cominitInitTpmTestFullSelftestSuccess(void **state) {
+    COMINIT_PARAM_UNUSED(state);
+    cominitTpmContext_t ctx;
+    cominitCliArgs_t argCtx = {.tpmFullSelftest = true};
+
+    will_return(__wrap_Tss2_TctiLdr_Initialize, TSS2_RC_SUCCESS);
+    will_return(__wrap_Esys_Initialize, TSS2_RC_SUCCESS);
+    will_return(__wrap_Esys_GetTestResult, NULL);
+    will_return(__wrap_Esys_GetTestResult, TPM2_RC_SUCCESS);
+    will_return(__wrap_Esys_GetTestResult, TSS2_RC_SUCCESS);
+    expect_any(__wrap_Esys_Free, __ptr);
+    assert_int_equal(cominitInitTpm(&ctx, &argCtx), 0);
 }
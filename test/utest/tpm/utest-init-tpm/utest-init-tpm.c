@@ -15,9 +15,11 @@
 int main(void) {
     const struct CMUnitTest tests[] = {
         cmocka_unit_test(cominitInitTpmTestSuccess),
+        cmocka_unit_test(cominitInitTpmTestFullSelftestSuccess),
         cmocka_unit_test(cominitInitTpmTestNullCtxFailure),
         cmocka_unit_test(cominitInitTpmTestTss2InitFailFailure),
         cmocka_unit_test(cominitInitTpmTestEsysInitFailFailure),
+        cmocka_unit_test(cominitInitTpmTestSelftestFailure),
     };
     return cmocka_run_group_tests(tests, NULL, NULL);
 }
@@ -14,6 +14,12 @@
  */
 void cominitInitTpmTestSuccess(void **state);
 
+/**
+ * Unit test for cominitInitTpm() successful code path with a full self-test.
+ * @param state
+ */
+void cominitInitTpmTestFullSelftestSuccess(void **state);
+
 /**
  * Unit test that simulates a null value parameter for tpmCtx
  * @param state
@@ -32,4 +38,10 @@ void cominitInitTpmTestTss2InitFailFailure(void **state);
  */
 void cominitInitTpmTestEsysInitFailFailure(void **state);
 
+/**
+ * Unit test that simulates a TPM reporting a failed self-test
+ * @param state
+ */
+void cominitInitTpmTestSelftestFailure(void **state);
+
 #endif /* __UTEST_TPM_EXTEND_PCR_H__ */
@@ -0,0 +1,81 @@
+// SPDX-License-Identifier: MIT
+/**
+ * @file utest-tpm-boot-latency-success.c
+ * @brief Implementation of unit tests for the time the TPM initialization adds to the boot with a slow self-test.
+ */
+#include <stdlib.h>
+#include <tss2/tss2_esys.h>
+
+#include "mock_Esys_IncrementalSelfTest.h"
+#include "mock_Esys_SelfTest.h"
+#include "unit_test.h"
+#include "utest-tpm-boot-latency.h"
+
+/**
+ * Sets up the mocks for a successful TPM2_GetTestResult after the self-test.
+ */
+static void cominitTpmBootLatencyExpectTestResult(void) {
+    will_return(__wrap_Esys_GetTestResult, NULL);
+    will_return(__wrap_Esys_GetTestResult, TPM2_RC_SUCCESS);
+    will_return(__wrap_Esys_GetTestResult, TSS2_RC_SUCCESS);
+    expect_any(__wrap_Esys_Free, __ptr);
+}
+
+/**
+ * Sets up the mocks for a successful TPM initialization with an incremental self-test.
+ */
+static void cominitTpmBootLatencyExpectIncrementalSelftest(void) {
+    will_return(__wrap_Tss2_TctiLdr_Initialize, TSS2_RC_SUCCESS);
+    will_return(__wrap_Esys_Initialize, TSS2_RC_SUCCESS);
+    will_return(__wrap_Esys_IncrementalSelfTest, NULL);
+    will_return(__wrap_Esys_IncrementalSelfTest, TSS2_RC_SUCCESS);
+    expect_any(__wrap_Esys_Free, __ptr);
+    cominitTpmBootLatencyExpectTestResult();
+}
+
+void cominitTpmBootLatencyTestIncrementalSelftest(void **state) {
+    COMINIT_PARAM_UNUSED(state);
+    cominitCliArgs_t argCtx = {.tpmFullSelftest = false};
+
+    cominitMockEsysIncrementalSelfTestLatency = COMINIT_MOCK_LATENCY_MSEC(200, 200);
+    cominitMockEsysSelfTestLatency = COMINIT_MOCK_LATENCY_MSEC(600, 600);
+    cominitTpmBootLatencyExpectIncrementalSelftest();
+
+    /* Only the incremental self-test is run, the full one is not tried in addition. */
+    uint64_t initNs = cominitTpmBootLatencyRun(&argCtx);
+    assert_int_equal(initNs, COMINIT_MOCK_MSEC(200));
+}
+
+void cominitTpmBootLatencyTestFullSelftestFallback(void **state) {
+    COMINIT_PARAM_UNUSED(state);
+    cominitCliArgs_t argCtx = {.tpmFullSelftest = false};
+
+    cominitMockEsysIncrementalSelfTestLatency = COMINIT_MOCK_LATENCY_MSEC(5, 5);
+    cominitMockEsysSelfTestLatency = COMINIT_MOCK_LATENCY_MSEC(500, 600);
+    will_return(__wrap_Tss2_TctiLdr_Initialize, TSS2_RC_SUCCESS);
+    will_return(__wrap_Esys_Initialize, TSS2_RC_SUCCESS);
+    will_return(__wrap_Esys_IncrementalSelfTest, NULL);
+    will_return(__wrap_Esys_IncrementalSelfTest, TPM2_RC_FAILURE);
+    expect_any(__wrap_Esys_Free, __ptr);
+    cominitTpmBootLatencyExpectTestResult();
+
+    /* The rejected incremental self-test costs no more than its own latency before the full one. */
+    uint64_t initNs = cominitTpmBootLatencyRun(&argCtx);
+    assert_in_range(initNs, COMINIT_MOCK_MSEC(5) + COMINIT_MOCK_MSEC(500),
+                    COMINIT_MOCK_MSEC(5) + COMINIT_MOCK_MSEC(600));
+}
+
+void cominitTpmBootLatencyTestFullSelftest(void **state) {
+    COMINIT_PARAM_UNUSED(state);
+    cominitCliArgs_t argCtx = {.tpmFullSelftest = true};
+
+    cominitMockEsysIncrementalSelfTestLatency = COMINIT_MOCK_LATENCY_MSEC(200, 200);
+    cominitMockEsysSelfTestLatency = COMINIT_MOCK_LATENCY_MSEC(600, 600);
+    will_return(__wrap_Tss2_TctiLdr_Initialize, TSS2_RC_SUCCESS);
+    will_return(__wrap_Esys_Initialize, TSS2_RC_SUCCESS);
+    cominitTpmBootLatencyExpectTestResult();
+
+    /* The incremental self-test is skipped. */
+    uint64_t initNs = cominitTpmBootLatencyRun(&argCtx);
+    assert_int_equal(initNs, COMINIT_MOCK_MSEC(600));
+}
@@ -0,0 +1,55 @@
+// SPDX-License-Identifier: MIT
+/**
+ * @file utest-tpm-boot-latency.c
+ * @brief Implementation of a TPM boot latency unit test group with latency injection using cmocka.
+ */
+#include "utest-tpm-boot-latency.h"
+
+#include <stdlib.h>
+
+#include "mock_Esys_IncrementalSelfTest.h"
+#include "mock_Esys_SelfTest.h"
+#include "mock_clock_gettime.h"
+#include "tpm.h"
+#include "unit_test.h"
+
+uint64_t cominitTpmBootLatencyRun(cominitCliArgs_t *argCtx) {
+    cominitTpmContext_t tpmCtx = {0};
+    uint64_t start = cominitMockClockNow();
+
+    assert_int_equal(cominitInitTpm(&tpmCtx, argCtx), EXIT_SUCCESS);
+
+    return cominitMockClockNow() - start;
+}
+
+int cominitTpmBootLatencyTestSetup(void **state) {
+    COMINIT_PARAM_UNUSED(state);
+    cominitMockClockReset();
+    cominitMockClockEnabled = true;
+    return 0;
+}
+
+int cominitTpmBootLatencyTestTeardown(void **state) {
+    COMINIT_PARAM_UNUSED(state);
+    cominitMockEsysIncrementalSelfTestLatency = COMINIT_MOCK_LATENCY_MSEC(0, 0);
+    cominitMockEsysSelfTestLatency = COMINIT_MOCK_LATENCY_MSEC(0, 0);
+    cominitMockClockEnabled = false;
+    return 0;
+}
+
+/**
+ * Run the boot time unit tests.
+ *
+ * @return  The same as cmocka_run_group_tests() returns for the tests.
+ */
+int main(void) {
+    const struct CMUnitTest tests[] = {
+        cmocka_unit_test_setup_teardown(cominitTpmBootLatencyTestIncrementalSelftest, cominitTpmBootLatencyTestSetup,
+                                        cominitTpmBootLatencyTestTeardown),
+        cmocka_unit_test_setup_teardown(cominitTpmBootLatencyTestFullSelftestFallback, cominitTpmBootLatencyTestSetup,
+                                        cominitTpmBootLatencyTestTeardown),
+        cmocka_unit_test_setup_teardown(cominitTpmBootLatencyTestFullSelftest, cominitTpmBootLatencyTestSetup,
+                                        cominitTpmBootLatencyTestTeardown),
+    };
+    return cmocka_run_group_tests(tests, NULL, NULL);
+}
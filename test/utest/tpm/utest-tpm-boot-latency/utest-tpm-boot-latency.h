@@ -0,0 +1,58 @@
+// SPDX-License-Identifier: MIT
+/**
+ * @file utest-tpm-boot-latency.h
+ * @brief Header declaring cmocka unit tests for the time the TPM initialization adds to the boot with a slow self-test.
+ */
+#ifndef __UTEST_TPM_BOOT_LATENCY_H__
+#define __UTEST_TPM_BOOT_LATENCY_H__
+
+#include <stdint.h>
+
+#include "common.h"
+#include "mock_latency.h"
+
+/**
+ * Runs the TPM initialization as cominit's main() does once the rootfs was found.
+ *
+ * Fails the test if the initialization fails.
+ *
+ * @param argCtx  The parsed options.
+ *
+ * @return  The time the initialization took on the virtual monotonic clock
+ */
+uint64_t cominitTpmBootLatencyRun(cominitCliArgs_t *argCtx);
+
+/**
+ * Enables the virtual monotonic clock and resets it to 0.
+ * @param state
+ * @return  0
+ */
+int cominitTpmBootLatencyTestSetup(void **state);
+
+/**
+ * Removes all latencies and forwards clock calls to the genuine functions again.
+ * @param state
+ * @return  0
+ */
+int cominitTpmBootLatencyTestTeardown(void **state);
+
+/**
+ * Unit test for a 200ms incremental TPM self-test, which must add no more than the self-test itself.
+ * @param state
+ */
+void cominitTpmBootLatencyTestIncrementalSelftest(void **state);
+
+/**
+ * Unit test for a TPM rejecting the incremental self-test and taking 600ms for the full one, which must run the full
+ * self-test only once.
+ * @param state
+ */
+void cominitTpmBootLatencyTestFullSelftestFallback(void **state);
+
+/**
+ * Unit test for a full self-test requested with `tpmSelftest=full`, which must skip the incremental one.
+ * @param state
+ */
+void cominitTpmBootLatencyTestFullSelftest(void **state);
+
+#endif /* __UTEST_TPM_BOOT_LATENCY_H__ */
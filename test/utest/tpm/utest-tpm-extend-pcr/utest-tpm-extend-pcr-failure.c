@@ -7,6 +7,7 @@
 #include <tss2/tss2_esys.h>
 
 #include "common.h"
+#include "crypto.h"
 #include "securememory.h"
 #include "tpm.h"
 #include "unit_test.h"
@@ -31,18 +32,21 @@ void cominitTpmExtendPCRTestNegativeIntegerParamFailure(void **state) {
     cominitTpmContext_t ctx;
     ESYS_CONTEXT *esysCtx = calloc(1, sizeof(char));
     ctx.esysCtx = esysCtx;
+    ctx.pcrBanks = COMINIT_CRYPTO_DIGEST_SHA256;
     char *keyfile = {"keyfile"};
 
     const int idxOffset = -1;
     const ESYS_TR idx = ESYS_TR_PCR0 + idxOffset;
 
-    will_return(__wrap_cominitCreateSHA256DigestfromKeyfile, 0);
+    expect_value(__wrap_cominitCryptoDigestsFromKeyfile, algs, COMINIT_CRYPTO_DIGEST_SHA256);
+    will_return(__wrap_cominitCryptoDigestsFromKeyfile, EXIT_SUCCESS);
 
     expect_string(__wrap_Esys_PCR_Extend, esysContext, esysCtx);
     expect_value(__wrap_Esys_PCR_Extend, pcrHandle, idx);
     expect_value(__wrap_Esys_PCR_Extend, shandle1, ESYS_TR_PASSWORD);
     expect_value(__wrap_Esys_PCR_Extend, shandle2, ESYS_TR_NONE);
     expect_value(__wrap_Esys_PCR_Extend, shandle3, ESYS_TR_NONE);
+    expect_value(__wrap_Esys_PCR_Extend, digestCount, 1);
     will_return(__wrap_Esys_PCR_Extend, TSS2_ESYS_RC_GENERAL_FAILURE);
     assert_int_not_equal(cominitTpmExtendPCR(&ctx, keyfile, idxOffset), 0);
 
@@ -54,18 +58,21 @@ void cominitTpmExtendPCRTestTooLargeParamFailure(void **state) {
     cominitTpmContext_t ctx;
     ESYS_CONTEXT *esysCtx = calloc(1, sizeof(char));
     ctx.esysCtx = esysCtx;
+    ctx.pcrBanks = COMINIT_CRYPTO_DIGEST_SHA256;
     char *keyfile = {"keyfile"};
 
     const int idxOffset = TPM2_PT_PCR_COUNT + 1;
     const ESYS_TR idx = ESYS_TR_PCR0 + idxOffset;
 
-    will_return(__wrap_cominitCreateSHA256DigestfromKeyfile, 0);
+    expect_value(__wrap_cominitCryptoDigestsFromKeyfile, algs, COMINIT_CRYPTO_DIGEST_SHA256);
+    will_return(__wrap_cominitCryptoDigestsFromKeyfile, EXIT_SUCCESS);
 
     expect_string(__wrap_Esys_PCR_Extend, esysContext, esysCtx);
     expect_value(__wrap_Esys_PCR_Extend, pcrHandle, idx);
     expect_value(__wrap_Esys_PCR_Extend, shandle1, ESYS_TR_PASSWORD);
     expect_value(__wrap_Esys_PCR_Extend, shandle2, ESYS_TR_NONE);
     expect_value(__wrap_Esys_PCR_Extend, shandle3, ESYS_TR_NONE);
+    expect_value(__wrap_Esys_PCR_Extend, digestCount, 1);
     will_return(__wrap_Esys_PCR_Extend, TSS2_ESYS_RC_GENERAL_FAILURE);
     assert_int_not_equal(cominitTpmExtendPCR(&ctx, keyfile, idxOffset), 0);
 
@@ -77,18 +84,21 @@ void cominitTpmExtendPCRTestTooLargeParamOnEdgeFailure(void **state) {
     cominitTpmContext_t ctx;
     ESYS_CONTEXT *esysCtx = calloc(1, sizeof(char));
     ctx.esysCtx = esysCtx;
+    ctx.pcrBanks = COMINIT_CRYPTO_DIGEST_SHA256;
     char *keyfile = {"keyfile"};
 
     const int idxOffset = TPM2_PT_PCR_COUNT;
     const ESYS_TR idx = ESYS_TR_PCR0 + idxOffset;
 
-    will_return(__wrap_cominitCreateSHA256DigestfromKeyfile, 0);
+    expect_value(__wrap_cominitCryptoDigestsFromKeyfile, algs, COMINIT_CRYPTO_DIGEST_SHA256);
+    will_return(__wrap_cominitCryptoDigestsFromKeyfile, EXIT_SUCCESS);
 
     expect_string(__wrap_Esys_PCR_Extend, esysContext, esysCtx);
     expect_value(__wrap_Esys_PCR_Extend, pcrHandle, idx);
     expect_value(__wrap_Esys_PCR_Extend, shandle1, ESYS_TR_PASSWORD);
     expect_value(__wrap_Esys_PCR_Extend, shandle2, ESYS_TR_NONE);
     expect_value(__wrap_Esys_PCR_Extend, shandle3, ESYS_TR_NONE);
+    expect_value(__wrap_Esys_PCR_Extend, digestCount, 1);
     will_return(__wrap_Esys_PCR_Extend, TSS2_ESYS_RC_GENERAL_FAILURE);
     assert_int_not_equal(cominitTpmExtendPCR(&ctx, keyfile, idxOffset), 0);
 
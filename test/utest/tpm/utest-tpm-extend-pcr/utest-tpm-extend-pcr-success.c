@@ -7,6 +7,7 @@
 #include <tss2/tss2_esys.h>
 
 #include "common.h"
+#include "crypto.h"
 #include "securememory.h"
 #include "tpm.h"
 #include "unit_test.h"
@@ -17,18 +18,21 @@ void cominitTpmExtendPCRTestIdx0Success(void **state) {
     cominitTpmContext_t ctx;
     ESYS_CONTEXT *esysCtx = calloc(1, sizeof(char));
     ctx.esysCtx = esysCtx;
+    ctx.pcrBanks = COMINIT_CRYPTO_DIGEST_SHA256;
     char *keyfile = {"keyfile"};
 
     const int idxOffset = 0;
     const ESYS_TR idx = ESYS_TR_PCR0 + idxOffset;
 
-    will_return(__wrap_cominitCreateSHA256DigestfromKeyfile, 0);
+    expect_value(__wrap_cominitCryptoDigestsFromKeyfile, algs, COMINIT_CRYPTO_DIGEST_SHA256);
+    will_return(__wrap_cominitCryptoDigestsFromKeyfile, EXIT_SUCCESS);
 
     expect_string(__wrap_Esys_PCR_Extend, esysContext, esysCtx);
     expect_value(__wrap_Esys_PCR_Extend, pcrHandle, idx);
     expect_value(__wrap_Esys_PCR_Extend, shandle1, ESYS_TR_PASSWORD);
     expect_value(__wrap_Esys_PCR_Extend, shandle2, ESYS_TR_NONE);
     expect_value(__wrap_Esys_PCR_Extend, shandle3, ESYS_TR_NONE);
+    expect_value(__wrap_Esys_PCR_Extend, digestCount, 1);
     will_return(__wrap_Esys_PCR_Extend, TSS2_RC_SUCCESS);
     assert_int_equal(cominitTpmExtendPCR(&ctx, keyfile, idxOffset), 0);
 
@@ -40,20 +44,79 @@ void cominitTpmExtendPCRTestIdx2Success(void **state) {
     cominitTpmContext_t ctx;
     ESYS_CONTEXT *esysCtx = calloc(1, sizeof(char));
     ctx.esysCtx = esysCtx;
+    ctx.pcrBanks = 0;
     char *keyfile = {"keyfile"};
+    TPMS_CAPABILITY_DATA capabilityData = {
+        .capability = TPM2_CAP_PCRS,
+        .data.assignedPCR = {.count = 3,
+                             .pcrSelections = {
+                                 {.hash = TPM2_ALG_SHA1, .sizeofSelect = 3, .pcrSelect = {0x00, 0x00, 0x00}},
+                                 {.hash = TPM2_ALG_SHA256, .sizeofSelect = 3, .pcrSelect = {0xff, 0xff, 0xff}},
+                                 {.hash = TPM2_ALG_SHA384, .sizeofSelect = 3, .pcrSelect = {0xff, 0xff, 0xff}},
+                             }}};
 
     const int idxOffset = 2;
     const ESYS_TR idx = ESYS_TR_PCR0 + idxOffset;
 
-    will_return(__wrap_cominitCreateSHA256DigestfromKeyfile, 0);
+    expect_value(__wrap_Esys_GetCapability, esysContext, esysCtx);
+    expect_value(__wrap_Esys_GetCapability, shandle1, ESYS_TR_NONE);
+    expect_value(__wrap_Esys_GetCapability, shandle2, ESYS_TR_NONE);
+    expect_value(__wrap_Esys_GetCapability, shandle3, ESYS_TR_NONE);
+    expect_value(__wrap_Esys_GetCapability, capability, TPM2_CAP_PCRS);
+    expect_value(__wrap_Esys_GetCapability, property, 0);
+    expect_value(__wrap_Esys_GetCapability, propertyCount, 1);
+    will_return(__wrap_Esys_GetCapability, &capabilityData);
+    will_return(__wrap_Esys_GetCapability, TSS2_RC_SUCCESS);
+    expect_value(__wrap_Esys_Free, __ptr, &capabilityData);
+
+    expect_value(__wrap_cominitCryptoDigestsFromKeyfile, algs,
+                 COMINIT_CRYPTO_DIGEST_SHA256 | COMINIT_CRYPTO_DIGEST_SHA384);
+    will_return(__wrap_cominitCryptoDigestsFromKeyfile, EXIT_SUCCESS);
 
     expect_string(__wrap_Esys_PCR_Extend, esysContext, esysCtx);
     expect_value(__wrap_Esys_PCR_Extend, pcrHandle, idx);
     expect_value(__wrap_Esys_PCR_Extend, shandle1, ESYS_TR_PASSWORD);
     expect_value(__wrap_Esys_PCR_Extend, shandle2, ESYS_TR_NONE);
     expect_value(__wrap_Esys_PCR_Extend, shandle3, ESYS_TR_NONE);
+    expect_value(__wrap_Esys_PCR_Extend, digestCount, 2);
     will_return(__wrap_Esys_PCR_Extend, TSS2_RC_SUCCESS);
     assert_int_equal(cominitTpmExtendPCR(&ctx, keyfile, idxOffset), 0);
+    assert_int_equal(ctx.pcrBanks, COMINIT_CRYPTO_DIGEST_SHA256 | COMINIT_CRYPTO_DIGEST_SHA384);
+
+    free(esysCtx);
+}
+
+void cominitTpmExtendPCRTestCapabilityFallbackSuccess(void **state) {
+    COMINIT_PARAM_UNUSED(state);
+    cominitTpmContext_t ctx;
+    ESYS_CONTEXT *esysCtx = calloc(1, sizeof(char));
+    ctx.esysCtx = esysCtx;
+    ctx.pcrBanks = 0;
+    char *keyfile = {"keyfile"};
+
+    expect_value(__wrap_Esys_GetCapability, esysContext, esysCtx);
+    expect_value(__wrap_Esys_GetCapability, shandle1, ESYS_TR_NONE);
+    expect_value(__wrap_Esys_GetCapability, shandle2, ESYS_TR_NONE);
+    expect_value(__wrap_Esys_GetCapability, shandle3, ESYS_TR_NONE);
+    expect_value(__wrap_Esys_GetCapability, capability, TPM2_CAP_PCRS);
+    expect_value(__wrap_Esys_GetCapability, property, 0);
+    expect_value(__wrap_Esys_GetCapability, propertyCount, 1);
+    will_return(__wrap_Esys_GetCapability, NULL);
+    will_return(__wrap_Esys_GetCapability, TSS2_ESYS_RC_GENERAL_FAILURE);
+    expect_value(__wrap_Esys_Free, __ptr, NULL);
+
+    expect_value(__wrap_cominitCryptoDigestsFromKeyfile, algs, COMINIT_CRYPTO_DIGEST_SHA256);
+    will_return(__wrap_cominitCryptoDigestsFromKeyfile, EXIT_SUCCESS);
+
+    expect_string(__wrap_Esys_PCR_Extend, esysContext, esysCtx);
+    expect_value(__wrap_Esys_PCR_Extend, pcrHandle, ESYS_TR_PCR0);
+    expect_value(__wrap_Esys_PCR_Extend, shandle1, ESYS_TR_PASSWORD);
+    expect_value(__wrap_Esys_PCR_Extend, shandle2, ESYS_TR_NONE);
+    expect_value(__wrap_Esys_PCR_Extend, shandle3, ESYS_TR_NONE);
+    expect_value(__wrap_Esys_PCR_Extend, digestCount, 1);
+    will_return(__wrap_Esys_PCR_Extend, TSS2_RC_SUCCESS);
+    assert_int_equal(cominitTpmExtendPCR(&ctx, keyfile, 0), 0);
+    assert_int_equal(ctx.pcrBanks, COMINIT_CRYPTO_DIGEST_SHA256);
 
     free(esysCtx);
 }
@@ -16,6 +16,7 @@ int main(void) {
     const struct CMUnitTest tests[] = {
         cmocka_unit_test(cominitTpmExtendPCRTestIdx0Success),
         cmocka_unit_test(cominitTpmExtendPCRTestIdx2Success),
+        cmocka_unit_test(cominitTpmExtendPCRTestCapabilityFallbackSuccess),
         cmocka_unit_test(cominitTpmExtendPCRTestNullCtxFailure),
         cmocka_unit_test(cominitTpmExtendPCRTestNullKeyfileFailure),
         cmocka_unit_test(cominitTpmExtendPCRTestNegativeIntegerParamFailure),
@@ -20,6 +20,12 @@ void cominitTpmExtendPCRTestIdx0Success(void **state);
  */
 void cominitTpmExtendPCRTestIdx2Success(void **state);
 
+/**
+ * Unit test for cominitTpmExtendPCR() falling back to the SHA-256 bank if the PCR banks cannot be queried.
+ * @param state
+ */
+void cominitTpmExtendPCRTestCapabilityFallbackSuccess(void **state);
+
 /**
  * Unit test that simulates a null value parameter for tpmCtx
  * @param state
@@ -0,0 +1,32 @@
+// SPDX-License-Identifier: MIT
+/**
+ * @file utest-tpm-parse-blob-storage-failure.c
+ * @brief Implementation of several failure case unit tests for cominitTpmParseBlobStorage().
+ */
+#include <cmocka_extensions/cmocka_extensions.h>
+#include <stdlib.h>
+
+#include "common.h"
+#include "tpm.h"
+#include "unit_test.h"
+#include "utest-tpm-parse-blob-storage.h"
+
+void cominitTpmParseBlobStorageTestFailure(void **state) {
+    COMINIT_PARAM_UNUSED(state);
+
+    cominitCliArgs_t ctx = {.blobStorage = COMINIT_BLOB_STORAGE_EXT4, .blobNvIndex = COMINIT_TPM_BLOB_NV_INDEX};
+
+    const char *testStrings[] = {
+        "",         "EXT4",          "raw ",          "file",           "nv:",
+        "nv:index", "nv:0x81000000", "nv:0x00FFFFFF", "nv:0x01000100 ", "nv0x01000100",
+    };
+
+    for (size_t i = 0; i < ARRAY_SIZE(testStrings); ++i) {
+        assert_int_not_equal(cominitTpmParseBlobStorage(&ctx, testStrings[i]), EXIT_SUCCESS);
+        assert_int_equal(ctx.blobStorage, COMINIT_BLOB_STORAGE_EXT4);
+        assert_int_equal(ctx.blobNvIndex, COMINIT_TPM_BLOB_NV_INDEX);
+    }
+
+    assert_int_not_equal(cominitTpmParseBlobStorage(NULL, "raw"), EXIT_SUCCESS);
+    assert_int_not_equal(cominitTpmParseBlobStorage(&ctx, NULL), EXIT_SUCCESS);
+}
@@ -0,0 +1,35 @@
+// SPDX-License-Identifier: MIT
+/**
+ * @file utest-tpm-parse-blob-storage-success.c
+ * @brief Implementation of a success case unit test for cominitTpmParseBlobStorage().
+ */
+#include <cmocka_extensions/cmocka_extensions.h>
+#include <stdlib.h>
+
+#include "common.h"
+#include "tpm.h"
+#include "unit_test.h"
+#include "utest-tpm-parse-blob-storage.h"
+
+void cominitTpmParseBlobStorageTestSuccess(void **state) {
+    COMINIT_PARAM_UNUSED(state);
+
+    cominitCliArgs_t ctx = {.blobStorage = COMINIT_BLOB_STORAGE_EXT4, .blobNvIndex = COMINIT_TPM_BLOB_NV_INDEX};
+
+    assert_int_equal(cominitTpmParseBlobStorage(&ctx, "raw"), EXIT_SUCCESS);
+    assert_int_equal(ctx.blobStorage, COMINIT_BLOB_STORAGE_RAW);
+
+    assert_int_equal(cominitTpmParseBlobStorage(&ctx, "ext4"), EXIT_SUCCESS);
+    assert_int_equal(ctx.blobStorage, COMINIT_BLOB_STORAGE_EXT4);
+
+    assert_int_equal(cominitTpmParseBlobStorage(&ctx, "nv"), EXIT_SUCCESS);
+    assert_int_equal(ctx.blobStorage, COMINIT_BLOB_STORAGE_NV);
+    assert_int_equal(ctx.blobNvIndex, COMINIT_TPM_BLOB_NV_INDEX);
+
+    assert_int_equal(cominitTpmParseBlobStorage(&ctx, "nv:0x01000042"), EXIT_SUCCESS);
+    assert_int_equal(ctx.blobStorage, COMINIT_BLOB_STORAGE_NV);
+    assert_int_equal(ctx.blobNvIndex, 0x01000042);
+
+    assert_int_equal(cominitTpmParseBlobStorage(&ctx, "nv:0x01FFFFFF"), EXIT_SUCCESS);
+    assert_int_equal(ctx.blobNvIndex, TPM2_NV_INDEX_LAST);
+}
@@ -0,0 +1,21 @@
+// SPDX-License-Identifier: MIT
+/**
+ * @file utest-tpm-parse-blob-storage.c
+ * @brief Implementation of an cominitTpmParseBlobStorage() unit test group using cmocka.
+ */
+#include "utest-tpm-parse-blob-storage.h"
+
+#include "unit_test.h"
+
+/**
+ * Run the unit tests for cominitTpmParseBlobStorage().
+ *
+ * @return  The same as cmocka_run_group_tests() returns for the tests.
+ */
+int main(void) {
+    const struct CMUnitTest tests[] = {
+        cmocka_unit_test(cominitTpmParseBlobStorageTestSuccess),
+        cmocka_unit_test(cominitTpmParseBlobStorageTestFailure),
+    };
+    return cmocka_run_group_tests(tests, NULL, NULL);
+}
@@ -0,0 +1,21 @@
+// SPDX-License-Identifier: MIT
+/**
+ * @file utest-tpm-parse-blob-storage.h
+ * @brief Header declaring cmocka unit test functions for cominitTpmParseBlobStorage().
+ */
+#ifndef __UTEST_TPM_PARSE_BLOB_STORAGE_H__
+#define __UTEST_TPM_PARSE_BLOB_STORAGE_H__
+
+/**
+ * Unit test for cominitTpmParseBlobStorage() successful code path.
+ * @param state
+ */
+void cominitTpmParseBlobStorageTestSuccess(void **state);
+
+/**
+ * Unit test that simulates invalid blob storages, NV indexes and parameters.
+ * @param state
+ */
+void cominitTpmParseBlobStorageTestFailure(void **state);
+
+#endif /* __UTEST_TPM_PARSE_BLOB_STORAGE_H__ */
@@ -0,0 +1,55 @@
+// SPDX-License-Identifier: MIT
+/**
+ * @file utest-tpm-parse-crypt-volumes-failure.c
+ * @brief Implementation of several failure case unit tests for cominitTpmParseCryptVolumes().
+ */
+#include <cmocka_extensions/cmocka_extensions.h>
+#include <stdlib.h>
+
+#include "common.h"
+#include "tpm.h"
+#include "unit_test.h"
+#include "utest-tpm-parse-crypt-volumes.h"
+
+void cominitTpmParseCryptVolumesTestFailure(void **state) {
+    COMINIT_PARAM_UNUSED(state);
+
+    cominitCliArgs_t ctx = {.cryptVolumeCount = 0};
+
+    const char *testStrings[] = {
+        "",
+        ",",
+        "logs",
+        "logs:",
+        ":11111111-2222-3333-4444-555555555555",
+        "logs:11111111-2222-3333-4444-55555555555",
+        "logs:11111111-2222-3333-4444-5555555555555",
+        "logs:11111111-2222-3333-4444-555555555555:",
+        "logs:11111111-2222-3333-4444-555555555555:creat",
+        "logs:11111111-2222-3333-4444-555555555555:created",
+        "logs:11111111-2222-3333-4444-555555555555+create",
+        "logs:11111111+2222-3333-4444-555555555555",
+        "logs:1111111g-2222-3333-4444-555555555555",
+        "lo/gs:11111111-2222-3333-4444-555555555555",
+        "secureStorage:11111111-2222-3333-4444-555555555555",
+        "a_volume_name_that_is_far_too_long:11111111-2222-3333-4444-555555555555",
+        "logs:11111111-2222-3333-4444-555555555555,logs:aaaaaaaa-bbbb-cccc-dddd-eeeeeeeeeeee",
+        "logs:11111111-2222-3333-4444-555555555555,data:11111111-2222-3333-4444-555555555555",
+        "logs:11111111-2222-3333-4444-555555555555,data",
+        "a:00000000-0000-0000-0000-000000000001,b:00000000-0000-0000-0000-000000000002,"
+        "c:00000000-0000-0000-0000-000000000003,d:00000000-0000-0000-0000-000000000004,"
+        "e:00000000-0000-0000-0000-000000000005,f:00000000-0000-0000-0000-000000000006,"
+        "g:00000000-0000-0000-0000-000000000007,h:00000000-0000-0000-0000-000000000008,"
+        "i:00000000-0000-0000-0000-000000000009",
+    };
+
+    for (size_t i = 0; i < ARRAY_SIZE(testStrings); ++i) {
+        ctx.cryptVolumeCount = 1;
+        assert_int_not_equal(cominitTpmParseCryptVolumes(&ctx, testStrings[i]), EXIT_SUCCESS);
+        assert_int_equal(ctx.cryptVolumeCount, 0);
+    }
+
+    assert_int_not_equal(cominitTpmParseCryptVolumes(NULL, "logs:11111111-2222-3333-4444-555555555555"),
+                         EXIT_SUCCESS);
+    assert_int_not_equal(cominitTpmParseCryptVolumes(&ctx, NULL), EXIT_SUCCESS);
+}
@@ -0,0 +1,44 @@
+// SPDX-License-Identifier: MIT
+/**
+ * @file utest-tpm-parse-crypt-volumes-success.c
+ * @brief Implementation of a success case unit test for cominitTpmParseCryptVolumes().
+ */
+#include <cmocka_extensions/cmocka_extensions.h>
+#include <stdlib.h>
+
+#include "common.h"
+#include "tpm.h"
+#include "unit_test.h"
+#include "utest-tpm-parse-crypt-volumes.h"
+
+void cominitTpmParseCryptVolumesTestSuccess(void **state) {
+    COMINIT_PARAM_UNUSED(state);
+
+    cominitCliArgs_t ctx = {.cryptVolumeCount = 0};
+
+    assert_int_equal(cominitTpmParseCryptVolumes(&ctx, "logs:0FC63DAF-8483-4772-8E79-3D69D8477DE4"), EXIT_SUCCESS);
+    assert_int_equal(ctx.cryptVolumeCount, 1);
+    assert_string_equal(ctx.cryptVolumes[0].name, "logs");
+    assert_string_equal(ctx.cryptVolumes[0].partUuid, "0fc63daf-8483-4772-8e79-3d69d8477de4");
+    assert_string_equal(ctx.cryptVolumes[0].devNode, "");
+    assert_false(ctx.cryptVolumes[0].create);
+
+    assert_int_equal(cominitTpmParseCryptVolumes(&ctx,
+                                                 "app_data:11111111-2222-3333-4444-555555555555,"
+                                                 "cache-1:aaaaaaaa-bbbb-cccc-dddd-eeeeeeeeeeee"),
+                     EXIT_SUCCESS);
+    assert_int_equal(ctx.cryptVolumeCount, 2);
+    assert_string_equal(ctx.cryptVolumes[0].name, "app_data");
+    assert_string_equal(ctx.cryptVolumes[0].partUuid, "11111111-2222-3333-4444-555555555555");
+    assert_string_equal(ctx.cryptVolumes[1].name, "cache-1");
+    assert_string_equal(ctx.cryptVolumes[1].partUuid, "aaaaaaaa-bbbb-cccc-dddd-eeeeeeeeeeee");
+
+    assert_int_equal(cominitTpmParseCryptVolumes(&ctx,
+                                                 "logs:0fc63daf-8483-4772-8e79-3d69d8477de4:create,"
+                                                 "data:aaaaaaaa-bbbb-cccc-dddd-eeeeeeeeeeee"),
+                     EXIT_SUCCESS);
+    assert_int_equal(ctx.cryptVolumeCount, 2);
+    assert_string_equal(ctx.cryptVolumes[0].partUuid, "0fc63daf-8483-4772-8e79-3d69d8477de4");
+    assert_true(ctx.cryptVolumes[0].create);
+    assert_false(ctx.cryptVolumes[1].create);
+}
@@ -0,0 +1,21 @@
+// SPDX-License-Identifier: MIT
+/**
+ * @file utest-tpm-parse-crypt-volumes.c
+ * @brief Implementation of an cominitTpmParseCryptVolumes() unit test group using cmocka.
+ */
+#include "utest-tpm-parse-crypt-volumes.h"
+
+#include "unit_test.h"
+
+/**
+ * Run the unit tests for cominitTpmParseCryptVolumes().
+ *
+ * @return  The same as cmocka_run_group_tests() returns for the tests.
+ */
+int main(void) {
+    const struct CMUnitTest tests[] = {
+        cmocka_unit_test(cominitTpmParseCryptVolumesTestSuccess),
+        cmocka_unit_test(cominitTpmParseCryptVolumesTestFailure),
+    };
+    return cmocka_run_group_tests(tests, NULL, NULL);
+}
@@ -0,0 +1,21 @@
+// SPDX-License-Identifier: MIT
+/**
+ * @file utest-tpm-parse-crypt-volumes.h
+ * @brief Header declaring cmocka unit test functions for cominitTpmParseCryptVolumes().
+ */
+#ifndef __UTEST_TPM_PARSE_CRYPT_VOLUMES_H__
+#define __UTEST_TPM_PARSE_CRYPT_VOLUMES_H__
+
+/**
+ * Unit test for cominitTpmParseCryptVolumes() successful code path.
+ * @param state
+ */
+void cominitTpmParseCryptVolumesTestSuccess(void **state);
+
+/**
+ * Unit test that simulates invalid volume names, partition GUIDs and parameters.
+ * @param state
+ */
+void cominitTpmParseCryptVolumesTestFailure(void **state);
+
+#endif /* __UTEST_TPM_PARSE_CRYPT_VOLUMES_H__ */
@@ -0,0 +1,27 @@
+// SPDX-License-Identifier: MIT
+/**
+ * @file utest-tpm-parse-pcr-measure-success.c
+ * @brief Implementation of a success case unit test for cominitTpmParsePcrMeasureIndex().
+ */
+#include <cmocka_extensions/cmocka_extensions.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "common.h"
+#include "securememory.h"
+#include "tpm.h"
+#include "unit_test.h"
+#include "utest-tpm-parse-pcr-measure.h"
+
+void cominitTpmParsePcrMeasureIndexTestSuccess(void **state) {
+    COMINIT_PARAM_UNUSED(state);
+
+    cominitCliArgs_t ctx = {0};
+    char argvalue[4];
+    snprintf(argvalue, sizeof(argvalue), "%d", 11);
+
+    assert_int_equal(cominitTpmParsePcrMeasureIndex(&ctx, argvalue), 0);
+
+    assert_true(ctx.pcrMeasureSet);
+    assert_int_equal(ctx.pcrMeasureIndex, 11);
+}
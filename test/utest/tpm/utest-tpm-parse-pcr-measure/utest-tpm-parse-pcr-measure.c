@@ -0,0 +1,21 @@
+// SPDX-License-Identifier: MIT
+/**
+ * @file utest-tpm-parse-pcr-measure.c
+ * @brief Impementation of an cominitTpmParsePcrMeasureIndex() unit test group using cmocka.
+ */
+#include "utest-tpm-parse-pcr-measure.h"
+
+#include "unit_test.h"
+
+/**
+ * Run the unit tests for cominitTpmParsePcrMeasureIndex().
+ *
+ * @return  The same as cmocka_run_group_tests() returns for the tests.
+ */
+int main(void) {
+    const struct CMUnitTest tests[] = {
+        cmocka_unit_test(cominitTpmParsePcrMeasureIndexTestSuccess),
+        cmocka_unit_test(cominitTpmParsePcrMeasureIndexTestFailure),
+    };
+    return cmocka_run_group_tests(tests, NULL, NULL);
+}
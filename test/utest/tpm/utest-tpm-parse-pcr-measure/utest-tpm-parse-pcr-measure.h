@@ -0,0 +1,23 @@
+// SPDX-License-Identifier: MIT
+/**
+ * @file utest-tpm-parse-pcr-measure.h
+ * @brief Header declaring cmocka unit test functions for cominitTpmParsePcrMeasureIndex().
+ */
+#ifndef __UTEST_TPM_PARSE_PCR_MEASURE_H__
+#define __UTEST_TPM_PARSE_PCR_MEASURE_H__
+
+#include <sys/mount.h>
+
+/**
+ * Unit test for cominitTpmParsePcrMeasureIndex() successful code path.
+ * @param state
+ */
+void cominitTpmParsePcrMeasureIndexTestSuccess(void **state);
+
+/**
+ * Unit test that simulates different non integer parameters
+ * @param state
+ */
+void cominitTpmParsePcrMeasureIndexTestFailure(void **state);
+
+#endif /* __UTEST_TPM_PARSE_PCR_MEASURE_H__ */
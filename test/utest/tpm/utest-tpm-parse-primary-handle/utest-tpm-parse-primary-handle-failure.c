@@ -0,0 +1,30 @@
+// SPDX-License-Identifier: MIT
+/**
+ * @file utest-tpm-parse-primary-handle-failure.c
+ * @brief Implementation of several failure case unit tests for cominitTpmParsePrimaryHandle().
+ */
+#include <cmocka_extensions/cmocka_extensions.h>
+#include <stdlib.h>
+
+#include "common.h"
+#include "tpm.h"
+#include "unit_test.h"
+#include "utest-tpm-parse-primary-handle.h"
+
+void cominitTpmParsePrimaryHandleTestFailure(void **state) {
+    COMINIT_PARAM_UNUSED(state);
+
+    cominitCliArgs_t ctx = {.tpmPrimaryHandle = TPM2_PERSISTENT_FIRST};
+
+    const char *testStrings[] = {
+        "", "0x80000000", "0x82000000", "0x81000000 ", "handle", "-1", "0x1000000000000000",
+    };
+
+    for (size_t i = 0; i < ARRAY_SIZE(testStrings); ++i) {
+        assert_int_not_equal(cominitTpmParsePrimaryHandle(&ctx, testStrings[i]), EXIT_SUCCESS);
+        assert_int_equal(ctx.tpmPrimaryHandle, TPM2_PERSISTENT_FIRST);
+    }
+
+    assert_int_not_equal(cominitTpmParsePrimaryHandle(NULL, "0x81000001"), EXIT_SUCCESS);
+    assert_int_not_equal(cominitTpmParsePrimaryHandle(&ctx, NULL), EXIT_SUCCESS);
+}
@@ -0,0 +1,27 @@
+// SPDX-License-Identifier: MIT
+/**
+ * @file utest-tpm-parse-primary-handle-success.c
+ * @brief Implementation of a success case unit test for cominitTpmParsePrimaryHandle().
+ */
+#include <cmocka_extensions/cmocka_extensions.h>
+#include <stdlib.h>
+
+#include "common.h"
+#include "tpm.h"
+#include "unit_test.h"
+#include "utest-tpm-parse-primary-handle.h"
+
+void cominitTpmParsePrimaryHandleTestSuccess(void **state) {
+    COMINIT_PARAM_UNUSED(state);
+
+    cominitCliArgs_t ctx = {0};
+
+    assert_int_equal(cominitTpmParsePrimaryHandle(&ctx, "0x81000001"), EXIT_SUCCESS);
+    assert_int_equal(ctx.tpmPrimaryHandle, 0x81000001);
+
+    assert_int_equal(cominitTpmParsePrimaryHandle(&ctx, "0x81ffffff"), EXIT_SUCCESS);
+    assert_int_equal(ctx.tpmPrimaryHandle, TPM2_PERSISTENT_LAST);
+
+    assert_int_equal(cominitTpmParsePrimaryHandle(&ctx, "2164260864"), EXIT_SUCCESS);
+    assert_int_equal(ctx.tpmPrimaryHandle, TPM2_PERSISTENT_FIRST);
+}
@@ -0,0 +1,21 @@
+// SPDX-License-Identifier: MIT
+/**
+ * @file utest-tpm-parse-primary-handle.c
+ * @brief Implementation of an cominitTpmParsePrimaryHandle() unit test group using cmocka.
+ */
+#include "utest-tpm-parse-primary-handle.h"
+
+#include "unit_test.h"
+
+/**
+ * Run the unit tests for cominitTpmParsePrimaryHandle().
+ *
+ * @return  The same as cmocka_run_group_tests() returns for the tests.
+ */
+int main(void) {
+    const struct CMUnitTest tests[] = {
+        cmocka_unit_test(cominitTpmParsePrimaryHandleTestSuccess),
+        cmocka_unit_test(cominitTpmParsePrimaryHandleTestFailure),
+    };
+    return cmocka_run_group_tests(tests, NULL, NULL);
+}
@@ -0,0 +1,21 @@
+// SPDX-License-Identifier: MIT
+/**
+ * @file utest-tpm-parse-primary-handle.h
+ * @brief Header declaring cmocka unit test functions for cominitTpmParsePrimaryHandle().
+ */
+#ifndef __UTEST_TPM_PARSE_PRIMARY_HANDLE_H__
+#define __UTEST_TPM_PARSE_PRIMARY_HANDLE_H__
+
+/**
+ * Unit test for cominitTpmParsePrimaryHandle() successful code path.
+ * @param state
+ */
+void cominitTpmParsePrimaryHandleTestSuccess(void **state);
+
+/**
+ * Unit test that simulates handles outside the persistent range and invalid parameters.
+ * @param state
+ */
+void cominitTpmParsePrimaryHandleTestFailure(void **state);
+
+#endif /* __UTEST_TPM_PARSE_PRIMARY_HANDLE_H__ */
@@ -0,0 +1,33 @@
+// SPDX-License-Identifier: MIT
+/**
+ * @file utest-tpm-parse-secure-storage-mode-failure.c
+ * @brief Implementation of several failure case unit tests for cominitTpmParseSecureStorageMode().
+ */
+#include <cmocka_extensions/cmocka_extensions.h>
+#include <stdlib.h>
+
+#include "common.h"
+#include "tpm.h"
+#include "unit_test.h"
+#include "utest-tpm-parse-secure-storage-mode.h"
+
+void cominitTpmParseSecureStorageModeTestFailure(void **state) {
+    COMINIT_PARAM_UNUSED(state);
+
+    cominitCliArgs_t ctx = {.secureStorageMode = COMINIT_SECURE_STORAGE_MODE_DEFERRED};
+
+    const char *testStrings[] = {
+        "",
+        "async",
+        "Deferred",
+        "deferred ",
+    };
+
+    for (size_t i = 0; i < ARRAY_SIZE(testStrings); ++i) {
+        assert_int_not_equal(cominitTpmParseSecureStorageMode(&ctx, testStrings[i]), EXIT_SUCCESS);
+        assert_int_equal(ctx.secureStorageMode, COMINIT_SECURE_STORAGE_MODE_DEFERRED);
+    }
+
+    assert_int_not_equal(cominitTpmParseSecureStorageMode(NULL, "sync"), EXIT_SUCCESS);
+    assert_int_not_equal(cominitTpmParseSecureStorageMode(&ctx, NULL), EXIT_SUCCESS);
+}
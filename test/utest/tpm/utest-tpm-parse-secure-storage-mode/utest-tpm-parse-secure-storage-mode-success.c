@@ -0,0 +1,27 @@
+// SPDX-License-Identifier: MIT
+/**
+ * @file utest-tpm-parse-secure-storage-mode-success.c
+ * @brief Implementation of a success case unit test for cominitTpmParseSecureStorageMode().
+ */
+#include <cmocka_extensions/cmocka_extensions.h>
+#include <stdlib.h>
+
+#include "common.h"
+#include "tpm.h"
+#include "unit_test.h"
+#include "utest-tpm-parse-secure-storage-mode.h"
+
+void cominitTpmParseSecureStorageModeTestSuccess(void **state) {
+    COMINIT_PARAM_UNUSED(state);
+
+    cominitCliArgs_t ctx = {0};
+
+    assert_int_equal(cominitTpmParseSecureStorageMode(&ctx, "deferred"), EXIT_SUCCESS);
+    assert_int_equal(ctx.secureStorageMode, COMINIT_SECURE_STORAGE_MODE_DEFERRED);
+
+    assert_int_equal(cominitTpmParseSecureStorageMode(&ctx, "detached"), EXIT_SUCCESS);
+    assert_int_equal(ctx.secureStorageMode, COMINIT_SECURE_STORAGE_MODE_DETACHED);
+
+    assert_int_equal(cominitTpmParseSecureStorageMode(&ctx, "sync"), EXIT_SUCCESS);
+    assert_int_equal(ctx.secureStorageMode, COMINIT_SECURE_STORAGE_MODE_SYNC);
+}
@@ -0,0 +1,21 @@
+// SPDX-License-Identifier: MIT
+/**
+ * @file utest-tpm-parse-secure-storage-mode.c
+ * @brief Implementation of an cominitTpmParseSecureStorageMode() unit test group using cmocka.
+ */
+#include "utest-tpm-parse-secure-storage-mode.h"
+
+#include "unit_test.h"
+
+/**
+ * Run the unit tests for cominitTpmParseSecureStorageMode().
+ *
+ * @return  The same as cmocka_run_group_tests() returns for the tests.
+ */
+int main(void) {
+    const struct CMUnitTest tests[] = {
+        cmocka_unit_test(cominitTpmParseSecureStorageModeTestSuccess),
+        cmocka_unit_test(cominitTpmParseSecureStorageModeTestFailure),
+    };
+    return cmocka_run_group_tests(tests, NULL, NULL);
+}
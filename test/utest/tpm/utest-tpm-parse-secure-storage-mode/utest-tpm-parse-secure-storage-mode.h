@@ -0,0 +1,21 @@
+// SPDX-License-Identifier: MIT
+/**
+ * @file utest-tpm-parse-secure-storage-mode.h
+ * @brief Header declaring cmocka unit test functions for cominitTpmParseSecureStorageMode().
+ */
+#ifndef __UTEST_TPM_PARSE_SECURE_STORAGE_MODE_H__
+#define __UTEST_TPM_PARSE_SECURE_STORAGE_MODE_H__
+
+/**
+ * Unit test for cominitTpmParseSecureStorageMode() successful code path.
+ * @param state
+ */
+void cominitTpmParseSecureStorageModeTestSuccess(void **state);
+
+/**
+ * Unit test that simulates invalid mode values and parameters.
+ * @param state
+ */
+void cominitTpmParseSecureStorageModeTestFailure(void **state);
+
+#endif /* __UTEST_TPM_PARSE_SECURE_STORAGE_MODE_H__ */
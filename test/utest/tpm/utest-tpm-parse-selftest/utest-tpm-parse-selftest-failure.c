@@ -0,0 +1,33 @@
+// SPDX-License-Identifier: MIT
+/**
+ * @file utest-tpm-parse-selftest-failure.c
+ * @brief Implementation of several failure case unit tests for cominitTpmParseSelftest().
+ */
+#include <cmocka_extensions/cmocka_extensions.h>
+#include <stdlib.h>
+
+#include "common.h"
+#include "tpm.h"
+#include "unit_test.h"
+#include "utest-tpm-parse-selftest.h"
+
+void cominitTpmParseSelftestTestFailure(void **state) {
+    COMINIT_PARAM_UNUSED(state);
+
+    cominitCliArgs_t ctx = {.tpmFullSelftest = true};
+
+    const char *testStrings[] = {
+        "",
+        "yes",
+        "Full",
+        "full ",
+    };
+
+    for (size_t i = 0; i < ARRAY_SIZE(testStrings); ++i) {
+        assert_int_not_equal(cominitTpmParseSelftest(&ctx, testStrings[i]), EXIT_SUCCESS);
+        assert_true(ctx.tpmFullSelftest);
+    }
+
+    assert_int_not_equal(cominitTpmParseSelftest(NULL, "full"), EXIT_SUCCESS);
+    assert_int_not_equal(cominitTpmParseSelftest(&ctx, NULL), EXIT_SUCCESS);
+}
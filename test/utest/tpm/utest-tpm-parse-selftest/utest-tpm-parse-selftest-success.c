@@ -0,0 +1,24 @@
+// SPDX-License-Identifier: MIT
+/**
+ * @file utest-tpm-parse-selftest-success.c
+ * @brief Implementation of a success case unit test for cominitTpmParseSelftest().
+ */
+#include <cmocka_extensions/cmocka_extensions.h>
+#include <stdlib.h>
+
+#include "common.h"
+#include "tpm.h"
+#include "unit_test.h"
+#include "utest-tpm-parse-selftest.h"
+
+void cominitTpmParseSelftestTestSuccess(void **state) {
+    COMINIT_PARAM_UNUSED(state);
+
+    cominitCliArgs_t ctx = {0};
+
+    assert_int_equal(cominitTpmParseSelftest(&ctx, "full"), EXIT_SUCCESS);
+    assert_true(ctx.tpmFullSelftest);
+
+    assert_int_equal(cominitTpmParseSelftest(&ctx, "incremental"), EXIT_SUCCESS);
+    assert_false(ctx.tpmFullSelftest);
+}
@@ -0,0 +1,21 @@
+// SPDX-License-Identifier: MIT
+/**
+ * @file utest-tpm-parse-selftest.c
+ * @brief Implementation of an cominitTpmParseSelftest() unit test group using cmocka.
+ */
+#include "utest-tpm-parse-selftest.h"
+
+#include "unit_test.h"
+
+/**
+ * Run the unit tests for cominitTpmParseSelftest().
+ *
+ * @return  The same as cmocka_run_group_tests() returns for the tests.
+ */
+int main(void) {
+    const struct CMUnitTest tests[] = {
+        cmocka_unit_test(cominitTpmParseSelftestTestSuccess),
+        cmocka_unit_test(cominitTpmParseSelftestTestFailure),
+    };
+    return cmocka_run_group_tests(tests, NULL, NULL);
+}
@@ -0,0 +1,21 @@
+// SPDX-License-Identifier: MIT
+/**
+ * @file utest-tpm-parse-selftest.h
+ * @brief Header declaring cmocka unit test functions for cominitTpmParseSelftest().
+ */
+#ifndef __UTEST_TPM_PARSE_SELFTEST_H__
+#define __UTEST_TPM_PARSE_SELFTEST_H__
+
+/**
+ * Unit test for cominitTpmParseSelftest() successful code path.
+ * @param state
+ */
+void cominitTpmParseSelftestTestSuccess(void **state);
+
+/**
+ * Unit test that simulates invalid mode values and parameters.
+ * @param state
+ */
+void cominitTpmParseSelftestTestFailure(void **state);
+
+#endif /* __UTEST_TPM_PARSE_SELFTEST_H__ */
@@ -0,0 +1,30 @@
+// SPDX-License-Identifier: MIT
+/**
+ * @file utest-tpm-parse-tcti-failure.c
+ * @brief Implementation of several failure case unit tests for cominitTpmParseTcti().
+ */
+#include <cmocka_extensions/cmocka_extensions.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "common.h"
+#include "tpm.h"
+#include "unit_test.h"
+#include "utest-tpm-parse-tcti.h"
+
+void cominitTpmParseTctiTestFailure(void **state) {
+    COMINIT_PARAM_UNUSED(state);
+
+    cominitCliArgs_t ctx = {.tpmTcti = "device:/dev/tpm0"};
+    char tooLong[COMINIT_TPM_TCTI_MAX + 1];
+
+    memset(tooLong, 'a', sizeof(tooLong) - 1);
+    tooLong[sizeof(tooLong) - 1] = '\0';
+
+    assert_int_not_equal(cominitTpmParseTcti(&ctx, ""), EXIT_SUCCESS);
+    assert_int_not_equal(cominitTpmParseTcti(&ctx, tooLong), EXIT_SUCCESS);
+    assert_string_equal(ctx.tpmTcti, "device:/dev/tpm0");
+
+    assert_int_not_equal(cominitTpmParseTcti(NULL, "mssim"), EXIT_SUCCESS);
+    assert_int_not_equal(cominitTpmParseTcti(&ctx, NULL), EXIT_SUCCESS);
+}
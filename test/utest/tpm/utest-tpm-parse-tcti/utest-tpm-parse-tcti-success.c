@@ -0,0 +1,29 @@
+// SPDX-License-Identifier: MIT
+/**
+ * @file utest-tpm-parse-tcti-success.c
+ * @brief Implementation of a success case unit test for cominitTpmParseTcti().
+ */
+#include <cmocka_extensions/cmocka_extensions.h>
+#include <stdlib.h>
+
+#include "common.h"
+#include "tpm.h"
+#include "unit_test.h"
+#include "utest-tpm-parse-tcti.h"
+
+void cominitTpmParseTctiTestSuccess(void **state) {
+    COMINIT_PARAM_UNUSED(state);
+
+    cominitCliArgs_t ctx = {0};
+
+    const char *testStrings[] = {
+        "device:/dev/tpmrm0",
+        "swtpm:host=127.0.0.1,port=2321",
+        "mssim",
+    };
+
+    for (size_t i = 0; i < ARRAY_SIZE(testStrings); ++i) {
+        assert_int_equal(cominitTpmParseTcti(&ctx, testStrings[i]), EXIT_SUCCESS);
+        assert_string_equal(ctx.tpmTcti, testStrings[i]);
+    }
+}
@@ -0,0 +1,21 @@
+// SPDX-License-Identifier: MIT
+/**
+ * @file utest-tpm-parse-tcti.c
+ * @brief Implementation of an cominitTpmParseTcti() unit test group using cmocka.
+ */
+#include "utest-tpm-parse-tcti.h"
+
+#include "unit_test.h"
+
+/**
+ * Run the unit tests for cominitTpmParseTcti().
+ *
+ * @return  The same as cmocka_run_group_tests() returns for the tests.
+ */
+int main(void) {
+    const struct CMUnitTest tests[] = {
+        cmocka_unit_test(cominitTpmParseTctiTestSuccess),
+        cmocka_unit_test(cominitTpmParseTctiTestFailure),
+    };
+    return cmocka_run_group_tests(tests, NULL, NULL);
+}
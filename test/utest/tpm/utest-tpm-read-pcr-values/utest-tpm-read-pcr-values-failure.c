@@ -0,0 +1,62 @@
+// SPDX-License-Identifier: MIT
+/**
+ * @file utest-tpm-read-pcr-values-failure.c
+ * @brief Implementation of failure cases unit tests for cominitTpmReadPcrValues().
+ */
+#include <stdlib.h>
+#include <tss2/tss2_esys.h>
+
+#include "common.h"
+#include "tpm.h"
+#include "unit_test.h"
+#include "utest-tpm-read-pcr-values.h"
+
+void cominitTpmReadPcrValuesTestReadFailure(void **state) {
+    COMINIT_PARAM_UNUSED(state);
+    cominitTpmContext_t ctx = {0};
+    ESYS_CONTEXT *esysCtx = calloc(1, sizeof(char));
+    ctx.esysCtx = esysCtx;
+    const unsigned long pcrs[] = {0};
+    uint8_t pcrValues[COMINIT_TPM_PCR_MAX][TPM2_SHA256_DIGEST_SIZE] = {{0}};
+
+    expect_value(__wrap_Esys_PCR_Read, esysContext, esysCtx);
+    expect_value(__wrap_Esys_PCR_Read, shandle1, ESYS_TR_NONE);
+    expect_value(__wrap_Esys_PCR_Read, shandle2, ESYS_TR_NONE);
+    expect_value(__wrap_Esys_PCR_Read, shandle3, ESYS_TR_NONE);
+    expect_any(__wrap_Esys_PCR_Read, pcrSelectionIn);
+    expect_any(__wrap_Esys_PCR_Read, pcrUpdateCounter);
+    will_return(__wrap_Esys_PCR_Read, NULL);
+    will_return(__wrap_Esys_PCR_Read, NULL);
+    will_return(__wrap_Esys_PCR_Read, TSS2_ESYS_RC_GENERAL_FAILURE);
+    expect_value(__wrap_Esys_Free, __ptr, NULL);
+    expect_value(__wrap_Esys_Free, __ptr, NULL);
+    assert_int_equal(cominitTpmReadPcrValues(&ctx, pcrs, 1, pcrValues), EXIT_FAILURE);
+
+    free(esysCtx);
+}
+
+void cominitTpmReadPcrValuesTestMissingPcrFailure(void **state) {
+    COMINIT_PARAM_UNUSED(state);
+    cominitTpmContext_t ctx = {0};
+    ESYS_CONTEXT *esysCtx = calloc(1, sizeof(char));
+    ctx.esysCtx = esysCtx;
+    const unsigned long pcrs[] = {23};
+    uint8_t pcrValues[COMINIT_TPM_PCR_MAX][TPM2_SHA256_DIGEST_SIZE] = {{0}};
+    TPML_PCR_SELECTION selection = {.count = 0};
+    TPML_DIGEST values = {.count = 0};
+
+    expect_value(__wrap_Esys_PCR_Read, esysContext, esysCtx);
+    expect_value(__wrap_Esys_PCR_Read, shandle1, ESYS_TR_NONE);
+    expect_value(__wrap_Esys_PCR_Read, shandle2, ESYS_TR_NONE);
+    expect_value(__wrap_Esys_PCR_Read, shandle3, ESYS_TR_NONE);
+    expect_any(__wrap_Esys_PCR_Read, pcrSelectionIn);
+    expect_any(__wrap_Esys_PCR_Read, pcrUpdateCounter);
+    will_return(__wrap_Esys_PCR_Read, &selection);
+    will_return(__wrap_Esys_PCR_Read, &values);
+    will_return(__wrap_Esys_PCR_Read, TSS2_RC_SUCCESS);
+    expect_value(__wrap_Esys_Free, __ptr, &selection);
+    expect_value(__wrap_Esys_Free, __ptr, &values);
+    assert_int_equal(cominitTpmReadPcrValues(&ctx, pcrs, 1, pcrValues), EXIT_FAILURE);
+
+    free(esysCtx);
+}
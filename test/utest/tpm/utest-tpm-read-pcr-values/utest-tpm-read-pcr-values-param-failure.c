@@ -0,0 +1,43 @@
+// SPDX-License-Identifier: MIT
+/**
+ * @file utest-tpm-read-pcr-values-param-failure.c
+ * @brief Implementation of parameter failure cases unit tests for cominitTpmReadPcrValues().
+ */
+#include <stdlib.h>
+#include <tss2/tss2_esys.h>
+
+#include "common.h"
+#include "tpm.h"
+#include "unit_test.h"
+#include "utest-tpm-read-pcr-values.h"
+
+void cominitTpmReadPcrValuesTestNullParamFailure(void **state) {
+    COMINIT_PARAM_UNUSED(state);
+    cominitTpmContext_t ctx = {0};
+    ESYS_CONTEXT *esysCtx = calloc(1, sizeof(char));
+    const unsigned long pcrs[] = {0};
+    uint8_t pcrValues[COMINIT_TPM_PCR_MAX][TPM2_SHA256_DIGEST_SIZE];
+
+    assert_int_equal(cominitTpmReadPcrValues(NULL, pcrs, 1, pcrValues), EXIT_FAILURE);
+    assert_int_equal(cominitTpmReadPcrValues(&ctx, pcrs, 1, pcrValues), EXIT_FAILURE);
+    ctx.esysCtx = esysCtx;
+    assert_int_equal(cominitTpmReadPcrValues(&ctx, NULL, 1, pcrValues), EXIT_FAILURE);
+    assert_int_equal(cominitTpmReadPcrValues(&ctx, pcrs, 1, NULL), EXIT_FAILURE);
+
+    free(esysCtx);
+}
+
+void cominitTpmReadPcrValuesTestInvalidPcrsFailure(void **state) {
+    COMINIT_PARAM_UNUSED(state);
+    cominitTpmContext_t ctx = {0};
+    ESYS_CONTEXT *esysCtx = calloc(1, sizeof(char));
+    ctx.esysCtx = esysCtx;
+    const unsigned long pcrs[] = {0, COMINIT_TPM_PCR_MAX};
+    uint8_t pcrValues[COMINIT_TPM_PCR_MAX][TPM2_SHA256_DIGEST_SIZE];
+
+    assert_int_equal(cominitTpmReadPcrValues(&ctx, pcrs, 0, pcrValues), EXIT_FAILURE);
+    assert_int_equal(cominitTpmReadPcrValues(&ctx, pcrs, -1, pcrValues), EXIT_FAILURE);
+    assert_int_equal(cominitTpmReadPcrValues(&ctx, pcrs, 2, pcrValues), EXIT_FAILURE);
+
+    free(esysCtx);
+}
@@ -0,0 +1,89 @@
+// SPDX-License-Identifier: MIT
+/**
+ * @file utest-tpm-read-pcr-values-success.c
+ * @brief Implementation of success cases unit tests for cominitTpmReadPcrValues().
+ */
+#include <stdlib.h>
+#include <string.h>
+#include <tss2/tss2_esys.h>
+
+#include "common.h"
+#include "tpm.h"
+#include "unit_test.h"
+#include "utest-tpm-read-pcr-values.h"
+
+/**
+ * Expects one TPM2_PCR_Read command returning \a selection and \a values.
+ */
+static void cominitTpmReadPcrValuesExpectRead(ESYS_CONTEXT *esysCtx, TPML_PCR_SELECTION *selection,
+                                              TPML_DIGEST *values) {
+    expect_value(__wrap_Esys_PCR_Read, esysContext, esysCtx);
+    expect_value(__wrap_Esys_PCR_Read, shandle1, ESYS_TR_NONE);
+    expect_value(__wrap_Esys_PCR_Read, shandle2, ESYS_TR_NONE);
+    expect_value(__wrap_Esys_PCR_Read, shandle3, ESYS_TR_NONE);
+    expect_any(__wrap_Esys_PCR_Read, pcrSelectionIn);
+    expect_any(__wrap_Esys_PCR_Read, pcrUpdateCounter);
+    will_return(__wrap_Esys_PCR_Read, selection);
+    will_return(__wrap_Esys_PCR_Read, values);
+    will_return(__wrap_Esys_PCR_Read, TSS2_RC_SUCCESS);
+    expect_value(__wrap_Esys_Free, __ptr, selection);
+    expect_value(__wrap_Esys_Free, __ptr, values);
+}
+
+void cominitTpmReadPcrValuesTestSuccess(void **state) {
+    COMINIT_PARAM_UNUSED(state);
+    cominitTpmContext_t ctx = {0};
+    ESYS_CONTEXT *esysCtx = calloc(1, sizeof(char));
+    ctx.esysCtx = esysCtx;
+    const unsigned long pcrs[] = {7, 0};
+    uint8_t pcrValues[COMINIT_TPM_PCR_MAX][TPM2_SHA256_DIGEST_SIZE] = {{0}};
+    TPML_PCR_SELECTION selection = {
+        .count = 1,
+        .pcrSelections = {{.hash = TPM2_ALG_SHA256, .sizeofSelect = COMINIT_TPM_PCR_SELECT_SIZE, .pcrSelect = {0x81}}}};
+    TPML_DIGEST values = {.count = 2};
+    values.digests[0].size = TPM2_SHA256_DIGEST_SIZE;
+    memset(values.digests[0].buffer, 0xa0, TPM2_SHA256_DIGEST_SIZE);
+    values.digests[1].size = TPM2_SHA256_DIGEST_SIZE;
+    memset(values.digests[1].buffer, 0xa7, TPM2_SHA256_DIGEST_SIZE);
+
+    cominitTpmReadPcrValuesExpectRead(esysCtx, &selection, &values);
+    assert_int_equal(cominitTpmReadPcrValues(&ctx, pcrs, 2, pcrValues), EXIT_SUCCESS);
+    assert_memory_equal(pcrValues[0], values.digests[0].buffer, TPM2_SHA256_DIGEST_SIZE);
+    assert_memory_equal(pcrValues[7], values.digests[1].buffer, TPM2_SHA256_DIGEST_SIZE);
+
+    free(esysCtx);
+}
+
+void cominitTpmReadPcrValuesTestTwoRoundsSuccess(void **state) {
+    COMINIT_PARAM_UNUSED(state);
+    cominitTpmContext_t ctx = {0};
+    ESYS_CONTEXT *esysCtx = calloc(1, sizeof(char));
+    ctx.esysCtx = esysCtx;
+    const unsigned long pcrs[] = {0, 1, 2, 3, 4, 5, 6, 7, 8};
+    uint8_t pcrValues[COMINIT_TPM_PCR_MAX][TPM2_SHA256_DIGEST_SIZE] = {{0}};
+    TPML_PCR_SELECTION first = {
+        .count = 1,
+        .pcrSelections = {{.hash = TPM2_ALG_SHA256, .sizeofSelect = COMINIT_TPM_PCR_SELECT_SIZE, .pcrSelect = {0xff}}}};
+    TPML_PCR_SELECTION second = {
+        .count = 1,
+        .pcrSelections = {
+            {.hash = TPM2_ALG_SHA256, .sizeofSelect = COMINIT_TPM_PCR_SELECT_SIZE, .pcrSelect = {0x00, 0x01}}}};
+    TPML_DIGEST firstValues = {.count = 8};
+    TPML_DIGEST secondValues = {.count = 1};
+    for (int i = 0; i < 8; i++) {
+        firstValues.digests[i].size = TPM2_SHA256_DIGEST_SIZE;
+        memset(firstValues.digests[i].buffer, i, TPM2_SHA256_DIGEST_SIZE);
+    }
+    secondValues.digests[0].size = TPM2_SHA256_DIGEST_SIZE;
+    memset(secondValues.digests[0].buffer, 8, TPM2_SHA256_DIGEST_SIZE);
+
+    cominitTpmReadPcrValuesExpectRead(esysCtx, &first, &firstValues);
+    cominitTpmReadPcrValuesExpectRead(esysCtx, &second, &secondValues);
+    assert_int_equal(cominitTpmReadPcrValues(&ctx, pcrs, 9, pcrValues), EXIT_SUCCESS);
+    for (int i = 0; i < 9; i++) {
+        assert_int_equal(pcrValues[i][0], i);
+        assert_int_equal(pcrValues[i][TPM2_SHA256_DIGEST_SIZE - 1], i);
+    }
+
+    free(esysCtx);
+}
@@ -0,0 +1,25 @@
+// SPDX-License-Identifier: MIT
+/**
+ * @file utest-tpm-read-pcr-values.c
+ * @brief Implementation of an cominitTpmReadPcrValues() unit test group using cmocka.
+ */
+#include "utest-tpm-read-pcr-values.h"
+
+#include "unit_test.h"
+
+/**
+ * Run the unit tests for cominitTpmReadPcrValues().
+ *
+ * @return  The same as cmocka_run_group_tests() returns for the tests.
+ */
+int main(void) {
+    const struct CMUnitTest tests[] = {
+        cmocka_unit_test(cominitTpmReadPcrValuesTestSuccess),
+        cmocka_unit_test(cominitTpmReadPcrValuesTestTwoRoundsSuccess),
+        cmocka_unit_test(cominitTpmReadPcrValuesTestReadFailure),
+        cmocka_unit_test(cominitTpmReadPcrValuesTestMissingPcrFailure),
+        cmocka_unit_test(cominitTpmReadPcrValuesTestNullParamFailure),
+        cmocka_unit_test(cominitTpmReadPcrValuesTestInvalidPcrsFailure),
+    };
+    return cmocka_run_group_tests(tests, NULL, NULL);
+}
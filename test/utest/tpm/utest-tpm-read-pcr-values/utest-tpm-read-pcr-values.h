@@ -0,0 +1,45 @@
+// SPDX-License-Identifier: MIT
+/**
+ * @file utest-tpm-read-pcr-values.h
+ * @brief Header declaring cmocka unit test functions for cominitTpmReadPcrValues().
+ */
+#ifndef __UTEST_TPM_READ_PCR_VALUES_H__
+#define __UTEST_TPM_READ_PCR_VALUES_H__
+
+/**
+ * Unit test for cominitTpmReadPcrValues() successful code path.
+ * @param state
+ */
+void cominitTpmReadPcrValuesTestSuccess(void **state);
+
+/**
+ * Unit test for cominitTpmReadPcrValues() reading the remaining PCRs in a second TPM2_PCR_Read command.
+ * @param state
+ */
+void cominitTpmReadPcrValuesTestTwoRoundsSuccess(void **state);
+
+/**
+ * Unit test for cominitTpmReadPcrValues() with a failing TPM2_PCR_Read command.
+ * @param state
+ */
+void cominitTpmReadPcrValuesTestReadFailure(void **state);
+
+/**
+ * Unit test for cominitTpmReadPcrValues() with a TPM that does not return a selected PCR.
+ * @param state
+ */
+void cominitTpmReadPcrValuesTestMissingPcrFailure(void **state);
+
+/**
+ * Unit test for cominitTpmReadPcrValues() with NULL parameters.
+ * @param state
+ */
+void cominitTpmReadPcrValuesTestNullParamFailure(void **state);
+
+/**
+ * Unit test for cominitTpmReadPcrValues() with no PCRs or a PCR index out of range.
+ * @param state
+ */
+void cominitTpmReadPcrValuesTestInvalidPcrsFailure(void **state);
+
+#endif /* __UTEST_TPM_READ_PCR_VALUES_H__ */
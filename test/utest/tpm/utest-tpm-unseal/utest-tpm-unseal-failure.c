@@ -0,0 +1,116 @@
+// SPDX-License-Identifier: MIT
+/**
+ * @file utest-tpm-unseal-failure.c
+ * @brief Implementation of several failure case unit tests for cominitTpmUnseal().
+ */
+#include <cmocka_extensions/cmocka_extensions.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "common.h"
+#include "tpm.h"
+#include "unit_test.h"
+#include "utest-tpm-unseal.h"
+
+/**
+ * Expects a single TPM2_PCR_Read returning the current values of PCR 10 and 12.
+ *
+ * @param readSelection  The selection returned by the TPM.
+ * @param values  The values returned by the TPM.
+ * @param pcr12  The current value of PCR 12.
+ */
+static void cominitTpmUnsealTestExpectPcrRead(TPML_PCR_SELECTION *readSelection, TPML_DIGEST *values, uint8_t pcr12) {
+    readSelection->count = 1;
+    readSelection->pcrSelections[0].hash = TPM2_ALG_SHA256;
+    readSelection->pcrSelections[0].sizeofSelect = 3;
+    readSelection->pcrSelections[0].pcrSelect[1] = (1u << 2) | (1u << 4);
+    values->count = 2;
+    values->digests[0].size = 32;
+    memset(values->digests[0].buffer, 0x10, 32);
+    values->digests[1].size = 32;
+    memset(values->digests[1].buffer, pcr12, 32);
+
+    expect_any(__wrap_Esys_PCR_Read, esysContext);
+    expect_value(__wrap_Esys_PCR_Read, shandle1, ESYS_TR_NONE);
+    expect_value(__wrap_Esys_PCR_Read, shandle2, ESYS_TR_NONE);
+    expect_value(__wrap_Esys_PCR_Read, shandle3, ESYS_TR_NONE);
+    expect_any(__wrap_Esys_PCR_Read, pcrSelectionIn);
+    expect_any(__wrap_Esys_PCR_Read, pcrUpdateCounter);
+    will_return(__wrap_Esys_PCR_Read, readSelection);
+    will_return(__wrap_Esys_PCR_Read, values);
+    will_return(__wrap_Esys_PCR_Read, TSS2_RC_SUCCESS);
+    expect_any(__wrap_Esys_Free, __ptr);
+    expect_any(__wrap_Esys_Free, __ptr);
+}
+
+/**
+ * Expects the primary key to be looked up and fails the lookup.
+ */
+static void cominitTpmUnsealTestExpectPrimaryFailure(void) {
+    expect_any(__wrap_Esys_TR_FromTPMPublic, esys_context);
+    expect_value(__wrap_Esys_TR_FromTPMPublic, tpm_handle, TPM2_PERSISTENT_FIRST);
+    expect_value(__wrap_Esys_TR_FromTPMPublic, shandle1, ESYS_TR_NONE);
+    expect_value(__wrap_Esys_TR_FromTPMPublic, shandle2, ESYS_TR_NONE);
+    expect_value(__wrap_Esys_TR_FromTPMPublic, shandle3, ESYS_TR_NONE);
+    will_return(__wrap_Esys_TR_FromTPMPublic, TPM2_RC_HANDLE);
+}
+
+void cominitTpmUnsealTestPcrsDivergedFailure(void **state) {
+    COMINIT_PARAM_UNUSED(state);
+
+    ESYS_CONTEXT *ectx = (ESYS_CONTEXT *)0x1;
+    cominitCliArgs_t argCtx = {.tpmPrimaryHandle = TPM2_PERSISTENT_FIRST};
+    cominitTpmBlob_t blob;
+    TPML_PCR_SELECTION readSelection = {0};
+    TPML_DIGEST values = {0};
+
+    cominitTpmUnsealTestFillBlob(&blob, 0x12);
+    cominitTpmUnsealTestExpectPcrRead(&readSelection, &values, 0x21);
+
+    /* No Esys_TR_FromTPMPublic(), Esys_Load() or policy session expected */
+    assert_int_equal(cominitTpmUnseal(ectx, &blob, &argCtx), TpmPolicyFailure);
+}
+
+void cominitTpmUnsealTestPcrsMatchFailure(void **state) {
+    COMINIT_PARAM_UNUSED(state);
+
+    ESYS_CONTEXT *ectx = (ESYS_CONTEXT *)0x1;
+    cominitCliArgs_t argCtx = {.tpmPrimaryHandle = TPM2_PERSISTENT_FIRST};
+    cominitTpmBlob_t blob;
+    TPML_PCR_SELECTION readSelection = {0};
+    TPML_DIGEST values = {0};
+
+    cominitTpmUnsealTestFillBlob(&blob, 0x12);
+    cominitTpmUnsealTestExpectPcrRead(&readSelection, &values, 0x12);
+    cominitTpmUnsealTestExpectPrimaryFailure();
+
+    assert_int_equal(cominitTpmUnseal(ectx, &blob, &argCtx), TpmFailure);
+}
+
+void cominitTpmUnsealTestNoPcrValuesFailure(void **state) {
+    COMINIT_PARAM_UNUSED(state);
+
+    ESYS_CONTEXT *ectx = (ESYS_CONTEXT *)0x1;
+    cominitCliArgs_t argCtx = {.tpmPrimaryHandle = TPM2_PERSISTENT_FIRST};
+    cominitTpmBlob_t blob;
+
+    cominitTpmUnsealTestFillBlob(&blob, 0x12);
+    memset(blob.pcrValues, 0, sizeof(blob.pcrValues));
+    cominitTpmUnsealTestExpectPrimaryFailure();
+
+    assert_int_equal(cominitTpmUnseal(ectx, &blob, &argCtx), TpmFailure);
+}
+
+void cominitTpmUnsealTestParamFailure(void **state) {
+    COMINIT_PARAM_UNUSED(state);
+
+    ESYS_CONTEXT *ectx = (ESYS_CONTEXT *)0x1;
+    cominitCliArgs_t argCtx = {.tpmPrimaryHandle = TPM2_PERSISTENT_FIRST};
+    cominitTpmBlob_t blob;
+
+    cominitTpmUnsealTestFillBlob(&blob, 0x12);
+
+    assert_int_equal(cominitTpmUnseal(NULL, &blob, &argCtx), TpmFailure);
+    assert_int_equal(cominitTpmUnseal(ectx, NULL, &argCtx), TpmFailure);
+    assert_int_equal(cominitTpmUnseal(ectx, &blob, NULL), TpmFailure);
+}
@@ -0,0 +1,39 @@
+// SPDX-License-Identifier: MIT
+/**
+ * @file utest-tpm-unseal.c
+ * @brief Implementation of an cominitTpmUnseal() unit test group using cmocka.
+ */
+#include "utest-tpm-unseal.h"
+
+#include <string.h>
+
+#include "unit_test.h"
+
+void cominitTpmUnsealTestFillBlob(cominitTpmBlob_t *blob, uint8_t pcr12) {
+    memset(blob, 0, sizeof(*blob));
+
+    blob->pcrSelection.count = 1;
+    blob->pcrSelection.pcrSelections[0].hash = TPM2_ALG_SHA256;
+    blob->pcrSelection.pcrSelections[0].sizeofSelect = 3;
+    blob->pcrSelection.pcrSelections[0].pcrSelect[1] = (1u << 2) | (1u << 4);
+
+    blob->pcrValues[10].size = 32;
+    memset(blob->pcrValues[10].buffer, 0x10, 32);
+    blob->pcrValues[12].size = 32;
+    memset(blob->pcrValues[12].buffer, pcr12, 32);
+}
+
+/**
+ * Run the unit tests for cominitTpmUnseal().
+ *
+ * @return  The same as cmocka_run_group_tests() returns for the tests.
+ */
+int main(void) {
+    const struct CMUnitTest tests[] = {
+        cmocka_unit_test(cominitTpmUnsealTestPcrsDivergedFailure),
+        cmocka_unit_test(cominitTpmUnsealTestPcrsMatchFailure),
+        cmocka_unit_test(cominitTpmUnsealTestNoPcrValuesFailure),
+        cmocka_unit_test(cominitTpmUnsealTestParamFailure),
+    };
+    return cmocka_run_group_tests(tests, NULL, NULL);
+}
@@ -0,0 +1,42 @@
+// SPDX-License-Identifier: MIT
+/**
+ * @file utest-tpm-unseal.h
+ * @brief Header declaring cmocka unit test functions for cominitTpmUnseal().
+ */
+#ifndef __UTEST_TPM_UNSEAL_H__
+#define __UTEST_TPM_UNSEAL_H__
+
+#include "tpm.h"
+
+/**
+ * Fills a blob sealed to PCR 10 and 12 with the given value of PCR 12.
+ * @param blob  The blob to fill.
+ * @param pcr12  The value of PCR 12 at sealing time.
+ */
+void cominitTpmUnsealTestFillBlob(cominitTpmBlob_t *blob, uint8_t pcr12);
+
+/**
+ * Unit test that the policy failure is predicted from diverged PCRs without loading the sealed object.
+ * @param state
+ */
+void cominitTpmUnsealTestPcrsDivergedFailure(void **state);
+
+/**
+ * Unit test that unsealing continues with loading the primary key if the PCRs match.
+ * @param state
+ */
+void cominitTpmUnsealTestPcrsMatchFailure(void **state);
+
+/**
+ * Unit test that a blob without recorded PCR values skips the prediction.
+ * @param state
+ */
+void cominitTpmUnsealTestNoPcrValuesFailure(void **state);
+
+/**
+ * Unit test that simulates invalid parameters.
+ * @param state
+ */
+void cominitTpmUnsealTestParamFailure(void **state);
+
+#endif /* __UTEST_TPM_UNSEAL_H__ */
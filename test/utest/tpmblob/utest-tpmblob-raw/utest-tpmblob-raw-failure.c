@@ -0,0 +1,70 @@
+// SPDX-License-Identifier: MIT
+/**
+ * @file utest-tpmblob-raw-failure.c
+ * @brief Implementation of several failure case unit tests for cominitTpmBlobRawSave() and cominitTpmBlobRawLoad().
+ */
+#include <cmocka_extensions/cmocka_extensions.h>
+#include <fcntl.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+#include "common.h"
+#include "tpmblob.h"
+#include "unit_test.h"
+#include "utest-tpmblob-raw.h"
+
+/**
+ * Overwrites a Byte of the file emulating the blob partition.
+ *
+ * @param path  The file.
+ * @param offset  The offset of the Byte.
+ * @param value  The new value.
+ */
+static void cominitTpmBlobRawTestPoke(const char *path, off_t offset, uint8_t value) {
+    int fd = open(path, O_WRONLY);
+    assert_true(fd >= 0);
+    assert_int_equal(pwrite(fd, &value, 1, offset), 1);
+    close(fd);
+}
+
+void cominitTpmBlobRawTestFailure(void **state) {
+    cominitTpmBlobRawTest_t *test = *state;
+    cominitTpmBlob_t loaded = {0};
+    bool empty = false;
+
+    assert_int_not_equal(cominitTpmBlobRawLoad(NULL, test->path, &empty), EXIT_SUCCESS);
+    assert_int_not_equal(cominitTpmBlobRawLoad(&loaded, NULL, &empty), EXIT_SUCCESS);
+    assert_int_not_equal(cominitTpmBlobRawLoad(&loaded, test->path, NULL), EXIT_SUCCESS);
+    assert_int_not_equal(cominitTpmBlobRawSave(NULL, test->path), EXIT_SUCCESS);
+    assert_int_not_equal(cominitTpmBlobRawSave(&test->blob, NULL), EXIT_SUCCESS);
+    assert_int_not_equal(cominitTpmBlobRawLoad(&loaded, "/nonexistent", &empty), EXIT_SUCCESS);
+
+    /* A first save interrupted before the magic Bytes were written leaves the partition empty */
+    assert_int_equal(cominitTpmBlobRawSave(&test->blob, test->path), EXIT_SUCCESS);
+    for (off_t i = 0; i < 4; i++) {
+        cominitTpmBlobRawTestPoke(test->path, i, 0);
+    }
+    assert_int_equal(cominitTpmBlobRawLoad(&loaded, test->path, &empty), EXIT_SUCCESS);
+    assert_true(empty);
+
+    /* First copy at offset 0 with sequence 1, second copy with sequence 2 */
+    assert_int_equal(cominitTpmBlobRawSave(&test->blob, test->path), EXIT_SUCCESS);
+    assert_int_equal(cominitTpmBlobRawSave(&test->blob, test->path), EXIT_SUCCESS);
+
+    /* An interrupted update of the second copy falls back to the first one */
+    cominitTpmBlobRawTestPoke(test->path, COMINIT_TPMBLOB_RAW_SLOT_SIZE + COMINIT_TPMBLOB_HEADER_SIZE, 0xFF);
+    assert_int_equal(cominitTpmBlobRawLoad(&loaded, test->path, &empty), EXIT_SUCCESS);
+    assert_false(empty);
+    assert_int_equal(loaded.sequence, 1);
+
+    /* The next update replaces the invalid copy */
+    assert_int_equal(cominitTpmBlobRawSave(&test->blob, test->path), EXIT_SUCCESS);
+    assert_int_equal(cominitTpmBlobRawLoad(&loaded, test->path, &empty), EXIT_SUCCESS);
+    assert_int_equal(loaded.sequence, 2);
+
+    /* Both copies corrupted must not be mistaken for an empty partition */
+    cominitTpmBlobRawTestPoke(test->path, COMINIT_TPMBLOB_HEADER_SIZE, 0xFF);
+    cominitTpmBlobRawTestPoke(test->path, COMINIT_TPMBLOB_RAW_SLOT_SIZE + COMINIT_TPMBLOB_HEADER_SIZE, 0xFF);
+    assert_int_not_equal(cominitTpmBlobRawLoad(&loaded, test->path, &empty), EXIT_SUCCESS);
+}
@@ -0,0 +1,35 @@
+// SPDX-License-Identifier: MIT
+/**
+ * @file utest-tpmblob-raw-success.c
+ * @brief Implementation of a success case unit test for cominitTpmBlobRawSave() and cominitTpmBlobRawLoad().
+ */
+#include <cmocka_extensions/cmocka_extensions.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "common.h"
+#include "tpmblob.h"
+#include "unit_test.h"
+#include "utest-tpmblob-raw.h"
+
+void cominitTpmBlobRawTestSuccess(void **state) {
+    cominitTpmBlobRawTest_t *test = *state;
+    cominitTpmBlob_t loaded = {0};
+    bool empty = false;
+
+    assert_int_equal(cominitTpmBlobRawLoad(&loaded, test->path, &empty), EXIT_SUCCESS);
+    assert_true(empty);
+
+    for (uint16_t i = 1; i <= 3; i++) {
+        test->blob.outPrivate.buffer[0] = (uint8_t)i;
+        assert_int_equal(cominitTpmBlobRawSave(&test->blob, test->path), EXIT_SUCCESS);
+
+        assert_int_equal(cominitTpmBlobRawLoad(&loaded, test->path, &empty), EXIT_SUCCESS);
+        assert_false(empty);
+        assert_int_equal(loaded.sequence, i);
+        assert_int_equal(loaded.pcrSelection.pcrSelections[0].pcrSelect[1], 0x1C);
+        assert_int_equal(loaded.policyDigest.size, test->blob.policyDigest.size);
+        assert_int_equal(loaded.outPrivate.size, test->blob.outPrivate.size);
+        assert_memory_equal(loaded.outPrivate.buffer, test->blob.outPrivate.buffer, test->blob.outPrivate.size);
+    }
+}
@@ -0,0 +1,65 @@
+// SPDX-License-Identifier: MIT
+/**
+ * @file utest-tpmblob-raw.c
+ * @brief Implementation of a cominitTpmBlobRawSave() and cominitTpmBlobRawLoad() unit test group using cmocka.
+ */
+#include "utest-tpmblob-raw.h"
+
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+#include "unit_test.h"
+
+int cominitTpmBlobRawTestSetup(void **state) {
+    cominitTpmBlobRawTest_t *test = calloc(1, sizeof(*test));
+    int fd = -1;
+
+    if (test != NULL) {
+        strcpy(test->path, "/tmp/utest-tpmblob-raw-XXXXXX");
+        fd = mkstemp(test->path);
+    }
+    if (fd < 0 || ftruncate(fd, 2 * COMINIT_TPMBLOB_RAW_SLOT_SIZE) != 0) {
+        free(test);
+        return -1;
+    }
+    close(fd);
+
+    test->blob.pcrSelection.count = 1;
+    test->blob.pcrSelection.pcrSelections[0].hash = TPM2_ALG_SHA256;
+    test->blob.pcrSelection.pcrSelections[0].sizeofSelect = 3;
+    test->blob.pcrSelection.pcrSelections[0].pcrSelect[1] = 0x1C;
+    test->blob.policyDigest.size = 32;
+    memset(test->blob.policyDigest.buffer, 0x3C, 32);
+    test->blob.outPublic.publicArea.type = TPM2_ALG_KEYEDHASH;
+    test->blob.outPublic.publicArea.nameAlg = TPM2_ALG_SHA256;
+    test->blob.outPublic.publicArea.parameters.keyedHashDetail.scheme.scheme = TPM2_ALG_NULL;
+    test->blob.outPrivate.size = 48;
+    memset(test->blob.outPrivate.buffer, 0xC3, 48);
+
+    *state = test;
+    return 0;
+}
+
+int cominitTpmBlobRawTestTeardown(void **state) {
+    cominitTpmBlobRawTest_t *test = *state;
+
+    unlink(test->path);
+    free(test);
+    return 0;
+}
+
+/**
+ * Run the unit tests for cominitTpmBlobRawSave() and cominitTpmBlobRawLoad().
+ *
+ * @return  The same as cmocka_run_group_tests() returns for the tests.
+ */
+int main(void) {
+    const struct CMUnitTest tests[] = {
+        cmocka_unit_test_setup_teardown(cominitTpmBlobRawTestSuccess, cominitTpmBlobRawTestSetup,
+                                        cominitTpmBlobRawTestTeardown),
+        cmocka_unit_test_setup_teardown(cominitTpmBlobRawTestFailure, cominitTpmBlobRawTestSetup,
+                                        cominitTpmBlobRawTestTeardown),
+    };
+    return cmocka_run_group_tests(tests, NULL, NULL);
+}
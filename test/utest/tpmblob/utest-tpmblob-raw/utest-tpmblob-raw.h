@@ -0,0 +1,43 @@
+// SPDX-License-Identifier: MIT
+/**
+ * @file utest-tpmblob-raw.h
+ * @brief Header declaring cmocka unit test functions for cominitTpmBlobRawSave() and cominitTpmBlobRawLoad().
+ */
+#ifndef __UTEST_TPMBLOB_RAW_H__
+#define __UTEST_TPMBLOB_RAW_H__
+
+#include "tpmblob.h"
+
+/**
+ * Structure holding the state of a test.
+ */
+typedef struct cominitTpmBlobRawTest {
+    char path[32];          ///< The file emulating the blob partition.
+    cominitTpmBlob_t blob;   ///< A blob with recognizable test data.
+} cominitTpmBlobRawTest_t;
+
+/**
+ * Creates a zeroed file emulating the blob partition.
+ * @param state
+ */
+int cominitTpmBlobRawTestSetup(void **state);
+
+/**
+ * Removes the file emulating the blob partition.
+ * @param state
+ */
+int cominitTpmBlobRawTestTeardown(void **state);
+
+/**
+ * Unit test for saving and loading both copies.
+ * @param state
+ */
+void cominitTpmBlobRawTestSuccess(void **state);
+
+/**
+ * Unit test that simulates an interrupted update, corrupted copies and invalid parameters.
+ * @param state
+ */
+void cominitTpmBlobRawTestFailure(void **state);
+
+#endif /* __UTEST_TPMBLOB_RAW_H__ */
@@ -0,0 +1,65 @@
+// SPDX-License-Identifier: MIT
+/**
+ * @file utest-tpmblob-serialize-failure.c
+ * @brief Implementation of several failure case unit tests for cominitTpmBlobSerialize() and
+ *        cominitTpmBlobDeserialize().
+ */
+#include <cmocka_extensions/cmocka_extensions.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "common.h"
+#include "tpmblob.h"
+#include "unit_test.h"
+#include "utest-tpmblob-serialize.h"
+
+void cominitTpmBlobSerializeTestFailure(void **state) {
+    COMINIT_PARAM_UNUSED(state);
+
+    cominitTpmBlob_t blob;
+    uint8_t buffer[COMINIT_TPMBLOB_MAX_SIZE];
+    uint8_t corrupted[COMINIT_TPMBLOB_MAX_SIZE];
+    size_t length = 0;
+
+    cominitTpmBlobSerializeTestFillBlob(&blob);
+
+    assert_int_not_equal(cominitTpmBlobSerialize(NULL, buffer, sizeof(buffer), &length), EXIT_SUCCESS);
+    assert_int_not_equal(cominitTpmBlobSerialize(&blob, NULL, sizeof(buffer), &length), EXIT_SUCCESS);
+    assert_int_not_equal(cominitTpmBlobSerialize(&blob, buffer, sizeof(buffer), NULL), EXIT_SUCCESS);
+    assert_int_not_equal(cominitTpmBlobSerialize(&blob, buffer, 64, &length), EXIT_SUCCESS);
+    blob.volumeCount = COMINIT_TPMBLOB_VOLUMES_MAX + 1;
+    assert_int_not_equal(cominitTpmBlobSerialize(&blob, buffer, sizeof(buffer), &length), EXIT_SUCCESS);
+    blob.volumeCount = 2;
+
+    assert_int_equal(cominitTpmBlobSerialize(&blob, buffer, sizeof(buffer), &length), EXIT_SUCCESS);
+
+    assert_int_not_equal(cominitTpmBlobDeserialize(NULL, buffer, length), EXIT_SUCCESS);
+    assert_int_not_equal(cominitTpmBlobDeserialize(&blob, NULL, length), EXIT_SUCCESS);
+
+    /* Truncated and oversized */
+    assert_int_not_equal(cominitTpmBlobDeserialize(&blob, buffer, COMINIT_TPMBLOB_HEADER_SIZE), EXIT_SUCCESS);
+    assert_int_not_equal(cominitTpmBlobDeserialize(&blob, buffer, length - 1), EXIT_SUCCESS);
+    memcpy(corrupted, buffer, length);
+    corrupted[length] = 0;
+    assert_int_not_equal(cominitTpmBlobDeserialize(&blob, corrupted, length + 1), EXIT_SUCCESS);
+
+    /* Wrong magic */
+    memcpy(corrupted, buffer, length);
+    corrupted[0] ^= 0xFF;
+    assert_int_not_equal(cominitTpmBlobDeserialize(&blob, corrupted, length), EXIT_SUCCESS);
+
+    /* Unknown version */
+    memcpy(corrupted, buffer, length);
+    corrupted[5] = COMINIT_TPMBLOB_VERSION + 1;
+    assert_int_not_equal(cominitTpmBlobDeserialize(&blob, corrupted, length), EXIT_SUCCESS);
+
+    /* Flipped bit in the payload */
+    memcpy(corrupted, buffer, length);
+    corrupted[length / 2] ^= 0x01;
+    assert_int_not_equal(cominitTpmBlobDeserialize(&blob, corrupted, length), EXIT_SUCCESS);
+
+    /* Flipped bit in the CRC */
+    memcpy(corrupted, buffer, length);
+    corrupted[length - 1] ^= 0x01;
+    assert_int_not_equal(cominitTpmBlobDeserialize(&blob, corrupted, length), EXIT_SUCCESS);
+}
@@ -0,0 +1,47 @@
+// SPDX-License-Identifier: MIT
+/**
+ * @file utest-tpmblob-serialize-success.c
+ * @brief Implementation of a success case unit test for cominitTpmBlobSerialize() and cominitTpmBlobDeserialize().
+ */
+#include <cmocka_extensions/cmocka_extensions.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "common.h"
+#include "tpmblob.h"
+#include "unit_test.h"
+#include "utest-tpmblob-serialize.h"
+
+void cominitTpmBlobSerializeTestSuccess(void **state) {
+    COMINIT_PARAM_UNUSED(state);
+
+    cominitTpmBlob_t blob;
+    cominitTpmBlob_t loaded;
+    uint8_t buffer[COMINIT_TPMBLOB_MAX_SIZE];
+    size_t length = 0;
+
+    cominitTpmBlobSerializeTestFillBlob(&blob);
+    memset(&loaded, 0xFF, sizeof(loaded));
+
+    assert_int_equal(cominitTpmBlobSerialize(&blob, buffer, sizeof(buffer), &length), EXIT_SUCCESS);
+    assert_true(length < sizeof(TPM2B_PUBLIC) + sizeof(TPM2B_PRIVATE));
+    assert_memory_equal(buffer, COMINIT_TPMBLOB_MAGIC, 4);
+
+    assert_int_equal(cominitTpmBlobDeserialize(&loaded, buffer, length), EXIT_SUCCESS);
+    assert_int_equal(loaded.pcrSelection.count, 1);
+    assert_memory_equal(&loaded.pcrSelection.pcrSelections[0], &blob.pcrSelection.pcrSelections[0],
+                        sizeof(TPMS_PCR_SELECTION));
+    assert_int_equal(loaded.policyDigest.size, blob.policyDigest.size);
+    assert_memory_equal(loaded.policyDigest.buffer, blob.policyDigest.buffer, blob.policyDigest.size);
+    assert_int_equal(loaded.outPublic.publicArea.type, TPM2_ALG_KEYEDHASH);
+    assert_int_equal(loaded.outPublic.publicArea.authPolicy.size, blob.policyDigest.size);
+    assert_int_equal(loaded.outPrivate.size, blob.outPrivate.size);
+    assert_memory_equal(loaded.outPrivate.buffer, blob.outPrivate.buffer, blob.outPrivate.size);
+    for (size_t i = 0; i < COMINIT_TPMBLOB_PCR_MAX; i++) {
+        assert_int_equal(loaded.pcrValues[i].size, blob.pcrValues[i].size);
+        assert_memory_equal(loaded.pcrValues[i].buffer, blob.pcrValues[i].buffer, blob.pcrValues[i].size);
+    }
+    assert_int_equal(loaded.flags, COMINIT_TPMBLOB_FLAG_CREATE | COMINIT_TPMBLOB_FLAG_FORMAT);
+    assert_int_equal(loaded.volumeCount, blob.volumeCount);
+    assert_memory_equal(loaded.volumes, blob.volumes, blob.volumeCount * COMINIT_TPMBLOB_VOLUME_ID_SIZE);
+}
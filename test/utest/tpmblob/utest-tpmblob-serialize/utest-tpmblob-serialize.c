@@ -0,0 +1,57 @@
+// SPDX-License-Identifier: MIT
+/**
+ * @file utest-tpmblob-serialize.c
+ * @brief Implementation of a cominitTpmBlobSerialize() and cominitTpmBlobDeserialize() unit test group using cmocka.
+ */
+#include "utest-tpmblob-serialize.h"
+
+#include <string.h>
+
+#include "unit_test.h"
+
+void cominitTpmBlobSerializeTestFillBlob(cominitTpmBlob_t *blob) {
+    memset(blob, 0, sizeof(*blob));
+
+    blob->pcrSelection.count = 1;
+    blob->pcrSelection.pcrSelections[0].hash = TPM2_ALG_SHA256;
+    blob->pcrSelection.pcrSelections[0].sizeofSelect = 3;
+    blob->pcrSelection.pcrSelections[0].pcrSelect[1] = 0x81;
+    blob->pcrValues[8].size = 32;
+    memset(blob->pcrValues[8].buffer, 0x08, 32);
+    blob->pcrValues[15].size = 32;
+    memset(blob->pcrValues[15].buffer, 0x0F, 32);
+
+    blob->policyDigest.size = 32;
+    memset(blob->policyDigest.buffer, 0xA5, blob->policyDigest.size);
+
+    blob->outPublic.publicArea.type = TPM2_ALG_KEYEDHASH;
+    blob->outPublic.publicArea.nameAlg = TPM2_ALG_SHA256;
+    blob->outPublic.publicArea.objectAttributes = TPMA_OBJECT_FIXEDTPM | TPMA_OBJECT_FIXEDPARENT;
+    blob->outPublic.publicArea.authPolicy = blob->policyDigest;
+    blob->outPublic.publicArea.parameters.keyedHashDetail.scheme.scheme = TPM2_ALG_NULL;
+    blob->outPublic.publicArea.unique.keyedHash.size = 32;
+    memset(blob->outPublic.publicArea.unique.keyedHash.buffer, 0x5A, 32);
+
+    blob->flags = COMINIT_TPMBLOB_FLAG_CREATE | COMINIT_TPMBLOB_FLAG_FORMAT;
+    blob->volumeCount = 2;
+    memset(blob->volumes[0], 0x11, COMINIT_TPMBLOB_VOLUME_ID_SIZE);
+    memset(blob->volumes[1], 0x22, COMINIT_TPMBLOB_VOLUME_ID_SIZE);
+
+    blob->outPrivate.size = 64;
+    for (uint16_t i = 0; i < blob->outPrivate.size; i++) {
+        blob->outPrivate.buffer[i] = (uint8_t)i;
+    }
+}
+
+/**
+ * Run the unit tests for cominitTpmBlobSerialize() and cominitTpmBlobDeserialize().
+ *
+ * @return  The same as cmocka_run_group_tests() returns for the tests.
+ */
+int main(void) {
+    const struct CMUnitTest tests[] = {
+        cmocka_unit_test(cominitTpmBlobSerializeTestSuccess),
+        cmocka_unit_test(cominitTpmBlobSerializeTestFailure),
+    };
+    return cmocka_run_group_tests(tests, NULL, NULL);
+}
@@ -0,0 +1,29 @@
+// SPDX-License-Identifier: MIT
+/**
+ * @file utest-tpmblob-serialize.h
+ * @brief Header declaring cmocka unit test functions for cominitTpmBlobSerialize() and cominitTpmBlobDeserialize().
+ */
+#ifndef __UTEST_TPMBLOB_SERIALIZE_H__
+#define __UTEST_TPMBLOB_SERIALIZE_H__
+
+#include "tpmblob.h"
+
+/**
+ * Fills a blob with recognizable test data.
+ * @param blob  The blob to fill.
+ */
+void cominitTpmBlobSerializeTestFillBlob(cominitTpmBlob_t *blob);
+
+/**
+ * Unit test for a serialization round trip.
+ * @param state
+ */
+void cominitTpmBlobSerializeTestSuccess(void **state);
+
+/**
+ * Unit test that simulates corrupted blobs and invalid parameters.
+ * @param state
+ */
+void cominitTpmBlobSerializeTestFailure(void **state);
+
+#endif /* __UTEST_TPMBLOB_SERIALIZE_H__ */
@@ -0,0 +1,31 @@
+// SPDX-License-Identifier: MIT
+/**
+ * @file utest-tpmprofile-record-failure.c
+ * @brief Implementation of several failure case unit tests for cominitTpmProfileCall().
+ */
+#include <cmocka_extensions/cmocka_extensions.h>
+#include <tss2/tss2_tpm2_types.h>
+
+#include "common.h"
+#include "tpmprofile.h"
+#include "unit_test.h"
+#include "utest-tpmprofile-record.h"
+
+void cominitTpmProfileRecordTestFailure(void **state) {
+    COMINIT_PARAM_UNUSED(state);
+
+    const cominitTpmProfileEntry_t *entry = cominitTpmProfileGet(COMINIT_TPM_CMD_NV_WRITE);
+    assert_non_null(entry);
+
+    assert_int_equal(cominitTpmProfileCall(COMINIT_TPM_CMD_NV_WRITE, TPM2_RC_NV_LOCKED), TPM2_RC_NV_LOCKED);
+    assert_int_equal(cominitTpmProfileCall(COMINIT_TPM_CMD_NV_WRITE, TPM2_RC_RETRY), TPM2_RC_RETRY);
+    assert_int_equal(cominitTpmProfileCall(COMINIT_TPM_CMD_NV_WRITE, TSS2_RC_SUCCESS), TSS2_RC_SUCCESS);
+
+    assert_int_equal(entry->count, 3);
+    assert_int_equal(entry->failed, 2);
+    assert_int_equal(entry->lastRc, TPM2_RC_RETRY);
+
+    /* Out of range commands are passed through but not recorded. */
+    assert_null(cominitTpmProfileGet(COMINIT_TPM_CMD_COUNT));
+    assert_int_equal(cominitTpmProfileCall(COMINIT_TPM_CMD_COUNT, TPM2_RC_FAILURE), TPM2_RC_FAILURE);
+}
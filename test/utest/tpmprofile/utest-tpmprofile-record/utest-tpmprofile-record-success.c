@@ -0,0 +1,44 @@
+// SPDX-License-Identifier: MIT
+/**
+ * @file utest-tpmprofile-record-success.c
+ * @brief Implementation of a success case unit test for cominitTpmProfileCall().
+ */
+#include <cmocka_extensions/cmocka_extensions.h>
+#include <time.h>
+
+#include "common.h"
+#include "tpmprofile.h"
+#include "unit_test.h"
+#include "utest-tpmprofile-record.h"
+
+/**
+ * Stands in for an ESAPI call taking a measurable amount of time.
+ *
+ * @return  TSS2_RC_SUCCESS
+ */
+static TSS2_RC cominitTpmProfileRecordTestSlowCall(void) {
+    struct timespec delay = {.tv_sec = 0, .tv_nsec = 2000000};
+
+    nanosleep(&delay, NULL);
+    return TSS2_RC_SUCCESS;
+}
+
+void cominitTpmProfileRecordTestSuccess(void **state) {
+    COMINIT_PARAM_UNUSED(state);
+
+    const cominitTpmProfileEntry_t *entry = cominitTpmProfileGet(COMINIT_TPM_CMD_PCR_EXTEND);
+    assert_non_null(entry);
+    assert_int_equal(entry->count, 0);
+
+    assert_int_equal(cominitTpmProfileCall(COMINIT_TPM_CMD_PCR_EXTEND, cominitTpmProfileRecordTestSlowCall()),
+                     TSS2_RC_SUCCESS);
+    assert_int_equal(cominitTpmProfileCall(COMINIT_TPM_CMD_PCR_EXTEND, TSS2_RC_SUCCESS), TSS2_RC_SUCCESS);
+
+    assert_int_equal(entry->count, 2);
+    assert_int_equal(entry->failed, 0);
+    assert_int_equal(entry->lastRc, TSS2_RC_SUCCESS);
+    assert_true(entry->maxNs >= 2000000);
+    assert_true(entry->totalNs >= entry->maxNs);
+
+    cominitTpmProfileReport();
+}
@@ -0,0 +1,21 @@
+// SPDX-License-Identifier: MIT
+/**
+ * @file utest-tpmprofile-record.c
+ * @brief Implementation of a cominitTpmProfileCall() unit test group using cmocka.
+ */
+#include "utest-tpmprofile-record.h"
+
+#include "unit_test.h"
+
+/**
+ * Run the unit tests for cominitTpmProfileCall() and cominitTpmProfileGet().
+ *
+ * @return  The same as cmocka_run_group_tests() returns for the tests.
+ */
+int main(void) {
+    const struct CMUnitTest tests[] = {
+        cmocka_unit_test(cominitTpmProfileRecordTestSuccess),
+        cmocka_unit_test(cominitTpmProfileRecordTestFailure),
+    };
+    return cmocka_run_group_tests(tests, NULL, NULL);
+}
@@ -0,0 +1,21 @@
+// SPDX-License-Identifier: MIT
+/**
+ * @file utest-tpmprofile-record.h
+ * @brief Header declaring cmocka unit test functions for cominitTpmProfileCall() and cominitTpmProfileGet().
+ */
+#ifndef __UTEST_TPMPROFILE_RECORD_H__
+#define __UTEST_TPMPROFILE_RECORD_H__
+
+/**
+ * Unit test for recording successful TPM commands.
+ * @param state
+ */
+void cominitTpmProfileRecordTestSuccess(void **state);
+
+/**
+ * Unit test for recording failed TPM commands and invalid parameters.
+ * @param state
+ */
+void cominitTpmProfileRecordTestFailure(void **state);
+
+#endif /* __UTEST_TPMPROFILE_RECORD_H__ */